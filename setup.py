@@ -742,6 +742,7 @@ EXT_CONFIGS = {
     '_twopt': {},
     '_threept': {},
     '_fftlog': {},
+    '_winconv': {},
 }
 
 
@@ -29,6 +29,31 @@ cdef extern from "include/fftlog.hpp":
             double complex* a, double complex* b
         ) except +
 
+        void biased_transform_batch(
+            int nbatch, const double* a, double* b
+        ) nogil except +
+
+    cdef cppclass CppDoubleSphericalBesselTransform \
+            "trv::maths::DoubleSphericalBesselTransform":
+        int nsamp
+        int nsamp_trans
+        double logres
+        double pivot
+
+        vector[double] pre_sampts
+        vector[double] post_sampts
+
+        CppDoubleSphericalBesselTransform(
+            int ell1, int ell2, int n1, int n2, bool_t threaded
+        )
+
+        void initialise(
+            vector[double] sample_pts, double kr_c, bool_t lowring,
+            int extrap, double extrap_exp, bool_t extrap2d
+        ) except +
+
+        void biased_transform(const double* a, double* b) nogil except +
+
 
 cdef class HankelTransform:
     cdef CppHankelTransform* thisptr
@@ -40,3 +65,13 @@ cdef class HankelTransform:
     cdef public double _pivot
     cdef public vector[double] _pre_sampts
     cdef public vector[double] _post_sampts
+
+
+cdef class _DoubleSphericalBesselTransform:
+    cdef CppDoubleSphericalBesselTransform* thisptr
+    cdef public int _nsamp
+    cdef public int _nsamp_trans
+    cdef public double _logres
+    cdef public double _pivot
+    cdef public vector[double] _pre_sampts
+    cdef public vector[double] _post_sampts
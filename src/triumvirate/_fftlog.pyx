@@ -9,7 +9,7 @@ import numpy as np
 cimport numpy as np
 
 from ._arrayops import _check_1d_array
-from ._fftlog cimport CppHankelTransform
+from ._fftlog cimport CppDoubleSphericalBesselTransform, CppHankelTransform
 
 
 cdef class HankelTransform:
@@ -124,6 +124,84 @@ cdef class HankelTransform:
 
         return np.asarray(y), np.asarray(gy)
 
+    def transform_batch(self, fx):
+        """Transform a batch of samples at initialised sample points.
+
+        The transform is performed in compiled code with the GIL released,
+        sharing a single pair of FFT plans across the batch.  Concurrent
+        calls on the same instance are serialised.
+
+        Parameters
+        ----------
+        fx : (M, N) array_like
+            Pre-transform samples, one row per sample array.  Must be
+            even in length if extrapolation is used.  If complex with
+            any non-zero imaginary part, the real and imaginary parts
+            are transformed separately.
+
+        Returns
+        -------
+        y : (N,) array_like
+            Post-transform sample points.
+        gy : (M, N) array_like
+            Post-transform samples, real unless `fx` has any non-zero
+            imaginary part.
+
+        Raises
+        ------
+        ValueError
+            If `fx` is not 2-d or its rows do not match the sample size.
+
+        """
+        fx = np.asarray(fx)
+        if fx.ndim != 2 or fx.shape[-1] != self._nsamp:
+            raise ValueError(
+                "Batch samples must be 2-d with rows of the same length as "
+                f"the sample points: {fx.shape} versus (..., {self._nsamp})."
+            )
+
+        if np.iscomplexobj(fx) and np.any(fx.imag):
+            gy = self._transform_batch(np.ascontiguousarray(
+                np.concatenate([fx.real, fx.imag]), dtype=np.float64
+            ))
+            gy = gy[:len(fx)] + 1j * gy[len(fx):]
+        else:
+            gy = self._transform_batch(
+                np.ascontiguousarray(fx.real, dtype=np.float64)
+            )
+
+        return np.asarray(self._post_sampts), gy
+
+    def _transform_batch(
+        self, np.ndarray[double, ndim=2, mode='c'] fx not None
+    ):
+        """Transform a batch of real samples at initialised sample points.
+
+        Parameters
+        ----------
+        fx : (M, N) array of float
+            Pre-transform samples, one row per sample array.
+
+        Returns
+        -------
+        gy : (M, N) array of float
+            Post-transform samples.
+
+        """
+        cdef int nbatch = fx.shape[0]
+        cdef np.ndarray[double, ndim=2, mode='c'] gy = \
+            np.zeros((nbatch, self._nsamp), dtype=np.float64)
+
+        if nbatch == 0:
+            return gy
+
+        cdef const double* fx_ptr = &fx[0, 0]
+        cdef double* gy_ptr = &gy[0, 0]
+        with nogil:
+            self.thisptr.biased_transform_batch(nbatch, fx_ptr, gy_ptr)
+
+        return gy
+
     def _transform(
         self, np.ndarray[double complex, ndim=1, mode='c'] fx not None
     ):
@@ -148,3 +226,122 @@ cdef class HankelTransform:
         self.thisptr.biased_transform(&fx[0], &gy[0])
 
         return gy
+
+
+cdef class _DoubleSphericalBesselTransform:
+    """Double spherical Bessel transform of 2-d samples in compiled code.
+
+    Parameters
+    ----------
+    degrees : (int, int)
+        Degrees of the transform in each dimension.
+    biases : (int, int)
+        Power-law bias indices in each dimension.
+    x : array of float
+        Pre-transform sample points in 1-d for both dimensions.  Must be
+        log-linearly spaced.  Must be even in length if extrapolation is
+        used.
+    kr_c : float
+        Pivot value for the transform.  When `lowring` is `True`, this is
+        adjusted if it is non-zero, or otherwise directly calculated.
+    lowring : bool, optional
+        Low-ringing condition (default is `True`).
+    extrap : int, optional
+        Extrapolation method (default is 0) with the same options as
+        for :class:`~triumvirate._fftlog.HankelTransform`.
+    extrap_exp : float, optional
+        Sample size expansion factor (default is 2.) for extrapolation.
+    extrap2d : bool, optional
+        If `True` (default is `False`), extrapolate in 2-d before the
+        transform; otherwise, extrapolate each row and column in 1-d.
+    threaded : bool, optional
+        If `True` (default is `False`), use multi-threading.
+
+    """
+
+    def __cinit__(self, degrees, biases, x, kr_c, lowring=True, extrap=0,
+                  extrap_exp=2., extrap2d=False, threaded=False):
+        self.thisptr = new CppDoubleSphericalBesselTransform(
+            degrees[0], degrees[1], biases[0], biases[1], threaded
+        )
+
+        cdef np.ndarray[double, ndim=1, mode='c'] _x = np.ascontiguousarray(
+            _check_1d_array(x, check_loglin=True)
+        )
+        self.thisptr.initialise(
+            _x, kr_c, lowring, 0 if extrap is None else extrap, extrap_exp,
+            extrap2d
+        )
+
+        self._nsamp = self.thisptr.nsamp
+        self._nsamp_trans = self.thisptr.nsamp_trans
+        self._logres = self.thisptr.logres
+        self._pivot = self.thisptr.pivot
+
+        self._pre_sampts = self.thisptr.pre_sampts
+        self._post_sampts = self.thisptr.post_sampts
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def transform(self, fx):
+        """Transform 2-d samples at initialised sample points.
+
+        The transform is performed with the GIL released.
+
+        Parameters
+        ----------
+        fx : (N, N) array_like
+            Pre-transform samples.  If complex with any non-zero
+            imaginary part, the real and imaginary parts are transformed
+            separately.
+
+        Returns
+        -------
+        gy : (N, N) array_like
+            Post-transform samples, real unless `fx` has any non-zero
+            imaginary part.
+
+        Raises
+        ------
+        ValueError
+            If the shape of `fx` does not match the sample size.
+
+        """
+        fx = np.asarray(fx)
+        if fx.shape != (self._nsamp, self._nsamp):
+            raise ValueError(
+                "Samples must be 2-d with the same length as the sample "
+                f"points in each dimension: {fx.shape} versus "
+                f"({self._nsamp}, {self._nsamp})."
+            )
+
+        if np.iscomplexobj(fx) and np.any(fx.imag):
+            return self._transform(fx.real) + 1j * self._transform(fx.imag)
+        return self._transform(fx.real)
+
+    def _transform(self, fx):
+        """Transform real 2-d samples at initialised sample points.
+
+        Parameters
+        ----------
+        fx : (N, N) array of float
+            Pre-transform samples.
+
+        Returns
+        -------
+        gy : (N, N) array of float
+            Post-transform samples.
+
+        """
+        cdef np.ndarray[double, ndim=2, mode='c'] fx_ = \
+            np.ascontiguousarray(fx, dtype=np.float64)
+        cdef np.ndarray[double, ndim=2, mode='c'] gy = \
+            np.zeros((self._nsamp, self._nsamp), dtype=np.float64)
+
+        cdef const double* fx_ptr = &fx_[0, 0]
+        cdef double* gy_ptr = &gy[0, 0]
+        with nogil:
+            self.thisptr.biased_transform(fx_ptr, gy_ptr)
+
+        return gy
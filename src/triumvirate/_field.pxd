@@ -4,11 +4,36 @@
 from libcpp cimport bool as bool_t
 from libcpp.string cimport string
 
+from ._particles cimport _ParticleCatalogue
 from .dataobjs cimport BinnedVectors, CppBinning
 from .parameters cimport CppParameterSet
 
 
+cdef extern from "<functional>":
+    cdef cppclass CppAliasingFunction "std::function<double(int, int, int)>":
+        double operator()(int i, int j, int k)
+
+
+cdef extern from "fftw3.h":
+    ctypedef double fftw_complex[2]
+
+    enum: FFTW_FORWARD
+    enum: FFTW_BACKWARD
+
+
 cdef extern from "include/field.hpp":
+    cdef cppclass CppMeshField "trv::MeshField":
+        CppParameterSet params
+        fftw_complex* field
+
+        CppMeshField(CppParameterSet& params, bool_t plan_ini, string name)
+
+        long long ret_grid_index(int i, int j, int k)
+
+        bool_t execute_pruned_transform(
+            fftw_complex* field_arr, int sign, double k_max
+        ) except +
+
     cdef cppclass CppFieldStats "trv::FieldStats":
         CppFieldStats(CppParameterSet& params, bool_t plan_ini)
 
@@ -16,3 +41,22 @@ cdef extern from "include/field.hpp":
             CppBinning& binning,
             string save_file
         ) except +
+
+        CppAliasingFunction ret_calc_shotnoise_aliasing_interlaced() except +
+
+    cdef cppclass CppMeshFieldCache "trv::MeshFieldCache":
+        int count_rand_computed
+        int count_rand_reused
+        int count_rand_loaded
+
+        CppMeshFieldCache()
+
+        void retain_random_fields()
+        void persist_random_fields(
+            string cache_dir, double cache_size, string catalogue_hash
+        )
+        void clear()
+
+
+cdef class _MeshFieldCache:
+    cdef CppMeshFieldCache* thisptr
@@ -6,15 +6,64 @@ Parse mesh fields and their statistics.
 
 """
 from cython.operator cimport dereference as deref
+from libc.string cimport memcpy
 
 import numpy as np
 cimport numpy as np
 
-from ._field cimport CppFieldStats
+from ._field cimport (
+    FFTW_BACKWARD, FFTW_FORWARD,
+    CppAliasingFunction, CppFieldStats, CppMeshField, CppMeshFieldCache,
+    fftw_complex
+)
+from ._particles cimport _ParticleCatalogue
 from .dataobjs cimport Binning
 from .parameters cimport ParameterSet
 
 
+cdef class _MeshFieldCache:
+    """C++ mesh field cache retaining random-source fields.
+
+    Random-source fields are retained across measurements with
+    different data-source catalogues paired with the same
+    random-source catalogue.
+
+    """
+
+    def __cinit__(self):
+        self.thisptr = new CppMeshFieldCache()
+        self.thisptr.retain_random_fields()
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @property
+    def count_rand_computed(self):
+        return self.thisptr.count_rand_computed
+
+    @property
+    def count_rand_reused(self):
+        return self.thisptr.count_rand_reused
+
+    @property
+    def count_rand_loaded(self):
+        return self.thisptr.count_rand_loaded
+
+    def persist_random_fields(self, cache_dir, double cache_size,
+                              _ParticleCatalogue particles_rand not None):
+        """Persist random-source fields in an on-disk cache keyed by
+        the content hash of the (aligned) random-source catalogue.
+
+        """
+        self.thisptr.persist_random_fields(
+            cache_dir.encode('utf-8'), cache_size,
+            particles_rand.thisptr.calc_content_hash()
+        )
+
+    def clear(self):
+        self.thisptr.clear()
+
+
 def _record_binned_vectors(Binning binning not None,
                            ParameterSet paramset not None):
     """Record binned vectors.
@@ -69,3 +118,134 @@ def _record_binned_vectors(Binning binning not None,
     binned_vectors['vecz'] = np.asarray(binned_vectors_struct.vecz)
 
     return binned_vectors
+
+
+def _calc_shotnoise_aliasing_interlaced(ParameterSet paramset not None,
+                                        indices):
+    """Calculate the shot-noise aliasing function including only
+    the aliased images which survive interlacing.
+
+    Parameters
+    ----------
+    paramset : :class:`~triumvirate.parameters.ParameterSet`
+        Parameter set for the sampling mesh grid, assignment scheme
+        and interlacing order.
+    indices : array of int, shape (N, 3)
+        Mesh grid indices.
+
+    Returns
+    -------
+    :class:`numpy.ndarray`
+        Aliasing function values at the mesh grid indices.
+
+    """
+    cdef CppFieldStats* fieldstats_ptr = new CppFieldStats(
+        deref(paramset.thisptr), False
+    )
+    cdef CppAliasingFunction calc_aliasing
+
+    indices = np.asarray(indices, dtype=int).reshape(-1, 3)
+    aliasing = np.empty(len(indices))
+    try:
+        calc_aliasing = \
+            fieldstats_ptr.ret_calc_shotnoise_aliasing_interlaced()
+        for iidx, (i, j, k) in enumerate(indices):
+            aliasing[iidx] = calc_aliasing(i, j, k)
+    finally:
+        del fieldstats_ptr
+
+    return aliasing
+
+
+def _execute_pruned_transform(ParameterSet paramset not None,
+                              field, double k_max, bint inverse=False):
+    """Execute a pruned 3-d Fourier transform of a complex field.
+
+    Parameters
+    ----------
+    paramset : :class:`~triumvirate.parameters.ParameterSet`
+        Parameter set for the sampling mesh grid.
+    field : array of complex, shape (ngrid_x, ngrid_y, ngrid_z)
+        Complex field on the mesh grid.
+    k_max : float
+        Maximum wavenumber.
+    inverse : bool, optional
+        If `True` (default is `False`), perform the inverse transform
+        (without normalisation).
+
+    Returns
+    -------
+    executed : bool
+        Whether the pruned transform has been executed.
+    :class:`numpy.ndarray`
+        Transformed field if `executed` is `True`, otherwise the
+        input field.
+
+    """
+    field = np.array(field, dtype=np.complex128, order='C', copy=True)
+    ngrid = tuple(paramset['ngrid'][axis] for axis in ['x', 'y', 'z'])
+    if field.shape != ngrid:
+        raise ValueError(
+            f"Field shape {field.shape} does not match mesh grid {ngrid}."
+        )
+
+    cdef np.ndarray[np.complex128_t, ndim=3, mode='c'] field_arr = field
+    cdef size_t nbytes = field_arr.nbytes
+    cdef bint executed
+
+    # Transform on the FFTW-allocated field array of a mesh field, which
+    # the pruned FFTW plans are created for.
+    cdef CppMeshField* meshfield_ptr = new CppMeshField(
+        deref(paramset.thisptr), True, "`pruned-field`".encode('utf-8')
+    )
+    try:
+        memcpy(<void*>meshfield_ptr.field, <void*>field_arr.data, nbytes)
+        executed = meshfield_ptr.execute_pruned_transform(
+            meshfield_ptr.field,
+            FFTW_BACKWARD if inverse else FFTW_FORWARD,
+            k_max
+        )
+        memcpy(<void*>field_arr.data, <void*>meshfield_ptr.field, nbytes)
+    finally:
+        del meshfield_ptr
+
+    return executed, field_arr
+
+
+def _ret_grid_index(ParameterSet paramset not None, int i, int j, int k):
+    """Return the grid cell index on a mesh grid.
+
+    Parameters
+    ----------
+    paramset : :class:`~triumvirate.parameters.ParameterSet`
+        Parameter set for the sampling mesh grid.
+    i, j, k : int
+        Grid index in each dimension.
+
+    Returns
+    -------
+    int
+        Grid cell index.
+
+    """
+    # The mesh field is allocated on a single grid cell and only takes
+    # the mesh grid numbers for the index, so that indices on mesh grids
+    # too large to allocate can be derived.
+    cdef CppParameterSet params_cell = deref(paramset.thisptr)
+    for iaxis in range(3):
+        params_cell.ngrid[iaxis] = 1
+    params_cell.nmesh = 1
+    params_cell.interlace = "false".encode('utf-8')
+
+    cdef CppMeshField* meshfield_ptr = new CppMeshField(
+        params_cell, False, "`grid-index`".encode('utf-8')
+    )
+    cdef long long idx_grid
+    try:
+        for iaxis in range(3):
+            meshfield_ptr.params.ngrid[iaxis] = paramset.thisptr.ngrid[iaxis]
+        idx_grid = meshfield_ptr.ret_grid_index(i, j, k)
+    finally:
+        del meshfield_ptr
+
+    return idx_grid
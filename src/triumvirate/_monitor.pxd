@@ -0,0 +1,93 @@
+"""Interface with program tracking and profiling.
+
+"""
+from libcpp.map cimport map as cppmap
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+
+cdef extern from "include/monitor.hpp":
+    cdef cppclass CppStageProfile "trv::sys::StageProfile":
+        long long ncalls
+        double time_total
+        double time_self
+        double gbytes
+        double gbytes_mem
+        int nthreads
+
+    cdef cppclass CppProfiler "trv::sys::Profiler":
+        vector[string] stages
+        cppmap[string, CppStageProfile] profiles
+
+        void reset()
+
+    CppProfiler profiler "trv::sys::profiler"
+
+    double gbytesMem "trv::sys::gbytesMem"
+    double gbytesMaxMem "trv::sys::gbytesMaxMem"
+    int count_fft "trv::sys::count_fft"
+    int count_ifft "trv::sys::count_ifft"
+
+
+cdef inline void _reset_stage_profile():
+    """Reset the stage profile of the calling thread.
+
+    """
+    profiler.reset()
+
+
+cdef inline dict _get_stage_profile():
+    """Get the stage profile of the calling thread.
+
+    Returns
+    -------
+    dict of {str: dict}
+        Stage profile as a dictionary keyed by stage name, with each
+        entry containing 'ncalls', 'time_total', 'time_self' (in
+        seconds), 'gbytes' (estimated data touched in gibibytes),
+        'gbytes_mem' (peak memory usage in gibibytes) and 'nthreads'.
+
+    """
+    cdef dict stage_profile = {}
+    cdef string stage
+    cdef CppStageProfile profile
+    for stage in profiler.stages:
+        profile = profiler.profiles[stage]
+        stage_profile[stage.decode('utf-8')] = {
+            'ncalls': profile.ncalls,
+            'time_total': profile.time_total,
+            'time_self': profile.time_self,
+            'gbytes': profile.gbytes,
+            'gbytes_mem': profile.gbytes_mem,
+            'nthreads': profile.nthreads,
+        }
+    return stage_profile
+
+
+cdef inline void _reset_resource_usage():
+    """Reset the (I)FFT counts and maximum memory usage of the calling
+    thread.
+
+    """
+    global gbytesMaxMem, count_fft, count_ifft
+    gbytesMaxMem = gbytesMem
+    count_fft = 0
+    count_ifft = 0
+
+
+cdef inline dict _get_resource_usage():
+    """Get the (I)FFT counts and maximum memory usage of the calling
+    thread.
+
+    Returns
+    -------
+    dict of {str: int or float}
+        Resource usage containing 'count_fft', 'count_ifft' and
+        'gbytes_max' (maximum memory usage in gibibytes).
+
+    """
+    return {
+        'count_fft': count_fft,
+        'count_ifft': count_ifft,
+        'gbytes_max': gbytesMaxMem,
+    }
@@ -1,11 +1,17 @@
 """Interface with the particle catalogue.
 
 """
+from libcpp.string cimport string
 from libcpp.vector cimport vector
 
+from .dataobjs cimport LineOfSight
+
 
 cdef extern from "include/particles.hpp":
     cdef cppclass CppParticleCatalogue "trv::ParticleCatalogue":
+        long long ntotal
+        double observer[3]
+
         CppParticleCatalogue(int verbose)
 
         int load_particle_data(
@@ -13,6 +19,49 @@ cdef extern from "include/particles.hpp":
             vector[double] nz, vector[double] ws, vector[double] wc
         ) except +
 
+        int wrap_particle_data(
+            long long num,
+            double* x, double* y, double* z,
+            double* nz, double* ws, double* wc
+        ) except +
+
+        string calc_content_hash() except +
+
+    cdef cppclass CppLineOfSightPolicy "trv::LineOfSightPolicy":
+        CppLineOfSightPolicy()
+        CppLineOfSightPolicy(LineOfSight* los)
+
+        @staticmethod
+        CppLineOfSightPolicy global_axis(const double axis[3])
+
+
+cdef extern from "include/synthetic.hpp":
+    cdef cppclass CppSyntheticCatalogueSpec "trv::SyntheticCatalogueSpec":
+        long long num
+
+    cdef cppclass CppSyntheticCatalogueGenerator \
+            "trv::SyntheticCatalogueGenerator":
+        CppSyntheticCatalogueGenerator(
+            const CppSyntheticCatalogueSpec& spec
+        ) except +
+
+        @staticmethod
+        CppSyntheticCatalogueSpec parse_spec(
+            const string& source, double volume
+        ) except +
+
+        long long count_particles() except +
+
+        void generate_particles(
+            double* x, double* y, double* z, double* nz
+        ) nogil except +
+
 
 cdef class _ParticleCatalogue:
     cdef CppParticleCatalogue* thisptr
+    cdef tuple _pdata_buffers
+
+
+cdef CppLineOfSightPolicy _view_lines_of_sight(
+    object los, _ParticleCatalogue particles
+) except *
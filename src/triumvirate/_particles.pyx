@@ -5,27 +5,149 @@ Catalogue Parser (:mod:`~triumvirate._particles`)
 Parse Python catalogue objects into C++ particle catalogues.
 
 """
+import numpy as np
 cimport numpy as np
 
-from ._particles cimport CppParticleCatalogue
+from ._particles cimport (
+    CppLineOfSightPolicy,
+    CppParticleCatalogue,
+    CppSyntheticCatalogueGenerator,
+    CppSyntheticCatalogueSpec,
+)
+from .dataobjs cimport LineOfSight
 
 
 cdef class _ParticleCatalogue:
+    """C++ particle catalogue wrapping NumPy particle data buffers.
 
-    def __cinit__(
-        self,
-        np.ndarray[double, ndim=1, mode='c'] x not None,
-        np.ndarray[double, ndim=1, mode='c'] y not None,
-        np.ndarray[double, ndim=1, mode='c'] z not None,
-        np.ndarray[double, ndim=1, mode='c'] nz not None,
-        np.ndarray[double, ndim=1, mode='c'] ws not None,
-        np.ndarray[double, ndim=1, mode='c'] wc not None,
-        verbose=-1
-    ):
+    Particle data columns are wrapped without copying, unless they are
+    not contiguous or not of double precision, in which case they are
+    compacted first.  References to the buffers are kept for the
+    lifetime of the catalogue.
+
+    """
+
+    def __cinit__(self, x, y, z, nz, ws, wc, observer=None, verbose=-1):
+
+        self._pdata_buffers = tuple(
+            np.ascontiguousarray(col, dtype=np.float64)
+            for col in (x, y, z, nz, ws, wc)
+        )
+
+        cdef long long ntotal = len(self._pdata_buffers[0])
+        if any(len(col) != ntotal for col in self._pdata_buffers):
+            raise ValueError("Inconsistent particle data dimensions.")
+
+        cdef const double[::1] x_, y_, z_, nz_, ws_, wc_
+        x_, y_, z_, nz_, ws_, wc_ = self._pdata_buffers
 
         self.thisptr = new CppParticleCatalogue(verbose)
 
-        self.thisptr.load_particle_data(x, y, z, nz, ws, wc)
+        if ntotal > 0:
+            self.thisptr.wrap_particle_data(
+                ntotal,
+                <double*>&x_[0], <double*>&y_[0], <double*>&z_[0],
+                <double*>&nz_[0], <double*>&ws_[0], <double*>&wc_[0]
+            )
+        else:
+            self.thisptr.wrap_particle_data(
+                ntotal, NULL, NULL, NULL, NULL, NULL, NULL
+            )
+
+        if observer is not None:
+            for iaxis in range(3):
+                self.thisptr.observer[iaxis] = observer[iaxis]
 
     def __dealloc__(self):
         del self.thisptr
+
+
+def _generate_synthetic_particles(source):
+    """Generate synthetic particle data from a specification.
+
+    Parameters
+    ----------
+    source : str
+        Synthetic catalogue specification (see
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.generate_synthetic`).
+
+    Returns
+    -------
+    tuple of (N,) :class:`numpy.ndarray`
+        Particle coordinates 'x', 'y', 'z' and expected number density
+        'nz'.
+
+    """
+    cdef CppSyntheticCatalogueSpec spec = \
+        CppSyntheticCatalogueGenerator.parse_spec(source.encode('utf-8'), 0.)
+    cdef CppSyntheticCatalogueGenerator* generator = \
+        new CppSyntheticCatalogueGenerator(spec)
+
+    cdef long long ntotal
+    cdef double[::1] x_, y_, z_, nz_
+    try:
+        ntotal = generator.count_particles()
+
+        x, y, z, nz = (np.empty(ntotal, dtype=np.float64) for _ in range(4))
+        if ntotal > 0:
+            x_, y_, z_, nz_ = x, y, z, nz
+            with nogil:
+                generator.generate_particles(
+                    &x_[0], &y_[0], &z_[0], &nz_[0]
+                )
+    finally:
+        del generator
+
+    return x, y, z, nz
+
+
+cdef CppLineOfSightPolicy _view_lines_of_sight(
+        object los, _ParticleCatalogue particles
+    ) except *:
+    """View lines of sight as a C++ line-of-sight policy without copying.
+
+    Parameters
+    ----------
+    los : (N, 3) or (3,) array of float or None
+        C-contiguous lines of sight, or a global line-of-sight axis for
+        all particles.  If `None`, the local line of sight is evaluated
+        on the fly.
+    particles : :class:`~triumvirate._particles._ParticleCatalogue`
+        Particle catalogue to which the lines of sight correspond.
+
+    Returns
+    -------
+    CppLineOfSightPolicy
+        Line-of-sight policy (viewing any lines-of-sight buffer).
+
+    Raises
+    ------
+    ValueError
+        If the lines-of-sight dimensions do not match the catalogue,
+        or the global line-of-sight axis is null.
+
+    """
+    if los is None:
+        return CppLineOfSightPolicy()
+
+    cdef double[::1] axis_
+    if np.ndim(los) == 1:
+        axis_ = los
+        if axis_.shape[0] != 3:
+            raise ValueError(
+                "Global line-of-sight axis must have 3 components: "
+                "({},).".format(axis_.shape[0])
+            )
+        if axis_[0] == 0. and axis_[1] == 0. and axis_[2] == 0.:
+            raise ValueError("Global line-of-sight axis must be non-null.")
+        return CppLineOfSightPolicy.global_axis(&axis_[0])
+
+    cdef double[:, ::1] los_ = los
+    if los_.shape[0] != particles.thisptr.ntotal or los_.shape[1] != 3:
+        raise ValueError(
+            "Line-of-sight dimensions do not match the catalogue: "
+            "({}, {}) versus ({}, 3)."
+            .format(los_.shape[0], los_.shape[1], particles.thisptr.ntotal)
+        )
+
+    return CppLineOfSightPolicy(<LineOfSight*>&los_[0, 0])
@@ -6,16 +6,22 @@ Declare and interface with three-point correlator algorithms.
 
 """
 from cython.operator cimport dereference as deref
-from libc.stdlib cimport free, malloc
 from libcpp cimport bool as bool_t
 
 import numpy as np
 cimport numpy as np
 
-from ._particles cimport CppParticleCatalogue, _ParticleCatalogue
+from ._field cimport CppMeshFieldCache, _MeshFieldCache
+from ._monitor cimport (
+    _get_resource_usage, _get_stage_profile,
+    _reset_resource_usage, _reset_stage_profile
+)
+from ._particles cimport (
+    CppLineOfSightPolicy, CppParticleCatalogue, _ParticleCatalogue,
+    _view_lines_of_sight
+)
 from .dataobjs cimport (
     Binning, CppBinning,
-    LineOfSight,
     BispecMeasurements, ThreePCFMeasurements, ThreePCFWindowMeasurements
 )
 from .parameters cimport CppParameterSet, ParameterSet
@@ -47,22 +53,24 @@ cdef extern from "include/threept.hpp":
     BispecMeasurements compute_bispec_cpp "trv::compute_bispec" (
         CppParticleCatalogue& catalogue_data,
         CppParticleCatalogue& catalogue_rand,
-        LineOfSight* los_data,
-        LineOfSight* los_rand,
+        const CppLineOfSightPolicy& los_data,
+        const CppLineOfSightPolicy& los_rand,
         CppParameterSet& params,
         CppBinning& kbinning,
-        double norm_factor
-    )
+        double norm_factor,
+        CppMeshFieldCache* field_cache
+    ) nogil except +
 
     ThreePCFMeasurements compute_3pcf_cpp "trv::compute_3pcf" (
         CppParticleCatalogue& catalogue_data,
         CppParticleCatalogue& catalogue_rand,
-        LineOfSight* los_data,
-        LineOfSight* los_rand,
+        const CppLineOfSightPolicy& los_data,
+        const CppLineOfSightPolicy& los_rand,
         CppParameterSet& params,
         CppBinning& rbinning,
-        double norm_factor
-    )
+        double norm_factor,
+        CppMeshFieldCache* field_cache
+    ) nogil except +
 
     BispecMeasurements compute_bispec_in_gpp_box_cpp \
         "trv::compute_bispec_in_gpp_box" (
@@ -70,7 +78,7 @@ cdef extern from "include/threept.hpp":
             CppParameterSet& params,
             CppBinning& kbinning,
             double norm_factor
-        )
+        ) nogil except +
 
     ThreePCFMeasurements compute_3pcf_in_gpp_box_cpp \
         "trv::compute_3pcf_in_gpp_box" (
@@ -78,18 +86,18 @@ cdef extern from "include/threept.hpp":
             CppParameterSet& params,
             CppBinning& rbinning,
             double norm_factor
-        )
+        ) nogil except +
 
     ThreePCFWindowMeasurements compute_3pcf_window_cpp \
         "trv::compute_3pcf_window" (
             CppParticleCatalogue& catalogue_rand,
-            LineOfSight* los_rand,
+            const CppLineOfSightPolicy& los_rand,
             CppParameterSet& params,
             CppBinning& rbinning,
             double alpha,
             double norm_factor,
             bool_t wide_angle
-        )
+        ) nogil except +
 
     # BispecMeasurements compute_bispec_for_los_choice_cpp \
     #     "trv::compute_bispec_for_los_choice" (
@@ -125,39 +133,38 @@ def _calc_bispec_normalisation_from_mesh(
 def _compute_bispec(
         _ParticleCatalogue catalogue_data not None,
         _ParticleCatalogue catalogue_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_data not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        np.ndarray los_data,
+        np.ndarray los_rand,
         ParameterSet params not None,
         Binning kbinning not None,
-        double norm_factor
+        double norm_factor,
+        _MeshFieldCache field_cache=None
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_data_cpp = <LineOfSight*>malloc(
-        len(los_data) * sizeof(LineOfSight)
+    # View lines of sight per particle or along a global axis (`None` for
+    # local lines of sight evaluated on the fly).
+    cdef CppLineOfSightPolicy los_data_cpp = _view_lines_of_sight(
+        los_data, catalogue_data
     )
-    for pid, (los_x, los_y, los_z) in enumerate(los_data):
-        los_data_cpp[pid].pos[0] = los_x
-        los_data_cpp[pid].pos[1] = los_y
-        los_data_cpp[pid].pos[2] = los_z
 
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
+    cdef CppLineOfSightPolicy los_rand_cpp = _view_lines_of_sight(
+        los_rand, catalogue_rand
     )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
+
+    # Share the mesh field cache if given.
+    cdef CppMeshFieldCache* field_cache_cpp = NULL
+    if field_cache is not None:
+        field_cache_cpp = field_cache.thisptr
 
     # Run algorithm.
     cdef BispecMeasurements results
-    results = compute_bispec_cpp(
-        deref(catalogue_data.thisptr), deref(catalogue_rand.thisptr),
-        los_data_cpp, los_rand_cpp,
-        deref(params.thisptr), deref(kbinning.thisptr),
-        norm_factor
-    )
-
-    free(los_data_cpp); free(los_rand_cpp)
+    _reset_stage_profile()
+    with nogil:
+        results = compute_bispec_cpp(
+            deref(catalogue_data.thisptr), deref(catalogue_rand.thisptr),
+            los_data_cpp, los_rand_cpp,
+            deref(params.thisptr), deref(kbinning.thisptr),
+            norm_factor, field_cache_cpp
+        )
 
     return {
         'k1_bin': np.asarray(results.k1_bin),
@@ -168,45 +175,45 @@ def _compute_bispec(
         'nmodes_2': np.asarray(results.nmodes_2),
         'bk_raw': np.asarray(results.bk_raw),
         'bk_shot': np.asarray(results.bk_shot),
+        'profile': _get_stage_profile(),
     }
 
 
 def _compute_3pcf(
         _ParticleCatalogue catalogue_data not None,
         _ParticleCatalogue catalogue_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_data not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        np.ndarray los_data,
+        np.ndarray los_rand,
         ParameterSet params not None,
         Binning rbinning not None,
-        double norm_factor
+        double norm_factor,
+        _MeshFieldCache field_cache=None
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_data_cpp = <LineOfSight*>malloc(
-        len(los_data) * sizeof(LineOfSight)
+    # View lines of sight per particle or along a global axis (`None` for
+    # local lines of sight evaluated on the fly).
+    cdef CppLineOfSightPolicy los_data_cpp = _view_lines_of_sight(
+        los_data, catalogue_data
     )
-    for pid, (los_x, los_y, los_z) in enumerate(los_data):
-        los_data_cpp[pid].pos[0] = los_x
-        los_data_cpp[pid].pos[1] = los_y
-        los_data_cpp[pid].pos[2] = los_z
 
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
+    cdef CppLineOfSightPolicy los_rand_cpp = _view_lines_of_sight(
+        los_rand, catalogue_rand
     )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
+
+    # Share the mesh field cache if given.
+    cdef CppMeshFieldCache* field_cache_cpp = NULL
+    if field_cache is not None:
+        field_cache_cpp = field_cache.thisptr
 
     # Run algorithm.
     cdef ThreePCFMeasurements results
-    results = compute_3pcf_cpp(
-        deref(catalogue_data.thisptr), deref(catalogue_rand.thisptr),
-        los_data_cpp, los_rand_cpp,
-        deref(params.thisptr), deref(rbinning.thisptr),
-        norm_factor
-    )
-
-    free(los_data_cpp); free(los_rand_cpp)
+    _reset_stage_profile()
+    with nogil:
+        results = compute_3pcf_cpp(
+            deref(catalogue_data.thisptr), deref(catalogue_rand.thisptr),
+            los_data_cpp, los_rand_cpp,
+            deref(params.thisptr), deref(rbinning.thisptr),
+            norm_factor, field_cache_cpp
+        )
 
     return {
         'r1_bin': np.asarray(results.r1_bin),
@@ -217,6 +224,7 @@ def _compute_3pcf(
         'npairs_2': np.asarray(results.npairs_2),
         'zeta_raw': np.asarray(results.zeta_raw),
         'zeta_shot': np.asarray(results.zeta_shot),
+        'profile': _get_stage_profile(),
     }
 
 
@@ -227,11 +235,13 @@ def _compute_bispec_in_gpp_box(
         double norm_factor
     ):
     cdef BispecMeasurements results
-    results = compute_bispec_in_gpp_box_cpp(
-        deref(catalogue_data.thisptr),
-        deref(params.thisptr), deref(kbinning.thisptr),
-        norm_factor
-    )
+    _reset_stage_profile()
+    with nogil:
+        results = compute_bispec_in_gpp_box_cpp(
+            deref(catalogue_data.thisptr),
+            deref(params.thisptr), deref(kbinning.thisptr),
+            norm_factor
+        )
 
     return {
         'k1_bin': np.asarray(results.k1_bin),
@@ -242,6 +252,7 @@ def _compute_bispec_in_gpp_box(
         'nmodes_2': np.asarray(results.nmodes_2),
         'bk_raw': np.asarray(results.bk_raw),
         'bk_shot': np.asarray(results.bk_shot),
+        'profile': _get_stage_profile(),
     }
 
 
@@ -252,11 +263,13 @@ def _compute_3pcf_in_gpp_box(
         double norm_factor
     ):
     cdef ThreePCFMeasurements results
-    results = compute_3pcf_in_gpp_box_cpp(
-        deref(catalogue_data.thisptr),
-        deref(params.thisptr), deref(rbinning.thisptr),
-        norm_factor
-    )
+    _reset_stage_profile()
+    with nogil:
+        results = compute_3pcf_in_gpp_box_cpp(
+            deref(catalogue_data.thisptr),
+            deref(params.thisptr), deref(rbinning.thisptr),
+            norm_factor
+        )
 
     return {
         'r1_bin': np.asarray(results.r1_bin),
@@ -267,37 +280,35 @@ def _compute_3pcf_in_gpp_box(
         'npairs_2': np.asarray(results.npairs_2),
         'zeta_raw': np.asarray(results.zeta_raw),
         'zeta_shot': np.asarray(results.zeta_shot),
+        'profile': _get_stage_profile(),
     }
 
 
 def _compute_3pcf_window(
         _ParticleCatalogue catalogue_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        np.ndarray los_rand,
         ParameterSet params not None,
         Binning rbinning not None,
         double alpha,
         double norm_factor,
         bool_t wide_angle
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
+    # View lines of sight per particle or along a global axis (`None` for
+    # local lines of sight evaluated on the fly).
+    cdef CppLineOfSightPolicy los_rand_cpp = _view_lines_of_sight(
+        los_rand, catalogue_rand
     )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
 
     # Run algorithm.
     cdef ThreePCFWindowMeasurements results
-    results = compute_3pcf_window_cpp(
-        deref(catalogue_rand.thisptr), los_rand_cpp,
-        deref(params.thisptr), deref(rbinning.thisptr),
-        alpha, norm_factor,
-        wide_angle
-    )
-
-    free(los_rand_cpp)
+    _reset_stage_profile()
+    with nogil:
+        results = compute_3pcf_window_cpp(
+            deref(catalogue_rand.thisptr), los_rand_cpp,
+            deref(params.thisptr), deref(rbinning.thisptr),
+            alpha, norm_factor,
+            wide_angle
+        )
 
     return {
         'r1_bin': np.asarray(results.r1_bin),
@@ -308,35 +319,51 @@ def _compute_3pcf_window(
         'npairs_2': np.asarray(results.npairs_2),
         'zeta_raw': np.asarray(results.zeta_raw),
         'zeta_shot': np.asarray(results.zeta_shot),
+        'profile': _get_stage_profile(),
     }
 
 
+def _reset_tracked_resource_usage():
+    """Reset the (I)FFT counts and maximum memory usage tracked on
+    the calling thread.
+
+    """
+    _reset_resource_usage()
+
+
+def _get_tracked_resource_usage():
+    """Get the (I)FFT counts and maximum memory usage tracked on
+    the calling thread, including those of worker threads.
+
+    Returns
+    -------
+    dict of {str: int or float}
+        Resource usage containing 'count_fft', 'count_ifft' and
+        'gbytes_max' (maximum memory usage in gibibytes).
+
+    """
+    return _get_resource_usage()
+
+
 # def _compute_bispec_for_los_choice(
 #         _ParticleCatalogue catalogue_data not None,
 #         _ParticleCatalogue catalogue_rand not None,
-#         np.ndarray[double, ndim=2, mode='c'] los_data not None,
-#         np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+#         np.ndarray[double, ndim=2, mode='c'] los_data,
+#         np.ndarray[double, ndim=2, mode='c'] los_rand,
 #         int los_choice,
 #         ParameterSet params not None,
 #         Binning kbinning not None,
 #         double norm_factor
 #     ):
-#     # Parse lines of sight per particle.
-#     cdef LineOfSight* los_data_cpp = <LineOfSight*>malloc(
-#         len(los_data) * sizeof(LineOfSight)
+#     # View lines of sight per particle (`None` for local lines of sight
+#     # evaluated on the fly).
+#     cdef LineOfSight* los_data_cpp = _view_lines_of_sight(
+#         los_data, catalogue_data
 #     )
-#     for pid, (los_x, los_y, los_z) in enumerate(los_data):
-#         los_data_cpp[pid].pos[0] = los_x
-#         los_data_cpp[pid].pos[1] = los_y
-#         los_data_cpp[pid].pos[2] = los_z
 
-#     cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-#         len(los_rand) * sizeof(LineOfSight)
+#     cdef LineOfSight* los_rand_cpp = _view_lines_of_sight(
+#         los_rand, catalogue_rand
 #     )
-#     for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-#         los_rand_cpp[pid].pos[0] = los_x
-#         los_rand_cpp[pid].pos[1] = los_y
-#         los_rand_cpp[pid].pos[2] = los_z
 
 #     # Run algorithm.
 #     cdef BispecMeasurements results
@@ -347,8 +374,6 @@ def _compute_3pcf_window(
 #         norm_factor
 #     )
 
-#     free(los_data_cpp); free(los_rand_cpp)
-
 #     return {
 #         'k1_bin': np.asarray(results.k1_bin),
 #         'k2_bin': np.asarray(results.k2_bin),
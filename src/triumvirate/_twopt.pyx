@@ -6,17 +6,22 @@ Declare and interface with two-point correlator algorithms.
 
 """
 from cython.operator cimport dereference as deref
-from libc.stdlib cimport free, malloc
 from libcpp.string cimport string
+from libcpp.vector cimport vector
 
 import numpy as np
 cimport numpy as np
 
-from ._particles cimport CppParticleCatalogue, _ParticleCatalogue
+from ._field cimport CppMeshFieldCache, _MeshFieldCache
+from ._monitor cimport _get_stage_profile, _reset_stage_profile
+from ._particles cimport (
+    CppLineOfSightPolicy, CppParticleCatalogue, _ParticleCatalogue,
+    _view_lines_of_sight
+)
 from .dataobjs cimport (
     Binning, CppBinning,
-    LineOfSight,
-    PowspecMeasurements, TwoPCFMeasurements, TwoPCFWindowMeasurements
+    PowspecMeasurements, PowspecKMuMeasurements,
+    TwoPCFMeasurements, TwoPCFWindowMeasurements
 )
 from .parameters cimport CppParameterSet, ParameterSet
 
@@ -66,22 +71,24 @@ cdef extern from "include/twopt.hpp":
     PowspecMeasurements compute_powspec_cpp "trv::compute_powspec" (
         CppParticleCatalogue& catalogue_data,
         CppParticleCatalogue& catalogue_rand,
-        LineOfSight* los_data,
-        LineOfSight* los_rand,
+        const CppLineOfSightPolicy& los_data,
+        const CppLineOfSightPolicy& los_rand,
         CppParameterSet& params,
         CppBinning& kbinning,
-        double norm_factor
-    )
+        double norm_factor,
+        CppMeshFieldCache* field_cache
+    ) nogil except +
 
     TwoPCFMeasurements compute_corrfunc_cpp "trv::compute_corrfunc" (
         CppParticleCatalogue& catalogue_data,
         CppParticleCatalogue& catalogue_rand,
-        LineOfSight* los_data,
-        LineOfSight* los_rand,
+        const CppLineOfSightPolicy& los_data,
+        const CppLineOfSightPolicy& los_rand,
         CppParameterSet& params,
         CppBinning& rbinning,
-        double norm_factor
-    )
+        double norm_factor,
+        CppMeshFieldCache* field_cache
+    ) nogil except +
 
     PowspecMeasurements compute_powspec_in_gpp_box_cpp \
         "trv::compute_powspec_in_gpp_box" (
@@ -89,7 +96,17 @@ cdef extern from "include/twopt.hpp":
             CppParameterSet& params,
             CppBinning& kbinning,
             double norm_factor
-        )
+        ) nogil except +
+
+    PowspecKMuMeasurements compute_powspec_kmu_in_gpp_box_cpp \
+        "trv::compute_powspec_kmu_in_gpp_box" (
+            CppParticleCatalogue& catalogue_data,
+            CppParameterSet& params,
+            CppBinning& kbinning,
+            vector[int]& ells,
+            int num_wedges,
+            double norm_factor
+        ) nogil except +
 
     TwoPCFMeasurements compute_corrfunc_in_gpp_box_cpp \
         "trv::compute_corrfunc_in_gpp_box" (
@@ -97,17 +114,17 @@ cdef extern from "include/twopt.hpp":
             CppParameterSet& params,
             CppBinning& rbinning,
             double norm_factor
-        )
+        ) nogil except +
 
     TwoPCFWindowMeasurements compute_corrfunc_window_cpp \
         "trv::compute_corrfunc_window" (
             CppParticleCatalogue& catalogue_rand,
-            LineOfSight* los_rand,
+            const CppLineOfSightPolicy& los_rand,
             CppParameterSet& params,
             CppBinning& rbinning,
             double alpha,
             double norm_factor
-        )
+        ) nogil except +
 
 
 def _calc_powspec_normalisation_from_particles(
@@ -161,39 +178,38 @@ def _calc_powspec_normalisation_from_meshes(
 def _compute_powspec(
         _ParticleCatalogue catalogue_data not None,
         _ParticleCatalogue catalogue_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_data not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        np.ndarray los_data,
+        np.ndarray los_rand,
         ParameterSet params not None,
         Binning kbinning not None,
-        double norm_factor
+        double norm_factor,
+        _MeshFieldCache field_cache=None
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_data_cpp = <LineOfSight*>malloc(
-        len(los_data) * sizeof(LineOfSight)
+    # View lines of sight per particle or along a global axis (`None` for
+    # local lines of sight evaluated on the fly).
+    cdef CppLineOfSightPolicy los_data_cpp = _view_lines_of_sight(
+        los_data, catalogue_data
     )
-    for pid, (los_x, los_y, los_z) in enumerate(los_data):
-        los_data_cpp[pid].pos[0] = los_x
-        los_data_cpp[pid].pos[1] = los_y
-        los_data_cpp[pid].pos[2] = los_z
 
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
+    cdef CppLineOfSightPolicy los_rand_cpp = _view_lines_of_sight(
+        los_rand, catalogue_rand
     )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
+
+    # Share the mesh field cache if given.
+    cdef CppMeshFieldCache* field_cache_cpp = NULL
+    if field_cache is not None:
+        field_cache_cpp = field_cache.thisptr
 
     # Run algorithm.
     cdef PowspecMeasurements results
-    results = compute_powspec_cpp(
-        deref(catalogue_data.thisptr), deref(catalogue_rand.thisptr),
-        los_data_cpp, los_rand_cpp,
-        deref(params.thisptr), deref(kbinning.thisptr),
-        norm_factor
-    )
-
-    free(los_data_cpp); free(los_rand_cpp)
+    _reset_stage_profile()
+    with nogil:
+        results = compute_powspec_cpp(
+            deref(catalogue_data.thisptr), deref(catalogue_rand.thisptr),
+            los_data_cpp, los_rand_cpp,
+            deref(params.thisptr), deref(kbinning.thisptr),
+            norm_factor, field_cache_cpp
+        )
 
     return {
         'kbin': np.asarray(results.kbin),
@@ -201,51 +217,52 @@ def _compute_powspec(
         'nmodes': np.asarray(results.nmodes),
         'pk_raw': np.asarray(results.pk_raw),
         'pk_shot': np.asarray(results.pk_shot),
+        'profile': _get_stage_profile(),
     }
 
 
 def _compute_corrfunc(
         _ParticleCatalogue catalogue_data not None,
         _ParticleCatalogue catalogue_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_data not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        np.ndarray los_data,
+        np.ndarray los_rand,
         ParameterSet params not None,
         Binning rbinning not None,
-        double norm_factor
+        double norm_factor,
+        _MeshFieldCache field_cache=None
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_data_cpp = <LineOfSight*>malloc(
-        len(los_data) * sizeof(LineOfSight)
+    # View lines of sight per particle or along a global axis (`None` for
+    # local lines of sight evaluated on the fly).
+    cdef CppLineOfSightPolicy los_data_cpp = _view_lines_of_sight(
+        los_data, catalogue_data
     )
-    for pid, (los_x, los_y, los_z) in enumerate(los_data):
-        los_data_cpp[pid].pos[0] = los_x
-        los_data_cpp[pid].pos[1] = los_y
-        los_data_cpp[pid].pos[2] = los_z
 
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
+    cdef CppLineOfSightPolicy los_rand_cpp = _view_lines_of_sight(
+        los_rand, catalogue_rand
     )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
+
+    # Share the mesh field cache if given.
+    cdef CppMeshFieldCache* field_cache_cpp = NULL
+    if field_cache is not None:
+        field_cache_cpp = field_cache.thisptr
 
     # Run algorithm.
     cdef TwoPCFMeasurements results
-    results = compute_corrfunc_cpp(
-        deref(catalogue_data.thisptr), deref(catalogue_rand.thisptr),
-        los_data_cpp, los_rand_cpp,
-        deref(params.thisptr), deref(rbinning.thisptr),
-        norm_factor
-    )
-
-    free(los_data_cpp); free(los_rand_cpp)
+    _reset_stage_profile()
+    with nogil:
+        results = compute_corrfunc_cpp(
+            deref(catalogue_data.thisptr), deref(catalogue_rand.thisptr),
+            los_data_cpp, los_rand_cpp,
+            deref(params.thisptr), deref(rbinning.thisptr),
+            norm_factor, field_cache_cpp
+        )
 
     return {
         'rbin': np.asarray(results.rbin),
         'reff': np.asarray(results.reff),
         'npairs': np.asarray(results.npairs),
         'xi': np.asarray(results.xi),
+        'profile': _get_stage_profile(),
     }
 
 
@@ -256,11 +273,13 @@ def _compute_powspec_in_gpp_box(
         double norm_factor
     ):
     cdef PowspecMeasurements results
-    results = compute_powspec_in_gpp_box_cpp(
-        deref(catalogue_data.thisptr),
-        deref(params.thisptr), deref(kbinning.thisptr),
-        norm_factor
-    )
+    _reset_stage_profile()
+    with nogil:
+        results = compute_powspec_in_gpp_box_cpp(
+            deref(catalogue_data.thisptr),
+            deref(params.thisptr), deref(kbinning.thisptr),
+            norm_factor
+        )
 
     return {
         'kbin': np.asarray(results.kbin),
@@ -268,6 +287,49 @@ def _compute_powspec_in_gpp_box(
         'nmodes': np.asarray(results.nmodes),
         'pk_raw': np.asarray(results.pk_raw),
         'pk_shot': np.asarray(results.pk_shot),
+        'profile': _get_stage_profile(),
+    }
+
+
+def _compute_powspec_kmu_in_gpp_box(
+        _ParticleCatalogue catalogue_data not None,
+        ParameterSet params not None,
+        Binning kbinning not None,
+        vector[int] ells,
+        int num_wedges,
+        double norm_factor
+    ):
+    cdef PowspecKMuMeasurements results
+    _reset_stage_profile()
+    with nogil:
+        results = compute_powspec_kmu_in_gpp_box_cpp(
+            deref(catalogue_data.thisptr),
+            deref(params.thisptr), deref(kbinning.thisptr),
+            ells, num_wedges, norm_factor
+        )
+
+    # Multipole and wedge entries are flattened with the wavenumber bin
+    # index running fastest.
+    shape_poles = (results.ells.size(), results.dim)
+    shape_wedges = (results.num_wedges, results.dim)
+
+    return {
+        'ells': np.asarray(results.ells),
+        'kbin': np.asarray(results.kbin),
+        'keff': np.asarray(results.keff),
+        'nmodes': np.asarray(results.nmodes),
+        'pk_raw': np.asarray(results.pk_raw).reshape(shape_poles),
+        'pk_shot': np.asarray(results.pk_shot).reshape(shape_poles),
+        'mu_edges': np.asarray(results.mu_edges),
+        'keff_wedges': np.asarray(results.keff_wedges).reshape(shape_wedges),
+        'mueff_wedges': np.asarray(results.mueff_wedges).reshape(shape_wedges),
+        'nmodes_wedges':
+            np.asarray(results.nmodes_wedges).reshape(shape_wedges),
+        'pk_raw_wedges':
+            np.asarray(results.pk_raw_wedges).reshape(shape_wedges),
+        'pk_shot_wedges':
+            np.asarray(results.pk_shot_wedges).reshape(shape_wedges),
+        'profile': _get_stage_profile(),
     }
 
 
@@ -278,50 +340,51 @@ def _compute_corrfunc_in_gpp_box(
         double norm_factor
     ):
     cdef TwoPCFMeasurements results
-    results = compute_corrfunc_in_gpp_box_cpp(
-        deref(catalogue_data.thisptr),
-        deref(params.thisptr), deref(rbinning.thisptr),
-        norm_factor
-    )
+    _reset_stage_profile()
+    with nogil:
+        results = compute_corrfunc_in_gpp_box_cpp(
+            deref(catalogue_data.thisptr),
+            deref(params.thisptr), deref(rbinning.thisptr),
+            norm_factor
+        )
 
     return {
         'rbin': np.asarray(results.rbin),
         'reff': np.asarray(results.reff),
         'npairs': np.asarray(results.npairs),
         'xi': np.asarray(results.xi),
+        'profile': _get_stage_profile(),
     }
 
 
 def _compute_corrfunc_window(
         _ParticleCatalogue catalogue_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        np.ndarray los_rand,
         ParameterSet params not None,
         Binning rbinning not None,
         double alpha,
         double norm_factor
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
+    # View lines of sight per particle or along a global axis (`None` for
+    # local lines of sight evaluated on the fly).
+    cdef CppLineOfSightPolicy los_rand_cpp = _view_lines_of_sight(
+        los_rand, catalogue_rand
     )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
 
     # Run algorithm.
     cdef TwoPCFWindowMeasurements results
-    results = compute_corrfunc_window_cpp(
-        deref(catalogue_rand.thisptr), los_rand_cpp,
-        deref(params.thisptr), deref(rbinning.thisptr),
-        alpha, norm_factor
-    )
-
-    free(los_rand_cpp)
+    _reset_stage_profile()
+    with nogil:
+        results = compute_corrfunc_window_cpp(
+            deref(catalogue_rand.thisptr), los_rand_cpp,
+            deref(params.thisptr), deref(rbinning.thisptr),
+            alpha, norm_factor
+        )
 
     return {
         'rbin': np.asarray(results.rbin),
         'reff': np.asarray(results.reff),
         'npairs': np.asarray(results.npairs),
         'xi': np.asarray(results.xi),
+        'profile': _get_stage_profile(),
     }
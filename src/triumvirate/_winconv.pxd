@@ -0,0 +1,53 @@
+"""Interface with the window convolution engine.
+
+"""
+from libcpp cimport bool as bool_t
+from libcpp.vector cimport vector
+
+
+cdef extern from "include/winconv.hpp":
+    cdef cppclass CppWinConvEngine "trv::WinConvEngine":
+        int ndim
+        int nmultipoles
+        int nmultipoles_Z
+        int nsamp_in
+        int nsamp
+        int nsamp_out
+
+        vector[vector[double]] post_sampts_Z
+        vector[vector[double]] post_sampts
+
+        CppWinConvEngine(
+            int ndim, int nmultipoles, int nmultipoles_Z,
+            int nsamp_in, int nsamp, int nsamp_out,
+            vector[double] coupling, bool_t threaded
+        ) except +
+
+        void plan_transforms(
+            vector[int] degrees_Z, vector[int] degrees,
+            vector[double] sample_pts_in, vector[double] sample_pts,
+            double kr_c, bool_t lowring,
+            int extrap, double extrap_exp, bool_t extrap2d
+        ) except +
+
+        void set_input_weights(
+            int imultipole_Z, vector[double] weights
+        ) except +
+
+        void set_output_weights(
+            int imultipole, vector[double] weights
+        ) except +
+
+        void convolve(
+            const double* samples_in, double* samples_out, bool_t on_grid
+        ) nogil except +
+
+
+cdef class _WinConvEngine:
+    cdef CppWinConvEngine* thisptr
+    cdef public int _ndim
+    cdef public int _nmultipoles
+    cdef public int _nmultipoles_Z
+    cdef public int _nsamp_in
+    cdef public int _nsamp
+    cdef public int _nsamp_out
@@ -0,0 +1,211 @@
+"""
+Window Convolution Engine (:mod:`~triumvirate._winconv`)
+==========================================================================
+
+Perform window convolution with precompiled coupling plans.
+
+"""
+import numpy as np
+cimport numpy as np
+
+from ._arrayops import _check_1d_array
+from ._winconv cimport CppWinConvEngine
+
+
+cdef class _WinConvEngine:
+    """Window convolution engine in compiled code.
+
+    Parameters
+    ----------
+    ndim : {1, 2}
+        Dimension of multipole samples.
+    coupling : array of float
+        Coupling plan of shape (`nmultipoles`, `nmultipoles_Z`, `nsamp`)
+        in 1-d or (`nmultipoles`, `nmultipoles_Z`, `nsamp`, `nsamp`)
+        in 2-d, where `nmultipoles` and `nmultipoles_Z` are the numbers
+        of windowed and unwindowed multipoles and `nsamp` is the number
+        of common sample points per dimension.
+    nsamp_in : int, optional
+        Number of input sample points per dimension.  If `None`
+        (default), it is the same as `nsamp`.
+    nsamp_out : int, optional
+        Number of output sample points per dimension.  If `None`
+        (default), it is the same as `nsamp`.
+    threaded : bool, optional
+        If `True` (default is `False`), use multi-threading.
+
+    """
+
+    def __cinit__(self, ndim, coupling, nsamp_in=None, nsamp_out=None,
+                  threaded=False):
+        coupling = np.ascontiguousarray(coupling, dtype=np.float64)
+        if coupling.ndim != 2 + ndim:
+            raise ValueError(
+                f"Coupling plan must be {2 + ndim}-d: {coupling.shape=}."
+            )
+
+        nmultipoles, nmultipoles_Z, nsamp = coupling.shape[:3]
+        nsamp_in = nsamp if nsamp_in is None else nsamp_in
+        nsamp_out = nsamp if nsamp_out is None else nsamp_out
+
+        self.thisptr = new CppWinConvEngine(
+            ndim, nmultipoles, nmultipoles_Z, nsamp_in, nsamp, nsamp_out,
+            coupling.ravel(), threaded
+        )
+
+        self._ndim = self.thisptr.ndim
+        self._nmultipoles = self.thisptr.nmultipoles
+        self._nmultipoles_Z = self.thisptr.nmultipoles_Z
+        self._nsamp_in = self.thisptr.nsamp_in
+        self._nsamp = self.thisptr.nsamp
+        self._nsamp_out = self.thisptr.nsamp_out
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @property
+    def post_sampts_Z(self):
+        """Post-transform sample points of each unwindowed multipole
+        after backward transforms.
+
+        """
+        return [np.asarray(_x) for _x in self.thisptr.post_sampts_Z]
+
+    @property
+    def post_sampts(self):
+        """Post-transform sample points of each windowed multipole
+        after forward transforms.
+
+        """
+        return [np.asarray(_x) for _x in self.thisptr.post_sampts]
+
+    def plan_transforms(self, degrees_Z, degrees, x_in, x, kr_c=1.,
+                        lowring=True, extrap=0, extrap_exp=2.,
+                        extrap2d=False):
+        """Plan backward and forward spherical Bessel transforms (with
+        zero power-law bias) for Fourier-space statistics.
+
+        Parameters
+        ----------
+        degrees_Z : sequence of int or sequence of (int, int)
+            Degrees of the backward transforms for each unwindowed
+            multipole.
+        degrees : sequence of int or sequence of (int, int)
+            Degrees of the forward transforms for each windowed
+            multipole.
+        x_in : array of float
+            Input sample points.  Must be log-linearly spaced.
+        x : array of float
+            Common sample points.  Must be log-linearly spaced.
+        kr_c : float, optional
+            Pivot value for the transform (default is 1.).
+        lowring : bool, optional
+            Low-ringing condition (default is `True`).
+        extrap : int, optional
+            Extrapolation method (default is 0) with the same options as
+            for :class:`~triumvirate._fftlog.HankelTransform`.
+        extrap_exp : float, optional
+            Sample size expansion factor (default is 2.) for
+            extrapolation.
+        extrap2d : bool, optional
+            If `True` (default is `False`), extrapolate in 2-d before
+            each 2-d transform.
+
+        """
+        self.thisptr.plan_transforms(
+            np.ravel(degrees_Z).astype(np.intc),
+            np.ravel(degrees).astype(np.intc),
+            _check_1d_array(x_in, check_loglin=True),
+            _check_1d_array(x, check_loglin=True),
+            kr_c, lowring, 0 if extrap is None else extrap, extrap_exp,
+            extrap2d
+        )
+
+    def set_input_weights(self, imultipole_Z, weights=None):
+        """Set the resampling weights of an unwindowed multipole from
+        input to common sample points.
+
+        Parameters
+        ----------
+        imultipole_Z : int
+            Index of the unwindowed multipole.
+        weights : (`nsamp`, `nsamp_in`) array of float, optional
+            Resampling weights.  If `None` (default), no resampling
+            is performed.
+
+        """
+        self.thisptr.set_input_weights(
+            imultipole_Z,
+            [] if weights is None else np.ravel(weights).astype(np.float64)
+        )
+
+    def set_output_weights(self, imultipole, weights=None):
+        """Set the resampling weights of a windowed multipole from
+        common to output sample points.
+
+        Parameters
+        ----------
+        imultipole : int
+            Index of the windowed multipole.
+        weights : (`nsamp_out`, `nsamp`) array of float, optional
+            Resampling weights.  If `None` (default), no resampling
+            is performed.
+
+        """
+        self.thisptr.set_output_weights(
+            imultipole,
+            [] if weights is None else np.ravel(weights).astype(np.float64)
+        )
+
+    def convolve(self, samples, on_grid=False):
+        """Convolve all multipoles.
+
+        The convolution is performed with the GIL released.
+
+        Parameters
+        ----------
+        samples : array of float
+            Unwindowed multipole samples of shape (`nmultipoles_Z`,
+            `nsamp_in`[, `nsamp_in`]), or (`nmultipoles_Z`,
+            `nsamp`[, `nsamp`]) if `on_grid` is `True`.
+        on_grid : bool, optional
+            If `True` (default is `False`), `samples` are given in
+            configuration space at the common sample points, and any
+            backward transforms and input resampling are skipped.
+
+        Returns
+        -------
+        samples_conv : array of float
+            Windowed multipole samples of shape (`nmultipoles`,
+            `nsamp_out`[, `nsamp_out`]).
+
+        Raises
+        ------
+        ValueError
+            If the shape of `samples` does not match the numbers of
+            multipoles and sample points.
+
+        """
+        nsamp_in = self._nsamp if on_grid else self._nsamp_in
+        shape_in = (self._nmultipoles_Z,) + (nsamp_in,) * self._ndim
+        shape_out = (self._nmultipoles,) + (self._nsamp_out,) * self._ndim
+
+        if np.shape(samples) != shape_in:
+            raise ValueError(
+                "Multipole samples do not match the numbers of multipoles "
+                f"and sample points: {np.shape(samples)} versus {shape_in}."
+            )
+
+        cdef np.ndarray[double, ndim=1, mode='c'] samples_ = \
+            np.ascontiguousarray(samples, dtype=np.float64).ravel()
+
+        cdef np.ndarray[double, ndim=1, mode='c'] samples_conv = \
+            np.zeros(np.prod(shape_out), dtype=np.float64)
+
+        cdef const double* samples_ptr = &samples_[0]
+        cdef double* samples_conv_ptr = &samples_conv[0]
+        cdef bint on_grid_ = on_grid
+        with nogil:
+            self.thisptr.convolve(samples_ptr, samples_conv_ptr, on_grid_)
+
+        return samples_conv.reshape(shape_out)
@@ -0,0 +1,684 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file bench_kernels.cpp
+ * @authors Mike S Wang (https://github.com/MikeSWang)
+ * @brief Benchmark the throughput of computational kernels.
+ *
+ * Kernels (mesh assignment, FFTs, binning, shell fills, spherical
+ * harmonic tables, spherical Bessel function evaluation and
+ * triple-product reduction) are timed over repeated runs on a synthetic
+ * catalogue generated in memory, sweeping mesh grid numbers and thread
+ * counts, and their throughputs are printed in JSON.
+ *
+ */
+
+#include <fftw3.h>
+
+#ifdef TRV_USE_OMP
+#include <omp.h>
+#endif  // TRV_USE_OMP
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "monitor.hpp"
+#include "parameters.hpp"
+#include "maths.hpp"
+#include "particles.hpp"
+#include "dataobjs.hpp"
+#include "field.hpp"
+#include "synthetic.hpp"
+
+namespace trvs = trv::sys;
+namespace trvm = trv::maths;
+
+namespace {
+
+/**
+ * @brief Benchmark configuration.
+ */
+struct BenchConfig {
+  std::vector<int> ngrids = {64, 128};  ///< mesh grid numbers per dimension
+  std::vector<int> nthreads;            ///< thread counts
+  long long nparticles = 1000000;       ///< (mean) number of particles
+  std::string catalogue;                ///< synthetic catalogue specification
+  double boxsize = 1000.;               ///< box size per dimension
+  int nrepeats = 3;                     ///< number of timed runs
+  std::vector<std::string> kernels;     ///< selected kernels (all if empty)
+  std::string output;                   ///< output file path (stdout if empty)
+  bool help = false;                    ///< print usage only
+};
+
+/**
+ * @brief Benchmark result of a kernel.
+ */
+struct BenchResult {
+  std::string kernel;   ///< kernel name
+  std::string variant;  ///< kernel variant
+  int ngrid;            ///< mesh grid number per dimension
+  int nthreads;         ///< number of threads
+  double time_min;      ///< minimum wall time (in seconds)
+  double time_mean;     ///< mean wall time (in seconds)
+  std::string unit;     ///< unit of work items
+  double nitems;        ///< number of work items per run
+  double gbytes;        ///< estimated data touched per run (in gibibytes)
+};
+
+/**
+ * @brief Split a comma-separated list.
+ *
+ * @param list Comma-separated list.
+ * @returns List entries.
+ */
+std::vector<std::string> split_list(const std::string& list) {
+  std::vector<std::string> entries;
+  std::stringstream ss(list);
+  std::string entry;
+  while (std::getline(ss, entry, ',')) {
+    if (entry != "") {entries.push_back(entry);}
+  }
+  return entries;
+}
+
+/**
+ * @brief Print command-line usage.
+ *
+ * @param fileptr Output file pointer.
+ * @param progname Program name.
+ */
+void print_usage(std::FILE* fileptr, const char* progname) {
+  std::fprintf(
+    fileptr,
+    "Usage: %s [--<name> <value> ...]\n"
+    "\n"
+    "Options:\n"
+    "  --ngrids <list>      mesh grid numbers per dimension "
+    "(default: 64,128)\n"
+    "  --nthreads <list>    thread counts "
+    "(default: powers of two up to the maximum)\n"
+    "  --nparticles <int>   (mean) number of particles "
+    "(default: 1000000)\n"
+    "  --catalogue <spec>   synthetic catalogue specification entries "
+    "overriding\n"
+    "                       the uniform default\n"
+    "  --boxsize <float>    box size per dimension (default: 1000)\n"
+    "  --repeats <int>      number of timed runs (default: 3)\n"
+    "  --kernels <list>     selected kernels among 'assignment', 'fft', "
+    "'binning',\n"
+    "                       'shell_fill', 'sjl_fill', 'ylm', 'sjl_eval' "
+    "and\n"
+    "                       'reduction' (default: all)\n"
+    "  --output <path>      output file path (default: stdout)\n"
+    "  -h, --help           print this message and exit\n"
+    "\n"
+    "Lists are comma-separated.\n",
+    progname
+  );
+}
+
+/**
+ * @brief Parse command-line options.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments.
+ * @returns Benchmark configuration.
+ * @throws trv::sys::InvalidParameterError When an option is
+ *                                         not recognised or
+ *                                         its value is missing.
+ */
+BenchConfig parse_options(int argc, char* argv[]) {
+  BenchConfig cfg;
+  for (int iarg = 1; iarg < argc; iarg++) {
+    std::string opt = argv[iarg];
+    if (opt == "--help" || opt == "-h") {
+      cfg.help = true;
+      return cfg;
+    }
+    if (iarg + 1 >= argc) {
+      throw trvs::InvalidParameterError(
+        "Missing value of benchmark option: '%s'.\n", opt.c_str()
+      );
+    }
+    std::string val = argv[++iarg];
+
+    if (opt == "--ngrids") {
+      cfg.ngrids.clear();
+      for (const std::string& entry : split_list(val)) {
+        cfg.ngrids.push_back(std::atoi(entry.c_str()));
+      }
+    } else
+    if (opt == "--nthreads") {
+      cfg.nthreads.clear();
+      for (const std::string& entry : split_list(val)) {
+        cfg.nthreads.push_back(std::atoi(entry.c_str()));
+      }
+    } else
+    if (opt == "--nparticles") {
+      cfg.nparticles = std::atoll(val.c_str());
+    } else
+    if (opt == "--catalogue") {
+      cfg.catalogue = val;
+    } else
+    if (opt == "--boxsize") {
+      cfg.boxsize = std::atof(val.c_str());
+    } else
+    if (opt == "--repeats") {
+      cfg.nrepeats = std::max(1, std::atoi(val.c_str()));
+    } else
+    if (opt == "--kernels") {
+      cfg.kernels = split_list(val);
+    } else
+    if (opt == "--output") {
+      cfg.output = val;
+    } else {
+      throw trvs::InvalidParameterError(
+        "Unrecognised benchmark option: '%s'.\n", opt.c_str()
+      );
+    }
+  }
+
+  // By default, sweep thread counts in powers of two up to
+  // the maximum number of threads.
+  if (cfg.nthreads.empty()) {
+#ifdef TRV_USE_OMP
+    int nthreads_max = omp_get_max_threads();
+#else  // !TRV_USE_OMP
+    int nthreads_max = 1;
+#endif  // TRV_USE_OMP
+    for (int nthreads = 1; nthreads < nthreads_max; nthreads *= 2) {
+      cfg.nthreads.push_back(nthreads);
+    }
+    cfg.nthreads.push_back(nthreads_max);
+  }
+
+  return cfg;
+}
+
+/**
+ * @brief Kernel timer over repeated runs.
+ */
+class KernelTimer {
+ public:
+  std::vector<BenchResult> results;  ///< benchmark results
+
+  /**
+   * @brief Construct the kernel timer.
+   *
+   * @param cfg Benchmark configuration.
+   */
+  explicit KernelTimer(const BenchConfig& cfg) : cfg(cfg) {}
+
+  /**
+   * @brief Check if a kernel is selected.
+   *
+   * @param kernel Kernel name.
+   * @returns { @c true , @c false }
+   */
+  bool selected(const std::string& kernel) {
+    return this->cfg.kernels.empty() || std::find(
+      this->cfg.kernels.begin(), this->cfg.kernels.end(), kernel
+    ) != this->cfg.kernels.end();
+  }
+
+  /**
+   * @brief Time a kernel after an untimed warm-up run.
+   *
+   * @param kernel Kernel name.
+   * @param variant Kernel variant.
+   * @param ngrid Mesh grid number per dimension.
+   * @param nthreads Number of threads.
+   * @param unit Unit of work items.
+   * @param nitems Number of work items per run.
+   * @param gbytes Estimated data touched per run (in gibibytes).
+   * @param run Kernel run.
+   * @param reset Untimed state reset after each run (default is none).
+   */
+  void time(
+    const std::string& kernel, const std::string& variant,
+    int ngrid, int nthreads,
+    const std::string& unit, double nitems, double gbytes,
+    std::function<void()> run, std::function<void()> reset = nullptr
+  ) {
+    run();
+    if (reset) {reset();}
+
+    double time_min = 0., time_sum = 0.;
+    for (int irep = 0; irep < this->cfg.nrepeats; irep++) {
+      auto time_start = std::chrono::steady_clock::now();
+      run();
+      auto time_end = std::chrono::steady_clock::now();
+      if (reset) {reset();}
+
+      double time_run =
+        std::chrono::duration<double>(time_end - time_start).count();
+      time_min = (irep == 0) ? time_run : std::min(time_min, time_run);
+      time_sum += time_run;
+    }
+
+    this->results.push_back({
+      kernel, variant, ngrid, nthreads,
+      time_min, time_sum / this->cfg.nrepeats, unit, nitems, gbytes
+    });
+
+    std::fprintf(
+      stderr, "[bench] %-18s %-16s ngrid=%-4d nthreads=%-3d %.3e s\n",
+      kernel.c_str(), variant.c_str(), ngrid, nthreads, time_min
+    );
+  }
+
+ private:
+  const BenchConfig& cfg;  ///< benchmark configuration
+};
+
+/**
+ * @brief Set up the parameter set of a mesh.
+ *
+ * @param cfg Benchmark configuration.
+ * @param ngrid Mesh grid number per dimension.
+ * @param assignment Mesh assignment scheme.
+ * @param interlace Interlacing flag.
+ * @returns Parameter set.
+ */
+trv::ParameterSet make_params(
+  const BenchConfig& cfg, int ngrid,
+  const std::string& assignment, const std::string& interlace
+) {
+  trv::ParameterSet params;
+
+  params.catalogue_type = "sim";
+  params.statistic_type = "powspec";
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    params.boxsize[iaxis] = cfg.boxsize;
+    params.ngrid[iaxis] = ngrid;
+  }
+  params.assignment = assignment;
+  params.interlace = interlace;
+  params.binning = "lin";
+  params.bin_min = 0.;
+  params.bin_max = M_PI * ngrid / cfg.boxsize;  // Nyquist wavenumber
+  params.num_bins = 20;
+  params.verbose = trvs::LogLevel::WARN;
+
+  params.validate();
+
+  return params;
+}
+
+/**
+ * @brief Write benchmark results in JSON.
+ *
+ * @param fileptr Output file pointer.
+ * @param cfg Benchmark configuration.
+ * @param catalogue Catalogue source.
+ * @param ntotal Number of particles.
+ * @param results Benchmark results.
+ */
+void write_results(
+  std::FILE* fileptr, const BenchConfig& cfg,
+  const std::string& catalogue, long long ntotal,
+  const std::vector<BenchResult>& results
+) {
+#ifdef TRV_USE_OMP
+  const char* omp = "true";
+#else  // !TRV_USE_OMP
+  const char* omp = "false";
+#endif  // TRV_USE_OMP
+
+  std::fprintf(fileptr, "{\n");
+  std::fprintf(fileptr, "  \"omp\": %s,\n", omp);
+  std::fprintf(fileptr, "  \"catalogue\": \"%s\",\n", catalogue.c_str());
+  std::fprintf(fileptr, "  \"nparticles\": %lld,\n", ntotal);
+  std::fprintf(fileptr, "  \"boxsize\": %.6g,\n", cfg.boxsize);
+  std::fprintf(fileptr, "  \"repeats\": %d,\n", cfg.nrepeats);
+  std::fprintf(fileptr, "  \"results\": [");
+  for (std::size_t ires = 0; ires < results.size(); ires++) {
+    const BenchResult& res = results[ires];
+    std::fprintf(
+      fileptr,
+      "%s\n    {\"kernel\": \"%s\", \"variant\": \"%s\", "
+      "\"ngrid\": %d, \"nthreads\": %d, "
+      "\"time_min\": %.6e, \"time_mean\": %.6e, "
+      "\"unit\": \"%s\", \"items\": %.0f, \"items_per_s\": %.6e, ",
+      (ires == 0) ? "" : ",",
+      res.kernel.c_str(), res.variant.c_str(), res.ngrid, res.nthreads,
+      res.time_min, res.time_mean,
+      res.unit.c_str(), res.nitems, res.nitems / res.time_min
+    );
+    if (res.gbytes > 0.) {
+      std::fprintf(
+        fileptr, "\"gbytes\": %.6e, \"gbytes_per_s\": %.6e}",
+        res.gbytes, res.gbytes / res.time_min
+      );
+    } else {
+      std::fprintf(fileptr, "\"gbytes\": null, \"gbytes_per_s\": null}");
+    }
+  }
+  std::fprintf(fileptr, "\n  ]\n}\n");
+}
+
+}  // namespace
+
+/**
+ * @brief Benchmark computational kernels.
+ *
+ * Options are given as `--<name> <value>` pairs: `--ngrids`,
+ * `--nthreads` and `--kernels` (comma-separated lists), `--nparticles`,
+ * `--catalogue` (synthetic catalogue specification entries overriding
+ * the uniform default), `--boxsize`, `--repeats` and `--output`.
+ * Kernels are 'assignment', 'fft', 'binning', 'shell_fill', 'sjl_fill',
+ * 'ylm', 'sjl_eval' and 'reduction'.  With `--help` (or `-h`), or on
+ * an invalid option, the usage is printed instead.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments.
+ * @returns Exit status.
+ */
+int main(int argc, char* argv[]) {
+  BenchConfig cfg;
+  try {
+    cfg = parse_options(argc, argv);
+  } catch (const trvs::InvalidParameterError& err) {
+    std::fprintf(stderr, "%s\n", err.what());
+    print_usage(stderr, argv[0]);
+    return 1;
+  }
+  if (cfg.help) {
+    print_usage(stdout, argv[0]);
+    return 0;
+  }
+
+  KernelTimer timer(cfg);
+
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+
+  // Generate a synthetic catalogue in the box (uniform by default).
+  std::string catalogue = "synthetic:type=uniform"
+    ",num=" + std::to_string(cfg.nparticles)
+    + ",boxsize=" + std::to_string(cfg.boxsize)
+    + ((cfg.catalogue != "") ? "," + cfg.catalogue : "");
+
+  trv::ParticleCatalogue particles(trvs::LogLevel::WARN);
+  particles.load_catalogue_file(catalogue, "");
+
+  fftw_complex* weights = fftw_alloc_complex(particles.ntotal);
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
+    weights[pid][0] = 1.;
+    weights[pid][1] = 0.;
+  }
+
+  const std::vector<std::string> schemes = {"ngp", "cic", "tsc", "pcs"};
+  const int ell = 2, m = 1;  // spherical harmonic degree and order
+
+  for (int ngrid : cfg.ngrids) {
+    trv::ParameterSet params = make_params(cfg, ngrid, "tsc", "false");
+    double nmesh = double(params.nmesh);
+    double gbytes_mesh = trvs::size_in_gb<fftw_complex>(params.nmesh);
+    double k_nyq = M_PI * ngrid / cfg.boxsize;
+
+    for (int nthreads : cfg.nthreads) {
+#ifdef TRV_USE_OMP
+      omp_set_num_threads(nthreads);
+#endif  // TRV_USE_OMP
+
+      // -- Mesh assignment ----------------------------------------------
+
+      if (timer.selected("assignment")) {
+        for (const std::string& scheme : schemes) {
+          for (const std::string interlace : {"false", "true"}) {
+            trv::ParameterSet params_assign =
+              make_params(cfg, ngrid, scheme, interlace);
+            trv::MeshField field(params_assign, false);
+
+            double nmeshes = (interlace == "true") ? 2. : 1.;
+            timer.time(
+              "assignment",
+              scheme + ((interlace == "true") ? "-interlaced" : ""),
+              ngrid, nthreads, "particles", double(particles.ntotal),
+              trvs::size_in_gb<double>(4*particles.ntotal)
+              + nmeshes * gbytes_mesh,
+              [&]() {field.assign_weighted_field_to_mesh(particles, weights);}
+            );
+          }
+        }
+      }
+
+      // -- FFTs ---------------------------------------------------------
+
+      if (timer.selected("fft")) {
+        for (const std::string interlace : {"false", "true"}) {
+          trv::ParameterSet params_fft =
+            make_params(cfg, ngrid, "tsc", interlace);
+          trv::MeshField field(params_fft);
+          auto assign = [&]() {
+            field.assign_weighted_field_to_mesh(particles, weights);
+          };
+
+          assign();
+          double nmeshes = (interlace == "true") ? 2. : 1.;
+          timer.time(
+            "fft",
+            (interlace == "true") ? "forward-interlaced" : "forward",
+            ngrid, nthreads, "cells", nmeshes * nmesh,
+            2. * nmeshes * gbytes_mesh,
+            [&]() {field.fourier_transform();}, assign
+          );
+
+          if (interlace == "false") {
+            field.fourier_transform();
+            timer.time(
+              "fft", "inverse", ngrid, nthreads, "cells", nmesh,
+              2. * gbytes_mesh,
+              [&]() {field.inv_fourier_transform();},
+              [&]() {field.fourier_transform();}
+            );
+          }
+        }
+      }
+
+      // -- Fourier-space kernels ----------------------------------------
+
+      bool fourier_kernels = timer.selected("binning")
+        || timer.selected("shell_fill") || timer.selected("sjl_fill")
+        || timer.selected("ylm");
+      if (fourier_kernels) {
+        trv::MeshField dn(params, true, "`dn`");
+        dn.assign_weighted_field_to_mesh(particles, weights);
+        dn.fourier_transform();
+
+        trvs::TrackedVector< std::complex<double> > ylm(params.nmesh);
+        auto store_ylm = [&]() {
+          trvm::SphericalHarmonicCalculator::
+            store_reduced_spherical_harmonic_in_fourier_space(
+              ell, m, params.boxsize, params.ngrid, ylm
+            );
+        };
+        store_ylm();
+
+        if (timer.selected("ylm")) {
+          timer.time(
+            "ylm", "fourier", ngrid, nthreads, "cells", nmesh,
+            trvs::size_in_gb< std::complex<double> >(params.nmesh),
+            store_ylm
+          );
+        }
+
+        if (timer.selected("binning")) {
+          trv::FieldStats stats(params, false);
+          trv::Binning kbinning(params);
+          kbinning.set_bins();
+
+          timer.time(
+            "binning", "fourier", ngrid, nthreads, "cells", nmesh,
+            3. * gbytes_mesh,
+            [&]() {
+              stats.compute_ylm_wgtd_2pt_stats_in_fourier(
+                dn, dn, 0., ell, m, kbinning
+              );
+            }
+          );
+        }
+
+        if (timer.selected("shell_fill") || timer.selected("sjl_fill")) {
+          trv::MeshField F(params, true, "`F`");
+
+          if (timer.selected("shell_fill")) {
+            double k_eff;
+            long long nmodes;
+            timer.time(
+              "shell_fill", "band_limited", ngrid, nthreads, "cells", nmesh,
+              2. * gbytes_mesh
+              + trvs::size_in_gb< std::complex<double> >(params.nmesh),
+              [&]() {
+                F.inv_fourier_transform_ylm_wgtd_field_band_limited(
+                  dn, ylm, 0.5 * k_nyq, 0.6 * k_nyq, k_eff, nmodes
+                );
+              }
+            );
+          }
+
+          if (timer.selected("sjl_fill")) {
+            trvm::SphericalBesselCalculator sjl(ell);
+            timer.time(
+              "sjl_fill", "sjl_wgtd", ngrid, nthreads, "cells", nmesh,
+              2. * gbytes_mesh
+              + trvs::size_in_gb< std::complex<double> >(params.nmesh),
+              [&]() {
+                F.inv_fourier_transform_sjl_ylm_wgtd_field(
+                  dn, ylm, sjl, 0.1 * cfg.boxsize
+                );
+              }
+            );
+          }
+        }
+      }
+
+      // -- Spherical Bessel function evaluation -------------------------
+
+      if (timer.selected("sjl_eval")) {
+        trvm::SphericalBesselCalculator sjl(ell);
+
+        // Sample arguments up to the maximum of `kr` on the mesh,
+        // which covers both interpolated and directly evaluated ranges.
+        long long neval = params.nmesh;
+        double x_max = std::sqrt(3.) * k_nyq * cfg.boxsize;
+        double sjl_sum = 0.;
+        timer.time(
+          "sjl_eval", "interp", ngrid, nthreads, "evaluations",
+          double(neval), 0.,
+          [&]() {
+            double sum = 0.;
+#ifdef TRV_USE_OMP
+#pragma omp parallel reduction(+:sum)
+#endif  // TRV_USE_OMP
+{
+            trvm::SphericalBesselCalculator sjl_thread(sjl);
+
+#ifdef TRV_USE_OMP
+#pragma omp for
+#endif  // TRV_USE_OMP
+            for (long long ieval = 0; ieval < neval; ieval++) {
+              sum += sjl_thread.eval(x_max * ieval / neval);
+            }
+}
+            sjl_sum += sum;
+          }
+        );
+        if (sjl_sum != sjl_sum) {
+          std::fprintf(stderr, "[bench] invalid spherical Bessel values\n");
+        }
+      }
+
+      // -- Triple-product reduction -------------------------------------
+
+      if (timer.selected("reduction")) {
+        trv::MeshField F_a(params, false, "`F_a`");
+        trv::MeshField F_b(params, false, "`F_b`");
+        trv::MeshField G(params, false, "`G`");
+        F_a.assign_weighted_field_to_mesh(particles, weights);
+        F_b.assign_weighted_field_to_mesh(particles, weights);
+        G.assign_weighted_field_to_mesh(particles, weights);
+
+        std::complex<double> component;
+        timer.time(
+          "reduction", "triple_product", ngrid, nthreads, "cells", nmesh,
+          3. * gbytes_mesh,
+          [&]() {
+            double comp_real = 0., comp_imag = 0.;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for reduction(+:comp_real, comp_imag)
+#endif  // TRV_USE_OMP
+            for (long long gid = 0; gid < params.nmesh; gid++) {
+              std::complex<double> F_a_gridpt(F_a[gid][0], F_a[gid][1]);
+              std::complex<double> F_b_gridpt(F_b[gid][0], F_b[gid][1]);
+              std::complex<double> G_gridpt(G[gid][0], G[gid][1]);
+              std::complex<double> product_gridpt =
+                F_a_gridpt * F_b_gridpt * G_gridpt;
+
+              comp_real += product_gridpt.real();
+              comp_imag += product_gridpt.imag();
+            }
+
+            component = std::complex<double>(comp_real, comp_imag);
+          }
+        );
+      }
+    }
+  }
+
+  fftw_free(weights);
+
+  // Write results.
+  std::FILE* fileptr = stdout;
+  if (cfg.output != "") {
+    fileptr = std::fopen(cfg.output.c_str(), "w");
+    if (fileptr == nullptr) {
+      throw trvs::IOError(
+        "Failed to open benchmark output file: %s.\n", cfg.output.c_str()
+      );
+    }
+  }
+  write_results(fileptr, cfg, catalogue, particles.ntotal, timer.results);
+  if (fileptr != stdout) {
+    std::fclose(fileptr);
+  }
+
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+  fftw_cleanup_threads();
+#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
+  fftw_cleanup();
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+
+  return 0;
+}
@@ -15,7 +15,7 @@ import warnings
 import numpy as np
 from astropy.table import Table
 
-from ._particles import _ParticleCatalogue
+from ._particles import _ParticleCatalogue, _generate_synthetic_particles
 
 try:
     from nbodykit.source.catalog import (
@@ -133,6 +133,9 @@ class ParticleCatalogue:
 
         self._source = 'extdata:{}'.format(id(self._pdata))
 
+        # Track the observer (i.e. original origin) position.
+        self._observer = np.zeros(3)
+
         # Compute catalogue properties.
         self._calc_bounds(init=True)
 
@@ -275,6 +278,8 @@ class ParticleCatalogue:
         self._logger = logger
         self._source = f'extfile:{filepath}'
 
+        self._observer = np.zeros(3)
+
         if reader.lower() == 'nbodykit':
             if _nbkt_imported:
                 self._backend = 'nbodykit'
@@ -386,6 +391,98 @@ class ParticleCatalogue:
 
         return self
 
+    @classmethod
+    def generate_synthetic(cls, num, boxsize, kind='uniform', seed=42,
+                           ngrid=64, sigma=1., index=-2., smoothing=None,
+                           radius_min=0., radius_max=None,
+                           radial_scale=None, logger=None):
+        """Generate a seeded synthetic catalogue in a box.
+
+        Particles are generated in compiled code and positioned in
+        the box [0, L) in each dimension, with the survey mask and
+        radial selection centred at the box centre.  The catalogue is
+        reproducible for a given `seed` irrespective of the number of
+        threads.
+
+        Parameters
+        ----------
+        num : int
+            (Mean) number of particles in the box before selection.
+        boxsize : float or sequence of [float, float, float]
+            Box size (in each dimension).
+        kind : {'uniform', 'poisson', 'lognormal'}, optional
+            Catalogue type (default is 'uniform'): exactly `num`
+            uniformly distributed particles, a Poisson point process or
+            a Poisson sampling of a lognormal density field.
+        seed : int, optional
+            Random seed (default is 42).
+        ngrid : int, optional
+            Mesh grid number per dimension of the lognormal field
+            (default is 64).  Used only when ``kind='lognormal'``.
+        sigma : float, optional
+            Standard deviation of the Gaussian field (default is 1.).
+            Used only when ``kind='lognormal'``.
+        index : float, optional
+            Spectral index of the Gaussian field power spectrum (default
+            is -2.).  Used only when ``kind='lognormal'``.
+        smoothing : float, optional
+            Gaussian smoothing length of the Gaussian field (default is
+            `None`, i.e. the mesh cell size).  Used only when
+            ``kind='lognormal'``.
+        radius_min, radius_max : float, optional
+            Inner and outer radii of the spherical-shell survey mask
+            (default is 0. and `None`, i.e. no mask).
+        radial_scale : float, optional
+            Scale of the Gaussian radial selection function (default is
+            `None`, i.e. no selection).
+        logger : :class:`logging.Logger`, optional
+            Program logger (default is `None`).
+
+        Returns
+        -------
+        :class:`~triumvirate.catalogue.ParticleCatalogue`
+            Synthetic catalogue with the expected number density 'nz'
+            and unit weights.
+
+        Raises
+        ------
+        ValueError
+            When the specification is invalid.
+
+        Examples
+        --------
+        >>> ParticleCatalogue.generate_synthetic(
+        ...     int(1e6), 1000., kind='lognormal', seed=7,
+        ...     radius_max=500., radial_scale=300.
+        ... )
+
+        """
+        boxsize = np.broadcast_to(np.asarray(boxsize, dtype=float), 3)
+
+        spec = {
+            'type': kind,
+            'num': int(num),
+            'seed': int(seed),
+            'boxsize': ':'.join(map(repr, boxsize.tolist())),
+            'ngrid': int(ngrid),
+            'sigma': sigma,
+            'index': index,
+            'smoothing': smoothing or 0.,
+            'radius_min': radius_min,
+            'radius_max': radius_max or 0.,
+            'radial_scale': radial_scale or 0.,
+        }
+        source = 'synthetic:' + ','.join(
+            f'{key}={val}' for key, val in spec.items()
+        )
+
+        x, y, z, nz = _generate_synthetic_particles(source)
+
+        self = cls(x, y, z, nz=nz, logger=logger)
+        self._source = source
+
+        return self
+
     def __str__(self):
         try:
             return "ParticleCatalogue(source={})".format(self._source)
@@ -437,17 +534,25 @@ class ParticleCatalogue:
         los : (N, 3) :class:`numpy.ndarray`
             Normalised line-of-sight vectors.
 
+
+        .. note::
+
+            Lines of sight are relative to the observer, i.e. the origin
+            of particle coordinates before any offset.  They need not be
+            computed for the local plane-parallel approximation, as they
+            are otherwise evaluated on the fly in measurements.
+
         """
-        los_norm = np.sqrt(
-            self._pdata['x']**2 + self._pdata['y']**2 + self._pdata['z']**2
-        )
+        los_x = self._pdata['x'] - self._observer[0]
+        los_y = self._pdata['y'] - self._observer[1]
+        los_z = self._pdata['z'] - self._observer[2]
+
+        los_norm = np.sqrt(los_x**2 + los_y**2 + los_z**2)
 
         los_norm[los_norm == 0.] = 1.
 
         los = np.transpose([
-            self._pdata['x'] / los_norm,
-            self._pdata['y'] / los_norm,
-            self._pdata['z'] / los_norm
+            los_x / los_norm, los_y / los_norm, los_z / los_norm
         ])
 
         return self._compute(los)
@@ -670,6 +775,8 @@ class ParticleCatalogue:
         for axis, coord in zip(['x', 'y', 'z'], origin):
             self._pdata[axis] -= coord
 
+        self._observer = self._observer - np.asarray(origin)
+
         self._calc_bounds()
 
     def _calc_bounds(self, init=False):
@@ -749,14 +856,15 @@ class ParticleCatalogue:
             C++-wrapped catalogue.
 
         """
-        x = np.ascontiguousarray(self._compute(self._pdata['x']))
-        y = np.ascontiguousarray(self._compute(self._pdata['y']))
-        z = np.ascontiguousarray(self._compute(self._pdata['z']))
-        nz = np.ascontiguousarray(self._compute(self._pdata['nz']))
-        ws = np.ascontiguousarray(self._compute(self._pdata['ws']))
-        wc = np.ascontiguousarray(self._compute(self._pdata['wc']))
-
-        return _ParticleCatalogue(x, y, z, nz, ws, wc, verbose=verbose)
+        # Particle data buffers are wrapped without copying where possible.
+        x, y, z, nz, ws, wc = (
+            self._compute(self._pdata[name])
+            for name in ['x', 'y', 'z', 'nz', 'ws', 'wc']
+        )
+
+        return _ParticleCatalogue(
+            x, y, z, nz, ws, wc, observer=self._observer, verbose=verbose
+        )
 
     def _compute(self, quant):
         """Return a quantity in standard form (i.e. apply
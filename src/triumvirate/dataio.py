@@ -0,0 +1,152 @@
+"""
+Data I/O (:mod:`~triumvirate.dataio`)
+==========================================================================
+
+.. versionadded:: 0.4.0
+
+
+Read measurement files saved by the C++ program.
+
+.. autosummary::
+    read_binary_measurements
+
+"""
+import struct
+
+import numpy as np
+
+
+_BINARY_SIGNATURE = b'TRVBIN01'
+
+_PROFILE_PREFIX = 'profile/'
+
+
+def _read_exact(fileobj, nbytes):
+    """Read an exact number of bytes from a binary file.
+
+    Parameters
+    ----------
+    fileobj : file object
+        Binary file.
+    nbytes : int
+        Number of bytes.
+
+    Returns
+    -------
+    bytes
+        Bytes read.
+
+    Raises
+    ------
+    ValueError
+        If the file ends before `nbytes` bytes are read.
+
+    """
+    buffer = fileobj.read(nbytes)
+    if len(buffer) != nbytes:
+        raise ValueError("Binary measurement file is truncated.")
+    return buffer
+
+
+def _read_string(fileobj):
+    """Read a length-prefixed string from a binary file.
+
+    Parameters
+    ----------
+    fileobj : file object
+        Binary file.
+
+    Returns
+    -------
+    str
+        String read.
+
+    """
+    (length,) = struct.unpack('<I', _read_exact(fileobj, 4))
+    return _read_exact(fileobj, length).decode('utf-8')
+
+
+def read_binary_measurements(filepath):
+    """Read a binary measurement file saved by the C++ program (with
+    ``output_type = binary``).
+
+    Parameters
+    ----------
+    filepath : str or :class:`pathlib.Path`
+        Binary measurement file path.
+
+    Returns
+    -------
+    dict
+        Measurements with the same keys as returned by
+        the ``compute_*`` functions in :mod:`~triumvirate.twopt` and
+        :mod:`~triumvirate.threept` (e.g. ``'kbin'``, ``'nmodes'`` and
+        ``'pk_raw'`` for the power spectrum), or binned vectors with
+        the same fields as returned by
+        :func:`~triumvirate.fieldmesh.record_binned_vectors` (i.e.
+        ``'index'``, ``'lower_edge'``, ``'upper_edge'``, ``'vecx'``,
+        ``'vecy'`` and ``'vecz'``), as well as ``'header'`` (the header
+        text as in text files) and, for measurements, ``'profile'`` (the
+        stage profile as a dictionary keyed by stage name).
+
+    Raises
+    ------
+    ValueError
+        If the file is not a valid binary measurement file.
+
+    """
+    records = {}
+    with open(filepath, 'rb') as fileobj:
+        if fileobj.read(len(_BINARY_SIGNATURE)) != _BINARY_SIGNATURE:
+            raise ValueError(
+                f"Not a binary measurement file: {filepath}."
+            )
+
+        while True:
+            prefix = fileobj.read(4)
+            if not prefix:
+                break
+            if len(prefix) != 4:
+                raise ValueError("Binary measurement file is truncated.")
+            (length,) = struct.unpack('<I', prefix)
+
+            name = _read_exact(fileobj, length).decode('utf-8')
+            dtype = np.dtype(_read_string(fileobj))
+            (ndim,) = struct.unpack('<I', _read_exact(fileobj, 4))
+            shape = struct.unpack(f'<{ndim}Q', _read_exact(fileobj, 8 * ndim))
+
+            size = int(np.prod(shape, dtype=np.int64))
+            buffer = _read_exact(fileobj, size * dtype.itemsize)
+            if dtype.itemsize == 0:
+                array = np.zeros(shape, dtype=dtype)
+            else:
+                array = np.frombuffer(bytearray(buffer), dtype=dtype) \
+                    .reshape(shape)
+
+            records.setdefault(name, []).append(array)
+
+    results = {}
+    profile_fields = {}
+    for name, arrays in records.items():
+        array = arrays[0] if len(arrays) == 1 else np.concatenate(arrays)
+        if array.dtype.kind == 'S':
+            array = np.char.decode(array, 'utf-8')
+        if array.ndim == 0:
+            array = array.item()
+
+        if name.startswith(_PROFILE_PREFIX):
+            profile_fields[name[len(_PROFILE_PREFIX):]] = array
+        else:
+            results[name] = array
+
+    if profile_fields:
+        stages = profile_fields.pop('stage')
+        results['profile'] = {
+            str(stage): {
+                field: values[istage].item()
+                for field, values in profile_fields.items()
+            }
+            for istage, stage in enumerate(stages)
+        }
+
+    return results
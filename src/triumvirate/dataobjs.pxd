@@ -61,22 +61,38 @@ cdef extern from "include/dataobjs.hpp":
         int dim
         vector[double] kbin
         vector[double] keff
-        vector[int] nmodes
+        vector[long long] nmodes
         vector[double complex] pk_raw
         vector[double complex] pk_shot
 
+    struct PowspecKMuMeasurements "trv::PowspecKMuMeasurements":
+        int dim
+        int num_wedges
+        vector[int] ells
+        vector[double] kbin
+        vector[double] keff
+        vector[long long] nmodes
+        vector[double complex] pk_raw
+        vector[double complex] pk_shot
+        vector[double] mu_edges
+        vector[double] keff_wedges
+        vector[double] mueff_wedges
+        vector[long long] nmodes_wedges
+        vector[double complex] pk_raw_wedges
+        vector[double complex] pk_shot_wedges
+
     struct TwoPCFMeasurements "trv::TwoPCFMeasurements":
         int dim
         vector[double] rbin
         vector[double] reff
-        vector[int] npairs
+        vector[long long] npairs
         vector[double complex] xi
 
     struct TwoPCFWindowMeasurements "trv::TwoPCFWindowMeasurements":
         int dim
         vector[double] rbin
         vector[double] reff
-        vector[int] npairs
+        vector[long long] npairs
         vector[double complex] xi
 
     # -- Three-point statistics ------------------------------------------
@@ -87,8 +103,8 @@ cdef extern from "include/dataobjs.hpp":
         vector[double] k2_bin
         vector[double] k1_eff
         vector[double] k2_eff
-        vector[int] nmodes_1
-        vector[int] nmodes_2
+        vector[long long] nmodes_1
+        vector[long long] nmodes_2
         vector[double complex] bk_raw
         vector[double complex] bk_shot
 
@@ -98,8 +114,8 @@ cdef extern from "include/dataobjs.hpp":
         vector[double] r2_bin
         vector[double] r1_eff
         vector[double] r2_eff
-        vector[int] npairs_1
-        vector[int] npairs_2
+        vector[long long] npairs_1
+        vector[long long] npairs_2
         vector[double complex] zeta_raw
         vector[double complex] zeta_shot
 
@@ -109,8 +125,8 @@ cdef extern from "include/dataobjs.hpp":
         vector[double] r2_bin
         vector[double] r1_eff
         vector[double] r2_eff
-        vector[int] npairs_1
-        vector[int] npairs_2
+        vector[long long] npairs_1
+        vector[long long] npairs_2
         vector[double complex] zeta_raw
         vector[double complex] zeta_shot
 
@@ -8,12 +8,15 @@ Field and mesh (:mod:`~triumvirate.fieldmesh`)
 Handle fields and mesh grids.
 
 .. autosummary::
+    MeshFieldCache
     record_binned_vectors
 
 """
+import os
+
 import numpy as np
 
-from ._field import _record_binned_vectors
+from ._field import _MeshFieldCache, _record_binned_vectors
 from .parameters import (
     _modify_sampling_parameters,
     fetch_paramset_template,
@@ -21,6 +24,194 @@ from .parameters import (
 )
 
 
+class MeshFieldCache:
+    """Mesh field cache for batch measurements of survey-type
+    catalogues sharing the same random-source catalogue.
+
+    .. versionadded:: 0.4.0
+
+    Pass the same cache as `field_cache` to successive survey-type
+    clustering measurements, each with a different data-source catalogue
+    but the same random-source catalogue and sampling parameters.
+    On first use, the random-source catalogue is aligned inside the
+    measurement box as usual and bound to the cache; subsequently,
+    each data-source catalogue is only offset into the frame of the
+    bound random-source catalogue, and the random-source mesh fields
+    and alpha-independent mesh normalisation are reused, so that only
+    data-source mesh assignments and Fourier transforms are repeated.
+
+    Parameters
+    ----------
+    cache_dir : str or :class:`pathlib.Path`, optional
+        Directory of the on-disk cache (default is `None`), which is
+        created if it does not exist.  If set, random-source mesh fields
+        are also saved there as raw binary files keyed by the content
+        of the aligned random-source catalogue, the mesh sampling
+        parameters and the spherical harmonic, and are read back by
+        later caches with the same inputs (e.g. in other sessions)
+        instead of being recomputed.
+    cache_size : float, optional
+        Size limit (in gigabytes) of the on-disk cache (default is
+        `None`), beyond which the least recently used files are removed.
+        If `None` or non-positive, the cache size is unlimited.
+
+    Attributes
+    ----------
+    count_rand_computed : int
+        Number of random-source mesh fields computed.
+    count_rand_reused : int
+        Number of random-source mesh fields reused.
+    count_rand_loaded : int
+        Number of random-source mesh fields loaded from the on-disk
+        cache.
+
+    Notes
+    -----
+    The random-source mesh fields are held in memory, one for each
+    pair of spherical harmonic degree and order (and separately
+    for quadratic fields).  A cache must not be shared between
+    concurrent measurements.
+
+    """
+
+    def __init__(self, cache_dir=None, cache_size=None):
+        self._cache = _MeshFieldCache()
+        self._catalogue_rand = None
+        self._sampling = None
+        self._norm_factors_mesh_unit = {}
+
+        if cache_dir is not None:
+            cache_dir = os.path.join(os.fspath(cache_dir), '')
+            os.makedirs(cache_dir, exist_ok=True)
+        self._cache_dir = cache_dir
+        self._cache_size = cache_size or 0.
+        self._persisted = False
+
+    @property
+    def count_rand_computed(self):
+        return self._cache.count_rand_computed
+
+    @property
+    def count_rand_reused(self):
+        return self._cache.count_rand_reused
+
+    @property
+    def count_rand_loaded(self):
+        return self._cache.count_rand_loaded
+
+    def clear(self):
+        """Clear all cached fields and unbind the random-source
+        catalogue.
+
+        """
+        self._cache.clear()
+        self._catalogue_rand = None
+        self._sampling = None
+        self._norm_factors_mesh_unit = {}
+        self._persisted = False
+
+    def _bind(self, catalogue_rand, paramset):
+        """Bind the cache to a random-source catalogue and sampling
+        parameters.
+
+        Parameters
+        ----------
+        catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
+            Random-source catalogue (already aligned if bound for
+            the first time).
+        paramset : :class:`~triumvirate.parameters.ParameterSet`
+            Parameter set.
+
+        Returns
+        -------
+        bool
+            `True` if the cache has already been bound, otherwise `False`.
+
+        Raises
+        ------
+        ValueError
+            When the cache has been bound to a different random-source
+            catalogue or different sampling parameters.
+
+        """
+        sampling = (
+            tuple(paramset['boxsize'][ax] for ax in ['x', 'y', 'z']),
+            tuple(paramset['ngrid'][ax] for ax in ['x', 'y', 'z']),
+            paramset['alignment'],
+            paramset['padscale'],
+            paramset['padfactor'],
+            paramset['assignment'],
+        )
+
+        if self._catalogue_rand is None:
+            self._catalogue_rand = catalogue_rand
+            self._sampling = sampling
+            return False
+
+        if catalogue_rand is not self._catalogue_rand:
+            raise ValueError(
+                "Mesh field cache is bound to a different "
+                "random-source catalogue."
+            )
+        if sampling != self._sampling:
+            raise ValueError(
+                "Mesh field cache is bound to different "
+                "sampling parameters."
+            )
+
+        return True
+
+    def _get_cpp_cache(self, particles_rand):
+        """Get the C++ mesh field cache for a measurement.
+
+        Parameters
+        ----------
+        particles_rand : :class:`~triumvirate._particles._ParticleCatalogue`
+            Random-source particle catalogue (aligned).
+
+        Returns
+        -------
+        :class:`~triumvirate._field._MeshFieldCache`
+            C++ mesh field cache.
+
+        """
+        # The on-disk cache is keyed by the content hash of the bound
+        # random-source catalogue, which is only aligned on first use.
+        if self._cache_dir is not None and not self._persisted:
+            self._cache.persist_random_fields(
+                self._cache_dir, self._cache_size, particles_rand
+            )
+            self._persisted = True
+        return self._cache
+
+    def _get_norm_factor_mesh_unit(self, npoint, calc_norm_func,
+                                   particles_rand, paramset):
+        """Get the mesh normalisation factor with unit alpha contrast.
+
+        Parameters
+        ----------
+        npoint : {'2pt', '3pt'}
+            N-point case.
+        calc_norm_func : callable
+            Mesh normalisation function.
+        particles_rand : :class:`~triumvirate._particles._ParticleCatalogue`
+            Random-source particle catalogue.
+        paramset : :class:`~triumvirate.parameters.ParameterSet`
+            Parameter set.
+
+        Returns
+        -------
+        float
+            Mesh normalisation factor with unit alpha contrast.
+
+        """
+        if npoint not in self._norm_factors_mesh_unit:
+            self._norm_factors_mesh_unit[npoint] = calc_norm_func(
+                particles_rand, paramset, 1.
+            )
+        return self._norm_factors_mesh_unit[npoint]
+
+
 def record_binned_vectors(binning, paramset=None, boxsize=None, ngrid=None):
     """Record binned vectors given a binning scheme and mesh grid
     parameters.
@@ -35,7 +35,9 @@
 #include <cfenv>
 #include <cmath>
 #include <cstdarg>
+#include <cstddef>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "monitor.hpp"
@@ -159,6 +161,51 @@ void extrap_pad(
   std::vector<double>& a_ext
 );
 
+/**
+ * @brief Extrapolate a 1-d array by an extrapolation scheme.
+ *
+ * Constant padding uses the end values of the array.
+ *
+ * @param[in] a 1-d array as a vector.
+ * @param[in] N_ext Number of extra elements on either side.
+ * @param[in] extrap Extrapolation scheme.
+ * @param[out] a_ext Extrapolated 1-d array.
+ * @throws trv::sys::InvalidParameterError When `extrap` is
+ *                                         @ref trv::array::ExtrapOption::NONE
+ *                                         or unsupported.
+ */
+void extrap_by_option(
+  std::vector<double>& a, int N_ext, ExtrapOption extrap,
+  std::vector<double>& a_ext
+);
+
+/**
+ * @brief Extrapolate a contiguous row-major 2-d array along each row
+ *        and then along each column by an extrapolation scheme.
+ *
+ * Constant padding uses the end values of each row and column, so that
+ * corners are padded with the corner values of the array.
+ *
+ * @param[in] a 2-d array as a contiguous row-major vector.
+ * @param[in] nrow, ncol Number of rows and columns.
+ * @param[in] N_row_ext Number of extra elements on either side
+ *                      of each row.
+ * @param[in] N_col_ext Number of extra elements on either side
+ *                      of each column.
+ * @param[in] extrap Extrapolation scheme.
+ * @param[out] a_ext Extrapolated 2-d array as a contiguous row-major
+ *                   vector of (@p nrow + 2 @p N_col_ext) rows and
+ *                   (@p ncol + 2 @p N_row_ext) columns.
+ * @throws trv::sys::InvalidParameterError When `extrap` is
+ *                                         @ref trv::array::ExtrapOption::NONE
+ *                                         or unsupported.
+ */
+void extrap2d_by_option(
+  const std::vector<double>& a, int nrow, int ncol,
+  int N_row_ext, int N_col_ext, ExtrapOption extrap,
+  std::vector<double>& a_ext
+);
+
 /**
  * @brief Extrapolate a 2-d array bi-linearly.
  *
@@ -0,0 +1,186 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file checkpoint.hpp
+ * @authors Mike S Wang (https://github.com/MikeSWang)
+ * @brief Checkpointing of three-point statistic term loops.
+ *
+ * This module saves the accumulated data vectors of a three-point
+ * statistic measurement together with the set of completed
+ * (@f$ m_1 @f$, @f$ m_2 @f$, @f$ M @f$) terms, so that an interrupted
+ * measurement can be resumed without recomputing completed terms.
+ *
+ */
+
+#ifndef TRIUMVIRATE_INCLUDE_CHECKPOINT_HPP_INCLUDED_
+#define TRIUMVIRATE_INCLUDE_CHECKPOINT_HPP_INCLUDED_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "monitor.hpp"
+#include "parameters.hpp"
+#include "particles.hpp"
+#include "field.hpp"
+
+namespace trv {
+
+/**
+ * @brief Checkpoint of a three-point statistic term loop.
+ *
+ * Checkpointing is enabled by @ref trv::ParameterSet::checkpoint_dir.
+ * The state file in that directory is named after a hash of a key
+ * derived from the measurement parameters and the content hashes of
+ * the catalogues, so that different measurements never share state.
+ * The state is saved after each completed term and removed once the
+ * measurement is finalised.
+ *
+ */
+class TermCheckpoint {
+ public:
+  /**
+   * @brief Construct a term checkpoint.
+   *
+   * @param params Parameter set.
+   * @param catalogues Particle catalogues measured.
+   * @param variant Additional identifier of the measurement variant
+   *                (default is empty).
+   *
+   * @note If checkpointing is disabled, @p catalogues are not hashed
+   *       and all other methods have no effect.
+   */
+  TermCheckpoint(
+    trv::ParameterSet& params,
+    std::vector<ParticleCatalogue*> catalogues,
+    const std::string variant = ""
+  );
+
+  /**
+   * @brief Check if checkpointing is enabled.
+   *
+   * @returns { @c true , @c false }
+   */
+  bool is_enabled();
+
+  /**
+   * @brief Attach a data buffer to be saved and restored with
+   *        the state.
+   *
+   * @param data Data buffer.
+   * @param nbytes Size of the data buffer in bytes.
+   *
+   * @attention Buffers must be attached in the same order before
+   *            the state is resumed.
+   */
+  void attach(void* data, std::size_t nbytes);
+
+  /**
+   * @brief Resume the saved state if any.
+   *
+   * The attached buffers and the set of completed terms are restored
+   * from a matching state file; otherwise they are left unchanged.
+   *
+   * @returns Number of completed terms.
+   */
+  int resume();
+
+  /**
+   * @brief Check if a term has been completed.
+   *
+   * @param m1 Order of the first spherical harmonic.
+   * @param m2 Order of the second spherical harmonic.
+   * @param M Order of the line-of-sight spherical harmonic.
+   * @returns { @c true , @c false }
+   */
+  bool is_completed(int m1, int m2, int M);
+
+  /**
+   * @brief Mark a term as completed and save the state.
+   *
+   * @param m1 Order of the first spherical harmonic.
+   * @param m2 Order of the second spherical harmonic.
+   * @param M Order of the line-of-sight spherical harmonic.
+   */
+  void complete(int m1, int m2, int M);
+
+  /**
+   * @brief Restore a checkpointed mesh field.
+   *
+   * @param params Parameter set.
+   * @param label Field label in the checkpoint.
+   * @param name Field name.
+   * @returns Mesh field (null if not checkpointed).
+   */
+  std::shared_ptr<MeshField> restore_field(
+    trv::ParameterSet& params, const std::string label,
+    const std::string name
+  );
+
+  /**
+   * @brief Checkpoint a mesh field if
+   *        @ref trv::ParameterSet::checkpoint_fields is enabled.
+   *
+   * @param field Mesh field.
+   * @param label Field label in the checkpoint.
+   */
+  void save_field(MeshField& field, const std::string label);
+
+  /**
+   * @brief Finalise the checkpoint by removing the state file and
+   *        any checkpointed fields.
+   */
+  void finalise();
+
+ private:
+  bool enabled = false;      ///< checkpointing flag
+  bool with_fields = false;  ///< field checkpointing flag
+  std::string key;           ///< identifying key of the measurement
+  std::string filepath;      ///< state file path
+  /// attached data buffers and their sizes in bytes
+  std::vector< std::pair<void*, std::size_t> > buffers;
+  /// completed terms
+  std::set< std::array<int, 3> > terms;
+  /// checkpointed field file paths
+  std::set<std::string> filepaths_fields;
+
+  /**
+   * @brief Save the state.
+   *
+   * @returns Exit status (0 on success).
+   */
+  int save();
+
+  /**
+   * @brief Return the file path of a checkpointed field.
+   *
+   * @param label Field label in the checkpoint.
+   * @returns File path.
+   */
+  std::string get_field_filepath(const std::string label);
+};
+
+}  // namespace trv
+
+#endif  // !TRIUMVIRATE_INCLUDE_CHECKPOINT_HPP_INCLUDED_
@@ -198,25 +198,58 @@ struct LineOfSight {
  *
  */
 struct PowspecMeasurements {
-  int dim = 0;               ///< dimension of data vector
-  std::vector<double> kbin;  ///< central wavenumber in bins
-  std::vector<double> keff;  ///< effective wavenumber in bins
-  std::vector<int> nmodes;   ///< number of wavevectors in bins
+  int dim = 0;                   ///< dimension of data vector
+  std::vector<double> kbin;      ///< central wavenumber in bins
+  std::vector<double> keff;      ///< effective wavenumber in bins
+  std::vector<long long> nmodes;  ///< number of wavevectors in bins
   /// power spectrum raw measurements (with normalisation and shot noise)
   std::vector< std::complex<double> > pk_raw;
   /// power spectrum shot noise
   std::vector< std::complex<double> > pk_shot;
 };
 
+/**
+ * @brief Power spectrum multipole and wedge measurements from a single
+ *        (k, μ) accumulation.
+ *
+ * Multipole and wedge entries are flattened with the wavenumber bin
+ * index running fastest, i.e. the entry for the multipole (wedge) index
+ * @f$ i @f$ and the wavenumber bin index @f$ j @f$ is at
+ * @f$ i \times \mathrm{dim} + j @f$.
+ */
+struct PowspecKMuMeasurements {
+  int dim = 0;                   ///< dimension of data vector
+  int num_wedges = 0;            ///< number of wedges in |μ|
+  std::vector<int> ells;         ///< degrees of multipoles
+  std::vector<double> kbin;      ///< central wavenumber in bins
+  std::vector<double> keff;      ///< effective wavenumber in bins
+  std::vector<long long> nmodes;  ///< number of wavevectors in bins
+  /// power spectrum multipole raw measurements (with normalisation and
+  /// shot noise)
+  std::vector< std::complex<double> > pk_raw;
+  /// power spectrum multipole shot noise
+  std::vector< std::complex<double> > pk_shot;
+  std::vector<double> mu_edges;  ///< wedge edges in |μ|
+  std::vector<double> keff_wedges;  ///< effective wavenumber in wedge bins
+  std::vector<double> mueff_wedges;  ///< effective |μ| in wedge bins
+  /// number of wavevectors in wedge bins
+  std::vector<long long> nmodes_wedges;
+  /// power spectrum wedge raw measurements (with normalisation and
+  /// shot noise)
+  std::vector< std::complex<double> > pk_raw_wedges;
+  /// power spectrum wedge shot noise
+  std::vector< std::complex<double> > pk_shot_wedges;
+};
+
 /**
  * @brief Two-point correlation function measurements.
  *
  */
 struct TwoPCFMeasurements {
-  int dim = 0;               ///< dimension of data vector
-  std::vector<double> rbin;  ///< central separation in bins
-  std::vector<double> reff;  ///< effective separation in bins
-  std::vector<int> npairs;   ///< number of separation vectors in bins
+  int dim = 0;                   ///< dimension of data vector
+  std::vector<double> rbin;      ///< central separation in bins
+  std::vector<double> reff;      ///< effective separation in bins
+  std::vector<long long> npairs;  ///< number of separation vectors in bins
   /// two-point correlation function measurements (with normalisation)
   std::vector< std::complex<double> > xi;
 };
@@ -226,10 +259,10 @@ struct TwoPCFMeasurements {
  *
  */
 struct TwoPCFWindowMeasurements {
-  int dim = 0;               ///< dimension of data vector
-  std::vector<double> rbin;  ///< central separation in bins
-  std::vector<double> reff;  ///< effective separation in bins
-  std::vector<int> npairs;   ///< number of separation vectors in bins
+  int dim = 0;                   ///< dimension of data vector
+  std::vector<double> rbin;      ///< central separation in bins
+  std::vector<double> reff;      ///< effective separation in bins
+  std::vector<long long> npairs;  ///< number of separation vectors in bins
   /// two-point correlation function window measurements
   /// (with normalisation)
   std::vector< std::complex<double> > xi;
@@ -250,8 +283,10 @@ struct BispecMeasurements {
   std::vector<double> k2_bin;  ///< second central wavenumber in bins
   std::vector<double> k1_eff;  ///< first effective wavenumber in bins
   std::vector<double> k2_eff;  ///< second effective wavenumber in bins
-  std::vector<int> nmodes_1;   ///< number of first wavevectors in bins
-  std::vector<int> nmodes_2;   ///< number of second wavevectors in bins
+  /// number of first wavevectors in bins
+  std::vector<long long> nmodes_1;
+  /// number of second wavevectors in bins
+  std::vector<long long> nmodes_2;
   /// bispectrum raw measurements (with normalisation and shot noise)
   std::vector< std::complex<double> > bk_raw;
   /// bispectrum shot noise
@@ -269,9 +304,9 @@ struct ThreePCFMeasurements {
   std::vector<double> r1_eff;  ///< first effective separation in bins
   std::vector<double> r2_eff;  ///< second effective separation in bins
   /// number of first separation vectors in bins
-  std::vector<int> npairs_1;
+  std::vector<long long> npairs_1;
   /// number of second separation vectors in bins
-  std::vector<int> npairs_2;
+  std::vector<long long> npairs_2;
   /// three-point correlation function raw measurements
   /// (with normalisation and shot noise)
   std::vector< std::complex<double> > zeta_raw;
@@ -290,9 +325,9 @@ struct ThreePCFWindowMeasurements {
   std::vector<double> r1_eff;  ///< first effective separation in bins
   std::vector<double> r2_eff;  ///< second effective separation in bins
   /// number of first separation vectors in bins
-  std::vector<int> npairs_1;
+  std::vector<long long> npairs_1;
   /// number of second separation vectors in bins
-  std::vector<int> npairs_2;
+  std::vector<long long> npairs_2;
   /// three-point correlation function window raw measurements
   /// (with normalisation and shot noise)
   std::vector< std::complex<double> > zeta_raw;
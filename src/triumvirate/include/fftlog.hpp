@@ -31,11 +31,18 @@
 
 #include <fftw3.h>
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
 #include <vector>
 
+#include "monitor.hpp"
 #include "maths.hpp"
 #include "arrayops.hpp"
 
@@ -171,9 +178,32 @@ class HankelTransform {
    */
   void biased_transform(std::complex<double>* a, std::complex<double>* b);
 
+  /**
+   * @brief Perform the (forward biased) Hankel transform on a batch of
+   *        real sample arrays.
+   *
+   * The batch is transformed by a single pair of real-to-complex and
+   * complex-to-real FFTW plans over all rows, which are created on the
+   * first call and reused for subsequent calls with the same batch size.
+   * As the kernel coefficients are Hermitian, real pre-transform samples
+   * result in real post-transform samples.  Concurrent calls on the same
+   * instance are serialised as they share the plans and arrays.
+   *
+   * @param[in] nbatch Number of sample arrays in the batch.
+   * @param[in] a Pre-transform sample values as a row-major
+   *              (@p nbatch × @ref nsamp) block.
+   * @param[out] b Post-transform sample values as a row-major
+   *               (@p nbatch × @ref nsamp) block.
+   */
+  void biased_transform_batch(int nbatch, const double* a, double* b);
+
   /**
    * @brief Compute the FFTLog transform kernel coefficients @f$ u @f$.
    *
+   * Coefficients are cached process-wide by the transform order,
+   * bias index, transform sample size, sample spacing and pivot value,
+   * so they are only computed once for identical transforms.
+   *
    * @returns Kernel coefficients.
    */
   std::vector< std::complex<double> > compute_kernel_coeff();
@@ -217,6 +247,31 @@ class HankelTransform {
   fftw_plan post_plan;
   fftw_complex* post_buffer;
 
+  int nbatch_plan = 0;  ///< batch size of the batched FFTW plans
+
+  /// batched pre-kernel FFTW plan and sample array
+  fftw_plan batch_pre_plan;
+  double* batch_buffer = nullptr;
+
+  /// batched post-kernel FFTW plan and Fourier array
+  fftw_plan batch_post_plan;
+  fftw_complex* batch_spectrum = nullptr;
+
+  /// mutex guarding the batched FFTW plans and arrays
+  std::mutex batch_mutex;
+
+  /**
+   * @brief Create the batched FFTW plans for a batch size.
+   *
+   * @param nbatch Number of sample arrays in the batch.
+   */
+  void plan_batch(int nbatch);
+
+  /**
+   * @brief Destroy any batched FFTW plans.
+   */
+  void destroy_batch_plans();
+
   /// FFTW multi-threading
   bool threaded = true;
 };
@@ -345,6 +400,141 @@ class SphericalBesselTransform: public HankelTransform {
   );
 };
 
+/**
+ * @brief Perform the (forward biased) double spherical Bessel transform
+ *        of 2-d samples using the FFTLog algorithm.
+ *
+ * The 2-d transform is performed on contiguous row-major arrays in two
+ * passes of batched 1-d transforms, first along each row (i.e. in the
+ * second dimension) and then along each column (i.e. in the first
+ * dimension).  Any extrapolation is applied either in 2-d before the
+ * transform or in 1-d to each row and column in its pass, and is
+ * trimmed off afterwards.
+ *
+ */
+class DoubleSphericalBesselTransform {
+ public:
+  int degrees[2];       ///< degrees of the spherical Bessel transform
+  int biases[2];        ///< power-law bias indices
+  int nsamp = 0;        ///< number of samples provided per dimension
+  int nsamp_trans = 0;  ///< number of samples transformed per dimension
+  double logres = 0.;   ///< logarithmic interval sample spacing
+  double pivot = 1.;    ///< pivot value (of the first dimension)
+
+  /// logarithmically linearly-spaced sample points pre-transform
+  /// (including any extrapolation)
+  std::vector<double> pre_sampts;
+
+  /// logarithmically linearly-spaced sample points post-transform
+  /// (of the first dimension)
+  std::vector<double> post_sampts;
+
+  /**
+   * @brief Construct the double spherical Bessel transform.
+   *
+   * @param ell1, ell2 Degrees of the spherical Bessel transform in
+   *                   each dimension.
+   * @param n1, n2 Power-law bias indices in each dimension.
+   * @param threaded If `true` (default), use multi-threads.
+   */
+  DoubleSphericalBesselTransform(
+    int ell1, int ell2, int n1, int n2, bool threaded = true
+  );
+
+  /**
+   * @brief Initialise the double spherical Bessel transform.
+   *
+   * @param sample_pts Logarithmically linearly-spaced sample points
+   *                   in either dimension.  Must be even in length if
+   *                   extrapolation is enabled.
+   * @param kr_c Pivot value.
+   * @param lowring If true (default), set the pivot value by the
+   *                low-ringing condition.
+   * @param extrap Extrapolation option.  If not 0 (default),
+   *               the sample size for the transform is the smallest
+   *               power of 2 that is greater than or equal to
+   *               `extrap_exp` times the original number of
+   *               sample points.
+   * @param extrap_exp Sample size expansion factor (default is 2.) for
+   *                   extrapolation.
+   * @param extrap2d If `true` (default is `false`), extrapolate in 2-d
+   *                 before the transform; otherwise, extrapolate each
+   *                 row and column in 1-d in its pass.
+   * @throws trv::sys::InvalidParameterError When the size of `sample_pts`
+   *                                         is not even with
+   *                                         extrapolation enabled.
+   */
+  void initialise(
+    std::vector<double> sample_pts, double kr_c,
+    bool lowring = true,
+    int extrap = 0,
+    double extrap_exp = 2.,
+    bool extrap2d = false
+  );
+
+  /**
+   * @brief Perform the (forward biased) double spherical Bessel
+   *        transform.
+   *
+   * The transform is defined here as
+   * @f[
+   *   b(k_1, k_2) = (4\pi)^2 \int_0^\infty r_1^2 \mathrm{d}r_1
+   *     \int_0^\infty r_2^2 \mathrm{d}r_2 \,
+   *     (k_1 r_1)^{q_1} j_{\ell_1}(k_1 r_1)
+   *     (k_2 r_2)^{q_2} j_{\ell_2}(k_2 r_2) \, a(r_1, r_2) \,.
+   * @f]
+   *
+   * @param[in] a Pre-transform sample values as a row-major
+   *              (@ref nsamp × @ref nsamp) block.  Assumed to be real.
+   * @param[out] b Post-transform sample values as a row-major
+   *               (@ref nsamp × @ref nsamp) block.
+   */
+  void biased_transform(const double* a, double* b);
+
+ private:
+  /// 1-d Hankel transforms in each dimension
+  std::unique_ptr<HankelTransform> transforms[2];
+
+  /// extrapolation option (default is none)
+  trva::ExtrapOption extrap = trva::ExtrapOption::NONE;
+
+  /// 2-d extrapolation
+  bool extrap2d = false;
+
+  /// number of extra sample points on either side
+  int n_ext = 0;
+
+  /// pre-transform factors @f$ r^{3/2} @f$
+  std::vector<double> pre_factors;
+
+  /// post-transform factors @f$ (2\pi/k)^{3/2} @f$ in each dimension
+  std::vector<double> post_factors[2];
+
+  /// multi-threading
+  bool threaded = true;
+
+  /// work buffers for pre- and post-transform rows, intermediate
+  /// samples and extrapolated samples, reused across transforms
+  std::vector<double> pre_buffer;
+  std::vector<double> post_buffer;
+  std::vector<double> inter_buffer;
+  std::vector<double> ext_buffer;
+
+  /**
+   * @brief Transform each row of a 2-d array in one dimension and
+   *        transpose the result.
+   *
+   * @param[in] idim Dimension index.
+   * @param[in] nrow Number of rows.
+   * @param[in] in Input 2-d array in row-major order.  Rows are of
+   *               length @ref nsamp if extrapolated in 1-d, or otherwise
+   *               of length @ref nsamp_trans.
+   * @param[out] out Transposed output 2-d array in row-major order,
+   *                 with columns of the same length as rows of @p in.
+   */
+  void transform_rows(int idim, int nrow, const double* in, double* out);
+};
+
 }  // namespace trv::maths
 
 }  // namespace trv
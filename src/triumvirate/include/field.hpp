@@ -28,7 +28,7 @@
  * weights to a mesh grid to construct discretely sampled fields, and
  * the Fourier transform and its inverse of the said fields.  It also
  * provides the corrections needed due to sampling effects, interlaced
- * 'shadow' mesh grid for reducing aliasing effects, and methods to
+ * 'shadow' mesh grids for reducing aliasing effects, and methods to
  * compute various constituent terms (one-point and pseudo two-point
  * statistics) in the estimators of two- and three-point statistics.
  *
@@ -42,6 +42,9 @@
 #include <cmath>
 #include <complex>
 #include <functional>
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "arrayops.hpp"
@@ -115,13 +118,47 @@ class MeshField {
   ~MeshField();
 
   /**
-   * @brief (Re-)initialise the complex field (and its shadow) on mesh.
+   * @brief (Re-)initialise the complex field (and its shadows) on mesh.
    *
    * This is an explicit method to reset values of
    * @ref trv::MeshField.field (and its interlaced counterpart) to zeros.
    */
   void reset_density_field();
 
+  /**
+   * @brief Return the memory size of a mesh field (including its
+   *        shadows if interlacing is used).
+   *
+   * @param params Parameter set.
+   * @returns Memory size (in gibibytes).
+   */
+  static double get_size_in_gb(trv::ParameterSet& params);
+
+  /**
+   * @brief Return the parameter set of the mesh grid cropped in Fourier
+   *        space to hold all wavevector modes entering triple products
+   *        of two fields band-limited below a maximum wavenumber.
+   *
+   * In each dimension, the cropped grid number is the smallest
+   * FFT-friendly even number exceeding @f$ 4 n_\mathrm{max} @f$, where
+   * @f$ n_\mathrm{max} @f$ is the largest wavevector index below
+   * @p k_max, so that the triple products of two such band-limited
+   * fields with any other field summed over the cropped mesh grid
+   * are free of aliasing.  Grid numbers are not increased beyond those
+   * in @p params.
+   *
+   * @param params Parameter set.
+   * @param k_max Maximum wavenumber.
+   * @returns Parameter set of the cropped mesh grid.
+   *
+   * @attention Assignment compensation is disabled in the returned
+   *            parameter set, as cropped fields are already compensated
+   *            (see @ref trv::MeshField::crop_field_in_fourier()).
+   */
+  static trv::ParameterSet get_cropped_params(
+    trv::ParameterSet& params, double k_max
+  );
+
   // ---------------------------------------------------------------------
   // Operators & reserved methods
   // ---------------------------------------------------------------------
@@ -132,7 +169,7 @@ class MeshField {
    * @param gid Grid index.
    * @returns Field value.
    */
-  const fftw_complex& operator[](int gid);
+  const fftw_complex& operator[](long long gid);
 
   // ---------------------------------------------------------------------
   // Mesh assignment
@@ -210,15 +247,15 @@ class MeshField {
    *
    * @param particles_data (Data-source) particle catalogue.
    * @param particles_rand (Random-source) particle catalogue.
-   * @param los_data (Data-source) particle lines of sight.
-   * @param los_rand (Random-source) particle lines of sight.
+   * @param los_data (Data-source) particle line-of-sight policy.
+   * @param los_rand (Random-source) particle line-of-sight policy.
    * @param alpha Alpha contrast.
    * @param ell Degree of the spherical harmonic.
    * @param m Order of the spherical harmonic.
    */
   void compute_ylm_wgtd_field(
     ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-    LineOfSight* los_data, LineOfSight* los_rand,
+    const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
     double alpha, int ell, int m
   );
 
@@ -227,7 +264,7 @@ class MeshField {
    *        reduced spherical harmonics.
    *
    * @param particles Particle catalogue.
-   * @param los Particle lines of sight.
+   * @param los Particle line-of-sight policy.
    * @param alpha Alpha contrast.
    * @param ell Degree of the spherical harmonic.
    * @param m Order of the spherical harmonic.
@@ -235,10 +272,30 @@ class MeshField {
    * @overload
    */
   void compute_ylm_wgtd_field(
-    ParticleCatalogue& particles, LineOfSight* los,
+    ParticleCatalogue& particles, const LineOfSightPolicy& los,
     double alpha, int ell, int m
   );
 
+  /**
+   * @brief Compute the weighted field (fluctuations) further weighted
+   *        by the reduced spherical harmonics with a precomputed
+   *        random-source field.
+   *
+   * @param particles_data (Data-source) particle catalogue.
+   * @param los_data (Data-source) particle line-of-sight policy.
+   * @param field_rand Random-source field computed with unit alpha
+   *                   contrast and the same @p ell and @p m.
+   * @param alpha Alpha contrast.
+   * @param ell Degree of the spherical harmonic.
+   * @param m Order of the spherical harmonic.
+   *
+   * @overload
+   */
+  void compute_ylm_wgtd_field(
+    ParticleCatalogue& particles_data, const LineOfSightPolicy& los_data,
+    MeshField& field_rand, double alpha, int ell, int m
+  );
+
   /**
    * @brief Compute the quadratic weighted field (fluctuations) further
    *        weighted by the reduced spherical harmonics.
@@ -264,15 +321,15 @@ class MeshField {
    *
    * @param particles_data (Data-source) particle catalogue.
    * @param particles_rand (Random-source) particle catalogue.
-   * @param los_data (Data-source) particle lines of sight.
-   * @param los_rand (Random-source) particle lines of sight.
+   * @param los_data (Data-source) particle line-of-sight policy.
+   * @param los_rand (Random-source) particle line-of-sight policy.
    * @param alpha Alpha contrast.
    * @param ell Degree of the spherical harmonic.
    * @param m Order of the spherical harmonic.
    */
   void compute_ylm_wgtd_quad_field(
     ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-    LineOfSight* los_data, LineOfSight* los_rand,
+    const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
     double alpha, int ell, int m
   );
 
@@ -281,7 +338,7 @@ class MeshField {
    *        weighted by the reduced spherical harmonics.
    *
    * @param particles Particle catalogue.
-   * @param los Particle lines of sight.
+   * @param los Particle line-of-sight policy.
    * @param alpha Alpha contrast.
    * @param ell Degree of the spherical harmonic.
    * @param m Order of the spherical harmonic.
@@ -289,10 +346,87 @@ class MeshField {
    * @overload
    */
   void compute_ylm_wgtd_quad_field(
-    ParticleCatalogue& particles, LineOfSight* los,
+    ParticleCatalogue& particles, const LineOfSightPolicy& los,
     double alpha, int ell, int m
   );
 
+  /**
+   * @brief Compute the quadratic weighted field (fluctuations) further
+   *        weighted by the reduced spherical harmonics with
+   *        a precomputed random-source field.
+   *
+   * @param particles_data (Data-source) particle catalogue.
+   * @param los_data (Data-source) particle line-of-sight policy.
+   * @param field_rand Random-source quadratic field computed with unit
+   *                   alpha contrast and the same @p ell and @p m.
+   * @param alpha Alpha contrast.
+   * @param ell Degree of the spherical harmonic.
+   * @param m Order of the spherical harmonic.
+   *
+   * @overload
+   */
+  void compute_ylm_wgtd_quad_field(
+    ParticleCatalogue& particles_data, const LineOfSightPolicy& los_data,
+    MeshField& field_rand, double alpha, int ell, int m
+  );
+
+  /**
+   * @brief Compute a pair of weighted field (fluctuations) further
+   *        weighted by the Cartesian line-of-sight moments, packed into
+   *        the real and imaginary parts.
+   *
+   * For a field (or its fluctuations) @f$ f @f$, this is
+   * @f[
+   *   f_a(\vec{x}) + \mathrm{i} f_b(\vec{x}) =
+   *     {\sum_i}{\vphantom{\sum}}'
+   *     \big[ c_a(\hat{\vec{x}}) + \mathrm{i} c_b(\hat{\vec{x}}) \big]
+   *     w(\vec{x}) \delta^{(\mathrm{D})}(\vec{x} - \vec{x}_i) \,,
+   * @f]
+   * where @f$ c_a @f$ are the line-of-sight moments from
+   * @ref trv::maths::CartesianMomentCalculator, and
+   * @f$ {\sum_i}{\vphantom{\sum}}' @f$ is as in
+   * @ref trv::MeshField::compute_ylm_wgtd_field().  As both moment
+   * fields are real, they can be unpacked after Fourier transform
+   * (see @ref trv::MeshField::add_unpacked_los_moment_wgtd_fields()).
+   *
+   * @param particles_data (Data-source) particle catalogue.
+   * @param particles_rand (Random-source) particle catalogue.
+   * @param los_data (Data-source) particle line-of-sight policy.
+   * @param los_rand (Random-source) particle line-of-sight policy.
+   * @param alpha Alpha contrast.
+   * @param moment_calc Cartesian moment calculator.
+   * @param idx_a Moment index packed into the real part.
+   * @param idx_b Moment index packed into the imaginary part
+   *              (or -1 for none).
+   */
+  void compute_los_moment_wgtd_field(
+    ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+    const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+    double alpha, const trv::maths::CartesianMomentCalculator& moment_calc,
+    int idx_a, int idx_b
+  );
+
+  /**
+   * @brief Compute a pair of weighted field further weighted by the
+   *        Cartesian line-of-sight moments, packed into the real and
+   *        imaginary parts.
+   *
+   * @param particles Particle catalogue.
+   * @param los Particle line-of-sight policy.
+   * @param alpha Alpha contrast.
+   * @param moment_calc Cartesian moment calculator.
+   * @param idx_a Moment index packed into the real part.
+   * @param idx_b Moment index packed into the imaginary part
+   *              (or -1 for none).
+   *
+   * @overload
+   */
+  void compute_los_moment_wgtd_field(
+    ParticleCatalogue& particles, const LineOfSightPolicy& los,
+    double alpha, const trv::maths::CartesianMomentCalculator& moment_calc,
+    int idx_a, int idx_b
+  );
+
   // ---------------------------------------------------------------------
   // Field transforms
   // ---------------------------------------------------------------------
@@ -301,17 +435,58 @@ class MeshField {
    * @brief Fourier transform the field.
    *
    * If @c trv::MeshField.params.interlace is set to "true", interlacing
-   * is performed where a phase factor is multiplied into the 'shadow'
-   * complex field before the average of the complex field and its shadow
-   * is taken.
+   * is performed where a phase factor is multiplied into each 'shadow'
+   * complex field before the average of the complex field and its
+   * shadows is taken.  For interlacing of order @f$ N @f$, the
+   * @f$ j @f$-th shadow field is sampled on the mesh grid shifted by
+   * @f$ j/N @f$ of the grid cell size along each dimension, so that
+   * the aliased images are suppressed except those with
+   * @f$ n_x + n_y + n_z \equiv 0 \pmod{N} @f$.
+   *
+   * If @p k_max is positive, only wavevector modes with
+   * @f$ |\vec{k}| \leqslant k_\mathrm{max} @f$ are needed and the
+   * transform may be pruned, i.e. 1-d transforms along pencils which
+   * do not reach these modes are skipped (see
+   * @ref trv::MeshField::execute_pruned_transform()).
+   *
+   * @param k_max Maximum wavenumber of the modes needed (default is 0.,
+   *              i.e. all modes are needed).
+   *
+   * @attention With pruning, modes on the skipped pencils are set to
+   *            zero and so the field should not be reused beyond
+   *            @p k_max.
    */
-  void fourier_transform();
+  void fourier_transform(double k_max = 0.);
 
   /**
    * @brief Inverse Fourier transform the (FFT-transformed) field.
    */
   void inv_fourier_transform();
 
+  /**
+   * @brief Execute a pruned 3-d Fourier transform in place.
+   *
+   * The transform is performed as three passes of batched 1-d
+   * transforms, one along each dimension, where blocks of adjacent
+   * pencils are skipped if they lie entirely outside the sphere of
+   * radius @p k_max (plus one fundamental wavenumber) in Fourier space.
+   * For the inverse transform, the input is assumed to vanish outside
+   * the sphere, so the passes along the x- and y-axes are pruned and
+   * the result is exact.  For the forward transform, the passes are
+   * reversed and the output on the skipped pencils is set to zero.
+   *
+   * @param[in,out] field_arr Complex field array.
+   * @param sign Sign of the transform, i.e. @c FFTW_FORWARD or
+   *             @c FFTW_BACKWARD.
+   * @param k_max Maximum wavenumber.
+   * @returns Whether the pruned transform has been executed; if not
+   *          (e.g. when too few pencils would be skipped), the full
+   *          transform should be executed instead.
+   */
+  bool execute_pruned_transform(
+    fftw_complex* field_arr, int sign, double k_max
+  );
+
   // ---------------------------------------------------------------------
   // Field operations
   // ---------------------------------------------------------------------
@@ -330,6 +505,54 @@ class MeshField {
    */
   void apply_assignment_compensation();
 
+  /**
+   * @brief Crop a Fourier-space field to the wavevector modes on the
+   *        (coarser) mesh grid of the current field.
+   *
+   * Assignment compensation is applied with respect to the mesh grid
+   * of @p field_fourier.
+   *
+   * @param field_fourier Fourier-space field on a mesh grid of the same
+   *                      box size.
+   * @throws trv::sys::InvalidParameterError When the mesh grid of the
+   *                                         current field is finer than
+   *                                         that of @p field_fourier
+   *                                         in any dimension.
+   *
+   * @see @ref trv::MeshField::get_cropped_params().
+   */
+  void crop_field_in_fourier(MeshField& field_fourier);
+
+  /**
+   * @brief Unpack a pair of Fourier-transformed Cartesian moment fields
+   *        and add them to the field weighted by the wavevector weights.
+   *
+   * For a packed field @f$ Z = F_a + \mathrm{i} F_b @f$ of two real
+   * moment fields, this adds
+   * @f[
+   *   w_a(\hat{\vec{k}}) F_a(\vec{k}) + w_b(\hat{\vec{k}}) F_b(\vec{k})
+   * @f]
+   * to the field, where @f$ F_a(\vec{k}) = [Z(\vec{k}) +
+   * Z^*(-\vec{k})] / 2 @f$ and @f$ F_b(\vec{k}) = - \mathrm{i}
+   * [Z(\vec{k}) - Z^*(-\vec{k})] / 2 @f$.
+   *
+   * @param field_packed Packed Fourier-space moment field from
+   *                     @ref trv::MeshField::compute_los_moment_wgtd_field().
+   * @param moment_calc Cartesian moment calculator.
+   * @param idx_a Moment index packed into the real part.
+   * @param idx_b Moment index packed into the imaginary part
+   *              (or -1 for none).
+   *
+   * @attention With interlacing, the packed field is only Hermitian
+   *            away from the Nyquist planes, where the unpacking is
+   *            therefore inexact.
+   */
+  void add_unpacked_los_moment_wgtd_fields(
+    MeshField& field_packed,
+    const trv::maths::CartesianMomentCalculator& moment_calc,
+    int idx_a, int idx_b
+  );
+
   // ---------------------------------------------------------------------
   // One-point statistics
   // ---------------------------------------------------------------------
@@ -358,9 +581,10 @@ class MeshField {
    * @param[out] nmodes Number of wavevector modes in band.
    */
   void inv_fourier_transform_ylm_wgtd_field_band_limited(
-    MeshField& field_fourier, std::vector< std::complex<double> >& ylm,
+    MeshField& field_fourier,
+    trv::sys::TrackedVector< std::complex<double> >& ylm,
     double k_band, double dk_band,
-    double& k_eff, int& nmodes
+    double& k_eff, long long& nmodes
   );
 
   /**
@@ -385,11 +609,55 @@ class MeshField {
    */
   void inv_fourier_transform_sjl_ylm_wgtd_field(
     MeshField& field_fourier,
-    std::vector< std::complex<double> >& ylm,
+    trv::sys::TrackedVector< std::complex<double> >& ylm,
     trvm::SphericalBesselCalculator& sjl,
     double r
   );
 
+  // ---------------------------------------------------------------------
+  // Field I/O
+  // ---------------------------------------------------------------------
+
+  /**
+   * @brief Write the field (and its shadow fields if interlaced) to
+   *        a raw binary file.
+   *
+   * The file consists of a fixed-size header recording the mesh grid
+   * properties and @p key, followed by the raw field values, so that
+   * it can be memory-mapped.  The file is written to a temporary path
+   * first and then renamed, so that it is never seen incomplete.
+   *
+   * @param filepath File path.
+   * @param key Identifying key recorded in the header.
+   * @returns Exit status (0 on success).
+   */
+  int write_to_file(const std::string& filepath, const std::string& key);
+
+  /**
+   * @brief Read the field (and its shadow fields if interlaced) from
+   *        a raw binary file written by
+   *        @ref trv::MeshField::write_to_file().
+   *
+   * @param filepath File path.
+   * @param key Identifying key expected in the header.
+   * @returns Exit status (0 on success; non-zero if the file is
+   *          missing or does not match the mesh grid or @p key,
+   *          in which case the field is unchanged).
+   */
+  int read_from_file(const std::string& filepath, const std::string& key);
+
+  // ---------------------------------------------------------------------
+  // Mesh grid properties
+  // ---------------------------------------------------------------------
+
+  /**
+   * @brief Return the grid cell index.
+   *
+   * @param i, j, k Grid index in each dimension.
+   * @returns Grid cell index.
+   */
+  long long ret_grid_index(int i, int j, int k);
+
   // ---------------------------------------------------------------------
   // Misc
   // ---------------------------------------------------------------------
@@ -408,8 +676,12 @@ class MeshField {
   double calc_grid_based_powlaw_norm(ParticleCatalogue& particles, int order);
 
  private:
-  /// half-grid shifted complex field on mesh
+  /// shifted complex field on mesh (the last shadow field for
+  /// interlacing, e.g. half-grid shifted for order 2)
   fftw_complex* field_s = nullptr;
+  /// stacked shadow fields in Fourier space (for interlacing of
+  /// order > 2)
+  fftw_complex* field_a = nullptr;
 
   /// FFTW plan for Fourier transform of the field
   fftw_plan transform;
@@ -421,19 +693,38 @@ class MeshField {
   bool plan_ini = false;  ///< FFTW plan initialisation flag
   bool plan_ext = false;  ///< FFTW plan externality flag
 
+  /// FFTW plans for pruned Fourier transform passes along each dimension
+  fftw_plan transform_pruned[3];
+  /// FFTW plans for pruned inverse Fourier transform passes along
+  /// each dimension
+  fftw_plan inv_transform_pruned[3];
+  /// number of adjacent pencils transformed together in pruned passes
+  int nblock_pruned = 1;
+  bool plan_pruned = false;  ///< pruned FFTW plan initialisation flag
+
   friend class FieldStats;
 
   // ---------------------------------------------------------------------
-  // Mesh grid properties
+  // Field transforms
   // ---------------------------------------------------------------------
 
   /**
-   * @brief Return the grid cell index.
+   * @brief Stack a shadow field for interlacing of order > 2.
    *
-   * @param i, j, k Grid index in each dimension.
-   * @returns Grid cell index.
+   * The shadow field sampled on the mesh grid shifted by @p ishift
+   * over the interlacing order of the grid cell size is Fourier
+   * transformed, multiplied by its phase factor and added to
+   * the stacked shadow fields, before being reset to zeros so that
+   * the next shadow field can be assigned.  This keeps the memory
+   * usage independent of the interlacing order.
+   *
+   * @param ishift Shift index of the shadow field.
    */
-  long long ret_grid_index(int i, int j, int k);
+  void stack_shadow_field(int ishift);
+
+  // ---------------------------------------------------------------------
+  // Mesh grid properties
+  // ---------------------------------------------------------------------
 
   /**
    * @brief Shift the grid indices on a discrete Fourier mesh grid.
@@ -519,6 +810,339 @@ class MeshField {
 };
 
 
+// ***********************************************************************
+// Mesh field cache
+// ***********************************************************************
+
+/**
+ * @brief Cache of mesh fields shared between measurements.
+ *
+ * This provides the mesh fields common to the estimators of two- and
+ * three-point statistics, i.e. the Fourier-space fields
+ * @f$ \delta{n}_{LM}(\vec{k}) @f$ and @f$ N_{LM}(\vec{k}) @f$ and the
+ * assignment-compensated configuration-space field
+ * @f$ G_{LM}(\vec{x}) @f$ (and their unweighted counterparts in
+ * a periodic box).  A field is only retained if it has been registered
+ * for use by a measurement (see @ref trv::MeasurementPlan), and is
+ * released once all registered measurements have used it; otherwise
+ * it is computed afresh on each request, so that a cache without any
+ * registered use reproduces the standalone measurement behaviour.
+ *
+ * @attention Cached fields are keyed by their type, spherical degree
+ *            and order (and interlacing), and are only valid for the
+ *            same catalogues, lines of sight, alpha contrast and mesh
+ *            parameters throughout the lifetime of the cache.
+ */
+class MeshFieldCache {
+ public:
+  int count_computed = 0;       ///< number of fields computed
+  int count_reused = 0;         ///< number of field requests from cache
+  int count_rand_computed = 0;  ///< number of random-source fields computed
+  int count_rand_reused = 0;    ///< number of random-source fields reused
+  /// number of random-source fields loaded from the on-disk cache
+  int count_rand_loaded = 0;
+
+  /**
+   * @brief Return the cache key of a field.
+   *
+   * @param type Field type: {"ylm_wgtd", "ylm_wgtd_quad",
+   *             "ylm_wgtd_config", "unwgtd_fluct", "unwgtd",
+   *             "unwgtd_fluct_config"}.
+   * @param ell Degree of the spherical harmonic.
+   * @param m Order of the spherical harmonic.
+   * @param params Parameter set.
+   * @returns Cache key.
+   */
+  static std::string get_key(
+    const std::string type, int ell, int m, trv::ParameterSet& params
+  );
+
+  /**
+   * @brief Register a measurement that will use a field.
+   *
+   * @param key Cache key.
+   */
+  void register_use(const std::string key);
+
+  /**
+   * @brief Release a field once used by a registered measurement.
+   *
+   * The field is dropped from the cache when no registered use remains.
+   *
+   * @param key Cache key.
+   */
+  void release_use(const std::string key);
+
+  /**
+   * @brief Retain random-source fields across data-source catalogues.
+   *
+   * Once enabled, the random-source contributions to the
+   * spherical-harmonic-weighted fields (fluctuations) are computed
+   * once for each pair of (@f$ \ell @f$, @f$ m @f$) and retained,
+   * so that each subsequent data-source catalogue only needs
+   * its own mesh assignments.  Fields that would exceed
+   * @ref trv::ParameterSet::memory_budget are not retained but
+   * recomputed with each use.
+   *
+   * @attention The random-source catalogue, its alignment and the
+   *            mesh parameters must remain unchanged while
+   *            random-source fields are retained.
+   */
+  void retain_random_fields();
+
+  /**
+   * @brief Persist retained random-source fields in an on-disk cache.
+   *
+   * Retention of random-source fields is enabled.  Each retained field
+   * is additionally written to @p cache_dir as a raw binary file (see
+   * @ref trv::MeshField::write_to_file()) named after the hash of
+   * a key derived from @p catalogue_hash, the line of sight, the mesh
+   * parameters and the field type and (@f$ \ell @f$, @f$ m @f$), and
+   * is read back in later runs instead of being recomputed.
+   *
+   * Cached files are invalidated whenever any part of the key changes
+   * (as they are then no longer found), or recomputed and overwritten
+   * if unreadable or mismatched.  When the total size of cached files
+   * exceeds @p cache_size, the least recently used files are evicted.
+   *
+   * @param cache_dir Cache directory (ending in "/").
+   * @param cache_size Cache size limit in gigabytes (non-positive for
+   *                   no limit).
+   * @param catalogue_hash Content hash of the random-source catalogue
+   *                       (see
+   *                       @ref trv::ParticleCatalogue::calc_content_hash()).
+   */
+  void persist_random_fields(
+    const std::string cache_dir, double cache_size,
+    const std::string catalogue_hash
+  );
+
+  /**
+   * @brief Clear all cached and retained fields.
+   */
+  void clear();
+
+  /**
+   * @brief Return the Fourier-space spherical-harmonic-weighted field
+   *        (fluctuations) @f$ \delta{n}_{LM}(\vec{k}) @f$.
+   *
+   * @param params Parameter set.
+   * @param particles_data (Data-source) particle catalogue.
+   * @param particles_rand (Random-source) particle catalogue.
+   * @param los_data (Data-source) particle line-of-sight policy.
+   * @param los_rand (Random-source) particle line-of-sight policy.
+   * @param alpha Alpha contrast.
+   * @param ell Degree of the spherical harmonic.
+   * @param m Order of the spherical harmonic.
+   * @param name Field name.
+   * @param k_max Maximum wavenumber of the modes needed, beyond which
+   *              the Fourier transform may be pruned unless the field
+   *              is cached (default is 0., i.e. no pruning).
+   * @returns Mesh field.
+   *
+   * @see @ref trv::MeshField::compute_ylm_wgtd_field(),
+   *      @ref trv::MeshField::fourier_transform().
+   */
+  std::shared_ptr<MeshField> get_ylm_wgtd_field(
+    trv::ParameterSet& params,
+    ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+    const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+    double alpha, int ell, int m, const std::string name,
+    double k_max = 0.
+  );
+
+  /**
+   * @brief Return the Fourier-space spherical-harmonic-weighted
+   *        quadratic field @f$ N_{LM}(\vec{k}) @f$.
+   *
+   * @param params Parameter set.
+   * @param particles_data (Data-source) particle catalogue.
+   * @param particles_rand (Random-source) particle catalogue.
+   * @param los_data (Data-source) particle line-of-sight policy.
+   * @param los_rand (Random-source) particle line-of-sight policy.
+   * @param alpha Alpha contrast.
+   * @param ell Degree of the spherical harmonic.
+   * @param m Order of the spherical harmonic.
+   * @param name Field name.
+   * @returns Mesh field.
+   *
+   * @see @ref trv::MeshField::compute_ylm_wgtd_quad_field().
+   */
+  std::shared_ptr<MeshField> get_ylm_wgtd_quad_field(
+    trv::ParameterSet& params,
+    ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+    const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+    double alpha, int ell, int m, const std::string name
+  );
+
+  /**
+   * @brief Return the configuration-space assignment-compensated
+   *        spherical-harmonic-weighted field (fluctuations)
+   *        @f$ G_{LM}(\vec{x}) @f$.
+   *
+   * The field is derived from @f$ \delta{n}_{LM}(\vec{k}) @f$ if the
+   * latter is registered for use (and thus cached).
+   *
+   * @param params Parameter set.
+   * @param particles_data (Data-source) particle catalogue.
+   * @param particles_rand (Random-source) particle catalogue.
+   * @param los_data (Data-source) particle line-of-sight policy.
+   * @param los_rand (Random-source) particle line-of-sight policy.
+   * @param alpha Alpha contrast.
+   * @param ell Degree of the spherical harmonic.
+   * @param m Order of the spherical harmonic.
+   * @param name Field name.
+   * @returns Mesh field.
+   */
+  std::shared_ptr<MeshField> get_ylm_wgtd_field_in_config(
+    trv::ParameterSet& params,
+    ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+    const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+    double alpha, int ell, int m, const std::string name
+  );
+
+  /**
+   * @brief Return the Fourier-space unweighted field fluctuations
+   *        @f$ \delta{n}(\vec{k}) @f$.
+   *
+   * @param params Parameter set.
+   * @param particles Particle catalogue.
+   * @param name Field name.
+   * @param k_max Maximum wavenumber of the modes needed, beyond which
+   *              the Fourier transform may be pruned unless the field
+   *              is cached (default is 0., i.e. no pruning).
+   * @returns Mesh field.
+   *
+   * @see @ref trv::MeshField::compute_unweighted_field_fluctuations_insitu(),
+   *      @ref trv::MeshField::fourier_transform().
+   */
+  std::shared_ptr<MeshField> get_unweighted_field_fluctuations(
+    trv::ParameterSet& params, ParticleCatalogue& particles,
+    const std::string name, double k_max = 0.
+  );
+
+  /**
+   * @brief Return the Fourier-space unweighted field
+   *        @f$ N(\vec{k}) @f$.
+   *
+   * @param params Parameter set.
+   * @param particles Particle catalogue.
+   * @param name Field name.
+   * @returns Mesh field.
+   *
+   * @see @ref trv::MeshField::compute_unweighted_field().
+   */
+  std::shared_ptr<MeshField> get_unweighted_field(
+    trv::ParameterSet& params, ParticleCatalogue& particles,
+    const std::string name
+  );
+
+  /**
+   * @brief Return the configuration-space assignment-compensated
+   *        unweighted field fluctuations @f$ G_{00}(\vec{x}) @f$.
+   *
+   * The field is derived from @f$ \delta{n}(\vec{k}) @f$ if the
+   * latter is registered for use (and thus cached).
+   *
+   * @param params Parameter set.
+   * @param particles Particle catalogue.
+   * @param name Field name.
+   * @returns Mesh field.
+   */
+  std::shared_ptr<MeshField> get_unweighted_field_fluctuations_in_config(
+    trv::ParameterSet& params, ParticleCatalogue& particles,
+    const std::string name
+  );
+
+ private:
+  /// cached fields
+  std::map< std::string, std::shared_ptr<MeshField> > fields;
+  /// number of registered uses remaining for each field
+  std::map<std::string, int> uses;
+  /// retained random-source fields (in configuration space)
+  std::map< std::string, std::shared_ptr<MeshField> > fields_rand;
+  bool retain_rand = false;  ///< whether random-source fields are retained
+  std::string cache_dir;       ///< on-disk cache directory
+  double cache_size = 0.;      ///< on-disk cache size limit (in GB)
+  std::string catalogue_hash;  ///< random-source catalogue content hash
+
+  /**
+   * @brief Look up a cached field.
+   *
+   * @param key Cache key.
+   * @returns Mesh field (null if not cached).
+   */
+  std::shared_ptr<MeshField> find(const std::string key);
+
+  /**
+   * @brief Store a computed field if it has any registered use.
+   *
+   * @param key Cache key.
+   * @param field Mesh field.
+   */
+  void store(const std::string key, std::shared_ptr<MeshField> field);
+
+  /**
+   * @brief Compute a (quadratic) spherical-harmonic-weighted field
+   *        (fluctuations) in configuration space, with the retained
+   *        random-source field if available.
+   *
+   * @param field Mesh field to compute.
+   * @param params Parameter set.
+   * @param particles_data (Data-source) particle catalogue.
+   * @param particles_rand (Random-source) particle catalogue.
+   * @param los_data (Data-source) particle line-of-sight policy.
+   * @param los_rand (Random-source) particle line-of-sight policy.
+   * @param alpha Alpha contrast.
+   * @param ell Degree of the spherical harmonic.
+   * @param m Order of the spherical harmonic.
+   * @param quad Whether the field is quadratic.
+   */
+  void compute_ylm_wgtd_field(
+    MeshField& field, trv::ParameterSet& params,
+    ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+    const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+    double alpha, int ell, int m, bool quad
+  );
+
+  /**
+   * @brief Return the on-disk cache key of a random-source field.
+   *
+   * @param key Cache key.
+   * @param params Parameter set.
+   * @param particles_rand (Random-source) particle catalogue.
+   * @param los_rand (Random-source) particle line-of-sight policy.
+   * @returns On-disk cache key.
+   */
+  std::string get_file_key(
+    const std::string key, trv::ParameterSet& params,
+    ParticleCatalogue& particles_rand, const LineOfSightPolicy& los_rand
+  );
+
+  /**
+   * @brief Evict the least recently used files from the on-disk cache
+   *        until it is within the size limit.
+   *
+   * @param filepath_kept File path never to be evicted.
+   */
+  void evict_cached_files(const std::string filepath_kept);
+
+  /**
+   * @brief Derive a configuration-space assignment-compensated field
+   *        from a Fourier-space field.
+   *
+   * @param params Parameter set.
+   * @param field_fourier Fourier-space field.
+   * @param name Field name.
+   * @returns Mesh field.
+   */
+  std::shared_ptr<MeshField> derive_compensated_field_in_config(
+    trv::ParameterSet& params, MeshField& field_fourier,
+    const std::string name
+  );
+};
+
+
 // ***********************************************************************
 // Field statistics
 // ***********************************************************************
@@ -533,16 +1157,28 @@ class MeshField {
  */
 class FieldStats {
  public:
-  std::vector<int> nmodes;  ///< number of wavevector modes in bins
-  std::vector<int> npairs;  ///< number of separation pairs in bins
-  std::vector<double> k;    ///< average wavenumber in bins
-  std::vector<double> r;    ///< average separation in bins
+  std::vector<long long> nmodes;  ///< number of wavevector modes in bins
+  std::vector<long long> npairs;  ///< number of separation pairs in bins
+  std::vector<double> k;          ///< average wavenumber in bins
+  std::vector<double> r;          ///< average separation in bins
   /// shot-noise power in bins
   std::vector< std::complex<double> > sn;
   /// pseudo power spectrum in bins
   std::vector< std::complex<double> > pk;
   /// pseudo two-point correlation function in bins
   std::vector< std::complex<double> > xi;
+  /// Legendre-weighted pseudo power spectrum in bins (flattened by degree)
+  std::vector< std::complex<double> > pk_poles;
+  /// Legendre-weighted shot-noise power in bins (flattened by degree)
+  std::vector< std::complex<double> > sn_poles;
+  /// number of wavevector modes in (k, μ) bins (flattened by wedge)
+  std::vector<long long> nmodes_wedges;
+  std::vector<double> k_wedges;   ///< average wavenumber in (k, μ) bins
+  std::vector<double> mu_wedges;  ///< average |μ| in (k, μ) bins
+  /// pseudo power spectrum in (k, μ) bins
+  std::vector< std::complex<double> > pk_wedges;
+  /// shot-noise power in (k, μ) bins
+  std::vector< std::complex<double> > sn_wedges;
 
   // ---------------------------------------------------------------------
   // Life cycle
@@ -606,6 +1242,75 @@ class FieldStats {
     int ell, int m, trv::Binning& kbinning
   );
 
+  /**
+   * @brief Compute binned two-point statistics in (k, μ) bins in
+   *        Fourier space with the global line of sight.
+   *
+   * In a single sweep over the mesh grid, this accumulates the
+   * grid-corrected mode power (and shot noise) as in
+   * @ref trv::FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier,
+   * both weighted by the Legendre polynomials
+   * @f$ \mathcal{L}_\ell(\mu) @f$ for each degree in @p ells,
+   * which is equivalent to the reduced spherical harmonics
+   * @f$ y_{\ell 0} @f$ with the line of sight along the @f$ z @f$-axis,
+   * and unweighted in @p num_wedges equal-width bins in
+   * @f$ |\mu| \in [0, 1] @f$.  The multipoles and wedges are stored in
+   * @ref trv::FieldStats::pk_poles (and similarly for other members)
+   * and @ref trv::FieldStats::pk_wedges (and similarly for other
+   * members) with the wavenumber bin index running fastest, while
+   * @ref trv::FieldStats::nmodes and @ref trv::FieldStats::k are
+   * shared by all multipoles.
+   *
+   * @param field_a First field.
+   * @param field_b Second field.
+   * @param shotnoise_amp Shot-noise amplitude.
+   * @param ells Degrees of the Legendre polynomials.
+   * @param num_wedges Number of wedges in @f$ |\mu| @f$ (zero if none).
+   * @param kbinning Wavenumber binning.
+   * @throws trv::sys::InvalidDataError When @p field_a and @p field_b
+   *                                    have incompatible physical
+   *                                    properties.
+   *
+   * @note @p field_a and @p field_b are Fourier-space fields and their
+   *       entries are arranged in the FFTW convention (i.e. shifted).
+   */
+  void compute_kmu_2pt_stats_in_fourier(
+    MeshField& field_a, MeshField& field_b, std::complex<double> shotnoise_amp,
+    const std::vector<int>& ells, int num_wedges, trv::Binning& kbinning
+  );
+
+  /**
+   * @brief Compute binned two-point statistics in Fourier space with
+   *        the shot noise weighted by Cartesian moments.
+   *
+   * This is as in
+   * @ref trv::FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier with
+   * unit weighting of the mode power, where @p field_a has already been
+   * weighted in Fourier space (see
+   * @ref trv::MeshField::add_unpacked_los_moment_wgtd_fields()), and
+   * the shot noise amplitude
+   * @f$ \sum_b P_{\mathrm{shot},b} w_b(\hat{\vec{k}}) @f$ for the
+   * wavevector weights @f$ w_b @f$ of the Cartesian moments.
+   *
+   * @param field_a First field.
+   * @param field_b Second field.
+   * @param shotnoise_amps Shot-noise amplitudes of the Cartesian moments.
+   * @param moment_calc Cartesian moment calculator.
+   * @param kbinning Wavenumber binning.
+   * @throws trv::sys::InvalidDataError When @p field_a and @p field_b
+   *                                    have incompatible physical
+   *                                    properties.
+   *
+   * @note @p field_a and @p field_b are Fourier-space fields and their
+   *       entries are arranged in the FFTW convention (i.e. shifted).
+   */
+  void compute_los_moment_wgtd_2pt_stats_in_fourier(
+    MeshField& field_a, MeshField& field_b,
+    const std::vector<double>& shotnoise_amps,
+    const trv::maths::CartesianMomentCalculator& moment_calc,
+    trv::Binning& kbinning
+  );
+
   /**
    * @brief Compute binned two-point statistics in configuration space.
    *
@@ -662,8 +1367,8 @@ class FieldStats {
    */
   void compute_uncoupled_shotnoise_for_3pcf(
     MeshField& field_a, MeshField& field_b,
-    std::vector< std::complex<double> >& ylm_a,
-    std::vector< std::complex<double> >& ylm_b,
+    trv::sys::TrackedVector< std::complex<double> >& ylm_a,
+    trv::sys::TrackedVector< std::complex<double> >& ylm_b,
     std::complex<double> shotnoise_amp,
     trv::Binning& rbinning
   );
@@ -707,8 +1412,8 @@ class FieldStats {
    */
   std::complex<double> compute_uncoupled_shotnoise_for_bispec_per_bin(
     MeshField& field_a, MeshField& field_b,
-    std::vector< std::complex<double> >& ylm_a,
-    std::vector< std::complex<double> >& ylm_b,
+    trv::sys::TrackedVector< std::complex<double> >& ylm_a,
+    trv::sys::TrackedVector< std::complex<double> >& ylm_b,
     trvm::SphericalBesselCalculator& sj_a,
     trvm::SphericalBesselCalculator& sj_b,
     std::complex<double> shotnoise_amp,
@@ -718,13 +1423,38 @@ class FieldStats {
   /**
    * @brief Record binned vectors given a binning scheme.
    *
+   * Vectors are counted per bin in a first pass and placed directly
+   * in bin order in a second pass, both parallelised over contiguous
+   * chunks of mesh grid cells, so that vectors within each bin are
+   * in mesh grid order.
+   *
    * @param binning Binning.
    * @param save_file Saved filename if non-empty.
+   * @param stream If `true` (default is `false`) and @p save_file is
+   *               non-empty, write binned vectors to the file in
+   *               blocks of bins without holding all of them in memory,
+   *               and return only the vector count and bin number.
    */
   trv::BinnedVectors record_binned_vectors(
-    trv::Binning& binning, const std::string& save_file
+    trv::Binning& binning, const std::string& save_file,
+    bool stream = false
   );
 
+  /**
+   * @brief Return the shot-noise aliasing scale-dependence function
+   *        @f$ C_1(\vec{k}) @f$ at each mesh grid, including only the
+   *        aliased images which survive interlacing.
+   *
+   * The interlacing order is @c trv::FieldStats.params.interlace_order,
+   * where order 1 (i.e. no interlacing) includes all aliased images.
+   *
+   * @returns Aliasing function.
+   *
+   * @see @ref trv::FieldStats::calc_shotnoise_aliasing_interlaced().
+   */
+  std::function<double(int, int, int)>
+  ret_calc_shotnoise_aliasing_interlaced();
+
  private:
   trv::ParameterSet params;  ///< parameter set
   double dr[3];              ///< grid size in each dimension
@@ -767,6 +1497,13 @@ class FieldStats {
    * @brief Return the shot-noise aliasing scale-dependence function
    *        @f$ C_1(\vec{k}) @f$ at each mesh grid.
    *
+   * For interlacing of order above 2 (i.e.
+   * @c trv::FieldStats.params.interlace_order > 2), only the aliased
+   * images which survive interlacing are included (see
+   * @ref trv::FieldStats::ret_calc_shotnoise_aliasing_interlaced());
+   * otherwise, including for interlacing of order 2, all aliased
+   * images are included.
+   *
    * @see Eqs. (45) and (46) in Sugiyama et al. (2019)
    *      [<a href="https://arxiv.org/abs/1803.02132">1803.02132</a>]
    *      and Jing (2004)
@@ -822,6 +1559,34 @@ class FieldStats {
    * @returns Function value.
    */
   double calc_shotnoise_aliasing_pcs(int i, int j, int k);
+
+  /**
+   * Calculate the shot-noise aliasing function for interlaced fields
+   * with any assignment scheme.
+   *
+   * For interlacing of order @f$ N @f$, the aliased images
+   * @f$ \vec{n} @f$ survive only if
+   * @f$ n_x + n_y + n_z \equiv 0 \pmod{N} @f$, so the sum over them is
+   * filtered with the roots of unity as
+   * @f[
+   *   C_1(\vec{k}) = \frac{1}{N} \sum_{j=0}^{N-1} \prod_{i=x,y,z}
+   *     \sum_{n_i} W^2(u_i + n_i) \mathrm{e}^{-2\pi\mathrm{i} n_i j/N} \,,
+   * @f]
+   * where @f$ u_i @f$ is the wavevector component in units of the
+   * sampling wavenumber and @f$ W @f$ is the assignment window.  By
+   * the Poisson summation formula, each inner sum is a finite sum over
+   * the centred B-spline of twice the assignment order.
+   *
+   * @param i, j, k Grid indices.
+   * @param bspline Centred B-spline values @f$ B(m + j/N) @f$
+   *                tabulated for each shift index @f$ j @f$ (outer)
+   *                and @f$ m = -p, \dots, p @f$ (inner), where
+   *                @f$ p @f$ is the assignment order.
+   * @returns Function value.
+   */
+  double calc_shotnoise_aliasing_interlaced(
+    int i, int j, int k, const std::vector<double>& bspline
+  );
 };
 
 }  // namespace trv
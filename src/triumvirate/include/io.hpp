@@ -30,6 +30,8 @@
 
 #include <sys/stat.h>
 #include <cerrno>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include "parameters.hpp"
@@ -63,6 +65,39 @@ void make_write_dir(std::string dirstr);
 }  // namespace trv::sys
 
 
+// ***********************************************************************
+// Checksums
+// ***********************************************************************
+
+namespace sys {
+
+/**
+ * @brief Update a 64-bit hash with a block of raw data.
+ *
+ * The hash is a fast non-cryptographic FNV-1a-type hash over 8-byte
+ * words, suitable only for identifying (not authenticating) data.
+ *
+ * @param data Data block.
+ * @param nbytes Size of the data block in bytes.
+ * @param hash Hash to update (default is the initial hash value).
+ * @returns Updated hash.
+ */
+std::uint64_t update_data_hash(
+  const void* data, std::size_t nbytes,
+  std::uint64_t hash = 14695981039346656037ULL
+);
+
+/**
+ * @brief Format a 64-bit hash as a hexadecimal string.
+ *
+ * @param hash Hash.
+ * @returns Hexadecimal string of 16 characters.
+ */
+std::string format_data_hash(std::uint64_t hash);
+
+}  // namespace trv::sys
+
+
 // ***********************************************************************
 // Files
 // ***********************************************************************
@@ -73,6 +108,28 @@ namespace io {
 const char comment_delimiter[] = "#";  ///< header comment delimiter
 /// @endcond
 
+/**
+ * @brief Signature at the start of binary measurement files.
+ *
+ * When the output type is "binary", measurement (and binned-vectors)
+ * files consist of this signature followed by a sequence of typed array
+ * records until the end of file.  Each record comprises
+ *
+ * - the record name as a string;
+ * - the NumPy type string (e.g. "<f8", "<c16", "|S12") as a string;
+ * - the number of dimensions as a 4-byte unsigned integer;
+ * - the length of each dimension as an 8-byte unsigned integer;
+ * - the array data in C order,
+ *
+ * where each string is prefixed by its length as a 4-byte unsigned
+ * integer and all record integers are little-endian.  The first record
+ * "header" holds the header text as printed to text files, followed
+ * for measurements by the stage profile records "profile/<field>" and
+ * then one record per data table column.  Records with the same name
+ * are to be concatenated (e.g. binned vectors streamed in blocks).
+ */
+const char binary_signature[] = "TRVBIN01";
+
 // -----------------------------------------------------------------------
 // Pre-measurement header
 // -----------------------------------------------------------------------
@@ -81,6 +138,9 @@ const char comment_delimiter[] = "#";  ///< header comment delimiter
  * @brief Print the pre-measurement header to a file including information
  *        about the catalogue(s) and mesh grid assignment.
  *
+ * If the output type is "binary", the binary file signature, the header
+ * text record and the stage profile records are written instead.
+ *
  * @param fileptr File to print to.
  * @param params Parameter set.
  * @param catalogue_data (Data-source) particle catalogue.
@@ -100,6 +160,9 @@ void print_measurement_header_to_file(
  * @brief Print the pre-measurement header to a file including information
  *        about the catalogue(s) and mesh grid assignment.
  *
+ * If the output type is "binary", the binary file signature, the header
+ * text record and the stage profile records are written instead.
+ *
  * @param fileptr File to print to.
  * @param params Parameter set.
  * @param catalogue Particle catalogue.
@@ -115,11 +178,53 @@ void print_measurement_header_to_file(
   double norm_factor_part, double norm_factor_mesh, double norm_factor_meshes
 );
 
+/**
+ * @brief Print the stage profile to a file as header lines.
+ *
+ * Stages are taken from @ref trv::sys::profiler as accumulated on
+ * the calling thread.
+ *
+ * @param fileptr File to print to.
+ */
+void print_stage_profile_to_file(std::FILE* fileptr);
+
 
 // -----------------------------------------------------------------------
 // Binning details
 // -----------------------------------------------------------------------
 
+/**
+ * @brief Print the header of binned vectors to a file.
+ *
+ * If the output type is "binary", the binary file signature and
+ * the header text record are written instead.
+ *
+ * @param fileptr File to print to.
+ * @param params Parameter set.
+ * @param binned_vectors Binned vectors (only the vector count and
+ *                       bin number are printed).
+ */
+void print_binned_vectors_header_to_file(
+  std::FILE* fileptr, trv::ParameterSet& params,
+  trv::BinnedVectors& binned_vectors
+);
+
+/**
+ * @brief Print the data table of binned vectors to a file.
+ *
+ * This can be called repeatedly on consecutive blocks of binned vectors
+ * after the header is printed.  If the output type is "binary", one
+ * record per column is written for each block.
+ *
+ * @param fileptr File to print to.
+ * @param params Parameter set.
+ * @param binned_vectors (Block of) binned vectors.
+ */
+void print_binned_vectors_datatab_to_file(
+  std::FILE* fileptr, trv::ParameterSet& params,
+  trv::BinnedVectors& binned_vectors
+);
+
 /**
  * @brief Print binned vectors to a file.
  *
@@ -140,6 +245,9 @@ void print_binned_vectors_to_file(
 /**
  * @brief Print measurements as a data table to a file.
  *
+ * If the output type is "binary", one record per column is written
+ * instead.
+ *
  * @param fileptr File to print to.
  * @param params Parameter set.
  * @param meas_powspec Power spectrum measurements.
@@ -26,6 +26,7 @@
  * Mathematical calculations provided include:
  * - spherical Bessel functions of the first kind with interpolation;
  * - (reduced) spherical harmonics include 3-d mesh grid storage;
+ * - Cartesian moment expansion of Legendre polynomials;
  * - Wigner 3-j symbols;
  * - the gamma function and related quantities with Lanzcos approximation.
  *
@@ -42,6 +43,7 @@
 #include <gsl/gsl_sf_result.h>
 #include <gsl/gsl_spline.h>
 
+#include <array>
 #include <cmath>
 #include <complex>
 #include <vector>
@@ -223,7 +225,7 @@ class SphericalHarmonicCalculator {
   static void store_reduced_spherical_harmonic_in_fourier_space(
     const int ell, const int m,
     const double boxsize[3], const int ngrid[3],
-    std::vector< std::complex<double> >& ylm_out
+    trv::sys::TrackedVector< std::complex<double> >& ylm_out
   );
 
   /**
@@ -241,11 +243,104 @@ class SphericalHarmonicCalculator {
   static void store_reduced_spherical_harmonic_in_config_space(
     const int ell, const int m,
     const double boxsize[3], const int ngrid[3],
-    std::vector< std::complex<double> >& ylm_out
+    trv::sys::TrackedVector< std::complex<double> >& ylm_out
   );
 };
 
 
+// ***********************************************************************
+// Cartesian moments
+// ***********************************************************************
+
+/**
+ * @brief Cartesian moment expansion of Legendre polynomials.
+ *
+ * For unit vectors @f$ \hat{\vec{k}} @f$ and @f$ \hat{\vec{x}} @f$,
+ * the Legendre polynomial @f$ \mathcal{L}_\ell @f$ is expanded as
+ * @f[
+ *   \mathcal{L}_\ell(\hat{\vec{k}} \cdot \hat{\vec{x}}) =
+ *     \sum_b w_b(\hat{\vec{k}}) c_b(\hat{\vec{x}})
+ * @f]
+ * over @f$ 2\ell + 1 @f$ moments, where @f$ c_b @f$ are the coefficients
+ * of the monomials @f$ \hat{k}_x^{\alpha_x} \hat{k}_y^{\alpha_y}
+ * \hat{k}_z^{\alpha_z} @f$ (with @f$ |\alpha| = \ell @f$ and
+ * @f$ \alpha_z \leqslant 1 @f$) in the harmonic polynomial
+ * @f$ |\vec{k}|^\ell \mathcal{L}_\ell(\hat{\vec{k}} \cdot
+ * \hat{\vec{x}}) @f$, and @f$ w_b @f$ collect the remaining monomials
+ * through tracelessness.  This is equivalent to the addition theorem
+ * for the reduced spherical harmonics but with real-valued moments.
+ *
+ * @see Bianchi et al. (2015)
+ *      [<a href="https://arxiv.org/abs/1505.05341">1505.05341</a>] and
+ *      Scoccimarro (2015)
+ *      [<a href="https://arxiv.org/abs/1506.02729">1506.02729</a>].
+ */
+class CartesianMomentCalculator {
+ public:
+  static constexpr int ell_max = 12;  ///< maximum degree supported
+
+  int ell;       ///< degree @f$ \ell @f$
+  int nmoments;  ///< number of moments @f$ 2\ell + 1 @f$
+
+  /**
+   * @brief Construct the Cartesian moment calculator.
+   *
+   * @param ell Degree @f$ \ell @f$.
+   * @throws trv::sys::InvalidParameterError When @p ell is negative or
+   *                                         exceeds @ref ell_max.
+   */
+  CartesianMomentCalculator(const int ell);
+
+  /**
+   * @brief Calculate the line-of-sight moments.
+   *
+   * @param[in] los Line-of-sight vector (normalised internally).
+   * @param[out] moments Values of @f$ c_b(\hat{\vec{x}}) @f$.
+   */
+  void calc_los_moments(const double los[3], double* moments) const;
+
+  /**
+   * @brief Calculate the wavevector weights of the moments.
+   *
+   * @param[in] kvec Wavevector (normalised internally).
+   * @param[out] weights Values of @f$ w_b(\hat{\vec{k}}) @f$.
+   *
+   * @note As for the reduced spherical harmonics, the weights vanish
+   *       for the zero wavevector unless @f$ \ell = 0 @f$.
+   */
+  void calc_wavevector_weights(const double kvec[3], double* weights) const;
+
+ private:
+  /// monomial exponents of the line-of-sight moment terms
+  std::vector<int> los_powers;
+  /// coefficients of the line-of-sight moment terms
+  std::vector<double> los_coeffs;
+  /// offsets of the line-of-sight moment terms for each moment
+  std::vector<int> los_offsets;
+  /// monomial exponents of the wavevector weight terms
+  std::vector<int> kvec_powers;
+  /// coefficients of the wavevector weight terms
+  std::vector<double> kvec_coeffs;
+  /// offsets of the wavevector weight terms for each moment
+  std::vector<int> kvec_offsets;
+
+  /**
+   * @brief Evaluate a sum of monomial terms of a normalised vector.
+   *
+   * @param vec Vector.
+   * @param powers Monomial exponents (three per term).
+   * @param coeffs Term coefficients.
+   * @param offsets Term offsets for each sum.
+   * @param[out] sums Values of the sums.
+   */
+  void eval_monomial_sums(
+    const double vec[3],
+    const std::vector<int>& powers, const std::vector<double>& coeffs,
+    const std::vector<int>& offsets, double* sums
+  ) const;
+};
+
+
 // ***********************************************************************
 // Spherical Bessel function
 // ***********************************************************************
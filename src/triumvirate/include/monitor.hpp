@@ -34,9 +34,15 @@
 
 #include <chrono>
 #include <cstdarg>
+#include <cstddef>
 #include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 /// @cond DOXYGEN_DOC_MACROS
 // Declares OMP macros.
@@ -65,11 +71,22 @@ namespace sys {
 // RFE: Implement MPI.
 extern int currTask;  ///< current task
 
-extern double gbytesMem;     ///< current memory usage in gibibytes
-extern double gbytesMaxMem;  ///< maximum memory usage in gibibytes
+// Resource trackers (and the default logger below) are thread-local so
+// that each calling thread carries its own measurement context, e.g.
+// when measurements run concurrently from Python threads.  Worker
+// threads of a measurement join the context of the calling thread
+// (see @ref trv::sys::ThreadContext).
+extern thread_local double gbytesMem;     ///< current memory usage (GiB)
+extern thread_local double gbytesMaxMem;  ///< maximum memory usage (GiB)
+/// estimated peak memory usage of the current measurement (GiB)
+extern thread_local double gbytesEstMem;
 
-extern int count_fft;   ///< number of FFTs
-extern int count_ifft;  ///< number of IFFTs
+extern thread_local int count_fft;   ///< number of FFTs
+extern thread_local int count_ifft;  ///< number of IFFTs
+
+/// Mutex guarding FFTW routines other than plan execution (e.g. plan
+/// creation and destruction), which are not thread-safe.
+extern std::mutex fftw_planner_mutex;
 
 /**
  * @brief Return size in gibibytes.
@@ -79,7 +96,7 @@ extern int count_ifft;  ///< number of IFFTs
  * @returns Size in gibibytes.
  */
 template <typename T>
-double size_in_gb(int num) {
+double size_in_gb(long long num) {
   const double BYTES_PER_GBYTES = 1073741824.;  // 1024³ bytes per gibibyte
   return double(num) * sizeof(T) / BYTES_PER_GBYTES;
 }
@@ -87,9 +104,120 @@ double size_in_gb(int num) {
 /**
  * @brief Update the maximum memory usage estimate.
  *
+ * The peak memory usage of the innermost active program stage
+ * (see @ref trv::sys::ScopedTimer) is also updated, and so is the
+ * memory usage reported by a worker thread to the calling thread
+ * (see @ref trv::sys::WorkerScope).
+ *
  */
 void update_maxmem();
 
+/**
+ * @brief Allocator recording its allocations in the memory usage
+ *        estimate.
+ *
+ * Allocations and deallocations are recorded to the memory usage
+ * trackers of the executing thread, so containers should be released
+ * by the same thread that has allocated them.
+ *
+ * @tparam T Element type.
+ */
+template <typename T>
+class TrackingAllocator {
+ public:
+  typedef T value_type;  ///< element type
+
+  /**
+   * @brief Construct a tracking allocator.
+   */
+  TrackingAllocator() noexcept {}
+
+  /**
+   * @brief Construct a tracking allocator from one of another
+   *        element type.
+   *
+   * @tparam U Element type of the other allocator.
+   */
+  template <typename U>
+  TrackingAllocator(const TrackingAllocator<U>&) noexcept {}
+
+  /**
+   * @brief Allocate storage and increase the memory usage estimate.
+   *
+   * @param num Number of elements.
+   * @returns Pointer to allocated storage.
+   */
+  T* allocate(std::size_t num) {
+    T* ptr = std::allocator<T>().allocate(num);
+    gbytesMem += size_in_gb<T>(num);
+    update_maxmem();
+    return ptr;
+  }
+
+  /**
+   * @brief Deallocate storage and decrease the memory usage estimate.
+   *
+   * @param ptr Pointer to allocated storage.
+   * @param num Number of elements.
+   */
+  void deallocate(T* ptr, std::size_t num) noexcept {
+    std::allocator<T>().deallocate(ptr, num);
+    gbytesMem -= size_in_gb<T>(num);
+  }
+};
+
+/// @cond DOXYGEN_DOC_MISC
+template <typename T, typename U>
+bool operator==(const TrackingAllocator<T>&, const TrackingAllocator<U>&) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const TrackingAllocator<T>&, const TrackingAllocator<U>&) {
+  return false;
+}
+/// @endcond
+
+/**
+ * @brief Vector whose storage is recorded in the memory usage estimate.
+ *
+ * @tparam T Element type.
+ */
+template <typename T>
+using TrackedVector = std::vector< T, TrackingAllocator<T> >;
+
+/**
+ * @brief Check the estimated peak memory usage of a task against
+ *        the memory budget.
+ *
+ * The estimate is recorded as @ref trv::sys::gbytesEstMem.
+ *
+ * @param gbytes_est Estimated peak memory usage (in gibibytes).
+ * @param gbytes_budget Memory budget (in gibibytes); non-positive
+ *                      for no budget.
+ * @param task Description of the task.
+ * @throws trv::sys::InsufficientMemoryError When @p gbytes_est
+ *                                           exceeds @p gbytes_budget.
+ */
+void check_mem_budget(
+  double gbytes_est, double gbytes_budget, const std::string& task
+);
+
+/**
+ * @brief Reserve optional memory usage within the memory budget.
+ *
+ * The reservation succeeds if the estimated peak memory usage
+ * (or the current usage if higher) including @p gbytes_extra is
+ * within @p gbytes_budget, in which case @ref trv::sys::gbytesEstMem
+ * is increased accordingly.
+ *
+ * @param gbytes_extra Additional memory usage (in gibibytes).
+ * @param gbytes_budget Memory budget (in gibibytes); non-positive
+ *                      for no budget.
+ * @returns { @c true , @c false }
+ */
+bool reserve_mem_budget(double gbytes_extra, double gbytes_budget);
+
 /**
  * @brief Return the current date-time string in
  *        'YYYY-MM-DD HH:MM:SS' format.
@@ -249,9 +377,265 @@ class Logger {
   void emit(std::string log_type, const char* fmt_string, std::va_list args);
 };
 
-extern Logger logger;  ///< default logger (at `NSET` logging level)
+/// Default logger (at `NSET` logging level).
+extern thread_local Logger logger;
 
 
+// ***********************************************************************
+// Program profiling
+// ***********************************************************************
+
+/**
+ * @brief Profile of a program stage accumulated over its calls.
+ *
+ */
+struct StageProfile {
+  long long ncalls = 0;    ///< number of calls
+  double time_total = 0.;  ///< wall time including nested stages (s)
+  double time_self = 0.;   ///< wall time excluding nested stages (s)
+  double gbytes = 0.;      ///< estimated data touched (GiB)
+  double gbytes_mem = 0.;  ///< peak memory usage (GiB)
+  int nthreads = 0;        ///< maximum number of threads used
+};
+
+/**
+ * @brief Timeline event of a program stage call.
+ *
+ */
+struct StageEvent {
+  std::string stage;     ///< stage name
+  double time_begin;     ///< starting time since program start (s)
+  double time_duration;  ///< wall time (s)
+  double gbytes;         ///< estimated data touched (GiB)
+  double gbytes_mem;     ///< peak memory usage (GiB)
+  int nthreads;          ///< number of threads used
+};
+
+/**
+ * @brief Registry of program stage profiles.
+ *
+ * Stages are timed with @ref trv::sys::ScopedTimer and recorded in
+ * the order of their first calls.  Timeline events are only kept when
+ * tracing is enabled.
+ *
+ */
+class Profiler {
+ public:
+  bool tracing = false;  ///< tracing flag
+  /// stage names in the order of first calls
+  std::vector<std::string> stages;
+  /// stage profiles
+  std::map<std::string, StageProfile> profiles;
+  /// stage call timeline events (if tracing)
+  std::vector<StageEvent> events;
+
+  /**
+   * @brief Reset stage profiles and timeline events.
+   */
+  void reset();
+
+  /**
+   * @brief Record stage calls.
+   *
+   * @param stage Stage name.
+   * @param time_total Wall time including nested stages (in seconds).
+   * @param time_self Wall time excluding nested stages (in seconds).
+   * @param gbytes Estimated data touched (in gibibytes).
+   * @param gbytes_mem Peak memory usage (in gibibytes).
+   * @param nthreads Number of threads used.
+   * @param ncalls Number of calls (default is 1).
+   */
+  void record(
+    const std::string& stage, double time_total, double time_self,
+    double gbytes, double gbytes_mem, int nthreads, long long ncalls = 1
+  );
+
+  /**
+   * @brief Merge stage profiles (but not timeline events) from
+   *        another registry.
+   *
+   * Peak memory usage is merged assuming that of the other registry
+   * is tracked in the same context (see
+   * @ref trv::sys::WorkerScope).
+   *
+   * @param other Other registry.
+   */
+  void merge(const Profiler& other);
+
+  /**
+   * @brief Write timeline events to a file in the Chrome trace
+   *        event format.
+   *
+   * @param filepath Output file path.
+   * @returns Exit status (0 on success).
+   */
+  int write_trace_to_file(const std::string& filepath);
+};
+
+/// Default stage profile registry.
+extern thread_local Profiler profiler;
+
+/**
+ * @brief Timer recording the enclosing scope as a program stage
+ *        in @ref trv::sys::profiler.
+ *
+ * Timers may be nested, in which case the self time of the enclosing
+ * stage excludes that of nested stages whereas its peak memory usage
+ * includes theirs.  Stages timed inside parallel regions are recorded
+ * to the profiler of the executing thread.
+ *
+ */
+class ScopedTimer {
+ public:
+  /**
+   * @brief Start timing a program stage.
+   *
+   * @param stage Stage name.
+   * @param gbytes Estimated data touched (in gibibytes) (default is 0).
+   */
+  ScopedTimer(const char* stage, double gbytes = 0.);
+
+  /**
+   * @brief Stop timing and record the program stage.
+   */
+  ~ScopedTimer();
+
+  /**
+   * @brief Add to the estimated data touched once known.
+   *
+   * @param gbytes Estimated data touched (in gibibytes).
+   */
+  void add_data(double gbytes);
+
+  /**
+   * @brief Update the peak memory usage of the innermost active timer
+   *        of the current thread.
+   */
+  static void update_mem_peak();
+
+  /**
+   * @brief Update the peak memory usage of the innermost active timer
+   *        of the current thread with a given memory usage.
+   *
+   * @param gbytes Memory usage (in gibibytes).
+   */
+  static void update_mem_peak(double gbytes);
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  const char* stage;        ///< stage name
+  double gbytes;            ///< estimated data touched (GiB)
+  double gbytes_mem;        ///< peak memory usage (GiB)
+  int nthreads;             ///< number of threads used
+  double time_nested = 0.;  ///< wall time of nested stages (s)
+  ScopedTimer* parent;      ///< enclosing timer
+  /// starting time
+  std::chrono::steady_clock::time_point time_begin;
+};
+
+
+
+// ***********************************************************************
+// Worker threads
+// ***********************************************************************
+
+/**
+ * @brief Tracking context of a calling thread shared with its worker
+ *        threads.
+ *
+ * As resource trackers, the default logger and the default profiler
+ * are thread-local, the context is captured on the calling thread
+ * before worker threads start (e.g. in a parallel region or pipeline),
+ * and each worker thread joins it with @ref trv::sys::WorkerScope.
+ * The memory usage, (I)FFT counts and stage profiles of worker threads
+ * are folded back into the calling thread when the context is
+ * destroyed, after all worker threads have left it.  Peak memory
+ * usage recorded in stage profiles of worker threads includes the
+ * memory usage of the calling thread when the context is captured
+ * and that of all worker threads.
+ *
+ */
+class ThreadContext {
+ public:
+  /**
+   * @brief Capture the tracking context of the calling thread.
+   */
+  ThreadContext();
+
+  /**
+   * @brief Fold worker-thread tracking into the calling thread.
+   *
+   * The peak memory usage is estimated as if the peak memory usage of
+   * the calling thread coincided with that of all worker threads.
+   */
+  ~ThreadContext();
+
+  ThreadContext(const ThreadContext&) = delete;
+  ThreadContext& operator=(const ThreadContext&) = delete;
+
+ private:
+  friend class WorkerScope;
+
+  std::mutex mutex;          ///< mutex guarding worker-thread tracking
+  const void* caller;        ///< calling-thread identifier
+  int log_level;             ///< logging level of the calling thread
+  double gbytes_caller;      ///< memory usage of the caller (GiB)
+  double gbytes_max_caller;  ///< maximum memory usage of the caller (GiB)
+  double gbytes_workers = 0.;      ///< worker-thread memory usage (GiB)
+  double gbytes_workers_max = 0.;  ///< worker-thread peak usage (GiB)
+  int count_fft_workers = 0;       ///< number of worker-thread FFTs
+  int count_ifft_workers = 0;      ///< number of worker-thread IFFTs
+  Profiler profiler_workers;       ///< worker-thread stage profiles
+};
+
+/**
+ * @brief Scope of a worker thread in the tracking context of
+ *        a calling thread.
+ *
+ * On a worker thread, the logging level of the calling thread is
+ * inherited and the stage profiles are reset; the memory usage of
+ * the worker thread is reported to the context whenever the memory
+ * usage estimate is updated (see @ref trv::sys::update_maxmem()), and
+ * its (I)FFT counts and stage profiles are added to the context when
+ * the scope ends.  On the calling thread itself, the scope has no
+ * effect.
+ *
+ */
+class WorkerScope {
+ public:
+  /**
+   * @brief Join the tracking context of a calling thread.
+   *
+   * @param context Tracking context of the calling thread.
+   */
+  explicit WorkerScope(ThreadContext& context);
+
+  /**
+   * @brief Leave the tracking context of the calling thread.
+   */
+  ~WorkerScope();
+
+  /**
+   * @brief Report the current memory usage of the worker thread
+   *        to the context.
+   */
+  void sync_mem();
+
+  WorkerScope(const WorkerScope&) = delete;
+  WorkerScope& operator=(const WorkerScope&) = delete;
+
+ private:
+  ThreadContext& context;      ///< tracking context of the caller
+  bool is_worker = false;      ///< worker-thread flag
+  WorkerScope* parent = nullptr;  ///< enclosing worker scope
+  double gbytes_ini = 0.;      ///< initial memory usage (GiB)
+  double gbytes_synced = 0.;   ///< reported memory usage (GiB)
+  int count_fft_ini = 0;       ///< initial number of FFTs
+  int count_ifft_ini = 0;      ///< initial number of IFFTs
+};
+
 // ***********************************************************************
 // Program exceptions
 // ***********************************************************************
@@ -352,6 +736,32 @@ class InvalidDataError: public std::runtime_error {
   virtual const char* what() const noexcept;
 };
 
+/**
+ * @brief Exception raised when the estimated memory usage exceeds
+ *        the memory budget.
+ *
+ */
+class InsufficientMemoryError: public std::bad_alloc {
+ public:
+  std::string err_mesg;  ///< error message
+
+  /**
+   * @brief Construct an @ref trv::sys::InsufficientMemoryError
+   *        exception.
+   *
+   * @param fmt_string Error message format string.
+   * @param ... An arbitrary number of substitution arguments.
+   */
+  InsufficientMemoryError(const char* fmt_string, ...);
+
+  /**
+   * @brief Exception string representation.
+   *
+   * @returns String representation of the exception.
+   */
+  virtual const char* what() const noexcept;
+};
+
 
 // ***********************************************************************
 // Program notices
@@ -62,12 +62,27 @@ class ParameterSet {
   std::string measurement_dir;
   /// data catalogue file
   std::string data_catalogue_file;
+  /// data catalogue list file (of data catalogue files, one per line)
+  /// for batch measurements paired with the same random catalogue
+  std::string data_catalogue_list;
   /// random catalogue file
   std::string rand_catalogue_file;
   /// catalogue data columns (comma-separated without space)
   std::string catalogue_columns;
   /// output tag
   std::string output_tag;
+  /// measurement output file type: {"text" (default), "binary"}
+  std::string output_type = "text";
+  /// mesh field cache directory (for random-source fields persisted
+  /// across runs; unset for no on-disk cache)
+  std::string mesh_cache_dir;
+  /// mesh field cache size limit (in GB; non-positive for no limit)
+  double mesh_cache_size = 0.;
+  /// checkpoint directory (for resuming three-point statistic term loops;
+  /// unset for no checkpointing)
+  std::string checkpoint_dir;
+  /// field checkpointing switch: {"true"/"on", "false"/"off" (default)}
+  std::string checkpoint_fields = "false";
 
   // ---------------------------------------------------------------------
   // Mesh sampling
@@ -90,15 +105,17 @@ class ParameterSet {
   // Mesh assignment.
   /// mesh assignment scheme: {"ngp", "cic", "tsc" (default), "pcs"}
   std::string assignment = "tsc";
-  /// interlacing switch: {"true"/"on", "false"/"off" (default)}
+  /// interlacing switch: {"true"/"on", "false"/"off" (default)},
+  /// or the interlacing order (as an integer string)
   std::string interlace = "false";
 
   // Derived mesh quantities.
   double volume;         ///< box volume (in Mpc^3/h^3)
-  int nmesh;             ///< number of mesh grid cells
-                         // RFE: change to @c long long and take care of int()
+  long long nmesh;       ///< number of mesh grid cells
 
   int assignment_order = 0;  ///< order of the assignment scheme
+  /// order of interlacing, i.e. number of interlaced mesh grids
+  int interlace_order = 0;
 
   // ---------------------------------------------------------------------
   // Measurement
@@ -108,8 +125,13 @@ class ParameterSet {
   /// catalogue type: {"survey", "random", "sim", "none"}
   std::string catalogue_type;
   /// statistic type: {"powspec", "2pcf", "2pcf-win", "bispec", "3pcf",
-  ///                  "3pcf-win", "3pcf-win-wa", "modes", "pairs"}
+  ///                  "3pcf-win", "3pcf-win-wa", "modes", "pairs",
+  ///                  "plan"}
   std::string statistic_type;
+  /// measurement plan as comma-separated items
+  /// <tt><statistic_type>:<degrees>[:<bin_min>:<bin_max>:<num_bins>]</tt>
+  /// (only used if @c statistic_type is "plan")
+  std::string measurement_plan;
 
   // Derived measurement type.
   std::string npoint;  ///< <i>N</i>-point case: {"2pt", "3pt", "none"}
@@ -136,6 +158,13 @@ class ParameterSet {
   ///                            "mesh-mixed"}
   std::string norm_convention = "particle";
 
+  /// power spectrum multipole estimator: {"ylm" (default), "cartesian"}
+  std::string powspec_estimator = "ylm";
+
+  /// Fourier-space cropping of the mesh for bispectrum measurements:
+  /// {"true"/"on", "false"/"off" (default)}
+  std::string crop_fourier = "false";
+
   // Measurement parameters.
   /// binning scheme: {"lin" (default), "log",
   ///                  "linpad", "logpad", "custom"}
@@ -158,6 +187,23 @@ class ParameterSet {
   ///                                                  <relpath-to-file>}
   std::string save_binned_vectors = "false";
 
+  /// task-parallel scheduling of three-point statistic bin pairs:
+  /// {"auto" (default), "true"/"on", "false"/"off"}
+  std::string task_parallel = "auto";
+
+  /// pipelining of three-point statistic bin pairs with double-buffered
+  /// fields: {"auto" (default), "true"/"on", "false"/"off"}
+  std::string pipeline = "auto";
+
+  /// memory budget (in GB; non-positive for no budget) checked against
+  /// pre-flight memory usage estimates and consulted by engines trading
+  /// memory for recomputation
+  double memory_budget = 0.;
+
+  /// Chrome trace file of program stages:
+  /// {"false"/"" (default), "true" (default path), <path-to-file>}
+  std::string profile_trace = "";
+
   /// logging verbosity level: {0  (NSET), 10 (DBUG), 20 (STAT) (default),
   ///                           30 (INFO), 40 (WARN), 50 (ERRO)}
   int verbose = 20;
@@ -25,7 +25,8 @@
  *
  * This module defines a particle catalogue object with I/O methods,
  * summary information and its computations, and methods to offset
- * particle coordinates (in particular in a mesh grid box).
+ * particle coordinates (in particular in a mesh grid box), as well as
+ * line-of-sight policies evaluated per particle.
  *
  */
 
@@ -42,10 +43,19 @@
 #include <string>
 #include <vector>
 
+#include <fftw3.h>
+
 #include "monitor.hpp"
+#include "dataobjs.hpp"
 
 namespace trv {
 
+#ifdef TRV_USE_FLOAT_POS
+typedef float pos_type;   ///< particle coordinate storage type
+#else  // !TRV_USE_FLOAT_POS
+typedef double pos_type;  ///< particle coordinate storage type
+#endif  // TRV_USE_FLOAT_POS
+
 /**
  * @brief Particle catalogue.
  *
@@ -58,7 +68,10 @@ class ParticleCatalogue {
   std::string source;  ///< catalogue source
 
   /**
-   * @brief Particle data container.
+   * @brief Individual particle data.
+   *
+   * @note Particle data are stored by column (see below); this
+   *       container is only a by-value view of a single particle.
    */
   struct ParticleData {
     double pos[3];  ///< particle position vector
@@ -66,16 +79,27 @@ class ParticleCatalogue {
     double ws;      ///< particle sample weight
     double wc;      ///< particle clustering weight
     double w;       ///< particle overall weight
-  }* pdata;         ///< particle data
+  };
+
+  // Particle data by column (SIMD-aligned if owned).
+  pos_type* pos[3];  ///< particle coordinates by axis
+  double* nz;        ///< redshift-dependent expected number density
+  double* ws;        ///< particle sample weight
+  double* wc;        ///< particle clustering weight
+  double* w;         ///< particle overall weight
 
-  int ntotal;      ///< total number of particles
-  double wtotal;   ///< total overall weight of particles
-  double wstotal;  ///< total sample weight of particles
+  long long ntotal;  ///< total number of particles
+  double wtotal;     ///< total overall weight of particles
+  double wstotal;    ///< total sample weight of particles
 
   double pos_min[3];   ///< minimum values of particle coordinates
   double pos_max[3];   ///< maximum values of particle coordinates
   double pos_span[3];  ///< span of particle coordinates
 
+  /// observer (i.e. origin of particle coordinates before any offset)
+  /// position in the current coordinates
+  double observer[3];
+
   // ---------------------------------------------------------------------
   // Life cycle
   // ---------------------------------------------------------------------
@@ -97,10 +121,9 @@ class ParticleCatalogue {
   ~ParticleCatalogue();
 
   /**
-   * @brief Initialise particle data container.
+   * @brief Initialise particle data columns.
    *
-   * @attention This method does not set the values of
-   *            @ref trv::ParticleCatalogue.ParticleData,
+   * @attention This method does not set the values of particle data,
    *            @ref trv::ParticleCatalogue.wtotal,
    *            @ref trv::ParticleCatalogue.wstotal,
    *            @ref trv::ParticleCatalogue.pos_min or
@@ -109,17 +132,26 @@ class ParticleCatalogue {
    *
    * @param num Number of data units (i.e. particles).
    */
-  void initialise_particles(const int num);
+  void initialise_particles(const long long num);
 
   /**
-   * @brief Finalise particle data container.
+   * @brief Finalise particle data columns.
    *
    * This is an explicit method to free the resources occupied by
-   * @ref trv::ParticleCatalogue.pdata and may be called outside the
-   * class destructor.
+   * particle data columns and may be called outside the class
+   * destructor.
    */
   void finalise_particles();
 
+  /**
+   * @brief Reset the catalogue to its initial state.
+   *
+   * Particle data are finalised and the catalogue source, summary
+   * information and observer position are cleared, so that the
+   * catalogue can be reloaded from another source.
+   */
+  void reset_catalogue();
+
   // ---------------------------------------------------------------------
   // Operators & reserved methods
   // ---------------------------------------------------------------------
@@ -128,9 +160,12 @@ class ParticleCatalogue {
    * @brief Return individual particle information.
    *
    * @param pid Particle index.
-   * @returns Individual particle data.
+   * @returns Individual particle data (copy).
+   *
+   * @note This is provided for compatibility; performance-critical
+   *       loops should access the data columns directly.
    */
-  ParticleData& operator[](const int pid);
+  ParticleData operator[](const long long pid) const;
 
   // ---------------------------------------------------------------------
   // Data I/O
@@ -139,6 +174,10 @@ class ParticleCatalogue {
   /**
    * @brief Read in a catalogue file.
    *
+   * If @p catalogue_filepath is a synthetic catalogue specification
+   * (see @ref trv::SyntheticCatalogueGenerator::parse_spec), the
+   * catalogue is generated instead without file I/O.
+   *
    * @param catalogue_filepath Catalogue file path.
    * @param catalogue_columns Catalogue data column names
    *                          (comma-separated without space).
@@ -159,8 +198,30 @@ class ParticleCatalogue {
    * @returns Exit status.
    */
   int load_particle_data(
-    std::vector<double> x, std::vector<double> y, std::vector<double> z,
-    std::vector<double> nz, std::vector<double> ws, std::vector<double> wc
+    const std::vector<double>& x,
+    const std::vector<double>& y,
+    const std::vector<double>& z,
+    const std::vector<double>& nz,
+    const std::vector<double>& ws,
+    const std::vector<double>& wc
+  );
+
+  /**
+   * @brief Wrap external particle data without copying.
+   *
+   * The catalogue does not own the wrapped data, which must outlive
+   * the catalogue.  Only the overall weight column (and the particle
+   * coordinates if stored in single precision) are allocated.
+   *
+   * @param num Number of particles.
+   * @param x, y, z, nz, ws, wc Contiguous particle data by column.
+   * @returns Exit status.
+   *
+   * @attention Coordinate offsets modify the wrapped data in place.
+   */
+  int wrap_particle_data(
+    const long long num,
+    double* x, double* y, double* z, double* nz, double* ws, double* wc
   );
 
   // ---------------------------------------------------------------------
@@ -184,6 +245,20 @@ class ParticleCatalogue {
    */
   void calc_pos_extents();
 
+  /**
+   * @brief Calculate the content hash of the catalogue.
+   *
+   * The hash covers the particle number, coordinates, overall weights
+   * and the observer position, which determine the mesh fields
+   * assigned from the catalogue.
+   *
+   * @returns Hexadecimal hash string.
+   *
+   * @note The hash is computed in the current coordinates, so the
+   *       same catalogue aligned differently hashes differently.
+   */
+  std::string calc_content_hash();
+
   // ---------------------------------------------------------------------
   // Catalogue operations
   // ---------------------------------------------------------------------
@@ -192,6 +267,7 @@ class ParticleCatalogue {
    * @brief Offset particle positions by a given vector.
    *
    * The position specified by the input vector is the new origin.
+   * @ref trv::ParticleCatalogue::observer is offset accordingly.
    *
    * @param dpos (Subtractive) offset position vector.
    */
@@ -201,6 +277,9 @@ class ParticleCatalogue {
    * @brief Offset particle positions for periodic boundary conditions.
    *
    * @param boxsize Periodic box size in each dimension.
+   *
+   * @note @ref trv::ParticleCatalogue::observer is unchanged, and
+   *       the local line of sight is no longer meaningful.
    */
   void offset_coords_for_periodicity(const double boxsize[3]);
 
@@ -301,6 +380,107 @@ class ParticleCatalogue {
     ParticleCatalogue& catalogue, ParticleCatalogue& catalogue_ref,
     const double boxsize[3], const int ngrid[3], const double ngrid_pad[3]
   );
+
+ private:
+  bool wrapped;  ///< whether particle data are wrapped (not owned)
+
+  /**
+   * @brief Return the size of owned particle data.
+   *
+   * @returns Size in gigabytes.
+   */
+  double get_owned_data_size_in_gb();
+
+  /**
+   * @brief Allocate a data column.
+   *
+   * @tparam T Data type.
+   * @param num Number of elements.
+   * @returns Pointer to the column.
+   */
+  template<typename T>
+  static T* alloc_column(const long long num);
+
+  /**
+   * @brief Free a data column.
+   *
+   * @tparam T Data type.
+   * @param column Pointer to the column (reset to @c nullptr ).
+   */
+  template<typename T>
+  static void free_column(T*& column);
+};
+
+/**
+ * @brief Line-of-sight policy.
+ *
+ * Lines of sight are evaluated per particle when needed (rather than
+ * stored), either from the particle position relative to the catalogue
+ * observer (local plane-parallel), or along a global axis; otherwise
+ * they are taken from a user-supplied array.
+ *
+ * @note Lines of sight evaluated here are not necessarily normalised
+ *       as only their directions are used.  A pair-wise line of sight
+ *       (e.g. the mid-point one) does not factorise into per-particle
+ *       weights and is thus not supported.
+ */
+class LineOfSightPolicy {
+ public:
+  /// line-of-sight type
+  enum class Type {local, global, user};
+
+  Type type;         ///< line-of-sight type
+  double axis[3];    ///< global line-of-sight axis
+  LineOfSight* los;  ///< user-supplied lines of sight
+
+  /**
+   * @brief Construct the local or user-supplied line-of-sight policy.
+   *
+   * @param los User-supplied lines of sight (default is @c nullptr,
+   *            in which case the local line of sight is used).
+   *
+   * @note This constructor is deliberately non-explicit so that
+   *       user-supplied line-of-sight arrays can be passed in place of
+   *       the policy.
+   */
+  LineOfSightPolicy(LineOfSight* los = nullptr);
+
+  /**
+   * @brief Construct the global line-of-sight policy.
+   *
+   * @param axis Global line-of-sight axis.
+   * @returns Line-of-sight policy.
+   */
+  static LineOfSightPolicy global_axis(const double axis[3]);
+
+  /**
+   * @brief Evaluate the line of sight to a particle.
+   *
+   * @param[in] particles Particle catalogue.
+   * @param[in] pid Particle index.
+   * @param[out] los_ Line-of-sight vector.
+   */
+  void eval(
+    const ParticleCatalogue& particles, const long long pid, double los_[3]
+  ) const {
+    switch (this->type) {
+      case Type::local:
+        for (int iaxis = 0; iaxis < 3; iaxis++) {
+          los_[iaxis] = particles.pos[iaxis][pid] - particles.observer[iaxis];
+        }
+        break;
+      case Type::global:
+        for (int iaxis = 0; iaxis < 3; iaxis++) {
+          los_[iaxis] = this->axis[iaxis];
+        }
+        break;
+      case Type::user:
+        for (int iaxis = 0; iaxis < 3; iaxis++) {
+          los_[iaxis] = this->los[pid].pos[iaxis];
+        }
+        break;
+    }
+  }
 };
 
 }  // namespace trv
@@ -0,0 +1,111 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file plan.hpp
+ * @authors Mike S Wang (https://github.com/MikeSWang)
+ * @brief Measurement plan of multiple clustering statistics.
+ *
+ * This module compiles a list of clustering statistic measurements
+ * into individual parameter sets and the mesh fields each of them
+ * requires, so that fields common to several measurements are
+ * computed once and retained only while they are still needed.
+ *
+ */
+
+#ifndef TRIUMVIRATE_INCLUDE_PLAN_HPP_INCLUDED_
+#define TRIUMVIRATE_INCLUDE_PLAN_HPP_INCLUDED_
+
+#include <string>
+#include <vector>
+
+#include "monitor.hpp"
+#include "parameters.hpp"
+#include "field.hpp"
+
+namespace trv {
+
+/**
+ * @brief Measurement plan.
+ *
+ * A plan is specified by @ref trv::ParameterSet::measurement_plan as
+ * comma-separated items of the form
+ * <tt><statistic_type>:<degrees>[:<bin_min>:<bin_max>:<num_bins>]</tt>,
+ * where the degrees are @c ELL for two-point statistics or the
+ * concatenated single digits of @c ell1, @c ell2 and @c ELL for
+ * three-point statistics (e.g. "powspec:2" or "bispec:202"); all other
+ * parameters are inherited from the parent parameter set.
+ *
+ */
+class MeasurementPlan {
+ public:
+  /// parameter sets of planned measurements in order of execution
+  std::vector<trv::ParameterSet> items;
+
+  /**
+   * @brief Construct a measurement plan from a parameter set.
+   *
+   * @param params Parameter set.
+   * @throws trv::sys::InvalidParameterError When a plan item cannot
+   *                                         be parsed or its statistic
+   *                                         type is unsupported.
+   *
+   * @note If @c params.statistic_type is not "plan", the plan consists
+   *       of a single measurement with @p params.  Otherwise planned
+   *       measurements are ordered by the line-of-sight degree @c ELL
+   *       so that fewer fields are retained at any one time.
+   */
+  MeasurementPlan(trv::ParameterSet& params);
+
+  /**
+   * @brief List the keys of shareable mesh fields used by
+   *        a measurement.
+   *
+   * @param params Parameter set of the measurement.
+   * @returns Mesh field cache keys.
+   *
+   * @note Window-function measurements do not share fields and have
+   *       no keys listed.
+   */
+  static std::vector<std::string> list_field_keys(
+    trv::ParameterSet& params
+  );
+
+  /**
+   * @brief Register the uses of mesh fields by all planned
+   *        measurements.
+   *
+   * @param field_cache Mesh field cache.
+   */
+  void register_field_uses(trv::MeshFieldCache& field_cache);
+
+  /**
+   * @brief Release the uses of mesh fields by a planned measurement.
+   *
+   * @param params Parameter set of the measurement.
+   * @param field_cache Mesh field cache.
+   */
+  static void release_field_uses(
+    trv::ParameterSet& params, trv::MeshFieldCache& field_cache
+  );
+};
+
+}  // namespace trv
+
+#endif  // !TRIUMVIRATE_INCLUDE_PLAN_HPP_INCLUDED_
@@ -0,0 +1,215 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file synthetic.hpp
+ * @authors Mike S Wang (https://github.com/MikeSWang)
+ * @brief Synthetic catalogue generation.
+ *
+ * This module generates uniform, Poisson and lognormal-clustered
+ * particle catalogues in a box, optionally with a spherical-shell
+ * survey mask and a radial selection function, directly into particle
+ * data columns without file I/O.
+ *
+ */
+
+#ifndef TRIUMVIRATE_INCLUDE_SYNTHETIC_HPP_INCLUDED_
+#define TRIUMVIRATE_INCLUDE_SYNTHETIC_HPP_INCLUDED_
+
+#ifdef TRV_USE_OMP
+#include <omp.h>
+#endif  // TRV_USE_OMP
+
+#include <fftw3.h>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "monitor.hpp"
+#include "particles.hpp"
+
+namespace trv {
+
+/**
+ * @brief Specification of a synthetic catalogue.
+ *
+ * Positions are generated in the box [0, L) in each dimension.  The
+ * survey mask and radial selection are centred at the box centre,
+ * where the observer is placed.
+ *
+ */
+struct SyntheticCatalogueSpec {
+  /// catalogue type: {"uniform", "poisson", "lognormal"}
+  std::string type = "uniform";
+  /// (mean) number of particles in the box before selection
+  long long num = 0;
+  /// random seed
+  unsigned long long seed = 42;
+  /// box size in each dimension
+  double boxsize[3] = {0., 0., 0.};
+  /// mesh grid number per dimension of the lognormal field
+  int ngrid = 64;
+  /// standard deviation of the Gaussian field (lognormal only)
+  double sigma = 1.;
+  /// spectral index of the Gaussian field power spectrum (lognormal only)
+  double index = -2.;
+  /// Gaussian smoothing length of the Gaussian field (lognormal only;
+  /// mesh cell size if non-positive)
+  double smoothing = 0.;
+  /// inner radius of the spherical-shell mask
+  double radius_min = 0.;
+  /// outer radius of the spherical-shell mask (no mask if non-positive)
+  double radius_max = 0.;
+  /// scale of the Gaussian radial selection function
+  /// (no selection if non-positive)
+  double radial_scale = 0.;
+};
+
+/**
+ * @brief Synthetic catalogue generator.
+ *
+ * Particles are drawn in independent streams (chunks of particles,
+ * blocks of the box or rows of mesh cells), each with its own random
+ * engine seeded by the catalogue seed and the stream index, so that
+ * the catalogue is reproducible irrespective of the number of threads.
+ * Particles are first counted per stream and then drawn again into
+ * their offsets, so no intermediate storage is needed.
+ *
+ * - "uniform": exactly @f$ N @f$ particles uniformly distributed
+ *   before selection;
+ * - "poisson": a Poisson point process with mean number @f$ N @f$;
+ * - "lognormal": a Poisson sampling of the lognormal density
+ *   @f$ 1 + \delta = \exp(g - \sigma_g^2/2) @f$ of a Gaussian field
+ *   @f$ g @f$ with power spectrum
+ *   @f$ P(k) \propto k^n \exp(-k^2 R^2) @f$ on a mesh.
+ *
+ * The 'nz' column is the expected number density including the
+ * selection function, and sample and clustering weights are unity.
+ *
+ */
+class SyntheticCatalogueGenerator {
+ public:
+  /**
+   * @brief Construct the synthetic catalogue generator.
+   *
+   * @param spec Synthetic catalogue specification.
+   * @throws trv::sys::InvalidParameterError When @p spec is invalid.
+   */
+  SyntheticCatalogueGenerator(const SyntheticCatalogueSpec& spec);
+
+  /**
+   * @brief Check if a catalogue source is a synthetic catalogue
+   *        specification, i.e. prefixed by "synthetic:".
+   *
+   * @param source Catalogue source.
+   * @returns { @c true , @c false }
+   */
+  static bool is_synthetic_source(const std::string& source);
+
+  /**
+   * @brief Parse a synthetic catalogue specification.
+   *
+   * The specification is a comma-separated list of `<key>=<value>`
+   * pairs, where keys are the fields of
+   * @ref trv::SyntheticCatalogueSpec, optionally prefixed by
+   * "synthetic:", e.g.
+   * "synthetic:type=lognormal,num=1e8,seed=7,boxsize=1000".
+   * The box size is either a single value or three values separated
+   * by ':'; if unspecified, it is the side length of a cube with
+   * volume @p volume.
+   *
+   * @param source Synthetic catalogue specification.
+   * @param volume Default box volume (default is 0.).
+   * @returns Synthetic catalogue specification.
+   * @throws trv::sys::InvalidParameterError When @p source cannot be
+   *                                         parsed.
+   */
+  static SyntheticCatalogueSpec parse_spec(
+    const std::string& source, double volume = 0.
+  );
+
+  /**
+   * @brief Count the number of generated particles.
+   *
+   * @returns Number of particles.
+   */
+  long long count_particles();
+
+  /**
+   * @brief Generate particle data into columns.
+   *
+   * @param[out] x, y, z Particle coordinates.
+   * @param[out] nz Expected number density at particle positions.
+   *
+   * @attention Columns must hold at least the number of particles
+   *            returned by
+   *            @ref trv::SyntheticCatalogueGenerator::count_particles.
+   */
+  void generate_particles(double* x, double* y, double* z, double* nz);
+
+  /**
+   * @brief Generate particle data into a particle catalogue.
+   *
+   * @param catalogue Particle catalogue.
+   */
+  void generate_particles(ParticleCatalogue& catalogue);
+
+ private:
+  SyntheticCatalogueSpec spec;  ///< synthetic catalogue specification
+  double nbar;                  ///< mean number density before selection
+  long long nstreams;           ///< number of random streams
+  int nblocks[3];               ///< number of stream blocks per dimension
+  /// particle counts by stream (once counted)
+  std::vector<long long> counts;
+  /// Poisson means by mesh cell (lognormal only)
+  trv::sys::TrackedVector<double> means;
+
+  /**
+   * @brief Compute Poisson means by mesh cell from a lognormal field.
+   */
+  void compute_lognormal_means();
+
+  /**
+   * @brief Draw the particles of a random stream.
+   *
+   * @tparam T Particle coordinate type.
+   * @param stream Stream index.
+   * @param[out] x, y, z Particle coordinates (counted only if null).
+   * @param[out] nz Expected number density at particle positions.
+   * @returns Number of particles drawn.
+   */
+  template <typename T>
+  long long draw_stream(long long stream, T* x, T* y, T* z, double* nz);
+
+  /**
+   * @brief Generate particle data into columns by stream.
+   *
+   * @tparam T Particle coordinate type.
+   * @param[out] x, y, z Particle coordinates.
+   * @param[out] nz Expected number density at particle positions.
+   */
+  template <typename T>
+  void generate_columns(T* x, T* y, T* z, double* nz);
+};
+
+}  // namespace trv
+
+#endif  // !TRIUMVIRATE_INCLUDE_SYNTHETIC_HPP_INCLUDED_
@@ -50,6 +50,7 @@
 #include "dataobjs.hpp"
 #include "field.hpp"
 #include "twopt.hpp"
+#include "checkpoint.hpp"
 
 namespace trv {
 
@@ -140,8 +141,8 @@ double calc_bispec_normalisation_from_mesh(
  *
  * @param particles_data (Data-source) particle catalogue.
  * @param particles_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) particle line-of-sight policy.
+ * @param los_rand (Random-source) particle line-of-sight policy.
  * @param alpha Alpha contrast.
  * @param ell Degree of the spherical harmonic.
  * @param m Order of the spherical harmonic.
@@ -149,7 +150,7 @@ double calc_bispec_normalisation_from_mesh(
  */
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   double alpha, int ell, int m
 );
 
@@ -158,7 +159,7 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
  *        reduced spherical harmonics.
  *
  * @param particles Particle catalogue.
- * @param los Particle lines of sight.
+ * @param los Particle line-of-sight policy.
  * @param alpha Alpha contrast.
  * @param ell Degree of the spherical harmonic.
  * @param m Order of the spherical harmonic.
@@ -167,11 +168,29 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
  * @overload
  */
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
-  ParticleCatalogue& particles, LineOfSight* los,
+  ParticleCatalogue& particles, const LineOfSightPolicy& los,
   double alpha, int ell, int m
 );
 
 
+// ***********************************************************************
+// Memory usage
+// ***********************************************************************
+
+/**
+ * @brief Estimate the peak memory usage of a three-point statistic
+ *        measurement in addition to its particle catalogues.
+ *
+ * Optional bin-pair scheduling engines are excluded as they are
+ * only used within the memory budget.
+ *
+ * @param params Parameter set.
+ * @param ntotal Particle number of the largest catalogue.
+ * @returns Estimated memory usage (in gibibytes).
+ */
+double estimate_3pt_mem_usage(trv::ParameterSet& params, long long ntotal);
+
+
 // ***********************************************************************
 // Full statistics
 // ***********************************************************************
@@ -186,18 +205,21 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
  *
  * @param catalogue_data (Data-source) particle catalogue.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) particle line-of-sight policy.
+ * @param los_rand (Random-source) particle line-of-sight policy.
  * @param params Parameter set.
  * @param kbinning Wavenumber binning.
  * @param norm_factor Normalisation factor.
+ * @param field_cache Mesh field cache shared between measurements
+ *                    (default is `nullptr`).
  * @returns Bispectrum measurements.
  */
 trv::BispecMeasurements compute_bispec(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning& kbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache = nullptr
 );
 
 /**
@@ -206,18 +228,21 @@ trv::BispecMeasurements compute_bispec(
  *
  * @param catalogue_data (Data-source) particle catalogue.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) particle line-of-sight policy.
+ * @param los_rand (Random-source) particle line-of-sight policy.
  * @param params Parameter set.
  * @param rbinning Separation binning.
  * @param norm_factor Normalisation factor.
+ * @param field_cache Mesh field cache shared between measurements
+ *                    (default is `nullptr`).
  * @returns Three-point correlation function measurements.
  */
 trv::ThreePCFMeasurements compute_3pcf(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache = nullptr
 );
 
 /**
@@ -228,12 +253,15 @@ trv::ThreePCFMeasurements compute_3pcf(
  * @param params Parameter set.
  * @param kbinning Wavenumber binning.
  * @param norm_factor Normalisation factor.
+ * @param field_cache Mesh field cache shared between measurements
+ *                    (default is `nullptr`).
  * @returns Bispectrum measurements.
  */
 trv::BispecMeasurements compute_bispec_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning kbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache = nullptr
 );
 
 /**
@@ -244,12 +272,15 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
  * @param params Parameter set.
  * @param rbinning Separation binning.
  * @param norm_factor Normalisation factor.
+ * @param field_cache Mesh field cache shared between measurements
+ *                    (default is `nullptr`).
  * @returns Three-point correlation function measurements.
  */
 trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning& rbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache = nullptr
 );
 
 /**
@@ -257,7 +288,7 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
  *        a random catalogue.
  *
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_rand (Random-source) particle line-of-sight policy.
  * @param params Parameter set.
  * @param rbinning Separation binning.
  * @param alpha Alpha contrast.
@@ -267,7 +298,7 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
  * @returns Three-point correlation function window measurements.
  */
 trv::ThreePCFWindowMeasurements compute_3pcf_window(
-  ParticleCatalogue& catalogue_rand, LineOfSight* los_rand,
+  ParticleCatalogue& catalogue_rand, const LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
   double alpha, double norm_factor, bool wide_angle = false
 );
@@ -279,8 +310,8 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
  *
  * @param catalogue_data (Data-source) particle catalogue.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) particle line-of-sight policy.
+ * @param los_rand (Random-source) particle line-of-sight policy.
  * @param los_choice Choice of line of sight in {0, 1, 2}.
  * @param params Parameter set.
  * @param kbin Wavenumber binning.
@@ -290,7 +321,7 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
  */
 trv::BispecMeasurements compute_bispec_for_los_choice(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   int los_choice,
   trv::ParameterSet& params, trv::Binning& kbinning,
   double norm_factor
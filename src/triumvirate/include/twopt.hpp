@@ -41,6 +41,7 @@
 #include <cmath>
 #include <complex>
 #include <cstdio>
+#include <vector>
 
 #include "monitor.hpp"
 #include "maths.hpp"
@@ -188,8 +189,8 @@ double calc_powspec_shotnoise_from_particles(
  *
  * @param particles_data (Data-source) particle catalogue.
  * @param particles_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) particle line-of-sight policy.
+ * @param los_rand (Random-source) particle line-of-sight policy.
  * @param alpha Alpha contrast.
  * @param ell Degree of the spherical harmonic.
  * @param m Order of the spherical harmonic.
@@ -197,7 +198,7 @@ double calc_powspec_shotnoise_from_particles(
  */
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   double alpha, int ell, int m
 );
 
@@ -206,7 +207,7 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
  *        reduced spherical harmonics.
  *
  * @param particles Particle catalogue.
- * @param los Particle lines of sight.
+ * @param los Particle line-of-sight policy.
  * @param alpha Alpha contrast.
  * @param ell Degree of the spherical harmonic.
  * @param m Order of the spherical harmonic.
@@ -215,10 +216,52 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
  * @overload
  */
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
-  ParticleCatalogue& particles, LineOfSight* los,
+  ParticleCatalogue& particles, const LineOfSightPolicy& los,
   double alpha, int ell, int m
 );
 
+/**
+ * @brief Calculate power spectrum shot noise weighted by
+ *        Cartesian line-of-sight moments.
+ *
+ * This calculates the quantities
+ * @f[
+ *   \bar{N}_b = {\sum_i}{\vphantom{\sum}}'
+ *     c_b(\hat{\vec{x}}_i) w(\vec{x}_i)^2
+ * @f]
+ * for all moments @f$ c_b @f$, where
+ * @f$ {\sum_i}{\vphantom{\sum}}' @f$ is as in
+ * @ref trv::calc_ylm_wgtd_shotnoise_amp_for_powspec().
+ *
+ * @param particles_data (Data-source) particle catalogue.
+ * @param particles_rand (Random-source) particle catalogue.
+ * @param los_data (Data-source) particle line-of-sight policy.
+ * @param los_rand (Random-source) particle line-of-sight policy.
+ * @param alpha Alpha contrast.
+ * @param moment_calc Cartesian moment calculator.
+ * @returns Weighted shot noise for power spectrum for each moment.
+ */
+std::vector<double> calc_los_moment_wgtd_shotnoise_amps_for_powspec(
+  ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+  double alpha, const trv::maths::CartesianMomentCalculator& moment_calc
+);
+
+
+// ***********************************************************************
+// Memory usage
+// ***********************************************************************
+
+/**
+ * @brief Estimate the peak memory usage of a two-point statistic
+ *        measurement in addition to its particle catalogues.
+ *
+ * @param params Parameter set.
+ * @param ntotal Particle number of the largest catalogue.
+ * @returns Estimated memory usage (in gibibytes).
+ */
+double estimate_2pt_mem_usage(trv::ParameterSet& params, long long ntotal);
+
 
 // ***********************************************************************
 // Full statistics
@@ -230,20 +273,32 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
 /**
  * @brief Compute power spectrum from paired survey-type catalogues.
  *
+ * If @c params.powspec_estimator is "cartesian" (and
+ * @c params.ELL is non-zero), the multipole is estimated from the
+ * @f$ 2\ell + 1 @f$ real Cartesian moment fields of
+ * @ref trv::maths::CartesianMomentCalculator, packed in pairs into
+ * complex fields, instead of the @f$ 2\ell + 1 @f$ complex fields
+ * weighted by the reduced spherical harmonics.  The results agree
+ * to round-off error except near the Nyquist planes with interlacing
+ * (see @ref trv::MeshField::add_unpacked_los_moment_wgtd_fields()).
+ *
  * @param catalogue_data (Data-source) particle catalogue.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) particle line-of-sight policy.
+ * @param los_rand (Random-source) particle line-of-sight policy.
  * @param params Parameter set.
  * @param kbinning Wavenumber binning.
  * @param norm_factor Normalisation factor.
+ * @param field_cache Mesh field cache shared between measurements
+ *                    (default is `nullptr`).
  * @returns Power spectrum measurements.
  */
 trv::PowspecMeasurements compute_powspec(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning& kbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache = nullptr
 );
 
 /**
@@ -252,18 +307,21 @@ trv::PowspecMeasurements compute_powspec(
  *
  * @param catalogue_data (Data-source) particle catalogue.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) particle line-of-sight policy.
+ * @param los_rand (Random-source) particle line-of-sight policy.
  * @param params Parameter set.
  * @param rbinning Separation binning.
  * @param norm_factor Normalisation factor.
+ * @param field_cache Mesh field cache shared between measurements
+ *                    (default is `nullptr`).
  * @returns Two-point correlation function measurements.
  */
 trv::TwoPCFMeasurements compute_corrfunc(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache = nullptr
 );
 
 /**
@@ -274,12 +332,44 @@ trv::TwoPCFMeasurements compute_corrfunc(
  * @param params Parameter set.
  * @param kbinning Wavenumber binning.
  * @param norm_factor Normalisation factor.
+ * @param field_cache Mesh field cache shared between measurements
+ *                    (default is `nullptr`).
  * @returns Power spectrum measurements.
  */
 trv::PowspecMeasurements compute_powspec_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning kbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache = nullptr
+);
+
+/**
+ * @brief Compute power spectrum multipoles and wedges in a periodic box
+ *        in the global plane-parallel approximation from a single
+ *        (k, μ) accumulation.
+ *
+ * All multipoles and wedges share one Fourier-space field and one sweep
+ * over the mesh grid, and the multipoles are identical to those from
+ * @ref trv::compute_powspec_in_gpp_box for each degree.
+ *
+ * @param catalogue_data (Data-source) particle catalogue.
+ * @param params Parameter set.
+ * @param kbinning Wavenumber binning.
+ * @param ells Degrees of the multipoles.
+ * @param num_wedges Number of equal-width wedges in |μ| (zero if none).
+ * @param norm_factor Normalisation factor.
+ * @param field_cache Mesh field cache shared between measurements
+ *                    (default is `nullptr`).
+ * @returns Power spectrum multipole and wedge measurements.
+ * @throws trv::sys::InvalidParameterError When any degree in @p ells
+ *                                         or @p num_wedges is negative.
+ */
+trv::PowspecKMuMeasurements compute_powspec_kmu_in_gpp_box(
+  ParticleCatalogue& catalogue_data,
+  trv::ParameterSet& params, trv::Binning kbinning,
+  const std::vector<int>& ells, int num_wedges,
+  double norm_factor,
+  MeshFieldCache* field_cache = nullptr
 );
 
 /**
@@ -290,12 +380,15 @@ trv::PowspecMeasurements compute_powspec_in_gpp_box(
  * @param params Parameter set.
  * @param rbinning Separation binning.
  * @param norm_factor Normalisation factor.
+ * @param field_cache Mesh field cache shared between measurements
+ *                    (default is `nullptr`).
  * @returns Two-point correlation function measurements.
  */
 trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning& rbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache = nullptr
 );
 
 /**
@@ -303,7 +396,7 @@ trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
  *        catalogue and optionally save the results.
  *
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_rand (Random-source) particle line-of-sight policy.
  * @param params Parameter set.
  * @param rbinning Separation binning.
  * @param alpha Alpha contrast.
@@ -311,7 +404,8 @@ trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
  * @returns Two-point correlation function window measurements.
  */
 trv::TwoPCFWindowMeasurements compute_corrfunc_window(
-  trv::ParticleCatalogue& catalogue_rand, trv::LineOfSight* los_rand,
+  trv::ParticleCatalogue& catalogue_rand,
+  const trv::LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning rbinning,
   double alpha, double norm_factor
 );
@@ -0,0 +1,307 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file winconv.hpp
+ * @authors Mike S Wang (https://github.com/MikeSWang)
+ * @brief Window convolution of two- and three-point clustering
+ *        statistics with precompiled coupling plans.
+ *
+ */
+
+#ifndef TRIUMVIRATE_INCLUDE_WINCONV_HPP_INCLUDED_
+#define TRIUMVIRATE_INCLUDE_WINCONV_HPP_INCLUDED_
+
+#ifdef TRV_USE_OMP
+#include <omp.h>
+#endif  // TRV_USE_OMP
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "monitor.hpp"
+#include "arrayops.hpp"
+#include "fftlog.hpp"
+
+namespace trv {
+
+/**
+ * @brief Window convolution engine.
+ *
+ * Window convolution of configuration-space multipoles is
+ * a multiplication by a dense coupling plan, i.e.
+ * @f[
+ *   \zeta^W_a(\vec{r}) = \sum_b C_{ab}(\vec{r}) \zeta_b(\vec{r}) \,,
+ * @f]
+ * where @f$ C_{ab} @f$ sums the window function multipoles of all
+ * formula terms coupling the unwindowed multipole @f$ b @f$ to the
+ * windowed multipole @f$ a @f$, sampled at common sample points in
+ * 1-d (two-point statistics) or 2-d (three-point statistics).
+ *
+ * All multipoles are convolved in one call in the following stages,
+ * with each multipole stored as a contiguous row-major block in
+ * input and output arrays:
+ *
+ * 1. (Fourier-space statistics only) backward spherical Bessel
+ *    transforms of the input multipoles;
+ * 2. resampling of the input multipoles at the common sample points;
+ * 3. multiplication by the coupling plan;
+ * 4. (Fourier-space statistics only) forward spherical Bessel
+ *    transforms of the windowed multipoles;
+ * 5. resampling of the windowed multipoles at the output sample points.
+ *
+ * Resampling is a precomputed linear operator (e.g. the weights of
+ * a cubic spline), applied in each dimension, and is skipped where
+ * unset; weights negligible to machine precision in each row are
+ * banded off.  Stages 1 and 2 are skipped entirely if the input multipoles
+ * are already on the common sample points.  All transform plans,
+ * weights and work buffers are reused across calls.
+ *
+ */
+class WinConvEngine {
+ public:
+  int ndim;            ///< dimension of multipole samples: {1, 2}
+  int nmultipoles;     ///< number of windowed multipoles
+  int nmultipoles_Z;   ///< number of unwindowed multipoles
+  int nsamp_in;        ///< number of input sample points per dimension
+  int nsamp;           ///< number of common sample points per dimension
+  int nsamp_out;       ///< number of output sample points per dimension
+
+  /// post-transform sample points of each unwindowed multipole after
+  /// backward transforms (empty if not planned)
+  std::vector< std::vector<double> > post_sampts_Z;
+
+  /// post-transform sample points of each windowed multipole after
+  /// forward transforms (empty if not planned)
+  std::vector< std::vector<double> > post_sampts;
+
+  /**
+   * @brief Construct the window convolution engine.
+   *
+   * @param ndim Dimension of multipole samples: {1, 2}.
+   * @param nmultipoles Number of windowed multipoles.
+   * @param nmultipoles_Z Number of unwindowed multipoles.
+   * @param nsamp_in Number of input sample points per dimension.
+   * @param nsamp Number of common sample points per dimension.
+   * @param nsamp_out Number of output sample points per dimension.
+   * @param coupling Coupling plan as a contiguous
+   *                 (@p nmultipoles × @p nmultipoles_Z × @p nsamp
+   *                 [× @p nsamp]) array.  Vanishing couplings are
+   *                 skipped.
+   * @param threaded If `true` (default), use multi-threads.
+   * @throws trv::sys::InvalidParameterError When the dimensions or
+   *                                         sizes are invalid.
+   */
+  WinConvEngine(
+    int ndim, int nmultipoles, int nmultipoles_Z,
+    int nsamp_in, int nsamp, int nsamp_out,
+    std::vector<double> coupling, bool threaded = true
+  );
+
+  /**
+   * @brief Plan the backward and forward spherical Bessel transforms
+   *        (with zero power-law bias) for Fourier-space statistics.
+   *
+   * @param degrees_Z Degrees of the backward transforms as
+   *                  a contiguous (@ref nmultipoles_Z × @ref ndim)
+   *                  array.
+   * @param degrees Degrees of the forward transforms as a contiguous
+   *                (@ref nmultipoles × @ref ndim) array.
+   * @param sample_pts_in Logarithmically linearly-spaced input
+   *                      sample points.
+   * @param sample_pts Logarithmically linearly-spaced common
+   *                   sample points.
+   * @param kr_c Pivot value.
+   * @param lowring If true (default), set the pivot value by the
+   *                low-ringing condition.
+   * @param extrap Extrapolation option (default is 0).
+   * @param extrap_exp Sample size expansion factor (default is 2.)
+   *                   for extrapolation.
+   * @param extrap2d If `true` (default is `false`), extrapolate in 2-d
+   *                 (three-point statistics only).
+   * @throws trv::sys::InvalidParameterError When the sizes of the
+   *                                         degrees or sample points are
+   *                                         invalid.
+   *
+   * @see @ref trv::maths::DoubleSphericalBesselTransform::initialise
+   */
+  void plan_transforms(
+    std::vector<int> degrees_Z, std::vector<int> degrees,
+    std::vector<double> sample_pts_in, std::vector<double> sample_pts,
+    double kr_c, bool lowring = true,
+    int extrap = 0, double extrap_exp = 2., bool extrap2d = false
+  );
+
+  /**
+   * @brief Set the resampling weights of an unwindowed multipole from
+   *        input to common sample points.
+   *
+   * @param imultipole_Z Index of the unwindowed multipole.
+   * @param weights Resampling weights as a contiguous
+   *                (@ref nsamp × @ref nsamp_in) array.  If empty,
+   *                no resampling is performed.
+   * @throws trv::sys::InvalidParameterError When the index or the size of
+   *                                         the weights is invalid.
+   */
+  void set_input_weights(int imultipole_Z, std::vector<double> weights);
+
+  /**
+   * @brief Set the resampling weights of a windowed multipole from
+   *        common to output sample points.
+   *
+   * @param imultipole Index of the windowed multipole.
+   * @param weights Resampling weights as a contiguous
+   *                (@ref nsamp_out × @ref nsamp) array.  If empty,
+   *                no resampling is performed.
+   * @throws trv::sys::InvalidParameterError When the index or the size of
+   *                                         the weights is invalid.
+   */
+  void set_output_weights(int imultipole, std::vector<double> weights);
+
+  /**
+   * @brief Convolve all multipoles.
+   *
+   * @param[in] in Unwindowed multipole samples as a contiguous
+   *               (@ref nmultipoles_Z × @ref nsamp_in [× @ref nsamp_in])
+   *               array, or (@ref nmultipoles_Z × @ref nsamp
+   *               [× @ref nsamp]) if @p on_grid is `true`.
+   * @param[out] out Windowed multipole samples as a contiguous
+   *                 (@ref nmultipoles × @ref nsamp_out
+   *                 [× @ref nsamp_out]) array.
+   * @param on_grid If `true` (default is `false`), the unwindowed
+   *                multipoles are given in configuration space at
+   *                the common sample points, and stages 1 and 2 are
+   *                skipped.
+   * @throws std::runtime_error When the resampling at any stage is
+   *                            required but unset.
+   */
+  void convolve(const double* in, double* out, bool on_grid = false);
+
+ private:
+  /// multi-threading
+  bool threaded = true;
+
+  /// number of samples per multipole at common sample points
+  std::size_t size_common = 0;
+
+  /// coupling plan
+  std::vector<double> coupling;
+
+  /// indices of unwindowed multipoles with non-vanishing coupling
+  /// for each windowed multipole
+  std::vector< std::vector<int> > couplings_Z;
+
+  /**
+   * @brief Resampling weights with the band of non-negligible weights
+   *        in each row.
+   */
+  struct ResamplingWeights {
+    std::vector<double> values;  ///< weights in row-major order
+    std::vector<int> begins;     ///< first column index of each row band
+    std::vector<int> ends;       ///< past-the-last column index of each
+                                 ///< row band
+  };
+
+  /// resampling weights of each multipole at each stage: [0] input,
+  /// [1] output
+  std::vector<ResamplingWeights> weights[2];
+
+  /// whether transforms are planned
+  bool transformed = false;
+
+  /// 1-d transforms of each multipole (on extended sample points
+  /// if extrapolated) in each direction
+  std::vector< std::unique_ptr<trv::maths::HankelTransform> >
+    transforms_1d[2];
+
+  /// 2-d transforms of each multipole in each direction
+  std::vector<
+    std::unique_ptr<trv::maths::DoubleSphericalBesselTransform>
+  > transforms_2d[2];
+
+  /// 1-d extrapolation option
+  trv::array::ExtrapOption extrap = trv::array::ExtrapOption::NONE;
+
+  /// number of extra 1-d sample points on either side in each direction
+  int n_ext[2] = {0, 0};
+
+  /// 1-d pre-transform factors @f$ x^{3/2} @f$ in each direction
+  std::vector<double> pre_factors[2];
+
+  /// 1-d post-transform factors @f$ (2\pi/y)^{3/2} @f$ of each
+  /// multipole in each direction
+  std::vector< std::vector<double> > post_factors[2];
+
+  /// work buffers for samples after each stage, reused across calls
+  std::vector<double> trans_buffer_Z;
+  std::vector<double> common_buffer_Z;
+  std::vector<double> conv_buffer;
+  std::vector<double> trans_buffer;
+  std::vector<double> resamp_buffer;
+  std::vector<double> pre_buffer;
+  std::vector<double> post_buffer;
+
+  /**
+   * @brief Perform the spherical Bessel transform of a multipole.
+   *
+   * @param[in] idir Transform direction index: 0 (backward) or
+   *                 1 (forward).
+   * @param[in] imultipole Multipole index.
+   * @param[in] in Pre-transform samples.
+   * @param[out] out Post-transform samples.
+   */
+  void transform(int idir, int imultipole, const double* in, double* out);
+
+  /**
+   * @brief Band resampling weights.
+   *
+   * @param weights Resampling weights as a contiguous
+   *                (@p nsamp_to × @p nsamp_from) array.
+   * @param nsamp_from Number of sample points before resampling.
+   * @returns Banded resampling weights.
+   */
+  static ResamplingWeights band_weights(
+    std::vector<double> weights, int nsamp_from
+  );
+
+  /**
+   * @brief Resample a multipole with linear weights in each dimension.
+   *
+   * @param[in] weights Banded resampling weights.
+   * @param[in] nsamp_from, nsamp_to Number of sample points per
+   *                                  dimension before and after
+   *                                  resampling.
+   * @param[in] in Samples before resampling.
+   * @param[out] out Samples after resampling.
+   */
+  void resample(
+    const ResamplingWeights& weights, int nsamp_from, int nsamp_to,
+    const double* in, double* out
+  );
+};
+
+}  // namespace trv
+
+#endif  // !TRIUMVIRATE_INCLUDE_WINCONV_HPP_INCLUDED_
@@ -25,8 +25,13 @@
  *
  */
 
+#include <array>
+#include <cmath>
 #include <cstdio>
+#include <fstream>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "monitor.hpp"
 #include "parameters.hpp"
@@ -35,6 +40,8 @@
 #include "io.hpp"
 #include "twopt.hpp"
 #include "threept.hpp"
+#include "plan.hpp"
+#include "synthetic.hpp"
 
 /**
  * @brief A 'black-box' program for measuring two- and three-point
@@ -111,6 +118,8 @@ int main(int argc, char* argv[]) {
 
   trv::sys::logger.reset_level(params.verbose);
 
+  trv::sys::profiler.tracing = (params.profile_trace != "");
+
   // ---------------------------------------------------------------------
   // A.2 Data I/O
   // ---------------------------------------------------------------------
@@ -121,6 +130,67 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  // In batch mode, data-source catalogues are listed in a file and
+  // loaded in turn, all paired with the same random-source catalogue.
+  std::vector<std::string> data_catalogue_files;  // batch catalogue files
+  if (params.data_catalogue_list != "") {
+    std::ifstream fin(params.data_catalogue_list.c_str(), std::ios::in);
+    if (!fin) {
+      if (trv::sys::currTask == 0) {
+        trv::sys::logger.error(
+          "Failed to initialise program: "
+          "unopenable data catalogue list file."
+        );
+        throw trv::sys::IOError(
+          "Failed to initialise program: "
+          "unopenable data catalogue list file.\n"
+        );
+      }
+    }
+
+    std::string line_str;
+    while (std::getline(fin, line_str)) {
+      // Skip empty lines or comment lines.
+      std::size_t pos_start = line_str.find_first_not_of(" \t\r");
+      if (pos_start == std::string::npos || line_str[pos_start] == '#') {
+        continue;
+      }
+      std::size_t pos_end = line_str.find_last_not_of(" \t\r");
+      std::string filepath =
+        line_str.substr(pos_start, pos_end - pos_start + 1);
+      if (
+        filepath.rfind("/", 0) != 0
+        && !trv::SyntheticCatalogueGenerator::is_synthetic_source(filepath)
+      ) {
+        filepath = params.catalogue_dir + filepath;
+      }
+      data_catalogue_files.push_back(filepath);
+    }
+    fin.close();
+
+    if (data_catalogue_files.empty()) {
+      if (trv::sys::currTask == 0) {
+        trv::sys::logger.error(
+          "Failed to initialise program: empty data catalogue list."
+        );
+        throw trv::sys::IOError(
+          "Failed to initialise program: empty data catalogue list.\n"
+        );
+      }
+    }
+
+    params.data_catalogue_file = data_catalogue_files[0];
+
+    if (trv::sys::currTask == 0) {
+      trv::sys::logger.info(
+        "Data catalogue list read: %d catalogues (source=%s).",
+        static_cast<int>(data_catalogue_files.size()),
+        params.data_catalogue_list.c_str()
+      );
+    }
+  }
+  bool batch = !data_catalogue_files.empty();  // batch mode
+
   trv::ParticleCatalogue catalogue_data; // data-source catalogue
   std::string flag_data = "false";       // data-source catalogue status
   if (params.catalogue_type == "survey" || params.catalogue_type == "sim") {
@@ -200,100 +270,34 @@ int main(int argc, char* argv[]) {
   }
 
   // ---------------------------------------------------------------------
-  // B.1 Binning
-  // ---------------------------------------------------------------------
-
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat("[B.1] Setting up binning...");
-  }
-
-  trv::Binning binning(params);  // binning
-  binning.set_bins();
-
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat("[B.1] ... set up binning.");
-  }
-
-  // ---------------------------------------------------------------------
-  // B.2 Line of sight
+  // B.1 Line of sight
   // ---------------------------------------------------------------------
 
   if (params.catalogue_type != "none") {
     if (trv::sys::currTask == 0) {
-      trv::sys::logger.stat("[B.2] Computing lines of sight...");
+      trv::sys::logger.stat("[B.1] Setting up lines of sight...");
     }
   }
 
-  trv::LineOfSight* los_data = nullptr;
-  if (flag_data == "true") {
-    // data-source LoS
-    los_data = new trv::LineOfSight[catalogue_data.ntotal];
-    trv::sys::gbytesMem +=
-      trv::sys::size_in_gb<struct trv::LineOfSight>(catalogue_data.ntotal);
-    trv::sys::update_maxmem();
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-    for (int pid = 0; pid < catalogue_data.ntotal; pid++) {
-      double los_mag =
-        trv::maths::get_vec3d_magnitude(catalogue_data[pid].pos);
-
-      if (los_mag == 0.) {
-        trv::sys::logger.warn(
-          "A data-catalogue particle coincides with the origin."
-        );
-        los_mag = 1.;
-      }
-
-      los_data[pid].pos[0] = catalogue_data[pid].pos[0] / los_mag;
-      los_data[pid].pos[1] = catalogue_data[pid].pos[1] / los_mag;
-      los_data[pid].pos[2] = catalogue_data[pid].pos[2] / los_mag;
-    }
-  }
-
-  trv::LineOfSight* los_rand = nullptr;
-  if (flag_rand == "true") {
-    // random-source LoS
-    los_rand = new trv::LineOfSight[catalogue_rand.ntotal];
-    trv::sys::gbytesMem +=
-      trv::sys::size_in_gb<struct trv::LineOfSight>(catalogue_rand.ntotal);
-    trv::sys::update_maxmem();
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-    for (int pid = 0; pid < catalogue_rand.ntotal; pid++) {
-      double los_mag =
-        trv::maths::get_vec3d_magnitude(catalogue_rand[pid].pos);
-
-      if (los_mag == 0.) {
-        trv::sys::logger.warn(
-          "A random-catalogue particle coincides with the origin."
-        );
-        los_mag = 1.;
-      }
-
-      los_rand[pid].pos[0] = catalogue_rand[pid].pos[0] / los_mag;
-      los_rand[pid].pos[1] = catalogue_rand[pid].pos[1] / los_mag;
-      los_rand[pid].pos[2] = catalogue_rand[pid].pos[2] / los_mag;
-    }
-  }
+  // Local lines of sight are evaluated on the fly relative to the
+  // catalogue observer, which is tracked through box alignment.
+  trv::LineOfSightPolicy los_data;  // data-source LoS
+  trv::LineOfSightPolicy los_rand;  // random-source LoS
 
   if (params.catalogue_type != "none") {
     if (trv::sys::currTask == 0) {
-      trv::sys::logger.stat("[B.2] ... computed lines of sight.");
+      trv::sys::logger.stat("[B.1] ... set up lines of sight.");
     }
   }
 
   // ---------------------------------------------------------------------
-  // B.3 Box alignment
+  // B.2 Box alignment
   // ---------------------------------------------------------------------
 
   if (params.catalogue_type != "none") {
     if (trv::sys::currTask == 0) {
       trv::sys::logger.stat(
-        "[B.3] Aligning catalogues inside measurement box..."
+        "[B.2] Aligning catalogues inside measurement box..."
       );
     }
   }
@@ -358,13 +362,13 @@ int main(int argc, char* argv[]) {
   if (params.catalogue_type != "none") {
     if (trv::sys::currTask == 0) {
       trv::sys::logger.stat(
-        "[B.3] ... aligned catalogues inside measurement box."
+        "[B.2] ... aligned catalogues inside measurement box."
       );
     }
   }
 
   // ---------------------------------------------------------------------
-  // B.4 Constants
+  // B.3 Constants
   // ---------------------------------------------------------------------
 
   double alpha;  // alpha contrast
@@ -380,389 +384,584 @@ int main(int argc, char* argv[]) {
     }
   }
 
-  trv::ParticleCatalogue& catalogue_for_norm =
-    (flag_rand == "true") ? catalogue_rand : catalogue_data;
-  double alpha_for_norm = (flag_rand == "true") ? alpha : 1.;
-  double norm_factor_part = 0., norm_factor_mesh = 0., norm_factor_meshes = 0.;
+  // ---------------------------------------------------------------------
+  // B.4 Measurement plan
+  // ---------------------------------------------------------------------
 
-  if (params.npoint == "2pt") {
-    norm_factor_part = trv::calc_powspec_normalisation_from_particles(
-      catalogue_for_norm, alpha_for_norm
-    );
-    norm_factor_mesh = trv::calc_powspec_normalisation_from_mesh(
-      catalogue_for_norm, params, alpha_for_norm
+  // All measurements share the catalogues, lines of sight and alpha
+  // contrast above.  Measurements in a plan also share mesh fields,
+  // which are cached only while they are still needed.  In batch mode,
+  // the plan is repeated for each data-source catalogue, while
+  // random-source mesh fields are retained throughout.  With an on-disk
+  // cache, random-source mesh fields are further persisted across runs
+  // (keyed by the content hash of the aligned random-source catalogue).
+  trv::MeasurementPlan plan(params);  // measurement plan
+  trv::MeshFieldCache field_cache;    // mesh field cache
+  trv::MeshFieldCache* field_cache_ptr = nullptr;
+  bool persist = params.mesh_cache_dir != "";  // on-disk cache mode
+  if (params.statistic_type == "plan" || batch || persist) {
+    field_cache_ptr = &field_cache;
+  }
+  if (persist) {
+    trv::sys::make_write_dir(params.mesh_cache_dir);
+    field_cache.persist_random_fields(
+      params.mesh_cache_dir, params.mesh_cache_size,
+      catalogue_rand.calc_content_hash()
     );
-    // Mixed-mesh normalisation is only implemented for
-    // paired survey-like catalogues.
-    if (params.catalogue_type == "survey") {
-      // Use default parameters for mixed-mesh normalisation in `pypower`.
-      const double PADDING = 0.1;
-      const double CELLSIZE = 10.;
-      const std::string ASSIGNMENT = "cic";
-      // Box size for normalisation is internally set and as such,
-      // the current alignment of the catalogues is not applicable, but
-      // this should have no effect on the normalisation.
-      norm_factor_meshes = trv::calc_powspec_normalisation_from_meshes(
-        catalogue_data, catalogue_rand, params, alpha,
-        PADDING, CELLSIZE, ASSIGNMENT
-      );
-    }
   } else
-  if (params.npoint == "3pt") {
-    norm_factor_part = trv::calc_bispec_normalisation_from_particles(
-      catalogue_for_norm, alpha_for_norm
-    );
-    norm_factor_mesh = trv::calc_bispec_normalisation_from_mesh(
-      catalogue_for_norm, params, alpha_for_norm
-    );
+  if (batch) {
+    field_cache.retain_random_fields();
   }
 
-  double norm_factor = 0.;
-  if (params.npoint != "none") {
-    if (params.norm_convention == "none") {
-      norm_factor = 1.;
-      if (trv::sys::currTask == 0) {
-        trv::sys::logger.info(
-          "Normalisation factors: "
-          "%.6e (particle), %.6e (mesh), %.6e (mesh-mixed) (none used).",
-          norm_factor_part, norm_factor_mesh, norm_factor_meshes
-        );
+  // Normalisation factors (particle, mesh and mesh-mixed) are computed
+  // once for each N-point case (and data-source catalogue).  The mesh
+  // normalisation depends on the data-source catalogue only through
+  // the alpha contrast, so its alpha-independent part is kept for
+  // all data-source catalogues.
+  std::map<std::string, std::array<double, 3>> norm_factors_npoint;
+  std::map<std::string, double> norm_factors_mesh_unit;
+
+  int nitems = static_cast<int>(plan.items.size());
+  int ncatalogues = batch ? static_cast<int>(data_catalogue_files.size()) : 1;
+  for (int imeas = 0; imeas < ncatalogues * nitems; imeas++) {
+    int icatalogue = imeas / nitems;
+    trv::ParameterSet params_stat(plan.items[imeas % nitems]);
+
+    if (imeas % nitems == 0) {
+      if (batch && icatalogue > 0) {
+        // Reload the data-source catalogue and align it in the frame of
+        // the random-source catalogue, which is already aligned.
+        catalogue_data.reset_catalogue();
+        if (catalogue_data.load_catalogue_file(
+          data_catalogue_files[icatalogue],
+          params.catalogue_columns, params.volume
+        )) {
+          if (trv::sys::currTask == 0) {
+            trv::sys::logger.error(
+              "Failed to load batch data-source catalogue file."
+            );
+            throw trv::sys::IOError(
+              "Failed to load batch data-source catalogue file.\n"
+            );
+          }
+        }
+
+        double dvec[3];
+        for (int iaxis = 0; iaxis < 3; iaxis++) {
+          dvec[iaxis] =
+            catalogue_data.observer[iaxis] - catalogue_rand.observer[iaxis];
+        }
+        catalogue_data.offset_coords(dvec);
+
+        alpha = catalogue_data.wstotal / catalogue_rand.wstotal;
+        if (trv::sys::currTask == 0) {
+          trv::sys::logger.info("Alpha contrast: %.6e.", alpha);
+        }
+
+        norm_factors_npoint.clear();
       }
-    } else
-    if (params.norm_convention == "particle") {
-      norm_factor = norm_factor_part;
-      if (trv::sys::currTask == 0) {
-        trv::sys::logger.info(
-          "Normalisation factors: "
-          "%.6e (particle; used), %.6e (mesh), %.6e (mesh-mixed).",
-          norm_factor, norm_factor_mesh, norm_factor_meshes
+
+      if (batch && trv::sys::currTask == 0) {
+        trv::sys::logger.stat(
+          "Measuring batch data-source catalogue %d of %d: %s.",
+          icatalogue + 1, ncatalogues,
+          data_catalogue_files[icatalogue].c_str()
         );
       }
-    } else
-    if (params.norm_convention == "mesh") {
-      norm_factor = norm_factor_mesh;
-      if (trv::sys::currTask == 0) {
-        trv::sys::logger.info(
-          "Normalisation factors: "
-          "%.6e (particle), %.6e (mesh; used), %.6e (mesh-mixed).",
-          norm_factor_part, norm_factor, norm_factor_meshes
-        );
+
+      if (params.statistic_type == "plan") {
+        plan.register_field_uses(field_cache);
       }
-    } else
-    if (params.norm_convention == "mesh-mixed") {
-      norm_factor = norm_factor_meshes;
-      if (trv::sys::currTask == 0) {
-        trv::sys::logger.info(
-          "Normalisation factors: "
-          "%.6e (particle), %.6e (mesh), %.6e (mesh-mixed; used).",
-          norm_factor_part, norm_factor_mesh, norm_factor
+    }
+
+    if (batch) {
+      // Window functions only depend on the random-source catalogue.
+      if (params_stat.statistic_type.find("-win") != std::string::npos) {
+        if (icatalogue > 0) {continue;}
+      } else {
+        std::string filename = data_catalogue_files[icatalogue].substr(
+          data_catalogue_files[icatalogue].find_last_of("/") + 1
         );
+        params_stat.data_catalogue_file = data_catalogue_files[icatalogue];
+        params_stat.output_tag +=
+          "_" + filename.substr(0, filename.find_last_of("."));
       }
     }
-  }
 
-  // ---------------------------------------------------------------------
-  // B.5 Clustering algorithms
-  // ---------------------------------------------------------------------
-
-  char save_filepath[1024];
-  if (params.statistic_type == "powspec") {
-    std::snprintf(
-      save_filepath, sizeof(save_filepath), "%s/pk%d%s",
-      params.measurement_dir.c_str(), params.ELL, params.output_tag.c_str()
-    );
-    std::FILE* save_fileptr = nullptr;
-    trv::PowspecMeasurements meas_powspec;  // power spectrum
-    if (params.catalogue_type == "survey") {
-      meas_powspec = trv::compute_powspec(
-        catalogue_data, catalogue_rand, los_data, los_rand,
-        params, binning, norm_factor
-      );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::io::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, catalogue_rand,
-        norm_factor_part, norm_factor_mesh, norm_factor_meshes
-      );
-    } else
-    if (params.catalogue_type == "sim") {
-      meas_powspec = trv::compute_powspec_in_gpp_box(
-        catalogue_data, params, binning, norm_factor
-      );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::io::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data,
-        norm_factor_part, norm_factor_mesh, norm_factor_meshes
+    if (params.statistic_type == "plan" && trv::sys::currTask == 0) {
+      trv::sys::logger.stat(
+        "Measuring planned statistic '%s' "
+        "(ell1 = %d, ell2 = %d, ELL = %d)...",
+        params_stat.statistic_type.c_str(),
+        params_stat.ell1, params_stat.ell2, params_stat.ELL
       );
     }
-    trv::io::print_measurement_datatab_to_file(
-      save_fileptr, params, meas_powspec
-    );
-    std::fclose(save_fileptr);
-  } else
-  if (params.statistic_type == "2pcf") {
-    std::snprintf(
-      save_filepath, sizeof(save_filepath), "%s/xi%d%s",
-      params.measurement_dir.c_str(), params.ELL, params.output_tag.c_str()
-    );
-    std::FILE* save_fileptr = nullptr;
-    trv::TwoPCFMeasurements meas_2pcf;  // two-point correlation function
-    if (params.catalogue_type == "survey") {
-      meas_2pcf = trv::compute_corrfunc(
-        catalogue_data, catalogue_rand, los_data, los_rand,
-        params, binning, norm_factor
-      );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::io::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, catalogue_rand,
-        norm_factor_part, norm_factor_mesh, norm_factor_meshes
-      );
-    } else
-    if (params.catalogue_type == "sim") {
-      meas_2pcf = trv::compute_corrfunc_in_gpp_box(
-        catalogue_data, params, binning, norm_factor
-      );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::io::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data,
+
+    // -------------------------------------------------------------------
+    // B.5 Binning
+    // -------------------------------------------------------------------
+
+    if (trv::sys::currTask == 0) {
+      trv::sys::logger.stat("[B.5] Setting up binning...");
+    }
+
+    trv::Binning binning(params_stat);  // binning
+    binning.set_bins();
+
+    if (trv::sys::currTask == 0) {
+      trv::sys::logger.stat("[B.5] ... set up binning.");
+    }
+
+    // -------------------------------------------------------------------
+    // B.6 Normalisation
+    // -------------------------------------------------------------------
+
+    trv::ParticleCatalogue& catalogue_for_norm =
+      (flag_rand == "true") ? catalogue_rand : catalogue_data;
+    double alpha_for_norm = (flag_rand == "true") ? alpha : 1.;
+    double norm_factor_part = 0., norm_factor_mesh = 0.;
+    double norm_factor_meshes = 0.;
+    if (norm_factors_npoint.count(params_stat.npoint) > 0) {
+      norm_factor_part = norm_factors_npoint[params_stat.npoint][0];
+      norm_factor_mesh = norm_factors_npoint[params_stat.npoint][1];
+      norm_factor_meshes = norm_factors_npoint[params_stat.npoint][2];
+    } else {
+      if (params_stat.npoint == "2pt") {
+        norm_factor_part = trv::calc_powspec_normalisation_from_particles(
+          catalogue_for_norm, alpha_for_norm
+        );
+        if (norm_factors_mesh_unit.count(params_stat.npoint) == 0) {
+          norm_factors_mesh_unit[params_stat.npoint] =
+            trv::calc_powspec_normalisation_from_mesh(
+              catalogue_for_norm, params_stat, 1.
+            );
+        }
+        norm_factor_mesh = norm_factors_mesh_unit[params_stat.npoint]
+          / std::pow(alpha_for_norm, 2);
+        // Mixed-mesh normalisation is only implemented for
+        // paired survey-like catalogues.
+        if (params_stat.catalogue_type == "survey") {
+          // Use default parameters for mixed-mesh normalisation in `pypower`.
+          const double PADDING = 0.1;
+          const double CELLSIZE = 10.;
+          const std::string ASSIGNMENT = "cic";
+          // Box size for normalisation is internally set and as such,
+          // the current alignment of the catalogues is not applicable, but
+          // this should have no effect on the normalisation.
+          norm_factor_meshes = trv::calc_powspec_normalisation_from_meshes(
+            catalogue_data, catalogue_rand, params_stat, alpha,
+            PADDING, CELLSIZE, ASSIGNMENT
+          );
+        }
+      } else
+      if (params_stat.npoint == "3pt") {
+        norm_factor_part = trv::calc_bispec_normalisation_from_particles(
+          catalogue_for_norm, alpha_for_norm
+        );
+        if (norm_factors_mesh_unit.count(params_stat.npoint) == 0) {
+          norm_factors_mesh_unit[params_stat.npoint] =
+            trv::calc_bispec_normalisation_from_mesh(
+              catalogue_for_norm, params_stat, 1.
+            );
+        }
+        norm_factor_mesh = norm_factors_mesh_unit[params_stat.npoint]
+          / std::pow(alpha_for_norm, 3);
+      }
+
+      norm_factors_npoint[params_stat.npoint] = {
         norm_factor_part, norm_factor_mesh, norm_factor_meshes
-      );
+      };
     }
-    trv::io::print_measurement_datatab_to_file(
-      save_fileptr, params, meas_2pcf
-    );
-    std::fclose(save_fileptr);
-  } else
-  if (params.statistic_type == "2pcf-win") {
-    std::snprintf(
-      save_filepath, sizeof(save_filepath), "%s/xiw%d%s",
-      params.measurement_dir.c_str(), params.ELL, params.output_tag.c_str()
-    );
 
-    trv::TwoPCFWindowMeasurements meas_2pcf_win = trv::compute_corrfunc_window(
-      catalogue_rand, los_rand, params, binning, alpha, norm_factor
-    );  // two-point correlation function window
-    std::FILE* save_fileptr = std::fopen(save_filepath, "w");
-    trv::io::print_measurement_header_to_file(
-      save_fileptr, params, catalogue_rand,
-      norm_factor_part, norm_factor_mesh, norm_factor_meshes
-    );
-    trv::io::print_measurement_datatab_to_file(
-      save_fileptr, params, meas_2pcf_win
-    );
-    std::fclose(save_fileptr);
-  } else
-  if (params.statistic_type == "bispec") {
-    if (params.form == "full" || params.form == "diag") {
+    double norm_factor = 0.;
+    if (params_stat.npoint != "none") {
+      if (params_stat.norm_convention == "none") {
+        norm_factor = 1.;
+        if (trv::sys::currTask == 0) {
+          trv::sys::logger.info(
+            "Normalisation factors: "
+            "%.6e (particle), %.6e (mesh), %.6e (mesh-mixed) (none used).",
+            norm_factor_part, norm_factor_mesh, norm_factor_meshes
+          );
+        }
+      } else
+      if (params_stat.norm_convention == "particle") {
+        norm_factor = norm_factor_part;
+        if (trv::sys::currTask == 0) {
+          trv::sys::logger.info(
+            "Normalisation factors: "
+            "%.6e (particle; used), %.6e (mesh), %.6e (mesh-mixed).",
+            norm_factor, norm_factor_mesh, norm_factor_meshes
+          );
+        }
+      } else
+      if (params_stat.norm_convention == "mesh") {
+        norm_factor = norm_factor_mesh;
+        if (trv::sys::currTask == 0) {
+          trv::sys::logger.info(
+            "Normalisation factors: "
+            "%.6e (particle), %.6e (mesh; used), %.6e (mesh-mixed).",
+            norm_factor_part, norm_factor, norm_factor_meshes
+          );
+        }
+      } else
+      if (params_stat.norm_convention == "mesh-mixed") {
+        norm_factor = norm_factor_meshes;
+        if (trv::sys::currTask == 0) {
+          trv::sys::logger.info(
+            "Normalisation factors: "
+            "%.6e (particle), %.6e (mesh), %.6e (mesh-mixed; used).",
+            norm_factor_part, norm_factor_mesh, norm_factor
+          );
+        }
+      }
+    }
+
+    // -------------------------------------------------------------------
+    // B.7 Clustering algorithms
+    // -------------------------------------------------------------------
+
+    char save_filepath[1024];
+    if (params_stat.statistic_type == "powspec") {
       std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s/bk%d%d%d_%s%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL,
-        params.form.c_str(),
-        params.output_tag.c_str()
+        save_filepath, sizeof(save_filepath), "%s/pk%d%s",
+        params_stat.measurement_dir.c_str(), params_stat.ELL,
+        params_stat.output_tag.c_str()
       );
-    } else
-    if (params.form == "off-diag") {
-      std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s/bk%d%d%d_offdiag%d%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL, params.idx_bin,
-        params.output_tag.c_str()
+      std::FILE* save_fileptr = nullptr;
+      trv::PowspecMeasurements meas_powspec;  // power spectrum
+      if (params_stat.catalogue_type == "survey") {
+        meas_powspec = trv::compute_powspec(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          params_stat, binning, norm_factor, field_cache_ptr
+        );
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::io::print_measurement_header_to_file(
+          save_fileptr, params_stat, catalogue_data, catalogue_rand,
+          norm_factor_part, norm_factor_mesh, norm_factor_meshes
+        );
+      } else
+      if (params_stat.catalogue_type == "sim") {
+        meas_powspec = trv::compute_powspec_in_gpp_box(
+          catalogue_data, params_stat, binning, norm_factor, field_cache_ptr
+        );
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::io::print_measurement_header_to_file(
+          save_fileptr, params_stat, catalogue_data,
+          norm_factor_part, norm_factor_mesh, norm_factor_meshes
+        );
+      }
+      trv::io::print_measurement_datatab_to_file(
+        save_fileptr, params_stat, meas_powspec
       );
+      std::fclose(save_fileptr);
     } else
-    if (params.form == "row") {
+    if (params_stat.statistic_type == "2pcf") {
       std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s/bk%d%d%d_row%d%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL, params.idx_bin,
-        params.output_tag.c_str()
-      );
-    }
-    std::FILE* save_fileptr = nullptr;
-    trv::BispecMeasurements meas_bispec;  // bispectrum
-    if (params.catalogue_type == "survey") {
-      meas_bispec = trv::compute_bispec(
-        catalogue_data, catalogue_rand, los_data, los_rand,
-        params, binning, norm_factor
+        save_filepath, sizeof(save_filepath), "%s/xi%d%s",
+        params_stat.measurement_dir.c_str(), params_stat.ELL,
+        params_stat.output_tag.c_str()
       );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::io::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, catalogue_rand,
-        norm_factor_part, norm_factor_mesh, norm_factor_meshes
+      std::FILE* save_fileptr = nullptr;
+      trv::TwoPCFMeasurements meas_2pcf;  // two-point correlation function
+      if (params_stat.catalogue_type == "survey") {
+        meas_2pcf = trv::compute_corrfunc(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          params_stat, binning, norm_factor, field_cache_ptr
+        );
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::io::print_measurement_header_to_file(
+          save_fileptr, params_stat, catalogue_data, catalogue_rand,
+          norm_factor_part, norm_factor_mesh, norm_factor_meshes
+        );
+      } else
+      if (params_stat.catalogue_type == "sim") {
+        meas_2pcf = trv::compute_corrfunc_in_gpp_box(
+          catalogue_data, params_stat, binning, norm_factor, field_cache_ptr
+        );
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::io::print_measurement_header_to_file(
+          save_fileptr, params_stat, catalogue_data,
+          norm_factor_part, norm_factor_mesh, norm_factor_meshes
+        );
+      }
+      trv::io::print_measurement_datatab_to_file(
+        save_fileptr, params_stat, meas_2pcf
       );
+      std::fclose(save_fileptr);
     } else
-    if (params.catalogue_type == "sim") {
-      meas_bispec = trv::compute_bispec_in_gpp_box(
-        catalogue_data, params, binning, norm_factor
+    if (params_stat.statistic_type == "2pcf-win") {
+      std::snprintf(
+        save_filepath, sizeof(save_filepath), "%s/xiw%d%s",
+        params_stat.measurement_dir.c_str(), params_stat.ELL,
+        params_stat.output_tag.c_str()
       );
-      save_fileptr = std::fopen(save_filepath, "w");
+
+      trv::TwoPCFWindowMeasurements meas_2pcf_win =
+        trv::compute_corrfunc_window(
+          catalogue_rand, los_rand, params_stat, binning, alpha, norm_factor
+        );  // two-point correlation function window
+      std::FILE* save_fileptr = std::fopen(save_filepath, "w");
       trv::io::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data,
+        save_fileptr, params_stat, catalogue_rand,
         norm_factor_part, norm_factor_mesh, norm_factor_meshes
       );
-    }
-    trv::io::print_measurement_datatab_to_file(
-      save_fileptr, params, meas_bispec
-    );
-    std::fclose(save_fileptr);
-  } else
-  if (params.statistic_type == "3pcf") {
-    if (params.form == "full" || params.form == "diag") {
-      std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s/zeta%d%d%d_%s%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL,
-        params.form.c_str(),
-        params.output_tag.c_str()
+      trv::io::print_measurement_datatab_to_file(
+        save_fileptr, params_stat, meas_2pcf_win
       );
+      std::fclose(save_fileptr);
     } else
-    if (params.form == "off-diag") {
-      std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s/zeta%d%d%d_offdiag%d%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL, params.idx_bin,
-        params.output_tag.c_str()
+    if (params_stat.statistic_type == "bispec") {
+      if (params_stat.form == "full" || params_stat.form == "diag") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s/bk%d%d%d_%s%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.form.c_str(),
+          params_stat.output_tag.c_str()
+        );
+      } else
+      if (params_stat.form == "off-diag") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s/bk%d%d%d_offdiag%d%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.idx_bin,
+          params_stat.output_tag.c_str()
+        );
+      } else
+      if (params_stat.form == "row") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s/bk%d%d%d_row%d%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.idx_bin,
+          params_stat.output_tag.c_str()
+        );
+      }
+      std::FILE* save_fileptr = nullptr;
+      trv::BispecMeasurements meas_bispec;  // bispectrum
+      if (params_stat.catalogue_type == "survey") {
+        meas_bispec = trv::compute_bispec(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          params_stat, binning, norm_factor, field_cache_ptr
+        );
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::io::print_measurement_header_to_file(
+          save_fileptr, params_stat, catalogue_data, catalogue_rand,
+          norm_factor_part, norm_factor_mesh, norm_factor_meshes
+        );
+      } else
+      if (params_stat.catalogue_type == "sim") {
+        meas_bispec = trv::compute_bispec_in_gpp_box(
+          catalogue_data, params_stat, binning, norm_factor, field_cache_ptr
+        );
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::io::print_measurement_header_to_file(
+          save_fileptr, params_stat, catalogue_data,
+          norm_factor_part, norm_factor_mesh, norm_factor_meshes
+        );
+      }
+      trv::io::print_measurement_datatab_to_file(
+        save_fileptr, params_stat, meas_bispec
       );
+      std::fclose(save_fileptr);
     } else
-    if (params.form == "row") {
-      std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s/zeta%d%d%d_row%d%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL, params.idx_bin,
-        params.output_tag.c_str()
-      );
-    }
-    std::FILE* save_fileptr = nullptr;
-    trv::ThreePCFMeasurements meas_3pcf;  // three-point correlation function
-    if (params.catalogue_type == "survey") {
-      meas_3pcf = trv::compute_3pcf(
-        catalogue_data, catalogue_rand, los_data, los_rand,
-        params, binning, norm_factor
-      );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::io::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, catalogue_rand,
-        norm_factor_part, norm_factor_mesh, norm_factor_meshes
+    if (params_stat.statistic_type == "3pcf") {
+      if (params_stat.form == "full" || params_stat.form == "diag") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s/zeta%d%d%d_%s%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.form.c_str(),
+          params_stat.output_tag.c_str()
+        );
+      } else
+      if (params_stat.form == "off-diag") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s/zeta%d%d%d_offdiag%d%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.idx_bin,
+          params_stat.output_tag.c_str()
+        );
+      } else
+      if (params_stat.form == "row") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s/zeta%d%d%d_row%d%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.idx_bin,
+          params_stat.output_tag.c_str()
+        );
+      }
+      std::FILE* save_fileptr = nullptr;
+      trv::ThreePCFMeasurements meas_3pcf;  // three-point correlation function
+      if (params_stat.catalogue_type == "survey") {
+        meas_3pcf = trv::compute_3pcf(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          params_stat, binning, norm_factor, field_cache_ptr
+        );
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::io::print_measurement_header_to_file(
+          save_fileptr, params_stat, catalogue_data, catalogue_rand,
+          norm_factor_part, norm_factor_mesh, norm_factor_meshes
+        );
+      } else
+      if (params_stat.catalogue_type == "sim") {
+        meas_3pcf = trv::compute_3pcf_in_gpp_box(
+          catalogue_data, params_stat, binning, norm_factor, field_cache_ptr
+        );
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::io::print_measurement_header_to_file(
+          save_fileptr, params_stat, catalogue_data,
+          norm_factor_part, norm_factor_mesh, norm_factor_meshes
+        );
+      }
+      trv::io::print_measurement_datatab_to_file(
+        save_fileptr, params_stat, meas_3pcf
       );
+      std::fclose(save_fileptr);
     } else
-    if (params.catalogue_type == "sim") {
-      meas_3pcf = trv::compute_3pcf_in_gpp_box(
-        catalogue_data, params, binning, norm_factor
-      );
-      save_fileptr = std::fopen(save_filepath, "w");
+    if (params_stat.statistic_type == "3pcf-win") {
+      if (params_stat.form == "full" || params_stat.form == "diag") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s/zetaw%d%d%d_%s%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.form.c_str(),
+          params_stat.output_tag.c_str()
+        );
+      } else
+      if (params_stat.form == "off-diag") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s/zetaw%d%d%d_offdiag%d%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.idx_bin,
+          params_stat.output_tag.c_str()
+        );
+      } else
+      if (params_stat.form == "row") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s/zetaw%d%d%d_row%d%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.idx_bin,
+          params_stat.output_tag.c_str()
+        );
+      }
+      bool wa = false;
+
+      trv::ThreePCFWindowMeasurements meas_3pcf_win = trv::compute_3pcf_window(
+        catalogue_rand, los_rand, params_stat, binning, alpha, norm_factor, wa
+      );  // three-point correlation function window
+      std::FILE* save_fileptr = std::fopen(save_filepath, "w");
       trv::io::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data,
+        save_fileptr, params_stat, catalogue_rand,
         norm_factor_part, norm_factor_mesh, norm_factor_meshes
       );
-    }
-    trv::io::print_measurement_datatab_to_file(
-      save_fileptr, params, meas_3pcf
-    );
-    std::fclose(save_fileptr);
-  } else
-  if (params.statistic_type == "3pcf-win") {
-    if (params.form == "full" || params.form == "diag") {
-      std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s/zetaw%d%d%d_%s%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL,
-        params.form.c_str(),
-        params.output_tag.c_str()
+      trv::io::print_measurement_datatab_to_file(
+        save_fileptr, params_stat, meas_3pcf_win
       );
+      std::fclose(save_fileptr);
     } else
-    if (params.form == "off-diag") {
-      std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s/zetaw%d%d%d_offdiag%d%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL, params.idx_bin,
-        params.output_tag.c_str()
+    if (params_stat.statistic_type == "3pcf-win-wa") {
+      if (params_stat.form == "full" || params_stat.form == "diag") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s/zetaw%d%d%d_wa%d%d_%s%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.i_wa, params_stat.j_wa,
+          params_stat.form.c_str(),
+          params_stat.output_tag.c_str()
+        );
+      } else
+      if (params_stat.form == "off-diag") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath),
+          "%s/zetaw%d%d%d_wa%d%d_offdiag%d%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.i_wa, params_stat.j_wa,
+          params_stat.idx_bin,
+          params_stat.output_tag.c_str()
+        );
+      } else
+      if (params_stat.form == "row") {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s/zetaw%d%d%d_wa%d%d_row%d%s",
+          params_stat.measurement_dir.c_str(),
+          params_stat.ell1, params_stat.ell2, params_stat.ELL,
+          params_stat.i_wa, params_stat.j_wa,
+          params_stat.idx_bin,
+          params_stat.output_tag.c_str()
+        );
+      }
+
+      bool wa = true;
+
+      trv::ThreePCFWindowMeasurements meas_3pcf_win_wa =
+        trv::compute_3pcf_window(
+          catalogue_rand, los_rand, params_stat, binning, alpha, norm_factor, wa
+        );  // three-point correlation function window wide-angle corrections
+      std::FILE* save_fileptr = std::fopen(save_filepath, "w");
+      trv::io::print_measurement_header_to_file(
+        save_fileptr, params_stat, catalogue_rand,
+        norm_factor_part, norm_factor_mesh, norm_factor_meshes
       );
-    } else
-    if (params.form == "row") {
-      std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s/zetaw%d%d%d_row%d%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL, params.idx_bin,
-        params.output_tag.c_str()
+      trv::io::print_measurement_datatab_to_file(
+        save_fileptr, params_stat, meas_3pcf_win_wa
       );
+      std::fclose(save_fileptr);
     }
-    bool wa = false;
 
-    trv::ThreePCFWindowMeasurements meas_3pcf_win = trv::compute_3pcf_window(
-      catalogue_rand, los_rand, params, binning, alpha, norm_factor, wa
-    );  // three-point correlation function window
-    std::FILE* save_fileptr = std::fopen(save_filepath, "w");
-    trv::io::print_measurement_header_to_file(
-      save_fileptr, params, catalogue_rand,
-      norm_factor_part, norm_factor_mesh, norm_factor_meshes
-    );
-    trv::io::print_measurement_datatab_to_file(
-      save_fileptr, params, meas_3pcf_win
-    );
-    std::fclose(save_fileptr);
-  } else
-  if (params.statistic_type == "3pcf-win-wa") {
-    if (params.form == "full" || params.form == "diag") {
-      std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s/zetaw%d%d%d_wa%d%d_%s%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL, params.i_wa, params.j_wa,
-        params.form.c_str(),
-        params.output_tag.c_str()
-      );
-    } else
-    if (params.form == "off-diag") {
-      std::snprintf(
-        save_filepath, sizeof(save_filepath),
-        "%s/zetaw%d%d%d_wa%d%d_offdiag%d%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL, params.i_wa, params.j_wa,
-        params.idx_bin,
-        params.output_tag.c_str()
-      );
-    } else
-    if (params.form == "row") {
-      std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s/zetaw%d%d%d_wa%d%d_row%d%s",
-        params.measurement_dir.c_str(),
-        params.ell1, params.ell2, params.ELL, params.i_wa, params.j_wa,
-        params.idx_bin,
-        params.output_tag.c_str()
-      );
+    if (params_stat.save_binned_vectors != "") {
+      trv::FieldStats binning_meshgrid(params_stat, false);
+      trv::BinnedVectors binned_vectors =
+        binning_meshgrid.record_binned_vectors(
+          binning, params_stat.save_binned_vectors, true
+        );
+      if (
+        params_stat.statistic_type == "modes"
+        || params_stat.statistic_type == "pairs"
+      ) {
+        std::snprintf(
+          save_filepath, sizeof(save_filepath), "%s",
+          params_stat.save_binned_vectors.c_str()
+        );
+      }
     }
 
-    bool wa = true;
+    if (trv::sys::currTask == 0) {
+      trv::sys::logger.info("Measurements saved to %s.", save_filepath);
+    }
+
+    if (params.statistic_type == "plan") {
+      trv::MeasurementPlan::release_field_uses(params_stat, field_cache);
+    }
+  }
 
-    trv::ThreePCFWindowMeasurements meas_3pcf_win_wa =
-      trv::compute_3pcf_window(
-        catalogue_rand, los_rand, params, binning, alpha, norm_factor, wa
-      );  // three-point correlation function window wide-angle corrections
-    std::FILE* save_fileptr = std::fopen(save_filepath, "w");
-    trv::io::print_measurement_header_to_file(
-      save_fileptr, params, catalogue_rand,
-      norm_factor_part, norm_factor_mesh, norm_factor_meshes
+  if (params.statistic_type == "plan" && trv::sys::currTask == 0) {
+    trv::sys::logger.info(
+      "Mesh fields in measurement plan: %d computed, %d reused.",
+      field_cache.count_computed, field_cache.count_reused
     );
-    trv::io::print_measurement_datatab_to_file(
-      save_fileptr, params, meas_3pcf_win_wa
+  }
+  if (batch && trv::sys::currTask == 0) {
+    trv::sys::logger.info(
+      "Random-source mesh fields in batch: %d computed, %d reused.",
+      field_cache.count_rand_computed, field_cache.count_rand_reused
     );
-    std::fclose(save_fileptr);
   }
-
-  if (params.save_binned_vectors != "") {
-    trv::FieldStats binning_meshgrid(params, false);
-    trv::BinnedVectors binned_vectors = binning_meshgrid.record_binned_vectors(
-      binning, params.save_binned_vectors
+  if (persist && trv::sys::currTask == 0) {
+    trv::sys::logger.info(
+      "Random-source mesh fields in disk cache: %d loaded, %d computed.",
+      field_cache.count_rand_loaded, field_cache.count_rand_computed
     );
-    if (params.statistic_type == "modes" || params.statistic_type == "pairs") {
-      std::snprintf(
-        save_filepath, sizeof(save_filepath), "%s",
-        params.save_binned_vectors.c_str()
-      );
-    }
   }
 
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.info("Measurements saved to %s.", save_filepath);
-  }
+  field_cache.clear();
 
   // =====================================================================
   // C Finalisation
@@ -782,15 +981,21 @@ int main(int argc, char* argv[]) {
   catalogue_data.finalise_particles();
   catalogue_rand.finalise_particles();
 
-  if (los_data != nullptr) {
-    delete[] los_data; los_data = nullptr;
-  }
-  if (los_rand != nullptr) {
-    delete[] los_rand; los_rand = nullptr;
+  if (trv::sys::profiler.tracing) {
+    if (trv::sys::profiler.write_trace_to_file(params.profile_trace)) {
+      if (trv::sys::currTask == 0) {
+        trv::sys::logger.warn(
+          "Failed to write stage trace: %s.", params.profile_trace.c_str()
+        );
+      }
+    } else {
+      if (trv::sys::currTask == 0) {
+        trv::sys::logger.info(
+          "Stage trace saved to %s.", params.profile_trace.c_str()
+        );
+      }
+    }
   }
-  trv::sys::gbytesMem -= trv::sys::size_in_gb<struct trv::LineOfSight>(
-    (catalogue_data.ntotal + catalogue_rand.ntotal)
-  );
 
   if (trv::sys::count_fft > 0 || trv::sys::count_ifft > 0) {
     trv::sys::logger.info(
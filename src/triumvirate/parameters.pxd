@@ -19,6 +19,8 @@ cdef extern from "include/parameters.hpp":
         string rand_catalogue_file
         # string catalogue_columns
         string output_tag
+        string checkpoint_dir
+        string checkpoint_fields
 
         # -- Mesh sampling -----------------------------------------------
 
@@ -26,7 +28,7 @@ cdef extern from "include/parameters.hpp":
         int ngrid[3]
 
         double volume
-        int nmesh
+        long long nmesh
 
         string alignment
         string padscale
@@ -35,6 +37,7 @@ cdef extern from "include/parameters.hpp":
         string assignment
         string interlace
         int assignment_order
+        int interlace_order
 
         # -- Measurement -------------------------------------------------
 
@@ -45,6 +48,8 @@ cdef extern from "include/parameters.hpp":
 
         string form
         string norm_convention
+        string powspec_estimator
+        string crop_fourier
 
         string binning
 
@@ -64,6 +69,9 @@ cdef extern from "include/parameters.hpp":
         # -- Misc --------------------------------------------------------
 
         # string save_binned_vectors
+        string task_parallel
+        string pipeline
+        double memory_budget
         int verbose
 
         # ----------------------------------------------------------------
@@ -35,6 +35,8 @@ _TMPL_PARAM_DICT = {
     'tags': {
         'output': None,
     },
+    'checkpoint_dir': None,
+    'checkpoint_fields': None,
     'boxsize': {'x': None, 'y': None, 'z': None},
     'ngrid': {'x': None, 'y': None, 'z': None},
     'alignment': 'centre',
@@ -48,11 +50,16 @@ _TMPL_PARAM_DICT = {
     'wa_orders': {'i': None, 'j': None},
     'form': 'diag',
     'norm_convention': 'particle',
+    'powspec_estimator': None,
+    'crop_fourier': None,
     'binning': 'lin',
     'range': [None, None],
     'num_bins': None,
     'idx_bin': None,
     'save_binned_vectors': False,
+    'task_parallel': None,
+    'pipeline': None,
+    'memory_budget': None,
     'verbose': 20,
 }
 
@@ -204,6 +211,13 @@ cdef class ParameterSet:
         """
         self.__setitem__(name, value)
 
+    @property
+    def _nmesh(self):
+        """Mesh grid cell number as derived in C++.
+
+        """
+        return self.thisptr.nmesh
+
     def names(self):
         """Return the full set of top-level parameter names like
         :meth:`dict.keys`.
@@ -362,6 +376,15 @@ cdef class ParameterSet:
         except KeyError:
             self.thisptr.output_tag = ''.encode('utf-8')
 
+        if self._params.get('checkpoint_dir') is not None:
+            self.thisptr.checkpoint_dir = \
+                str(self._params['checkpoint_dir']).encode('utf-8')
+
+        if self._params.get('checkpoint_fields') is not None:
+            # possibly convert from bool
+            self.thisptr.checkpoint_fields = \
+                str(self._params['checkpoint_fields']).lower().encode('utf-8')
+
         # -- Mesh sampling -----------------------------------------------
 
         # Attribute numerical parameters.
@@ -399,7 +422,9 @@ cdef class ParameterSet:
 
         # Attribute derived parameters.
         self.thisptr.volume = np.prod(list(self._params['boxsize'].values()))
-        self.thisptr.nmesh = np.prod(list(self._params['ngrid'].values()))
+        self.thisptr.nmesh = np.prod(
+            list(self._params['ngrid'].values()), dtype=np.int64
+        )
 
         # -- Measurement -------------------------------------------------
 
@@ -460,6 +485,15 @@ cdef class ParameterSet:
             self.thisptr.norm_convention = \
                 self._params['norm_convention'].lower().encode('utf-8')
 
+        if self._params.get('powspec_estimator') is not None:
+            self.thisptr.powspec_estimator = \
+                self._params['powspec_estimator'].lower().encode('utf-8')
+
+        if self._params.get('crop_fourier') is not None:
+            # possibly convert from bool
+            self.thisptr.crop_fourier = \
+                str(self._params['crop_fourier']).lower().encode('utf-8')
+
         if self._params['binning'] is not None:
             self.thisptr.binning = \
                 self._params['binning'].lower().encode('utf-8')
@@ -477,6 +511,19 @@ cdef class ParameterSet:
 
         # -- Misc --------------------------------------------------------
 
+        if self._params.get('task_parallel') is not None:
+            # possibly convert from bool
+            self.thisptr.task_parallel = \
+                str(self._params['task_parallel']).lower().encode('utf-8')
+
+        if self._params.get('pipeline') is not None:
+            # possibly convert from bool
+            self.thisptr.pipeline = \
+                str(self._params['pipeline']).lower().encode('utf-8')
+
+        if self._params.get('memory_budget') is not None:
+            self.thisptr.memory_budget = float(self._params['memory_budget'])
+
         if self._params['verbose'] is None:
             self.thisptr.verbose = 20
         else:
@@ -507,7 +554,9 @@ cdef class ParameterSet:
         self._params['space'] = self.thisptr.space.decode('utf-8')
 
         _interlace = self.thisptr.interlace.decode('utf-8')
-        if _interlace.lower() == 'true':
+        if _interlace.lower() == 'true' and self.thisptr.interlace_order > 2:
+            self._params['interlace'] = self.thisptr.interlace_order
+        elif _interlace.lower() == 'true':
             self._params['interlace'] = True
         elif _interlace.lower() == 'false':
             self._params['interlace'] = False
@@ -599,7 +648,7 @@ def _modify_sampling_parameters(paramset, params_sampling=None,
         - 'ngrid': [int, int, int];
         - 'alignment': {'centre', 'pad'}
         - 'assignment': {'ngp', 'cic', 'tsc', 'pcs'};
-        - 'interlace': bool;
+        - 'interlace': bool or int;
 
         and exactly one of the following parameters only when 'alignment'
         is 'pad'---
@@ -145,13 +145,15 @@ void extrap_loglin(
     );
   }
 
+  // Floating-point exception flags are sticky, so they are only tested
+  // once after the loop.
   for (int i = 0; i < N_notch_left; i++) {
     a_ext[i] = a.front() * std::exp((i - N_notch_left) * dlna_left);
-    if (std::fetestexcept(FE_DIVBYZERO) || std::fetestexcept(FE_INVALID)) {
-      throw std::invalid_argument(
-        "NaN detected at lower-end log-linear extrapolation."
-      );
-    }
+  }
+  if (std::fetestexcept(FE_DIVBYZERO) || std::fetestexcept(FE_INVALID)) {
+    throw std::invalid_argument(
+      "NaN detected at lower-end log-linear extrapolation."
+    );
   }
 
   // Fill in the middle part.
@@ -169,11 +171,11 @@ void extrap_loglin(
 
   for (int i = N_notch_right; i < N_extrap; i++) {
     a_ext[i] = a.back() * std::exp((i - (N_notch_right - 1)) * dlna_right);
-    if (std::fetestexcept(FE_DIVBYZERO) || std::fetestexcept(FE_INVALID)) {
-      throw std::invalid_argument(
-        "NaN detected at upper-end log-linear extrapolation."
-      );
-    }
+  }
+  if (std::fetestexcept(FE_DIVBYZERO) || std::fetestexcept(FE_INVALID)) {
+    throw std::invalid_argument(
+      "NaN detected at upper-end log-linear extrapolation."
+    );
   }
 }
 
@@ -200,6 +202,104 @@ void extrap_pad(
   }
 }
 
+void extrap_by_option(
+  std::vector<double>& a, int N_ext, ExtrapOption extrap,
+  std::vector<double>& a_ext
+) {
+  switch (extrap) {
+    case ExtrapOption::LIN:
+      extrap_lin(a, N_ext, a_ext);
+      break;
+    case ExtrapOption::LOGLIN:
+      extrap_loglin(a, N_ext, a_ext);
+      break;
+    case ExtrapOption::PAD:
+      extrap_pad(a, N_ext, a.front(), a.back(), a_ext);
+      break;
+    default:
+      throw trvs::InvalidParameterError("Unsupported extrapolation option.");
+  }
+}
+
+void extrap2d_by_option(
+  const std::vector<double>& a, int nrow, int ncol,
+  int N_row_ext, int N_col_ext, ExtrapOption extrap,
+  std::vector<double>& a_ext
+) {
+  if (int(a.size()) != nrow * ncol) {
+    throw trvs::InvalidParameterError(
+      "The size of the 2-d array does not match its dimensions."
+    );
+  }
+  if (extrap == ExtrapOption::NONE) {
+    throw trvs::InvalidParameterError("Unsupported extrapolation option.");
+  }
+
+  int ncol_ext = ncol + 2 * N_row_ext;
+  int nrow_ext = nrow + 2 * N_col_ext;
+
+  a_ext.resize(std::size_t(nrow_ext) * ncol_ext);
+
+  // Extrapolate horizontally then vertically.  Exceptions are caught
+  // inside parallel regions and rethrown afterwards.
+  std::string err_mesg;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (int irow = 0; irow < nrow; irow++) {
+    std::vector<double> row(
+      a.begin() + std::size_t(irow) * ncol,
+      a.begin() + std::size_t(irow + 1) * ncol
+    );
+    std::vector<double> row_ext;
+    try {
+      extrap_by_option(row, N_row_ext, extrap, row_ext);
+    } catch (const std::exception& err) {
+#ifdef TRV_USE_OMP
+#pragma omp critical (extrap2d_error)
+#endif  // TRV_USE_OMP
+      err_mesg = err.what();
+      continue;
+    }
+    std::copy(
+      row_ext.begin(), row_ext.end(),
+      a_ext.begin() + std::size_t(irow + N_col_ext) * ncol_ext
+    );
+  }
+
+  if (!err_mesg.empty()) {
+    throw std::invalid_argument(err_mesg);
+  }
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (int icol = 0; icol < ncol_ext; icol++) {
+    std::vector<double> col(nrow);
+    for (int irow = 0; irow < nrow; irow++) {
+      col[irow] = a_ext[std::size_t(irow + N_col_ext) * ncol_ext + icol];
+    }
+    std::vector<double> col_ext;
+    try {
+      extrap_by_option(col, N_col_ext, extrap, col_ext);
+    } catch (const std::exception& err) {
+#ifdef TRV_USE_OMP
+#pragma omp critical (extrap2d_error)
+#endif  // TRV_USE_OMP
+      err_mesg = err.what();
+      continue;
+    }
+    for (int irow = 0; irow < nrow_ext; irow++) {
+      a_ext[std::size_t(irow) * ncol_ext + icol] = col_ext[irow];
+    }
+  }
+
+  if (!err_mesg.empty()) {
+    throw std::invalid_argument(err_mesg);
+  }
+}
+
 void extrap2d_lin(
   std::vector< std::vector<double> >& a,
   int N_row_ext, int N_col_ext,
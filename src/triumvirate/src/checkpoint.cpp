@@ -0,0 +1,311 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file checkpoint.cpp
+ * @authors Mike S Wang (https://github.com/MikeSWang)
+ *
+ */
+
+#include "checkpoint.hpp"
+#include "io.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace trvs = trv::sys;
+
+namespace trv {
+
+namespace {
+
+/// magic string of checkpoint state files
+const char CKPT_FILE_MAGIC[8] = "TRVCKPT";
+/// format version of checkpoint state files
+const int CKPT_FILE_VERSION = 1;
+
+}  // namespace
+
+// ***********************************************************************
+// Life cycle
+// ***********************************************************************
+
+TermCheckpoint::TermCheckpoint(
+  trv::ParameterSet& params,
+  std::vector<ParticleCatalogue*> catalogues,
+  const std::string variant
+) {
+  if (params.checkpoint_dir == "") {return;}
+
+  this->enabled = true;
+  this->with_fields = (params.checkpoint_fields == "true");
+
+  // Identify the measurement by everything the accumulated data vectors
+  // depend on (except the normalisation applied afterwards).
+  char key[1024];
+  std::snprintf(
+    key, sizeof(key),
+    "%s|%s|degrees=%d,%d,%d|wa=%d,%d|form=%s|idx_bin=%d"
+    "|binning=%s:%.17g:%.17g:%d|boxsize=%.17g,%.17g,%.17g|ngrid=%d,%d,%d"
+    "|assignment=%s|interlace=%s:%d"
+    "|alignment=%s|padscale=%s|padfactor=%.17g|crop_fourier=%s",
+    params.statistic_type.c_str(), variant.c_str(),
+    params.ell1, params.ell2, params.ELL, params.i_wa, params.j_wa,
+    params.form.c_str(), params.idx_bin,
+    params.binning.c_str(), params.bin_min, params.bin_max, params.num_bins,
+    params.boxsize[0], params.boxsize[1], params.boxsize[2],
+    params.ngrid[0], params.ngrid[1], params.ngrid[2],
+    params.assignment.c_str(), params.interlace.c_str(),
+    params.interlace_order,
+    params.alignment.c_str(), params.padscale.c_str(), params.padfactor,
+    params.crop_fourier.c_str()
+  );
+  this->key = key;
+  for (ParticleCatalogue* catalogue : catalogues) {
+    this->key += "|catalogue=" + catalogue->calc_content_hash();
+  }
+
+  trvs::make_write_dir(params.checkpoint_dir);
+
+  this->filepath = params.checkpoint_dir + "trvckpt_"
+    + trvs::format_data_hash(
+      trvs::update_data_hash(this->key.data(), this->key.size())
+    );
+}
+
+
+// ***********************************************************************
+// State
+// ***********************************************************************
+
+bool TermCheckpoint::is_enabled() {
+  return this->enabled;
+}
+
+void TermCheckpoint::attach(void* data, std::size_t nbytes) {
+  this->buffers.push_back(std::make_pair(data, nbytes));
+}
+
+int TermCheckpoint::resume() {
+  if (!this->enabled) {return 0;}
+
+  std::string filepath_state = this->filepath + ".state";
+  std::FILE* fileptr = std::fopen(filepath_state.c_str(), "rb");
+  if (fileptr == nullptr) {return 0;}
+
+  // Read into staging storage first so that attached buffers are
+  // unchanged unless the entire state is valid.
+  bool valid = true;
+
+  char magic[8];
+  int version = 0;
+  std::size_t key_len = 0;
+  valid = valid
+    && std::fread(magic, sizeof(magic), 1, fileptr) == 1
+    && std::memcmp(magic, CKPT_FILE_MAGIC, sizeof(magic)) == 0
+    && std::fread(&version, sizeof(version), 1, fileptr) == 1
+    && version == CKPT_FILE_VERSION
+    && std::fread(&key_len, sizeof(key_len), 1, fileptr) == 1
+    && key_len == this->key.size();
+
+  std::string key_saved(key_len, '\0');
+  valid = valid
+    && std::fread(&key_saved[0], 1, key_len, fileptr) == key_len
+    && key_saved == this->key;
+
+  int nterms = 0;
+  std::vector<int> terms_saved;
+  valid = valid
+    && std::fread(&nterms, sizeof(nterms), 1, fileptr) == 1
+    && nterms >= 0;
+  if (valid) {
+    terms_saved.resize(3 * nterms);
+    valid = std::fread(terms_saved.data(), sizeof(int), 3 * nterms, fileptr)
+      == static_cast<std::size_t>(3 * nterms);
+  }
+
+  std::vector< std::vector<char> > buffers_saved;
+  for (auto& buffer : this->buffers) {
+    if (!valid) {break;}
+    std::vector<char> buffer_saved(buffer.second);
+    valid = std::fread(buffer_saved.data(), 1, buffer.second, fileptr)
+      == buffer.second;
+    buffers_saved.push_back(std::move(buffer_saved));
+  }
+  valid = valid && std::fgetc(fileptr) == EOF;
+
+  std::fclose(fileptr);
+
+  if (!valid) {
+    if (trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Checkpoint state is invalid and discarded: %s.",
+        filepath_state.c_str()
+      );
+    }
+    return 0;
+  }
+
+  for (std::size_t ibuf = 0; ibuf < this->buffers.size(); ibuf++) {
+    std::memcpy(
+      this->buffers[ibuf].first, buffers_saved[ibuf].data(),
+      this->buffers[ibuf].second
+    );
+  }
+  this->terms.clear();
+  for (int iterm = 0; iterm < nterms; iterm++) {
+    this->terms.insert({
+      terms_saved[3*iterm], terms_saved[3*iterm + 1], terms_saved[3*iterm + 2]
+    });
+  }
+
+  if (trvs::currTask == 0) {
+    trvs::logger.info(
+      "Resumed from checkpoint with %d completed terms: %s.",
+      nterms, filepath_state.c_str()
+    );
+  }
+
+  return nterms;
+}
+
+bool TermCheckpoint::is_completed(int m1, int m2, int M) {
+  return this->terms.count({m1, m2, M}) > 0;
+}
+
+void TermCheckpoint::complete(int m1, int m2, int M) {
+  if (!this->enabled) {return;}
+
+  this->terms.insert({m1, m2, M});
+
+  if (this->save() != 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Failed to save checkpoint state: %s.state.", this->filepath.c_str()
+      );
+    }
+  }
+}
+
+void TermCheckpoint::finalise() {
+  if (!this->enabled) {return;}
+
+  std::remove((this->filepath + ".state").c_str());
+  for (const std::string& filepath_field : this->filepaths_fields) {
+    std::remove(filepath_field.c_str());
+  }
+  this->filepaths_fields.clear();
+}
+
+int TermCheckpoint::save() {
+  // Write to a temporary file first so that the previous state is
+  // kept intact if interrupted.
+  std::string filepath_state = this->filepath + ".state";
+  std::string filepath_tmp = filepath_state + ".tmp";
+  std::FILE* fileptr = std::fopen(filepath_tmp.c_str(), "wb");
+  if (fileptr == nullptr) {return 1;}
+
+  std::size_t key_len = this->key.size();
+  int nterms = static_cast<int>(this->terms.size());
+  std::vector<int> terms_flat;
+  for (const std::array<int, 3>& term : this->terms) {
+    terms_flat.insert(terms_flat.end(), term.begin(), term.end());
+  }
+
+  bool written =
+    std::fwrite(CKPT_FILE_MAGIC, sizeof(CKPT_FILE_MAGIC), 1, fileptr) == 1
+    && std::fwrite(&CKPT_FILE_VERSION, sizeof(int), 1, fileptr) == 1
+    && std::fwrite(&key_len, sizeof(key_len), 1, fileptr) == 1
+    && std::fwrite(this->key.data(), 1, key_len, fileptr) == key_len
+    && std::fwrite(&nterms, sizeof(nterms), 1, fileptr) == 1
+    && std::fwrite(terms_flat.data(), sizeof(int), 3 * nterms, fileptr)
+      == static_cast<std::size_t>(3 * nterms);
+  for (auto& buffer : this->buffers) {
+    written = written
+      && std::fwrite(buffer.first, 1, buffer.second, fileptr) == buffer.second;
+  }
+
+  if (std::fclose(fileptr) != 0 || !written) {
+    std::remove(filepath_tmp.c_str());
+    return 1;
+  }
+  if (std::rename(filepath_tmp.c_str(), filepath_state.c_str()) != 0) {
+    std::remove(filepath_tmp.c_str());
+    return 1;
+  }
+
+  return 0;
+}
+
+
+// ***********************************************************************
+// Fields
+// ***********************************************************************
+
+std::shared_ptr<MeshField> TermCheckpoint::restore_field(
+  trv::ParameterSet& params, const std::string label, const std::string name
+) {
+  if (!this->enabled || !this->with_fields) {return nullptr;}
+
+  std::string filepath_field = this->get_field_filepath(label);
+
+  std::FILE* fileptr = std::fopen(filepath_field.c_str(), "rb");
+  if (fileptr == nullptr) {return nullptr;}
+  std::fclose(fileptr);
+
+  std::shared_ptr<MeshField> field =
+    std::make_shared<MeshField>(params, true, name);
+  if (field->read_from_file(filepath_field, this->key + "|" + label) != 0) {
+    return nullptr;
+  }
+
+  this->filepaths_fields.insert(filepath_field);
+
+  if (trvs::currTask == 0) {
+    trvs::logger.info(
+      "Restored checkpointed field %s: %s.",
+      name.c_str(), filepath_field.c_str()
+    );
+  }
+
+  return field;
+}
+
+void TermCheckpoint::save_field(MeshField& field, const std::string label) {
+  if (!this->enabled || !this->with_fields) {return;}
+
+  std::string filepath_field = this->get_field_filepath(label);
+  if (field.write_to_file(filepath_field, this->key + "|" + label) != 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Failed to checkpoint field %s: %s.",
+        field.name.c_str(), filepath_field.c_str()
+      );
+    }
+    return;
+  }
+
+  this->filepaths_fields.insert(filepath_field);
+}
+
+std::string TermCheckpoint::get_field_filepath(const std::string label) {
+  return this->filepath + "_" + label + ".bin";
+}
+
+}  // namespace trv
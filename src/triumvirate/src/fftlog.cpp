@@ -34,6 +34,22 @@ namespace trv {
 
 namespace maths {
 
+namespace {
+
+/// key of cached FFTLog kernel coefficients: order, bias index,
+/// transform sample size, sample spacing and pivot value
+using KernelKey = std::tuple<double, double, int, double, double>;
+
+/// cached FFTLog kernel coefficients
+std::map<
+  KernelKey, std::shared_ptr<const std::vector< std::complex<double> >>
+> kernel_cache;
+
+/// mutex guarding the cached FFTLog kernel coefficients
+std::mutex kernel_cache_mutex;
+
+}  // namespace
+
 HankelTransform::HankelTransform(double mu, double q, bool threaded) {
   this->order = mu;
   this->bias = q;
@@ -42,21 +58,16 @@ HankelTransform::HankelTransform(double mu, double q, bool threaded) {
 }
 
 HankelTransform::~HankelTransform() {
+  this->destroy_batch_plans();
+
+  // FFTW cleanup is left to the caller as other threads may hold plans.
+  std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+
   fftw_destroy_plan(this->pre_plan);
   fftw_free(this->pre_buffer);
 
   fftw_destroy_plan(this->post_plan);
   fftw_free(this->post_buffer);
-
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  if (this->threaded) {
-    fftw_cleanup_threads();
-  } else {
-    fftw_cleanup();
-  }
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 }
 
 void HankelTransform::initialise(
@@ -146,6 +157,8 @@ void HankelTransform::initialise(
   // ----<
 
   // Initialise FFTW plans.
+  std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
   if (this->threaded) {
     fftw_init_threads();
@@ -222,6 +235,15 @@ std::vector< std::complex<double> > HankelTransform::compute_kernel_coeff() {
     );
   }
 
+  KernelKey key(mu, q, N_trans, dL, kr_c);
+  {
+    std::lock_guard<std::mutex> cache_lock(kernel_cache_mutex);
+    auto cached = kernel_cache.find(key);
+    if (cached != kernel_cache.end()) {
+      return *(cached->second);
+    }
+  }
+
   double x_p = (mu + 1. + q)/2.;
   double x_m = (mu + 1. - q)/2.;
   double x_eq = (mu + 1.)/2.;
@@ -263,6 +285,13 @@ std::vector< std::complex<double> > HankelTransform::compute_kernel_coeff() {
     u[N_trans/2] = u[N_trans/2].real() + trvm::M_I * 0.;
   }
 
+  {
+    std::lock_guard<std::mutex> cache_lock(kernel_cache_mutex);
+    kernel_cache.emplace(
+      key, std::make_shared<const std::vector< std::complex<double> >>(u)
+    );
+  }
+
   return u;
 }
 
@@ -296,21 +325,7 @@ void HankelTransform::biased_transform(
     }
 
     std::vector<double> a_trans_vec(N_trans);
-    switch (this->extrap) {
-      case trva::ExtrapOption::LIN:
-        trva::extrap_lin(a_vec, this->n_ext, a_trans_vec);
-        break;
-      case trva::ExtrapOption::LOGLIN:
-        trva::extrap_loglin(a_vec, this->n_ext, a_trans_vec);
-        break;
-      case trva::ExtrapOption::PAD:
-        trva::extrap_pad(
-          a_vec, this->n_ext, a_vec.front(), a_vec.back(), a_trans_vec
-        );
-        break;
-      default:
-        throw trvs::InvalidParameterError("Unsupported extrapolation option.");
-    }
+    trva::extrap_by_option(a_vec, this->n_ext, this->extrap, a_trans_vec);
 
     for (int j = 0; j < N_trans; j++) {
       this->pre_buffer[j][0] = a_trans_vec[j];
@@ -364,6 +379,150 @@ void HankelTransform::biased_transform(
   // ----<
 }
 
+void HankelTransform::biased_transform_batch(
+  int nbatch, const double* a, double* b
+) {
+  // STYLE: Standard naming convention is not followed below.
+  int N = this->nsamp;
+  int N_trans = this->nsamp_trans;
+  int N_spec = N_trans/2 + 1;
+
+  if (this->kernel.empty() || N <= 2 || N_trans <= 2) {
+    throw std::runtime_error(
+      "This instance of trv::maths::HankelTransform has not been "
+      "initialised with `initialise`."
+    );
+  }
+  if (nbatch <= 0) {
+    return;
+  }
+
+  // The batched plans and arrays are shared by calls on this instance,
+  // which may come from different threads (e.g. without the GIL).
+  std::lock_guard<std::mutex> batch_lock(this->batch_mutex);
+
+  if (nbatch != this->nbatch_plan) {
+    this->plan_batch(nbatch);
+  }
+
+  // Perform any extrapolation required.
+  std::string extrap_err;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for if(this->threaded)
+#endif  // TRV_USE_OMP
+  for (int ibatch = 0; ibatch < nbatch; ibatch++) {
+    const double* a_row = a + std::size_t(ibatch) * N;
+    double* buffer_row = this->batch_buffer + std::size_t(ibatch) * N_trans;
+    if (this->extrap == trva::ExtrapOption::NONE) {
+      std::memcpy(buffer_row, a_row, N * sizeof(double));
+    } else {
+      std::vector<double> a_vec(a_row, a_row + N);
+      std::vector<double> a_trans_vec(N_trans);
+      try {
+        trva::extrap_by_option(a_vec, this->n_ext, this->extrap, a_trans_vec);
+      } catch (const std::exception& err) {
+#ifdef TRV_USE_OMP
+#pragma omp critical (fftlog_batch_extrap)
+#endif  // TRV_USE_OMP
+        extrap_err = err.what();
+        continue;
+      }
+      std::memcpy(buffer_row, a_trans_vec.data(), N_trans * sizeof(double));
+    }
+  }
+
+  if (!extrap_err.empty()) {
+    throw std::invalid_argument(extrap_err);
+  }
+
+  // Compute the convolution b = a * u using FFT.  As both the
+  // pre-transform Fourier coefficients and the kernel are Hermitian,
+  // only non-negative frequencies are needed and the post-kernel forward
+  // FFT is the reflected backward real FFT.
+  fftw_execute(this->batch_pre_plan);
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(2) if(this->threaded)
+#endif  // TRV_USE_OMP
+  for (int ibatch = 0; ibatch < nbatch; ibatch++) {
+    for (int m = 0; m < N_spec; m++) {
+      // Divide by `N` to normalise the inverse DFT.
+      std::size_t idx = std::size_t(ibatch) * N_spec + m;
+      std::complex<double> a_(
+        this->batch_spectrum[idx][0], this->batch_spectrum[idx][1]
+      );
+      std::complex<double> b_ = a_ * this->kernel[m] / double(N_trans);
+      this->batch_spectrum[idx][0] = b_.real();
+      this->batch_spectrum[idx][1] = b_.imag();
+    }
+  }
+
+  fftw_execute(this->batch_post_plan);
+
+  // Reflect and trim any extrapolation.
+#ifdef TRV_USE_OMP
+#pragma omp parallel for if(this->threaded)
+#endif  // TRV_USE_OMP
+  for (int ibatch = 0; ibatch < nbatch; ibatch++) {
+    const double* buffer_row =
+      this->batch_buffer + std::size_t(ibatch) * N_trans;
+    double* b_row = b + std::size_t(ibatch) * N;
+    for (int j = 0; j < N; j++) {
+      b_row[j] = buffer_row[(N_trans - j - this->n_ext) % N_trans];
+    }
+  }
+}
+
+void HankelTransform::plan_batch(int nbatch) {
+  this->destroy_batch_plans();
+
+  int N_trans = this->nsamp_trans;
+  int N_spec = N_trans/2 + 1;
+
+  std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+  if (this->threaded) {
+    fftw_init_threads();
+    fftw_plan_with_nthreads(omp_get_max_threads());
+  }
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+
+  this->batch_buffer = fftw_alloc_real(std::size_t(nbatch) * N_trans);
+  this->batch_spectrum = fftw_alloc_complex(std::size_t(nbatch) * N_spec);
+
+  this->batch_pre_plan = fftw_plan_many_dft_r2c(
+    1, &N_trans, nbatch,
+    this->batch_buffer, nullptr, 1, N_trans,
+    this->batch_spectrum, nullptr, 1, N_spec,
+    FFTW_ESTIMATE
+  );
+  this->batch_post_plan = fftw_plan_many_dft_c2r(
+    1, &N_trans, nbatch,
+    this->batch_spectrum, nullptr, 1, N_spec,
+    this->batch_buffer, nullptr, 1, N_trans,
+    FFTW_ESTIMATE
+  );
+
+  this->nbatch_plan = nbatch;
+}
+
+void HankelTransform::destroy_batch_plans() {
+  if (this->nbatch_plan == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+
+  fftw_destroy_plan(this->batch_pre_plan);
+  fftw_destroy_plan(this->batch_post_plan);
+  fftw_free(this->batch_buffer); this->batch_buffer = nullptr;
+  fftw_free(this->batch_spectrum); this->batch_spectrum = nullptr;
+
+  this->nbatch_plan = 0;
+}
+
 SphericalBesselTransform::SphericalBesselTransform(
   int ell, int n, bool threaded
 ) : HankelTransform(ell + 1./2, double(n), threaded) {
@@ -436,6 +595,220 @@ void SphericalBesselTransform::transform_cosmological_multipole(
   }
 }
 
+DoubleSphericalBesselTransform::DoubleSphericalBesselTransform(
+  int ell1, int ell2, int n1, int n2, bool threaded
+) {
+  this->degrees[0] = ell1;
+  this->degrees[1] = ell2;
+  this->biases[0] = n1;
+  this->biases[1] = n2;
+
+  this->threaded = threaded;
+}
+
+void DoubleSphericalBesselTransform::initialise(
+  std::vector<double> sample_pts, double kr_c, bool lowring,
+  int extrap, double extrap_exp, bool extrap2d
+) {
+  this->nsamp = sample_pts.size();
+  this->extrap = trva::ExtrapOption(extrap);
+  this->extrap2d = extrap2d;
+
+  // Extend the sample points for any extrapolation, which is performed
+  // here rather than natively in the 1-d transforms.
+  std::vector<double> sample_pts_trans = sample_pts;
+  if (this->extrap != trva::ExtrapOption::NONE) {
+    if (this->nsamp % 2 != 0) {
+      throw trvs::InvalidParameterError(
+        "The number of sample points must be even for extrapolation."
+      );
+    }
+    int nsamp_trans = std::pow(
+      2, std::ceil(std::log2(extrap_exp * this->nsamp))
+    );
+    if (nsamp_trans < this->nsamp) {
+      throw trvs::InvalidParameterError(
+        "The sample size expansion factor results in a shrunken sample size."
+      );
+    }
+
+    this->n_ext = (nsamp_trans - this->nsamp) / 2;
+    trva::extrap_loglin(sample_pts, this->n_ext, sample_pts_trans);
+  } else {
+    this->n_ext = 0;
+  }
+  this->nsamp_trans = sample_pts_trans.size();
+
+  for (int idim = 0; idim < 2; idim++) {
+    this->transforms[idim].reset(new HankelTransform(
+      this->degrees[idim] + 1./2, double(this->biases[idim]),
+      this->threaded
+    ));
+    this->transforms[idim]->initialise(
+      sample_pts_trans, kr_c, lowring, trva::ExtrapOption::NONE
+    );
+
+    this->post_factors[idim].resize(this->nsamp_trans);
+    for (int j = 0; j < this->nsamp_trans; j++) {
+      this->post_factors[idim][j] = std::pow(
+        2*M_PI / this->transforms[idim]->post_sampts[j], 3./2
+      );
+    }
+  }
+
+  this->pre_sampts = sample_pts_trans;
+  this->pre_factors.resize(this->nsamp_trans);
+  for (int j = 0; j < this->nsamp_trans; j++) {
+    this->pre_factors[j] = std::pow(this->pre_sampts[j], 3./2);
+  }
+
+  this->logres = this->transforms[0]->logres;
+  this->pivot = this->transforms[0]->pivot;
+  this->post_sampts = std::vector<double>(
+    this->transforms[0]->post_sampts.begin() + this->n_ext,
+    this->transforms[0]->post_sampts.begin() + this->n_ext + this->nsamp
+  );
+}
+
+void DoubleSphericalBesselTransform::biased_transform(
+  const double* a, double* b
+) {
+  // STYLE: Standard naming convention is not followed below.
+  int N = this->nsamp;
+  int N_trans = this->nsamp_trans;
+  int N_ext = this->n_ext;
+
+  if (!this->transforms[0] || !this->transforms[1]) {
+    throw std::runtime_error(
+      "This instance of trv::maths::DoubleSphericalBesselTransform "
+      "has not been initialised with `initialise`."
+    );
+  }
+
+  // Perform any 2-d extrapolation.
+  const double* pre_samples = a;
+  int N_pass = N;
+  if (this->extrap != trva::ExtrapOption::NONE && this->extrap2d) {
+    trva::extrap2d_by_option(
+      std::vector<double>(a, a + std::size_t(N) * N), N, N, N_ext, N_ext,
+      this->extrap, this->ext_buffer
+    );
+    pre_samples = this->ext_buffer.data();
+    N_pass = N_trans;
+  }
+
+  // Transform along rows and then along columns, each pass transposing
+  // its output so that the result is in the original orientation.
+  std::size_t size_pass = std::size_t(N_pass) * N_pass;
+  if (this->inter_buffer.size() != size_pass) {
+    this->inter_buffer.resize(size_pass);
+  }
+  this->transform_rows(1, N_pass, pre_samples, this->inter_buffer.data());
+
+  if (N_pass == N) {
+    this->transform_rows(0, N_pass, this->inter_buffer.data(), b);
+    return;
+  }
+
+  if (this->ext_buffer.size() != size_pass) {
+    this->ext_buffer.resize(size_pass);
+  }
+  this->transform_rows(
+    0, N_pass, this->inter_buffer.data(), this->ext_buffer.data()
+  );
+
+  // Trim any 2-d extrapolation.
+#ifdef TRV_USE_OMP
+#pragma omp parallel for if(this->threaded)
+#endif  // TRV_USE_OMP
+  for (int i = 0; i < N; i++) {
+    std::memcpy(
+      b + std::size_t(i) * N,
+      this->ext_buffer.data() + std::size_t(i + N_ext) * N_pass + N_ext,
+      N * sizeof(double)
+    );
+  }
+}
+
+void DoubleSphericalBesselTransform::transform_rows(
+  int idim, int nrow, const double* in, double* out
+) {
+  // STYLE: Standard naming convention is not followed below.
+  int N = this->nsamp;
+  int N_trans = this->nsamp_trans;
+  int N_ext = this->n_ext;
+
+  // Rows are extrapolated in 1-d unless already extrapolated in 2-d.
+  bool extrap1d = this->extrap != trva::ExtrapOption::NONE
+    && !this->extrap2d;
+  int N_row = extrap1d ? N : N_trans;
+  int offset = extrap1d ? N_ext : 0;
+
+  std::size_t size_batch = std::size_t(nrow) * N_trans;
+  if (this->pre_buffer.size() != size_batch) {
+    this->pre_buffer.resize(size_batch);
+    this->post_buffer.resize(size_batch);
+  }
+
+  std::string extrap_err;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for if(this->threaded)
+#endif  // TRV_USE_OMP
+  for (int irow = 0; irow < nrow; irow++) {
+    const double* in_row = in + std::size_t(irow) * N_row;
+    double* pre_row = this->pre_buffer.data() + std::size_t(irow) * N_trans;
+    if (extrap1d) {
+      std::vector<double> row(in_row, in_row + N_row);
+      std::vector<double> row_ext;
+      try {
+        trva::extrap_by_option(row, N_ext, this->extrap, row_ext);
+      } catch (const std::exception& err) {
+#ifdef TRV_USE_OMP
+#pragma omp critical (fftlog_rows_extrap)
+#endif  // TRV_USE_OMP
+        extrap_err = err.what();
+        continue;
+      }
+      for (int j = 0; j < N_trans; j++) {
+        pre_row[j] = row_ext[j] * this->pre_factors[j];
+      }
+    } else {
+      for (int j = 0; j < N_trans; j++) {
+        pre_row[j] = in_row[j] * this->pre_factors[j];
+      }
+    }
+  }
+
+  if (!extrap_err.empty()) {
+    throw std::invalid_argument(extrap_err);
+  }
+
+  this->transforms[idim]->biased_transform_batch(
+    nrow, this->pre_buffer.data(), this->post_buffer.data()
+  );
+
+  // Trim any 1-d extrapolation and transpose in cache blocks.
+  const int block = 32;
+  const double* post_factors = this->post_factors[idim].data() + offset;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(2) if(this->threaded)
+#endif  // TRV_USE_OMP
+  for (int irow_b = 0; irow_b < nrow; irow_b += block) {
+    for (int j_b = 0; j_b < N_row; j_b += block) {
+      int irow_e = std::min(irow_b + block, nrow);
+      int j_e = std::min(j_b + block, N_row);
+      for (int j = j_b; j < j_e; j++) {
+        for (int irow = irow_b; irow < irow_e; irow++) {
+          out[std::size_t(j) * nrow + irow] = post_factors[j]
+            * this->post_buffer[std::size_t(irow) * N_trans + j + offset];
+        }
+      }
+    }
+  }
+}
+
 }  // namespace trv::maths
 
 }  // namespace trv
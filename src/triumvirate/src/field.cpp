@@ -26,6 +26,17 @@
 
 #include "field.hpp"
 
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
 namespace trvs = trv::sys;
 namespace trvm = trv::maths;
 
@@ -48,7 +59,7 @@ MeshField::MeshField(
 
   trvs::logger.reset_level(params.verbose);
 
-  // Initialise the field (and its shadow field if interlacing is used)
+  // Initialise the field (and its shadow fields if interlacing is used)
   // and increase allocated memory.
   this->field = fftw_alloc_complex(this->params.nmesh);
 
@@ -61,13 +72,23 @@ MeshField::MeshField(
     trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(this->params.nmesh);
     trvs::update_maxmem();
   }
+  if (this->params.interlace == "true" && this->params.interlace_order > 2) {
+    this->field_a = fftw_alloc_complex(this->params.nmesh);
+
+    trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(this->params.nmesh);
+    trvs::update_maxmem();
+  }
 
   this->reset_density_field();  // likely redundant but safe
 
   // Initialise FFTW plans.
   if (plan_ini) {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-    fftw_plan_with_nthreads(omp_get_max_threads());
+    // Fields constructed by worker threads (e.g. in task-parallel
+    // scheduling) use single-threaded plans.
+    fftw_plan_with_nthreads(omp_in_parallel() ? 1 : omp_get_max_threads());
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
     this->transform = fftw_plan_dft_3d(
@@ -88,6 +109,54 @@ MeshField::MeshField(
       );
     }
     this->plan_ini = true;
+
+    // Initialise batched 1-d plans for pruned transforms, which are
+    // executed over blocks of pencils by threads (if any) in parallel.
+    // CAVEAT: Discretionary choice of the block size, where block
+    // offsets preserve the SIMD alignment of the field arrays only if
+    // the block size is a multiple of 4.
+    for (int nblock : {8, 4, 2, 1}) {
+      if (this->params.ngrid[2] % nblock == 0) {
+        this->nblock_pruned = nblock;
+        break;
+      }
+    }
+    unsigned flags_pruned = (this->nblock_pruned % 4 == 0)
+      ? FFTW_MEASURE : FFTW_MEASURE | FFTW_UNALIGNED;
+
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+    fftw_plan_with_nthreads(1);
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+
+    const int stride_x = this->params.ngrid[1] * this->params.ngrid[2];
+    const int stride_y = this->params.ngrid[2];
+    for (int sign : {FFTW_FORWARD, FFTW_BACKWARD}) {
+      fftw_plan* plans = (sign == FFTW_FORWARD)
+        ? this->transform_pruned : this->inv_transform_pruned;
+      plans[0] = fftw_plan_many_dft(
+        1, &this->params.ngrid[0], this->nblock_pruned,
+        this->field, nullptr, stride_x, 1,
+        this->field, nullptr, stride_x, 1,
+        sign, flags_pruned
+      );
+      plans[1] = fftw_plan_many_dft(
+        1, &this->params.ngrid[1], this->nblock_pruned,
+        this->field, nullptr, stride_y, 1,
+        this->field, nullptr, stride_y, 1,
+        sign, flags_pruned
+      );
+      plans[2] = fftw_plan_many_dft(
+        1, &this->params.ngrid[2], this->params.ngrid[1],
+        this->field, nullptr, 1, this->params.ngrid[2],
+        this->field, nullptr, 1, this->params.ngrid[2],
+        sign, flags_pruned
+      );
+    }
+    this->plan_pruned = true;
+
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+    fftw_plan_with_nthreads(omp_in_parallel() ? 1 : omp_get_max_threads());
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
   }
 
   // Calculate grid sizes in configuration space.
@@ -116,7 +185,7 @@ MeshField::MeshField(
 
   trvs::logger.reset_level(params.verbose);
 
-  // Initialise the field (and its shadow field if interlacing is used)
+  // Initialise the field (and its shadow fields if interlacing is used)
   // and increase allocated memory.
   this->field = fftw_alloc_complex(this->params.nmesh);
 
@@ -129,6 +198,12 @@ MeshField::MeshField(
     trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(this->params.nmesh);
     trvs::update_maxmem();
   }
+  if (this->params.interlace == "true" && this->params.interlace_order > 2) {
+    this->field_a = fftw_alloc_complex(this->params.nmesh);
+
+    trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(this->params.nmesh);
+    trvs::update_maxmem();
+  }
 
   this->reset_density_field();  // likely redundant but safe
 
@@ -157,12 +232,20 @@ MeshField::MeshField(
 
 MeshField::~MeshField() {
   if (this->plan_ini) {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
     fftw_destroy_plan(this->transform);
     fftw_destroy_plan(this->inv_transform);
     if (this->params.interlace == "true") {
       fftw_destroy_plan(this->transform_s);
     }
   }
+  if (this->plan_pruned) {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      fftw_destroy_plan(this->transform_pruned[iaxis]);
+      fftw_destroy_plan(this->inv_transform_pruned[iaxis]);
+    }
+  }
 
   if (this->field != nullptr) {
     fftw_free(this->field); this->field = nullptr;
@@ -172,13 +255,17 @@ MeshField::~MeshField() {
     fftw_free(this->field_s); this->field_s = nullptr;
     trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(this->params.nmesh);
   }
+  if (this->field_a != nullptr) {
+    fftw_free(this->field_a); this->field_a = nullptr;
+    trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(this->params.nmesh);
+  }
 }
 
 void MeshField::reset_density_field() {
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
     this->field[gid][0] = 0.;
     this->field[gid][1] = 0.;
   }
@@ -186,11 +273,64 @@ void MeshField::reset_density_field() {
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-    for (int gid = 0; gid < this->params.nmesh; gid++) {
+    for (long long gid = 0; gid < this->params.nmesh; gid++) {
       this->field_s[gid][0] = 0.;
       this->field_s[gid][1] = 0.;
     }
   }
+  if (this->field_a != nullptr) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (long long gid = 0; gid < this->params.nmesh; gid++) {
+      this->field_a[gid][0] = 0.;
+      this->field_a[gid][1] = 0.;
+    }
+  }
+}
+
+double MeshField::get_size_in_gb(trv::ParameterSet& params) {
+  // Interlacing of order > 2 needs the stacked shadow fields
+  // in addition to the last shadow field.
+  int nfields = 1;
+  if (params.interlace == "true") {
+    nfields = (params.interlace_order > 2) ? 3 : 2;
+  }
+  return nfields * trvs::size_in_gb<fftw_complex>(params.nmesh);
+}
+
+trv::ParameterSet MeshField::get_cropped_params(
+  trv::ParameterSet& params, double k_max
+) {
+  // CAVEAT: Discretionary choice of FFT-friendly grid numbers as even
+  // numbers without prime factors greater than 7.
+  auto is_fft_friendly = [](int n) {
+    for (int p : {2, 3, 5, 7}) {
+      while (n % p == 0) {n /= p;}
+    }
+    return n == 1;
+  };
+
+  trv::ParameterSet params_crop = params;
+
+  params_crop.nmesh = 1;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    double dk = 2.*M_PI / params.boxsize[iaxis];
+    int nmax = int(k_max / dk);
+
+    int ngrid_crop = 4 * nmax + 2;
+    while (!is_fft_friendly(ngrid_crop)) {ngrid_crop += 2;}
+
+    params_crop.ngrid[iaxis] = std::min(ngrid_crop, params.ngrid[iaxis]);
+    params_crop.nmesh *= params_crop.ngrid[iaxis];
+  }
+
+  // Cropped fields are compensated and not interlaced.
+  params_crop.assignment_order = 0;
+  params_crop.interlace = "false";
+  params_crop.interlace_order = 1;
+
+  return params_crop;
 }
 
 
@@ -198,7 +338,9 @@ void MeshField::reset_density_field() {
 // Operators & reserved methods
 // -----------------------------------------------------------------------
 
-const fftw_complex& MeshField::operator[](int gid) {return this->field[gid];}
+const fftw_complex& MeshField::operator[](long long gid) {
+  return this->field[gid];
+}
 
 
 // -----------------------------------------------------------------------
@@ -206,8 +348,9 @@ const fftw_complex& MeshField::operator[](int gid) {return this->field[gid];}
 // -----------------------------------------------------------------------
 
 long long MeshField::ret_grid_index(int i, int j, int k) {
+  // Promote before multiplying to avoid 32-bit overflow on large meshes.
   long long idx_grid =
-    (i * this->params.ngrid[1] + j) * this->params.ngrid[2] + k;
+    ((long long)(i) * this->params.ngrid[1] + j) * this->params.ngrid[2] + k;
   return idx_grid;
 }
 
@@ -251,6 +394,12 @@ void MeshField::assign_weighted_field_to_mesh(
     );
   }
 
+  trvs::ScopedTimer timer(
+    "assignment",
+    trvs::size_in_gb<double>(4*particles.ntotal)
+    + MeshField::get_size_in_gb(this->params)
+  );
+
   for (int iaxis = 0; iaxis < 3; iaxis++) {
     double extent = particles.pos_max[iaxis] - particles.pos_min[iaxis];
     if (params.boxsize[iaxis] < extent) {
@@ -307,7 +456,7 @@ void MeshField::assign_weighted_field_to_mesh_ngp(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
     int ijk[order][3];     // grid index coordinates of covered grid cells
     double win[order][3];  // sampling window
     long long gid = 0;     // flattened grid cell index
@@ -315,7 +464,7 @@ void MeshField::assign_weighted_field_to_mesh_ngp(
     for (int iaxis = 0; iaxis < 3; iaxis++) {
       // Carefully set covered sampling window grid indices.
       double loc_grid = this->params.ngrid[iaxis] *
-        particles[pid].pos[iaxis] / this->params.boxsize[iaxis];
+        particles.pos[iaxis][pid] / this->params.boxsize[iaxis];
 
       int idx_grid = int(loc_grid);
       if (loc_grid - idx_grid >= 0.5) {
@@ -348,49 +497,56 @@ OMP_ATOMIC
     }
   }
 
-  // Perform interlacing if needed.
+  // Perform interlacing if needed, where each shadow field but the last
+  // is stacked in Fourier space once assigned.
   if (this->params.interlace == "true") {
+    for (int ishift = 1; ishift < this->params.interlace_order; ishift++) {
+      if (ishift > 1) {this->stack_shadow_field(ishift - 1);}
+
+      double shift = double(ishift) / this->params.interlace_order;
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-    for (int pid = 0; pid < particles.ntotal; pid++) {
-      int ijk[order][3];
-      double win[order][3];
-      long long gid = 0;
+      for (long long pid = 0; pid < particles.ntotal; pid++) {
+        int ijk[order][3];
+        double win[order][3];
+        long long gid = 0;
+
+        for (int iaxis = 0; iaxis < 3; iaxis++) {
+          // Apply the grid shift and impose the periodic boundary condition.
+          double loc_grid = this->params.ngrid[iaxis]
+            * particles.pos[iaxis][pid] / this->params.boxsize[iaxis] + shift;
+
+          if (loc_grid > this->params.ngrid[iaxis]) {
+            loc_grid -= this->params.ngrid[iaxis];
+          }
 
-      for (int iaxis = 0; iaxis < 3; iaxis++) {
-        // Apply a half-grid shift and impose the periodic boundary condition.
-        double loc_grid = this->params.ngrid[iaxis]
-          * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
+          int idx_grid = int(loc_grid);
+          if (loc_grid - idx_grid >= 0.5) {
+            idx_grid = (idx_grid == this->params.ngrid[iaxis] - 1)
+              ? 0 : idx_grid + 1;
+          }
 
-        if (loc_grid > this->params.ngrid[iaxis]) {
-          loc_grid -= this->params.ngrid[iaxis];
-        }
+          ijk[0][iaxis] = idx_grid;
 
-        int idx_grid = int(loc_grid);
-        if (loc_grid - idx_grid >= 0.5) {
-          idx_grid = (idx_grid == this->params.ngrid[iaxis] - 1)
-            ? 0 : idx_grid + 1;
+          win[0][iaxis] = 1.;
         }
 
-        ijk[0][iaxis] = idx_grid;
-
-        win[0][iaxis] = 1.;
-      }
-
-      for (int iloc = 0; iloc < order; iloc++) {
-        for (int jloc = 0; jloc < order; jloc++) {
-          for (int kloc = 0; kloc < order; kloc++) {
-            gid = this->ret_grid_index(
-              ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
-            );
-            if (0 <= gid && gid < this->params.nmesh) {
+        for (int iloc = 0; iloc < order; iloc++) {
+          for (int jloc = 0; jloc < order; jloc++) {
+            for (int kloc = 0; kloc < order; kloc++) {
+              gid = this->ret_grid_index(
+                ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
+              );
+              if (0 <= gid && gid < this->params.nmesh) {
 OMP_ATOMIC
-              this->field_s[gid][0] += inv_vol_cell
-                * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+                this->field_s[gid][0] += inv_vol_cell
+                  * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-              this->field_s[gid][1] += inv_vol_cell
-                * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+                this->field_s[gid][1] += inv_vol_cell
+                  * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+              }
             }
           }
         }
@@ -418,7 +574,7 @@ void MeshField::assign_weighted_field_to_mesh_cic(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
     int ijk[order][3];     // grid index coordinates of covered grid cells
     double win[order][3];  // sampling window
     long long gid = 0;     // flattened grid cell index
@@ -426,7 +582,7 @@ void MeshField::assign_weighted_field_to_mesh_cic(
     for (int iaxis = 0; iaxis < 3; iaxis++) {
       // Carefully set covered sampling window grid indices.
       double loc_grid = this->params.ngrid[iaxis]
-        * particles[pid].pos[iaxis] / this->params.boxsize[iaxis];
+        * particles.pos[iaxis][pid] / this->params.boxsize[iaxis];
 
       int idx_grid = int(loc_grid);
 
@@ -460,49 +616,56 @@ OMP_ATOMIC
     }
   }
 
-  // Perform interlacing if needed.
+  // Perform interlacing if needed, where each shadow field but the last
+  // is stacked in Fourier space once assigned.
   if (this->params.interlace == "true") {
+    for (int ishift = 1; ishift < this->params.interlace_order; ishift++) {
+      if (ishift > 1) {this->stack_shadow_field(ishift - 1);}
+
+      double shift = double(ishift) / this->params.interlace_order;
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-    for (int pid = 0; pid < particles.ntotal; pid++) {
-      int ijk[order][3];
-      double win[order][3];
-      long long gid = 0;
-
-      for (int iaxis = 0; iaxis < 3; iaxis++) {
-        // Apply a half-grid shift and impose the periodic boundary condition.
-        double loc_grid = this->params.ngrid[iaxis]
-          * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
-
-        if (loc_grid > this->params.ngrid[iaxis]) {
-          loc_grid -= this->params.ngrid[iaxis];
-        }
+      for (long long pid = 0; pid < particles.ntotal; pid++) {
+        int ijk[order][3];
+        double win[order][3];
+        long long gid = 0;
+
+        for (int iaxis = 0; iaxis < 3; iaxis++) {
+          // Apply the grid shift and impose the periodic boundary condition.
+          double loc_grid = this->params.ngrid[iaxis]
+            * particles.pos[iaxis][pid] / this->params.boxsize[iaxis] + shift;
+
+          if (loc_grid > this->params.ngrid[iaxis]) {
+            loc_grid -= this->params.ngrid[iaxis];
+          }
 
-        int idx_grid = int(loc_grid);
+          int idx_grid = int(loc_grid);
 
-        ijk[0][iaxis] = idx_grid;
-        ijk[1][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
-          ? 0 : idx_grid + 1;
+          ijk[0][iaxis] = idx_grid;
+          ijk[1][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
+            ? 0 : idx_grid + 1;
 
-        double s = loc_grid - idx_grid;
-        win[0][iaxis] = 1. - s;
-        win[1][iaxis] = s;
-      }
+          double s = loc_grid - idx_grid;
+          win[0][iaxis] = 1. - s;
+          win[1][iaxis] = s;
+        }
 
-      for (int iloc = 0; iloc < order; iloc++) {
-        for (int jloc = 0; jloc < order; jloc++) {
-          for (int kloc = 0; kloc < order; kloc++) {
-            gid = this->ret_grid_index(
-              ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
-            );
-            if (0 <= gid && gid < this->params.nmesh) {
+        for (int iloc = 0; iloc < order; iloc++) {
+          for (int jloc = 0; jloc < order; jloc++) {
+            for (int kloc = 0; kloc < order; kloc++) {
+              gid = this->ret_grid_index(
+                ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
+              );
+              if (0 <= gid && gid < this->params.nmesh) {
 OMP_ATOMIC
-              this->field_s[gid][0] += inv_vol_cell
-                * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+                this->field_s[gid][0] += inv_vol_cell
+                  * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-              this->field_s[gid][1] += inv_vol_cell
-                * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+                this->field_s[gid][1] += inv_vol_cell
+                  * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+              }
             }
           }
         }
@@ -529,7 +692,7 @@ void MeshField::assign_weighted_field_to_mesh_tsc(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
     int ijk[order][3];     // grid index coordinates of covered grid cells
     double win[order][3];  // sampling window
     long long gid = 0;     // flattened grid cell index
@@ -537,7 +700,7 @@ void MeshField::assign_weighted_field_to_mesh_tsc(
     for (int iaxis = 0; iaxis < 3; iaxis++) {
       // Carefully set covered sampling window grid indices.
       double loc_grid = this->params.ngrid[iaxis]
-        * particles[pid].pos[iaxis] / this->params.boxsize[iaxis];
+        * particles.pos[iaxis][pid] / this->params.boxsize[iaxis];
 
       int idx_grid = int(loc_grid);
 
@@ -589,68 +752,75 @@ OMP_ATOMIC
     }
   }
 
-  // Perform interlacing if needed.
+  // Perform interlacing if needed, where each shadow field but the last
+  // is stacked in Fourier space once assigned.
   if (this->params.interlace == "true") {
+    for (int ishift = 1; ishift < this->params.interlace_order; ishift++) {
+      if (ishift > 1) {this->stack_shadow_field(ishift - 1);}
+
+      double shift = double(ishift) / this->params.interlace_order;
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-    for (int pid = 0; pid < particles.ntotal; pid++) {
-      int ijk[order][3];
-      double win[order][3];
-      long long gid = 0;
-
-      for (int iaxis = 0; iaxis < 3; iaxis++) {
-        // Apply a half-grid shift and impose the periodic boundary condition.
-        double loc_grid = this->params.ngrid[iaxis]
-          * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
-
-        if (loc_grid > this->params.ngrid[iaxis]) {
-          loc_grid -= this->params.ngrid[iaxis];
-        }
-
-        int idx_grid = int(loc_grid);
-
-        if (loc_grid - idx_grid < 0.5) {
-          ijk[0][iaxis] = (idx_grid == 0)
-            ? this->params.ngrid[iaxis] - 1 : idx_grid - 1;
-          ijk[1][iaxis] = idx_grid;
-          ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
-            ? 0 : idx_grid + 1;
-        } else {
-          ijk[0][iaxis] = idx_grid;
-          ijk[1][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
-            ? 0 : ijk[0][iaxis] + 1;
-          ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
-            ? 0 : ijk[1][iaxis] + 1;
-        }
+      for (long long pid = 0; pid < particles.ntotal; pid++) {
+        int ijk[order][3];
+        double win[order][3];
+        long long gid = 0;
+
+        for (int iaxis = 0; iaxis < 3; iaxis++) {
+          // Apply the grid shift and impose the periodic boundary condition.
+          double loc_grid = this->params.ngrid[iaxis]
+            * particles.pos[iaxis][pid] / this->params.boxsize[iaxis] + shift;
+
+          if (loc_grid > this->params.ngrid[iaxis]) {
+            loc_grid -= this->params.ngrid[iaxis];
+          }
 
-        double s = loc_grid - idx_grid;
+          int idx_grid = int(loc_grid);
+
+          if (loc_grid - idx_grid < 0.5) {
+            ijk[0][iaxis] = (idx_grid == 0)
+              ? this->params.ngrid[iaxis] - 1 : idx_grid - 1;
+            ijk[1][iaxis] = idx_grid;
+            ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
+              ? 0 : idx_grid + 1;
+          } else {
+            ijk[0][iaxis] = idx_grid;
+            ijk[1][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
+              ? 0 : ijk[0][iaxis] + 1;
+            ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
+              ? 0 : ijk[1][iaxis] + 1;
+          }
 
-        if (s < 0.5) {
-          win[0][iaxis] = 1./2 * (1./2 - s) * (1./2 - s);
-          win[1][iaxis] = 3./4 - s * s;
-          win[2][iaxis] = 1./2 * (1./2 + s) * (1./2 + s);
-        } else {
-          s = 1 - s;
-          win[0][iaxis] = 1./2 * (1./2 + s) * (1./2 + s);
-          win[1][iaxis] = 3./4 - s * s;
-          win[2][iaxis] = 1./2 * (1./2 - s) * (1./2 - s);
+          double s = loc_grid - idx_grid;
+
+          if (s < 0.5) {
+            win[0][iaxis] = 1./2 * (1./2 - s) * (1./2 - s);
+            win[1][iaxis] = 3./4 - s * s;
+            win[2][iaxis] = 1./2 * (1./2 + s) * (1./2 + s);
+          } else {
+            s = 1 - s;
+            win[0][iaxis] = 1./2 * (1./2 + s) * (1./2 + s);
+            win[1][iaxis] = 3./4 - s * s;
+            win[2][iaxis] = 1./2 * (1./2 - s) * (1./2 - s);
+          }
         }
-      }
 
-      for (int iloc = 0; iloc < order; iloc++) {
-        for (int jloc = 0; jloc < order; jloc++) {
-          for (int kloc = 0; kloc < order; kloc++) {
-            gid = this->ret_grid_index(
-              ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
-            );
-            if (0 <= gid && gid < this->params.nmesh) {
+        for (int iloc = 0; iloc < order; iloc++) {
+          for (int jloc = 0; jloc < order; jloc++) {
+            for (int kloc = 0; kloc < order; kloc++) {
+              gid = this->ret_grid_index(
+                ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
+              );
+              if (0 <= gid && gid < this->params.nmesh) {
 OMP_ATOMIC
-              this->field_s[gid][0] += inv_vol_cell
-                * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+                this->field_s[gid][0] += inv_vol_cell
+                  * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-              this->field_s[gid][1] += inv_vol_cell
-                * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+                this->field_s[gid][1] += inv_vol_cell
+                  * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+              }
             }
           }
         }
@@ -677,7 +847,7 @@ void MeshField::assign_weighted_field_to_mesh_pcs(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
     int ijk[order][3];     // grid index coordinates of covered grid cells
     double win[order][3];  // sampling window
     long long gid = 0;     // flattened grid cell index
@@ -685,7 +855,7 @@ void MeshField::assign_weighted_field_to_mesh_pcs(
     for (int iaxis = 0; iaxis < 3; iaxis++) {
       // Carefully set covered sampling window grid indices.
       double loc_grid = this->params.ngrid[iaxis]
-        * particles[pid].pos[iaxis] / this->params.boxsize[iaxis];
+        * particles.pos[iaxis][pid] / this->params.boxsize[iaxis];
 
       int idx_grid = int(loc_grid);
 
@@ -727,57 +897,64 @@ OMP_ATOMIC
     }
   }
 
-  // Perform interlacing if needed.
+  // Perform interlacing if needed, where each shadow field but the last
+  // is stacked in Fourier space once assigned.
   if (this->params.interlace == "true") {
+    for (int ishift = 1; ishift < this->params.interlace_order; ishift++) {
+      if (ishift > 1) {this->stack_shadow_field(ishift - 1);}
+
+      double shift = double(ishift) / this->params.interlace_order;
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-    for (int pid = 0; pid < particles.ntotal; pid++) {
-      int ijk[order][3];
-      double win[order][3];
-      long long gid = 0;
+      for (long long pid = 0; pid < particles.ntotal; pid++) {
+        int ijk[order][3];
+        double win[order][3];
+        long long gid = 0;
+
+        for (int iaxis = 0; iaxis < 3; iaxis++) {
+          // Apply the grid shift and impose the periodic boundary condition.
+          double loc_grid = this->params.ngrid[iaxis]
+            * particles.pos[iaxis][pid] / this->params.boxsize[iaxis] + shift;
+
+          if (loc_grid > this->params.ngrid[iaxis]) {
+            loc_grid -= this->params.ngrid[iaxis];
+          }
 
-      for (int iaxis = 0; iaxis < 3; iaxis++) {
-        // Apply a half-grid shift and impose the periodic boundary condition.
-        double loc_grid = this->params.ngrid[iaxis]
-          * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
+          int idx_grid = int(loc_grid);
 
-        if (loc_grid > this->params.ngrid[iaxis]) {
-          loc_grid -= this->params.ngrid[iaxis];
+          ijk[0][iaxis] = (idx_grid == 0)
+            ? this->params.ngrid[iaxis] - 1 : idx_grid - 1;
+          ijk[1][iaxis] = idx_grid;
+          ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
+            ? 0 : idx_grid + 1;
+          ijk[3][iaxis] = (ijk[2][iaxis] == this->params.ngrid[iaxis] - 1)
+            ? 0 : ijk[2][iaxis] + 1;
+          double s = loc_grid - idx_grid;
+
+          win[0][iaxis] = 1./6 * (1. - s) * (1. - s) * (1. - s);
+          win[1][iaxis] = 1./6 * (4. - 6. * s * s + 3. * s * s * s);
+          win[2][iaxis] = 1./6 * (
+            4. - 6. * (1. - s) * (1. - s) + 3. * (1. - s) * (1. - s) * (1. - s)
+          );
+          win[3][iaxis] = 1./6 * s * s * s;
         }
 
-        int idx_grid = int(loc_grid);
-
-        ijk[0][iaxis] = (idx_grid == 0)
-          ? this->params.ngrid[iaxis] - 1 : idx_grid - 1;
-        ijk[1][iaxis] = idx_grid;
-        ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
-          ? 0 : idx_grid + 1;
-        ijk[3][iaxis] = (ijk[2][iaxis] == this->params.ngrid[iaxis] - 1)
-          ? 0 : ijk[2][iaxis] + 1;
-        double s = loc_grid - idx_grid;
-
-        win[0][iaxis] = 1./6 * (1. - s) * (1. - s) * (1. - s);
-        win[1][iaxis] = 1./6 * (4. - 6. * s * s + 3. * s * s * s);
-        win[2][iaxis] = 1./6 * (
-          4. - 6. * (1. - s) * (1. - s) + 3. * (1. - s) * (1. - s) * (1. - s)
-        );
-        win[3][iaxis] = 1./6 * s * s * s;
-      }
-
-      for (int iloc = 0; iloc < order; iloc++) {
-        for (int jloc = 0; jloc < order; jloc++) {
-          for (int kloc = 0; kloc < order; kloc++) {
-            gid = this->ret_grid_index(
-              ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
-            );
-            if (0 <= gid && gid < this->params.nmesh) {
+        for (int iloc = 0; iloc < order; iloc++) {
+          for (int jloc = 0; jloc < order; jloc++) {
+            for (int kloc = 0; kloc < order; kloc++) {
+              gid = this->ret_grid_index(
+                ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
+              );
+              if (0 <= gid && gid < this->params.nmesh) {
 OMP_ATOMIC
-              this->field_s[gid][0] += inv_vol_cell
-                * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+                this->field_s[gid][0] += inv_vol_cell
+                  * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-              this->field_s[gid][1] += inv_vol_cell
-                * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+                this->field_s[gid][1] += inv_vol_cell
+                  * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+              }
             }
           }
         }
@@ -821,7 +998,7 @@ void MeshField::compute_unweighted_field(ParticleCatalogue& particles) {
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
     unit_weight[pid][0] = 1.;
     unit_weight[pid][1] = 0.;
   }
@@ -844,7 +1021,7 @@ void MeshField::compute_unweighted_field_fluctuations_insitu(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
     this->field[gid][0] -= nbar;
     // this->field[gid][1] -= 0.; (unused)
   }
@@ -852,8 +1029,22 @@ void MeshField::compute_unweighted_field_fluctuations_insitu(
 
 void MeshField::compute_ylm_wgtd_field(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   double alpha, int ell, int m
+) {
+  // Compute the weighted random-source field.
+  MeshField field_rand(this->params, false, "`field_rand`");
+  field_rand.compute_ylm_wgtd_field(particles_rand, los_rand, 1., ell, m);
+
+  // Compute the weighted data-source field and subtract.
+  this->compute_ylm_wgtd_field(
+    particles_data, los_data, field_rand, alpha, ell, m
+  );
+}
+
+void MeshField::compute_ylm_wgtd_field(
+  ParticleCatalogue& particles_data, const LineOfSightPolicy& los_data,
+  MeshField& field_rand, double alpha, int ell, int m
 ) {
   fftw_complex* weight_kern = nullptr;
 
@@ -866,16 +1057,15 @@ void MeshField::compute_ylm_wgtd_field(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles_data.ntotal; pid++) {
-    double los_[3] = {
-      los_data[pid].pos[0], los_data[pid].pos[1], los_data[pid].pos[2]
-    };
+  for (long long pid = 0; pid < particles_data.ntotal; pid++) {
+    double los_[3];
+    los_data.eval(particles_data, pid, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
 
-    weight_kern[pid][0] = ylm.real() * particles_data[pid].w;
-    weight_kern[pid][1] = ylm.imag() * particles_data[pid].w;
+    weight_kern[pid][0] = ylm.real() * particles_data.w[pid];
+    weight_kern[pid][1] = ylm.imag() * particles_data.w[pid];
   }
 
   this->assign_weighted_field_to_mesh(particles_data, weight_kern);
@@ -884,39 +1074,11 @@ void MeshField::compute_ylm_wgtd_field(
 
   trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles_data.ntotal);
 
-  // Compute the weighted random-source field.
-  weight_kern = fftw_alloc_complex(particles_rand.ntotal);
-
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles_rand.ntotal);
-  trvs::update_maxmem();
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles_rand.ntotal; pid++) {
-    double los_[3] = {
-      los_rand[pid].pos[0], los_rand[pid].pos[1], los_rand[pid].pos[2]
-    };
-
-    std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-      calc_reduced_spherical_harmonic(ell, m, los_);
-
-    weight_kern[pid][0] = ylm.real() * particles_rand[pid].w;
-    weight_kern[pid][1] = ylm.imag() * particles_rand[pid].w;
-  }
-
-  MeshField field_rand(this->params, false, "`field_rand`");
-  field_rand.assign_weighted_field_to_mesh(particles_rand, weight_kern);
-
-  fftw_free(weight_kern); weight_kern = nullptr;
-
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles_rand.ntotal);
-
   // Subtract to compute fluctuations, i.e. δn_LM.
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
     this->field[gid][0] -= alpha * field_rand[gid][0];
     this->field[gid][1] -= alpha * field_rand[gid][1];
   }
@@ -925,15 +1087,24 @@ void MeshField::compute_ylm_wgtd_field(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-    for (int gid = 0; gid < this->params.nmesh; gid++) {
+    for (long long gid = 0; gid < this->params.nmesh; gid++) {
       this->field_s[gid][0] -= alpha * field_rand.field_s[gid][0];
       this->field_s[gid][1] -= alpha * field_rand.field_s[gid][1];
     }
   }
+  if (this->field_a != nullptr) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (long long gid = 0; gid < this->params.nmesh; gid++) {
+      this->field_a[gid][0] -= alpha * field_rand.field_a[gid][0];
+      this->field_a[gid][1] -= alpha * field_rand.field_a[gid][1];
+    }
+  }
 }
 
 void MeshField::compute_ylm_wgtd_field(
-  ParticleCatalogue& particles, LineOfSight* los,
+  ParticleCatalogue& particles, const LineOfSightPolicy& los,
   double alpha, int ell, int m
 ) {
   fftw_complex* weight_kern = nullptr;
@@ -947,14 +1118,16 @@ void MeshField::compute_ylm_wgtd_field(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    double los_[3] = {los[pid].pos[0], los[pid].pos[1], los[pid].pos[2]};
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
+    double los_[3];
+
+    los.eval(particles, pid, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
 
-    weight_kern[pid][0] = ylm.real() * particles[pid].w;
-    weight_kern[pid][1] = ylm.imag() * particles[pid].w;
+    weight_kern[pid][0] = ylm.real() * particles.w[pid];
+    weight_kern[pid][1] = ylm.imag() * particles.w[pid];
   }
 
   this->assign_weighted_field_to_mesh(particles, weight_kern);
@@ -967,7 +1140,7 @@ void MeshField::compute_ylm_wgtd_field(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
     this->field[gid][0] *= alpha;
     this->field[gid][1] *= alpha;
   }
@@ -975,9 +1148,25 @@ void MeshField::compute_ylm_wgtd_field(
 
 void MeshField::compute_ylm_wgtd_quad_field(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   double alpha,
   int ell, int m
+) {
+  // Compute the quadratic weighted random-source field.
+  MeshField field_rand(this->params, false, "`field_rand`");
+  field_rand.compute_ylm_wgtd_quad_field(
+    particles_rand, los_rand, 1., ell, m
+  );
+
+  // Compute the quadratic weighted data-source field and add.
+  this->compute_ylm_wgtd_quad_field(
+    particles_data, los_data, field_rand, alpha, ell, m
+  );
+}
+
+void MeshField::compute_ylm_wgtd_quad_field(
+  ParticleCatalogue& particles_data, const LineOfSightPolicy& los_data,
+  MeshField& field_rand, double alpha, int ell, int m
 ) {
   fftw_complex* weight_kern = nullptr;
 
@@ -990,18 +1179,17 @@ void MeshField::compute_ylm_wgtd_quad_field(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles_data.ntotal; pid++) {
-    double los_[3] = {
-      los_data[pid].pos[0], los_data[pid].pos[1], los_data[pid].pos[2]
-    };
+  for (long long pid = 0; pid < particles_data.ntotal; pid++) {
+    double los_[3];
+    los_data.eval(particles_data, pid, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
 
     ylm = std::conj(ylm);  // additional conjugation
 
-    weight_kern[pid][0] = ylm.real() * std::pow(particles_data[pid].w, 2);
-    weight_kern[pid][1] = ylm.imag() * std::pow(particles_data[pid].w, 2);
+    weight_kern[pid][0] = ylm.real() * std::pow(particles_data.w[pid], 2);
+    weight_kern[pid][1] = ylm.imag() * std::pow(particles_data.w[pid], 2);
   }
 
   this->assign_weighted_field_to_mesh(particles_data, weight_kern);
@@ -1010,63 +1198,136 @@ void MeshField::compute_ylm_wgtd_quad_field(
 
   trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles_data.ntotal);
 
-  // Compute the quadratic weighted random-source field.
-  weight_kern = fftw_alloc_complex(particles_rand.ntotal);
+  // Add to compute quadratic fluctuations, i.e. N_LM.
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
+    this->field[gid][0] += std::pow(alpha, 2) * field_rand[gid][0];
+    this->field[gid][1] += std::pow(alpha, 2) * field_rand[gid][1];
+  }
+
+  if (this->params.interlace == "true") {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (long long gid = 0; gid < this->params.nmesh; gid++) {
+      this->field_s[gid][0] += std::pow(alpha, 2) * field_rand.field_s[gid][0];
+      this->field_s[gid][1] += std::pow(alpha, 2) * field_rand.field_s[gid][1];
+    }
+  }
+  if (this->field_a != nullptr) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (long long gid = 0; gid < this->params.nmesh; gid++) {
+      this->field_a[gid][0] += std::pow(alpha, 2) * field_rand.field_a[gid][0];
+      this->field_a[gid][1] += std::pow(alpha, 2) * field_rand.field_a[gid][1];
+    }
+  }
+}
+
+void MeshField::compute_ylm_wgtd_quad_field(
+  ParticleCatalogue& particles, const LineOfSightPolicy& los,
+  double alpha, int ell, int m
+) {
+  fftw_complex* weight_kern = nullptr;
 
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles_rand.ntotal);
+  // Compute the quadratic weighted field.
+  weight_kern = fftw_alloc_complex(particles.ntotal);
+
+  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles.ntotal);
   trvs::update_maxmem();
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles_rand.ntotal; pid++) {
-    double los_[3] = {
-      los_rand[pid].pos[0], los_rand[pid].pos[1], los_rand[pid].pos[2]
-    };
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
+    double los_[3];
+
+    los.eval(particles, pid, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
 
-    ylm = std::conj(ylm);  // additional conjugation
+    ylm = std::conj(ylm);  // conjugation is essential
 
-    weight_kern[pid][0] = ylm.real() * std::pow(particles_rand[pid].w, 2);
-    weight_kern[pid][1] = ylm.imag() * std::pow(particles_rand[pid].w, 2);
+    weight_kern[pid][0] = ylm.real() * std::pow(particles.w[pid], 2);
+    weight_kern[pid][1] = ylm.imag() * std::pow(particles.w[pid], 2);
   }
 
-  MeshField field_rand(this->params, false, "`field_rand`");
-  field_rand.assign_weighted_field_to_mesh(particles_rand, weight_kern);
+  this->assign_weighted_field_to_mesh(particles, weight_kern);
 
   fftw_free(weight_kern); weight_kern = nullptr;
 
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles_rand.ntotal);
+  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles.ntotal);
 
-  // Add to compute quadratic fluctuations, i.e. N_LM.
+  // Apply mean-density matching normalisation (i.e. alpha contrast)
+  // to compute N_LM.
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
-    this->field[gid][0] += std::pow(alpha, 2) * field_rand[gid][0];
-    this->field[gid][1] += std::pow(alpha, 2) * field_rand[gid][1];
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
+    this->field[gid][0] *= std::pow(alpha, 2);
+    this->field[gid][1] *= std::pow(alpha, 2);
+  }
+}
+
+
+void MeshField::compute_los_moment_wgtd_field(
+  ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+  double alpha, const trvm::CartesianMomentCalculator& moment_calc,
+  int idx_a, int idx_b
+) {
+  // Compute the weighted random-source field.
+  MeshField field_rand(this->params, false, "`field_rand`");
+  field_rand.compute_los_moment_wgtd_field(
+    particles_rand, los_rand, 1., moment_calc, idx_a, idx_b
+  );
+
+  // Compute the weighted data-source field.
+  this->compute_los_moment_wgtd_field(
+    particles_data, los_data, 1., moment_calc, idx_a, idx_b
+  );
+
+  // Subtract to compute fluctuations, i.e. δn_a + i δn_b.
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
+    this->field[gid][0] -= alpha * field_rand[gid][0];
+    this->field[gid][1] -= alpha * field_rand[gid][1];
   }
 
   if (this->params.interlace == "true") {
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-    for (int gid = 0; gid < this->params.nmesh; gid++) {
-      this->field_s[gid][0] += std::pow(alpha, 2) * field_rand.field_s[gid][0];
-      this->field_s[gid][1] += std::pow(alpha, 2) * field_rand.field_s[gid][1];
+    for (long long gid = 0; gid < this->params.nmesh; gid++) {
+      this->field_s[gid][0] -= alpha * field_rand.field_s[gid][0];
+      this->field_s[gid][1] -= alpha * field_rand.field_s[gid][1];
+    }
+  }
+  if (this->field_a != nullptr) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (long long gid = 0; gid < this->params.nmesh; gid++) {
+      this->field_a[gid][0] -= alpha * field_rand.field_a[gid][0];
+      this->field_a[gid][1] -= alpha * field_rand.field_a[gid][1];
     }
   }
 }
 
-void MeshField::compute_ylm_wgtd_quad_field(
-  ParticleCatalogue& particles, LineOfSight* los,
-  double alpha, int ell, int m
+void MeshField::compute_los_moment_wgtd_field(
+  ParticleCatalogue& particles, const LineOfSightPolicy& los,
+  double alpha, const trvm::CartesianMomentCalculator& moment_calc,
+  int idx_a, int idx_b
 ) {
   fftw_complex* weight_kern = nullptr;
 
-  // Compute the quadratic weighted field.
+  // Compute the weighted field.
   weight_kern = fftw_alloc_complex(particles.ntotal);
 
   trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles.ntotal);
@@ -1075,16 +1336,17 @@ void MeshField::compute_ylm_wgtd_quad_field(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    double los_[3] = {los[pid].pos[0], los[pid].pos[1], los[pid].pos[2]};
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
+    double los_[3];
 
-    std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-      calc_reduced_spherical_harmonic(ell, m, los_);
+    los.eval(particles, pid, los_);
 
-    ylm = std::conj(ylm);  // conjugation is essential
+    double moments_[2*trvm::CartesianMomentCalculator::ell_max + 1];
+    moment_calc.calc_los_moments(los_, moments_);
 
-    weight_kern[pid][0] = ylm.real() * std::pow(particles[pid].w, 2);
-    weight_kern[pid][1] = ylm.imag() * std::pow(particles[pid].w, 2);
+    weight_kern[pid][0] = moments_[idx_a] * particles.w[pid];
+    weight_kern[pid][1] =
+      (idx_b < 0) ? 0. : moments_[idx_b] * particles.w[pid];
   }
 
   this->assign_weighted_field_to_mesh(particles, weight_kern);
@@ -1093,63 +1355,76 @@ void MeshField::compute_ylm_wgtd_quad_field(
 
   trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles.ntotal);
 
-  // Apply mean-density matching normalisation (i.e. alpha contrast)
-  // to compute N_LM.
+  // Apply the normalising alpha contrast.
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
-    this->field[gid][0] *= std::pow(alpha, 2);
-    this->field[gid][1] *= std::pow(alpha, 2);
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
+    this->field[gid][0] *= alpha;
+    this->field[gid][1] *= alpha;
   }
 }
 
-
 // -----------------------------------------------------------------------
 // Field transforms
 // -----------------------------------------------------------------------
 
-void MeshField::fourier_transform() {
+void MeshField::fourier_transform(double k_max) {
   if (trvs::currTask == 0) {
     trvs::logger.debug(
       "Performing Fourier transform of %s.", this->name.c_str()
     );
   }
 
+  trvs::ScopedTimer timer(
+    "fft", 2 * MeshField::get_size_in_gb(this->params)
+  );
+
   // Apply FFT volume normalisation, where ∫d³x ↔ dV Σᵢ, dV =: `vol_cell`.
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
     this->field[gid][0] *= this->vol_cell;
     this->field[gid][1] *= this->vol_cell;
   }
 
-  // Perform FFT.
-  if (this->plan_ext) {
-    fftw_execute_dft(this->transform, this->field, this->field);
-  } else {
-    fftw_execute(this->transform);
+  // Perform FFT (pruned if possible).
+  if (!this->execute_pruned_transform(this->field, FFTW_FORWARD, k_max)) {
+    if (this->plan_ext) {
+      fftw_execute_dft(this->transform, this->field, this->field);
+    } else {
+      fftw_execute(this->transform);
+    }
   }
   trvs::count_fft += 1;
 
-  // Interlace with the shadow field.
+  // Interlace with the shadow fields.
   if (this->params.interlace == "true") {
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-    for (int gid = 0; gid < this->params.nmesh; gid++) {
+    for (long long gid = 0; gid < this->params.nmesh; gid++) {
       this->field_s[gid][0] *= this->vol_cell;
       this->field_s[gid][1] *= this->vol_cell;
     }
 
-    if (this->plan_ext) {
-      fftw_execute_dft(this->transform_s, this->field_s, this->field_s);
-    } else {
-      fftw_execute(this->transform_s);
+    if (!this->execute_pruned_transform(
+      this->field_s, FFTW_FORWARD, k_max
+    )) {
+      if (this->plan_ext) {
+        fftw_execute_dft(this->transform_s, this->field_s, this->field_s);
+      } else {
+        fftw_execute(this->transform_s);
+      }
     }
     trvs::count_fft += 1;
 
+    // The last shadow field is shifted by (N - 1)/N of the grid cell
+    // size for interlacing of order N.
+    const int order = this->params.interlace_order;
+    const double shift = double(order - 1) / order;
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for collapse(3)
 #endif  // TRV_USE_OMP
@@ -1170,10 +1445,10 @@ void MeshField::fourier_transform() {
             ? double(k) / this->params.ngrid[2]
             : double(k) / this->params.ngrid[2] - 1;
 
-          // Multiply by the phase factor from the half-grid shift and
+          // Multiply by the phase factor from the grid shift and
           // add the shadow mesh field contribution.  Note the positive
           // sign of `arg`.
-          double arg = M_PI * (m[0] + m[1] + m[2]);
+          double arg = 2.*M_PI * shift * (m[0] + m[1] + m[2]);
 
           this->field[idx_grid][0] +=
             std::cos(arg) * this->field_s[idx_grid][0]
@@ -1184,8 +1459,17 @@ void MeshField::fourier_transform() {
             + std::cos(arg) * this->field_s[idx_grid][1]
           ;
 
-          this->field[idx_grid][0] /= 2.;
-          this->field[idx_grid][1] /= 2.;
+          // Add the stacked shadow field contributions (with the FFT
+          // volume normalisation deferred till now).
+          if (this->field_a != nullptr) {
+            this->field[idx_grid][0] +=
+              this->vol_cell * this->field_a[idx_grid][0];
+            this->field[idx_grid][1] +=
+              this->vol_cell * this->field_a[idx_grid][1];
+          }
+
+          this->field[idx_grid][0] /= order;
+          this->field[idx_grid][1] /= order;
         }
       }
     }
@@ -1199,12 +1483,16 @@ void MeshField::inv_fourier_transform() {
     );
   }
 
+  trvs::ScopedTimer timer(
+    "fft", trvs::size_in_gb<fftw_complex>(2*this->params.nmesh)
+  );
+
   // Apply inverse FFT volume normalisation, where ∫d³k/(2π)³ ↔ (1/V) Σᵢ,
   // V =: `vol`.
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
     this->field[gid][0] /= this->vol;
     this->field[gid][1] /= this->vol;
   }
@@ -1218,6 +1506,196 @@ void MeshField::inv_fourier_transform() {
   trvs::count_ifft += 1;
 }
 
+bool MeshField::execute_pruned_transform(
+  fftw_complex* field_arr, int sign, double k_max
+) {
+  if (!this->plan_pruned || k_max <= 0.) {return false;}
+
+  const int ni = this->params.ngrid[0];
+  const int nj = this->params.ngrid[1];
+  const int nk = this->params.ngrid[2];
+  const int nblock = this->nblock_pruned;
+  const int nblocks_k = nk / nblock;
+  const long long njk = (long long)(nj) * nk;
+
+  // CAVEAT: Discretionary choice of a margin of one fundamental
+  // wavenumber against round-off errors.
+  double k_prune = k_max + std::max({this->dk[0], this->dk[1], this->dk[2]});
+  double k_prune_sq = k_prune * k_prune;
+
+  // Mark blocks of pencils along the x-axis (indexed by (j, k) blocks)
+  // and the y-axis (indexed by k blocks) which reach inside the sphere.
+  std::vector<char> active_jk(nj * nblocks_k, 0);
+  std::vector<int> blocks_k;
+  for (int kblock = 0; kblock < nblocks_k; kblock++) {
+    bool active_k = false;
+    for (int j = 0; j < nj; j++) {
+      for (int k = kblock * nblock; k < (kblock + 1) * nblock; k++) {
+        double kv[3];
+        this->get_grid_wavevector(0, j, k, kv);
+        if (kv[1] * kv[1] + kv[2] * kv[2] <= k_prune_sq) {
+          active_jk[j * nblocks_k + kblock] = 1;
+          active_k = true;
+        }
+      }
+    }
+    if (active_k) {blocks_k.push_back(kblock * nblock);}
+  }
+
+  std::vector<long long> blocks_jk;
+  for (int j = 0; j < nj; j++) {
+    for (int kblock = 0; kblock < nblocks_k; kblock++) {
+      if (active_jk[j * nblocks_k + kblock]) {
+        blocks_jk.push_back((long long)(j) * nk + kblock * nblock);
+      }
+    }
+  }
+
+  // Fall back to the full transform if too few pencils are skipped.
+  // CAVEAT: Discretionary choice of the cost model, where the strided
+  // 1-d passes are compared with the full transform costing three
+  // contiguous passes.
+  double frac_x = double(blocks_jk.size()) / double(nj * nblocks_k);
+  double frac_y = double(blocks_k.size()) / double(nblocks_k);
+  if (frac_x + frac_y >= 1.5) {return false;}
+
+  fftw_plan* plans = (sign == FFTW_FORWARD)
+    ? this->transform_pruned : this->inv_transform_pruned;
+
+  const long long nblocks_jk = blocks_jk.size();
+  const int nblocks_k_active = blocks_k.size();
+
+  auto execute_pass_x = [&]() {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (long long iblock = 0; iblock < nblocks_jk; iblock++) {
+      fftw_complex* arr = field_arr + blocks_jk[iblock];
+      fftw_execute_dft(plans[0], arr, arr);
+    }
+  };
+  auto execute_pass_y = [&]() {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(2)
+#endif  // TRV_USE_OMP
+    for (int i = 0; i < ni; i++) {
+      for (int iblock = 0; iblock < nblocks_k_active; iblock++) {
+        fftw_complex* arr = field_arr + i * njk + blocks_k[iblock];
+        fftw_execute_dft(plans[1], arr, arr);
+      }
+    }
+  };
+  auto execute_pass_z = [&]() {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (int i = 0; i < ni; i++) {
+      fftw_complex* arr = field_arr + i * njk;
+      fftw_execute_dft(plans[2], arr, arr);
+    }
+  };
+
+  if (sign == FFTW_BACKWARD) {
+    // Pencils along the x- and y-axes outside the sphere are zero on
+    // input and remain so after the preceding passes.
+    execute_pass_x();
+    execute_pass_y();
+    execute_pass_z();
+  } else {
+    // Pencils along the x-axis outside the sphere are not needed on
+    // output and are set to zero, which covers any skipped pencils
+    // along the y-axis.
+    execute_pass_z();
+    execute_pass_y();
+    execute_pass_x();
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(2)
+#endif  // TRV_USE_OMP
+    for (int i = 0; i < ni; i++) {
+      for (int jkblock = 0; jkblock < nj * nblocks_k; jkblock++) {
+        if (active_jk[jkblock]) {continue;}
+        long long gid_block = i * njk + (long long)(jkblock) * nblock;
+        for (int k = 0; k < nblock; k++) {
+          field_arr[gid_block + k][0] = 0.;
+          field_arr[gid_block + k][1] = 0.;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+void MeshField::stack_shadow_field(int ishift) {
+  // Perform FFT, where the FFT volume normalisation is deferred till
+  // interlacing in `fourier_transform`.
+  if (this->plan_ext) {
+    fftw_execute_dft(this->transform_s, this->field_s, this->field_s);
+  } else
+  if (this->plan_ini) {
+    fftw_execute(this->transform_s);
+  } else {
+    // Fields without FFTW plans (e.g. only used in configuration space)
+    // use a one-off plan, which leaves the field values unchanged.
+    fftw_plan transform_s_;
+    {
+      std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+      transform_s_ = fftw_plan_dft_3d(
+        this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
+        this->field_s, this->field_s,
+        FFTW_FORWARD, FFTW_ESTIMATE
+      );
+    }
+    fftw_execute(transform_s_);
+    {
+      std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+      fftw_destroy_plan(transform_s_);
+    }
+  }
+  trvs::count_fft += 1;
+
+  const double shift = double(ishift) / this->params.interlace_order;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(3)
+#endif  // TRV_USE_OMP
+  for (int i = 0; i < this->params.ngrid[0]; i++) {
+    for (int j = 0; j < this->params.ngrid[1]; j++) {
+      for (int k = 0; k < this->params.ngrid[2]; k++) {
+        long long idx_grid = this->ret_grid_index(i, j, k);
+
+        double m[3];
+        m[0] = (i < this->params.ngrid[0]/2)
+          ? double(i) / this->params.ngrid[0]
+          : double(i) / this->params.ngrid[0] - 1;
+        m[1] = (j < this->params.ngrid[1]/2)
+          ? double(j) / this->params.ngrid[1]
+          : double(j) / this->params.ngrid[1] - 1;
+        m[2] = (k < this->params.ngrid[2]/2)
+          ? double(k) / this->params.ngrid[2]
+          : double(k) / this->params.ngrid[2] - 1;
+
+        // Multiply by the phase factor from the grid shift, stack and
+        // reset the shadow field for the next assignment.
+        double arg = 2.*M_PI * shift * (m[0] + m[1] + m[2]);
+
+        this->field_a[idx_grid][0] +=
+          std::cos(arg) * this->field_s[idx_grid][0]
+          - std::sin(arg) * this->field_s[idx_grid][1]
+        ;
+        this->field_a[idx_grid][1] +=
+          std::sin(arg) * this->field_s[idx_grid][0]
+          + std::cos(arg) * this->field_s[idx_grid][1]
+        ;
+
+        this->field_s[idx_grid][0] = 0.;
+        this->field_s[idx_grid][1] = 0.;
+      }
+    }
+  }
+}
+
 
 // -----------------------------------------------------------------------
 // Field operations
@@ -1286,15 +1764,127 @@ void MeshField::apply_assignment_compensation() {
   }
 }
 
+void MeshField::crop_field_in_fourier(MeshField& field_fourier) {
+  if (trvs::currTask == 0) {
+    trvs::logger.debug(
+      "Cropping %s in Fourier space to %s.",
+      field_fourier.name.c_str(), this->name.c_str()
+    );
+  }
+
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    if (this->params.ngrid[iaxis] > field_fourier.params.ngrid[iaxis]) {
+      if (trvs::currTask == 0) {
+        trvs::logger.error(
+          "Cropped mesh grid is finer than the original mesh grid: "
+          "%d > %d (axis %d).",
+          this->params.ngrid[iaxis], field_fourier.params.ngrid[iaxis],
+          iaxis
+        );
+      }
+      throw trvs::InvalidParameterError(
+        "Cropped mesh grid is finer than the original mesh grid: "
+        "%d > %d (axis %d).\n",
+        this->params.ngrid[iaxis], field_fourier.params.ngrid[iaxis],
+        iaxis
+      );
+    }
+  }
+
+  // Map a wavevector index on the cropped mesh grid to that on the
+  // original mesh grid.
+  auto map_index = [](int i, int ngrid_crop, int ngrid) {
+    return (i < ngrid_crop/2) ? i : i - ngrid_crop + ngrid;
+  };
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(3)
+#endif  // TRV_USE_OMP
+  for (int i = 0; i < this->params.ngrid[0]; i++) {
+    for (int j = 0; j < this->params.ngrid[1]; j++) {
+      for (int k = 0; k < this->params.ngrid[2]; k++) {
+        long long idx_grid = this->ret_grid_index(i, j, k);
+
+        int i_ = map_index(
+          i, this->params.ngrid[0], field_fourier.params.ngrid[0]
+        );
+        int j_ = map_index(
+          j, this->params.ngrid[1], field_fourier.params.ngrid[1]
+        );
+        int k_ = map_index(
+          k, this->params.ngrid[2], field_fourier.params.ngrid[2]
+        );
+        long long idx_grid_ = field_fourier.ret_grid_index(i_, j_, k_);
+
+        double win = field_fourier.calc_assignment_window_in_fourier(
+          i_, j_, k_, field_fourier.params.assignment_order
+        );
+
+        this->field[idx_grid][0] = field_fourier[idx_grid_][0] / win;
+        this->field[idx_grid][1] = field_fourier[idx_grid_][1] / win;
+      }
+    }
+  }
+}
+
+void MeshField::add_unpacked_los_moment_wgtd_fields(
+  MeshField& field_packed,
+  const trvm::CartesianMomentCalculator& moment_calc,
+  int idx_a, int idx_b
+) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(3)
+#endif  // TRV_USE_OMP
+  for (int i = 0; i < this->params.ngrid[0]; i++) {
+    for (int j = 0; j < this->params.ngrid[1]; j++) {
+      for (int k = 0; k < this->params.ngrid[2]; k++) {
+        long long idx_grid = this->ret_grid_index(i, j, k);
+
+        double kvec[3];
+        this->get_grid_wavevector(i, j, k, kvec);
+
+        double weights_[2*trvm::CartesianMomentCalculator::ell_max + 1];
+        moment_calc.calc_wavevector_weights(kvec, weights_);
+
+        std::complex<double> z(
+          field_packed[idx_grid][0], field_packed[idx_grid][1]
+        );
+
+        // Unpack the pair of real fields by Hermitian symmetry unless
+        // only one is packed.
+        std::complex<double> field_ab = weights_[idx_a] * z;
+        if (idx_b >= 0) {
+          long long idx_grid_neg = this->ret_grid_index(
+            (this->params.ngrid[0] - i) % this->params.ngrid[0],
+            (this->params.ngrid[1] - j) % this->params.ngrid[1],
+            (this->params.ngrid[2] - k) % this->params.ngrid[2]
+          );
+          std::complex<double> z_neg_conj(
+            field_packed[idx_grid_neg][0], - field_packed[idx_grid_neg][1]
+          );
+
+          std::complex<double> field_a = (z + z_neg_conj) / 2.;
+          std::complex<double> field_b = - trvm::M_I * (z - z_neg_conj) / 2.;
+
+          field_ab = weights_[idx_a] * field_a + weights_[idx_b] * field_b;
+        }
+
+        this->field[idx_grid][0] += field_ab.real();
+        this->field[idx_grid][1] += field_ab.imag();
+      }
+    }
+  }
+}
+
 
 // -----------------------------------------------------------------------
 // One-point statistics
 // -----------------------------------------------------------------------
 
 void MeshField::inv_fourier_transform_ylm_wgtd_field_band_limited(
-  MeshField& field_fourier, std::vector< std::complex<double> >& ylm,
+  MeshField& field_fourier, trvs::TrackedVector< std::complex<double> >& ylm,
   double k_lower, double k_upper,
-  double& k_eff, int& nmodes
+  double& k_eff, long long& nmodes
 ) {
   if (trvs::currTask == 0) {
     trvs::logger.debug(
@@ -1304,6 +1894,12 @@ void MeshField::inv_fourier_transform_ylm_wgtd_field_band_limited(
     );
   }
 
+  trvs::ScopedTimer timer(
+    "shell_fill",
+    trvs::size_in_gb<fftw_complex>(2*this->params.nmesh)
+    + trvs::size_in_gb< std::complex<double> >(this->params.nmesh)
+  );
+
   // Reset field values to zero.
   this->reset_density_field();
 
@@ -1353,18 +1949,27 @@ void MeshField::inv_fourier_transform_ylm_wgtd_field_band_limited(
   }
 
   // Perform inverse FFT.
-  if (this->plan_ext) {
-    fftw_execute_dft(this->inv_transform, this->field, this->field);
-  } else {
-    fftw_execute(this->inv_transform);
+  {
+    trvs::ScopedTimer timer_fft(
+      "fft", trvs::size_in_gb<fftw_complex>(2*this->params.nmesh)
+    );
+    if (!this->execute_pruned_transform(
+      this->field, FFTW_BACKWARD, k_upper
+    )) {
+      if (this->plan_ext) {
+        fftw_execute_dft(this->inv_transform, this->field, this->field);
+      } else {
+        fftw_execute(this->inv_transform);
+      }
+    }
+    trvs::count_ifft += 1;
   }
-  trvs::count_ifft += 1;
 
   // Average over wavevector modes in the band.
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
     this->field[gid][0] /= double(nmodes);
     this->field[gid][1] /= double(nmodes);
   }
@@ -1374,7 +1979,7 @@ void MeshField::inv_fourier_transform_ylm_wgtd_field_band_limited(
 
 void MeshField::inv_fourier_transform_sjl_ylm_wgtd_field(
     MeshField& field_fourier,
-    std::vector< std::complex<double> >& ylm,
+    trvs::TrackedVector< std::complex<double> >& ylm,
     trvm::SphericalBesselCalculator& sjl,
     double r
 ) {
@@ -1386,6 +1991,12 @@ void MeshField::inv_fourier_transform_sjl_ylm_wgtd_field(
     );
   }
 
+  trvs::ScopedTimer timer(
+    "shell_fill",
+    trvs::size_in_gb<fftw_complex>(2*this->params.nmesh)
+    + trvs::size_in_gb< std::complex<double> >(this->params.nmesh)
+  );
+
   // Reset field values to zero.
   this->reset_density_field();
 
@@ -1433,12 +2044,165 @@ void MeshField::inv_fourier_transform_sjl_ylm_wgtd_field(
 }
 
   // Perform inverse FFT.
-  if (this->plan_ext) {
-    fftw_execute_dft(this->inv_transform, this->field, this->field);
-  } else {
-    fftw_execute(this->inv_transform);
+  {
+    trvs::ScopedTimer timer_fft(
+      "fft", trvs::size_in_gb<fftw_complex>(2*this->params.nmesh)
+    );
+    if (this->plan_ext) {
+      fftw_execute_dft(this->inv_transform, this->field, this->field);
+    } else {
+      fftw_execute(this->inv_transform);
+    }
+    trvs::count_ifft += 1;
   }
-  trvs::count_ifft += 1;
+}
+
+
+// -----------------------------------------------------------------------
+// Field I/O
+// -----------------------------------------------------------------------
+
+namespace {
+
+/// magic string of mesh field files
+const char MESH_FILE_MAGIC[8] = "TRVMESH";
+/// format version of mesh field files
+const int MESH_FILE_VERSION = 1;
+
+/**
+ * @brief Header of mesh field files (padded to 512 bytes).
+ */
+struct MeshFileHeader {
+  char magic[8];       ///< magic string
+  int version;         ///< format version
+  int interlace;       ///< number of shadow fields (interlacing)
+  int ngrid[3];        ///< grid cell numbers
+  int padding;         ///< alignment padding
+  double boxsize[3];   ///< box sizes
+  long long nmesh;     ///< number of mesh grid cells
+  char key[448];       ///< identifying key
+};
+
+static_assert(
+  sizeof(MeshFileHeader) == 512, "Mesh field file header size must be 512."
+);
+
+/**
+ * @brief Fill in the mesh field file header.
+ *
+ * @param params Parameter set.
+ * @param key Identifying key.
+ * @returns Mesh field file header.
+ */
+MeshFileHeader make_mesh_file_header(
+  trv::ParameterSet& params, const std::string& key
+) {
+  MeshFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+
+  std::memcpy(header.magic, MESH_FILE_MAGIC, sizeof(header.magic));
+  header.version = MESH_FILE_VERSION;
+  header.interlace =
+    (params.interlace == "true") ? params.interlace_order - 1 : 0;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    header.ngrid[iaxis] = params.ngrid[iaxis];
+    header.boxsize[iaxis] = params.boxsize[iaxis];
+  }
+  header.nmesh = params.nmesh;
+  std::strncpy(header.key, key.c_str(), sizeof(header.key) - 1);
+
+  return header;
+}
+
+}  // namespace
+
+int MeshField::write_to_file(
+  const std::string& filepath, const std::string& key
+) {
+  MeshFileHeader header = make_mesh_file_header(this->params, key);
+
+  std::string filepath_tmp = filepath + ".tmp";
+  std::FILE* fileptr = std::fopen(filepath_tmp.c_str(), "wb");
+  if (fileptr == nullptr) {return 1;}
+
+  std::size_t nwritten = std::fwrite(&header, sizeof(header), 1, fileptr);
+  nwritten += std::fwrite(
+    this->field, sizeof(fftw_complex), this->params.nmesh, fileptr
+  );
+  std::size_t nexpected = 1 + this->params.nmesh;
+  if (header.interlace) {
+    nwritten += std::fwrite(
+      this->field_s, sizeof(fftw_complex), this->params.nmesh, fileptr
+    );
+    nexpected += this->params.nmesh;
+  }
+  if (header.interlace > 1) {
+    nwritten += std::fwrite(
+      this->field_a, sizeof(fftw_complex), this->params.nmesh, fileptr
+    );
+    nexpected += this->params.nmesh;
+  }
+
+  if (std::fclose(fileptr) != 0 || nwritten != nexpected) {
+    std::remove(filepath_tmp.c_str());
+    return 1;
+  }
+
+  if (std::rename(filepath_tmp.c_str(), filepath.c_str()) != 0) {
+    std::remove(filepath_tmp.c_str());
+    return 1;
+  }
+
+  return 0;
+}
+
+int MeshField::read_from_file(
+  const std::string& filepath, const std::string& key
+) {
+  MeshFileHeader header_exp = make_mesh_file_header(this->params, key);
+
+  std::size_t nbytes_field = sizeof(fftw_complex) * this->params.nmesh;
+  int nfields = 1 + std::min(header_exp.interlace, 2);
+  std::size_t nbytes_exp = sizeof(MeshFileHeader) + nfields * nbytes_field;
+
+  int fd = open(filepath.c_str(), O_RDONLY);
+  if (fd < 0) {return 1;}
+
+  struct stat filestat;
+  if (fstat(fd, &filestat) != 0
+      || static_cast<std::size_t>(filestat.st_size) != nbytes_exp) {
+    close(fd);
+    return 1;
+  }
+
+  void* mapped = mmap(nullptr, nbytes_exp, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // the mapping remains valid
+  if (mapped == MAP_FAILED) {return 1;}
+
+  // Validate the header before copying any field values.
+  const char* bytes = static_cast<const char*>(mapped);
+  if (std::memcmp(bytes, &header_exp, sizeof(MeshFileHeader)) != 0) {
+    munmap(mapped, nbytes_exp);
+    return 1;
+  }
+
+  std::memcpy(this->field, bytes + sizeof(MeshFileHeader), nbytes_field);
+  if (header_exp.interlace) {
+    std::memcpy(
+      this->field_s, bytes + sizeof(MeshFileHeader) + nbytes_field,
+      nbytes_field
+    );
+  }
+  if (header_exp.interlace > 1) {
+    std::memcpy(
+      this->field_a, bytes + sizeof(MeshFileHeader) + 2 * nbytes_field,
+      nbytes_field
+    );
+  }
+
+  munmap(mapped, nbytes_exp);
+
+  return 0;
 }
 
 
@@ -1460,8 +2224,8 @@ double MeshField::calc_grid_based_powlaw_norm(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    weight[pid][0] = particles[pid].w;
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
+    weight[pid][0] = particles.w[pid];
     weight[pid][1] = 0.;
   }
 
@@ -1479,7 +2243,7 @@ double MeshField::calc_grid_based_powlaw_norm(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:vol_int)
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
     vol_int += std::pow(this->field[gid][0], order);
   }
 
@@ -1492,55 +2256,507 @@ double MeshField::calc_grid_based_powlaw_norm(
 
 
 // ***********************************************************************
-// Field statistics
+// Mesh field cache
 // ***********************************************************************
 
-// -----------------------------------------------------------------------
-// Life cycle
-// -----------------------------------------------------------------------
+std::string MeshFieldCache::get_key(
+  const std::string type, int ell, int m, trv::ParameterSet& params
+) {
+  // Interlacing (with its order) is included as it may differ between
+  // two- and three-point measurements in the same plan.
+  char key[128];
+  std::snprintf(
+    key, sizeof(key), "%s_%d_%d_%s_%d",
+    type.c_str(), ell, m, params.interlace.c_str(), params.interlace_order
+  );
+  return std::string(key);
+}
 
-FieldStats::FieldStats(trv::ParameterSet& params, bool plan_ini){
-  this->params = params;
+void MeshFieldCache::register_use(const std::string key) {
+  this->uses[key] += 1;
+}
 
-  this->reset_stats();
+void MeshFieldCache::release_use(const std::string key) {
+  if (this->uses.count(key) == 0) {return;}
 
-  // Calculate grid sizes in configuration space.
-  this->dr[0] = this->params.boxsize[0] / this->params.ngrid[0];
-  this->dr[1] = this->params.boxsize[1] / this->params.ngrid[1];
-  this->dr[2] = this->params.boxsize[2] / this->params.ngrid[2];
+  this->uses[key] -= 1;
+  if (this->uses[key] <= 0) {
+    this->uses.erase(key);
+    this->fields.erase(key);  // memory is freed with the last reference
+  }
+}
 
-  // Calculate fundamental wavenumbers in Fourier space.
-  this->dk[0] = 2.*M_PI / this->params.boxsize[0];
-  this->dk[1] = 2.*M_PI / this->params.boxsize[1];
-  this->dk[2] = 2.*M_PI / this->params.boxsize[2];
+void MeshFieldCache::retain_random_fields() {
+  this->retain_rand = true;
+}
 
-  // Calculate mesh volume and mesh grid cell volume.
-  this->vol = this->params.volume;
-  this->vol_cell = this->vol / double(this->params.nmesh);
+void MeshFieldCache::persist_random_fields(
+  const std::string cache_dir, double cache_size,
+  const std::string catalogue_hash
+) {
+  this->retain_rand = true;
+  this->cache_dir = cache_dir;
+  this->cache_size = cache_size;
+  this->catalogue_hash = catalogue_hash;
+}
 
-  // Set up FFTW plans.
-  if (plan_ini) {
-    this->twopt_3d = fftw_alloc_complex(this->params.nmesh);
+void MeshFieldCache::clear() {
+  this->fields.clear();
+  this->uses.clear();
+  this->fields_rand.clear();  // memory is freed with the last reference
+}
 
-    trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(this->params.nmesh);
-    trvs::update_maxmem();
+std::shared_ptr<MeshField> MeshFieldCache::find(const std::string key) {
+  auto it = this->fields.find(key);
+  if (it == this->fields.end()) {
+    return nullptr;
+  }
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-    fftw_plan_with_nthreads(omp_get_max_threads());
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-    this->inv_transform = fftw_plan_dft_3d(
-      this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
-      this->twopt_3d, this->twopt_3d,
-      FFTW_BACKWARD, FFTW_MEASURE
-    );
+  this->count_reused += 1;
 
-    this->plan_ini = true;
+  if (trvs::currTask == 0) {
+    trvs::logger.debug("Reusing cached mesh field: %s.", key.c_str());
+  }
+
+  return it->second;
+}
+
+void MeshFieldCache::store(
+  const std::string key, std::shared_ptr<MeshField> field
+) {
+  this->count_computed += 1;
+
+  if (this->uses.count(key) > 0) {
+    this->fields[key] = field;
+  }
+}
+
+void MeshFieldCache::compute_ylm_wgtd_field(
+  MeshField& field, trv::ParameterSet& params,
+  ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+  double alpha, int ell, int m, bool quad
+) {
+  // Random-source fields are retained with unit alpha contrast, which
+  // is applied together with the data-source assignment.
+  std::string key_rand = MeshFieldCache::get_key(
+    quad ? "ylm_wgtd_quad_rand" : "ylm_wgtd_rand", ell, m, params
+  );
+  auto it = this->fields_rand.find(key_rand);
+
+  // Newly retained random-source fields must fit within the memory
+  // budget; otherwise they are recomputed with each use.
+  bool retained = this->retain_rand && (
+    it != this->fields_rand.end() || trvs::reserve_mem_budget(
+      MeshField::get_size_in_gb(params), params.memory_budget
+    )
+  );
+  if (this->retain_rand && !retained && trvs::currTask == 0) {
+    trvs::logger.debug(
+      "Random-source mesh field is not retained within the memory budget: "
+      "%s.", key_rand.c_str()
+    );
+  }
+
+  if (!retained) {
+    if (quad) {
+      field.compute_ylm_wgtd_quad_field(
+        particles_data, particles_rand, los_data, los_rand, alpha, ell, m
+      );
+    } else {
+      field.compute_ylm_wgtd_field(
+        particles_data, particles_rand, los_data, los_rand, alpha, ell, m
+      );
+    }
+    return;
+  }
+
+  std::shared_ptr<MeshField> field_rand = nullptr;
+  if (it != this->fields_rand.end()) {
+    field_rand = it->second;
+    this->count_rand_reused += 1;
+  } else {
+    field_rand = std::make_shared<MeshField>(params, false, "`field_rand`");
+
+    // Look up the on-disk cache if any.
+    bool loaded = false;
+    std::string key_file, filepath;
+    if (!this->cache_dir.empty()) {
+      key_file = this->get_file_key(key_rand, params, particles_rand, los_rand);
+      filepath = this->cache_dir + "trvmesh_" + trvs::format_data_hash(
+        trvs::update_data_hash(key_file.data(), key_file.size())
+      ) + ".bin";
+      loaded = (field_rand->read_from_file(filepath, key_file) == 0);
+    }
+
+    if (loaded) {
+      utime(filepath.c_str(), nullptr);  // mark as recently used
+      this->count_rand_loaded += 1;
+      if (trvs::currTask == 0) {
+        trvs::logger.debug(
+          "Loaded cached mesh field from disk: %s (%s).",
+          key_rand.c_str(), filepath.c_str()
+        );
+      }
+    } else {
+      if (quad) {
+        field_rand->compute_ylm_wgtd_quad_field(
+          particles_rand, los_rand, 1., ell, m
+        );
+      } else {
+        field_rand->compute_ylm_wgtd_field(
+          particles_rand, los_rand, 1., ell, m
+        );
+      }
+      this->count_rand_computed += 1;
+
+      if (!this->cache_dir.empty()) {
+        if (field_rand->write_to_file(filepath, key_file) == 0) {
+          this->evict_cached_files(filepath);
+        } else
+        if (trvs::currTask == 0) {
+          trvs::logger.warn(
+            "Failed to write mesh field to disk cache: %s.", filepath.c_str()
+          );
+        }
+      }
+    }
+
+    this->fields_rand[key_rand] = field_rand;
+  }
+
+  if (quad) {
+    field.compute_ylm_wgtd_quad_field(
+      particles_data, los_data, *field_rand, alpha, ell, m
+    );
+  } else {
+    field.compute_ylm_wgtd_field(
+      particles_data, los_data, *field_rand, alpha, ell, m
+    );
+  }
+}
+
+std::string MeshFieldCache::get_file_key(
+  const std::string key, trv::ParameterSet& params,
+  ParticleCatalogue& particles_rand, const LineOfSightPolicy& los_rand
+) {
+  // Identify the line of sight, hashing user-supplied lines of sight.
+  char los_str[128];
+  switch (los_rand.type) {
+    case LineOfSightPolicy::Type::local:
+      std::snprintf(los_str, sizeof(los_str), "local");
+      break;
+    case LineOfSightPolicy::Type::global:
+      std::snprintf(
+        los_str, sizeof(los_str), "global:%.17g,%.17g,%.17g",
+        los_rand.axis[0], los_rand.axis[1], los_rand.axis[2]
+      );
+      break;
+    case LineOfSightPolicy::Type::user:
+      std::snprintf(
+        los_str, sizeof(los_str), "user:%s",
+        trvs::format_data_hash(trvs::update_data_hash(
+          los_rand.los, particles_rand.ntotal * sizeof(LineOfSight)
+        )).c_str()
+      );
+      break;
+  }
+
+  char key_file[448];
+  std::snprintf(
+    key_file, sizeof(key_file),
+    "%s|catalogue=%s|los=%s|boxsize=%.17g,%.17g,%.17g|ngrid=%d,%d,%d"
+    "|assignment=%s|alignment=%s|padscale=%s|padfactor=%.17g",
+    key.c_str(), this->catalogue_hash.c_str(), los_str,
+    params.boxsize[0], params.boxsize[1], params.boxsize[2],
+    params.ngrid[0], params.ngrid[1], params.ngrid[2],
+    params.assignment.c_str(), params.alignment.c_str(),
+    params.padscale.c_str(), params.padfactor
+  );
+  return std::string(key_file);
+}
+
+void MeshFieldCache::evict_cached_files(const std::string filepath_kept) {
+  if (this->cache_size <= 0.) {return;}
+
+  const double BYTES_PER_GBYTES = 1073741824.;
+
+  DIR* dirptr = opendir(this->cache_dir.c_str());
+  if (dirptr == nullptr) {return;}
+
+  // List cached files with their sizes and last-use times.
+  struct CachedFile {
+    std::string filepath;
+    double size;
+    time_t mtime;
+  };
+  std::vector<CachedFile> cached_files;
+  double size_total = 0.;
+  while (struct dirent* entry = readdir(dirptr)) {
+    std::string filename = entry->d_name;
+    if (filename.rfind("trvmesh_", 0) != 0
+        || filename.size() < 4
+        || filename.compare(filename.size() - 4, 4, ".bin") != 0) {
+      continue;
+    }
+
+    std::string filepath = this->cache_dir + filename;
+    struct stat filestat;
+    if (stat(filepath.c_str(), &filestat) != 0) {continue;}
+
+    double size = filestat.st_size / BYTES_PER_GBYTES;
+    cached_files.push_back({filepath, size, filestat.st_mtime});
+    size_total += size;
+  }
+  closedir(dirptr);
+
+  // Evict the least recently used files first.
+  std::sort(
+    cached_files.begin(), cached_files.end(),
+    [](const CachedFile& a, const CachedFile& b) {return a.mtime < b.mtime;}
+  );
+  for (const CachedFile& cached_file : cached_files) {
+    if (size_total <= this->cache_size) {break;}
+    if (cached_file.filepath == filepath_kept) {continue;}
+    if (std::remove(cached_file.filepath.c_str()) == 0) {
+      size_total -= cached_file.size;
+      if (trvs::currTask == 0) {
+        trvs::logger.debug(
+          "Evicted mesh field from disk cache: %s.",
+          cached_file.filepath.c_str()
+        );
+      }
+    }
+  }
+}
+
+std::shared_ptr<MeshField> MeshFieldCache::get_ylm_wgtd_field(
+  trv::ParameterSet& params,
+  ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+  double alpha, int ell, int m, const std::string name, double k_max
+) {
+  std::string key = MeshFieldCache::get_key("ylm_wgtd", ell, m, params);
+  std::shared_ptr<MeshField> field = this->find(key);
+  if (field != nullptr) {return field;}
+
+  field = std::make_shared<MeshField>(params, true, name);
+  this->compute_ylm_wgtd_field(
+    *field, params, particles_data, particles_rand, los_data, los_rand,
+    alpha, ell, m, false
+  );
+  // Cached fields may be reused for all modes and are not pruned.
+  field->fourier_transform((this->uses.count(key) > 0) ? 0. : k_max);
+
+  this->store(key, field);
+
+  return field;
+}
+
+std::shared_ptr<MeshField> MeshFieldCache::get_ylm_wgtd_quad_field(
+  trv::ParameterSet& params,
+  ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+  double alpha, int ell, int m, const std::string name
+) {
+  std::string key =
+    MeshFieldCache::get_key("ylm_wgtd_quad", ell, m, params);
+  std::shared_ptr<MeshField> field = this->find(key);
+  if (field != nullptr) {return field;}
+
+  field = std::make_shared<MeshField>(params, true, name);
+  this->compute_ylm_wgtd_field(
+    *field, params, particles_data, particles_rand, los_data, los_rand,
+    alpha, ell, m, true
+  );
+  field->fourier_transform();
+
+  this->store(key, field);
+
+  return field;
+}
+
+std::shared_ptr<MeshField> MeshFieldCache::get_ylm_wgtd_field_in_config(
+  trv::ParameterSet& params,
+  ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+  double alpha, int ell, int m, const std::string name
+) {
+  std::string key =
+    MeshFieldCache::get_key("ylm_wgtd_config", ell, m, params);
+  std::shared_ptr<MeshField> field = this->find(key);
+  if (field != nullptr) {return field;}
+
+  // Derive from the Fourier-space field if it is or will be cached.
+  std::string key_fourier =
+    MeshFieldCache::get_key("ylm_wgtd", ell, m, params);
+  if (this->uses.count(key_fourier) > 0) {
+    std::shared_ptr<MeshField> field_fourier = this->get_ylm_wgtd_field(
+      params, particles_data, particles_rand, los_data, los_rand,
+      alpha, ell, m, name
+    );
+    field = this->derive_compensated_field_in_config(
+      params, *field_fourier, name
+    );
+  } else {
+    field = std::make_shared<MeshField>(params, true, name);
+    this->compute_ylm_wgtd_field(
+      *field, params, particles_data, particles_rand, los_data, los_rand,
+      alpha, ell, m, false
+    );
+    field->fourier_transform();
+    field->apply_assignment_compensation();
+    field->inv_fourier_transform();
+  }
+
+  this->store(key, field);
+
+  return field;
+}
+
+std::shared_ptr<MeshField> MeshFieldCache::get_unweighted_field_fluctuations(
+  trv::ParameterSet& params, ParticleCatalogue& particles,
+  const std::string name, double k_max
+) {
+  std::string key = MeshFieldCache::get_key("unwgtd_fluct", 0, 0, params);
+  std::shared_ptr<MeshField> field = this->find(key);
+  if (field != nullptr) {return field;}
+
+  field = std::make_shared<MeshField>(params, true, name);
+  field->compute_unweighted_field_fluctuations_insitu(particles);
+  // Cached fields may be reused for all modes and are not pruned.
+  field->fourier_transform((this->uses.count(key) > 0) ? 0. : k_max);
+
+  this->store(key, field);
+
+  return field;
+}
+
+std::shared_ptr<MeshField> MeshFieldCache::get_unweighted_field(
+  trv::ParameterSet& params, ParticleCatalogue& particles,
+  const std::string name
+) {
+  std::string key = MeshFieldCache::get_key("unwgtd", 0, 0, params);
+  std::shared_ptr<MeshField> field = this->find(key);
+  if (field != nullptr) {return field;}
+
+  field = std::make_shared<MeshField>(params, true, name);
+  field->compute_unweighted_field(particles);
+  field->fourier_transform();
+
+  this->store(key, field);
+
+  return field;
+}
+
+std::shared_ptr<MeshField>
+MeshFieldCache::get_unweighted_field_fluctuations_in_config(
+  trv::ParameterSet& params, ParticleCatalogue& particles,
+  const std::string name
+) {
+  std::string key =
+    MeshFieldCache::get_key("unwgtd_fluct_config", 0, 0, params);
+  std::shared_ptr<MeshField> field = this->find(key);
+  if (field != nullptr) {return field;}
+
+  // Derive from the Fourier-space field if it is or will be cached.
+  std::string key_fourier =
+    MeshFieldCache::get_key("unwgtd_fluct", 0, 0, params);
+  if (this->uses.count(key_fourier) > 0) {
+    std::shared_ptr<MeshField> field_fourier =
+      this->get_unweighted_field_fluctuations(params, particles, name);
+    field = this->derive_compensated_field_in_config(
+      params, *field_fourier, name
+    );
+  } else {
+    field = std::make_shared<MeshField>(params, true, name);
+    field->compute_unweighted_field_fluctuations_insitu(particles);
+    field->fourier_transform();
+    field->apply_assignment_compensation();
+    field->inv_fourier_transform();
+  }
+
+  this->store(key, field);
+
+  return field;
+}
+
+std::shared_ptr<MeshField>
+MeshFieldCache::derive_compensated_field_in_config(
+  trv::ParameterSet& params, MeshField& field_fourier,
+  const std::string name
+) {
+  std::shared_ptr<MeshField> field =
+    std::make_shared<MeshField>(params, true, name);
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (long long gid = 0; gid < params.nmesh; gid++) {
+    field->field[gid][0] = field_fourier.field[gid][0];
+    field->field[gid][1] = field_fourier.field[gid][1];
+  }
+
+  field->apply_assignment_compensation();
+  field->inv_fourier_transform();
+
+  return field;
+}
+
+
+// ***********************************************************************
+// Field statistics
+// ***********************************************************************
+
+// -----------------------------------------------------------------------
+// Life cycle
+// -----------------------------------------------------------------------
+
+FieldStats::FieldStats(trv::ParameterSet& params, bool plan_ini){
+  this->params = params;
+
+  this->reset_stats();
+
+  // Calculate grid sizes in configuration space.
+  this->dr[0] = this->params.boxsize[0] / this->params.ngrid[0];
+  this->dr[1] = this->params.boxsize[1] / this->params.ngrid[1];
+  this->dr[2] = this->params.boxsize[2] / this->params.ngrid[2];
+
+  // Calculate fundamental wavenumbers in Fourier space.
+  this->dk[0] = 2.*M_PI / this->params.boxsize[0];
+  this->dk[1] = 2.*M_PI / this->params.boxsize[1];
+  this->dk[2] = 2.*M_PI / this->params.boxsize[2];
+
+  // Calculate mesh volume and mesh grid cell volume.
+  this->vol = this->params.volume;
+  this->vol_cell = this->vol / double(this->params.nmesh);
+
+  // Set up FFTW plans.
+  if (plan_ini) {
+    this->twopt_3d = fftw_alloc_complex(this->params.nmesh);
+
+    trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(this->params.nmesh);
+    trvs::update_maxmem();
+
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+    fftw_plan_with_nthreads(omp_get_max_threads());
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+    this->inv_transform = fftw_plan_dft_3d(
+      this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
+      this->twopt_3d, this->twopt_3d,
+      FFTW_BACKWARD, FFTW_MEASURE
+    );
+
+    this->plan_ini = true;
   }
 }
 
 // An empty destructor is redundant but left here for future implementations.
 FieldStats::~FieldStats() {
   if (this->plan_ini) {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
     fftw_destroy_plan(this->inv_transform);
     fftw_free(this->twopt_3d); this->twopt_3d = nullptr;
     trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(this->params.nmesh);
@@ -1603,202 +2819,753 @@ bool FieldStats::if_fields_compatible(
   return flag_compatible;
 }
 
-trv::BinnedVectors FieldStats::record_binned_vectors(
-  trv::Binning& binning, const std::string& save_file={}
+namespace {
+
+/// maximum number of binned vectors held per block in streaming writes
+const int NVEC_BINNED_VECTORS_BLOCK = 1 << 20;
+
+}  // namespace
+
+trv::BinnedVectors FieldStats::record_binned_vectors(
+  trv::Binning& binning, const std::string& save_file={}, bool stream
+) {
+  double cellsizes[3];
+  if (binning.space == "config") {
+    cellsizes[0] = this->dr[0];
+    cellsizes[1] = this->dr[1];
+    cellsizes[2] = this->dr[2];
+  } else
+  if (binning.space == "fourier") {
+    cellsizes[0] = this->dk[0];
+    cellsizes[1] = this->dk[1];
+    cellsizes[2] = this->dk[2];
+  } else {
+    trvs::logger.error(
+      "Invalid binning space: '%s'.", binning.space.c_str()
+    );
+    throw trvs::InvalidDataError(
+      "Invalid binning space: '%s'.", binning.space.c_str()
+    );
+  }
+
+  // Restrict the mesh grid index ranges.
+  double b = binning.bin_max;
+
+  int lrange_upper[3], rrange_lower[3];
+  if (binning.space == "config") {
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      lrange_upper[iaxis] = std::min(
+        std::ceil(b * this->params.ngrid[iaxis] / this->params.boxsize[iaxis]),
+        std::ceil(this->params.ngrid[iaxis]/2.)
+      );
+      rrange_lower[iaxis] = std::max(
+        std::floor(
+          this->params.ngrid[iaxis]
+          - b * this->params.ngrid[iaxis] / this->params.boxsize[iaxis]
+        ),
+        std::floor(this->params.ngrid[iaxis]/2.)
+      );
+    }
+  } else
+  if (binning.space == "fourier") {
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      lrange_upper[iaxis] = std::min(
+        std::ceil(b * this->params.boxsize[iaxis] / (2*M_PI)),
+        std::ceil(this->params.ngrid[iaxis]/2.)
+      );
+      rrange_lower[iaxis] = std::max(
+        std::floor(
+          this->params.ngrid[iaxis]
+          - b * this->params.boxsize[iaxis] / (2*M_PI)
+        ),
+        std::floor(this->params.ngrid[iaxis]/2.)
+      );
+    }
+  }
+
+  auto generate_range = [](
+    int lrange_lower, int lrange_upper, int rrange_lower, int rrange_upper
+  ) {
+    std::vector<int> range_vector;
+    if (lrange_upper < rrange_lower) {
+      for (int i = lrange_lower; i <= lrange_upper; i++) {
+          range_vector.push_back(i);
+      }
+      for (int i = rrange_lower; i <= rrange_upper; i++) {
+          range_vector.push_back(i);
+      }
+    } else {
+      // This can happen when sampling beyond the Nyquist scale.
+      for (int i = lrange_lower; i <= rrange_upper; i++) {
+          range_vector.push_back(i);
+      }
+    }
+    return range_vector;
+  };
+
+  std::vector<int> i_range = generate_range(
+    0, lrange_upper[0], rrange_lower[0], params.ngrid[0] - 1
+  );
+  std::vector<int> j_range = generate_range(
+    0, lrange_upper[1], rrange_lower[1], params.ngrid[1] - 1
+  );
+  std::vector<int> k_range = generate_range(
+    0, lrange_upper[2], rrange_lower[2], params.ngrid[2] - 1
+  );
+
+  // Locate the bin of the vector in each mesh grid cell, where cells
+  // are flattened over the index ranges in row-major order.
+  const int num_bins = binning.num_bins;
+  const long long nj = j_range.size();
+  const long long nk = k_range.size();
+  const long long ncells = (long long)(i_range.size()) * nj * nk;
+
+  auto locate_vector = [&](long long icell, double* vec) {
+    int i = i_range[icell / (nj * nk)];
+    int j = j_range[(icell / nk) % nj];
+    int k = k_range[icell % nk];
+
+    vec[0] = (i < this->params.ngrid[0]/2) ?
+      i * cellsizes[0] : (i - this->params.ngrid[0]) * cellsizes[0];
+    vec[1] = (j < this->params.ngrid[1]/2) ?
+      j * cellsizes[1] : (j - this->params.ngrid[1]) * cellsizes[1];
+    vec[2] = (k < this->params.ngrid[2]/2) ?
+      k * cellsizes[2] : (k - this->params.ngrid[2]) * cellsizes[2];
+
+    double scale = trvm::get_vec3d_magnitude(vec);
+
+    // Bins are closed below and open above; -1 marks out-of-range scales.
+    int ibin = int(
+      std::upper_bound(
+        binning.bin_edges.begin(), binning.bin_edges.begin() + num_bins + 1,
+        scale
+      ) - binning.bin_edges.begin()
+    ) - 1;
+
+    return (ibin < num_bins) ? ibin : -1;
+  };
+
+  // Split the cells into contiguous chunks, one per thread, so that
+  // vectors within each bin are placed in mesh grid order regardless
+  // of the thread count.  Per-chunk bin counts are padded to separate
+  // cache lines.
+  int nchunks = 1;
+#ifdef TRV_USE_OMP
+  nchunks = omp_get_max_threads();
+#endif  // TRV_USE_OMP
+
+  auto chunk_begin = [&](int ichunk) { return ncells * ichunk / nchunks; };
+
+  const int stride = (num_bins + 15) / 16 * 16;
+
+  std::vector<int> counts(nchunks * stride, 0);
+  std::vector<int> offsets(nchunks * stride, 0);
+
+  trvs::gbytesMem += trvs::size_in_gb<int>(2 * nchunks * stride);
+  trvs::update_maxmem();
+
+  // Count the vectors in each bin per chunk.
+#ifdef TRV_USE_OMP
+#pragma omp parallel for schedule(static, 1)
+#endif  // TRV_USE_OMP
+  for (int ichunk = 0; ichunk < nchunks; ichunk++) {
+    int* counts_chunk = &counts[ichunk * stride];
+    double vec[3];
+    for (
+      long long icell = chunk_begin(ichunk);
+      icell < chunk_begin(ichunk + 1);
+      icell++
+    ) {
+      int ibin = locate_vector(icell, vec);
+      if (ibin >= 0) {
+        counts_chunk[ibin]++;
+      }
+    }
+  }
+
+  std::vector<int> bin_counts(num_bins, 0);
+  int count = 0;
+  for (int ibin = 0; ibin < num_bins; ibin++) {
+    for (int ichunk = 0; ichunk < nchunks; ichunk++) {
+      bin_counts[ibin] += counts[ichunk * stride + ibin];
+    }
+    count += bin_counts[ibin];
+  }
+
+  // Place the vectors in a block of bins directly in bin order at
+  // per-chunk offsets given by the exclusive prefix sum of the counts.
+  auto place_vectors = [&](
+    int bin_begin, int bin_end, trv::BinnedVectors& binned_vectors_block
+  ) {
+    int offset = 0;
+    for (int ibin = bin_begin; ibin < bin_end; ibin++) {
+      for (int ichunk = 0; ichunk < nchunks; ichunk++) {
+        offsets[ichunk * stride + ibin] = offset;
+        offset += counts[ichunk * stride + ibin];
+      }
+    }
+
+    binned_vectors_block.count = offset;
+    binned_vectors_block.num_bins = num_bins;
+
+    binned_vectors_block.indices.resize(offset);
+    binned_vectors_block.lower_edges.resize(offset);
+    binned_vectors_block.upper_edges.resize(offset);
+    binned_vectors_block.vecx.resize(offset);
+    binned_vectors_block.vecy.resize(offset);
+    binned_vectors_block.vecz.resize(offset);
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for schedule(static, 1)
+#endif  // TRV_USE_OMP
+    for (int ichunk = 0; ichunk < nchunks; ichunk++) {
+      int* offsets_chunk = &offsets[ichunk * stride];
+      double vec[3];
+      for (
+        long long icell = chunk_begin(ichunk);
+        icell < chunk_begin(ichunk + 1);
+        icell++
+      ) {
+        int ibin = locate_vector(icell, vec);
+        if (ibin < bin_begin || ibin >= bin_end) {
+          continue;
+        }
+
+        int ivec = offsets_chunk[ibin]++;
+        binned_vectors_block.indices[ivec] = ibin;
+        binned_vectors_block.lower_edges[ivec] = binning.bin_edges[ibin];
+        binned_vectors_block.upper_edges[ivec] = binning.bin_edges[ibin + 1];
+        binned_vectors_block.vecx[ivec] = vec[0];
+        binned_vectors_block.vecy[ivec] = vec[1];
+        binned_vectors_block.vecz[ivec] = vec[2];
+      }
+    }
+  };
+
+  // Record the binned vectors.
+  trv::BinnedVectors binned_vectors;
+
+  binned_vectors.count = count;
+  binned_vectors.num_bins = num_bins;
+
+  int nvec_held = 0;  // number of vectors held in memory
+  if (stream && save_file != "") {
+    // Stream blocks of whole bins to the file, with each block holding
+    // at most the block size unless a single bin exceeds it.
+    std::vector<int> block_edges{0};
+    int nvec_block = 0;
+    for (int ibin = 0; ibin < num_bins; ibin++) {
+      if (
+        nvec_block > 0
+        && nvec_block + bin_counts[ibin] > NVEC_BINNED_VECTORS_BLOCK
+      ) {
+        block_edges.push_back(ibin);
+        nvec_block = 0;
+      }
+      nvec_block += bin_counts[ibin];
+      nvec_held = std::max(nvec_held, nvec_block);
+    }
+    block_edges.push_back(num_bins);
+
+    trvs::gbytesMem += trvs::size_in_gb<double>(6*nvec_held);
+    trvs::update_maxmem();
+
+    std::FILE* save_fileptr = std::fopen(save_file.c_str(), "w");
+    trv::io::print_binned_vectors_header_to_file(
+      save_fileptr, this->params, binned_vectors
+    );
+
+    trv::BinnedVectors binned_vectors_block;
+    for (std::size_t iblock = 0; iblock + 1 < block_edges.size(); iblock++) {
+      place_vectors(
+        block_edges[iblock], block_edges[iblock + 1], binned_vectors_block
+      );
+      trv::io::print_binned_vectors_datatab_to_file(
+        save_fileptr, this->params, binned_vectors_block
+      );
+    }
+    std::fclose(save_fileptr);
+  } else {
+    nvec_held = count;
+
+    trvs::gbytesMem += trvs::size_in_gb<double>(6*nvec_held);
+    trvs::update_maxmem();
+
+    place_vectors(0, num_bins, binned_vectors);
+
+    // Save the binned vectors.
+    if (save_file != "") {
+      std::FILE* save_fileptr = std::fopen(save_file.c_str(), "w");
+      trv::io::print_binned_vectors_to_file(
+        save_fileptr, this->params, binned_vectors
+      );
+      std::fclose(save_fileptr);
+    }
+  }
+
+  if (save_file != "" && trvs::currTask == 0) {
+    trvs::logger.info(
+      "Check binned-vectors file for reference: %s.", save_file.c_str()
+    );
+  }
+
+  trvs::gbytesMem -= trvs::size_in_gb<double>(6*nvec_held);
+  trvs::gbytesMem -= trvs::size_in_gb<int>(2 * nchunks * stride);
+
+  return binned_vectors;
+}
+
+
+// -----------------------------------------------------------------------
+// Binned statistics
+// -----------------------------------------------------------------------
+
+void FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier(
+  MeshField& field_a, MeshField& field_b, std::complex<double> shotnoise_amp,
+  int ell, int m, trv::Binning& kbinning
+) {
+  trvs::ScopedTimer timer(
+    "binning", trvs::size_in_gb<fftw_complex>(3*this->params.nmesh)
+  );
+
+  this->resize_stats(kbinning.num_bins);
+
+  // Check mesh fields compatibility and reuse methods of the first mesh field.
+  if (!this->if_fields_compatible(field_a, field_b)) {
+    trvs::logger.error(
+      "Input mesh fields have incompatible physical properties."
+    );
+    throw trvs::InvalidDataError(
+      "Input mesh fields have incompatible physical properties.\n"
+    );
+  }
+
+  auto ret_grid_index = [&field_a](int i, int j, int k) {
+    return field_a.ret_grid_index(i, j, k);
+  };
+
+  auto ret_grid_wavevector = [&field_a](int i, int j, int k, double kvec[3]) {
+    field_a.get_grid_wavevector(i, j, k, kvec);
+  };
+
+  std::function<double(int, int, int)> calc_shotnoise_aliasing =
+    this->ret_calc_shotnoise_aliasing();
+
+  std::function<double(int, int, int)> calc_win_pk, calc_win_sn;
+  int assignment_order = this->params.assignment_order;
+  if (this->params.interlace == "true") {
+    calc_win_pk = [&field_a, &field_b, &assignment_order](
+      int i, int j, int k
+    ) {
+      return
+        field_a.calc_assignment_window_in_fourier(i, j, k, assignment_order)
+        * field_b.calc_assignment_window_in_fourier(i, j, k, assignment_order);
+    };
+    calc_win_sn = calc_win_pk;
+  } else
+  if (this->params.interlace == "false") {
+#ifndef DBG_FLAG_NOAC
+    calc_win_sn = calc_shotnoise_aliasing;
+    calc_win_pk = calc_win_sn;
+#else   // !DBG_FLAG_NOAC
+    calc_win_pk = [&field_a, &field_b, &assignment_order](
+      int i, int j, int k
+    ) {
+      return
+        field_a.calc_assignment_window_in_fourier(i, j, k, assignment_order)
+        * field_b.calc_assignment_window_in_fourier(i, j, k, assignment_order);
+    };
+    calc_win_sn = calc_shotnoise_aliasing;
+#endif  // !DBG_FLAG_NOAC
+  }
+
+  // Perform fine binning.
+  // NOTE: Dynamically allocate owing to size.
+  // CAVEAT: Discretionary choices such that 0.0 < k < 10.0.
+  const int n_sample = 1e6;
+  const double dk_sample = 1.e-5;
+  if (kbinning.bin_max > n_sample * dk_sample) {
+    trvs::logger.warn(
+      "Input bin range exceeds sampled range. "
+      "Statistics in bins beyond sampled range are uncomputed."
+    );
+  }
+
+  trvs::TrackedVector<long long> nmodes_sample(n_sample);
+  trvs::TrackedVector<double> k_sample(n_sample);
+  trvs::TrackedVector<double> pk_sample_real(n_sample);
+  trvs::TrackedVector<double> pk_sample_imag(n_sample);
+  trvs::TrackedVector<double> sn_sample_real(n_sample);
+  trvs::TrackedVector<double> sn_sample_imag(n_sample);
+  trvs::TrackedVector< std::complex<double> > pk_sample(n_sample);
+  trvs::TrackedVector< std::complex<double> > sn_sample(n_sample);
+
+  this->reset_stats();
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(3)
+#endif  // TRV_USE_OMP
+  for (int i = 0; i < this->params.ngrid[0]; i++) {
+    for (int j = 0; j < this->params.ngrid[1]; j++) {
+      for (int k = 0; k < this->params.ngrid[2]; k++) {
+        long long idx_grid = ret_grid_index(i, j, k);
+
+        double kv[3];
+        ret_grid_wavevector(i, j, k, kv);
+
+        double k_ = trvm::get_vec3d_magnitude(kv);
+
+        int idx_k = int(k_ / dk_sample);
+        if (0 <= idx_k && idx_k < n_sample) {
+          std::complex<double> fa(field_a[idx_grid][0], field_a[idx_grid][1]);
+          std::complex<double> fb(field_b[idx_grid][0], field_b[idx_grid][1]);
+
+          std::complex<double> pk_mode = fa * std::conj(fb);
+          std::complex<double> sn_mode =
+            shotnoise_amp * calc_shotnoise_aliasing(i, j, k);
+
+          // Apply grid corrections.
+          double win_pk = calc_win_pk(i, j, k);
+          double win_sn = calc_win_sn(i, j, k);
+
+          pk_mode /= win_pk;
+          sn_mode /= win_sn;
+
+          // Weight by reduced spherical harmonics.
+          std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
+            calc_reduced_spherical_harmonic(ell, m, kv);
+
+          pk_mode *= ylm;
+          sn_mode *= ylm;
+
+          double pk_mode_real = pk_mode.real();
+          double pk_mode_imag = pk_mode.imag();
+          double sn_mode_real = sn_mode.real();
+          double sn_mode_imag = sn_mode.imag();
+
+          // Add contribution.
+OMP_ATOMIC
+          nmodes_sample[idx_k]++;
+OMP_ATOMIC
+          k_sample[idx_k] += k_;
+OMP_ATOMIC
+          pk_sample_real[idx_k] += pk_mode_real;
+OMP_ATOMIC
+          pk_sample_imag[idx_k] += pk_mode_imag;
+OMP_ATOMIC
+          sn_sample_real[idx_k] += sn_mode_real;
+OMP_ATOMIC
+          sn_sample_imag[idx_k] += sn_mode_imag;
+        }
+      }
+    }
+  }
+
+  for (int i = 0; i < n_sample; i++) {
+    pk_sample[i] = pk_sample_real[i] + trvm::M_I * pk_sample_imag[i];
+    sn_sample[i] = sn_sample_real[i] + trvm::M_I * sn_sample_imag[i];
+  }
+
+  // Perform binning.
+  for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+    double k_lower = kbinning.bin_edges[ibin];
+    double k_upper = kbinning.bin_edges[ibin + 1];
+    for (int i = 0; i < n_sample; i++) {
+      double k_ = i * dk_sample;
+      if (k_lower <= k_ && k_ < k_upper) {
+        this->nmodes[ibin] += nmodes_sample[i];
+        this->k[ibin] += k_sample[i];
+        this->pk[ibin] += pk_sample[i];
+        this->sn[ibin] += sn_sample[i];
+      }
+    }
+
+    if (this->nmodes[ibin] != 0) {
+      this->k[ibin] /= double(this->nmodes[ibin]);
+      this->pk[ibin] /= double(this->nmodes[ibin]);
+      this->sn[ibin] /= double(this->nmodes[ibin]);
+    } else {
+      this->k[ibin] = kbinning.bin_centres[ibin];
+      this->pk[ibin] = 0.;
+      this->sn[ibin] = 0.;
+    }
+  }
+}
+
+void FieldStats::compute_kmu_2pt_stats_in_fourier(
+  MeshField& field_a, MeshField& field_b, std::complex<double> shotnoise_amp,
+  const std::vector<int>& ells, int num_wedges, trv::Binning& kbinning
 ) {
-  double cellsizes[3];
-  if (binning.space == "config") {
-    cellsizes[0] = this->dr[0];
-    cellsizes[1] = this->dr[1];
-    cellsizes[2] = this->dr[2];
-  } else
-  if (binning.space == "fourier") {
-    cellsizes[0] = this->dk[0];
-    cellsizes[1] = this->dk[1];
-    cellsizes[2] = this->dk[2];
-  } else {
+  trvs::ScopedTimer timer(
+    "binning", trvs::size_in_gb<fftw_complex>(3*this->params.nmesh)
+  );
+
+  const int num_bins = kbinning.num_bins;
+  const int nells = static_cast<int>(ells.size());
+
+  this->resize_stats(num_bins);
+  this->reset_stats();
+
+  // Check mesh fields compatibility and reuse methods of the first mesh field.
+  if (!this->if_fields_compatible(field_a, field_b)) {
     trvs::logger.error(
-      "Invalid binning space: '%s'.", binning.space.c_str()
+      "Input mesh fields have incompatible physical properties."
     );
     throw trvs::InvalidDataError(
-      "Invalid binning space: '%s'.", binning.space.c_str()
+      "Input mesh fields have incompatible physical properties.\n"
     );
   }
 
-  // Restrict the mesh grid index ranges.
-  double b = binning.bin_max;
+  std::function<double(int, int, int)> calc_shotnoise_aliasing =
+    this->ret_calc_shotnoise_aliasing();
 
-  int lrange_upper[3], rrange_lower[3];
-  if (binning.space == "config") {
-    for (int iaxis = 0; iaxis < 3; iaxis++) {
-      lrange_upper[iaxis] = std::min(
-        std::ceil(b * this->params.ngrid[iaxis] / this->params.boxsize[iaxis]),
-        std::ceil(this->params.ngrid[iaxis]/2.)
-      );
-      rrange_lower[iaxis] = std::max(
-        std::floor(
-          this->params.ngrid[iaxis]
-          - b * this->params.ngrid[iaxis] / this->params.boxsize[iaxis]
-        ),
-        std::floor(this->params.ngrid[iaxis]/2.)
-      );
-    }
+  std::function<double(int, int, int)> calc_win_pk, calc_win_sn;
+  int assignment_order = this->params.assignment_order;
+  if (this->params.interlace == "true") {
+    calc_win_pk = [&field_a, &field_b, &assignment_order](
+      int i, int j, int k
+    ) {
+      return
+        field_a.calc_assignment_window_in_fourier(i, j, k, assignment_order)
+        * field_b.calc_assignment_window_in_fourier(i, j, k, assignment_order);
+    };
+    calc_win_sn = calc_win_pk;
   } else
-  if (binning.space == "fourier") {
-    for (int iaxis = 0; iaxis < 3; iaxis++) {
-      lrange_upper[iaxis] = std::min(
-        std::ceil(b * this->params.boxsize[iaxis] / (2*M_PI)),
-        std::ceil(this->params.ngrid[iaxis]/2.)
-      );
-      rrange_lower[iaxis] = std::max(
-        std::floor(
-          this->params.ngrid[iaxis]
-          - b * this->params.boxsize[iaxis] / (2*M_PI)
-        ),
-        std::floor(this->params.ngrid[iaxis]/2.)
-      );
-    }
+  if (this->params.interlace == "false") {
+#ifndef DBG_FLAG_NOAC
+    calc_win_sn = calc_shotnoise_aliasing;
+    calc_win_pk = calc_win_sn;
+#else   // !DBG_FLAG_NOAC
+    calc_win_pk = [&field_a, &field_b, &assignment_order](
+      int i, int j, int k
+    ) {
+      return
+        field_a.calc_assignment_window_in_fourier(i, j, k, assignment_order)
+        * field_b.calc_assignment_window_in_fourier(i, j, k, assignment_order);
+    };
+    calc_win_sn = calc_shotnoise_aliasing;
+#endif  // !DBG_FLAG_NOAC
   }
 
-  auto generate_range = [](
-    int lrange_lower, int lrange_upper, int rrange_lower, int rrange_upper
-  ) {
-    std::vector<int> range_vector;
-    if (lrange_upper < rrange_lower) {
-      for (int i = lrange_lower; i <= lrange_upper; i++) {
-          range_vector.push_back(i);
-      }
-      for (int i = rrange_lower; i <= rrange_upper; i++) {
-          range_vector.push_back(i);
-      }
-    } else {
-      // This can happen when sampling beyond the Nyquist scale.
-      for (int i = lrange_lower; i <= rrange_upper; i++) {
-          range_vector.push_back(i);
-      }
-    }
-    return range_vector;
-  };
-
-  std::vector<int> i_range = generate_range(
-    0, lrange_upper[0], rrange_lower[0], params.ngrid[0] - 1
-  );
-  std::vector<int> j_range = generate_range(
-    0, lrange_upper[1], rrange_lower[1], params.ngrid[1] - 1
-  );
-  std::vector<int> k_range = generate_range(
-    0, lrange_upper[2], rrange_lower[2], params.ngrid[2] - 1
-  );
+  // Modes are assigned to bins by their wavenumbers floored to the fine
+  // sampling step as in `compute_ylm_wgtd_2pt_stats_in_fourier`, so that
+  // mode counts agree exactly.
+  // CAVEAT: Discretionary choices such that 0.0 < k < 10.0.
+  const int n_sample = 1e6;
+  const double dk_sample = 1.e-5;
+  if (kbinning.bin_max > n_sample * dk_sample) {
+    trvs::logger.warn(
+      "Input bin range exceeds sampled range. "
+      "Statistics in bins beyond sampled range are uncomputed."
+    );
+  }
 
-  // Record the binned vectors.
-  trv::BinnedVectors binned_vectors;
+  // CAVEAT: Discretionary choice as in the reduced spherical harmonics.
+  const double eps_k = 1.e-9;
 
-  binned_vectors.num_bins = binning.num_bins;
+  int ell_max = 0;
+  for (int ell : ells) {ell_max = std::max(ell_max, ell);}
 
+  // Accumulate per contiguous chunk of cells, one per thread, instead of
+  // with atomic updates.  Accumulators hold the (k, μ) bins after the
+  // wavenumber bins, and per-chunk blocks are padded to separate cache
+  // lines.
+  int nchunks = 1;
 #ifdef TRV_USE_OMP
-#pragma omp parallel for collapse(3)
+  nchunks = omp_get_max_threads();
 #endif  // TRV_USE_OMP
-  for (int i: i_range) {
-    for (int j: j_range) {
-      for (int k: k_range) {
-        double vx = (i < this->params.ngrid[0]/2) ?
-          i * cellsizes[0] : (i - this->params.ngrid[0]) * cellsizes[0];
-        double vy = (j < this->params.ngrid[1]/2) ?
-          j * cellsizes[1] : (j - this->params.ngrid[1]) * cellsizes[1];
-        double vz = (k < this->params.ngrid[2]/2) ?
-          k * cellsizes[2] : (k - this->params.ngrid[2]) * cellsizes[2];
-
-        double scale = trvm::get_vec3d_magnitude({vx, vy, vz});
-
-OMP_CRITICAL
-{
-        for (int ibin = 0; ibin < binning.num_bins; ibin++) {
-          double bin_lower = binning.bin_edges[ibin];
-          double bin_upper = binning.bin_edges[ibin + 1];
-          if (bin_lower <= scale && scale < bin_upper) {
-            binned_vectors.indices.push_back(ibin);
-            binned_vectors.lower_edges.push_back(bin_lower);
-            binned_vectors.upper_edges.push_back(bin_upper);
-            binned_vectors.vecx.push_back(vx);
-            binned_vectors.vecy.push_back(vy);
-            binned_vectors.vecz.push_back(vz);
-            binned_vectors.count++;
-            break;
-          }
-        }
-}
-      }
-    }
-  }
 
-  trvs::gbytesMem += trvs::size_in_gb<double>(6*binned_vectors.count);
-  trvs::update_maxmem();
-
-  // Sort the binned vectors.
-  trv::BinnedVectors binned_vectors_sorted;
+  const long long ncells = this->params.nmesh;
+  auto chunk_begin = [&](int ichunk) { return ncells * ichunk / nchunks; };
 
-  binned_vectors_sorted.count = binned_vectors.count;
-  binned_vectors_sorted.num_bins = binned_vectors.num_bins;
+  const int nbins_kmu = num_bins * (1 + num_wedges);
+  const int stride = (nbins_kmu + 7) / 8 * 8;
+  const int stride_poles = (num_bins * nells + 3) / 4 * 4;
 
-  binned_vectors_sorted.indices.resize(binned_vectors.count);
-  binned_vectors_sorted.lower_edges.resize(binned_vectors.count);
-  binned_vectors_sorted.upper_edges.resize(binned_vectors.count);
-  binned_vectors_sorted.vecx.resize(binned_vectors.count);
-  binned_vectors_sorted.vecy.resize(binned_vectors.count);
-  binned_vectors_sorted.vecz.resize(binned_vectors.count);
+  std::vector<long long> nmodes_acc(nchunks * stride, 0);
+  std::vector<double> k_acc(nchunks * stride, 0.);
+  std::vector<double> mu_acc(nchunks * stride, 0.);
+  std::vector< std::complex<double> > pk_acc(nchunks * stride, 0.);
+  std::vector< std::complex<double> > sn_acc(nchunks * stride, 0.);
+  std::vector< std::complex<double> > pk_poles_acc(
+    nchunks * stride_poles, 0.
+  );
+  std::vector< std::complex<double> > sn_poles_acc(
+    nchunks * stride_poles, 0.
+  );
 
-  trvs::gbytesMem += trvs::size_in_gb<double>(6*binned_vectors.count);
+  trvs::gbytesMem += trvs::size_in_gb<double>(
+    nchunks * (7 * stride + 4 * stride_poles)
+  );
   trvs::update_maxmem();
 
-  std::vector<int> indices_sorted =
-    trv::array::get_sorted_indices(binned_vectors.indices);
-
-  trvs::gbytesMem += trvs::size_in_gb<int>(binned_vectors.count);
-  trvs::update_maxmem();
+  const int nj = this->params.ngrid[1];
+  const int nk = this->params.ngrid[2];
 
 #ifdef TRV_USE_OMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(static, 1)
 #endif  // TRV_USE_OMP
-  for (int i = 0; i < binned_vectors.count; i++) {
-    int idx = indices_sorted[i];
-    binned_vectors_sorted.indices[i] = binned_vectors.indices[idx];
-    binned_vectors_sorted.lower_edges[i] = binned_vectors.lower_edges[idx];
-    binned_vectors_sorted.upper_edges[i] = binned_vectors.upper_edges[idx];
-    binned_vectors_sorted.vecx[i] = binned_vectors.vecx[idx];
-    binned_vectors_sorted.vecy[i] = binned_vectors.vecy[idx];
-    binned_vectors_sorted.vecz[i] = binned_vectors.vecz[idx];
-  }
+  for (int ichunk = 0; ichunk < nchunks; ichunk++) {
+    long long* nmodes_chunk = &nmodes_acc[ichunk * stride];
+    double* k_chunk = &k_acc[ichunk * stride];
+    double* mu_chunk = &mu_acc[ichunk * stride];
+    std::complex<double>* pk_chunk = &pk_acc[ichunk * stride];
+    std::complex<double>* sn_chunk = &sn_acc[ichunk * stride];
+    std::complex<double>* pk_poles_chunk =
+      &pk_poles_acc[ichunk * stride_poles];
+    std::complex<double>* sn_poles_chunk =
+      &sn_poles_acc[ichunk * stride_poles];
+
+    std::vector<double> legendre(ell_max + 1);
+    for (
+      long long icell = chunk_begin(ichunk);
+      icell < chunk_begin(ichunk + 1);
+      icell++
+    ) {
+      int i = int(icell / (nj * nk));
+      int j = int((icell / nk) % nj);
+      int k = int(icell % nk);
+
+      double kv[3];
+      field_a.get_grid_wavevector(i, j, k, kv);
+
+      double k_ = trvm::get_vec3d_magnitude(kv);
+
+      int idx_k = int(k_ / dk_sample);
+      if (idx_k < 0 || idx_k >= n_sample) {continue;}
+
+      int ibin = int(
+        std::upper_bound(
+          kbinning.bin_edges.begin(),
+          kbinning.bin_edges.begin() + num_bins + 1,
+          idx_k * dk_sample
+        ) - kbinning.bin_edges.begin()
+      ) - 1;
+      if (ibin < 0 || ibin >= num_bins) {continue;}
+
+      long long idx_grid = field_a.ret_grid_index(i, j, k);
+
+      std::complex<double> fa(field_a[idx_grid][0], field_a[idx_grid][1]);
+      std::complex<double> fb(field_b[idx_grid][0], field_b[idx_grid][1]);
+
+      std::complex<double> pk_mode = fa * std::conj(fb);
+      std::complex<double> sn_mode =
+        shotnoise_amp * calc_shotnoise_aliasing(i, j, k);
+
+      // Apply grid corrections.
+      pk_mode /= calc_win_pk(i, j, k);
+      sn_mode /= calc_win_sn(i, j, k);
+
+      // Evaluate the Legendre polynomials by recurrence, which vanish
+      // for the zero mode except at zero degree.
+      double mu = (k_ < eps_k) ? 0. : kv[2] / k_;
+
+      legendre[0] = 1.;
+      for (int ell = 1; ell <= ell_max; ell++) {
+        if (k_ < eps_k) {
+          legendre[ell] = 0.;
+        } else
+        if (ell == 1) {
+          legendre[ell] = mu;
+        } else {
+          legendre[ell] = (
+            (2*ell - 1) * mu * legendre[ell - 1]
+            - (ell - 1) * legendre[ell - 2]
+          ) / ell;
+        }
+      }
 
-  // Save the binned vectors.
-  if (save_file != "") {
-    std::FILE* save_fileptr = std::fopen(save_file.c_str(), "w");
-    trv::io::print_binned_vectors_to_file(
-      save_fileptr, this->params, binned_vectors_sorted
-    );
-    std::fclose(save_fileptr);
+      // Add contributions.
+      nmodes_chunk[ibin]++;
+      k_chunk[ibin] += k_;
+      for (int iell = 0; iell < nells; iell++) {
+        double legendre_ell = legendre[ells[iell]];
+        pk_poles_chunk[iell * num_bins + ibin] += legendre_ell * pk_mode;
+        sn_poles_chunk[iell * num_bins + ibin] += legendre_ell * sn_mode;
+      }
 
-    if (trvs::currTask == 0) {
-      trvs::logger.info(
-        "Check binned-vectors file for reference: %s.", save_file.c_str()
-      );
+      if (num_wedges > 0) {
+        double mu_abs = std::fabs(mu);
+        int imu = std::min(int(mu_abs * num_wedges), num_wedges - 1);
+        int idx_kmu = (1 + imu) * num_bins + ibin;
+
+        nmodes_chunk[idx_kmu]++;
+        k_chunk[idx_kmu] += k_;
+        mu_chunk[idx_kmu] += mu_abs;
+        pk_chunk[idx_kmu] += pk_mode;
+        sn_chunk[idx_kmu] += sn_mode;
+      }
     }
   }
 
-  trvs::gbytesMem -= trvs::size_in_gb<double>(2*6*binned_vectors.count);
-  trvs::gbytesMem -= trvs::size_in_gb<int>(binned_vectors.count);
+  // Reduce over chunks and average in bins.
+  this->pk_poles.assign(num_bins * nells, 0.);
+  this->sn_poles.assign(num_bins * nells, 0.);
+  this->nmodes_wedges.assign(num_bins * num_wedges, 0);
+  this->k_wedges.assign(num_bins * num_wedges, 0.);
+  this->mu_wedges.assign(num_bins * num_wedges, 0.);
+  this->pk_wedges.assign(num_bins * num_wedges, 0.);
+  this->sn_wedges.assign(num_bins * num_wedges, 0.);
+
+  for (int ichunk = 0; ichunk < nchunks; ichunk++) {
+    for (int ibin = 0; ibin < num_bins; ibin++) {
+      this->nmodes[ibin] += nmodes_acc[ichunk * stride + ibin];
+      this->k[ibin] += k_acc[ichunk * stride + ibin];
+    }
+    for (int idx = 0; idx < num_bins * nells; idx++) {
+      this->pk_poles[idx] += pk_poles_acc[ichunk * stride_poles + idx];
+      this->sn_poles[idx] += sn_poles_acc[ichunk * stride_poles + idx];
+    }
+    for (int idx = 0; idx < num_bins * num_wedges; idx++) {
+      int idx_acc = ichunk * stride + num_bins + idx;
+      this->nmodes_wedges[idx] += nmodes_acc[idx_acc];
+      this->k_wedges[idx] += k_acc[idx_acc];
+      this->mu_wedges[idx] += mu_acc[idx_acc];
+      this->pk_wedges[idx] += pk_acc[idx_acc];
+      this->sn_wedges[idx] += sn_acc[idx_acc];
+    }
+  }
 
-  return binned_vectors_sorted;
-}
+  trvs::gbytesMem -= trvs::size_in_gb<double>(
+    nchunks * (7 * stride + 4 * stride_poles)
+  );
 
+  for (int ibin = 0; ibin < num_bins; ibin++) {
+    if (this->nmodes[ibin] != 0) {
+      this->k[ibin] /= double(this->nmodes[ibin]);
+      for (int iell = 0; iell < nells; iell++) {
+        this->pk_poles[iell * num_bins + ibin] /= double(this->nmodes[ibin]);
+        this->sn_poles[iell * num_bins + ibin] /= double(this->nmodes[ibin]);
+      }
+    } else {
+      this->k[ibin] = kbinning.bin_centres[ibin];
+    }
 
-// -----------------------------------------------------------------------
-// Binned statistics
-// -----------------------------------------------------------------------
+    for (int imu = 0; imu < num_wedges; imu++) {
+      int idx = imu * num_bins + ibin;
+      if (this->nmodes_wedges[idx] != 0) {
+        this->k_wedges[idx] /= double(this->nmodes_wedges[idx]);
+        this->mu_wedges[idx] /= double(this->nmodes_wedges[idx]);
+        this->pk_wedges[idx] /= double(this->nmodes_wedges[idx]);
+        this->sn_wedges[idx] /= double(this->nmodes_wedges[idx]);
+      } else {
+        this->k_wedges[idx] = kbinning.bin_centres[ibin];
+        this->mu_wedges[idx] = (imu + .5) / num_wedges;
+      }
+    }
+  }
+}
 
-void FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier(
-  MeshField& field_a, MeshField& field_b, std::complex<double> shotnoise_amp,
-  int ell, int m, trv::Binning& kbinning
+void FieldStats::compute_los_moment_wgtd_2pt_stats_in_fourier(
+  MeshField& field_a, MeshField& field_b,
+  const std::vector<double>& shotnoise_amps,
+  const trvm::CartesianMomentCalculator& moment_calc,
+  trv::Binning& kbinning
 ) {
+  trvs::ScopedTimer timer(
+    "binning", trvs::size_in_gb<fftw_complex>(3*this->params.nmesh)
+  );
+
   this->resize_stats(kbinning.num_bins);
 
   // Check mesh fields compatibility and reuse methods of the first mesh field.
@@ -1862,22 +3629,12 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier(
     );
   }
 
-  int* nmodes_sample = new int[n_sample];
-  double* k_sample = new double[n_sample];
-  double* pk_sample_real = new double[n_sample];
-  double* pk_sample_imag = new double[n_sample];
-  double* sn_sample_real = new double[n_sample];
-  double* sn_sample_imag = new double[n_sample];
-  std::complex<double>* pk_sample = new std::complex<double>[n_sample];
-  std::complex<double>* sn_sample = new std::complex<double>[n_sample];
-  for (int i = 0; i < n_sample; i++) {
-    nmodes_sample[i] = 0;
-    k_sample[i] = 0.;
-    pk_sample_real[i] = 0.;
-    pk_sample_imag[i] = 0.;
-    sn_sample_real[i] = 0.;
-    sn_sample_imag[i] = 0.;
-  }
+  trvs::TrackedVector<long long> nmodes_sample(n_sample);
+  trvs::TrackedVector<double> k_sample(n_sample);
+  trvs::TrackedVector<double> pk_sample_real(n_sample);
+  trvs::TrackedVector<double> pk_sample_imag(n_sample);
+  trvs::TrackedVector<double> sn_sample_real(n_sample);
+  trvs::TrackedVector< std::complex<double> > pk_sample(n_sample);
 
   this->reset_stats();
 
@@ -1899,9 +3656,17 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier(
           std::complex<double> fa(field_a[idx_grid][0], field_a[idx_grid][1]);
           std::complex<double> fb(field_b[idx_grid][0], field_b[idx_grid][1]);
 
+          // Weight the shot noise by the Cartesian moments.
+          double weights_[2*trvm::CartesianMomentCalculator::ell_max + 1];
+          moment_calc.calc_wavevector_weights(kv, weights_);
+
+          double shotnoise_amp = 0.;
+          for (int ib = 0; ib < moment_calc.nmoments; ib++) {
+            shotnoise_amp += shotnoise_amps[ib] * weights_[ib];
+          }
+
           std::complex<double> pk_mode = fa * std::conj(fb);
-          std::complex<double> sn_mode =
-            shotnoise_amp * calc_shotnoise_aliasing(i, j, k);
+          double sn_mode = shotnoise_amp * calc_shotnoise_aliasing(i, j, k);
 
           // Apply grid corrections.
           double win_pk = calc_win_pk(i, j, k);
@@ -1910,17 +3675,8 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier(
           pk_mode /= win_pk;
           sn_mode /= win_sn;
 
-          // Weight by reduced spherical harmonics.
-          std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-            calc_reduced_spherical_harmonic(ell, m, kv);
-
-          pk_mode *= ylm;
-          sn_mode *= ylm;
-
           double pk_mode_real = pk_mode.real();
           double pk_mode_imag = pk_mode.imag();
-          double sn_mode_real = sn_mode.real();
-          double sn_mode_imag = sn_mode.imag();
 
           // Add contribution.
 OMP_ATOMIC
@@ -1932,9 +3688,7 @@ OMP_ATOMIC
 OMP_ATOMIC
           pk_sample_imag[idx_k] += pk_mode_imag;
 OMP_ATOMIC
-          sn_sample_real[idx_k] += sn_mode_real;
-OMP_ATOMIC
-          sn_sample_imag[idx_k] += sn_mode_imag;
+          sn_sample_real[idx_k] += sn_mode;
         }
       }
     }
@@ -1942,7 +3696,6 @@ OMP_ATOMIC
 
   for (int i = 0; i < n_sample; i++) {
     pk_sample[i] = pk_sample_real[i] + trvm::M_I * pk_sample_imag[i];
-    sn_sample[i] = sn_sample_real[i] + trvm::M_I * sn_sample_imag[i];
   }
 
   // Perform binning.
@@ -1955,7 +3708,7 @@ OMP_ATOMIC
         this->nmodes[ibin] += nmodes_sample[i];
         this->k[ibin] += k_sample[i];
         this->pk[ibin] += pk_sample[i];
-        this->sn[ibin] += sn_sample[i];
+        this->sn[ibin] += sn_sample_real[i];
       }
     }
 
@@ -1969,21 +3722,16 @@ OMP_ATOMIC
       this->sn[ibin] = 0.;
     }
   }
-
-  delete[] nmodes_sample;
-  delete[] k_sample;
-  delete[] pk_sample_real;
-  delete[] pk_sample_imag;
-  delete[] sn_sample_real;
-  delete[] sn_sample_imag;
-  delete[] pk_sample;
-  delete[] sn_sample;
 }
 
 void FieldStats::compute_ylm_wgtd_2pt_stats_in_config(
   MeshField& field_a, MeshField& field_b, std::complex<double> shotnoise_amp,
   int ell, int m, trv::Binning& rbinning
 ) {
+  trvs::ScopedTimer timer(
+    "binning", trvs::size_in_gb<fftw_complex>(3*this->params.nmesh)
+  );
+
   this->resize_stats(rbinning.num_bins);
 
   // Check mesh fields compatibility and reuse properties and methods of
@@ -2041,7 +3789,7 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_config(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
     this->twopt_3d[gid][0] = 0.;
     this->twopt_3d[gid][1] = 0.;
   }  // likely redundant but safe
@@ -2075,12 +3823,17 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_config(
   }
 
   // Inverse Fourier transform.
-  if (this->plan_ini) {
-    fftw_execute(this->inv_transform);
-  } else {
-    fftw_execute_dft(field_a.inv_transform, twopt_3d, twopt_3d);
+  {
+    trvs::ScopedTimer timer_fft(
+      "fft", trvs::size_in_gb<fftw_complex>(2*this->params.nmesh)
+    );
+    if (this->plan_ini) {
+      fftw_execute(this->inv_transform);
+    } else {
+      fftw_execute_dft(field_a.inv_transform, twopt_3d, twopt_3d);
+    }
+    trvs::count_ifft += 1;
   }
-  trvs::count_ifft += 1;
 
   // Perform fine binning.
   // NOTE: Dynamically allocate owing to size.
@@ -2094,17 +3847,11 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_config(
     );
   }
 
-  int* npairs_sample = new int[n_sample];
-  double* r_sample = new double[n_sample];
-  double* xi_sample_real = new double[n_sample];
-  double* xi_sample_imag = new double[n_sample];
-  std::complex<double>* xi_sample = new std::complex<double>[n_sample];
-  for (int i = 0; i < n_sample; i++) {
-    npairs_sample[i] = 0;
-    r_sample[i] = 0.;
-    xi_sample_real[i] = 0.;
-    xi_sample_imag[i] = 0.;
-  }
+  trvs::TrackedVector<long long> npairs_sample(n_sample);
+  trvs::TrackedVector<double> r_sample(n_sample);
+  trvs::TrackedVector<double> xi_sample_real(n_sample);
+  trvs::TrackedVector<double> xi_sample_imag(n_sample);
+  trvs::TrackedVector< std::complex<double> > xi_sample(n_sample);
 
   this->reset_stats();
 
@@ -2176,18 +3923,12 @@ OMP_ATOMIC
       this->xi[ibin] = 0.;
     }
   }
-
-  delete[] npairs_sample;
-  delete[] r_sample;
-  delete[] xi_sample_real;
-  delete[] xi_sample_imag;
-  delete[] xi_sample;
 }
 
 void FieldStats::compute_uncoupled_shotnoise_for_3pcf(
   MeshField& field_a, MeshField& field_b,
-  std::vector< std::complex<double> >& ylm_a,
-  std::vector< std::complex<double> >& ylm_b,
+  trvs::TrackedVector< std::complex<double> >& ylm_a,
+  trvs::TrackedVector< std::complex<double> >& ylm_b,
   std::complex<double> shotnoise_amp,
   trv::Binning& rbinning
 ) {
@@ -2195,6 +3936,10 @@ void FieldStats::compute_uncoupled_shotnoise_for_3pcf(
     trvs::logger.debug("Computing uncoupled shot noise for 3PCF.");
   }
 
+  trvs::ScopedTimer timer(
+    "shotnoise", trvs::size_in_gb<fftw_complex>(3*this->params.nmesh)
+  );
+
   this->resize_stats(rbinning.num_bins);
 
   // Check mesh fields compatibility and reuse properties and methods of
@@ -2252,7 +3997,7 @@ void FieldStats::compute_uncoupled_shotnoise_for_3pcf(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
     this->twopt_3d[gid][0] = 0.;
     this->twopt_3d[gid][1] = 0.;
   }  // likely redundant but safe
@@ -2289,12 +4034,17 @@ void FieldStats::compute_uncoupled_shotnoise_for_3pcf(
   }
 
   // Inverse Fourier transform.
-  if (this->plan_ini) {
-    fftw_execute(this->inv_transform);
-  } else {
-    fftw_execute_dft(field_a.inv_transform, twopt_3d, twopt_3d);
+  {
+    trvs::ScopedTimer timer_fft(
+      "fft", trvs::size_in_gb<fftw_complex>(2*this->params.nmesh)
+    );
+    if (this->plan_ini) {
+      fftw_execute(this->inv_transform);
+    } else {
+      fftw_execute_dft(field_a.inv_transform, twopt_3d, twopt_3d);
+    }
+    trvs::count_ifft += 1;
   }
-  trvs::count_ifft += 1;
 
   // Perform fine binning.
   // NOTE: Dynamically allocate owing to size.
@@ -2302,17 +4052,11 @@ void FieldStats::compute_uncoupled_shotnoise_for_3pcf(
   const int n_sample = 1e5;
   const double dr_sample = 1.;
 
-  int* npairs_sample = new int[n_sample];
-  double* r_sample = new double[n_sample];
-  double* xi_sample_real = new double[n_sample];
-  double* xi_sample_imag = new double[n_sample];
-  std::complex<double>* xi_sample = new std::complex<double>[n_sample];
-  for (int i = 0; i < n_sample; i++) {
-    npairs_sample[i] = 0;
-    r_sample[i] = 0.;
-    xi_sample_real[i] = 0.;
-    xi_sample_imag[i] = 0.;
-  }
+  trvs::TrackedVector<long long> npairs_sample(n_sample);
+  trvs::TrackedVector<double> r_sample(n_sample);
+  trvs::TrackedVector<double> xi_sample_real(n_sample);
+  trvs::TrackedVector<double> xi_sample_imag(n_sample);
+  trvs::TrackedVector< std::complex<double> > xi_sample(n_sample);
 
   this->reset_stats();
 
@@ -2391,19 +4135,13 @@ OMP_ATOMIC
       // this->npairs[ibin] /= 2;  // reality condition
     }
   }
-
-  delete[] npairs_sample;
-  delete[] r_sample;
-  delete[] xi_sample_real;
-  delete[] xi_sample_imag;
-  delete[] xi_sample;
 }
 
 std::complex<double> \
 FieldStats::compute_uncoupled_shotnoise_for_bispec_per_bin(
   MeshField& field_a, MeshField& field_b,
-  std::vector< std::complex<double> >& ylm_a,
-  std::vector< std::complex<double> >& ylm_b,
+  trvs::TrackedVector< std::complex<double> >& ylm_a,
+  trvs::TrackedVector< std::complex<double> >& ylm_b,
   trvm::SphericalBesselCalculator& sj_a, trvm::SphericalBesselCalculator& sj_b,
   std::complex<double> shotnoise_amp,
   double k_a, double k_b
@@ -2416,6 +4154,10 @@ FieldStats::compute_uncoupled_shotnoise_for_bispec_per_bin(
     );
   }
 
+  trvs::ScopedTimer timer(
+    "shotnoise", trvs::size_in_gb<fftw_complex>(3*this->params.nmesh)
+  );
+
   // Check mesh fields compatibility and reuse properties and methods of
   // the first mesh field.
   if (!this->if_fields_compatible(field_a, field_b)) {
@@ -2471,7 +4213,7 @@ FieldStats::compute_uncoupled_shotnoise_for_bispec_per_bin(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (long long gid = 0; gid < this->params.nmesh; gid++) {
     this->twopt_3d[gid][0] = 0.;
     this->twopt_3d[gid][1] = 0.;
   }  // likely redundant but safe
@@ -2508,12 +4250,17 @@ FieldStats::compute_uncoupled_shotnoise_for_bispec_per_bin(
   }
 
   // Inverse Fourier transform.
-  if (this->plan_ini) {
-    fftw_execute(this->inv_transform);
-  } else {
-    fftw_execute_dft(field_a.inv_transform, twopt_3d, twopt_3d);
+  {
+    trvs::ScopedTimer timer_fft(
+      "fft", trvs::size_in_gb<fftw_complex>(2*this->params.nmesh)
+    );
+    if (this->plan_ini) {
+      fftw_execute(this->inv_transform);
+    } else {
+      fftw_execute_dft(field_a.inv_transform, twopt_3d, twopt_3d);
+    }
+    trvs::count_ifft += 1;
   }
-  trvs::count_ifft += 1;
 
   // Weight by spherical Bessel functions and harmonics before summing
   // over the configuration-space grids.
@@ -2573,6 +4320,14 @@ FieldStats::compute_uncoupled_shotnoise_for_bispec_per_bin(
 
 std::function<double(int, int, int)> FieldStats::ret_calc_shotnoise_aliasing()
 {
+  // CAVEAT: Discretionary choice such that interlacing of order 2
+  // retains the full aliasing sum.
+  if (
+    this->params.interlace == "true" && this->params.interlace_order > 2
+  ) {
+    return this->ret_calc_shotnoise_aliasing_interlaced();
+  }
+
   if (this->params.assignment == "ngp") {
     return [this](int i, int j, int k) {
       return calc_shotnoise_aliasing_ngp(i, j, k);
@@ -2602,6 +4357,40 @@ std::function<double(int, int, int)> FieldStats::ret_calc_shotnoise_aliasing()
   );
 }
 
+std::function<double(int, int, int)>
+FieldStats::ret_calc_shotnoise_aliasing_interlaced() {
+  // Tabulate the centred B-spline of twice the assignment order,
+  // i.e. the self-convolution of the assignment kernel, at the
+  // shifted grid points B(m + s) for m = -p, ..., p and s = j/N.
+  const int q = 2 * this->params.assignment_order;
+  const int order = this->params.interlace_order;
+
+  double fact = 1.;
+  for (int n = 1; n < q; n++) {fact *= n;}
+
+  std::vector<double> bspline;
+  for (int ishift = 0; ishift < order; ishift++) {
+    for (int m = - q/2; m <= q/2; m++) {
+      double x = m + double(ishift) / order;
+
+      double val = 0.;
+      double binom = 1.;
+      for (int n = 0; n <= q; n++) {
+        double xn = x + q/2. - n;
+        if (xn > 0.) {
+          val += ((n % 2 == 0) ? 1. : -1.) * binom * std::pow(xn, q - 1);
+        }
+        binom *= double(q - n) / (n + 1);
+      }
+      bspline.push_back(std::max(val / fact, 0.));
+    }
+  }
+
+  return [this, bspline](int i, int j, int k) {
+    return calc_shotnoise_aliasing_interlaced(i, j, k, bspline);
+  };
+}
+
 void FieldStats::get_shotnoise_aliasing_sin2(
   int i, int j, int k, double& cx2, double& cy2, double& cz2
 ) {
@@ -2647,4 +4436,47 @@ double FieldStats::calc_shotnoise_aliasing_pcs(int i, int j, int k) {
     * (1. - 4./3. * cz2 + 2./5. * cz2 * cz2 - 4./315. * cz2 * cz2 * cz2);
 }
 
+double FieldStats::calc_shotnoise_aliasing_interlaced(
+  int i, int j, int k, const std::vector<double>& bspline
+) {
+  const int order = this->params.interlace_order;
+  const int nterms = 2 * this->params.assignment_order + 1;
+
+  // Calculate the wavevector components in units of the sampling
+  // wavenumber (consistent with the interlacing phase factors).
+  double u[3];
+  u[0] = (i < this->params.ngrid[0]/2)
+    ? double(i) / this->params.ngrid[0]
+    : double(i) / this->params.ngrid[0] - 1;
+  u[1] = (j < this->params.ngrid[1]/2)
+    ? double(j) / this->params.ngrid[1]
+    : double(j) / this->params.ngrid[1] - 1;
+  u[2] = (k < this->params.ngrid[2]/2)
+    ? double(k) / this->params.ngrid[2]
+    : double(k) / this->params.ngrid[2] - 1;
+
+  double aliasing = 0.;
+  for (int ishift = 0; ishift < order; ishift++) {
+    double shift = double(ishift) / order;
+
+    // Σₙ W²(u + n) e^{-2πi n s} = e^{2πi u s} Σₘ B(m + s) e^{2πi m u},
+    // where m = -p, ..., p for the assignment order p.
+    std::complex<double> aliasing_shift = 1.;
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      std::complex<double> aliasing_axis = 0.;
+      for (int iterm = 0; iterm < nterms; iterm++) {
+        int m = iterm - this->params.assignment_order;
+        aliasing_axis += std::polar(
+          bspline[ishift * nterms + iterm], 2.*M_PI * (m + shift) * u[iaxis]
+        );
+      }
+      aliasing_shift *= aliasing_axis;
+    }
+
+    aliasing += aliasing_shift.real();
+  }
+
+  return aliasing / order;
+}
+
 }  // namespace trv
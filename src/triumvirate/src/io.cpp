@@ -26,6 +26,14 @@
 
 #include "io.hpp"
 
+#include <algorithm>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
 namespace trv {
 
 // ***********************************************************************
@@ -72,17 +80,266 @@ void make_write_dir(std::string dirstr) {
 }  // namespace trv::sys
 
 
+// ***********************************************************************
+// Checksums
+// ***********************************************************************
+
+namespace sys {
+
+std::uint64_t update_data_hash(
+  const void* data, std::size_t nbytes, std::uint64_t hash
+) {
+  const std::uint64_t prime = 1099511628211ULL;
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+  // Hash by 8-byte words (copied to avoid unaligned access) and then
+  // by the remaining bytes.
+  std::size_t nwords = nbytes / sizeof(std::uint64_t);
+  for (std::size_t iword = 0; iword < nwords; iword++) {
+    std::uint64_t word;
+    std::memcpy(&word, bytes + iword * sizeof(word), sizeof(word));
+    hash ^= word;
+    hash *= prime;
+    hash ^= hash >> 32;  // fold high bits into low bits
+  }
+  for (
+    std::size_t ibyte = nwords * sizeof(std::uint64_t);
+    ibyte < nbytes;
+    ibyte++
+  ) {
+    hash ^= bytes[ibyte];
+    hash *= prime;
+  }
+
+  return hash;
+}
+
+std::string format_data_hash(std::uint64_t hash) {
+  char hash_str[17];
+  std::snprintf(
+    hash_str, sizeof(hash_str), "%016llx",
+    static_cast<unsigned long long>(hash)
+  );
+  return std::string(hash_str);
+}
+
+}  // namespace trv::sys
+
+
 // ***********************************************************************
 // Files
 // ***********************************************************************
 
 namespace io {
 
+// -----------------------------------------------------------------------
+// Binary records
+// -----------------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief Write a little-endian unsigned integer to a binary file.
+ *
+ * @param fileptr File to write to.
+ * @param value Integer value.
+ * @param nbytes Number of bytes.
+ */
+void write_binary_uint(std::FILE* fileptr, std::uint64_t value, int nbytes) {
+  unsigned char bytes[8];
+  for (int ibyte = 0; ibyte < nbytes; ibyte++) {
+    bytes[ibyte] = (value >> (8 * ibyte)) & 0xFF;
+  }
+  std::fwrite(bytes, 1, nbytes, fileptr);
+}
+
+/**
+ * @brief Write a length-prefixed string to a binary file.
+ *
+ * @param fileptr File to write to.
+ * @param str String.
+ */
+void write_binary_string(std::FILE* fileptr, const std::string& str) {
+  write_binary_uint(fileptr, str.size(), 4);
+  std::fwrite(str.data(), 1, str.size(), fileptr);
+}
+
+/**
+ * @brief Get the native byte-order character of NumPy type strings.
+ *
+ * @returns '<' (little-endian) or '>' (big-endian).
+ */
+char get_native_byteorder() {
+  const std::uint16_t probe = 1;
+  return (*reinterpret_cast<const unsigned char*>(&probe) == 1) ? '<' : '>';
+}
+
+/**
+ * @brief Get the NumPy type string of a native data type.
+ *
+ * @tparam T Data type.
+ * @returns NumPy type string.
+ */
+template <typename T>
+std::string get_binary_typestr();
+
+template <>
+std::string get_binary_typestr<int>() {
+  return get_native_byteorder() + std::string("i4");
+}
+
+template <>
+std::string get_binary_typestr<long long>() {
+  return get_native_byteorder() + std::string("i8");
+}
+
+template <>
+std::string get_binary_typestr<double>() {
+  return get_native_byteorder() + std::string("f8");
+}
+
+template <>
+std::string get_binary_typestr< std::complex<double> >() {
+  return get_native_byteorder() + std::string("c16");
+}
+
+/**
+ * @brief Write a typed array record to a binary file.
+ *
+ * @param fileptr File to write to.
+ * @param name Record name.
+ * @param typestr NumPy type string.
+ * @param shape Array shape.
+ * @param data Array data in C order.
+ * @param nbytes Number of data bytes.
+ */
+void write_binary_record(
+  std::FILE* fileptr, const std::string& name, const std::string& typestr,
+  const std::vector<std::uint64_t>& shape, const void* data,
+  std::size_t nbytes
+) {
+  write_binary_string(fileptr, name);
+  write_binary_string(fileptr, typestr);
+  write_binary_uint(fileptr, shape.size(), 4);
+  for (std::uint64_t length : shape) {
+    write_binary_uint(fileptr, length, 8);
+  }
+  if (nbytes > 0) {
+    std::fwrite(data, 1, nbytes, fileptr);
+  }
+}
+
+/**
+ * @brief Write a 1-d array record to a binary file.
+ *
+ * @tparam T Data type.
+ * @param fileptr File to write to.
+ * @param name Record name.
+ * @param array Array.
+ * @param size Number of array elements written.
+ */
+template <typename T>
+void write_binary_array(
+  std::FILE* fileptr, const std::string& name,
+  const std::vector<T>& array, int size
+) {
+  write_binary_record(
+    fileptr, name, get_binary_typestr<T>(), {std::uint64_t(size)},
+    array.data(), size * sizeof(T)
+  );
+}
+
+/**
+ * @brief Capture text printed to a file as a string.
+ *
+ * @param printer Function printing to a file.
+ * @returns Printed text.
+ */
+std::string capture_printed_text(std::function<void(std::FILE*)> printer) {
+  char* buffer = nullptr;
+  std::size_t size = 0;
+  std::FILE* memptr = open_memstream(&buffer, &size);
+  printer(memptr);
+  std::fclose(memptr);
+
+  std::string text(buffer, size);
+  std::free(buffer);
+
+  return text;
+}
+
+/**
+ * @brief Write the file signature and header records to a binary file.
+ *
+ * @param fileptr File to write to.
+ * @param header Header text.
+ * @param profile If `true`, also write the stage profile records.
+ */
+void write_binary_header(
+  std::FILE* fileptr, const std::string& header, bool profile
+) {
+  std::fwrite(binary_signature, 1, std::strlen(binary_signature), fileptr);
+
+  write_binary_record(
+    fileptr, "header", "|S" + std::to_string(header.size()), {},
+    header.data(), header.size()
+  );
+
+  if (!profile) {return;}
+
+  const std::vector<std::string>& stages = trv::sys::profiler.stages;
+  const int nstages = stages.size();
+
+  std::size_t len_stage = 1;
+  for (const std::string& stage : stages) {
+    len_stage = std::max(len_stage, stage.size());
+  }
+
+  std::string stage_names(nstages * len_stage, '\0');
+  std::vector<long long> ncalls(nstages);
+  std::vector<double> time_total(nstages), time_self(nstages);
+  std::vector<double> gbytes(nstages), gbytes_mem(nstages);
+  std::vector<int> nthreads(nstages);
+  for (int istage = 0; istage < nstages; istage++) {
+    const trv::sys::StageProfile& stage_profile =
+      trv::sys::profiler.profiles[stages[istage]];
+    stages[istage].copy(&stage_names[istage * len_stage], len_stage);
+    ncalls[istage] = stage_profile.ncalls;
+    time_total[istage] = stage_profile.time_total;
+    time_self[istage] = stage_profile.time_self;
+    gbytes[istage] = stage_profile.gbytes;
+    gbytes_mem[istage] = stage_profile.gbytes_mem;
+    nthreads[istage] = stage_profile.nthreads;
+  }
+
+  write_binary_record(
+    fileptr, "profile/stage", "|S" + std::to_string(len_stage),
+    {std::uint64_t(nstages)}, stage_names.data(), stage_names.size()
+  );
+  write_binary_array(fileptr, "profile/ncalls", ncalls, nstages);
+  write_binary_array(fileptr, "profile/time_total", time_total, nstages);
+  write_binary_array(fileptr, "profile/time_self", time_self, nstages);
+  write_binary_array(fileptr, "profile/gbytes", gbytes, nstages);
+  write_binary_array(fileptr, "profile/gbytes_mem", gbytes_mem, nstages);
+  write_binary_array(fileptr, "profile/nthreads", nthreads, nstages);
+}
+
+}  // namespace
+
+
 // -----------------------------------------------------------------------
 // Pre-measurement header
 // -----------------------------------------------------------------------
 
-void print_measurement_header_to_file(
+namespace {
+
+
+/**
+ * @brief Print the measurement header text for paired catalogues.
+ *
+ * @see @ref trv::io::print_measurement_header_to_file
+ */
+void print_measurement_header_text(
   std::FILE* fileptr, trv::ParameterSet& params,
   trv::ParticleCatalogue& catalogue_data,
   trv::ParticleCatalogue& catalogue_rand,
@@ -95,7 +352,7 @@ void print_measurement_header_to_file(
   );
   std::fprintf(
     fileptr,
-    "%s Data catalogue size: ntotal = %d, wtotal = %.3f, wstotal = %.3f\n",
+    "%s Data catalogue size: ntotal = %lld, wtotal = %.3f, wstotal = %.3f\n",
     comment_delimiter,
     catalogue_data.ntotal, catalogue_data.wtotal, catalogue_data.wstotal
   );
@@ -115,7 +372,7 @@ void print_measurement_header_to_file(
   );
   std::fprintf(
     fileptr,
-    "%s Random catalogue size: ntotal = %d, wtotal = %.3f, wstotal = %.3f\n",
+    "%s Random catalogue size: ntotal = %lld, wtotal = %.3f, wstotal = %.3f\n",
     comment_delimiter,
     catalogue_rand.ntotal, catalogue_rand.wtotal, catalogue_rand.wstotal
   );
@@ -147,11 +404,14 @@ void print_measurement_header_to_file(
     comment_delimiter,
     params.ngrid[0], params.ngrid[1], params.ngrid[2]
   );
+  // Interlacing of order > 2 is recorded by its order.
+  std::string interlace_str = (params.interlace_order > 2)
+    ? std::to_string(params.interlace_order) : params.interlace;
   std::fprintf(
     fileptr,
     "%s Mesh assignment and interlacing: %s, %s\n",
     comment_delimiter,
-    params.assignment.c_str(), params.interlace.c_str()
+    params.assignment.c_str(), interlace_str.c_str()
   );
 
   if (params.norm_convention == "none") {
@@ -190,9 +450,16 @@ void print_measurement_header_to_file(
     comment_delimiter,
     norm_factor_part, norm_factor_mesh, norm_factor_meshes
   );
+
+  print_stage_profile_to_file(fileptr);
 }
 
-void print_measurement_header_to_file(
+/**
+ * @brief Print the measurement header text for a single catalogue.
+ *
+ * @see @ref trv::io::print_measurement_header_to_file
+ */
+void print_measurement_header_text(
   std::FILE* fileptr,
   trv::ParameterSet& params, trv::ParticleCatalogue& catalogue,
   double norm_factor_part, double norm_factor_mesh, double norm_factor_meshes
@@ -204,7 +471,7 @@ void print_measurement_header_to_file(
   );
   std::fprintf(
     fileptr,
-    "%s Catalogue size: ntotal = %d, wtotal = %.3f, wstotal = %.3f\n",
+    "%s Catalogue size: ntotal = %lld, wtotal = %.3f, wstotal = %.3f\n",
     comment_delimiter, catalogue.ntotal, catalogue.wtotal, catalogue.wstotal
   );
   std::fprintf(
@@ -235,11 +502,14 @@ void print_measurement_header_to_file(
     comment_delimiter,
     params.ngrid[0], params.ngrid[1], params.ngrid[2]
   );
+  // Interlacing of order > 2 is recorded by its order.
+  std::string interlace_str = (params.interlace_order > 2)
+    ? std::to_string(params.interlace_order) : params.interlace;
   std::fprintf(
     fileptr,
     "%s Mesh assignment and interlacing: %s, %s\n",
     comment_delimiter,
-    params.assignment.c_str(), params.interlace.c_str()
+    params.assignment.c_str(), interlace_str.c_str()
   );
 
   if (params.norm_convention == "none") {
@@ -278,6 +548,63 @@ void print_measurement_header_to_file(
     comment_delimiter,
     norm_factor_part, norm_factor_mesh, norm_factor_meshes
   );
+
+  print_stage_profile_to_file(fileptr);
+}
+
+}  // namespace
+
+void print_measurement_header_to_file(
+  std::FILE* fileptr, trv::ParameterSet& params,
+  trv::ParticleCatalogue& catalogue_data,
+  trv::ParticleCatalogue& catalogue_rand,
+  double norm_factor_part, double norm_factor_mesh, double norm_factor_meshes
+) {
+  auto print_header = [&](std::FILE* textptr) {
+    print_measurement_header_text(
+      textptr, params, catalogue_data, catalogue_rand,
+      norm_factor_part, norm_factor_mesh, norm_factor_meshes
+    );
+  };
+
+  if (params.output_type == "binary") {
+    write_binary_header(fileptr, capture_printed_text(print_header), true);
+  } else {
+    print_header(fileptr);
+  }
+}
+
+void print_measurement_header_to_file(
+  std::FILE* fileptr,
+  trv::ParameterSet& params, trv::ParticleCatalogue& catalogue,
+  double norm_factor_part, double norm_factor_mesh, double norm_factor_meshes
+) {
+  auto print_header = [&](std::FILE* textptr) {
+    print_measurement_header_text(
+      textptr, params, catalogue,
+      norm_factor_part, norm_factor_mesh, norm_factor_meshes
+    );
+  };
+
+  if (params.output_type == "binary") {
+    write_binary_header(fileptr, capture_printed_text(print_header), true);
+  } else {
+    print_header(fileptr);
+  }
+}
+
+void print_stage_profile_to_file(std::FILE* fileptr) {
+  for (const std::string& stage : trv::sys::profiler.stages) {
+    const trv::sys::StageProfile& profile = trv::sys::profiler.profiles[stage];
+    std::fprintf(
+      fileptr,
+      "%s Stage profile: %s: calls = %lld, time = %.3f s (self %.3f s), "
+      "data = %.3f GiB, peak memory = %.3f GiB, threads = %d\n",
+      comment_delimiter, stage.c_str(), profile.ncalls,
+      profile.time_total, profile.time_self, profile.gbytes,
+      profile.gbytes_mem, profile.nthreads
+    );
+  }
 }
 
 
@@ -285,11 +612,17 @@ void print_measurement_header_to_file(
 // Binning details
 // -----------------------------------------------------------------------
 
-void print_binned_vectors_to_file(
+namespace {
+
+/**
+ * @brief Print the binned-vectors header text.
+ *
+ * @see @ref trv::io::print_binned_vectors_header_to_file
+ */
+void print_binned_vectors_header_text(
   std::FILE* fileptr, trv::ParameterSet& params,
   trv::BinnedVectors& binned_vectors
 ) {
-  // Print header.
   std::fprintf(
     fileptr,
     "%s Box size: [%.3f, %.3f, %.3f]\n",
@@ -319,8 +652,44 @@ void print_binned_vectors_to_file(
     "[3] vec_x, [4] vec_y, [5] vec_z\n",
     comment_delimiter
   );
+}
+
+}  // namespace
+
+void print_binned_vectors_header_to_file(
+  std::FILE* fileptr, trv::ParameterSet& params,
+  trv::BinnedVectors& binned_vectors
+) {
+  auto print_header = [&](std::FILE* textptr) {
+    print_binned_vectors_header_text(textptr, params, binned_vectors);
+  };
+
+  if (params.output_type == "binary") {
+    write_binary_header(fileptr, capture_printed_text(print_header), false);
+  } else {
+    print_header(fileptr);
+  }
+}
+
+void print_binned_vectors_datatab_to_file(
+  std::FILE* fileptr, trv::ParameterSet& params,
+  trv::BinnedVectors& binned_vectors
+) {
+  if (params.output_type == "binary") {
+    const int count = binned_vectors.count;
+    write_binary_array(fileptr, "index", binned_vectors.indices, count);
+    write_binary_array(
+      fileptr, "lower_edge", binned_vectors.lower_edges, count
+    );
+    write_binary_array(
+      fileptr, "upper_edge", binned_vectors.upper_edges, count
+    );
+    write_binary_array(fileptr, "vecx", binned_vectors.vecx, count);
+    write_binary_array(fileptr, "vecy", binned_vectors.vecy, count);
+    write_binary_array(fileptr, "vecz", binned_vectors.vecz, count);
+    return;
+  }
 
-  // Print data table.
   for (int ivec = 0; ivec < binned_vectors.count; ivec++) {
     std::fprintf(
       fileptr,
@@ -335,6 +704,14 @@ void print_binned_vectors_to_file(
   }
 }
 
+void print_binned_vectors_to_file(
+  std::FILE* fileptr, trv::ParameterSet& params,
+  trv::BinnedVectors& binned_vectors
+) {
+  print_binned_vectors_header_to_file(fileptr, params, binned_vectors);
+  print_binned_vectors_datatab_to_file(fileptr, params, binned_vectors);
+}
+
 
 // -----------------------------------------------------------------------
 // Two-point measurement data table
@@ -344,6 +721,21 @@ void print_measurement_datatab_to_file(
   std::FILE* fileptr,
   trv::ParameterSet& params, trv::PowspecMeasurements& meas_powspec
 ) {
+  if (params.output_type == "binary") {
+    write_binary_array(fileptr, "kbin", meas_powspec.kbin, meas_powspec.dim);
+    write_binary_array(fileptr, "keff", meas_powspec.keff, meas_powspec.dim);
+    write_binary_array(
+      fileptr, "nmodes", meas_powspec.nmodes, meas_powspec.dim
+    );
+    write_binary_array(
+      fileptr, "pk_raw", meas_powspec.pk_raw, meas_powspec.dim
+    );
+    write_binary_array(
+      fileptr, "pk_shot", meas_powspec.pk_shot, meas_powspec.dim
+    );
+    return;
+  }
+
   // Print data table columns.
   std::fprintf(
     fileptr,
@@ -359,7 +751,7 @@ void print_measurement_datatab_to_file(
   for (int idx_dv = 0; idx_dv < meas_powspec.dim; idx_dv++) {
     std::fprintf(
       fileptr,
-      "%.9e\t%.9e\t%10d\t% .9e\t% .9e\t% .9e\t% .9e\n",
+      "%.9e\t%.9e\t%10lld\t% .9e\t% .9e\t% .9e\t% .9e\n",
       meas_powspec.kbin[idx_dv],
       meas_powspec.keff[idx_dv],
       meas_powspec.nmodes[idx_dv],
@@ -373,6 +765,14 @@ void print_measurement_datatab_to_file(
   std::FILE* fileptr,
   trv::ParameterSet& params, trv::TwoPCFMeasurements& meas_2pcf
 ) {
+  if (params.output_type == "binary") {
+    write_binary_array(fileptr, "rbin", meas_2pcf.rbin, meas_2pcf.dim);
+    write_binary_array(fileptr, "reff", meas_2pcf.reff, meas_2pcf.dim);
+    write_binary_array(fileptr, "npairs", meas_2pcf.npairs, meas_2pcf.dim);
+    write_binary_array(fileptr, "xi", meas_2pcf.xi, meas_2pcf.dim);
+    return;
+  }
+
   // Print data table columns.
   std::fprintf(
     fileptr,
@@ -385,7 +785,7 @@ void print_measurement_datatab_to_file(
   for (int idx_dv = 0; idx_dv < meas_2pcf.dim; idx_dv++) {
     std::fprintf(
       fileptr,
-      "%.9e\t%.9e\t%10d\t% .9e\t% .9e\n",
+      "%.9e\t%.9e\t%10lld\t% .9e\t% .9e\n",
       meas_2pcf.rbin[idx_dv],
       meas_2pcf.reff[idx_dv],
       meas_2pcf.npairs[idx_dv],
@@ -398,6 +798,20 @@ void print_measurement_datatab_to_file(
   std::FILE* fileptr,
   trv::ParameterSet& params, trv::TwoPCFWindowMeasurements& meas_2pcf_win
 ) {
+  if (params.output_type == "binary") {
+    write_binary_array(
+      fileptr, "rbin", meas_2pcf_win.rbin, meas_2pcf_win.dim
+    );
+    write_binary_array(
+      fileptr, "reff", meas_2pcf_win.reff, meas_2pcf_win.dim
+    );
+    write_binary_array(
+      fileptr, "npairs", meas_2pcf_win.npairs, meas_2pcf_win.dim
+    );
+    write_binary_array(fileptr, "xi", meas_2pcf_win.xi, meas_2pcf_win.dim);
+    return;
+  }
+
   // Print data table columns.
   std::fprintf(
     fileptr,
@@ -410,7 +824,7 @@ void print_measurement_datatab_to_file(
   for (int idx_dv = 0; idx_dv < meas_2pcf_win.dim; idx_dv++) {
     std::fprintf(
       fileptr,
-      "%.9e\t%.9e\t%10d\t% .9e\t% .9e\n",
+      "%.9e\t%.9e\t%10lld\t% .9e\t% .9e\n",
       meas_2pcf_win.rbin[idx_dv],
       meas_2pcf_win.reff[idx_dv],
       meas_2pcf_win.npairs[idx_dv],
@@ -428,6 +842,34 @@ void print_measurement_datatab_to_file(
   std::FILE* fileptr,
   trv::ParameterSet& params, trv::BispecMeasurements& meas_bispec
 ) {
+  if (params.output_type == "binary") {
+    write_binary_array(
+      fileptr, "k1_bin", meas_bispec.k1_bin, meas_bispec.dim
+    );
+    write_binary_array(
+      fileptr, "k1_eff", meas_bispec.k1_eff, meas_bispec.dim
+    );
+    write_binary_array(
+      fileptr, "nmodes_1", meas_bispec.nmodes_1, meas_bispec.dim
+    );
+    write_binary_array(
+      fileptr, "k2_bin", meas_bispec.k2_bin, meas_bispec.dim
+    );
+    write_binary_array(
+      fileptr, "k2_eff", meas_bispec.k2_eff, meas_bispec.dim
+    );
+    write_binary_array(
+      fileptr, "nmodes_2", meas_bispec.nmodes_2, meas_bispec.dim
+    );
+    write_binary_array(
+      fileptr, "bk_raw", meas_bispec.bk_raw, meas_bispec.dim
+    );
+    write_binary_array(
+      fileptr, "bk_shot", meas_bispec.bk_shot, meas_bispec.dim
+    );
+    return;
+  }
+
   char multipole_str[8];
   std::snprintf(
     multipole_str, sizeof(multipole_str), "%d%d%d",
@@ -450,7 +892,7 @@ void print_measurement_datatab_to_file(
   for (int idx_dv = 0; idx_dv < meas_bispec.dim; idx_dv++) {
     std::fprintf(
       fileptr,
-      "%.9e\t%.9e\t%10d\t%.9e\t%.9e\t%10d\t% .9e\t% .9e\t% .9e\t% .9e\n",
+      "%.9e\t%.9e\t%10lld\t%.9e\t%.9e\t%10lld\t% .9e\t% .9e\t% .9e\t% .9e\n",
       meas_bispec.k1_bin[idx_dv], meas_bispec.k1_eff[idx_dv],
       meas_bispec.nmodes_1[idx_dv],
       meas_bispec.k2_bin[idx_dv], meas_bispec.k2_eff[idx_dv],
@@ -465,6 +907,26 @@ void print_measurement_datatab_to_file(
   std::FILE* fileptr,
   trv::ParameterSet& params, trv::ThreePCFMeasurements& meas_3pcf
 ) {
+  if (params.output_type == "binary") {
+    write_binary_array(fileptr, "r1_bin", meas_3pcf.r1_bin, meas_3pcf.dim);
+    write_binary_array(fileptr, "r1_eff", meas_3pcf.r1_eff, meas_3pcf.dim);
+    write_binary_array(
+      fileptr, "npairs_1", meas_3pcf.npairs_1, meas_3pcf.dim
+    );
+    write_binary_array(fileptr, "r2_bin", meas_3pcf.r2_bin, meas_3pcf.dim);
+    write_binary_array(fileptr, "r2_eff", meas_3pcf.r2_eff, meas_3pcf.dim);
+    write_binary_array(
+      fileptr, "npairs_2", meas_3pcf.npairs_2, meas_3pcf.dim
+    );
+    write_binary_array(
+      fileptr, "zeta_raw", meas_3pcf.zeta_raw, meas_3pcf.dim
+    );
+    write_binary_array(
+      fileptr, "zeta_shot", meas_3pcf.zeta_shot, meas_3pcf.dim
+    );
+    return;
+  }
+
   char multipole_str[8];
   std::snprintf(
     multipole_str, sizeof(multipole_str), "%d%d%d",
@@ -487,7 +949,7 @@ void print_measurement_datatab_to_file(
   for (int idx_dv = 0; idx_dv < meas_3pcf.dim; idx_dv++) {
     std::fprintf(
       fileptr,
-      "%.9e\t%.9e\t%10d\t%.9e\t%.9e\t%10d\t% .9e\t% .9e\t% .9e\t% .9e\n",
+      "%.9e\t%.9e\t%10lld\t%.9e\t%.9e\t%10lld\t% .9e\t% .9e\t% .9e\t% .9e\n",
       meas_3pcf.r1_bin[idx_dv], meas_3pcf.r1_eff[idx_dv],
       meas_3pcf.npairs_1[idx_dv],
       meas_3pcf.r2_bin[idx_dv], meas_3pcf.r2_eff[idx_dv],
@@ -502,6 +964,34 @@ void print_measurement_datatab_to_file(
   std::FILE* fileptr,
   trv::ParameterSet& params, trv::ThreePCFWindowMeasurements& meas_3pcf_win
 ) {
+  if (params.output_type == "binary") {
+    write_binary_array(
+      fileptr, "r1_bin", meas_3pcf_win.r1_bin, meas_3pcf_win.dim
+    );
+    write_binary_array(
+      fileptr, "r1_eff", meas_3pcf_win.r1_eff, meas_3pcf_win.dim
+    );
+    write_binary_array(
+      fileptr, "npairs_1", meas_3pcf_win.npairs_1, meas_3pcf_win.dim
+    );
+    write_binary_array(
+      fileptr, "r2_bin", meas_3pcf_win.r2_bin, meas_3pcf_win.dim
+    );
+    write_binary_array(
+      fileptr, "r2_eff", meas_3pcf_win.r2_eff, meas_3pcf_win.dim
+    );
+    write_binary_array(
+      fileptr, "npairs_2", meas_3pcf_win.npairs_2, meas_3pcf_win.dim
+    );
+    write_binary_array(
+      fileptr, "zeta_raw", meas_3pcf_win.zeta_raw, meas_3pcf_win.dim
+    );
+    write_binary_array(
+      fileptr, "zeta_shot", meas_3pcf_win.zeta_shot, meas_3pcf_win.dim
+    );
+    return;
+  }
+
   char multipole_str[8];
   std::snprintf(
     multipole_str, sizeof(multipole_str), "%d%d%d",
@@ -524,7 +1014,7 @@ void print_measurement_datatab_to_file(
   for (int idx_dv = 0; idx_dv < meas_3pcf_win.dim; idx_dv++) {
     std::fprintf(
       fileptr,
-      "%.9e\t%.9e\t%10d\t%.9e\t%.9e\t%10d\t% .9e\t% .9e\t% .9e\t% .9e\n",
+      "%.9e\t%.9e\t%10lld\t%.9e\t%.9e\t%10lld\t% .9e\t% .9e\t% .9e\t% .9e\n",
       meas_3pcf_win.r1_bin[idx_dv], meas_3pcf_win.r1_eff[idx_dv],
       meas_3pcf_win.npairs_1[idx_dv],
       meas_3pcf_win.r2_bin[idx_dv], meas_3pcf_win.r2_eff[idx_dv],
@@ -221,7 +221,7 @@ void SphericalHarmonicCalculator::\
 store_reduced_spherical_harmonic_in_fourier_space(
   const int ell, const int m,
   const double boxsize[3], const int ngrid[3],
-  std::vector< std::complex<double> >& ylm_out
+  trvs::TrackedVector< std::complex<double> >& ylm_out
 ) {
   // Determine the fundamental wavenumber in each dimension.
   double dk[3] = {
@@ -240,7 +240,7 @@ store_reduced_spherical_harmonic_in_fourier_space(
         // The assigned flattened-grid array index is
         // (i * ngrid_y * ngrid_z + j * ngrid_z + k)
         // where ngrid is the grid number along each axis.
-        long long idx_grid = (i * ngrid[1] + j) * ngrid[2] + k;
+        long long idx_grid = ((long long)(i) * ngrid[1] + j) * ngrid[2] + k;
 
         // This conforms to the (absurd) FFT array-ordering convention
         // that negative wavenumbers/frequencies come after zero and
@@ -260,7 +260,7 @@ void SphericalHarmonicCalculator::\
 store_reduced_spherical_harmonic_in_config_space(
   const int ell, const int m,
   const double boxsize[3], const int ngrid[3],
-  std::vector< std::complex<double> >& ylm_out
+  trvs::TrackedVector< std::complex<double> >& ylm_out
 ) {
   // Determine the grid cell size in each dimension.
   double dr[3] = {
@@ -281,7 +281,7 @@ store_reduced_spherical_harmonic_in_config_space(
         // The assigned flattened-grid array index is
         // (i * ngrid_y * ngrid_z + j * ngrid_z + k)
         // where ngrid is the grid number along each axis.
-        long long idx_grid = (i * ngrid[1] + j) * ngrid[2] + k;
+        long long idx_grid = ((long long)(i) * ngrid[1] + j) * ngrid[2] + k;
 
         // This conforms to the (absurd) FFT array-ordering convention
         // that negative wavenumbers/frequencies come after zero and
@@ -298,6 +298,179 @@ store_reduced_spherical_harmonic_in_config_space(
 }
 
 
+// ***********************************************************************
+// Cartesian moments
+// ***********************************************************************
+
+CartesianMomentCalculator::CartesianMomentCalculator(const int ell) {
+  if (ell < 0 || ell > CartesianMomentCalculator::ell_max) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Cartesian moment degree must be between 0 and %d: `ell` = %d.",
+        CartesianMomentCalculator::ell_max, ell
+      );
+    }
+    throw trvs::InvalidParameterError(
+      "Cartesian moment degree must be between 0 and %d: `ell` = %d.\n",
+      CartesianMomentCalculator::ell_max, ell
+    );
+  }
+
+  this->ell = ell;
+  this->nmoments = 2*ell + 1;
+
+  auto factorial = [](int n) {
+    double fac = 1.;
+    for (int i = 2; i <= n; i++) {fac *= i;}
+    return fac;
+  };
+
+  // Enumerate the monomial exponents α with |α| = ℓ in order of
+  // ascending α_z, where the first 2ℓ + 1 (with α_z <= 1) are the
+  // moment basis.
+  std::vector< std::array<int, 3> > alphas;
+  for (int az = 0; az <= ell; az++) {
+    for (int ax = ell - az; ax >= 0; ax--) {
+      alphas.push_back({ax, ell - az - ax, az});
+    }
+  }
+
+  auto find_alpha = [&alphas](int ax, int ay, int az) {
+    for (std::size_t ia = 0; ia < alphas.size(); ia++) {
+      if (alphas[ia][0] == ax && alphas[ia][1] == ay && alphas[ia][2] == az) {
+        return int(ia);
+      }
+    }
+    return -1;
+  };
+
+  // Expand the line-of-sight moments, i.e. the monomial coefficients of
+  // Σ_p a_p (k·x̂)^p (k·k)^q with p + 2q = ℓ, where a_p are
+  // the Legendre polynomial coefficients.
+  this->los_offsets.push_back(0);
+  for (int ib = 0; ib < this->nmoments; ib++) {
+    const std::array<int, 3>& alpha = alphas[ib];
+    for (int q = 0; 2*q <= ell; q++) {
+      int p = ell - 2*q;
+      double a_p = std::pow(-1., q) * factorial(2*ell - 2*q) / (
+        std::pow(2., ell) * factorial(q) * factorial(ell - q) * factorial(p)
+      );
+      for (int gx = 0; 2*gx <= alpha[0] && gx <= q; gx++) {
+        for (int gy = 0; 2*gy <= alpha[1] && gx + gy <= q; gy++) {
+          int gz = q - gx - gy;
+          if (2*gz > alpha[2]) {continue;}
+
+          int bx = alpha[0] - 2*gx, by = alpha[1] - 2*gy, bz = alpha[2] - 2*gz;
+          double coeff = a_p
+            * factorial(q) / (factorial(gx) * factorial(gy) * factorial(gz))
+            * factorial(p) / (factorial(bx) * factorial(by) * factorial(bz));
+
+          this->los_powers.insert(this->los_powers.end(), {bx, by, bz});
+          this->los_coeffs.push_back(coeff);
+        }
+      }
+    }
+    this->los_offsets.push_back(int(this->los_coeffs.size()));
+  }
+
+  // Reduce the monomials with α_z >= 2 to the moment basis by
+  // tracelessness, i.e. ∇²_k of the harmonic polynomial vanishes, so
+  // c_{β+2e_z} = - Σ_{i=x,y} (β_i + 2)(β_i + 1) c_{β+2e_i}
+  //                / ((β_z + 2)(β_z + 1)).
+  std::vector< std::vector<double> > reduction(
+    alphas.size(), std::vector<double>(this->nmoments, 0.)
+  );
+  for (std::size_t ia = 0; ia < alphas.size(); ia++) {
+    int ax = alphas[ia][0], ay = alphas[ia][1], az = alphas[ia][2];
+    if (az <= 1) {
+      reduction[ia][ia] = 1.;
+      continue;
+    }
+    int ia_x = find_alpha(ax + 2, ay, az - 2);
+    int ia_y = find_alpha(ax, ay + 2, az - 2);
+    for (int ib = 0; ib < this->nmoments; ib++) {
+      reduction[ia][ib] = - (
+        (ax + 2) * (ax + 1) * reduction[ia_x][ib]
+        + (ay + 2) * (ay + 1) * reduction[ia_y][ib]
+      ) / double(az * (az - 1));
+    }
+  }
+
+  this->kvec_offsets.push_back(0);
+  for (int ib = 0; ib < this->nmoments; ib++) {
+    for (std::size_t ia = 0; ia < alphas.size(); ia++) {
+      if (reduction[ia][ib] == 0.) {continue;}
+      this->kvec_powers.insert(
+        this->kvec_powers.end(), alphas[ia].begin(), alphas[ia].end()
+      );
+      this->kvec_coeffs.push_back(reduction[ia][ib]);
+    }
+    this->kvec_offsets.push_back(int(this->kvec_coeffs.size()));
+  }
+}
+
+void CartesianMomentCalculator::calc_los_moments(
+  const double los[3], double* moments
+) const {
+  this->eval_monomial_sums(
+    los, this->los_powers, this->los_coeffs, this->los_offsets, moments
+  );
+}
+
+void CartesianMomentCalculator::calc_wavevector_weights(
+  const double kvec[3], double* weights
+) const {
+  this->eval_monomial_sums(
+    kvec, this->kvec_powers, this->kvec_coeffs, this->kvec_offsets, weights
+  );
+}
+
+void CartesianMomentCalculator::eval_monomial_sums(
+  const double vec[3],
+  const std::vector<int>& powers, const std::vector<double>& coeffs,
+  const std::vector<int>& offsets, double* sums
+) const {
+  // CAVEAT: Discretionary choice as in the reduced spherical harmonics.
+  const double eps = 1.e-9;
+
+  // Return unity in the trivial case.
+  if (this->ell == 0) {
+    sums[0] = 1.;
+    return;
+  }
+
+  double vec_mod = std::sqrt(
+    vec[0] * vec[0] + vec[1] * vec[1] + vec[2] * vec[2]
+  );
+
+  // Return zeros in the trivial case.
+  if (vec_mod < eps) {
+    for (int ib = 0; ib < this->nmoments; ib++) {sums[ib] = 0.;}
+    return;
+  }
+
+  // Tabulate powers of the normalised vector components.
+  double vec_pow[3][CartesianMomentCalculator::ell_max + 1];
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    vec_pow[iaxis][0] = 1.;
+    for (int n = 1; n <= this->ell; n++) {
+      vec_pow[iaxis][n] = vec_pow[iaxis][n - 1] * vec[iaxis] / vec_mod;
+    }
+  }
+
+  for (int ib = 0; ib < this->nmoments; ib++) {
+    double sum = 0.;
+    for (int iterm = offsets[ib]; iterm < offsets[ib + 1]; iterm++) {
+      sum += coeffs[iterm]
+        * vec_pow[0][powers[3*iterm]]
+        * vec_pow[1][powers[3*iterm + 1]]
+        * vec_pow[2][powers[3*iterm + 2]];
+    }
+    sums[ib] = sum;
+  }
+}
+
+
 // ***********************************************************************
 // Spherical Bessel function
 // ***********************************************************************
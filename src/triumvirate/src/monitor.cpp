@@ -26,6 +26,8 @@
 
 #include "monitor.hpp"
 
+#include <algorithm>
+
 /// @cond DOXYGEN_DOC_MACROS
 #ifdef TRV_EXTCALL
 #define SHOW_CPPSTATE "C++"
@@ -43,21 +45,75 @@ namespace sys {
 
 int currTask = 0;
 
-double gbytesMem = 0.;
-double gbytesMaxMem = 0.;
+thread_local double gbytesMem = 0.;
+thread_local double gbytesMaxMem = 0.;
+thread_local double gbytesEstMem = 0.;
+
+thread_local int count_fft = 0;
+thread_local int count_ifft = 0;
 
-int count_fft = 0;
-int count_ifft = 0;
+std::mutex fftw_planner_mutex;
 
 auto clockStart = std::chrono::steady_clock::now();  ///< program starting time
 
 /// @cond DOXYGEN_DOC_MISC
-Logger logger(LogLevel::NSET);  ///< default logger at `NSET` logging level
+/// Default logger at `NSET` logging level.
+thread_local Logger logger(LogLevel::NSET);
 /// @endcond
 
+namespace {
+
+/// innermost active worker scope of the current thread
+thread_local WorkerScope* worker_active = nullptr;
+
+}  // namespace
+
 void update_maxmem() {
   trv::sys::gbytesMaxMem = (trv::sys::gbytesMem > trv::sys::gbytesMaxMem) ?
     trv::sys::gbytesMem : trv::sys::gbytesMaxMem;
+
+  ScopedTimer::update_mem_peak();
+
+  if (worker_active != nullptr) {
+    worker_active->sync_mem();
+  }
+}
+
+void check_mem_budget(
+  double gbytes_est, double gbytes_budget, const std::string& task
+) {
+  trv::sys::gbytesEstMem = gbytes_est;
+
+  if (trv::sys::currTask == 0) {
+    trv::sys::logger.info(
+      "Estimated peak memory usage for %s: %.3f gigabytes.",
+      task.c_str(), gbytes_est
+    );
+  }
+
+  if (gbytes_budget <= 0. || gbytes_est <= gbytes_budget) {return;}
+
+  if (trv::sys::currTask == 0) {
+    trv::sys::logger.error(
+      "Estimated memory usage for %s exceeds the memory budget: "
+      "%.3f > %.3f gigabytes.",
+      task.c_str(), gbytes_est, gbytes_budget
+    );
+  }
+  throw trv::sys::InsufficientMemoryError(
+    "Estimated memory usage for %s exceeds the memory budget: "
+    "%.3f > %.3f gigabytes.\n",
+    task.c_str(), gbytes_est, gbytes_budget
+  );
+}
+
+bool reserve_mem_budget(double gbytes_extra, double gbytes_budget) {
+  double gbytes_est = std::max(trv::sys::gbytesEstMem, trv::sys::gbytesMem)
+    + gbytes_extra;
+  if (gbytes_budget > 0. && gbytes_est > gbytes_budget) {return false;}
+
+  trv::sys::gbytesEstMem = gbytes_est;
+  return true;
 }
 
 std::string show_current_datetime() {
@@ -249,6 +305,217 @@ void Logger::error(const char* fmt_string, ...) {
 }
 
 
+// ***********************************************************************
+// Program profiling
+// ***********************************************************************
+
+thread_local Profiler profiler;
+
+namespace {
+
+/// innermost active timer of the current thread
+thread_local ScopedTimer* timer_active = nullptr;
+
+}  // namespace
+
+void Profiler::reset() {
+  this->stages.clear();
+  this->profiles.clear();
+  this->events.clear();
+}
+
+void Profiler::record(
+  const std::string& stage, double time_total, double time_self,
+  double gbytes, double gbytes_mem, int nthreads, long long ncalls
+) {
+  if (this->profiles.count(stage) == 0) {
+    this->stages.push_back(stage);
+  }
+
+  StageProfile& profile = this->profiles[stage];
+  profile.ncalls += ncalls;
+  profile.time_total += time_total;
+  profile.time_self += time_self;
+  profile.gbytes += gbytes;
+  profile.gbytes_mem = std::max(profile.gbytes_mem, gbytes_mem);
+  profile.nthreads = std::max(profile.nthreads, nthreads);
+}
+
+void Profiler::merge(const Profiler& other) {
+  for (const std::string& stage : other.stages) {
+    const StageProfile& profile = other.profiles.at(stage);
+    this->record(
+      stage, profile.time_total, profile.time_self,
+      profile.gbytes, profile.gbytes_mem, profile.nthreads, profile.ncalls
+    );
+  }
+}
+
+int Profiler::write_trace_to_file(const std::string& filepath) {
+  std::FILE* fileptr = std::fopen(filepath.c_str(), "w");
+  if (fileptr == nullptr) {return 1;}
+
+  // Timestamps and durations are in microseconds.
+  std::fprintf(fileptr, "{\"traceEvents\": [\n");
+  for (std::size_t ievent = 0; ievent < this->events.size(); ievent++) {
+    const StageEvent& event = this->events[ievent];
+    std::fprintf(
+      fileptr,
+      "  {\"name\": \"%s\", \"cat\": \"trv\", \"ph\": \"X\", "
+      "\"ts\": %.3f, \"dur\": %.3f, \"pid\": 0, \"tid\": 0, "
+      "\"args\": {\"gbytes\": %.6e, \"gbytes_mem\": %.6e, "
+      "\"nthreads\": %d}}%s\n",
+      event.stage.c_str(), 1.e6 * event.time_begin, 1.e6 * event.time_duration,
+      event.gbytes, event.gbytes_mem, event.nthreads,
+      (ievent + 1 < this->events.size()) ? "," : ""
+    );
+  }
+  std::fprintf(fileptr, "], \"displayTimeUnit\": \"ms\"}\n");
+
+  return (std::fclose(fileptr) == 0) ? 0 : 1;
+}
+
+ScopedTimer::ScopedTimer(const char* stage, double gbytes) {
+  this->stage = stage;
+  this->gbytes = gbytes;
+  this->gbytes_mem = gbytesMem;
+
+  // Nested parallel regions beyond the active level limit are serial.
+#ifdef TRV_USE_OMP
+  this->nthreads = (omp_get_active_level() < omp_get_max_active_levels()) ?
+    omp_get_max_threads() : 1;
+#else  // !TRV_USE_OMP
+  this->nthreads = 1;
+#endif  // TRV_USE_OMP
+
+  this->parent = timer_active;
+  timer_active = this;
+
+  // Include the memory usage of other worker threads.
+  if (worker_active != nullptr) {
+    worker_active->sync_mem();
+  }
+
+  this->time_begin = std::chrono::steady_clock::now();
+}
+
+void ScopedTimer::add_data(double gbytes) {
+  this->gbytes += gbytes;
+}
+
+void ScopedTimer::update_mem_peak() {
+  ScopedTimer::update_mem_peak(gbytesMem);
+}
+
+void ScopedTimer::update_mem_peak(double gbytes) {
+  if (timer_active != nullptr) {
+    timer_active->gbytes_mem = std::max(timer_active->gbytes_mem, gbytes);
+  }
+}
+
+ScopedTimer::~ScopedTimer() {
+  auto time_end = std::chrono::steady_clock::now();
+  double time_total =
+    std::chrono::duration<double>(time_end - this->time_begin).count();
+
+  timer_active = this->parent;
+  if (this->parent != nullptr) {
+    this->parent->time_nested += time_total;
+    this->parent->gbytes_mem =
+      std::max(this->parent->gbytes_mem, this->gbytes_mem);
+  }
+
+  profiler.record(
+    this->stage, time_total, time_total - this->time_nested,
+    this->gbytes, this->gbytes_mem, this->nthreads
+  );
+  if (profiler.tracing) {
+    profiler.events.push_back({
+      this->stage,
+      std::chrono::duration<double>(this->time_begin - clockStart).count(),
+      time_total, this->gbytes, this->gbytes_mem, this->nthreads
+    });
+  }
+}
+
+
+// ***********************************************************************
+// Worker threads
+// ***********************************************************************
+
+ThreadContext::ThreadContext() {
+  this->caller = &gbytesMem;
+  this->log_level = logger.level_limit;
+  this->gbytes_caller = gbytesMem;
+
+  // The maximum memory usage of the calling thread is tracked afresh
+  // to be combined with that of worker threads.
+  this->gbytes_max_caller = gbytesMaxMem;
+  gbytesMaxMem = gbytesMem;
+}
+
+ThreadContext::~ThreadContext() {
+  count_fft += this->count_fft_workers;
+  count_ifft += this->count_ifft_workers;
+  profiler.merge(this->profiler_workers);
+
+  double gbytes_peak = gbytesMaxMem + this->gbytes_workers_max;
+  gbytesMaxMem = std::max(this->gbytes_max_caller, gbytes_peak);
+
+  ScopedTimer::update_mem_peak(gbytes_peak);
+}
+
+WorkerScope::WorkerScope(ThreadContext& context) : context(context) {
+  this->is_worker = (static_cast<const void*>(&gbytesMem) != context.caller);
+  if (!this->is_worker) {return;}
+
+  logger.reset_level(context.log_level);
+  profiler.reset();
+
+  // Memory usage of the worker thread is offset by that of the caller
+  // so that stage peaks are comparable with those of the caller.
+  gbytesMem += context.gbytes_caller;
+
+  this->gbytes_ini = gbytesMem;
+  this->count_fft_ini = count_fft;
+  this->count_ifft_ini = count_ifft;
+
+  this->parent = worker_active;
+  worker_active = this;
+}
+
+void WorkerScope::sync_mem() {
+  if (!this->is_worker) {return;}
+
+  double gbytes = gbytesMem - this->gbytes_ini;
+
+  double gbytes_total;
+  {
+    std::lock_guard<std::mutex> lock(this->context.mutex);
+    this->context.gbytes_workers += gbytes - this->gbytes_synced;
+    this->context.gbytes_workers_max = std::max(
+      this->context.gbytes_workers_max, this->context.gbytes_workers
+    );
+    gbytes_total = this->context.gbytes_caller + this->context.gbytes_workers;
+  }
+  this->gbytes_synced = gbytes;
+
+  ScopedTimer::update_mem_peak(gbytes_total);
+}
+
+WorkerScope::~WorkerScope() {
+  if (!this->is_worker) {return;}
+
+  worker_active = this->parent;
+  this->sync_mem();
+  gbytesMem -= this->context.gbytes_caller;
+
+  std::lock_guard<std::mutex> lock(this->context.mutex);
+  this->context.count_fft_workers += count_fft - this->count_fft_ini;
+  this->context.count_ifft_workers += count_ifft - this->count_ifft_ini;
+  this->context.profiler_workers.merge(profiler);
+}
+
 // ***********************************************************************
 // Program exceptions
 // ***********************************************************************
@@ -322,6 +589,23 @@ const char* InvalidDataError::what() const noexcept {
   return this->err_mesg.c_str();
 }
 
+InsufficientMemoryError::InsufficientMemoryError(
+  const char* fmt_string, ...
+): std::bad_alloc() {
+  std::va_list args;
+
+  char err_mesg_buf[4096];
+  va_start(args, fmt_string);
+  std::vsnprintf(err_mesg_buf, sizeof(err_mesg_buf), fmt_string, args);
+  va_end(args);
+
+  this->err_mesg = std::string(err_mesg_buf);
+}
+
+const char* InsufficientMemoryError::what() const noexcept {
+  return this->err_mesg.c_str();
+}
+
 
 // ***********************************************************************
 // Program notices
@@ -25,6 +25,7 @@
  */
 
 #include "parameters.hpp"
+#include "synthetic.hpp"
 
 namespace trvs = trv::sys;
 
@@ -35,9 +36,15 @@ ParameterSet::ParameterSet(const ParameterSet& other) {
   this->catalogue_dir = other.catalogue_dir;
   this->measurement_dir = other.measurement_dir;
   this->data_catalogue_file = other.data_catalogue_file;
+  this->data_catalogue_list = other.data_catalogue_list;
   this->rand_catalogue_file = other.rand_catalogue_file;
   this->catalogue_columns = other.catalogue_columns;
   this->output_tag = other.output_tag;
+  this->output_type = other.output_type;
+  this->mesh_cache_dir = other.mesh_cache_dir;
+  this->mesh_cache_size = other.mesh_cache_size;
+  this->checkpoint_dir = other.checkpoint_dir;
+  this->checkpoint_fields = other.checkpoint_fields;
 
   // Copy mesh sampling parameters.
   for (int i = 0; i < 3; i++) {
@@ -52,10 +59,12 @@ ParameterSet::ParameterSet(const ParameterSet& other) {
   this->volume = other.volume;
   this->nmesh = other.nmesh;
   this->assignment_order = other.assignment_order;
+  this->interlace_order = other.interlace_order;
 
   // Copy measurement parameters.
   this->catalogue_type = other.catalogue_type;
   this->statistic_type = other.statistic_type;
+  this->measurement_plan = other.measurement_plan;
   this->npoint = other.npoint;
   this->space = other.space;
   this->ell1 = other.ell1;
@@ -65,6 +74,8 @@ ParameterSet::ParameterSet(const ParameterSet& other) {
   this->j_wa = other.j_wa;
   this->form = other.form;
   this->norm_convention = other.norm_convention;
+  this->powspec_estimator = other.powspec_estimator;
+  this->crop_fourier = other.crop_fourier;
   this->binning = other.binning;
   this->bin_min = other.bin_min;
   this->bin_max = other.bin_max;
@@ -73,6 +84,10 @@ ParameterSet::ParameterSet(const ParameterSet& other) {
 
   // Copy misc parameters.
   this->save_binned_vectors = other.save_binned_vectors;
+  this->task_parallel = other.task_parallel;
+  this->pipeline = other.pipeline;
+  this->memory_budget = other.memory_budget;
+  this->profile_trace = other.profile_trace;
   this->verbose = other.verbose;
 }
 
@@ -90,9 +105,14 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
   char catalogue_dir_[1024] = "";
   char measurement_dir_[1024] = "";
   char data_catalogue_file_[1024] = "";
+  char data_catalogue_list_[1024] = "";
   char rand_catalogue_file_[1024] = "";
   char catalogue_columns_[1024] = "";
   char output_tag_[1024] = "";
+  char output_type_[16] = "";
+  char mesh_cache_dir_[1024] = "";
+  char checkpoint_dir_[1024] = "";
+  char checkpoint_fields_[16] = "";
 
   double boxsize_x, boxsize_y, boxsize_z;
   int ngrid_x, ngrid_y, ngrid_z;
@@ -104,11 +124,17 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
 
   char catalogue_type_[16] = "";
   char statistic_type_[16] = "";
+  char measurement_plan_[1024] = "";
   char form_[16] = "";
   char norm_convention_[16] = "";
+  char powspec_estimator_[16] = "";
+  char crop_fourier_[16] = "";
   char binning_[16] = "";
 
   char save_binned_vectors_[16] = "";
+  char task_parallel_[16] = "";
+  char pipeline_[16] = "";
+  char profile_trace_[1024] = "";
 
   // ---------------------------------------------------------------------
   // Extraction
@@ -148,9 +174,22 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
     scan_par_str("catalogue_dir", "%s %s %s", catalogue_dir_);
     scan_par_str("measurement_dir", "%s %s %s", measurement_dir_);
     scan_par_str("data_catalogue_file", "%s %s %s", data_catalogue_file_);
+    scan_par_str("data_catalogue_list", "%s %s %s", data_catalogue_list_);
     scan_par_str("rand_catalogue_file", "%s %s %s", rand_catalogue_file_);
     scan_par_str("catalogue_columns", "%s %s %s", catalogue_columns_);
     scan_par_str("output_tag", "%s %s %s", output_tag_);
+    scan_par_str("output_type", "%s %s %s", output_type_);
+    scan_par_str("mesh_cache_dir", "%s %s %s", mesh_cache_dir_);
+
+    if (line_str.find("mesh_cache_size") != std::string::npos) {
+      std::sscanf(
+        line_str.data(), "%s %s %lg",
+        dummy_str, dummy_equal, &this->mesh_cache_size
+      );
+    }
+
+    scan_par_str("checkpoint_dir", "%s %s %s", checkpoint_dir_);
+    scan_par_str("checkpoint_fields", "%s %s %s", checkpoint_fields_);
 
     // -- Mesh sampling --------------------------------------------------
 
@@ -202,8 +241,11 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
 
     scan_par_str("catalogue_type", "%s %s %s", catalogue_type_);
     scan_par_str("statistic_type", "%s %s %s", statistic_type_);
+    scan_par_str("measurement_plan", "%s %s %s", measurement_plan_);
     scan_par_str("form", "%s %s %s", form_);
     scan_par_str("norm_convention", "%s %s %s", norm_convention_);
+    scan_par_str("powspec_estimator", "%s %s %s", powspec_estimator_);
+    scan_par_str("crop_fourier", "%s %s %s", crop_fourier_);
     scan_par_str("binning", "%s %s %s", binning_);
 
     if (line_str.find("ell1") != std::string::npos) {
@@ -258,6 +300,17 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
     // -- Misc -------------------------------------------------------------
 
     scan_par_str("save_binned_vectors", "%s %s %s", save_binned_vectors_);
+    scan_par_str("task_parallel", "%s %s %s", task_parallel_);
+    scan_par_str("pipeline", "%s %s %s", pipeline_);
+
+    if (line_str.find("memory_budget") != std::string::npos) {
+      std::sscanf(
+        line_str.data(), "%s %s %lg",
+        dummy_str, dummy_equal, &this->memory_budget
+      );
+    }
+
+    scan_par_str("profile_trace", "%s %s %s", profile_trace_);
 
     if (line_str.find("verbose") != std::string::npos) {
       std::sscanf(
@@ -276,9 +329,14 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
   this->catalogue_dir = catalogue_dir_;
   this->measurement_dir = measurement_dir_;
   this->data_catalogue_file = data_catalogue_file_;
+  this->data_catalogue_list = data_catalogue_list_;
   this->rand_catalogue_file = rand_catalogue_file_;
   this->catalogue_columns = catalogue_columns_;
   this->output_tag = output_tag_;
+  this->output_type = output_type_;
+  this->mesh_cache_dir = mesh_cache_dir_;
+  this->checkpoint_dir = checkpoint_dir_;
+  this->checkpoint_fields = checkpoint_fields_;
 
   this->alignment = alignment_;
   this->padscale = padscale_;
@@ -287,11 +345,17 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
 
   this->catalogue_type = catalogue_type_;
   this->statistic_type = statistic_type_;
+  this->measurement_plan = measurement_plan_;
   this->form = form_;
   this->norm_convention = norm_convention_;
+  this->powspec_estimator = powspec_estimator_;
+  this->crop_fourier = crop_fourier_;
   this->binning = binning_;
 
   this->save_binned_vectors = save_binned_vectors_;
+  this->task_parallel = task_parallel_;
+  this->pipeline = pipeline_;
+  this->profile_trace = profile_trace_;
 
   // Attribute derived parameters.
   this->boxsize[0] = boxsize_x;
@@ -303,7 +367,7 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
   this->ngrid[2] = ngrid_z;
 
   this->volume = boxsize_x * boxsize_y * boxsize_z;
-  this->nmesh = ngrid_x * ngrid_y * ngrid_z;
+  this->nmesh = (long long)(ngrid_x) * ngrid_y * ngrid_z;
 
   // ---------------------------------------------------------------------
   // Debugging mode
@@ -314,7 +378,7 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
   auto debug_par_str = [](std::string name, std::string value) {
     std::cout << name << ": " << value << std::endl;
   };
-  auto debug_par_int = [](std::string name, int value) {
+  auto debug_par_int = [](std::string name, long long value) {
     std::cout << name << ": " << value << std::endl;
   };
   auto debug_par_double = [](std::string name, double value) {
@@ -325,9 +389,14 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
   debug_par_str("catalogue_dir", this->catalogue_dir);
   debug_par_str("measurement_dir", this->measurement_dir);
   debug_par_str("data_catalogue_file", this->data_catalogue_file);
+  debug_par_str("data_catalogue_list", this->data_catalogue_list);
   debug_par_str("rand_catalogue_file", this->rand_catalogue_file);
   debug_par_str("catalogue_columns", this->catalogue_columns);
   debug_par_str("output_tag", this->output_tag);
+  debug_par_str("output_type", this->output_type);
+  debug_par_str("mesh_cache_dir", this->mesh_cache_dir);
+  debug_par_str("checkpoint_dir", this->checkpoint_dir);
+  debug_par_str("checkpoint_fields", this->checkpoint_fields);
 
   debug_par_str("alignment", this->alignment);
   debug_par_str("padscale", this->padscale);
@@ -336,11 +405,17 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
 
   debug_par_str("catalogue_type", this->catalogue_type);
   debug_par_str("statistic_type", this->statistic_type);
+  debug_par_str("measurement_plan", this->measurement_plan);
   debug_par_str("form", this->form);
   debug_par_str("norm_convention", this->norm_convention);
+  debug_par_str("powspec_estimator", this->powspec_estimator);
+  debug_par_str("crop_fourier", this->crop_fourier);
   debug_par_str("binning", this->binning);
 
   debug_par_str("save_binned_vectors", this->save_binned_vectors);
+  debug_par_str("task_parallel", this->task_parallel);
+  debug_par_str("pipeline", this->pipeline);
+  debug_par_str("profile_trace", this->profile_trace);
 
   debug_par_int("ngrid[0]", this->ngrid[0]);
   debug_par_int("ngrid[1]", this->ngrid[1]);
@@ -361,6 +436,8 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
   debug_par_double("boxsize[2]", this->boxsize[2]);
   debug_par_double("volume", this->volume);
   debug_par_double("padfactor", this->padfactor);
+  debug_par_double("mesh_cache_size", this->mesh_cache_size);
+  debug_par_double("memory_budget", this->memory_budget);
   debug_par_double("bin_min", this->bin_min);
   debug_par_double("bin_max", this->bin_max);
 #endif  // DBG_PARS
@@ -385,15 +462,41 @@ int ParameterSet::validate() {
   } else {
     this->measurement_dir += "/";  // transmutation
   }
+  if (
+    this->mesh_cache_dir.find_first_not_of(" \t\n\r\v\f") != std::string::npos
+  ) {
+    this->mesh_cache_dir += "/";  // transmutation
+  }
+  if (
+    this->checkpoint_dir.find_first_not_of(" \t\n\r\v\f") != std::string::npos
+  ) {
+    this->checkpoint_dir += "/";  // transmutation
+  }
   if (this->catalogue_type == "survey") {
     if (this->data_catalogue_file != "") {
-      if (this->data_catalogue_file.rfind("/", 0) != 0) {
+      if (
+        this->data_catalogue_file.rfind("/", 0) != 0
+        && !SyntheticCatalogueGenerator::is_synthetic_source(
+          this->data_catalogue_file
+        )
+      ) {
         this->data_catalogue_file = this->catalogue_dir
           + this->data_catalogue_file;
       }  // transmutation
     }
+    if (this->data_catalogue_list != "") {
+      if (this->data_catalogue_list.rfind("/", 0) != 0) {
+        this->data_catalogue_list = this->catalogue_dir
+          + this->data_catalogue_list;
+      }  // transmutation
+    }
     if (this->rand_catalogue_file != "") {
-      if (this->rand_catalogue_file.rfind("/", 0) != 0) {
+      if (
+        this->rand_catalogue_file.rfind("/", 0) != 0
+        && !SyntheticCatalogueGenerator::is_synthetic_source(
+          this->rand_catalogue_file
+        )
+      ) {
         this->rand_catalogue_file = this->catalogue_dir
           + this->rand_catalogue_file;
       }  // transmutation
@@ -402,7 +505,12 @@ int ParameterSet::validate() {
   if (this->catalogue_type == "random") {
     this->data_catalogue_file = "";  // transmutation
     if (this->rand_catalogue_file != "") {
-      if (this->rand_catalogue_file.rfind("/", 0) != 0) {
+      if (
+        this->rand_catalogue_file.rfind("/", 0) != 0
+        && !SyntheticCatalogueGenerator::is_synthetic_source(
+          this->rand_catalogue_file
+        )
+      ) {
         this->rand_catalogue_file = this->catalogue_dir
           + this->rand_catalogue_file;
       }  // transmutation
@@ -410,7 +518,12 @@ int ParameterSet::validate() {
   } else
   if (this->catalogue_type == "sim") {
     if (this->data_catalogue_file != "") {
-      if (this->data_catalogue_file.rfind("/", 0) != 0) {
+      if (
+        this->data_catalogue_file.rfind("/", 0) != 0
+        && !SyntheticCatalogueGenerator::is_synthetic_source(
+          this->data_catalogue_file
+        )
+      ) {
         this->data_catalogue_file = this->catalogue_dir
           + this->data_catalogue_file;
       }  // transmutation
@@ -486,26 +599,68 @@ int ParameterSet::validate() {
       );
     }
   }
+  // Interlacing may be specified by its order, i.e. the number of
+  // interlaced mesh grids, where order 1 means no interlacing.
+  // Any order derived from an earlier validation is discarded, as the
+  // same parameter set may be revalidated after `interlace` is reset.
+  int interlace_order_ = 0;
+  char interlace_trail_ = '\0';
+  bool interlace_by_order = std::sscanf(
+    this->interlace.c_str(), "%d%c", &interlace_order_, &interlace_trail_
+  ) == 1 && interlace_order_ >= 1;
+  if (interlace_by_order) {
+    this->interlace = (interlace_order_ > 1) ? "true" : "false";
+    this->interlace_order = interlace_order_;  // derivation
+  }
   if (this->interlace == "true" || this->interlace == "on") {
     this->interlace = "true";  // transmutation
+    if (!interlace_by_order) {
+      this->interlace_order = 2;  // derivation
+    }
   } else
   if (this->interlace == "false" || this->interlace == "off") {
     this->interlace = "false";  // transmutation
+    this->interlace_order = 1;  // derivation
   } else {
     if (trvs::currTask == 0) {
       trvs::logger.error(
-        "Interlacing must be 'true'/'on' or 'false'/'off': "
-        "`interlace` = '%s'.",
+        "Interlacing must be 'true'/'on', 'false'/'off' or "
+        "a positive integer order: `interlace` = '%s'.",
         this->interlace.c_str()
       );
       throw trvs::InvalidParameterError(
-        "Interlacing must be 'true'/'on' or 'false'/'off': "
-        "`interlace` = '%s'.\n",
+        "Interlacing must be 'true'/'on', 'false'/'off' or "
+        "a positive integer order: `interlace` = '%s'.\n",
         this->interlace.c_str()
       );
     }
   }
 
+  if (
+    this->checkpoint_fields == "true" || this->checkpoint_fields == "on"
+  ) {
+    this->checkpoint_fields = "true";  // transmutation
+  } else
+  if (
+    this->checkpoint_fields == "false" || this->checkpoint_fields == "off"
+    || this->checkpoint_fields == ""
+  ) {
+    this->checkpoint_fields = "false";  // transmutation
+  } else {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Field checkpointing must be 'true'/'on' or 'false'/'off': "
+        "`checkpoint_fields` = '%s'.",
+        this->checkpoint_fields.c_str()
+      );
+      throw trvs::InvalidParameterError(
+        "Field checkpointing must be 'true'/'on' or 'false'/'off': "
+        "`checkpoint_fields` = '%s'.\n",
+        this->checkpoint_fields.c_str()
+      );
+    }
+  }
+
   if (this->statistic_type == "powspec") {
     this->npoint = "2pt"; this->space = "fourier";  // derivation
   } else
@@ -529,6 +684,9 @@ int ParameterSet::validate() {
   } else
   if (this->statistic_type == "pairs") {
     this->npoint = "none"; this->space = "config";  // derivation
+  } else
+  if (this->statistic_type == "plan") {
+    this->npoint = "none"; this->space = "none";  // derivation
   } else {
 #ifndef TRV_EXTCALL
     if (trvs::currTask == 0) {
@@ -543,6 +701,46 @@ int ParameterSet::validate() {
     }
 #endif  // !TRV_EXTCALL
   }
+  if (this->data_catalogue_list != "" && this->catalogue_type != "survey") {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Data catalogue list `data_catalogue_list` is only supported "
+        "for survey-type catalogues: `catalogue_type` = '%s'.",
+        this->catalogue_type.c_str()
+      );
+      throw trvs::InvalidParameterError(
+        "Data catalogue list `data_catalogue_list` is only supported "
+        "for survey-type catalogues: `catalogue_type` = '%s'.\n",
+        this->catalogue_type.c_str()
+      );
+    }
+  }
+  if (this->mesh_cache_dir != "" && this->catalogue_type != "survey") {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Mesh field cache `mesh_cache_dir` is only supported "
+        "for survey-type catalogues: `catalogue_type` = '%s'.",
+        this->catalogue_type.c_str()
+      );
+      throw trvs::InvalidParameterError(
+        "Mesh field cache `mesh_cache_dir` is only supported "
+        "for survey-type catalogues: `catalogue_type` = '%s'.\n",
+        this->catalogue_type.c_str()
+      );
+    }
+  }
+  if (this->statistic_type == "plan" && this->measurement_plan == "") {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Measurement plan `measurement_plan` must be set "
+        "when `statistic_type` is 'plan'."
+      );
+      throw trvs::InvalidParameterError(
+        "Measurement plan `measurement_plan` must be set "
+        "when `statistic_type` is 'plan'.\n"
+      );
+    }
+  }
   if (!(
     this->form == "full"
     || this->form == "diag"
@@ -593,6 +791,48 @@ int ParameterSet::validate() {
       );
     }
   }
+  if (this->powspec_estimator == "") {
+    this->powspec_estimator = "ylm";  // transmutation
+  }
+  if (!(
+    this->powspec_estimator == "ylm"
+    || this->powspec_estimator == "cartesian"
+  )) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Power spectrum estimator must be 'ylm' or 'cartesian': "
+        "`powspec_estimator` = '%s'.",
+        this->powspec_estimator.c_str()
+      );
+      throw trvs::InvalidParameterError(
+        "Power spectrum estimator must be 'ylm' or 'cartesian': "
+        "`powspec_estimator` = '%s'.\n",
+        this->powspec_estimator.c_str()
+      );
+    }
+  }
+  if (this->crop_fourier == "true" || this->crop_fourier == "on") {
+    this->crop_fourier = "true";  // transmutation
+  } else
+  if (
+    this->crop_fourier == "false" || this->crop_fourier == "off"
+    || this->crop_fourier == ""
+  ) {
+    this->crop_fourier = "false";  // transmutation
+  } else {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Fourier-space cropping must be 'true'/'on' or 'false'/'off': "
+        "`crop_fourier` = '%s'.",
+        this->crop_fourier.c_str()
+      );
+      throw trvs::InvalidParameterError(
+        "Fourier-space cropping must be 'true'/'on' or 'false'/'off': "
+        "`crop_fourier` = '%s'.\n",
+        this->crop_fourier.c_str()
+      );
+    }
+  }
   if (!(
     this->binning == "lin"
     || this->binning == "log"
@@ -612,6 +852,68 @@ int ParameterSet::validate() {
     }
   }
 
+  if (this->output_type == "") {
+    this->output_type = "text";  // transmutation
+  }
+  if (!(this->output_type == "text" || this->output_type == "binary")) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Output type must be 'text' or 'binary': `output_type` = '%s'.",
+        this->output_type.c_str()
+      );
+      throw trvs::InvalidParameterError(
+        "Output type must be 'text' or 'binary': `output_type` = '%s'.\n",
+        this->output_type.c_str()
+      );
+    }
+  }
+
+  if (this->task_parallel == "true" || this->task_parallel == "on") {
+    this->task_parallel = "true";  // transmutation
+  } else
+  if (this->task_parallel == "false" || this->task_parallel == "off") {
+    this->task_parallel = "false";  // transmutation
+  } else
+  if (this->task_parallel == "auto" || this->task_parallel == "") {
+    this->task_parallel = "auto";  // transmutation
+  } else {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Task-parallel scheduling must be 'auto', 'true'/'on' or "
+        "'false'/'off': `task_parallel` = '%s'.",
+        this->task_parallel.c_str()
+      );
+      throw trvs::InvalidParameterError(
+        "Task-parallel scheduling must be 'auto', 'true'/'on' or "
+        "'false'/'off': `task_parallel` = '%s'.\n",
+        this->task_parallel.c_str()
+      );
+    }
+  }
+
+  if (this->pipeline == "true" || this->pipeline == "on") {
+    this->pipeline = "true";  // transmutation
+  } else
+  if (this->pipeline == "false" || this->pipeline == "off") {
+    this->pipeline = "false";  // transmutation
+  } else
+  if (this->pipeline == "auto" || this->pipeline == "") {
+    this->pipeline = "auto";  // transmutation
+  } else {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Bin-pair pipelining must be 'auto', 'true'/'on' or "
+        "'false'/'off': `pipeline` = '%s'.",
+        this->pipeline.c_str()
+      );
+      throw trvs::InvalidParameterError(
+        "Bin-pair pipelining must be 'auto', 'true'/'on' or "
+        "'false'/'off': `pipeline` = '%s'.\n",
+        this->pipeline.c_str()
+      );
+    }
+  }
+
   char default_bvec_sfilepath[1024];
   std::snprintf(
     default_bvec_sfilepath, sizeof(default_bvec_sfilepath),
@@ -631,38 +933,56 @@ int ParameterSet::validate() {
     }  // transmutation
   }
 
+  char default_trace_filepath[1024];
+  std::snprintf(
+    default_trace_filepath, sizeof(default_trace_filepath),
+    "%s/trace%s.json",
+    this->measurement_dir.c_str(), this->output_tag.c_str()
+  );
+  if (this->profile_trace == "false") {
+    this->profile_trace = "";  // transmutation
+  } else
+  if (this->profile_trace == "true") {
+    this->profile_trace = default_trace_filepath;  // transmutation
+  } else
+  if (this->profile_trace != "") {
+    if (this->profile_trace.rfind("/", 0) != 0) {
+      this->profile_trace = this->measurement_dir + this->profile_trace;
+    }  // transmutation
+  }
+
   // Validate and derive numerical parameters.
   this->volume =
     this->boxsize[0] * this->boxsize[1] * this->boxsize[2];  // derivation
-  this->nmesh =
-    this->ngrid[0] * this->ngrid[1] * this->ngrid[2];  // derivation
+  this->nmesh = (long long)(this->ngrid[0])
+    * this->ngrid[1] * this->ngrid[2];  // derivation
 
   if (this->volume <= 0.) {
     if (trvs::currTask == 0) {
       trvs::logger.error(
-        "Derived total box volume is non-positive: `volume` = '%d'. "
+        "Derived total box volume is non-positive: `volume` = '%.3f'. "
         "Possible numerical overflow due to large `boxsize`, "
         "or `boxsize` is unset.",
-        this->nmesh
+        this->volume
       );
       throw trvs::InvalidParameterError(
-        "Derived total box volume is non-positive: `volume` = '%d'. "
+        "Derived total box volume is non-positive: `volume` = '%.3f'. "
         "Possible numerical overflow due to large `boxsize`, "
         "or `boxsize` is unset.\n",
-        this->nmesh
+        this->volume
       );
     }
   }
   if (this->nmesh <= 0) {
     if (trvs::currTask == 0) {
       trvs::logger.error(
-        "Derived total mesh grid number is non-positive: `nmesh` = '%d'. "
+        "Derived total mesh grid number is non-positive: `nmesh` = '%lld'. "
         "Possible numerical overflow due to large `ngrid`, "
         "or `ngrid` is unset.",
         this->nmesh
       );
       throw trvs::InvalidParameterError(
-        "Derived total mesh grid number is non-positive: `nmesh` = '%d'. "
+        "Derived total mesh grid number is non-positive: `nmesh` = '%lld'. "
         "Possible numerical overflow due to large `ngrid`, "
         "or `ngrid` is unset.\n",
         this->nmesh
@@ -804,6 +1124,7 @@ int ParameterSet::validate() {
 
   if (this->npoint == "3pt" && this->interlace == "true") {
     this->interlace = "false";  // transmutation
+    this->interlace_order = 1;  // derivation
 
     if (trvs::currTask == 0) {
       trvs::logger.warn(
@@ -857,6 +1178,9 @@ int ParameterSet::print_to_file(char* out_parameter_filepath) {
   auto print_par_int = [ofileptr](const char* fmt, int par_val) {
     std::fprintf(ofileptr, fmt, par_val);
   };
+  auto print_par_longlong = [ofileptr](const char* fmt, long long par_val) {
+    std::fprintf(ofileptr, fmt, par_val);
+  };
   auto print_par_double = [ofileptr](const char* fmt, double par_val) {
     std::fprintf(ofileptr, fmt, par_val);
   };
@@ -865,9 +1189,15 @@ int ParameterSet::print_to_file(char* out_parameter_filepath) {
   print_par_str("catalogue_dir = %s\n", this->catalogue_dir);
   print_par_str("measurement_dir = %s\n", this->measurement_dir);
   print_par_str("data_catalogue_file = %s\n", this->data_catalogue_file);
+  print_par_str("data_catalogue_list = %s\n", this->data_catalogue_list);
   print_par_str("rand_catalogue_file = %s\n", this->rand_catalogue_file);
   print_par_str("catalogue_columns = %s\n", this->catalogue_columns);
   print_par_str("output_tag = %s\n", this->output_tag);
+  print_par_str("output_type = %s\n", this->output_type);
+  print_par_str("mesh_cache_dir = %s\n", this->mesh_cache_dir);
+  print_par_double("mesh_cache_size = %.3f\n", this->mesh_cache_size);
+  print_par_str("checkpoint_dir = %s\n", this->checkpoint_dir);
+  print_par_str("checkpoint_fields = %s\n", this->checkpoint_fields);
 
   print_par_double("boxsize_x = %.3f\n", this->boxsize[0]);
   print_par_double("boxsize_y = %.3f\n", this->boxsize[1]);
@@ -877,7 +1207,7 @@ int ParameterSet::print_to_file(char* out_parameter_filepath) {
   print_par_int("ngrid_z = %d\n", this->ngrid[2]);
 
   print_par_double("volume = %.6e\n", this->volume);
-  print_par_int("nmesh = %d\n", this->nmesh);
+  print_par_longlong("nmesh = %lld\n", this->nmesh);
 
   print_par_str("alignment = %s\n", this->alignment);
   print_par_str("padscale = %s\n", this->padscale);
@@ -886,9 +1216,11 @@ int ParameterSet::print_to_file(char* out_parameter_filepath) {
   print_par_str("assignment = %s\n", this->assignment);
   print_par_str("interlace = %s\n", this->interlace);
   print_par_int("assignment_order = %d\n", this->assignment_order);
+  print_par_int("interlace_order = %d\n", this->interlace_order);
 
   print_par_str("catalogue_type = %s\n", this->catalogue_type);
   print_par_str("statistic_type = %s\n", this->statistic_type);
+  print_par_str("measurement_plan = %s\n", this->measurement_plan);
   print_par_str("npoint = %s\n", this->npoint);
   print_par_str("space = %s\n", this->space);
 
@@ -901,6 +1233,8 @@ int ParameterSet::print_to_file(char* out_parameter_filepath) {
 
   print_par_str("form = %s\n", this->form);
   print_par_str("norm_convention = %s\n", this->norm_convention);
+  print_par_str("powspec_estimator = %s\n", this->powspec_estimator);
+  print_par_str("crop_fourier = %s\n", this->crop_fourier);
   print_par_str("binning = %s\n", this->binning);
 
   print_par_double("bin_min = %.4f\n", this->bin_min);
@@ -909,6 +1243,10 @@ int ParameterSet::print_to_file(char* out_parameter_filepath) {
   print_par_int("idx_bin = %d\n", this->idx_bin);
 
   print_par_str("save_binned_vectors = %s\n", this->save_binned_vectors);
+  print_par_str("task_parallel = %s\n", this->task_parallel);
+  print_par_str("pipeline = %s\n", this->pipeline);
+  print_par_double("memory_budget = %.3f\n", this->memory_budget);
+  print_par_str("profile_trace = %s\n", this->profile_trace);
   print_par_int("verbose = %d\n", this->verbose);
 
   std::fclose(ofileptr);
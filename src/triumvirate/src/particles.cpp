@@ -25,6 +25,8 @@
  */
 
 #include "particles.hpp"
+#include "io.hpp"
+#include "synthetic.hpp"
 
 namespace trvs = trv::sys;
 
@@ -40,7 +42,14 @@ ParticleCatalogue::ParticleCatalogue(int verbose) {
   }
 
   // Set default values (likely redundant but safe).
-  this->pdata = nullptr;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    this->pos[iaxis] = nullptr;
+  }
+  this->nz = nullptr;
+  this->ws = nullptr;
+  this->wc = nullptr;
+  this->w = nullptr;
+  this->wrapped = false;
   this->ntotal = 0;
   this->wtotal = 0.;
   this->wstotal = 0.;
@@ -48,12 +57,13 @@ ParticleCatalogue::ParticleCatalogue(int verbose) {
     this->pos_min[iaxis] = 0.;
     this->pos_max[iaxis] = 0.;
     this->pos_span[iaxis] = 0.;
+    this->observer[iaxis] = 0.;
   }
 }
 
 ParticleCatalogue::~ParticleCatalogue() {this->finalise_particles();}
 
-void ParticleCatalogue::initialise_particles(const int num) {
+void ParticleCatalogue::initialise_particles(const long long num) {
   // Check the total number of particles.
   if (num <= 0) {
     trvs::logger.error("Number of particles is non-positive.");
@@ -62,22 +72,87 @@ void ParticleCatalogue::initialise_particles(const int num) {
     );
   }
 
-  this->ntotal = num;
-
   // Renew particle data.
-  delete[] this->pdata; this->pdata = nullptr;
+  this->finalise_particles();
 
-  this->pdata = new ParticleData[this->ntotal];
+  this->ntotal = num;
+
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    this->pos[iaxis] = alloc_column<pos_type>(this->ntotal);
+  }
+  this->nz = alloc_column<double>(this->ntotal);
+  this->ws = alloc_column<double>(this->ntotal);
+  this->wc = alloc_column<double>(this->ntotal);
+  this->w = alloc_column<double>(this->ntotal);
 
-  trvs::gbytesMem += trvs::size_in_gb<struct ParticleData>(this->ntotal);
+  trvs::gbytesMem += this->get_owned_data_size_in_gb();
   trvs::update_maxmem();
 }
 
 void ParticleCatalogue::finalise_particles() {
-  // Free particle data.
-  if (this->pdata != nullptr) {
-    delete[] this->pdata; this->pdata = nullptr;
-    trvs::gbytesMem -= trvs::size_in_gb<struct ParticleData>(this->ntotal);
+  // Free particle data (or release wrapped data).
+  if (this->w != nullptr) {
+    trvs::gbytesMem -= this->get_owned_data_size_in_gb();
+
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+#ifndef TRV_USE_FLOAT_POS
+      if (this->wrapped) {this->pos[iaxis] = nullptr;}
+#endif  // !TRV_USE_FLOAT_POS
+      free_column(this->pos[iaxis]);
+    }
+    if (this->wrapped) {
+      this->nz = nullptr;
+      this->ws = nullptr;
+      this->wc = nullptr;
+    } else {
+      free_column(this->nz);
+      free_column(this->ws);
+      free_column(this->wc);
+    }
+    free_column(this->w);
+
+    this->wrapped = false;
+  }
+}
+
+void ParticleCatalogue::reset_catalogue() {
+  this->finalise_particles();
+
+  this->source.clear();
+  this->ntotal = 0;
+  this->wtotal = 0.;
+  this->wstotal = 0.;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    this->pos_min[iaxis] = 0.;
+    this->pos_max[iaxis] = 0.;
+    this->pos_span[iaxis] = 0.;
+    this->observer[iaxis] = 0.;
+  }
+}
+
+double ParticleCatalogue::get_owned_data_size_in_gb() {
+  if (!this->wrapped) {
+    return trvs::size_in_gb<pos_type>(3 * this->ntotal)
+      + trvs::size_in_gb<double>(4 * this->ntotal);
+  }
+
+#ifdef TRV_USE_FLOAT_POS
+  return trvs::size_in_gb<pos_type>(3 * this->ntotal)
+    + trvs::size_in_gb<double>(this->ntotal);
+#else  // !TRV_USE_FLOAT_POS
+  return trvs::size_in_gb<double>(this->ntotal);
+#endif  // TRV_USE_FLOAT_POS
+}
+
+template<typename T>
+T* ParticleCatalogue::alloc_column(const long long num) {
+  return static_cast<T*>(fftw_malloc(sizeof(T) * num));
+}
+
+template<typename T>
+void ParticleCatalogue::free_column(T*& column) {
+  if (column != nullptr) {
+    fftw_free(column); column = nullptr;
   }
 }
 
@@ -86,8 +161,19 @@ void ParticleCatalogue::finalise_particles() {
 // Operators & reserved methods
 // ***********************************************************************
 
-ParticleCatalogue::ParticleData& ParticleCatalogue::operator[](const int pid) {
-  return this->pdata[pid];
+ParticleCatalogue::ParticleData ParticleCatalogue::operator[](
+  const long long pid
+) const {
+  ParticleData particle;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    particle.pos[iaxis] = this->pos[iaxis][pid];
+  }
+  particle.nz = this->nz[pid];
+  particle.ws = this->ws[pid];
+  particle.wc = this->wc[pid];
+  particle.w = this->w[pid];
+
+  return particle;
 }
 
 
@@ -109,8 +195,23 @@ int ParticleCatalogue::load_catalogue_file(
       this->source.c_str()
     );
   }
+
+  // Generate a synthetic catalogue in place of a catalogue file.
+  if (SyntheticCatalogueGenerator::is_synthetic_source(catalogue_filepath)) {
+    this->source = catalogue_filepath;
+
+    SyntheticCatalogueGenerator generator(
+      SyntheticCatalogueGenerator::parse_spec(catalogue_filepath, volume)
+    );
+    generator.generate_particles(*this);
+
+    return 0;
+  }
+
   this->source = "extfile:" + catalogue_filepath;
 
+  trvs::ScopedTimer timer("catalogue_io");
+
   // ---------------------------------------------------------------------
   // Columns & fields
   // ---------------------------------------------------------------------
@@ -167,7 +268,7 @@ int ParticleCatalogue::load_catalogue_file(
   }
 
   // Initialise particle data.
-  int num_lines = 0;
+  long long num_lines = 0;
   std::string line_str;
   while (std::getline(fin, line_str)) {
     // Terminate at the end of file.
@@ -192,9 +293,9 @@ int ParticleCatalogue::load_catalogue_file(
 
   fin.open(catalogue_filepath.c_str(), std::ios::in);
 
-  int idx_line = 0;   // current line number
-  double nz, ws, wc;  // placeholder variables
-  double entry;       // data entry (per column per row)
+  long long idx_line = 0;  // current line number
+  double nz, ws, wc;       // placeholder variables
+  double entry;            // data entry (per column per row)
   while (std::getline(fin, line_str)) {  // std::string line_str;
     // Terminate at the end of file.
     if (!fin) {break;}
@@ -211,9 +312,9 @@ int ParticleCatalogue::load_catalogue_file(
     while (ss >> entry) {row.push_back(entry);}
 
     // Add the current line as a particle.
-    this->pdata[idx_line].pos[0] = row[name_indices[0]];  // x
-    this->pdata[idx_line].pos[1] = row[name_indices[1]];  // y
-    this->pdata[idx_line].pos[2] = row[name_indices[2]];  // z
+    this->pos[0][idx_line] = row[name_indices[0]];  // x
+    this->pos[1][idx_line] = row[name_indices[1]];  // y
+    this->pos[2][idx_line] = row[name_indices[2]];  // z
 
     if (name_indices[3] != -1) {
       nz = row[name_indices[3]];
@@ -233,16 +334,18 @@ int ParticleCatalogue::load_catalogue_file(
       wc = 1.;  // default value
     }
 
-    this->pdata[idx_line].nz = nz;
-    this->pdata[idx_line].ws = ws;
-    this->pdata[idx_line].wc = wc;
-    this->pdata[idx_line].w = ws * wc;
+    this->nz[idx_line] = nz;
+    this->ws[idx_line] = ws;
+    this->wc[idx_line] = wc;
+    this->w[idx_line] = ws * wc;
 
     idx_line++;
   }
 
   fin.close();
 
+  timer.add_data(trvs::size_in_gb<double>(colnames.size() * this->ntotal));
+
   // ---------------------------------------------------------------------
   // Catalogue properties
   // ---------------------------------------------------------------------
@@ -257,19 +360,23 @@ int ParticleCatalogue::load_catalogue_file(
 }
 
 int ParticleCatalogue::load_particle_data(
-  std::vector<double> x, std::vector<double> y, std::vector<double> z,
-  std::vector<double> nz, std::vector<double> ws, std::vector<double> wc
+  const std::vector<double>& x,
+  const std::vector<double>& y,
+  const std::vector<double>& z,
+  const std::vector<double>& nz,
+  const std::vector<double>& ws,
+  const std::vector<double>& wc
 ) {
   this->source = "extdata";
 
   // Check data array sizes.
-  int ntotal = x.size();
+  long long ntotal = x.size();
   if (!(
-    ntotal == int(y.size())
-    && ntotal == int(z.size())
-    && ntotal == int(nz.size())
-    && ntotal == int(ws.size())
-    && ntotal == int(wc.size())
+    ntotal == (long long)(y.size())
+    && ntotal == (long long)(z.size())
+    && ntotal == (long long)(nz.size())
+    && ntotal == (long long)(ws.size())
+    && ntotal == (long long)(wc.size())
   )) {
     if (trvs::currTask == 0) {
       trvs::logger.error(
@@ -289,14 +396,75 @@ int ParticleCatalogue::load_particle_data(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < ntotal; pid++) {
-    this->pdata[pid].pos[0] = x[pid];
-    this->pdata[pid].pos[1] = y[pid];
-    this->pdata[pid].pos[2] = z[pid];
-    this->pdata[pid].nz = nz[pid];
-    this->pdata[pid].ws = ws[pid];
-    this->pdata[pid].wc = wc[pid];
-    this->pdata[pid].w = ws[pid] * wc[pid];
+  for (long long pid = 0; pid < ntotal; pid++) {
+    this->pos[0][pid] = x[pid];
+    this->pos[1][pid] = y[pid];
+    this->pos[2][pid] = z[pid];
+    this->nz[pid] = nz[pid];
+    this->ws[pid] = ws[pid];
+    this->wc[pid] = wc[pid];
+    this->w[pid] = ws[pid] * wc[pid];
+  }
+
+  // Calculate sample weight sum.
+  this->calc_total_weights();
+
+  // Calculate the extents of particles.
+  this->calc_pos_extents();
+
+  return 0;
+}
+
+int ParticleCatalogue::wrap_particle_data(
+  const long long num,
+  double* x, double* y, double* z, double* nz, double* ws, double* wc
+) {
+  this->source = "extdata";
+
+  // Check the total number of particles.
+  if (num <= 0) {
+    trvs::logger.error("Number of particles is non-positive.");
+    throw trvs::InvalidParameterError(
+      "Number of particles is non-positive.\n"
+    );
+  }
+
+  // Wrap particle data.
+  this->finalise_particles();
+
+  this->ntotal = num;
+  this->wrapped = true;
+
+#ifdef TRV_USE_FLOAT_POS
+  double* pos_in[3] = {x, y, z};
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    this->pos[iaxis] = alloc_column<pos_type>(this->ntotal);
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for simd
+#endif  // TRV_USE_OMP
+    for (long long pid = 0; pid < this->ntotal; pid++) {
+      this->pos[iaxis][pid] = pos_in[iaxis][pid];
+    }
+  }
+#else  // !TRV_USE_FLOAT_POS
+  this->pos[0] = x;
+  this->pos[1] = y;
+  this->pos[2] = z;
+#endif  // TRV_USE_FLOAT_POS
+  this->nz = nz;
+  this->ws = ws;
+  this->wc = wc;
+  this->w = alloc_column<double>(this->ntotal);
+
+  trvs::gbytesMem += this->get_owned_data_size_in_gb();
+  trvs::update_maxmem();
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for simd
+#endif  // TRV_USE_OMP
+  for (long long pid = 0; pid < this->ntotal; pid++) {
+    this->w[pid] = ws[pid] * wc[pid];
   }
 
   // Calculate sample weight sum.
@@ -314,21 +482,24 @@ int ParticleCatalogue::load_particle_data(
 // ***********************************************************************
 
 void ParticleCatalogue::calc_total_weights() {
-  if (this->pdata == nullptr) {
+  if (this->w == nullptr) {
     if (trvs::currTask == 0) {
       trvs::logger.error("Particle data are uninitialised.");
       throw trvs::InvalidDataError("Particle data are uninitialised.\n");
     }
   }
 
+  const double* w = this->w;
+  const double* ws = this->ws;
+
   double wtotal = 0., wstotal = 0.;
 
 #ifdef TRV_USE_OMP
-#pragma omp parallel for reduction(+:wtotal, wstotal)
+#pragma omp parallel for simd reduction(+:wtotal, wstotal)
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < this->ntotal; pid++) {
-    wtotal += this->pdata[pid].w;
-    wstotal += this->pdata[pid].ws;
+  for (long long pid = 0; pid < this->ntotal; pid++) {
+    wtotal += w[pid];
+    wstotal += ws[pid];
   }
 
   this->wtotal = wtotal;
@@ -337,44 +508,39 @@ void ParticleCatalogue::calc_total_weights() {
   if (trvs::currTask == 0) {
     trvs::logger.info(
       "Catalogue loaded: "
-      "ntotal = %d, wtotal = %.3f, wstotal = %.3f (source=%s).",
+      "ntotal = %lld, wtotal = %.3f, wstotal = %.3f (source=%s).",
       this->ntotal, this->wtotal, this->wstotal, this->source.c_str()
     );
   }
 }
 
 void ParticleCatalogue::calc_pos_extents() {
-  if (this->pdata == nullptr) {
+  if (this->w == nullptr) {
     if (trvs::currTask == 0) {
       trvs::logger.error("Particle data are uninitialised.");
       throw trvs::InvalidDataError("Particle data are uninitialised.\n");
     }
   }
 
-  // Initialise minimum and maximum values with the 0th particle's.
-  double pos_min[3], pos_max[3];
+  // Update minimum and maximum values axis by axis, initialised with
+  // the 0th particle's.
   for (int iaxis = 0; iaxis < 3; iaxis++) {
-    pos_min[iaxis] = this->pdata[0].pos[iaxis];
-    pos_max[iaxis] = this->pdata[0].pos[iaxis];
-  }
+    const pos_type* pos = this->pos[iaxis];
+
+    pos_type pos_min = pos[0];
+    pos_type pos_max = pos[0];
 
-  // Update minimum and maximum values partice by particle.
 #ifdef TRV_USE_OMP
-#pragma omp parallel for reduction(min:pos_min) reduction(max:pos_max)
+#pragma omp parallel for simd reduction(min:pos_min) reduction(max:pos_max)
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < this->ntotal; pid++) {
-    for (int iaxis = 0; iaxis < 3; iaxis++) {
-      pos_min[iaxis] = (pos_min[iaxis] < this->pdata[pid].pos[iaxis]) ?
-        pos_min[iaxis] : this->pdata[pid].pos[iaxis];
-      pos_max[iaxis] = (pos_max[iaxis] > this->pdata[pid].pos[iaxis]) ?
-        pos_max[iaxis] : this->pdata[pid].pos[iaxis];
+    for (long long pid = 0; pid < this->ntotal; pid++) {
+      pos_min = (pos_min < pos[pid]) ? pos_min : pos[pid];
+      pos_max = (pos_max > pos[pid]) ? pos_max : pos[pid];
     }
-  }
 
-  for (int iaxis = 0; iaxis < 3; iaxis++) {
-    this->pos_min[iaxis] = pos_min[iaxis];
-    this->pos_max[iaxis] = pos_max[iaxis];
-    this->pos_span[iaxis] = pos_max[iaxis] - pos_min[iaxis];
+    this->pos_min[iaxis] = pos_min;
+    this->pos_max[iaxis] = pos_max;
+    this->pos_span[iaxis] = double(pos_max) - double(pos_min);
   }
 
   if (trvs::currTask == 0) {
@@ -392,26 +558,55 @@ void ParticleCatalogue::calc_pos_extents() {
   }
 }
 
+std::string ParticleCatalogue::calc_content_hash() {
+  if (this->w == nullptr) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error("Particle data are uninitialised.");
+      throw trvs::InvalidDataError("Particle data are uninitialised.\n");
+    }
+  }
+
+  std::uint64_t hash = trvs::update_data_hash(
+    &this->ntotal, sizeof(this->ntotal)
+  );
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    hash = trvs::update_data_hash(
+      this->pos[iaxis], this->ntotal * sizeof(pos_type), hash
+    );
+  }
+  hash = trvs::update_data_hash(
+    this->w, this->ntotal * sizeof(double), hash
+  );
+  hash = trvs::update_data_hash(this->observer, sizeof(this->observer), hash);
+
+  return trvs::format_data_hash(hash);
+}
+
 
 // ***********************************************************************
 // Catalogue operations
 // ***********************************************************************
 
 void ParticleCatalogue::offset_coords(const double dpos[3]) {
-  if (this->pdata == nullptr) {
+  if (this->w == nullptr) {
     if (trvs::currTask == 0) {
       trvs::logger.error("Particle data are uninitialised.");
       throw trvs::InvalidDataError("Particle data are uninitialised.\n");
     }
   }
 
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    pos_type* pos = this->pos[iaxis];
+    const double dpos_ = dpos[iaxis];
+
 #ifdef TRV_USE_OMP
-#pragma omp parallel for
+#pragma omp parallel for simd
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < this->ntotal; pid++) {
-    for (int iaxis = 0; iaxis < 3; iaxis++) {
-      this->pdata[pid].pos[iaxis] -= dpos[iaxis];
+    for (long long pid = 0; pid < this->ntotal; pid++) {
+      pos[pid] -= dpos_;
     }
+
+    this->observer[iaxis] -= dpos_;
   }
 
   this->calc_pos_extents();
@@ -419,16 +614,19 @@ void ParticleCatalogue::offset_coords(const double dpos[3]) {
 
 void ParticleCatalogue::\
 offset_coords_for_periodicity(const double boxsize[3]) {
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    pos_type* pos = this->pos[iaxis];
+    const double boxsize_ = boxsize[iaxis];
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < this->ntotal; pid++) {
-    for (int iaxis = 0; iaxis < 3; iaxis++) {
-      if (this->pdata[pid].pos[iaxis] >= boxsize[iaxis]) {
-        this->pdata[pid].pos[iaxis] -= boxsize[iaxis];
+    for (long long pid = 0; pid < this->ntotal; pid++) {
+      if (pos[pid] >= boxsize_) {
+        pos[pid] -= boxsize_;
       } else
-      if (this->pdata[pid].pos[iaxis] < 0.) {
-        this->pdata[pid].pos[iaxis] += boxsize[iaxis];
+      if (pos[pid] < 0.) {
+        pos[pid] += boxsize_;
       }
     }
   }
@@ -535,4 +733,26 @@ void ParticleCatalogue::pad_grids(
   catalogue.offset_coords(dvec);
 }
 
+
+
+// ***********************************************************************
+// Line of sight
+// ***********************************************************************
+
+LineOfSightPolicy::LineOfSightPolicy(LineOfSight* los) {
+  this->type = (los == nullptr) ? Type::local : Type::user;
+  this->los = los;
+  this->axis[0] = 0.; this->axis[1] = 0.; this->axis[2] = 1.;
+}
+
+LineOfSightPolicy LineOfSightPolicy::global_axis(const double axis[3]) {
+  LineOfSightPolicy policy;
+  policy.type = Type::global;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    policy.axis[iaxis] = axis[iaxis];
+  }
+
+  return policy;
+}
+
 }  // namespace trv
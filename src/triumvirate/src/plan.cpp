@@ -0,0 +1,250 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file plan.cpp
+ * @authors Mike S Wang (https://github.com/MikeSWang)
+ *
+ */
+
+#include "plan.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+namespace trvs = trv::sys;
+
+namespace trv {
+
+// ***********************************************************************
+// Life cycle
+// ***********************************************************************
+
+MeasurementPlan::MeasurementPlan(trv::ParameterSet& params) {
+  if (params.statistic_type != "plan") {
+    this->items.push_back(params);
+    return;
+  }
+
+  const std::vector<std::string> statistic_types_supported = {
+    "powspec", "2pcf", "2pcf-win", "bispec", "3pcf", "3pcf-win", "3pcf-win-wa"
+  };
+
+  std::stringstream plan_sstream(params.measurement_plan);
+  std::string item_str;
+  while (std::getline(plan_sstream, item_str, ',')) {
+    if (item_str.empty()) {continue;}
+
+    // Split the plan item into fields.
+    std::vector<std::string> item_fields;
+    std::stringstream item_sstream(item_str);
+    std::string field_str;
+    while (std::getline(item_sstream, field_str, ':')) {
+      item_fields.push_back(field_str);
+    }
+
+    if (item_fields.size() != 2 && item_fields.size() != 5) {
+      if (trvs::currTask == 0) {
+        trvs::logger.error(
+          "Measurement plan item is malformed: '%s'.", item_str.c_str()
+        );
+        throw trvs::InvalidParameterError(
+          "Measurement plan item is malformed: '%s'.\n", item_str.c_str()
+        );
+      }
+    }
+
+    std::string statistic_type = item_fields[0];
+    if (std::find(
+      statistic_types_supported.begin(), statistic_types_supported.end(),
+      statistic_type
+    ) == statistic_types_supported.end()) {
+      if (trvs::currTask == 0) {
+        trvs::logger.error(
+          "Statistic type is unsupported in measurement plan: '%s'.",
+          statistic_type.c_str()
+        );
+        throw trvs::InvalidParameterError(
+          "Statistic type is unsupported in measurement plan: '%s'.\n",
+          statistic_type.c_str()
+        );
+      }
+    }
+
+    // Derive the item parameter set, avoiding repeated transmutation
+    // of directory and file paths already validated.
+    trv::ParameterSet params_item(params);
+    params_item.statistic_type = statistic_type;
+    params_item.measurement_plan = "";
+    params_item.catalogue_dir = "";
+    params_item.save_binned_vectors = "false";
+
+    std::string degrees = item_fields[1];
+    bool degrees_valid = !degrees.empty() && std::all_of(
+      degrees.begin(), degrees.end(),
+      [](unsigned char c) {return std::isdigit(c);}
+    );
+    if (statistic_type == "powspec" || statistic_type.rfind("2pcf", 0) == 0) {
+      if (degrees_valid) {
+        params_item.ELL = std::stoi(degrees);
+      }
+    } else {
+      degrees_valid = degrees_valid && degrees.size() == 3;
+      if (degrees_valid) {
+        params_item.ell1 = degrees[0] - '0';
+        params_item.ell2 = degrees[1] - '0';
+        params_item.ELL = degrees[2] - '0';
+      }
+    }
+    if (!degrees_valid) {
+      if (trvs::currTask == 0) {
+        trvs::logger.error(
+          "Measurement plan item has invalid degrees: '%s'.",
+          item_str.c_str()
+        );
+        throw trvs::InvalidParameterError(
+          "Measurement plan item has invalid degrees: '%s'.\n",
+          item_str.c_str()
+        );
+      }
+    }
+
+    if (item_fields.size() == 5) {
+      if (
+        std::sscanf(item_fields[2].c_str(), "%lg", &params_item.bin_min) != 1
+        || std::sscanf(item_fields[3].c_str(), "%lg", &params_item.bin_max)
+          != 1
+        || std::sscanf(item_fields[4].c_str(), "%d", &params_item.num_bins)
+          != 1
+      ) {
+        if (trvs::currTask == 0) {
+          trvs::logger.error(
+            "Measurement plan item has invalid binning: '%s'.",
+            item_str.c_str()
+          );
+          throw trvs::InvalidParameterError(
+            "Measurement plan item has invalid binning: '%s'.\n",
+            item_str.c_str()
+          );
+        }
+      }
+    }
+
+    params_item.validate();
+
+    params_item.catalogue_dir = params.catalogue_dir;
+    params_item.measurement_dir = params.measurement_dir;
+
+    this->items.push_back(params_item);
+  }
+
+  if (this->items.empty()) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error("Measurement plan is empty.");
+      throw trvs::InvalidParameterError("Measurement plan is empty.\n");
+    }
+  }
+
+  // Order measurements by the line-of-sight degree so that
+  // fields of the same degree are used (and released) together.
+  std::stable_sort(
+    this->items.begin(), this->items.end(),
+    [](const trv::ParameterSet& a, const trv::ParameterSet& b) {
+      return a.ELL < b.ELL;
+    }
+  );
+
+  if (trvs::currTask == 0) {
+    trvs::logger.info(
+      "Measurement plan compiled: %d measurements.",
+      static_cast<int>(this->items.size())
+    );
+  }
+}
+
+
+// ***********************************************************************
+// Field dependencies
+// ***********************************************************************
+
+std::vector<std::string> MeasurementPlan::list_field_keys(
+  trv::ParameterSet& params
+) {
+  std::vector<std::string> keys;
+
+  auto add_key = [&keys, &params](const std::string type, int ell, int m) {
+    keys.push_back(trv::MeshFieldCache::get_key(type, ell, m, params));
+  };
+
+  bool is_2pt = params.statistic_type == "powspec"
+    || params.statistic_type == "2pcf";
+  bool is_3pt = params.statistic_type == "bispec"
+    || params.statistic_type == "3pcf";
+
+  if (params.catalogue_type == "survey") {
+    if (is_2pt) {
+      add_key("ylm_wgtd", 0, 0);
+      for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
+        add_key("ylm_wgtd", params.ELL, M_);
+      }
+    } else
+    if (is_3pt) {
+      add_key("ylm_wgtd", 0, 0);
+      add_key("ylm_wgtd_quad", 0, 0);
+      for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
+        add_key("ylm_wgtd", params.ELL, M_);
+        add_key("ylm_wgtd_config", params.ELL, M_);
+        if (params.statistic_type == "bispec") {
+          add_key("ylm_wgtd_quad", params.ELL, M_);
+        }
+      }
+    }
+  } else
+  if (params.catalogue_type == "sim") {
+    if (is_2pt) {
+      add_key("unwgtd_fluct", 0, 0);
+    } else
+    if (is_3pt) {
+      add_key("unwgtd_fluct", 0, 0);
+      add_key("unwgtd", 0, 0);
+      add_key("unwgtd_fluct_config", 0, 0);
+    }
+  }
+
+  return keys;
+}
+
+void MeasurementPlan::register_field_uses(trv::MeshFieldCache& field_cache) {
+  for (trv::ParameterSet& params_item : this->items) {
+    for (std::string key : MeasurementPlan::list_field_keys(params_item)) {
+      field_cache.register_use(key);
+    }
+  }
+}
+
+void MeasurementPlan::release_field_uses(
+  trv::ParameterSet& params, trv::MeshFieldCache& field_cache
+) {
+  for (std::string key : MeasurementPlan::list_field_keys(params)) {
+    field_cache.release_use(key);
+  }
+}
+
+}  // namespace trv
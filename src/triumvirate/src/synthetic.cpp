@@ -0,0 +1,619 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file synthetic.cpp
+ * @authors Mike S Wang (https://github.com/MikeSWang)
+ *
+ */
+
+#include "synthetic.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace trvs = trv::sys;
+
+namespace trv {
+
+namespace {
+
+/// prefix of synthetic catalogue sources
+const std::string SYNTHETIC_SOURCE_PREFIX = "synthetic:";
+/// mean number of particles per random stream
+const long long NPARTICLES_PER_STREAM = 65536;
+
+/**
+ * @brief Mix the bits of a 64-bit integer (SplitMix64 finaliser).
+ *
+ * @param z 64-bit integer.
+ * @returns Mixed 64-bit integer.
+ */
+std::uint64_t mix_bits(std::uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief SplitMix64 random engine for an independent random stream.
+ *
+ * The engine is cheap to seed, so that one can be created per stream.
+ *
+ */
+class StreamEngine {
+ public:
+  typedef std::uint64_t result_type;  ///< random number type
+
+  /**
+   * @brief Construct the random engine of a stream.
+   *
+   * @param seed Random seed.
+   * @param stream Stream index.
+   * @param salt Stream family identifier (default is 0).
+   */
+  StreamEngine(
+    unsigned long long seed, unsigned long long stream,
+    unsigned long long salt = 0
+  ) {
+    this->state = mix_bits(
+      mix_bits(seed + salt * 0x9e3779b97f4a7c15ULL) ^ mix_bits(stream)
+    );
+  }
+
+  static constexpr result_type min() {return 0;}
+  static constexpr result_type max() {return UINT64_MAX;}
+
+  /**
+   * @brief Draw a random number.
+   *
+   * @returns Random 64-bit integer.
+   */
+  result_type operator()() {
+    this->state += 0x9e3779b97f4a7c15ULL;
+    return mix_bits(this->state);
+  }
+
+  /**
+   * @brief Draw a uniform random number in [0, 1).
+   *
+   * @returns Uniform random number.
+   */
+  double uniform() {
+    return ((*this)() >> 11) * 0x1.0p-53;
+  }
+
+ private:
+  std::uint64_t state;  ///< engine state
+};
+
+}  // namespace
+
+
+// ***********************************************************************
+// Life cycle
+// ***********************************************************************
+
+SyntheticCatalogueGenerator::SyntheticCatalogueGenerator(
+  const SyntheticCatalogueSpec& spec
+) {
+  this->spec = spec;
+
+  if (!(
+    spec.type == "uniform" || spec.type == "poisson" || spec.type == "lognormal"
+  )) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Synthetic catalogue type must be "
+        "'uniform', 'poisson' or 'lognormal': `type` = '%s'.",
+        spec.type.c_str()
+      );
+    }
+    throw trvs::InvalidParameterError(
+      "Synthetic catalogue type must be "
+      "'uniform', 'poisson' or 'lognormal': `type` = '%s'.\n",
+      spec.type.c_str()
+    );
+  }
+  if (spec.num <= 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Synthetic catalogue particle number must be positive: "
+        "`num` = %lld.", spec.num
+      );
+    }
+    throw trvs::InvalidParameterError(
+      "Synthetic catalogue particle number must be positive: "
+      "`num` = %lld.\n", spec.num
+    );
+  }
+  if (!(
+    spec.boxsize[0] > 0. && spec.boxsize[1] > 0. && spec.boxsize[2] > 0.
+  )) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Synthetic catalogue box size must be positive: "
+        "`boxsize` = (%.3f, %.3f, %.3f).",
+        spec.boxsize[0], spec.boxsize[1], spec.boxsize[2]
+      );
+    }
+    throw trvs::InvalidParameterError(
+      "Synthetic catalogue box size must be positive: "
+      "`boxsize` = (%.3f, %.3f, %.3f).\n",
+      spec.boxsize[0], spec.boxsize[1], spec.boxsize[2]
+    );
+  }
+  if (spec.type == "lognormal" && (spec.ngrid < 2 || spec.sigma < 0.)) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Synthetic lognormal catalogue requires `ngrid` >= 2 and "
+        "`sigma` >= 0: `ngrid` = %d, `sigma` = %.3f.",
+        spec.ngrid, spec.sigma
+      );
+    }
+    throw trvs::InvalidParameterError(
+      "Synthetic lognormal catalogue requires `ngrid` >= 2 and "
+      "`sigma` >= 0: `ngrid` = %d, `sigma` = %.3f.\n",
+      spec.ngrid, spec.sigma
+    );
+  }
+  if (spec.radius_max > 0. && spec.radius_max <= spec.radius_min) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Synthetic catalogue mask radii must satisfy "
+        "`radius_min` < `radius_max`: %.3f >= %.3f.",
+        spec.radius_min, spec.radius_max
+      );
+    }
+    throw trvs::InvalidParameterError(
+      "Synthetic catalogue mask radii must satisfy "
+      "`radius_min` < `radius_max`: %.3f >= %.3f.\n",
+      spec.radius_min, spec.radius_max
+    );
+  }
+
+  this->nbar = spec.num
+    / (spec.boxsize[0] * spec.boxsize[1] * spec.boxsize[2]);
+
+  // Set up random streams: chunks of particles ("uniform"), blocks of
+  // the box ("poisson") or rows of mesh cells ("lognormal").
+  if (spec.type == "uniform") {
+    this->nstreams =
+      (spec.num + NPARTICLES_PER_STREAM - 1) / NPARTICLES_PER_STREAM;
+    this->nblocks[0] = this->nblocks[1] = this->nblocks[2] = 1;
+  } else
+  if (spec.type == "poisson") {
+    int nblock = std::max(1, int(std::round(
+      std::cbrt(double(spec.num) / NPARTICLES_PER_STREAM)
+    )));
+    this->nblocks[0] = this->nblocks[1] = this->nblocks[2] = nblock;
+    this->nstreams = (long long)(nblock) * nblock * nblock;
+  } else
+  if (spec.type == "lognormal") {
+    this->nblocks[0] = this->nblocks[1] = spec.ngrid;
+    this->nblocks[2] = 1;
+    this->nstreams = (long long)(spec.ngrid) * spec.ngrid;
+
+    this->compute_lognormal_means();
+  }
+}
+
+bool SyntheticCatalogueGenerator::is_synthetic_source(
+  const std::string& source
+) {
+  return source.rfind(SYNTHETIC_SOURCE_PREFIX, 0) == 0;
+}
+
+SyntheticCatalogueSpec SyntheticCatalogueGenerator::parse_spec(
+  const std::string& source, double volume
+) {
+  SyntheticCatalogueSpec spec;
+
+  std::string spec_str = source;
+  if (is_synthetic_source(spec_str)) {
+    spec_str = spec_str.substr(SYNTHETIC_SOURCE_PREFIX.size());
+  }
+
+  bool boxsize_set = false;
+
+  std::istringstream iss(spec_str);
+  std::string entry;
+  while (std::getline(iss, entry, ',')) {
+    if (entry.empty()) {continue;}
+
+    std::size_t pos_eq = entry.find('=');
+    std::string key = entry.substr(0, pos_eq);
+    std::string val =
+      (pos_eq == std::string::npos) ? "" : entry.substr(pos_eq + 1);
+
+    try {
+      if (key == "type") {
+        spec.type = val;
+      } else
+      if (key == "num") {
+        spec.num = std::llround(std::stod(val));
+      } else
+      if (key == "seed") {
+        spec.seed = std::stoull(val);
+      } else
+      if (key == "boxsize") {
+        std::istringstream iss_box(val);
+        std::string length;
+        int iaxis = 0;
+        while (std::getline(iss_box, length, ':') && iaxis < 3) {
+          spec.boxsize[iaxis++] = std::stod(length);
+        }
+        if (iaxis == 1) {
+          spec.boxsize[1] = spec.boxsize[2] = spec.boxsize[0];
+        } else
+        if (iaxis != 3) {
+          throw std::invalid_argument(val);
+        }
+        boxsize_set = true;
+      } else
+      if (key == "ngrid") {
+        spec.ngrid = std::stoi(val);
+      } else
+      if (key == "sigma") {
+        spec.sigma = std::stod(val);
+      } else
+      if (key == "index") {
+        spec.index = std::stod(val);
+      } else
+      if (key == "smoothing") {
+        spec.smoothing = std::stod(val);
+      } else
+      if (key == "radius_min") {
+        spec.radius_min = std::stod(val);
+      } else
+      if (key == "radius_max") {
+        spec.radius_max = std::stod(val);
+      } else
+      if (key == "radial_scale") {
+        spec.radial_scale = std::stod(val);
+      } else {
+        throw std::invalid_argument(key);
+      }
+    } catch (const std::logic_error&) {
+      if (trvs::currTask == 0) {
+        trvs::logger.error(
+          "Invalid synthetic catalogue specification entry: '%s'.",
+          entry.c_str()
+        );
+      }
+      throw trvs::InvalidParameterError(
+        "Invalid synthetic catalogue specification entry: '%s'.\n",
+        entry.c_str()
+      );
+    }
+  }
+
+  if (!boxsize_set && volume > 0.) {
+    spec.boxsize[0] = spec.boxsize[1] = spec.boxsize[2] = std::cbrt(volume);
+  }
+
+  return spec;
+}
+
+
+// ***********************************************************************
+// Generation
+// ***********************************************************************
+
+long long SyntheticCatalogueGenerator::count_particles() {
+  if (this->counts.empty()) {
+    this->counts.resize(this->nstreams);
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for schedule(dynamic)
+#endif  // TRV_USE_OMP
+    for (long long stream = 0; stream < this->nstreams; stream++) {
+      this->counts[stream] = this->draw_stream<double>(
+        stream, nullptr, nullptr, nullptr, nullptr
+      );
+    }
+  }
+
+  long long ntotal = 0;
+  for (long long count : this->counts) {
+    ntotal += count;
+  }
+  return ntotal;
+}
+
+void SyntheticCatalogueGenerator::generate_particles(
+  double* x, double* y, double* z, double* nz
+) {
+  this->generate_columns<double>(x, y, z, nz);
+}
+
+void SyntheticCatalogueGenerator::generate_particles(
+  ParticleCatalogue& catalogue
+) {
+  trvs::ScopedTimer timer("catalogue_synthesis");
+
+  long long ntotal = this->count_particles();
+
+  catalogue.initialise_particles(ntotal);
+
+  this->generate_columns<pos_type>(
+    catalogue.pos[0], catalogue.pos[1], catalogue.pos[2], catalogue.nz
+  );
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (long long pid = 0; pid < ntotal; pid++) {
+    catalogue.ws[pid] = 1.;
+    catalogue.wc[pid] = 1.;
+    catalogue.w[pid] = 1.;
+  }
+
+  timer.add_data(
+    trvs::size_in_gb<pos_type>(3*ntotal) + trvs::size_in_gb<double>(4*ntotal)
+  );
+
+  catalogue.calc_total_weights();
+  catalogue.calc_pos_extents();
+}
+
+template <typename T>
+void SyntheticCatalogueGenerator::generate_columns(
+  T* x, T* y, T* z, double* nz
+) {
+  this->count_particles();
+
+  std::vector<long long> offsets(this->nstreams, 0);
+  for (long long stream = 1; stream < this->nstreams; stream++) {
+    offsets[stream] = offsets[stream - 1] + this->counts[stream - 1];
+  }
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for schedule(dynamic)
+#endif  // TRV_USE_OMP
+  for (long long stream = 0; stream < this->nstreams; stream++) {
+    long long offset = offsets[stream];
+    this->draw_stream<T>(
+      stream, x + offset, y + offset, z + offset, nz + offset
+    );
+  }
+}
+
+template <typename T>
+long long SyntheticCatalogueGenerator::draw_stream(
+  long long stream, T* x, T* y, T* z, double* nz
+) {
+  StreamEngine engine(this->spec.seed, stream);
+
+  const double* boxsize = this->spec.boxsize;
+  const double centre[3] = {boxsize[0]/2., boxsize[1]/2., boxsize[2]/2.};
+  const bool masked = (this->spec.radius_max > 0.);
+  const bool selected = (this->spec.radial_scale > 0.);
+
+  long long count = 0;
+
+  // Accept a particle drawn at the given position subject to the mask
+  // and the radial selection (by thinning), and record it if needed.
+  auto accept = [&](double px, double py, double pz) {
+    double phi = 1.;
+    if (masked || selected) {
+      double r = std::sqrt(
+        (px - centre[0]) * (px - centre[0])
+        + (py - centre[1]) * (py - centre[1])
+        + (pz - centre[2]) * (pz - centre[2])
+      );
+      if (
+        masked && (r < this->spec.radius_min || r >= this->spec.radius_max)
+      ) {
+        return;
+      }
+      if (selected) {
+        phi = std::exp(
+          - r * r / (2. * this->spec.radial_scale * this->spec.radial_scale)
+        );
+        if (engine.uniform() >= phi) {return;}
+      }
+    }
+
+    if (x != nullptr) {
+      x[count] = static_cast<T>(px);
+      y[count] = static_cast<T>(py);
+      z[count] = static_cast<T>(pz);
+      nz[count] = this->nbar * phi;
+    }
+    count++;
+  };
+
+  // Draw particles uniformly in a cuboid with the given corner and sides.
+  auto draw_in_cuboid = [&](
+    long long num, const double lo[3], const double len[3]
+  ) {
+    for (long long ipar = 0; ipar < num; ipar++) {
+      double px = lo[0] + len[0] * engine.uniform();
+      double py = lo[1] + len[1] * engine.uniform();
+      double pz = lo[2] + len[2] * engine.uniform();
+      accept(px, py, pz);
+    }
+  };
+
+  if (this->spec.type == "uniform") {
+    long long num = std::min(
+      NPARTICLES_PER_STREAM, this->spec.num - stream * NPARTICLES_PER_STREAM
+    );
+    const double lo[3] = {0., 0., 0.};
+    draw_in_cuboid(num, lo, boxsize);
+  } else
+  if (this->spec.type == "poisson") {
+    int ib = int(stream / (this->nblocks[1] * this->nblocks[2]));
+    int jb = int(stream / this->nblocks[2] % this->nblocks[1]);
+    int kb = int(stream % this->nblocks[2]);
+
+    const double len[3] = {
+      boxsize[0] / this->nblocks[0],
+      boxsize[1] / this->nblocks[1],
+      boxsize[2] / this->nblocks[2]
+    };
+    const double lo[3] = {ib * len[0], jb * len[1], kb * len[2]};
+
+    std::poisson_distribution<long long> poisson(
+      this->nbar * len[0] * len[1] * len[2]
+    );
+    draw_in_cuboid(poisson(engine), lo, len);
+  } else
+  if (this->spec.type == "lognormal") {
+    const int ngrid = this->spec.ngrid;
+    int i = int(stream / ngrid);
+    int j = int(stream % ngrid);
+
+    const double len[3] = {
+      boxsize[0] / ngrid, boxsize[1] / ngrid, boxsize[2] / ngrid
+    };
+
+    for (int k = 0; k < ngrid; k++) {
+      double mean = this->means[(stream * ngrid) + k];
+      if (!(mean > 0.)) {continue;}
+
+      const double lo[3] = {i * len[0], j * len[1], k * len[2]};
+
+      std::poisson_distribution<long long> poisson(mean);
+      draw_in_cuboid(poisson(engine), lo, len);
+    }
+  }
+
+  return count;
+}
+
+void SyntheticCatalogueGenerator::compute_lognormal_means() {
+  const int ngrid = this->spec.ngrid;
+  const long long ncells = (long long)(ngrid) * ngrid * ngrid;
+  const double* boxsize = this->spec.boxsize;
+
+  fftw_complex* field = fftw_alloc_complex(ncells);
+
+  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(ncells);
+  trvs::update_maxmem();
+
+  // Draw white noise by row of mesh cells.
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (long long row = 0; row < (long long)(ngrid) * ngrid; row++) {
+    StreamEngine engine(this->spec.seed, row, 1);
+    std::normal_distribution<double> normal;
+    for (int k = 0; k < ngrid; k++) {
+      field[row * ngrid + k][0] = normal(engine);
+      field[row * ngrid + k][1] = 0.;
+    }
+  }
+
+  fftw_plan transform, inv_transform;
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+    fftw_init_threads();
+    fftw_plan_with_nthreads(omp_get_max_threads());
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+
+    transform = fftw_plan_dft_3d(
+      ngrid, ngrid, ngrid, field, field, FFTW_FORWARD, FFTW_ESTIMATE
+    );
+    inv_transform = fftw_plan_dft_3d(
+      ngrid, ngrid, ngrid, field, field, FFTW_BACKWARD, FFTW_ESTIMATE
+    );
+  }
+
+  // Filter the white noise with the square root of the power spectrum
+  // P(k) ∝ k^n exp(-k² R²).
+  fftw_execute(transform);
+
+  double smoothing = (this->spec.smoothing > 0.) ? this->spec.smoothing
+    : *std::max_element(boxsize, boxsize + 3) / ngrid;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(3)
+#endif  // TRV_USE_OMP
+  for (int i = 0; i < ngrid; i++) {
+    for (int j = 0; j < ngrid; j++) {
+      for (int k = 0; k < ngrid; k++) {
+        long long idx_grid = ((long long)(i) * ngrid + j) * ngrid + k;
+
+        double kx = 2*M_PI / boxsize[0] * ((i < ngrid/2) ? i : i - ngrid);
+        double ky = 2*M_PI / boxsize[1] * ((j < ngrid/2) ? j : j - ngrid);
+        double kz = 2*M_PI / boxsize[2] * ((k < ngrid/2) ? k : k - ngrid);
+        double k_ = std::sqrt(kx * kx + ky * ky + kz * kz);
+
+        double amp = 0.;
+        if (k_ > 0.) {
+          amp = std::sqrt(
+            std::pow(k_, this->spec.index)
+            * std::exp(- k_ * k_ * smoothing * smoothing)
+          );
+        }
+
+        field[idx_grid][0] *= amp;
+        field[idx_grid][1] *= amp;
+      }
+    }
+  }
+
+  fftw_execute(inv_transform);
+
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_destroy_plan(transform);
+    fftw_destroy_plan(inv_transform);
+  }
+
+  // Normalise the Gaussian field to the target variance and
+  // exponentiate to the lognormal density.
+  double var = 0.;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for reduction(+:var)
+#endif  // TRV_USE_OMP
+  for (long long gid = 0; gid < ncells; gid++) {
+    var += field[gid][0] * field[gid][0];
+  }
+  var /= ncells;
+
+  double scale = (var > 0.) ? this->spec.sigma / std::sqrt(var) : 0.;
+  double mean_cell = this->nbar * (boxsize[0] / ngrid)
+    * (boxsize[1] / ngrid) * (boxsize[2] / ngrid);
+  double sigma2 = this->spec.sigma * this->spec.sigma;
+
+  this->means.resize(ncells);
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (long long gid = 0; gid < ncells; gid++) {
+    this->means[gid] =
+      mean_cell * std::exp(scale * field[gid][0] - sigma2 / 2.);
+  }
+
+  fftw_free(field); field = nullptr;
+
+  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(ncells);
+}
+
+}  // namespace trv
@@ -69,7 +69,7 @@ void validate_multipole_coupling(trv::ParameterSet& params) {
 double calc_bispec_normalisation_from_particles(
   ParticleCatalogue& particles, double alpha
 ) {
-  if (particles.pdata == nullptr) {
+  if (particles.w == nullptr) {
     if (trvs::currTask == 0) {
       trvs::logger.error("Particle data are uninitialised.");
       throw trvs::InvalidDataError("Particle data are uninitialised.\n");
@@ -81,9 +81,9 @@ double calc_bispec_normalisation_from_particles(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:norm)
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    norm += particles[pid].ws
-      * std::pow(particles[pid].nz, 2) * std::pow(particles[pid].wc, 3);
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
+    norm += particles.ws[pid]
+      * std::pow(particles.nz[pid], 2) * std::pow(particles.wc[pid], 3);
   }
 
   if (norm == 0.) {
@@ -124,23 +124,29 @@ double calc_bispec_normalisation_from_mesh(
 
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   double alpha, int ell, int m
 ) {
+  trvs::ScopedTimer timer(
+    "shotnoise",
+    trvs::size_in_gb<double>(
+      4*(particles_data.ntotal + particles_rand.ntotal)
+    )
+  );
+
   double sn_data_real = 0., sn_data_imag = 0.;
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_data_real, sn_data_imag)
 #endif
-  for (int pid = 0; pid < particles_data.ntotal; pid++) {
-    double los_[3] = {
-      los_data[pid].pos[0], los_data[pid].pos[1], los_data[pid].pos[2]
-    };
+  for (long long pid = 0; pid < particles_data.ntotal; pid++) {
+    double los_[3];
+    los_data.eval(particles_data, pid, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
 
-    std::complex<double> sn_part = ylm * std::pow(particles_data[pid].w, 3);
+    std::complex<double> sn_part = ylm * std::pow(particles_data.w[pid], 3);
     double sn_part_real = sn_part.real();
     double sn_part_imag = sn_part.imag();
 
@@ -155,15 +161,14 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_rand_real, sn_rand_imag)
 #endif
-  for (int pid = 0; pid < particles_rand.ntotal; pid++) {
-    double los_[3] = {
-      los_rand[pid].pos[0], los_rand[pid].pos[1], los_rand[pid].pos[2]
-    };
+  for (long long pid = 0; pid < particles_rand.ntotal; pid++) {
+    double los_[3];
+    los_rand.eval(particles_rand, pid, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
 
-    std::complex<double> sn_part = ylm * std::pow(particles_rand[pid].w, 3);
+    std::complex<double> sn_part = ylm * std::pow(particles_rand.w[pid], 3);
     double sn_part_real = sn_part.real();
     double sn_part_imag = sn_part.imag();
 
@@ -177,21 +182,27 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
 }
 
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
-  ParticleCatalogue& particles, LineOfSight* los,
+  ParticleCatalogue& particles, const LineOfSightPolicy& los,
   double alpha, int ell, int m
 ) {
+  trvs::ScopedTimer timer(
+    "shotnoise", trvs::size_in_gb<double>(4*particles.ntotal)
+  );
+
   double sn_real = 0., sn_imag = 0.;
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_real, sn_imag)
 #endif
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    double los_[3] = {los[pid].pos[0], los[pid].pos[1], los[pid].pos[2]};
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
+    double los_[3];
+
+    los.eval(particles, pid, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
 
-    std::complex<double> sn_part = ylm * std::pow(particles[pid].w, 3);
+    std::complex<double> sn_part = ylm * std::pow(particles.w[pid], 3);
     double sn_part_real = sn_part.real();
     double sn_part_imag = sn_part.imag();
 
@@ -205,6 +216,466 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
 }
 
 
+// ***********************************************************************
+// Bin-pair scheduling
+// ***********************************************************************
+
+namespace {
+
+/// maximum number of mesh grid cells for automatic task parallelism
+const long long NMESH_TASK_PARALLEL_MAX = 256LL * 256LL * 256LL;
+/// minimum number of threads for automatic pipelining
+const int NTHREADS_PIPELINE_MIN = 4;
+/// number of mesh grid cells per chunk in pipelined reductions
+const long long NMESH_REDUCTION_CHUNK = 32768;
+
+/**
+ * @brief Pair of bins of a three-point statistic data vector entry.
+ */
+struct BinPair {
+  int idx_dv;  ///< data vector index
+  int ibin_a;  ///< first bin index
+  int ibin_b;  ///< second bin index
+};
+
+/**
+ * @brief Triple-product reduction of a bin pair.
+ */
+struct BinPairProduct {
+  std::complex<double> component;  ///< triple-product sum over the mesh
+  double eff_a;                     ///< first effective bin coordinate
+  double eff_b;                     ///< second effective bin coordinate
+  long long count_a;                ///< first bin mode count
+  long long count_b;                ///< second bin mode count
+};
+
+/**
+ * @brief List bin pairs of a three-point statistic data vector in
+ *        the order of data vector indices.
+ *
+ * @param params Parameter set.
+ * @param dv_dim Data vector dimension.
+ * @returns Bin pairs.
+ */
+std::vector<BinPair> list_bin_pairs(trv::ParameterSet& params, int dv_dim) {
+  std::vector<BinPair> pairs;
+  if (params.form == "diag") {
+    for (int idx_dv = 0; idx_dv < dv_dim; idx_dv++) {
+      pairs.push_back({idx_dv, idx_dv, idx_dv});
+    }
+  } else
+  if (params.form == "off-diag") {
+    for (int idx_dv = 0; idx_dv < dv_dim; idx_dv++) {
+      pairs.push_back({idx_dv, idx_dv, idx_dv + params.idx_bin});
+    }
+  } else
+  if (params.form == "row") {
+    for (int idx_dv = 0; idx_dv < dv_dim; idx_dv++) {
+      pairs.push_back({idx_dv, params.idx_bin, idx_dv});
+    }
+  } else
+  if (params.form == "full") {
+    for (int idx_row = 0; idx_row < params.num_bins; idx_row++) {
+      for (int idx_col = idx_row; idx_col < params.num_bins; idx_col++) {
+        int idx_dv = (2*params.num_bins - idx_row + 1) * idx_row / 2
+          + (idx_col - idx_row);
+        pairs.push_back({idx_dv, idx_row, idx_col});
+      }
+    }
+  }
+  return pairs;
+}
+
+/**
+ * @brief Scheduling of bin pairs across threads.
+ */
+enum class BinPairSchedule {
+  loop,      ///< bin pairs in turn with each mesh loop parallelised
+  pipeline,  ///< bin pairs pipelined over double-buffered fields
+  task       ///< bin blocks distributed across threads as tasks
+};
+
+/**
+ * @brief Choose the scheduling of bin pairs across threads.
+ *
+ * Unless forced by @ref trv::ParameterSet::task_parallel, tasks are
+ * used when the mesh is small enough for per-loop threading overhead
+ * to dominate and there are enough bin pairs to occupy all threads.
+ * Otherwise, unless forced by @ref trv::ParameterSet::pipeline,
+ * bin pairs are pipelined when there are enough threads to split
+ * between filling fields and reducing their products.  Either is
+ * only used if its additional fields fit within
+ * @ref trv::ParameterSet::memory_budget.
+ *
+ * @param params Parameter set.
+ * @param npairs Number of bin pairs.
+ * @returns Bin-pair scheduling.
+ */
+BinPairSchedule choose_bin_pair_schedule(
+  trv::ParameterSet& params, int npairs
+) {
+#ifdef TRV_USE_OMP
+  int nthreads = omp_get_max_threads();
+
+  // Each worker thread holds its own pair of fields in task-level
+  // scheduling, and pipelining holds a second pair of fields.
+  double gbytes_pair = 2 * MeshField::get_size_in_gb(params);
+
+  if (
+    params.task_parallel == "true" || (
+      params.task_parallel == "auto"
+      && nthreads > 1 && npairs >= nthreads
+      && params.nmesh <= NMESH_TASK_PARALLEL_MAX
+    )
+  ) {
+    double gbytes_workers = (nthreads - 1) * gbytes_pair;
+    if (trvs::reserve_mem_budget(gbytes_workers, params.memory_budget)) {
+      return BinPairSchedule::task;
+    }
+    if (params.task_parallel == "true" && trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Task-parallel scheduling is disabled as it would exceed "
+        "the memory budget."
+      );
+    }
+  }
+
+  if (
+    params.pipeline == "true" || (
+      params.pipeline == "auto"
+      && nthreads >= NTHREADS_PIPELINE_MIN && npairs > 1
+    )
+  ) {
+    if (trvs::reserve_mem_budget(gbytes_pair, params.memory_budget)) {
+      return BinPairSchedule::pipeline;
+    }
+    if (params.pipeline == "true" && trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Pipelining is disabled as it would exceed the memory budget."
+      );
+    }
+  }
+#else  // !TRV_USE_OMP
+  if (params.task_parallel == "true" && trvs::currTask == 0) {
+    trvs::logger.warn(
+      "Task-parallel scheduling is unavailable without OpenMP."
+    );
+  }
+  if (params.pipeline == "true" && trvs::currTask == 0) {
+    trvs::logger.warn("Pipelining is unavailable without OpenMP.");
+  }
+#endif  // TRV_USE_OMP
+
+  return BinPairSchedule::loop;
+}
+
+/**
+ * @brief Return the name of a bin-pair scheduling.
+ *
+ * @param schedule Bin-pair scheduling.
+ * @returns Scheduling name.
+ */
+const char* get_bin_pair_schedule_name(BinPairSchedule schedule) {
+  switch (schedule) {
+    case BinPairSchedule::pipeline: return "pipelined";
+    case BinPairSchedule::task: return "task-level";
+    default: return "loop-level";
+  }
+}
+
+/**
+ * @brief Set up the mesh grid for the raw bispectrum.
+ *
+ * If @ref trv::ParameterSet::crop_fourier is "true", the mesh grid is
+ * cropped in Fourier space to hold the wavevector modes up to twice
+ * the maximum wavenumber bin edge, which are the only ones entering
+ * the triple products @f$ F_a F_b G @f$ of band-limited fields
+ * (see @ref trv::MeshField::get_cropped_params()).
+ *
+ * @param params Parameter set.
+ * @param kbinning Wavenumber binning.
+ * @returns Parameter set of the (cropped) mesh grid.
+ */
+trv::ParameterSet set_up_bispec_mesh(
+  trv::ParameterSet& params, trv::Binning& kbinning
+) {
+  if (params.crop_fourier != "true") {return params;}
+
+  trv::ParameterSet params_crop =
+    MeshField::get_cropped_params(params, kbinning.bin_max);
+
+  if (params_crop.nmesh >= params.nmesh) {
+    if (trvs::currTask == 0) {
+      trvs::logger.info(
+        "Mesh grid is not cropped in Fourier space, as no coarser "
+        "FFT-friendly mesh grid holds the wavevector modes needed."
+      );
+    }
+    return params;
+  }
+
+  if (trvs::currTask == 0) {
+    trvs::logger.info(
+      "Mesh grid is cropped in Fourier space for the raw bispectrum: "
+      "(%d, %d, %d) -> (%d, %d, %d).",
+      params.ngrid[0], params.ngrid[1], params.ngrid[2],
+      params_crop.ngrid[0], params_crop.ngrid[1], params_crop.ngrid[2]
+    );
+  }
+
+  return params_crop;
+}
+
+/**
+ * @brief Reduce the triple products @f$ F_a F_b G @f$ over the mesh
+ *        for bin pairs.
+ *
+ * With loop-level scheduling, bin pairs are run in turn with each mesh
+ * loop parallelised.  With pipelined scheduling, the fields of the
+ * next bin pair are filled by one thread group while the product of
+ * the current bin pair is reduced by another, alternating between two
+ * pairs of fields; the reduction is summed in fixed chunks so that it
+ * is independent of the thread count.  With task-level scheduling,
+ * bin pairs are split into blocks sharing the first bin, which are
+ * dynamically distributed across threads each with its own fields and
+ * single-threaded FFT plans.  Results are returned by bin pair, so
+ * their accumulation order is reproducible.
+ *
+ * @tparam FillFunc Field filling function type.
+ * @param params Parameter set.
+ * @param pairs Bin pairs.
+ * @param G Configuration-space field @f$ G @f$.
+ * @param fill Function filling a configuration-space field
+ *             @f$ F_a @f$ (side 0) or @f$ F_b @f$ (side 1) for a bin
+ *             pair and returning the effective bin coordinate and
+ *             mode count.
+ * @param schedule Bin-pair scheduling.
+ * @returns Triple-product reductions by bin pair.
+ */
+template <typename FillFunc>
+std::vector<BinPairProduct> reduce_bin_pair_products(
+  trv::ParameterSet& params, const std::vector<BinPair>& pairs,
+  MeshField& G, FillFunc fill, BinPairSchedule schedule
+) {
+  int npairs = static_cast<int>(pairs.size());
+  std::vector<BinPairProduct> products(npairs);
+
+  // Fill the fields of a bin pair, reusing @f$ F_a @f$ if it already
+  // holds the first bin.
+  auto fill_pair = [&](
+    MeshField& F_a, MeshField& F_b, int& ibin_a_filled,
+    double& eff_a, long long& count_a, int ipair
+  ) {
+    const BinPair& pair = pairs[ipair];
+
+    if (pair.ibin_a != ibin_a_filled) {
+      fill(F_a, 0, pair, eff_a, count_a);
+      ibin_a_filled = pair.ibin_a;
+    }
+    products[ipair].eff_a = eff_a;
+    products[ipair].count_a = count_a;
+
+    fill(F_b, 1, pair, products[ipair].eff_b, products[ipair].count_b);
+  };
+
+  // Run a block of bin pairs in turn.
+#ifdef TRV_USE_OMP
+  bool task_parallel = (schedule == BinPairSchedule::task);
+#endif  // TRV_USE_OMP
+  auto run_block = [&](
+    MeshField& F_a, MeshField& F_b, int ipair_begin, int ipair_end
+  ) {
+    int ibin_a_filled = -1;
+    double eff_a = 0.;
+    long long count_a = 0;
+    for (int ipair = ipair_begin; ipair < ipair_end; ipair++) {
+      fill_pair(F_a, F_b, ibin_a_filled, eff_a, count_a, ipair);
+
+      trvs::ScopedTimer timer(
+        "reduction", trvs::size_in_gb<fftw_complex>(3*params.nmesh)
+      );
+
+      double comp_real = 0., comp_imag = 0.;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for reduction(+:comp_real, comp_imag) if(!task_parallel)
+#endif  // TRV_USE_OMP
+      for (long long gid = 0; gid < params.nmesh; gid++) {
+        std::complex<double> F_a_gridpt(F_a[gid][0], F_a[gid][1]);
+        std::complex<double> F_b_gridpt(F_b[gid][0], F_b[gid][1]);
+        std::complex<double> G_gridpt(G[gid][0], G[gid][1]);
+        std::complex<double> product_gridpt =
+          F_a_gridpt * F_b_gridpt * G_gridpt;
+
+        comp_real += product_gridpt.real();
+        comp_imag += product_gridpt.imag();
+      }
+
+      products[ipair].component = std::complex<double>(comp_real, comp_imag);
+    }
+  };
+
+  if (schedule == BinPairSchedule::loop) {
+    MeshField F_a(params, true, "`F_lm_a`");  // F_lm_a
+    MeshField F_b(params, true, "`F_lm_b`");  // F_lm_b
+    run_block(F_a, F_b, 0, npairs);
+    return products;
+  }
+
+#ifdef TRV_USE_OMP
+  int nthreads = omp_get_max_threads();
+
+  if (schedule == BinPairSchedule::pipeline) {
+    // Split threads between the filling and reducing stages, which
+    // run as nested thread groups.
+    int nthreads_fill = std::max(1, nthreads / 2);
+    int nthreads_reduce = std::max(1, nthreads - nthreads_fill);
+
+    int max_active_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(std::max(max_active_levels, 2));
+
+    // Plan the double-buffered fields for the filling thread group.
+    omp_set_num_threads(nthreads_fill);
+    MeshField F_a_0(params, true, "`F_lm_a`");  // F_lm_a (buffer 0)
+    MeshField F_b_0(params, true, "`F_lm_b`");  // F_lm_b (buffer 0)
+    MeshField F_a_1(params, true, "`F_lm_a`");  // F_lm_a (buffer 1)
+    MeshField F_b_1(params, true, "`F_lm_b`");  // F_lm_b (buffer 1)
+    omp_set_num_threads(nthreads);
+
+    MeshField* F_a_buf[2] = {&F_a_0, &F_a_1};
+    MeshField* F_b_buf[2] = {&F_b_0, &F_b_1};
+    int ibin_a_buf[2] = {-1, -1};
+    double eff_a_buf[2] = {0., 0.};
+    long long count_a_buf[2] = {0, 0};
+
+    // Sum the product in fixed chunks, in order.
+    long long nchunks =
+      (params.nmesh + NMESH_REDUCTION_CHUNK - 1) / NMESH_REDUCTION_CHUNK;
+    std::vector< std::complex<double> > chunk_sums(nchunks);
+
+    auto reduce_pair = [&](MeshField& F_a, MeshField& F_b, int ipair) {
+      trvs::ScopedTimer timer(
+        "reduction", trvs::size_in_gb<fftw_complex>(3*params.nmesh)
+      );
+
+#pragma omp parallel for schedule(static)
+      for (long long ichunk = 0; ichunk < nchunks; ichunk++) {
+        long long gid_begin = ichunk * NMESH_REDUCTION_CHUNK;
+        long long gid_end =
+          std::min(gid_begin + NMESH_REDUCTION_CHUNK, params.nmesh);
+
+        double comp_real = 0., comp_imag = 0.;
+        for (long long gid = gid_begin; gid < gid_end; gid++) {
+          std::complex<double> F_a_gridpt(F_a[gid][0], F_a[gid][1]);
+          std::complex<double> F_b_gridpt(F_b[gid][0], F_b[gid][1]);
+          std::complex<double> G_gridpt(G[gid][0], G[gid][1]);
+          std::complex<double> product_gridpt =
+            F_a_gridpt * F_b_gridpt * G_gridpt;
+
+          comp_real += product_gridpt.real();
+          comp_imag += product_gridpt.imag();
+        }
+        chunk_sums[ichunk] = std::complex<double>(comp_real, comp_imag);
+      }
+
+      std::complex<double> component = 0.;
+      for (long long ichunk = 0; ichunk < nchunks; ichunk++) {
+        component += chunk_sums[ichunk];
+      }
+      products[ipair].component = component;
+    };
+
+    // At each step, fill bin pair `step` into one buffer while reducing
+    // bin pair `step - 1` from the other.  The filling stage runs on the
+    // calling thread.
+    trvs::ThreadContext context;
+
+#pragma omp parallel num_threads(2)
+    {
+      trvs::WorkerScope worker(context);
+
+      int nstages = omp_get_num_threads();
+      int stage = omp_get_thread_num();  // 0: filling; 1: reducing
+      omp_set_num_threads((stage == 0) ? nthreads_fill : nthreads_reduce);
+
+      for (int step = 0; step <= npairs; step++) {
+        if ((stage == 0 || nstages == 1) && step < npairs) {
+          int ibuf = step % 2;
+          fill_pair(
+            *F_a_buf[ibuf], *F_b_buf[ibuf], ibin_a_buf[ibuf],
+            eff_a_buf[ibuf], count_a_buf[ibuf], step
+          );
+        }
+        if ((stage == 1 || nstages == 1) && step > 0) {
+          int ibuf = (step - 1) % 2;
+          reduce_pair(*F_a_buf[ibuf], *F_b_buf[ibuf], step - 1);
+        }
+#pragma omp barrier
+      }
+    }
+
+    omp_set_max_active_levels(max_active_levels);
+
+    return products;
+  }
+
+  // Split bin pairs into blocks sharing the first bin, no longer than
+  // an even share per thread.
+  std::vector< std::pair<int, int> > blocks;
+  int block_len_max = std::max(1, npairs / nthreads);
+  for (int ipair_begin = 0; ipair_begin < npairs; ) {
+    int ipair_end = ipair_begin + 1;
+    while (
+      ipair_end < npairs
+      && ipair_end - ipair_begin < block_len_max
+      && pairs[ipair_end].ibin_a == pairs[ipair_begin].ibin_a
+    ) {
+      ipair_end++;
+    }
+    blocks.push_back(std::make_pair(ipair_begin, ipair_end));
+    ipair_begin = ipair_end;
+  }
+  int nblocks = static_cast<int>(blocks.size());
+
+  // Each thread holds its own pair of fields.
+  {
+    trvs::ThreadContext context;
+
+#pragma omp parallel
+    {
+      trvs::WorkerScope worker(context);
+
+      MeshField F_a(params, true, "`F_lm_a`");  // F_lm_a
+      MeshField F_b(params, true, "`F_lm_b`");  // F_lm_b
+
+#pragma omp for schedule(dynamic, 1)
+      for (int iblock = 0; iblock < nblocks; iblock++) {
+        run_block(F_a, F_b, blocks[iblock].first, blocks[iblock].second);
+      }
+    }
+  }
+#endif  // TRV_USE_OMP
+
+  return products;
+}
+
+}  // namespace
+
+
+// ***********************************************************************
+// Memory usage
+// ***********************************************************************
+
+double estimate_3pt_mem_usage(trv::ParameterSet& params, long long ntotal) {
+  // Three more fields (quadratic and bin-pair fields) and four
+  // reduced-spherical-harmonic tables are held at once in addition
+  // to the two-point statistic usage.
+  return estimate_2pt_mem_usage(params, ntotal)
+    + 3 * MeshField::get_size_in_gb(params)
+    + trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
+}
+
+
 // ***********************************************************************
 // Full statistics
 // ***********************************************************************
@@ -216,9 +687,10 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
 
 trv::BispecMeasurements compute_bispec(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning& kbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache
 ) {
   trvs::logger.reset_level(params.verbose);
 
@@ -228,6 +700,13 @@ trv::BispecMeasurements compute_bispec(
     );
   }
 
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_3pt_mem_usage(
+      params, std::max(catalogue_data.ntotal, catalogue_rand.ntotal)
+    ),
+    params.memory_budget, "bispectrum measurement"
+  );
+
   // ---------------------------------------------------------------------
   // Set-up
   // ---------------------------------------------------------------------
@@ -262,8 +741,8 @@ trv::BispecMeasurements compute_bispec(
     }
   }
 
-  int* nmodes1_dv = new int[dv_dim];
-  int* nmodes2_dv = new int[dv_dim];
+  long long* nmodes1_dv = new long long[dv_dim];
+  long long* nmodes2_dv = new long long[dv_dim];
   double* k1bin_dv = new double[dv_dim];
   double* k2bin_dv = new double[dv_dim];
   double* k1eff_dv = new double[dv_dim];
@@ -281,330 +760,196 @@ trv::BispecMeasurements compute_bispec(
     sn_dv[idx_dv] = 0.;
   }  // likely redundant but safe
 
+  // Set up checkpointing of the accumulated data vectors (including
+  // bin metadata set with the first term).
+  TermCheckpoint checkpoint(params, {&catalogue_data, &catalogue_rand});
+  checkpoint.attach(nmodes1_dv, dv_dim * sizeof(long long));
+  checkpoint.attach(nmodes2_dv, dv_dim * sizeof(long long));
+  checkpoint.attach(k1bin_dv, dv_dim * sizeof(double));
+  checkpoint.attach(k2bin_dv, dv_dim * sizeof(double));
+  checkpoint.attach(k1eff_dv, dv_dim * sizeof(double));
+  checkpoint.attach(k2eff_dv, dv_dim * sizeof(double));
+  checkpoint.attach(bk_dv, dv_dim * sizeof(std::complex<double>));
+  checkpoint.attach(sn_dv, dv_dim * sizeof(std::complex<double>));
+
   // ---------------------------------------------------------------------
   // Measurement
   // ---------------------------------------------------------------------
 
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
   // Compute common field quantities.
-  MeshField dn_00(params, true, "`dn_00`");  // δn_00(k)
-  dn_00.compute_ylm_wgtd_field(
-    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
-  );
-  dn_00.fourier_transform();
-
-  MeshField& dn_00_for_sn = dn_00;  // δn_00(k) (for shot noise)
-
-  double vol_cell = dn_00.vol_cell;
-
-  MeshField N_00(params, true, "`N_00`");  // N_00(k)
-  N_00.compute_ylm_wgtd_quad_field(
-    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
-  );
-  N_00.fourier_transform();
-
-  trvm::SphericalBesselCalculator sj_a(params.ell1);  // j_l_a
-  trvm::SphericalBesselCalculator sj_b(params.ell2);  // j_l_b
-
-  FieldStats stats_sn(params);
-
-  // Compute bispectrum terms including shot noise.
-  int count_terms = 0;
-  for (int m1_ = - params.ell1; m1_ <= params.ell1; m1_++) {
-    for (int m2_ = - params.ell2; m2_ <= params.ell2; m2_++) {
-      // Check for if all Wigner-3j symbols are zero.
-      std::string flag_vanishing = "true";
-      for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
-        double coupling = trv::calc_coupling_coeff_3pt(
-          params.ell1, params.ell2, params.ELL, m1_, m2_, M_
-        );
-        if (std::fabs(coupling) > trvm::eps_coupling) {
-          flag_vanishing = "false";
-          break;
-        }
-      }
-      if (flag_vanishing == "true") {continue;}
-
-      // Initialise reduced-spherical-harmonic weights on mesh grids.
-      std::vector< std::complex<double> > ylm_k_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_b(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
-      trvs::update_maxmem();
-
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_k_a
-        );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_k_b
-        );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_r_a
-        );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_r_b
-        );
-
-      for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
-        // Calculate the coupling coefficient.
-        double coupling = trv::calc_coupling_coeff_3pt(
-          params.ell1, params.ell2, params.ELL, m1_, m2_, M_
-        );  // Wigner 3-j's
-        if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
-
-        // ·······························································
-        // Raw bispectrum
-        // ·······························································
-
-        // Compute bispectrum components in eqs. (41) & (42) in the Paper.
-        MeshField G_LM(params, true, "`G_LM`");  // G_LM
-        G_LM.compute_ylm_wgtd_field(
-          catalogue_data, catalogue_rand, los_data, los_rand, alpha,
-          params.ELL, M_
-        );
-        G_LM.fourier_transform();
-        G_LM.apply_assignment_compensation();
-        G_LM.inv_fourier_transform();
-
-        MeshField F_lm_a(params, true, "`F_lm_a`");  // F_lm_a
-        MeshField F_lm_b(params, true, "`F_lm_b`");  // F_lm_b
-
-        if (params.form == "diag") {
-          for (int idx_dv = 0; idx_dv < dv_dim; idx_dv++) {
-            int ibin = idx_dv;
-
-            double k_lower = kbinning.bin_edges[ibin];
-            double k_upper = kbinning.bin_edges[ibin + 1];
-
-            double k_eff_a_, k_eff_b_;
-            int nmodes_a_, nmodes_b_;
-
-            F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_00, ylm_k_a, k_lower, k_upper, k_eff_a_, nmodes_a_
-            );
-            F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_00, ylm_k_b, k_lower, k_upper, k_eff_b_, nmodes_b_
-            );
-
-            if (count_terms == 0) {
-              k1bin_dv[idx_dv] = kbinning.bin_centres[ibin];
-              k2bin_dv[idx_dv] = kbinning.bin_centres[ibin];
-              k1eff_dv[idx_dv] = k_eff_a_;
-              k2eff_dv[idx_dv] = k_eff_b_;
-              nmodes1_dv[idx_dv] = nmodes_a_;
-              nmodes2_dv[idx_dv] = nmodes_b_;
-            }
-
-            // B_{l₁ l₂ L}^{m₁ m₂ M}
-            double bk_comp_real = 0., bk_comp_imag = 0.;
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
-#endif  // TRV_USE_OMP
-            for (int gid = 0; gid < params.nmesh; gid++) {
-              std::complex<double> F_lm_a_gridpt(
-                F_lm_a[gid][0], F_lm_a[gid][1]
-              );
-              std::complex<double> F_lm_b_gridpt(
-                F_lm_b[gid][0], F_lm_b[gid][1]
-              );
-              std::complex<double> G_LM_gridpt(G_LM[gid][0], G_LM[gid][1]);
-              std::complex<double> bk_gridpt =
-                F_lm_a_gridpt * F_lm_b_gridpt * G_LM_gridpt;
-
-              bk_comp_real += bk_gridpt.real();
-              bk_comp_imag += bk_gridpt.imag();
-            }
-
-            std::complex<double> bk_component(bk_comp_real, bk_comp_imag);
-
-            bk_dv[idx_dv] += coupling * vol_cell * bk_component;
-          }
-        }
-
-        if (params.form == "off-diag") {
-          for (int idx_dv = 0; idx_dv < dv_dim; idx_dv++) {
-            int ibin_row = idx_dv;
-            int ibin_col = idx_dv + params.idx_bin;
-
-            double k_lower_a = kbinning.bin_edges[ibin_row];
-            double k_upper_a = kbinning.bin_edges[ibin_row + 1];
-            double k_lower_b = kbinning.bin_edges[ibin_col];
-            double k_upper_b = kbinning.bin_edges[ibin_col + 1];
-
-            double k_eff_a_, k_eff_b_;
-            int nmodes_a_, nmodes_b_;
-
-            F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_00, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
-            );
-            F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_00, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
-            );
-
-            if (count_terms == 0) {
-              k1bin_dv[idx_dv] = kbinning.bin_centres[ibin_row];
-              k2bin_dv[idx_dv] = kbinning.bin_centres[ibin_col];
-              k1eff_dv[idx_dv] = k_eff_a_;
-              k2eff_dv[idx_dv] = k_eff_b_;
-              nmodes1_dv[idx_dv] = nmodes_a_;
-              nmodes2_dv[idx_dv] = nmodes_b_;
-            }
-
-            // B_{l₁ l₂ L}^{m₁ m₂ M}
-            double bk_comp_real = 0., bk_comp_imag = 0.;
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
-#endif  // TRV_USE_OMP
-            for (int gid = 0; gid < params.nmesh; gid++) {
-              std::complex<double> F_lm_a_gridpt(
-                F_lm_a[gid][0], F_lm_a[gid][1]
-              );
-              std::complex<double> F_lm_b_gridpt(
-                F_lm_b[gid][0], F_lm_b[gid][1]
-              );
-              std::complex<double> G_LM_gridpt(G_LM[gid][0], G_LM[gid][1]);
-              std::complex<double> bk_gridpt =
-                F_lm_a_gridpt * F_lm_b_gridpt * G_LM_gridpt;
-
-              bk_comp_real += bk_gridpt.real();
-              bk_comp_imag += bk_gridpt.imag();
-            }
-
-            std::complex<double> bk_component(bk_comp_real, bk_comp_imag);
-
-            bk_dv[idx_dv] += coupling * vol_cell * bk_component;
-          }
-        }
-
-        if (params.form == "row") {
-          int ibin_row = params.idx_bin;
-
-          double k_lower_a = kbinning.bin_edges[ibin_row];
-          double k_upper_a = kbinning.bin_edges[ibin_row + 1];
-
-          double k_eff_a_;
-          int nmodes_a_;
-
-          F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-            dn_00, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
-          );
-
-          for (int idx_dv = 0; idx_dv < dv_dim; idx_dv++) {
-            int ibin_col = idx_dv;
-
-            double k_lower_b = kbinning.bin_edges[ibin_col];
-            double k_upper_b = kbinning.bin_edges[ibin_col + 1];
-
-            double k_eff_b_;
-            int nmodes_b_;
-
-            F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_00, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
-            );
+  MeshFieldCache field_cache_local;  // unshared unless a cache is given
+  MeshFieldCache& fields =
+    (field_cache != nullptr) ? *field_cache : field_cache_local;
+
+  std::shared_ptr<MeshField> dn_00_ptr =
+    checkpoint.restore_field(params, "dn_00", "`dn_00`");
+  if (dn_00_ptr == nullptr) {
+    dn_00_ptr = fields.get_ylm_wgtd_field(
+      params, catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0,
+      "`dn_00`"
+    );
+    checkpoint.save_field(*dn_00_ptr, "dn_00");
+  }
+  MeshField& dn_00 = *dn_00_ptr;  // δn_00(k)
 
-            if (count_terms == 0) {
-              k1bin_dv[idx_dv] = kbinning.bin_centres[ibin_row];
-              k2bin_dv[idx_dv] = kbinning.bin_centres[ibin_col];
-              k1eff_dv[idx_dv] = k_eff_a_;
-              k2eff_dv[idx_dv] = k_eff_b_;
-              nmodes1_dv[idx_dv] = nmodes_a_;
-              nmodes2_dv[idx_dv] = nmodes_b_;
-            }
+  MeshField& dn_00_for_sn = dn_00;  // δn_00(k) (for shot noise)
 
-            // B_{l₁ l₂ L}^{m₁ m₂ M}
-            double bk_comp_real = 0., bk_comp_imag = 0.;
+  // Set up the (possibly cropped) mesh grid for the raw bispectrum.
+  trv::ParameterSet params_raw = set_up_bispec_mesh(params, kbinning);
+  bool cropped = (params_raw.nmesh < params.nmesh);
 
-#ifdef TRV_USE_OMP
-#pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
-#endif  // TRV_USE_OMP
-            for (int gid = 0; gid < params.nmesh; gid++) {
-              std::complex<double> F_lm_a_gridpt(
-                F_lm_a[gid][0], F_lm_a[gid][1]
-              );
-              std::complex<double> F_lm_b_gridpt(
-                F_lm_b[gid][0], F_lm_b[gid][1]
-              );
-              std::complex<double> G_LM_gridpt(G_LM[gid][0], G_LM[gid][1]);
-              std::complex<double> bk_gridpt =
-                F_lm_a_gridpt * F_lm_b_gridpt * G_LM_gridpt;
+  std::shared_ptr<MeshField> dn_00_raw_ptr = dn_00_ptr;
+  if (cropped) {
+    dn_00_raw_ptr =
+      std::make_shared<MeshField>(params_raw, false, "`dn_00_raw`");
+    dn_00_raw_ptr->crop_field_in_fourier(dn_00);
+  }
+  MeshField& dn_00_raw = *dn_00_raw_ptr;  // δn_00(k) (for raw bispectrum)
 
-              bk_comp_real += bk_gridpt.real();
-              bk_comp_imag += bk_gridpt.imag();
-            }
+  double vol_cell = dn_00_raw.vol_cell;
 
-            std::complex<double> bk_component(bk_comp_real, bk_comp_imag);
+  std::shared_ptr<MeshField> N_00_ptr =
+    checkpoint.restore_field(params, "N_00", "`N_00`");
+  if (N_00_ptr == nullptr) {
+    N_00_ptr = fields.get_ylm_wgtd_quad_field(
+      params, catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0,
+      "`N_00`"
+    );
+    checkpoint.save_field(*N_00_ptr, "N_00");
+  }
+  MeshField& N_00 = *N_00_ptr;  // N_00(k)
 
-            bk_dv[idx_dv] += coupling * vol_cell * bk_component;
-          }
-        }
+  trvm::SphericalBesselCalculator sj_a(params.ell1);  // j_l_a
+  trvm::SphericalBesselCalculator sj_b(params.ell2);  // j_l_b
 
-        if (params.form == "full") {
-          for (int idx_row = 0; idx_row < params.num_bins; idx_row++) {
-            for (int idx_col = idx_row; idx_col < params.num_bins; idx_col++) {
-              int idx_dv = (2*params.num_bins - idx_row + 1) * idx_row / 2
-                + (idx_col - idx_row);
+  FieldStats stats_sn(params);
 
-              double k_lower_a = kbinning.bin_edges[idx_row];
-              double k_upper_a = kbinning.bin_edges[idx_row + 1];
-              double k_lower_b = kbinning.bin_edges[idx_col];
-              double k_upper_b = kbinning.bin_edges[idx_col + 1];
+  // Schedule bin pairs of the raw bispectrum.
+  std::vector<BinPair> bin_pairs = list_bin_pairs(params, dv_dim);
+  BinPairSchedule schedule = choose_bin_pair_schedule(
+    params_raw, static_cast<int>(bin_pairs.size())
+  );
+  if (trvs::currTask == 0) {
+    trvs::logger.info(
+      "Bin pairs are scheduled with %s parallelism.",
+      get_bin_pair_schedule_name(schedule)
+    );
+  }
 
-              double k_eff_a_, k_eff_b_;
-              int nmodes_a_, nmodes_b_;
+  // Compute bispectrum terms including shot noise.
+  int count_terms = checkpoint.resume();  // resumed completed terms
+  for (int m1_ = - params.ell1; m1_ <= params.ell1; m1_++) {
+    for (int m2_ = - params.ell2; m2_ <= params.ell2; m2_++) {
+      // Check for if all Wigner-3j symbols are zero (or all
+      // non-vanishing terms have been completed).
+      std::string flag_vanishing = "true";
+      for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
+        double coupling = trv::calc_coupling_coeff_3pt(
+          params.ell1, params.ell2, params.ELL, m1_, m2_, M_
+        );
+        if (
+          std::fabs(coupling) > trvm::eps_coupling
+          && !checkpoint.is_completed(m1_, m2_, M_)
+        ) {
+          flag_vanishing = "false";
+          break;
+        }
+      }
+      if (flag_vanishing == "true") {continue;}
 
-              F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-                dn_00, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
-              );
-              F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-                dn_00, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
-              );
+      // Initialise reduced-spherical-harmonic weights on mesh grids.
+      trvs::TrackedVector< std::complex<double> > ylm_k_a(params_raw.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_k_b(params_raw.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_r_a(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_r_b(params.nmesh);
 
-              if (count_terms == 0) {
-                k1bin_dv[idx_dv] = kbinning.bin_centres[idx_row];
-                k2bin_dv[idx_dv] = kbinning.bin_centres[idx_col];
-                k1eff_dv[idx_dv] = k_eff_a_;
-                k2eff_dv[idx_dv] = k_eff_b_;
-                nmodes1_dv[idx_dv] = nmodes_a_;
-                nmodes2_dv[idx_dv] = nmodes_b_;
-              }
+      trvm::SphericalHarmonicCalculator::
+        store_reduced_spherical_harmonic_in_fourier_space(
+          params.ell1, m1_, params_raw.boxsize, params_raw.ngrid, ylm_k_a
+        );
+      trvm::SphericalHarmonicCalculator::
+        store_reduced_spherical_harmonic_in_fourier_space(
+          params.ell2, m2_, params_raw.boxsize, params_raw.ngrid, ylm_k_b
+        );
+      trvm::SphericalHarmonicCalculator::
+        store_reduced_spherical_harmonic_in_config_space(
+          params.ell1, m1_, params.boxsize, params.ngrid, ylm_r_a
+        );
+      trvm::SphericalHarmonicCalculator::
+        store_reduced_spherical_harmonic_in_config_space(
+          params.ell2, m2_, params.boxsize, params.ngrid, ylm_r_b
+        );
 
-              // B_{l₁ l₂ L}^{m₁ m₂ M}
-              double bk_comp_real = 0., bk_comp_imag = 0.;
+      for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
+        // Calculate the coupling coefficient.
+        double coupling = trv::calc_coupling_coeff_3pt(
+          params.ell1, params.ell2, params.ELL, m1_, m2_, M_
+        );  // Wigner 3-j's
+        if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
+        if (checkpoint.is_completed(m1_, m2_, M_)) {continue;}
 
-#ifdef TRV_USE_OMP
-#pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
-#endif  // TRV_USE_OMP
-              for (int gid = 0; gid < params.nmesh; gid++) {
-                std::complex<double> F_lm_a_gridpt(
-                  F_lm_a[gid][0], F_lm_a[gid][1]
-                );
-                std::complex<double> F_lm_b_gridpt(
-                  F_lm_b[gid][0], F_lm_b[gid][1]
-                );
-                std::complex<double> G_LM_gridpt(G_LM[gid][0], G_LM[gid][1]);
-                std::complex<double> bk_gridpt =
-                  F_lm_a_gridpt * F_lm_b_gridpt * G_LM_gridpt;
+        // ·······························································
+        // Raw bispectrum
+        // ·······························································
 
-                bk_comp_real += bk_gridpt.real();
-                bk_comp_imag += bk_gridpt.imag();
-              }
+        // Compute bispectrum components in eqs. (41) & (42) in the Paper.
+        std::shared_ptr<MeshField> G_LM_ptr = nullptr;
+        if (cropped) {
+          // Only wavevector modes up to twice the maximum wavenumber
+          // enter the triple products.
+          std::shared_ptr<MeshField> dn_LM_ptr = fields.get_ylm_wgtd_field(
+            params, catalogue_data, catalogue_rand, los_data, los_rand,
+            alpha, params.ELL, M_, "`dn_LM`", 2*kbinning.bin_max
+          );
+          G_LM_ptr = std::make_shared<MeshField>(params_raw, true, "`G_LM`");
+          G_LM_ptr->crop_field_in_fourier(*dn_LM_ptr);
+          G_LM_ptr->inv_fourier_transform();
+        } else {
+          G_LM_ptr = fields.get_ylm_wgtd_field_in_config(
+            params, catalogue_data, catalogue_rand, los_data, los_rand,
+            alpha, params.ELL, M_, "`G_LM`"
+          );
+        }
+        MeshField& G_LM = *G_LM_ptr;  // G_LM
+
+        std::vector<BinPairProduct> bk_products = reduce_bin_pair_products(
+          params_raw, bin_pairs, G_LM,
+          [&](
+            MeshField& F_lm, int side, const BinPair& pair,
+            double& k_eff_, long long& nmodes_
+          ) {
+            int ibin = (side == 0) ? pair.ibin_a : pair.ibin_b;
+            F_lm.inv_fourier_transform_ylm_wgtd_field_band_limited(
+              dn_00_raw, (side == 0) ? ylm_k_a : ylm_k_b,
+              kbinning.bin_edges[ibin], kbinning.bin_edges[ibin + 1],
+              k_eff_, nmodes_
+            );
+          },
+          schedule
+        );
 
-              std::complex<double> bk_component(bk_comp_real, bk_comp_imag);
+        for (std::size_t ipair = 0; ipair < bin_pairs.size(); ipair++) {
+          const BinPair& pair = bin_pairs[ipair];
+          const BinPairProduct& product = bk_products[ipair];
 
-              bk_dv[idx_dv] += coupling * vol_cell * bk_component;
-            }
+          if (count_terms == 0) {
+            k1bin_dv[pair.idx_dv] = kbinning.bin_centres[pair.ibin_a];
+            k2bin_dv[pair.idx_dv] = kbinning.bin_centres[pair.ibin_b];
+            k1eff_dv[pair.idx_dv] = product.eff_a;
+            k2eff_dv[pair.idx_dv] = product.eff_b;
+            nmodes1_dv[pair.idx_dv] = product.count_a;
+            nmodes2_dv[pair.idx_dv] = product.count_b;
           }
+
+          // B_{l₁ l₂ L}^{m₁ m₂ M}
+          bk_dv[pair.idx_dv] += coupling * vol_cell * product.component;
         }
 
         // ·······························································
@@ -612,21 +957,19 @@ trv::BispecMeasurements compute_bispec(
         // ·······························································
 
         // Compute shot noise components in eqs. (45) & (46) in the Paper.
-        MeshField dn_LM_for_sn(params, true, "`dn_LM_for_sn`");  // δn_LM(k)
-                                                                 // (for
-                                                                 // shot noise)
-        dn_LM_for_sn.compute_ylm_wgtd_field(
-          catalogue_data, catalogue_rand, los_data, los_rand, alpha,
-          params.ELL, M_
-        );
-        dn_LM_for_sn.fourier_transform();
+        std::shared_ptr<MeshField> dn_LM_for_sn_ptr =
+          fields.get_ylm_wgtd_field(
+            params, catalogue_data, catalogue_rand, los_data, los_rand,
+            alpha, params.ELL, M_, "`dn_LM_for_sn`"
+          );
+        MeshField& dn_LM_for_sn = *dn_LM_for_sn_ptr;  // δn_LM(k)
+                                                      // (for shot noise)
 
-        MeshField N_LM(params, true, "`N_LM`");  // N_LM(k)
-        N_LM.compute_ylm_wgtd_quad_field(
-          catalogue_data, catalogue_rand, los_data, los_rand, alpha,
-          params.ELL, M_
+        std::shared_ptr<MeshField> N_LM_ptr = fields.get_ylm_wgtd_quad_field(
+          params, catalogue_data, catalogue_rand, los_data, los_rand, alpha,
+          params.ELL, M_, "`N_LM`"
         );
-        N_LM.fourier_transform();
+        MeshField& N_LM = *N_LM_ptr;  // N_LM(k)
 
         std::complex<double> Sbar_LM = calc_ylm_wgtd_shotnoise_amp_for_bispec(
           catalogue_data, catalogue_rand, los_data, los_rand, alpha,
@@ -750,6 +1093,7 @@ trv::BispecMeasurements compute_bispec(
         }
 
         count_terms++;
+        checkpoint.complete(m1_, m2_, M_);
         if (trvs::currTask == 0) {
           trvs::logger.stat(
             "Bispectrum term at orders (m1, m2, M) = (%d, %d, %d) computed.",
@@ -757,9 +1101,6 @@ trv::BispecMeasurements compute_bispec(
           );
         }
       }
-
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
     }
   }
 
@@ -785,6 +1126,8 @@ trv::BispecMeasurements compute_bispec(
   delete[] k1eff_dv; delete[] k2eff_dv;
   delete[] bk_dv; delete[] sn_dv;
 
+  checkpoint.finalise();
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "... computed bispectrum from paired survey-type catalogues."
@@ -796,9 +1139,10 @@ trv::BispecMeasurements compute_bispec(
 
 trv::ThreePCFMeasurements compute_3pcf(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache
 ) {
   trvs::logger.reset_level(params.verbose);
 
@@ -809,6 +1153,13 @@ trv::ThreePCFMeasurements compute_3pcf(
     );
   }
 
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_3pt_mem_usage(
+      params, std::max(catalogue_data.ntotal, catalogue_rand.ntotal)
+    ),
+    params.memory_budget, "three-point correlation function measurement"
+  );
+
   // ---------------------------------------------------------------------
   // Set-up
   // ---------------------------------------------------------------------
@@ -843,8 +1194,8 @@ trv::ThreePCFMeasurements compute_3pcf(
     }
   }
 
-  int* npairs1_dv = new int[dv_dim];
-  int* npairs2_dv = new int[dv_dim];
+  long long* npairs1_dv = new long long[dv_dim];
+  long long* npairs2_dv = new long long[dv_dim];
   double* r1bin_dv = new double[dv_dim];
   double* r2bin_dv = new double[dv_dim];
   double* r1eff_dv = new double[dv_dim];
@@ -862,46 +1213,91 @@ trv::ThreePCFMeasurements compute_3pcf(
     sn_dv[idx_dv] = 0.;
   }  // likely redundant but safe
 
+  // Set up checkpointing of the accumulated data vectors (including
+  // bin metadata set with the first term).
+  TermCheckpoint checkpoint(params, {&catalogue_data, &catalogue_rand});
+  checkpoint.attach(npairs1_dv, dv_dim * sizeof(long long));
+  checkpoint.attach(npairs2_dv, dv_dim * sizeof(long long));
+  checkpoint.attach(r1bin_dv, dv_dim * sizeof(double));
+  checkpoint.attach(r2bin_dv, dv_dim * sizeof(double));
+  checkpoint.attach(r1eff_dv, dv_dim * sizeof(double));
+  checkpoint.attach(r2eff_dv, dv_dim * sizeof(double));
+  checkpoint.attach(zeta_dv, dv_dim * sizeof(std::complex<double>));
+  checkpoint.attach(sn_dv, dv_dim * sizeof(std::complex<double>));
+
   // ---------------------------------------------------------------------
   // Measurement
   // ---------------------------------------------------------------------
 
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
   // Compute common field quantities.
-  MeshField dn_00(params, true, "`dn_00`");  // δn_00(k)
-  dn_00.compute_ylm_wgtd_field(
-    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
-  );
-  dn_00.fourier_transform();
+  MeshFieldCache field_cache_local;  // unshared unless a cache is given
+  MeshFieldCache& fields =
+    (field_cache != nullptr) ? *field_cache : field_cache_local;
+
+  std::shared_ptr<MeshField> dn_00_ptr =
+    checkpoint.restore_field(params, "dn_00", "`dn_00`");
+  if (dn_00_ptr == nullptr) {
+    dn_00_ptr = fields.get_ylm_wgtd_field(
+      params, catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0,
+      "`dn_00`"
+    );
+    checkpoint.save_field(*dn_00_ptr, "dn_00");
+  }
+  MeshField& dn_00 = *dn_00_ptr;  // δn_00(k)
 
   double vol_cell = dn_00.vol_cell;
 
-  MeshField N_00(params, true, "`N_00`");  // N_00(k)
-  N_00.compute_ylm_wgtd_quad_field(
-    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
-  );
-  N_00.fourier_transform();
+  std::shared_ptr<MeshField> N_00_ptr =
+    checkpoint.restore_field(params, "N_00", "`N_00`");
+  if (N_00_ptr == nullptr) {
+    N_00_ptr = fields.get_ylm_wgtd_quad_field(
+      params, catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0,
+      "`N_00`"
+    );
+    checkpoint.save_field(*N_00_ptr, "N_00");
+  }
+  MeshField& N_00 = *N_00_ptr;  // N_00(k)
 
   trvm::SphericalBesselCalculator sj_a(params.ell1);  // j_l_a
   trvm::SphericalBesselCalculator sj_b(params.ell2);  // j_l_b
 
   FieldStats stats_sn(params);
 
+  // Schedule bin pairs of the raw 3PCF.
+  std::vector<BinPair> bin_pairs = list_bin_pairs(params, dv_dim);
+  BinPairSchedule schedule = choose_bin_pair_schedule(
+    params, static_cast<int>(bin_pairs.size())
+  );
+  if (trvs::currTask == 0) {
+    trvs::logger.info(
+      "Bin pairs are scheduled with %s parallelism.",
+      get_bin_pair_schedule_name(schedule)
+    );
+  }
+
   // Compute 3PCF terms including shot noise.
-  int count_terms = 0;
+  int count_terms = checkpoint.resume();  // resumed completed terms
   for (int m1_ = - params.ell1; m1_ <= params.ell1; m1_++) {
     for (int m2_ = - params.ell2; m2_ <= params.ell2; m2_++) {
       // Check for vanishing cases where all Wigner-3j symbols are zero.
-      // Check for if all Wigner-3j symbols are zero.
+      // Check for if all Wigner-3j symbols are zero (or all
+      // non-vanishing terms have been completed).
       std::string flag_vanishing = "true";
       for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
         double coupling = trv::calc_coupling_coeff_3pt(
           params.ell1, params.ell2, params.ELL, m1_, m2_, M_
         );
-        if (std::fabs(coupling) > trvm::eps_coupling) {
+        if (
+          std::fabs(coupling) > trvm::eps_coupling
+          && !checkpoint.is_completed(m1_, m2_, M_)
+        ) {
           flag_vanishing = "false";
           break;
         }
@@ -909,13 +1305,10 @@ trv::ThreePCFMeasurements compute_3pcf(
       if (flag_vanishing == "true") {continue;}
 
       // Initialise reduced-spherical-harmonic weights on mesh grids.
-      std::vector< std::complex<double> > ylm_r_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
-      trvs::update_maxmem();
+      trvs::TrackedVector< std::complex<double> > ylm_r_a(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_r_b(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_k_a(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_k_b(params.nmesh);
 
       trvm::SphericalHarmonicCalculator::
         store_reduced_spherical_harmonic_in_config_space(
@@ -940,20 +1333,20 @@ trv::ThreePCFMeasurements compute_3pcf(
           params.ell1, params.ell2, params.ELL, m1_, m2_, M_
         );  // Wigner 3-j's
         if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
+        if (checkpoint.is_completed(m1_, m2_, M_)) {continue;}
 
         // ·······························································
         // Shot noise
         // ·······························································
 
         // Compute shot noise components in eq. (51) in the Paper.
-        MeshField dn_LM_for_sn(params, true, "`dn_LM_for_sn`");  // δn_LM(k)
-                                                                 // (for
-                                                                 // shot noise)
-        dn_LM_for_sn.compute_ylm_wgtd_field(
-          catalogue_data, catalogue_rand, los_data, los_rand, alpha,
-          params.ELL, M_
-        );
-        dn_LM_for_sn.fourier_transform();
+        std::shared_ptr<MeshField> dn_LM_for_sn_ptr =
+          fields.get_ylm_wgtd_field(
+            params, catalogue_data, catalogue_rand, los_data, los_rand,
+            alpha, params.ELL, M_, "`dn_LM_for_sn`"
+          );
+        MeshField& dn_LM_for_sn = *dn_LM_for_sn_ptr;  // δn_LM(k)
+                                                      // (for shot noise)
 
         std::complex<double> Sbar_LM = calc_ylm_wgtd_shotnoise_amp_for_bispec(
           catalogue_data, catalogue_rand, los_data, los_rand, alpha,
@@ -1058,52 +1451,44 @@ trv::ThreePCFMeasurements compute_3pcf(
         // ·······························································
 
         // Compute 3PCF components in eqs. (42), (48) & (49) in the Paper.
-        MeshField G_LM(params, true, "`G_LM`");  // G_LM
-        G_LM.compute_ylm_wgtd_field(
-          catalogue_data, catalogue_rand, los_data, los_rand, alpha,
-          params.ELL, M_
-        );
-        G_LM.fourier_transform();
-        G_LM.apply_assignment_compensation();
-        G_LM.inv_fourier_transform();
-
-        MeshField F_lm_a(params, true, "`F_lm_a`");  // F_lm_a
-        MeshField F_lm_b(params, true, "`F_lm_b`");  // F_lm_b
-
-        for (int idx_dv = 0; idx_dv < dv_dim; idx_dv++) {
-          double r_a = r1eff_dv[idx_dv];
-          F_lm_a.inv_fourier_transform_sjl_ylm_wgtd_field(
-            dn_00, ylm_k_a, sj_a, r_a
-          );
-
-          double r_b = r2eff_dv[idx_dv];
-          F_lm_b.inv_fourier_transform_sjl_ylm_wgtd_field(
-            dn_00, ylm_k_b, sj_b, r_b
+        std::shared_ptr<MeshField> G_LM_ptr =
+          fields.get_ylm_wgtd_field_in_config(
+            params, catalogue_data, catalogue_rand, los_data, los_rand,
+            alpha, params.ELL, M_, "`G_LM`"
           );
+        MeshField& G_LM = *G_LM_ptr;  // G_LM
+
+        std::vector<BinPairProduct> zeta_products = reduce_bin_pair_products(
+          params, bin_pairs, G_LM,
+          [&](
+            MeshField& F_lm, int side, const BinPair& pair,
+            double& r_eff_, long long& npairs_
+          ) {
+            if (side == 0) {
+              r_eff_ = r1eff_dv[pair.idx_dv];
+              npairs_ = npairs1_dv[pair.idx_dv];
+              F_lm.inv_fourier_transform_sjl_ylm_wgtd_field(
+                dn_00, ylm_k_a, sj_a, r_eff_
+              );
+            } else {
+              r_eff_ = r2eff_dv[pair.idx_dv];
+              npairs_ = npairs2_dv[pair.idx_dv];
+              F_lm.inv_fourier_transform_sjl_ylm_wgtd_field(
+                dn_00, ylm_k_b, sj_b, r_eff_
+              );
+            }
+          },
+          schedule
+        );
 
+        for (std::size_t ipair = 0; ipair < bin_pairs.size(); ipair++) {
           // ζ_{l₁ l₂ L}^{m₁ m₂ M}
-          double zeta_comp_real = 0., zeta_comp_imag = 0.;
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for reduction(+:zeta_comp_real, zeta_comp_imag)
-#endif  // TRV_USE_OMP
-          for (int gid = 0; gid < params.nmesh; gid++) {
-            std::complex<double> F_lm_a_gridpt(F_lm_a[gid][0], F_lm_a[gid][1]);
-            std::complex<double> F_lm_b_gridpt(F_lm_b[gid][0], F_lm_b[gid][1]);
-            std::complex<double> G_LM_gridpt(G_LM[gid][0], G_LM[gid][1]);
-            std::complex<double> zeta_gridpt =
-              F_lm_a_gridpt * F_lm_b_gridpt * G_LM_gridpt;
-
-            zeta_comp_real += zeta_gridpt.real();
-            zeta_comp_imag += zeta_gridpt.imag();
-          }
-
-          std::complex<double> zeta_component(zeta_comp_real, zeta_comp_imag);
-
-          zeta_dv[idx_dv] += parity * coupling * vol_cell * zeta_component;
+          zeta_dv[bin_pairs[ipair].idx_dv] +=
+            parity * coupling * vol_cell * zeta_products[ipair].component;
         }
 
         count_terms++;
+        checkpoint.complete(m1_, m2_, M_);
         if (trvs::currTask == 0) {
           trvs::logger.stat(
             "Three-point correlation function term at orders "
@@ -1112,9 +1497,6 @@ trv::ThreePCFMeasurements compute_3pcf(
           );
         }
       }
-
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
     }
   }
 
@@ -1140,6 +1522,8 @@ trv::ThreePCFMeasurements compute_3pcf(
   delete[] r1eff_dv; delete[] r2eff_dv;
   delete[] zeta_dv; delete[] sn_dv;
 
+  checkpoint.finalise();
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "... computed three-point correlation function "
@@ -1153,7 +1537,8 @@ trv::ThreePCFMeasurements compute_3pcf(
 trv::BispecMeasurements compute_bispec_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning kbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache
 ) {
   trvs::logger.reset_level(params.verbose);
 
@@ -1164,6 +1549,11 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
     );
   }
 
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_3pt_mem_usage(params, catalogue_data.ntotal),
+    params.memory_budget, "bispectrum measurement"
+  );
+
   // ---------------------------------------------------------------------
   // Set-up
   // ---------------------------------------------------------------------
@@ -1196,8 +1586,8 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
     }
   }
 
-  int* nmodes1_dv = new int[dv_dim];
-  int* nmodes2_dv = new int[dv_dim];
+  long long* nmodes1_dv = new long long[dv_dim];
+  long long* nmodes2_dv = new long long[dv_dim];
   double* k1bin_dv = new double[dv_dim];
   double* k2bin_dv = new double[dv_dim];
   double* k1eff_dv = new double[dv_dim];
@@ -1220,24 +1610,43 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
   // ---------------------------------------------------------------------
 
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
   // Compute common field quantities.
-  MeshField dn_00(params, true, "`dn_00`");  // δn_00(k)
-  dn_00.compute_unweighted_field_fluctuations_insitu(catalogue_data);
-  dn_00.fourier_transform();
+  MeshFieldCache field_cache_local;  // unshared unless a cache is given
+  MeshFieldCache& fields =
+    (field_cache != nullptr) ? *field_cache : field_cache_local;
+
+  std::shared_ptr<MeshField> dn_00_ptr =
+    fields.get_unweighted_field_fluctuations(params, catalogue_data, "`dn_00`");
+  MeshField& dn_00 = *dn_00_ptr;  // δn_00(k)
 
   MeshField& dn_00_for_sn = dn_00;  // δn_00(k) (for shot noise)
   MeshField& dn_L0_for_sn = dn_00;  // δn_L0(k) (for shot noise)
 
-  double vol_cell = dn_00.vol_cell;
+  // Set up the (possibly cropped) mesh grid for the raw bispectrum.
+  trv::ParameterSet params_raw = set_up_bispec_mesh(params, kbinning);
+  bool cropped = (params_raw.nmesh < params.nmesh);
+
+  std::shared_ptr<MeshField> dn_00_raw_ptr = dn_00_ptr;
+  if (cropped) {
+    dn_00_raw_ptr =
+      std::make_shared<MeshField>(params_raw, false, "`dn_00_raw`");
+    dn_00_raw_ptr->crop_field_in_fourier(dn_00);
+  }
+  MeshField& dn_00_raw = *dn_00_raw_ptr;  // δn_00(k) (for raw bispectrum)
+
+  double vol_cell = dn_00_raw.vol_cell;
 
   // Under the global plane-parallel approximation, y_{LM} = δᴰ_{M0}
   // (L-invariant) for the line-of-sight spherical harmonic.
-  MeshField N_L0(params, true, "`N_L0`");  // N_L0(k)
-  N_L0.compute_unweighted_field(catalogue_data);
-  N_L0.fourier_transform();
+  std::shared_ptr<MeshField> N_L0_ptr =
+    fields.get_unweighted_field(params, catalogue_data, "`N_L0`");
+  MeshField& N_L0 = *N_L0_ptr;  // N_L0(k)
 
   MeshField& N_00 = N_L0;  // N_00(k)
 
@@ -1261,21 +1670,18 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
       if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
 
       // Initialise/reset spherical harmonic mesh grids.
-      std::vector< std::complex<double> > ylm_k_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_b(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
-      trvs::update_maxmem();
+      trvs::TrackedVector< std::complex<double> > ylm_k_a(params_raw.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_k_b(params_raw.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_r_a(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_r_b(params.nmesh);
 
       trvm::SphericalHarmonicCalculator::
         store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_k_a
+          params.ell1, m1_, params_raw.boxsize, params_raw.ngrid, ylm_k_a
         );
       trvm::SphericalHarmonicCalculator
         ::store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_k_b
+          params.ell2, m2_, params_raw.boxsize, params_raw.ngrid, ylm_k_b
         );
       trvm::SphericalHarmonicCalculator::
         store_reduced_spherical_harmonic_in_config_space(
@@ -1290,14 +1696,20 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
       // Raw bispectrum
       // ·································································
 
-      MeshField G_00(params, true, "`G_00`");  // G_00
-      G_00.compute_unweighted_field_fluctuations_insitu(catalogue_data);
-      G_00.fourier_transform();
-      G_00.apply_assignment_compensation();
-      G_00.inv_fourier_transform();
+      std::shared_ptr<MeshField> G_00_ptr = nullptr;
+      if (cropped) {
+        G_00_ptr = std::make_shared<MeshField>(params_raw, true, "`G_00`");
+        G_00_ptr->crop_field_in_fourier(dn_00);
+        G_00_ptr->inv_fourier_transform();
+      } else {
+        G_00_ptr = fields.get_unweighted_field_fluctuations_in_config(
+          params, catalogue_data, "`G_00`"
+        );
+      }
+      MeshField& G_00 = *G_00_ptr;  // G_00
 
-      MeshField F_lm_a(params, true, "`F_lm_a`");  // F_lm_a
-      MeshField F_lm_b(params, true, "`F_lm_b`");  // F_lm_b
+      MeshField F_lm_a(params_raw, true, "`F_lm_a`");  // F_lm_a
+      MeshField F_lm_b(params_raw, true, "`F_lm_b`");  // F_lm_b
 
       if (params.form == "diag") {
         for (int idx_dv = 0; idx_dv < dv_dim; idx_dv++) {
@@ -1307,13 +1719,13 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
           double k_upper = kbinning.bin_edges[ibin + 1];
 
           double k_eff_a_, k_eff_b_;
-          int nmodes_a_, nmodes_b_;
+          long long nmodes_a_, nmodes_b_;
 
           F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-            dn_00, ylm_k_a, k_lower, k_upper, k_eff_a_, nmodes_a_
+            dn_00_raw, ylm_k_a, k_lower, k_upper, k_eff_a_, nmodes_a_
           );
           F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-            dn_00, ylm_k_b, k_lower, k_upper, k_eff_b_, nmodes_b_
+            dn_00_raw, ylm_k_b, k_lower, k_upper, k_eff_b_, nmodes_b_
           );
 
           if (count_terms == 0) {
@@ -1331,7 +1743,7 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
 #endif  // TRV_USE_OMP
-          for (int gid = 0; gid < params.nmesh; gid++) {
+          for (long long gid = 0; gid < params_raw.nmesh; gid++) {
             std::complex<double> F_lm_a_gridpt(F_lm_a[gid][0], F_lm_a[gid][1]);
             std::complex<double> F_lm_b_gridpt(F_lm_b[gid][0], F_lm_b[gid][1]);
             std::complex<double> G_00_gridpt(G_00[gid][0], G_00[gid][1]);
@@ -1359,13 +1771,13 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
           double k_upper_b = kbinning.bin_edges[ibin_col + 1];
 
           double k_eff_a_, k_eff_b_;
-          int nmodes_a_, nmodes_b_;
+          long long nmodes_a_, nmodes_b_;
 
           F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-            dn_00, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
+            dn_00_raw, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
           );
           F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-            dn_00, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
+            dn_00_raw, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
           );
 
           if (count_terms == 0) {
@@ -1383,7 +1795,7 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
 #endif  // TRV_USE_OMP
-          for (int gid = 0; gid < params.nmesh; gid++) {
+          for (long long gid = 0; gid < params_raw.nmesh; gid++) {
             std::complex<double> F_lm_a_gridpt(F_lm_a[gid][0], F_lm_a[gid][1]);
             std::complex<double> F_lm_b_gridpt(F_lm_b[gid][0], F_lm_b[gid][1]);
             std::complex<double> G_00_gridpt(G_00[gid][0], G_00[gid][1]);
@@ -1407,10 +1819,10 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
         double k_upper_a = kbinning.bin_edges[ibin_row + 1];
 
         double k_eff_a_;
-        int nmodes_a_;
+        long long nmodes_a_;
 
         F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-          dn_00, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
+          dn_00_raw, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
         );
 
         for (int idx_dv = 0; idx_dv < dv_dim; idx_dv++) {
@@ -1420,10 +1832,10 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
           double k_upper_b = kbinning.bin_edges[ibin_col + 1];
 
           double k_eff_b_;
-          int nmodes_b_;
+          long long nmodes_b_;
 
           F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-            dn_00, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
+            dn_00_raw, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
           );
 
           if (count_terms == 0) {
@@ -1441,7 +1853,7 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
 #endif  // TRV_USE_OMP
-          for (int gid = 0; gid < params.nmesh; gid++) {
+          for (long long gid = 0; gid < params_raw.nmesh; gid++) {
             std::complex<double> F_lm_a_gridpt(F_lm_a[gid][0], F_lm_a[gid][1]);
             std::complex<double> F_lm_b_gridpt(F_lm_b[gid][0], F_lm_b[gid][1]);
             std::complex<double> G_00_gridpt(G_00[gid][0], G_00[gid][1]);
@@ -1470,13 +1882,13 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
             double k_upper_b = kbinning.bin_edges[idx_col + 1];
 
             double k_eff_a_, k_eff_b_;
-            int nmodes_a_, nmodes_b_;
+            long long nmodes_a_, nmodes_b_;
 
             F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_00, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
+              dn_00_raw, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
             );
             F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_00, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
+              dn_00_raw, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
             );
 
             if (count_terms == 0) {
@@ -1494,7 +1906,7 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
 #endif  // TRV_USE_OMP
-            for (int gid = 0; gid < params.nmesh; gid++) {
+            for (long long gid = 0; gid < params_raw.nmesh; gid++) {
               std::complex<double> F_lm_a_gridpt(
                 F_lm_a[gid][0], F_lm_a[gid][1]
               );
@@ -1648,9 +2060,6 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
           m1_, m2_
         );
       }
-
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
     }
   }
 
@@ -1689,7 +2098,8 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
 trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning& rbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache
 ) {
   trvs::logger.reset_level(params.verbose);
 
@@ -1701,6 +2111,11 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
     );
   }
 
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_3pt_mem_usage(params, catalogue_data.ntotal),
+    params.memory_budget, "three-point correlation function measurement"
+  );
+
   // ---------------------------------------------------------------------
   // Set-up
   // ---------------------------------------------------------------------
@@ -1733,8 +2148,8 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
     }
   }
 
-  int* npairs1_dv = new int[dv_dim];
-  int* npairs2_dv = new int[dv_dim];
+  long long* npairs1_dv = new long long[dv_dim];
+  long long* npairs2_dv = new long long[dv_dim];
   double* r1bin_dv = new double[dv_dim];
   double* r2bin_dv = new double[dv_dim];
   double* r1eff_dv = new double[dv_dim];
@@ -1757,21 +2172,28 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
   // ---------------------------------------------------------------------
 
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
   // Compute common field quantities.
-  MeshField dn_00(params, true, "`dn_00`");  // δn_00(k)
-  dn_00.compute_unweighted_field_fluctuations_insitu(catalogue_data);
-  dn_00.fourier_transform();
+  MeshFieldCache field_cache_local;  // unshared unless a cache is given
+  MeshFieldCache& fields =
+    (field_cache != nullptr) ? *field_cache : field_cache_local;
+
+  std::shared_ptr<MeshField> dn_00_ptr =
+    fields.get_unweighted_field_fluctuations(params, catalogue_data, "`dn_00`");
+  MeshField& dn_00 = *dn_00_ptr;  // δn_00(k)
 
   MeshField& dn_L0_for_sn = dn_00;  // δn_L0(k)
 
   double vol_cell = dn_00.vol_cell;
 
-  MeshField N_00(params, true, "`N_00`");  // N_00(k)
-  N_00.compute_unweighted_field(catalogue_data);
-  N_00.fourier_transform();
+  std::shared_ptr<MeshField> N_00_ptr =
+    fields.get_unweighted_field(params, catalogue_data, "`N_00`");
+  MeshField& N_00 = *N_00_ptr;  // N_00(k)
 
   trvm::SphericalBesselCalculator sj_a(params.ell1);  // j_l_a
   trvm::SphericalBesselCalculator sj_b(params.ell2);  // j_l_b
@@ -1793,13 +2215,10 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
       if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
 
       // Initialise/reset spherical harmonic mesh grids.
-      std::vector< std::complex<double> > ylm_r_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
-      trvs::update_maxmem();
+      trvs::TrackedVector< std::complex<double> > ylm_r_a(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_r_b(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_k_a(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_k_b(params.nmesh);
 
       trvm::SphericalHarmonicCalculator::
         store_reduced_spherical_harmonic_in_config_space(
@@ -1926,11 +2345,11 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
       // ·································································
 
       // Compute 3PCF components in eqs. (42), (48) & (49) in the Paper.
-      MeshField G_00(params, true, "`G_00`");  // G_00
-      G_00.compute_unweighted_field_fluctuations_insitu(catalogue_data);
-      G_00.fourier_transform();
-      G_00.apply_assignment_compensation();
-      G_00.inv_fourier_transform();
+      std::shared_ptr<MeshField> G_00_ptr =
+        fields.get_unweighted_field_fluctuations_in_config(
+          params, catalogue_data, "`G_00`"
+        );
+      MeshField& G_00 = *G_00_ptr;  // G_00
 
       MeshField F_lm_a(params, true, "`F_lm_a`");  // F_lm_a
       MeshField F_lm_b(params, true, "`F_lm_b`");  // F_lm_b
@@ -1952,7 +2371,7 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:zeta_comp_real, zeta_comp_imag)
 #endif  // TRV_USE_OMP
-        for (int gid = 0; gid < params.nmesh; gid++) {
+        for (long long gid = 0; gid < params.nmesh; gid++) {
           std::complex<double> F_lm_a_gridpt(F_lm_a[gid][0], F_lm_a[gid][1]);
           std::complex<double> F_lm_b_gridpt(F_lm_b[gid][0], F_lm_b[gid][1]);
           std::complex<double> G_00_gridpt(G_00[gid][0], G_00[gid][1]);
@@ -1976,9 +2395,6 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
           m1_, m2_
         );
       }
-
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
     }
   }
 
@@ -2016,7 +2432,7 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
 }
 
 trv::ThreePCFWindowMeasurements compute_3pcf_window(
-  ParticleCatalogue& catalogue_rand, LineOfSight* los_rand,
+  ParticleCatalogue& catalogue_rand, const LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
   double alpha, double norm_factor, bool wide_angle
 ) {
@@ -2032,6 +2448,11 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
     );
   }
 
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_3pt_mem_usage(params, catalogue_rand.ntotal),
+    params.memory_budget, "three-point correlation function window measurement"
+  );
+
   // ---------------------------------------------------------------------
   // Set-up
   // ---------------------------------------------------------------------
@@ -2064,8 +2485,8 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
     }
   }
 
-  int* npairs1_dv = new int[dv_dim];
-  int* npairs2_dv = new int[dv_dim];
+  long long* npairs1_dv = new long long[dv_dim];
+  long long* npairs2_dv = new long long[dv_dim];
   double* r1bin_dv = new double[dv_dim];
   double* r2bin_dv = new double[dv_dim];
   double* r1eff_dv = new double[dv_dim];
@@ -2083,24 +2504,55 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
     sn_dv[idx_dv] = 0.;
   }  // likely redundant but safe
 
+  // Set up checkpointing of the accumulated data vectors (including
+  // bin metadata set with the first term).
+  TermCheckpoint checkpoint(
+    params, {&catalogue_rand}, wide_angle ? "wide_angle" : ""
+  );
+  checkpoint.attach(npairs1_dv, dv_dim * sizeof(long long));
+  checkpoint.attach(npairs2_dv, dv_dim * sizeof(long long));
+  checkpoint.attach(r1bin_dv, dv_dim * sizeof(double));
+  checkpoint.attach(r2bin_dv, dv_dim * sizeof(double));
+  checkpoint.attach(r1eff_dv, dv_dim * sizeof(double));
+  checkpoint.attach(r2eff_dv, dv_dim * sizeof(double));
+  checkpoint.attach(zeta_dv, dv_dim * sizeof(std::complex<double>));
+  checkpoint.attach(sn_dv, dv_dim * sizeof(std::complex<double>));
+
   // ---------------------------------------------------------------------
   // Measurement
   // ---------------------------------------------------------------------
 
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
   // Compute common field quantities.
-  MeshField n_00(params, true, "`n_00`");  // n_00(k)
-  n_00.compute_ylm_wgtd_field(catalogue_rand, los_rand, alpha, 0, 0);
-  n_00.fourier_transform();
+  std::shared_ptr<MeshField> n_00_ptr =
+    checkpoint.restore_field(params, "n_00", "`n_00`");
+  if (n_00_ptr == nullptr) {
+    n_00_ptr = std::make_shared<MeshField>(params, true, "`n_00`");
+    n_00_ptr->compute_ylm_wgtd_field(catalogue_rand, los_rand, alpha, 0, 0);
+    n_00_ptr->fourier_transform();
+    checkpoint.save_field(*n_00_ptr, "n_00");
+  }
+  MeshField& n_00 = *n_00_ptr;  // n_00(k)
 
   double vol_cell = n_00.vol_cell;
 
-  MeshField N_00(params, true, "`N_00`");  // N_00(k)
-  N_00.compute_ylm_wgtd_quad_field(catalogue_rand, los_rand, alpha, 0, 0);
-  N_00.fourier_transform();
+  std::shared_ptr<MeshField> N_00_ptr =
+    checkpoint.restore_field(params, "N_00", "`N_00`");
+  if (N_00_ptr == nullptr) {
+    N_00_ptr = std::make_shared<MeshField>(params, true, "`N_00`");
+    N_00_ptr->compute_ylm_wgtd_quad_field(
+      catalogue_rand, los_rand, alpha, 0, 0
+    );
+    N_00_ptr->fourier_transform();
+    checkpoint.save_field(*N_00_ptr, "N_00");
+  }
+  MeshField& N_00 = *N_00_ptr;  // N_00(k)
 
   trvm::SphericalBesselCalculator sj_a(params.ell1);  // j_l_a
   trvm::SphericalBesselCalculator sj_b(params.ell2);  // j_l_b
@@ -2108,17 +2560,21 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
   FieldStats stats_sn(params);
 
   // Compute 3PCF window terms including shot noise.
-  int count_terms = 0;
+  int count_terms = checkpoint.resume();  // resumed completed terms
   for (int m1_ = - params.ell1; m1_ <= params.ell1; m1_++) {
     for (int m2_ = - params.ell2; m2_ <= params.ell2; m2_++) {
       // Check for vanishing cases where all Wigner-3j symbols are zero.
-      // Check for if all Wigner-3j symbols are zero.
+      // Check for if all Wigner-3j symbols are zero (or all
+      // non-vanishing terms have been completed).
       std::string flag_vanishing = "true";
       for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
         double coupling = trv::calc_coupling_coeff_3pt(
           params.ell1, params.ell2, params.ELL, m1_, m2_, M_
         );
-        if (std::fabs(coupling) > trvm::eps_coupling) {
+        if (
+          std::fabs(coupling) > trvm::eps_coupling
+          && !checkpoint.is_completed(m1_, m2_, M_)
+        ) {
           flag_vanishing = "false";
           break;
         }
@@ -2126,13 +2582,10 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
       if (flag_vanishing == "true") {continue;}
 
       // Initialise reduced-spherical-harmonic weights on mesh grids.
-      std::vector< std::complex<double> > ylm_r_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
-      trvs::update_maxmem();
+      trvs::TrackedVector< std::complex<double> > ylm_r_a(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_r_b(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_k_a(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_k_b(params.nmesh);
 
       trvm::SphericalHarmonicCalculator::
         store_reduced_spherical_harmonic_in_config_space(
@@ -2157,6 +2610,7 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
           params.ell1, params.ell2, params.ELL, m1_, m2_, M_
         );  // Wigner 3-j's
         if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
+        if (checkpoint.is_completed(m1_, m2_, M_)) {continue;}
 
         // ·······························································
         // Shot noise
@@ -2305,7 +2759,7 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:zeta_comp_real, zeta_comp_imag)
 #endif  // TRV_USE_OMP
-          for (int gid = 0; gid < params.nmesh; gid++) {
+          for (long long gid = 0; gid < params.nmesh; gid++) {
             std::complex<double> F_lm_a_gridpt(F_lm_a[gid][0], F_lm_a[gid][1]);
             std::complex<double> F_lm_b_gridpt(F_lm_b[gid][0], F_lm_b[gid][1]);
             std::complex<double> G_LM_gridpt(G_LM[gid][0], G_LM[gid][1]);
@@ -2322,6 +2776,7 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
         }
 
         count_terms++;
+        checkpoint.complete(m1_, m2_, M_);
         if (trvs::currTask == 0) {
           trvs::logger.stat(
             "Three-point correlation function window term at orders "
@@ -2330,9 +2785,6 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
           );
         }
       }
-
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
     }
   }
 
@@ -2358,6 +2810,8 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
   delete[] r1eff_dv; delete[] r2eff_dv;
   delete[] zeta_dv; delete[] sn_dv;
 
+  checkpoint.finalise();
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "... computed three-point correlation function window %s"
@@ -2372,7 +2826,7 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
 #ifdef TRV_USE_LEGACY_CODE
 trv::BispecMeasurements compute_bispec_for_los_choice(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   int los_choice,
   trv::ParameterSet& params, trv::Binning& kbinning,
   double norm_factor
@@ -2387,6 +2841,13 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
     );
   }
 
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_3pt_mem_usage(
+      params, std::max(catalogue_data.ntotal, catalogue_rand.ntotal)
+    ),
+    params.memory_budget, "bispectrum measurement"
+  );
+
   // ---------------------------------------------------------------------
   // Set-up
   // ---------------------------------------------------------------------
@@ -2421,8 +2882,8 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
     }
   }
 
-  int* nmodes1_dv = new int[dv_dim];
-  int* nmodes2_dv = new int[dv_dim];
+  long long* nmodes1_dv = new long long[dv_dim];
+  long long* nmodes2_dv = new long long[dv_dim];
   double* k1bin_dv = new double[dv_dim];
   double* k2bin_dv = new double[dv_dim];
   double* k1eff_dv = new double[dv_dim];
@@ -2460,7 +2921,10 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
   // ---------------------------------------------------------------------
 
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
   // RFE: Not adopted until copy-assignment constructor is checked.
@@ -2479,6 +2943,10 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
   // );
   // ----<
 
+  // Set up the (possibly cropped) mesh grid for the raw bispectrum.
+  trv::ParameterSet params_raw = set_up_bispec_mesh(params, kbinning);
+  bool cropped = (params_raw.nmesh < params.nmesh);
+
   trvm::SphericalBesselCalculator sj_a(params.ell1);  // j_l_a
   trvm::SphericalBesselCalculator sj_b(params.ell2);  // j_l_b
 
@@ -2502,21 +2970,18 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
       if (flag_vanishing == "true") {continue;}
 
       // Initialise reduced-spherical-harmonic weights on mesh grids.
-      std::vector< std::complex<double> > ylm_k_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_b(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
-      trvs::update_maxmem();
+      trvs::TrackedVector< std::complex<double> > ylm_k_a(params_raw.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_k_b(params_raw.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_r_a(params.nmesh);
+      trvs::TrackedVector< std::complex<double> > ylm_r_b(params.nmesh);
 
       trvm::SphericalHarmonicCalculator::
         store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_k_a
+          params.ell1, m1_, params_raw.boxsize, params_raw.ngrid, ylm_k_a
         );
       trvm::SphericalHarmonicCalculator::
         store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_k_b
+          params.ell2, m2_, params_raw.boxsize, params_raw.ngrid, ylm_k_b
         );
       trvm::SphericalHarmonicCalculator::
         store_reduced_spherical_harmonic_in_config_space(
@@ -2580,13 +3045,35 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
           );
         }
         G_LM.fourier_transform();
-        G_LM.apply_assignment_compensation();
-        G_LM.inv_fourier_transform();
 
-        double vol_cell = G_LM.vol_cell;
+        // Crop the fields in Fourier space for the raw bispectrum
+        // if enabled.
+        std::shared_ptr<MeshField> dn_LM_a_crop_ptr = nullptr;
+        std::shared_ptr<MeshField> dn_LM_b_crop_ptr = nullptr;
+        std::shared_ptr<MeshField> G_LM_crop_ptr = nullptr;
+        if (cropped) {
+          dn_LM_a_crop_ptr =
+            std::make_shared<MeshField>(params_raw, false, "`dn_LM_a_raw`");
+          dn_LM_a_crop_ptr->crop_field_in_fourier(dn_LM_a);
+          dn_LM_b_crop_ptr =
+            std::make_shared<MeshField>(params_raw, false, "`dn_LM_b_raw`");
+          dn_LM_b_crop_ptr->crop_field_in_fourier(dn_LM_b);
+          G_LM_crop_ptr =
+            std::make_shared<MeshField>(params_raw, true, "`G_LM_raw`");
+          G_LM_crop_ptr->crop_field_in_fourier(G_LM);
+          G_LM_crop_ptr->inv_fourier_transform();
+        } else {
+          G_LM.apply_assignment_compensation();
+          G_LM.inv_fourier_transform();
+        }
+        MeshField& dn_LM_a_raw = cropped ? *dn_LM_a_crop_ptr : dn_LM_a;
+        MeshField& dn_LM_b_raw = cropped ? *dn_LM_b_crop_ptr : dn_LM_b;
+        MeshField& G_LM_raw = cropped ? *G_LM_crop_ptr : G_LM;
+
+        double vol_cell = G_LM_raw.vol_cell;
 
-        MeshField F_lm_a(params, true, "`F_lm_a`");  // F_lm_a
-        MeshField F_lm_b(params, true, "`F_lm_b`");  // F_lm_b
+        MeshField F_lm_a(params_raw, true, "`F_lm_a`");  // F_lm_a
+        MeshField F_lm_b(params_raw, true, "`F_lm_b`");  // F_lm_b
 
         if (params.form == "diag") {
           for (int idx_dv = 0; idx_dv < dv_dim; idx_dv++) {
@@ -2596,13 +3083,13 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
             double k_upper = kbinning.bin_edges[ibin + 1];
 
             double k_eff_a_, k_eff_b_;
-            int nmodes_a_, nmodes_b_;
+            long long nmodes_a_, nmodes_b_;
 
             F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_LM_a, ylm_k_a, k_lower, k_upper, k_eff_a_, nmodes_a_
+              dn_LM_a_raw, ylm_k_a, k_lower, k_upper, k_eff_a_, nmodes_a_
             );
             F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_LM_b, ylm_k_b, k_lower, k_upper, k_eff_b_, nmodes_b_
+              dn_LM_b_raw, ylm_k_b, k_lower, k_upper, k_eff_b_, nmodes_b_
             );
 
             if (count_terms == 0) {
@@ -2620,14 +3107,16 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
 #endif  // TRV_USE_OMP
-            for (int gid = 0; gid < params.nmesh; gid++) {
+            for (long long gid = 0; gid < params_raw.nmesh; gid++) {
               std::complex<double> F_lm_a_gridpt(
                 F_lm_a[gid][0], F_lm_a[gid][1]
               );
               std::complex<double> F_lm_b_gridpt(
                 F_lm_b[gid][0], F_lm_b[gid][1]
               );
-              std::complex<double> G_LM_gridpt(G_LM[gid][0], G_LM[gid][1]);
+              std::complex<double> G_LM_gridpt(
+                G_LM_raw[gid][0], G_LM_raw[gid][1]
+              );
               std::complex<double> bk_gridpt =
                 F_lm_a_gridpt * F_lm_b_gridpt * G_LM_gridpt;
 
@@ -2652,13 +3141,13 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
             double k_upper_b = kbinning.bin_edges[ibin_col + 1];
 
             double k_eff_a_, k_eff_b_;
-            int nmodes_a_, nmodes_b_;
+            long long nmodes_a_, nmodes_b_;
 
             F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_LM_a, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
+              dn_LM_a_raw, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
             );
             F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_LM_b, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
+              dn_LM_b_raw, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
             );
 
             if (count_terms == 0) {
@@ -2676,14 +3165,16 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
 #endif  // TRV_USE_OMP
-            for (int gid = 0; gid < params.nmesh; gid++) {
+            for (long long gid = 0; gid < params_raw.nmesh; gid++) {
               std::complex<double> F_lm_a_gridpt(
                 F_lm_a[gid][0], F_lm_a[gid][1]
               );
               std::complex<double> F_lm_b_gridpt(
                 F_lm_b[gid][0], F_lm_b[gid][1]
               );
-              std::complex<double> G_LM_gridpt(G_LM[gid][0], G_LM[gid][1]);
+              std::complex<double> G_LM_gridpt(
+                G_LM_raw[gid][0], G_LM_raw[gid][1]
+              );
               std::complex<double> bk_gridpt =
                 F_lm_a_gridpt * F_lm_b_gridpt * G_LM_gridpt;
 
@@ -2704,10 +3195,10 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
           double k_upper_a = kbinning.bin_edges[params.idx_bin + 1];
 
           double k_eff_a_;
-          int nmodes_a_;
+          long long nmodes_a_;
 
           F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-            dn_LM_a, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
+            dn_LM_a_raw, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
           );
 
           for (int idx_dv = 0; idx_dv < dv_dim; idx_dv++) {
@@ -2717,10 +3208,10 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
             double k_upper_b = kbinning.bin_edges[ibin_col + 1];
 
             double k_eff_b_;
-            int nmodes_b_;
+            long long nmodes_b_;
 
             F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_LM_b, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
+              dn_LM_b_raw, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
             );
 
             if (count_terms == 0) {
@@ -2738,14 +3229,16 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
 #endif  // TRV_USE_OMP
-            for (int gid = 0; gid < params.nmesh; gid++) {
+            for (long long gid = 0; gid < params_raw.nmesh; gid++) {
               std::complex<double> F_lm_a_gridpt(
                 F_lm_a[gid][0], F_lm_a[gid][1]
               );
               std::complex<double> F_lm_b_gridpt(
                 F_lm_b[gid][0], F_lm_b[gid][1]
               );
-              std::complex<double> G_LM_gridpt(G_LM[gid][0], G_LM[gid][1]);
+              std::complex<double> G_LM_gridpt(
+                G_LM_raw[gid][0], G_LM_raw[gid][1]
+              );
               std::complex<double> bk_gridpt =
                 F_lm_a_gridpt * F_lm_b_gridpt * G_LM_gridpt;
 
@@ -2771,13 +3264,13 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
               double k_upper_b = kbinning.bin_edges[idx_col + 1];
 
               double k_eff_a_, k_eff_b_;
-              int nmodes_a_, nmodes_b_;
+              long long nmodes_a_, nmodes_b_;
 
               F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-                dn_LM_a, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
+                dn_LM_a_raw, ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
               );
               F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-                dn_LM_b, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
+                dn_LM_b_raw, ylm_k_b, k_lower_b, k_upper_b, k_eff_b_, nmodes_b_
               );
 
               if (count_terms == 0) {
@@ -2795,14 +3288,16 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:bk_comp_real, bk_comp_imag)
 #endif  // TRV_USE_OMP
-              for (int gid = 0; gid < params.nmesh; gid++) {
+              for (long long gid = 0; gid < params_raw.nmesh; gid++) {
                 std::complex<double> F_lm_a_gridpt(
                   F_lm_a[gid][0], F_lm_a[gid][1]
                 );
                 std::complex<double> F_lm_b_gridpt(
                   F_lm_b[gid][0], F_lm_b[gid][1]
                 );
-                std::complex<double> G_LM_gridpt(G_LM[gid][0], G_LM[gid][1]);
+                std::complex<double> G_LM_gridpt(
+                  G_LM_raw[gid][0], G_LM_raw[gid][1]
+                );
                 std::complex<double> bk_gridpt =
                   F_lm_a_gridpt * F_lm_b_gridpt * G_LM_gridpt;
 
@@ -3041,9 +3536,6 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
           );
         }
       }
-
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4*params.nmesh);
     }
   }
 
@@ -54,7 +54,7 @@ double calc_coupling_coeff_2pt(int ell, int ELL, int m, int M) {
 double calc_powspec_normalisation_from_particles(
   ParticleCatalogue& particles, double alpha
 ) {
-  if (particles.pdata == nullptr) {
+  if (particles.w == nullptr) {
     if (trvs::currTask == 0) {
       trvs::logger.error("Particle data are uninitialised.");
       throw trvs::InvalidDataError("Particle data are uninitialised.\n");
@@ -66,9 +66,9 @@ double calc_powspec_normalisation_from_particles(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:norm)
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    norm += particles[pid].ws
-      * particles[pid].nz * std::pow(particles[pid].wc, 2);
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
+    norm += particles.ws[pid]
+      * particles.nz[pid] * std::pow(particles.wc[pid], 2);
   }
 
   if (norm == 0.) {
@@ -124,16 +124,16 @@ double calc_powspec_normalisation_from_meshes(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles_data.ntotal; pid++) {
-    weight_data[pid][0] = particles_data[pid].w;
+  for (long long pid = 0; pid < particles_data.ntotal; pid++) {
+    weight_data[pid][0] = particles_data.w[pid];
     weight_data[pid][1] = 0.;
   }
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles_rand.ntotal; pid++) {
-    weight_rand[pid][0] = particles_rand[pid].w;
+  for (long long pid = 0; pid < particles_rand.ntotal; pid++) {
+    weight_rand[pid][0] = particles_rand.w[pid];
     weight_rand[pid][1] = 0.;
   }
 
@@ -152,7 +152,7 @@ double calc_powspec_normalisation_from_meshes(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:norm)
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < params.nmesh; gid++) {
+  for (long long gid = 0; gid < params.nmesh; gid++) {
     norm += mesh_data.field[gid][0] * mesh_rand.field[gid][0];
   }
 
@@ -207,7 +207,7 @@ double calc_powspec_normalisation_from_meshes(
 double calc_powspec_shotnoise_from_particles(
   ParticleCatalogue& particles, double alpha
 ) {
-  if (particles.pdata == nullptr) {
+  if (particles.w == nullptr) {
     if (trvs::currTask == 0) {
       trvs::logger.error("Particle data are uninitialised.");
       throw trvs::InvalidDataError("Particle data are uninitialised.\n");
@@ -219,9 +219,9 @@ double calc_powspec_shotnoise_from_particles(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:shotnoise)
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
     shotnoise +=
-      std::pow(particles[pid].ws, 2) * std::pow(particles[pid].wc, 2);
+      std::pow(particles.ws[pid], 2) * std::pow(particles.wc[pid], 2);
   }
 
   return shotnoise;
@@ -229,23 +229,29 @@ double calc_powspec_shotnoise_from_particles(
 
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   double alpha, int ell, int m
 ) {
+  trvs::ScopedTimer timer(
+    "shotnoise",
+    trvs::size_in_gb<double>(
+      4*(particles_data.ntotal + particles_rand.ntotal)
+    )
+  );
+
   double sn_data_real = 0., sn_data_imag = 0.;
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_data_real, sn_data_imag)
 #endif
-  for (int pid = 0; pid < particles_data.ntotal; pid++) {
-    double los_[3] = {
-      los_data[pid].pos[0], los_data[pid].pos[1], los_data[pid].pos[2]
-    };
+  for (long long pid = 0; pid < particles_data.ntotal; pid++) {
+    double los_[3];
+    los_data.eval(particles_data, pid, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
 
-    std::complex<double> sn_part = ylm * std::pow(particles_data[pid].w, 2);
+    std::complex<double> sn_part = ylm * std::pow(particles_data.w[pid], 2);
     double sn_part_real = sn_part.real();
     double sn_part_imag = sn_part.imag();
 
@@ -260,15 +266,14 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_rand_real, sn_rand_imag)
 #endif
-  for (int pid = 0; pid < particles_rand.ntotal; pid++) {
-    double los_[3] = {
-      los_rand[pid].pos[0], los_rand[pid].pos[1], los_rand[pid].pos[2]
-    };
+  for (long long pid = 0; pid < particles_rand.ntotal; pid++) {
+    double los_[3];
+    los_rand.eval(particles_rand, pid, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
 
-    std::complex<double> sn_part = ylm * std::pow(particles_rand[pid].w, 2);
+    std::complex<double> sn_part = ylm * std::pow(particles_rand.w[pid], 2);
     double sn_part_real = sn_part.real();
     double sn_part_imag = sn_part.imag();
 
@@ -282,21 +287,27 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
 }
 
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
-  ParticleCatalogue& particles, LineOfSight* los,
+  ParticleCatalogue& particles, const LineOfSightPolicy& los,
   double alpha, int ell, int m
 ) {
+  trvs::ScopedTimer timer(
+    "shotnoise", trvs::size_in_gb<double>(4*particles.ntotal)
+  );
+
   double sn_real = 0., sn_imag = 0.;
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_real, sn_imag)
 #endif
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    double los_[3] = {los[pid].pos[0], los[pid].pos[1], los[pid].pos[2]};
+  for (long long pid = 0; pid < particles.ntotal; pid++) {
+    double los_[3];
+
+    los.eval(particles, pid, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
 
-    std::complex<double> sn_part = ylm * std::pow(particles[pid].w, 2);
+    std::complex<double> sn_part = ylm * std::pow(particles.w[pid], 2);
     double sn_part_real = sn_part.real();
     double sn_part_imag = sn_part.imag();
 
@@ -309,6 +320,78 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
   return std::pow(alpha, 2) * sn;
 }
 
+std::vector<double> calc_los_moment_wgtd_shotnoise_amps_for_powspec(
+  ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
+  double alpha, const trvm::CartesianMomentCalculator& moment_calc
+) {
+  trvs::ScopedTimer timer(
+    "shotnoise",
+    trvs::size_in_gb<double>(
+      4*(particles_data.ntotal + particles_rand.ntotal)
+    )
+  );
+
+  const int nmoments = moment_calc.nmoments;
+
+  std::vector<double> sn_amps(nmoments, 0.);
+
+  // Accumulate per thread to avoid array reductions.
+  auto accumulate_sn_amps = [&](
+    ParticleCatalogue& particles, const LineOfSightPolicy& los, double amp
+  ) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel
+#endif  // TRV_USE_OMP
+    {
+      std::vector<double> sn_amps_part(nmoments, 0.);
+      double moments_[2*trvm::CartesianMomentCalculator::ell_max + 1];
+
+#ifdef TRV_USE_OMP
+#pragma omp for
+#endif  // TRV_USE_OMP
+      for (long long pid = 0; pid < particles.ntotal; pid++) {
+        double los_[3];
+        los.eval(particles, pid, los_);
+
+        moment_calc.calc_los_moments(los_, moments_);
+
+        double w_sq = std::pow(particles.w[pid], 2);
+        for (int ib = 0; ib < nmoments; ib++) {
+          sn_amps_part[ib] += moments_[ib] * w_sq;
+        }
+      }
+
+#ifdef TRV_USE_OMP
+#pragma omp critical (los_moment_shotnoise)
+#endif  // TRV_USE_OMP
+      for (int ib = 0; ib < nmoments; ib++) {
+        sn_amps[ib] += amp * sn_amps_part[ib];
+      }
+    }
+  };
+
+  accumulate_sn_amps(particles_data, los_data, 1.);
+  accumulate_sn_amps(particles_rand, los_rand, std::pow(alpha, 2));
+
+  return sn_amps;
+}
+
+
+// ***********************************************************************
+// Memory usage
+// ***********************************************************************
+
+double estimate_2pt_mem_usage(trv::ParameterSet& params, long long ntotal) {
+  // Two fields are held at once, with a third (random-source) field and
+  // particle weights during mesh assignment, besides the statistics mesh
+  // and its fine-binning arrays (of 10^6 samples with 80 bytes each).
+  return 3 * MeshField::get_size_in_gb(params)
+    + trvs::size_in_gb<fftw_complex>(params.nmesh)
+    + trvs::size_in_gb<fftw_complex>(ntotal)
+    + trvs::size_in_gb<char>(80000000LL);
+}
+
 
 // ***********************************************************************
 // Full statistics
@@ -319,9 +402,10 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
 
 trv::PowspecMeasurements compute_powspec(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning& kbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache
 ) {
   trvs::logger.reset_level(params.verbose);
 
@@ -331,6 +415,17 @@ trv::PowspecMeasurements compute_powspec(
     );
   }
 
+  // The Cartesian estimator additionally holds the accumulated
+  // multipole field.
+  bool cartesian = (params.powspec_estimator == "cartesian" && params.ELL > 0);
+
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_2pt_mem_usage(
+      params, std::max(catalogue_data.ntotal, catalogue_rand.ntotal)
+    ) + (cartesian ? MeshField::get_size_in_gb(params) : 0.),
+    params.memory_budget, "power spectrum measurement"
+  );
+
   // ---------------------------------------------------------------------
   // Set-up
   // ---------------------------------------------------------------------
@@ -340,7 +435,7 @@ trv::PowspecMeasurements compute_powspec(
   int ell1 = params.ELL;
 
   // Set up output.
-  int* nmodes_save = new int[kbinning.num_bins];
+  long long* nmodes_save = new long long[kbinning.num_bins];
   double* k_save = new double[kbinning.num_bins];
   std::complex<double>* pk_save = new std::complex<double>[kbinning.num_bins];
   std::complex<double>* sn_save = new std::complex<double>[kbinning.num_bins];
@@ -356,62 +451,114 @@ trv::PowspecMeasurements compute_powspec(
   // ---------------------------------------------------------------------
 
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
-  MeshField dn_00(params, true, "`dn_00`");  // δn_00(k)
-  dn_00.compute_ylm_wgtd_field(
-    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+  MeshFieldCache field_cache_local;  // unshared unless a cache is given
+  MeshFieldCache& fields =
+    (field_cache != nullptr) ? *field_cache : field_cache_local;
+
+  std::shared_ptr<MeshField> dn_00_ptr = fields.get_ylm_wgtd_field(
+    params, catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0,
+    "`dn_00`", kbinning.bin_max
   );
-  dn_00.fourier_transform();
+  MeshField& dn_00 = *dn_00_ptr;  // δn_00(k)
 
   FieldStats stats_2pt(params);
 
-  for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
-    MeshField dn_LM(params, true, "`dn_LM`");  // δn_LM(k)
-    dn_LM.compute_ylm_wgtd_field(
-      catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
-    );
-    dn_LM.fourier_transform();
+  if (cartesian) {
+    trvm::CartesianMomentCalculator moment_calc(params.ELL);
+
+    std::vector<double> sn_amps =
+      trv::calc_los_moment_wgtd_shotnoise_amps_for_powspec(
+        catalogue_data, catalogue_rand, los_data, los_rand, alpha,
+        moment_calc
+      );  // \bar{N}_b
+
+    // Accumulate Σ_b w_b(k) δn_b(k) from the real moment fields, which
+    // are packed in pairs into complex fields to halve the number of
+    // Fourier transforms.
+    MeshField dn_L(params, false, "`dn_L`");  // Σ_b w_b(k) δn_b(k)
+    for (int ib = 0; ib < moment_calc.nmoments; ib += 2) {
+      int ib_pair = (ib + 1 < moment_calc.nmoments) ? ib + 1 : -1;
+
+      MeshField dn_ab(params, true, "`dn_ab`");  // δn_a(k) + i δn_b(k)
+      dn_ab.compute_los_moment_wgtd_field(
+        catalogue_data, catalogue_rand, los_data, los_rand, alpha,
+        moment_calc, ib, ib_pair
+      );
+      dn_ab.fourier_transform(kbinning.bin_max);
 
-    std::complex<double> sn_amp = trv::calc_ylm_wgtd_shotnoise_amp_for_powspec(
-      catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
-    );  // \bar{N}_LM(k)
+      dn_L.add_unpacked_los_moment_wgtd_fields(
+        dn_ab, moment_calc, ib, ib_pair
+      );
+    }
 
-    // Compute quantity equivalent to (-1)^m₁ δᴰ_{m₁, -M} which, after
-    // being summed over m₁, agrees with Hand et al. (2017) [1704.02357].
-    for (int m1 = - ell1; m1 <= ell1; m1++) {
-      double coupling = calc_coupling_coeff_2pt(ell1, params.ELL, m1, M_);
-      if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
+    stats_2pt.compute_los_moment_wgtd_2pt_stats_in_fourier(
+      dn_L, dn_00, sn_amps, moment_calc, kbinning
+    );
+
+    // Apply the addition theorem for the reduced spherical harmonics.
+    double coupling = 2*params.ELL + 1;
+    for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+      nmodes_save[ibin] = stats_2pt.nmodes[ibin];
+      k_save[ibin] = stats_2pt.k[ibin];
+      pk_save[ibin] = coupling * stats_2pt.pk[ibin];
+      sn_save[ibin] = coupling * stats_2pt.sn[ibin];
+    }
 
-      stats_2pt.compute_ylm_wgtd_2pt_stats_in_fourier(
-        dn_LM, dn_00, sn_amp, ell1, m1, kbinning
+    if (trvs::currTask == 0) {
+      trvs::logger.stat(
+        "Power spectrum terms from %d Cartesian moments computed.",
+        moment_calc.nmoments
+      );
+    }
+  } else {
+    for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
+      std::shared_ptr<MeshField> dn_LM_ptr = fields.get_ylm_wgtd_field(
+        params, catalogue_data, catalogue_rand, los_data, los_rand, alpha,
+        params.ELL, M_, "`dn_LM`", kbinning.bin_max
       );
+      MeshField& dn_LM = *dn_LM_ptr;  // δn_LM(k)
 
-      for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
-        pk_save[ibin] += coupling * stats_2pt.pk[ibin];
-        sn_save[ibin] += coupling * stats_2pt.sn[ibin];
-      }
+      std::complex<double> sn_amp =
+        trv::calc_ylm_wgtd_shotnoise_amp_for_powspec(
+          catalogue_data, catalogue_rand, los_data, los_rand, alpha,
+          params.ELL, M_
+        );  // \bar{N}_LM(k)
+
+      // Compute quantity equivalent to (-1)^m₁ δᴰ_{m₁, -M} which, after
+      // being summed over m₁, agrees with Hand et al. (2017) [1704.02357].
+      for (int m1 = - ell1; m1 <= ell1; m1++) {
+        double coupling = calc_coupling_coeff_2pt(ell1, params.ELL, m1, M_);
+        if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
+
+        stats_2pt.compute_ylm_wgtd_2pt_stats_in_fourier(
+          dn_LM, dn_00, sn_amp, ell1, m1, kbinning
+        );
 
-      if (M_ == 0 && m1 == 0) {
         for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
-          nmodes_save[ibin] = stats_2pt.nmodes[ibin];
-          k_save[ibin] = stats_2pt.k[ibin];
+          pk_save[ibin] += coupling * stats_2pt.pk[ibin];
+          sn_save[ibin] += coupling * stats_2pt.sn[ibin];
+        }
+
+        if (M_ == 0 && m1 == 0) {
+          for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+            nmodes_save[ibin] = stats_2pt.nmodes[ibin];
+            k_save[ibin] = stats_2pt.k[ibin];
+          }
         }
       }
-    }
 
-    if (trvs::currTask == 0) {
-      trvs::logger.stat("Power spectrum term at order M = %d computed.", M_);
+      if (trvs::currTask == 0) {
+        trvs::logger.stat("Power spectrum term at order M = %d computed.", M_);
+      }
     }
   }
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   // ---------------------------------------------------------------------
   // Results
   // ---------------------------------------------------------------------
@@ -439,9 +586,10 @@ trv::PowspecMeasurements compute_powspec(
 
 trv::TwoPCFMeasurements compute_corrfunc(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  const LineOfSightPolicy& los_data, const LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache
 ) {
   trvs::logger.reset_level(params.verbose);
 
@@ -452,6 +600,13 @@ trv::TwoPCFMeasurements compute_corrfunc(
     );
   }
 
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_2pt_mem_usage(
+      params, std::max(catalogue_data.ntotal, catalogue_rand.ntotal)
+    ),
+    params.memory_budget, "two-point correlation function measurement"
+  );
+
   // ---------------------------------------------------------------------
   // Set-up
   // ---------------------------------------------------------------------
@@ -461,7 +616,7 @@ trv::TwoPCFMeasurements compute_corrfunc(
   int ell1 = params.ELL;
 
   // Set up output.
-  int* npairs_save = new int[rbinning.num_bins];
+  long long* npairs_save = new long long[rbinning.num_bins];
   double* r_save = new double[rbinning.num_bins];
   std::complex<double>* xi_save = new std::complex<double>[rbinning.num_bins];
   for (int ibin = 0; ibin < rbinning.num_bins; ibin++) {
@@ -475,23 +630,30 @@ trv::TwoPCFMeasurements compute_corrfunc(
   // ---------------------------------------------------------------------
 
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
-  MeshField dn_00(params, true, "`dn_00`");  // δn_00(k)
-  dn_00.compute_ylm_wgtd_field(
-    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+  MeshFieldCache field_cache_local;  // unshared unless a cache is given
+  MeshFieldCache& fields =
+    (field_cache != nullptr) ? *field_cache : field_cache_local;
+
+  std::shared_ptr<MeshField> dn_00_ptr = fields.get_ylm_wgtd_field(
+    params, catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0,
+    "`dn_00`"
   );
-  dn_00.fourier_transform();
+  MeshField& dn_00 = *dn_00_ptr;  // δn_00(k)
 
   FieldStats stats_2pt(params);
 
   for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
-    MeshField dn_LM(params, true, "`dn_LM`");  // δn_LM(k)
-    dn_LM.compute_ylm_wgtd_field(
-      catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
+    std::shared_ptr<MeshField> dn_LM_ptr = fields.get_ylm_wgtd_field(
+      params, catalogue_data, catalogue_rand, los_data, los_rand, alpha,
+      params.ELL, M_, "`dn_LM`"
     );
-    dn_LM.fourier_transform();
+    MeshField& dn_LM = *dn_LM_ptr;  // δn_LM(k)
 
     std::complex<double> sn_amp = trv::calc_ylm_wgtd_shotnoise_amp_for_powspec(
       catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
@@ -526,12 +688,6 @@ trv::TwoPCFMeasurements compute_corrfunc(
     }
   }
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   // ---------------------------------------------------------------------
   // Results
   // ---------------------------------------------------------------------
@@ -560,7 +716,8 @@ trv::TwoPCFMeasurements compute_corrfunc(
 trv::PowspecMeasurements compute_powspec_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning kbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache
 ) {
   trvs::logger.reset_level(params.verbose);
 
@@ -571,11 +728,16 @@ trv::PowspecMeasurements compute_powspec_in_gpp_box(
     );
   }
 
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_2pt_mem_usage(params, catalogue_data.ntotal),
+    params.memory_budget, "power spectrum measurement"
+  );
+
   // ---------------------------------------------------------------------
   // Set-up
   // ---------------------------------------------------------------------
 
-  int* nmodes_save = new int[kbinning.num_bins];
+  long long* nmodes_save = new long long[kbinning.num_bins];
   double* k_save = new double[kbinning.num_bins];
   std::complex<double>* pk_save = new std::complex<double>[kbinning.num_bins];
   std::complex<double>* sn_save = new std::complex<double>[kbinning.num_bins];
@@ -601,13 +763,21 @@ trv::PowspecMeasurements compute_powspec_in_gpp_box(
   // ---------------------------------------------------------------------
 
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
   // Compute power spectrum.
-  MeshField dn(params, true, "`dn`");  // δn(k)
-  dn.compute_unweighted_field_fluctuations_insitu(catalogue_data);
-  dn.fourier_transform();
+  MeshFieldCache field_cache_local;  // unshared unless a cache is given
+  MeshFieldCache& fields =
+    (field_cache != nullptr) ? *field_cache : field_cache_local;
+
+  std::shared_ptr<MeshField> dn_ptr = fields.get_unweighted_field_fluctuations(
+    params, catalogue_data, "`dn`", kbinning.bin_max
+  );
+  MeshField& dn = *dn_ptr;  // δn(k)
 
   std::complex<double> sn_amp = double(catalogue_data.ntotal);  // \bar{N}
 
@@ -625,12 +795,6 @@ trv::PowspecMeasurements compute_powspec_in_gpp_box(
     sn_save[ibin] += double(2*params.ELL + 1) * stats_2pt.sn[ibin];
   }
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   // ---------------------------------------------------------------------
   // Results
   // ---------------------------------------------------------------------
@@ -659,10 +823,152 @@ trv::PowspecMeasurements compute_powspec_in_gpp_box(
   return powspec_out;
 }
 
+trv::PowspecKMuMeasurements compute_powspec_kmu_in_gpp_box(
+  ParticleCatalogue& catalogue_data,
+  trv::ParameterSet& params, trv::Binning kbinning,
+  const std::vector<int>& ells, int num_wedges,
+  double norm_factor,
+  MeshFieldCache* field_cache
+) {
+  trvs::logger.reset_level(params.verbose);
+
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "Computing power spectrum multipoles and wedges "
+      "from a periodic-box simulation-type catalogue "
+      "in the global plane-parallel approximation."
+    );
+  }
+
+  for (int ell : ells) {
+    if (ell < 0) {
+      if (trvs::currTask == 0) {
+        trvs::logger.error(
+          "Power spectrum multipole degree must be non-negative: %d.", ell
+        );
+      }
+      throw trvs::InvalidParameterError(
+        "Power spectrum multipole degree must be non-negative: %d.\n", ell
+      );
+    }
+  }
+  if (num_wedges < 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Number of power spectrum wedges must be non-negative: %d.",
+        num_wedges
+      );
+    }
+    throw trvs::InvalidParameterError(
+      "Number of power spectrum wedges must be non-negative: %d.\n",
+      num_wedges
+    );
+  }
+
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_2pt_mem_usage(params, catalogue_data.ntotal),
+    params.memory_budget, "power spectrum measurement"
+  );
+
+  // Check input normalisation matches expectation.
+  double norm = double(catalogue_data.ntotal) * double(catalogue_data.ntotal)
+    / params.volume;
+  if (std::fabs(1 - norm * norm_factor) > eps_norm) {
+    trvs::logger.warn(
+      "Power spectrum normalisation input differs from "
+      "expected value for an unweight field in a periodic box."
+    );
+  }
+
+  // ---------------------------------------------------------------------
+  // Measurement
+  // ---------------------------------------------------------------------
+
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+
+  // Compute power spectrum multipoles and wedges.
+  MeshFieldCache field_cache_local;  // unshared unless a cache is given
+  MeshFieldCache& fields =
+    (field_cache != nullptr) ? *field_cache : field_cache_local;
+
+  std::shared_ptr<MeshField> dn_ptr = fields.get_unweighted_field_fluctuations(
+    params, catalogue_data, "`dn`", kbinning.bin_max
+  );
+  MeshField& dn = *dn_ptr;  // δn(k)
+
+  std::complex<double> sn_amp = double(catalogue_data.ntotal);  // \bar{N}
+
+  // Under the global plane-parallel approximation, the reduced spherical
+  // harmonics y_{ℓ0} reduce to the Legendre polynomials in μ, so all
+  // multipoles and wedges follow from the same sweep.
+  FieldStats stats_2pt(params);
+  stats_2pt.compute_kmu_2pt_stats_in_fourier(
+    dn, dn, sn_amp, ells, num_wedges, kbinning
+  );
+
+  // ---------------------------------------------------------------------
+  // Results
+  // ---------------------------------------------------------------------
+
+  // Fill in output struct.
+  trv::PowspecKMuMeasurements powspec_out;
+  powspec_out.ells = ells;
+  for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+    powspec_out.kbin.push_back(kbinning.bin_centres[ibin]);
+    powspec_out.keff.push_back(stats_2pt.k[ibin]);
+    powspec_out.nmodes.push_back(stats_2pt.nmodes[ibin]);
+  }
+  for (std::size_t iell = 0; iell < ells.size(); iell++) {
+    for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+      int idx = iell * kbinning.num_bins + ibin;
+      powspec_out.pk_raw.push_back(
+        norm_factor * double(2*ells[iell] + 1) * stats_2pt.pk_poles[idx]
+      );
+      powspec_out.pk_shot.push_back(
+        norm_factor * double(2*ells[iell] + 1) * stats_2pt.sn_poles[idx]
+      );
+    }
+  }
+  if (num_wedges > 0) {
+    for (int imu = 0; imu <= num_wedges; imu++) {
+      powspec_out.mu_edges.push_back(double(imu) / num_wedges);
+    }
+  }
+  for (int idx = 0; idx < num_wedges * kbinning.num_bins; idx++) {
+    powspec_out.keff_wedges.push_back(stats_2pt.k_wedges[idx]);
+    powspec_out.mueff_wedges.push_back(stats_2pt.mu_wedges[idx]);
+    powspec_out.nmodes_wedges.push_back(stats_2pt.nmodes_wedges[idx]);
+    powspec_out.pk_raw_wedges.push_back(
+      norm_factor * stats_2pt.pk_wedges[idx]
+    );
+    powspec_out.pk_shot_wedges.push_back(
+      norm_factor * stats_2pt.sn_wedges[idx]
+    );
+  }
+  powspec_out.dim = kbinning.num_bins;
+  powspec_out.num_wedges = num_wedges;
+
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "... computed power spectrum multipoles and wedges "
+      "from a periodic-box simulation-type catalogue "
+      "in the global plane-parallel approximation."
+    );
+  }
+
+  return powspec_out;
+}
+
 trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning& rbinning,
-  double norm_factor
+  double norm_factor,
+  MeshFieldCache* field_cache
 ) {
   trvs::logger.reset_level(params.verbose);
 
@@ -674,11 +980,16 @@ trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
     );
   }
 
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_2pt_mem_usage(params, catalogue_data.ntotal),
+    params.memory_budget, "two-point correlation function measurement"
+  );
+
   // ---------------------------------------------------------------------
   // Set-up
   // ---------------------------------------------------------------------
 
-  int* npairs_save = new int[rbinning.num_bins];
+  long long* npairs_save = new long long[rbinning.num_bins];
   double* r_save = new double[rbinning.num_bins];
   std::complex<double>* xi_save = new std::complex<double>[rbinning.num_bins];
   for (int ibin = 0; ibin < rbinning.num_bins; ibin++) {
@@ -702,13 +1013,20 @@ trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
   // ---------------------------------------------------------------------
 
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
   // Compute 2PCF.
-  MeshField dn(params, true, "`dn`");  // δn(k)
-  dn.compute_unweighted_field_fluctuations_insitu(catalogue_data);
-  dn.fourier_transform();
+  MeshFieldCache field_cache_local;  // unshared unless a cache is given
+  MeshFieldCache& fields =
+    (field_cache != nullptr) ? *field_cache : field_cache_local;
+
+  std::shared_ptr<MeshField> dn_ptr =
+    fields.get_unweighted_field_fluctuations(params, catalogue_data, "`dn`");
+  MeshField& dn = *dn_ptr;  // δn(k)
 
   std::complex<double> sn_amp = double(catalogue_data.ntotal);  // \bar{N}
 
@@ -725,12 +1043,6 @@ trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
     xi_save[ibin] += double(2*params.ELL + 1) * stats_2pt.xi[ibin];
   }
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   // ---------------------------------------------------------------------
   // Results
   // ---------------------------------------------------------------------
@@ -759,7 +1071,8 @@ trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
 }
 
 trv::TwoPCFWindowMeasurements compute_corrfunc_window(
-  trv::ParticleCatalogue& catalogue_rand, trv::LineOfSight* los_rand,
+  trv::ParticleCatalogue& catalogue_rand,
+  const trv::LineOfSightPolicy& los_rand,
   trv::ParameterSet& params, trv::Binning rbinning,
   double alpha, double norm_factor
 ) {
@@ -772,6 +1085,11 @@ trv::TwoPCFWindowMeasurements compute_corrfunc_window(
     );
   }
 
+  trvs::check_mem_budget(
+    trvs::gbytesMem + estimate_2pt_mem_usage(params, catalogue_rand.ntotal),
+    params.memory_budget, "two-point correlation function window measurement"
+  );
+
   // ---------------------------------------------------------------------
   // Set-up
   // ---------------------------------------------------------------------
@@ -780,7 +1098,7 @@ trv::TwoPCFWindowMeasurements compute_corrfunc_window(
   int ell1 = params.ELL;
 
   // Set up output.
-  int* npairs_save = new int[rbinning.num_bins];
+  long long* npairs_save = new long long[rbinning.num_bins];
   double* r_save = new double[rbinning.num_bins];
   std::complex<double>* xi_save = new std::complex<double>[rbinning.num_bins];
   for (int ibin = 0; ibin < rbinning.num_bins; ibin++) {
@@ -794,7 +1112,10 @@ trv::TwoPCFWindowMeasurements compute_corrfunc_window(
   // ---------------------------------------------------------------------
 
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
+  {
+    std::lock_guard<std::mutex> planner_lock(trvs::fftw_planner_mutex);
+    fftw_init_threads();
+  }
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
 
   MeshField dn_00(params, true, "`dn_00`");
@@ -844,12 +1165,6 @@ trv::TwoPCFWindowMeasurements compute_corrfunc_window(
     }
   }
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   // ---------------------------------------------------------------------
   // Results
   // ---------------------------------------------------------------------
@@ -0,0 +1,475 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file winconv.cpp
+ * @authors Mike S Wang (https://github.com/MikeSWang)
+ *
+ */
+
+#include "winconv.hpp"
+
+namespace trva = trv::array;
+namespace trvm = trv::maths;
+namespace trvs = trv::sys;
+
+namespace trv {
+
+WinConvEngine::WinConvEngine(
+  int ndim, int nmultipoles, int nmultipoles_Z,
+  int nsamp_in, int nsamp, int nsamp_out,
+  std::vector<double> coupling, bool threaded
+) {
+  if (ndim != 1 && ndim != 2) {
+    throw trvs::InvalidParameterError(
+      "Window convolution dimension must be 1 or 2: `ndim` = %d.", ndim
+    );
+  }
+  if (nmultipoles <= 0 || nmultipoles_Z <= 0) {
+    throw trvs::InvalidParameterError(
+      "Number of multipoles must be positive."
+    );
+  }
+  if (nsamp_in <= 0 || nsamp <= 0 || nsamp_out <= 0) {
+    throw trvs::InvalidParameterError(
+      "Number of sample points must be positive."
+    );
+  }
+
+  this->ndim = ndim;
+  this->nmultipoles = nmultipoles;
+  this->nmultipoles_Z = nmultipoles_Z;
+  this->nsamp_in = nsamp_in;
+  this->nsamp = nsamp;
+  this->nsamp_out = nsamp_out;
+  this->threaded = threaded;
+
+  this->size_common = (ndim == 1)
+    ? std::size_t(nsamp) : std::size_t(nsamp) * nsamp;
+
+  if (coupling.size() != this->size_common * nmultipoles * nmultipoles_Z) {
+    throw trvs::InvalidParameterError(
+      "Coupling plan size does not match the numbers of multipoles "
+      "and sample points."
+    );
+  }
+  this->coupling = std::move(coupling);
+
+  // Record non-vanishing couplings only.
+  this->couplings_Z.resize(nmultipoles);
+  for (int a = 0; a < nmultipoles; a++) {
+    for (int b = 0; b < nmultipoles_Z; b++) {
+      const double* coupling_ab = this->coupling.data()
+        + (std::size_t(a) * nmultipoles_Z + b) * this->size_common;
+      for (std::size_t p = 0; p < this->size_common; p++) {
+        if (coupling_ab[p] != 0.) {
+          this->couplings_Z[a].push_back(b);
+          break;
+        }
+      }
+    }
+  }
+
+  this->weights[0].resize(nmultipoles_Z);
+  this->weights[1].resize(nmultipoles);
+}
+
+void WinConvEngine::plan_transforms(
+  std::vector<int> degrees_Z, std::vector<int> degrees,
+  std::vector<double> sample_pts_in, std::vector<double> sample_pts,
+  double kr_c, bool lowring, int extrap, double extrap_exp, bool extrap2d
+) {
+  if (degrees_Z.size() != std::size_t(this->nmultipoles_Z) * this->ndim
+      || degrees.size() != std::size_t(this->nmultipoles) * this->ndim) {
+    throw trvs::InvalidParameterError(
+      "Transform degrees do not match the number of multipoles."
+    );
+  }
+  if (int(sample_pts_in.size()) != this->nsamp_in
+      || int(sample_pts.size()) != this->nsamp) {
+    throw trvs::InvalidParameterError(
+      "Transform sample points do not match the number of sample points."
+    );
+  }
+
+  this->extrap = trva::ExtrapOption(extrap);
+
+  const std::vector<int>* degrees_dir[2] = {&degrees_Z, &degrees};
+  std::vector<double>* sample_pts_dir[2] = {
+    &sample_pts_in, &sample_pts
+  };
+  std::vector< std::vector<double> >* post_sampts_dir[2] = {
+    &this->post_sampts_Z, &this->post_sampts
+  };
+
+  for (int idir = 0; idir < 2; idir++) {
+    std::vector<double>& sampts = *sample_pts_dir[idir];
+    int N = sampts.size();
+    int nmultipoles_dir = degrees_dir[idir]->size() / this->ndim;
+
+    this->transforms_1d[idir].clear();
+    this->transforms_2d[idir].clear();
+    this->post_factors[idir].clear();
+    post_sampts_dir[idir]->clear();
+
+    if (this->ndim == 2) {
+      for (int i = 0; i < nmultipoles_dir; i++) {
+        this->transforms_2d[idir].emplace_back(
+          new trvm::DoubleSphericalBesselTransform(
+            (*degrees_dir[idir])[2*i], (*degrees_dir[idir])[2*i + 1], 0, 0,
+            this->threaded
+          )
+        );
+        this->transforms_2d[idir].back()->initialise(
+          sampts, kr_c, lowring, extrap, extrap_exp, extrap2d
+        );
+        post_sampts_dir[idir]->push_back(
+          this->transforms_2d[idir].back()->post_sampts
+        );
+      }
+      continue;
+    }
+
+    // Extend the sample points for any extrapolation, which is performed
+    // here rather than natively in the 1-d transforms.
+    std::vector<double> sampts_trans = sampts;
+    if (this->extrap != trva::ExtrapOption::NONE) {
+      if (N % 2 != 0) {
+        throw trvs::InvalidParameterError(
+          "The number of sample points must be even for extrapolation."
+        );
+      }
+      int N_trans = std::pow(2, std::ceil(std::log2(extrap_exp * N)));
+      if (N_trans < N) {
+        throw trvs::InvalidParameterError(
+          "The sample size expansion factor results in a shrunken "
+          "sample size."
+        );
+      }
+      this->n_ext[idir] = (N_trans - N) / 2;
+      trva::extrap_loglin(sampts, this->n_ext[idir], sampts_trans);
+    } else {
+      this->n_ext[idir] = 0;
+    }
+
+    this->pre_factors[idir].resize(sampts_trans.size());
+    for (std::size_t j = 0; j < sampts_trans.size(); j++) {
+      this->pre_factors[idir][j] = std::pow(sampts_trans[j], 3./2);
+    }
+
+    for (int i = 0; i < nmultipoles_dir; i++) {
+      this->transforms_1d[idir].emplace_back(new trvm::HankelTransform(
+        (*degrees_dir[idir])[i] + 1./2, 0., this->threaded
+      ));
+      trvm::HankelTransform& ht = *this->transforms_1d[idir].back();
+      ht.initialise(sampts_trans, kr_c, lowring, trva::ExtrapOption::NONE);
+
+      std::vector<double> post_factors_i(ht.nsamp);
+      for (int j = 0; j < ht.nsamp; j++) {
+        post_factors_i[j] = std::pow(2*M_PI / ht.post_sampts[j], 3./2);
+      }
+      this->post_factors[idir].push_back(post_factors_i);
+
+      post_sampts_dir[idir]->emplace_back(
+        ht.post_sampts.begin() + this->n_ext[idir],
+        ht.post_sampts.begin() + this->n_ext[idir] + N
+      );
+    }
+  }
+
+  this->transformed = true;
+}
+
+void WinConvEngine::set_input_weights(
+  int imultipole_Z, std::vector<double> weights
+) {
+  if (imultipole_Z < 0 || imultipole_Z >= this->nmultipoles_Z) {
+    throw trvs::InvalidParameterError(
+      "Multipole index is out of range: %d.", imultipole_Z
+    );
+  }
+  if (!weights.empty()
+      && weights.size() != std::size_t(this->nsamp) * this->nsamp_in) {
+    throw trvs::InvalidParameterError(
+      "Input resampling weights do not match the numbers of "
+      "input and common sample points."
+    );
+  }
+  this->weights[0][imultipole_Z] =
+    band_weights(std::move(weights), this->nsamp_in);
+}
+
+void WinConvEngine::set_output_weights(
+  int imultipole, std::vector<double> weights
+) {
+  if (imultipole < 0 || imultipole >= this->nmultipoles) {
+    throw trvs::InvalidParameterError(
+      "Multipole index is out of range: %d.", imultipole
+    );
+  }
+  if (!weights.empty()
+      && weights.size() != std::size_t(this->nsamp_out) * this->nsamp) {
+    throw trvs::InvalidParameterError(
+      "Output resampling weights do not match the numbers of "
+      "common and output sample points."
+    );
+  }
+  this->weights[1][imultipole] =
+    band_weights(std::move(weights), this->nsamp);
+}
+
+void WinConvEngine::convolve(const double* in, double* out, bool on_grid) {
+  std::size_t size_in = (this->ndim == 1)
+    ? std::size_t(this->nsamp_in)
+    : std::size_t(this->nsamp_in) * this->nsamp_in;
+  std::size_t size_out = (this->ndim == 1)
+    ? std::size_t(this->nsamp_out)
+    : std::size_t(this->nsamp_out) * this->nsamp_out;
+  std::size_t size_common = this->size_common;
+
+  // Transform and resample unwindowed multipoles onto the common
+  // sample points.
+  const double* samples_Z = in;
+  if (!on_grid) {
+    if (this->transformed) {
+      this->trans_buffer_Z.resize(size_in * this->nmultipoles_Z);
+      for (int b = 0; b < this->nmultipoles_Z; b++) {
+        this->transform(
+          0, b, in + b * size_in, this->trans_buffer_Z.data() + b * size_in
+        );
+      }
+      samples_Z = this->trans_buffer_Z.data();
+    }
+
+    this->common_buffer_Z.resize(size_common * this->nmultipoles_Z);
+    for (int b = 0; b < this->nmultipoles_Z; b++) {
+      const double* samples_b = samples_Z + b * size_in;
+      double* common_b = this->common_buffer_Z.data() + b * size_common;
+      if (!this->weights[0][b].values.empty()) {
+        this->resample(
+          this->weights[0][b], this->nsamp_in, this->nsamp,
+          samples_b, common_b
+        );
+      } else if (this->nsamp_in == this->nsamp) {
+        std::memcpy(common_b, samples_b, size_common * sizeof(double));
+      } else {
+        throw std::runtime_error(
+          "Input resampling weights are unset for unwindowed multipole "
+          "index " + std::to_string(b) + "."
+        );
+      }
+    }
+    samples_Z = this->common_buffer_Z.data();
+  }
+
+  // Multiply by the coupling plan.
+  this->conv_buffer.resize(size_common * this->nmultipoles);
+
+  int nmultipoles_Z = this->nmultipoles_Z;
+  const double* coupling = this->coupling.data();
+  double* conv = this->conv_buffer.data();
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for if(this->threaded)
+#endif  // TRV_USE_OMP
+  for (std::size_t p = 0; p < size_common; p++) {
+    for (int a = 0; a < this->nmultipoles; a++) {
+      const double* coupling_a =
+        coupling + std::size_t(a) * nmultipoles_Z * size_common;
+      double conv_ap = 0.;
+      for (int b : this->couplings_Z[a]) {
+        conv_ap += coupling_a[b * size_common + p]
+          * samples_Z[b * size_common + p];
+      }
+      conv[a * size_common + p] = conv_ap;
+    }
+  }
+
+  // Transform and resample windowed multipoles onto the output
+  // sample points.
+  const double* samples = conv;
+  if (this->transformed) {
+    this->trans_buffer.resize(size_common * this->nmultipoles);
+    for (int a = 0; a < this->nmultipoles; a++) {
+      this->transform(
+        1, a, conv + a * size_common,
+        this->trans_buffer.data() + a * size_common
+      );
+    }
+    samples = this->trans_buffer.data();
+  }
+
+  for (int a = 0; a < this->nmultipoles; a++) {
+    const double* samples_a = samples + a * size_common;
+    double* out_a = out + a * size_out;
+    if (!this->weights[1][a].values.empty()) {
+      this->resample(
+        this->weights[1][a], this->nsamp, this->nsamp_out, samples_a, out_a
+      );
+    } else if (this->nsamp == this->nsamp_out) {
+      std::memcpy(out_a, samples_a, size_common * sizeof(double));
+    } else {
+      throw std::runtime_error(
+        "Output resampling weights are unset for windowed multipole "
+        "index " + std::to_string(a) + "."
+      );
+    }
+  }
+}
+
+void WinConvEngine::transform(
+  int idir, int imultipole, const double* in, double* out
+) {
+  if (this->ndim == 2) {
+    this->transforms_2d[idir][imultipole]->biased_transform(in, out);
+    return;
+  }
+
+  // STYLE: Standard naming convention is not followed below.
+  int N = (idir == 0) ? this->nsamp_in : this->nsamp;
+  int N_ext = this->n_ext[idir];
+  int N_trans = N + 2 * N_ext;
+
+  this->pre_buffer.resize(N_trans);
+  this->post_buffer.resize(N_trans);
+
+  const std::vector<double>& pre_factors = this->pre_factors[idir];
+  if (this->extrap != trva::ExtrapOption::NONE) {
+    std::vector<double> a(in, in + N);
+    std::vector<double> a_ext;
+    trva::extrap_by_option(a, N_ext, this->extrap, a_ext);
+    for (int j = 0; j < N_trans; j++) {
+      this->pre_buffer[j] = a_ext[j] * pre_factors[j];
+    }
+  } else {
+    for (int j = 0; j < N_trans; j++) {
+      this->pre_buffer[j] = in[j] * pre_factors[j];
+    }
+  }
+
+  this->transforms_1d[idir][imultipole]->biased_transform_batch(
+    1, this->pre_buffer.data(), this->post_buffer.data()
+  );
+
+  // Trim any extrapolation.
+  const std::vector<double>& post_factors =
+    this->post_factors[idir][imultipole];
+  for (int j = 0; j < N; j++) {
+    out[j] = this->post_buffer[j + N_ext] * post_factors[j + N_ext];
+  }
+}
+
+WinConvEngine::ResamplingWeights WinConvEngine::band_weights(
+  std::vector<double> weights, int nsamp_from
+) {
+  ResamplingWeights banded;
+  banded.values = std::move(weights);
+  if (banded.values.empty()) {
+    return banded;
+  }
+
+  // Band off weights negligible relative to the largest in each row,
+  // e.g. those of a cubic spline, which decay away from the diagonal.
+  const double eps = std::numeric_limits<double>::epsilon();
+
+  int nsamp_to = banded.values.size() / nsamp_from;
+  banded.begins.resize(nsamp_to);
+  banded.ends.resize(nsamp_to);
+  for (int i = 0; i < nsamp_to; i++) {
+    const double* w_i = banded.values.data() + std::size_t(i) * nsamp_from;
+
+    double w_max = 0.;
+    for (int j = 0; j < nsamp_from; j++) {
+      w_max = std::max(w_max, std::abs(w_i[j]));
+    }
+
+    int j_begin = 0;
+    int j_end = nsamp_from;
+    while (j_begin < j_end && std::abs(w_i[j_begin]) <= eps * w_max) {
+      j_begin++;
+    }
+    while (j_end > j_begin && std::abs(w_i[j_end - 1]) <= eps * w_max) {
+      j_end--;
+    }
+    banded.begins[i] = j_begin;
+    banded.ends[i] = j_end;
+  }
+
+  return banded;
+}
+
+void WinConvEngine::resample(
+  const ResamplingWeights& weights, int nsamp_from, int nsamp_to,
+  const double* in, double* out
+) {
+  const double* w = weights.values.data();
+  const int* begins = weights.begins.data();
+  const int* ends = weights.ends.data();
+
+  if (this->ndim == 1) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for if(this->threaded)
+#endif  // TRV_USE_OMP
+    for (int i = 0; i < nsamp_to; i++) {
+      const double* w_i = w + std::size_t(i) * nsamp_from;
+      double out_i = 0.;
+      for (int j = begins[i]; j < ends[i]; j++) {
+        out_i += w_i[j] * in[j];
+      }
+      out[i] = out_i;
+    }
+    return;
+  }
+
+  // Resample along columns and then along rows, i.e. W · in · W^T.
+  this->resamp_buffer.resize(std::size_t(nsamp_to) * nsamp_from);
+  double* inter = this->resamp_buffer.data();
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for if(this->threaded)
+#endif  // TRV_USE_OMP
+  for (int i = 0; i < nsamp_to; i++) {
+    const double* w_i = w + std::size_t(i) * nsamp_from;
+    double* inter_i = inter + std::size_t(i) * nsamp_from;
+    std::fill(inter_i, inter_i + nsamp_from, 0.);
+    for (int j = begins[i]; j < ends[i]; j++) {
+      const double* in_j = in + std::size_t(j) * nsamp_from;
+      for (int k = 0; k < nsamp_from; k++) {
+        inter_i[k] += w_i[j] * in_j[k];
+      }
+    }
+  }
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(2) if(this->threaded)
+#endif  // TRV_USE_OMP
+  for (int i = 0; i < nsamp_to; i++) {
+    for (int l = 0; l < nsamp_to; l++) {
+      const double* inter_i = inter + std::size_t(i) * nsamp_from;
+      const double* w_l = w + std::size_t(l) * nsamp_from;
+      double out_il = 0.;
+      for (int k = begins[l]; k < ends[l]; k++) {
+        out_il += inter_i[k] * w_l[k];
+      }
+      out[std::size_t(i) * nsamp_to + l] = out_il;
+    }
+  }
+}
+
+}  // namespace trv
@@ -383,6 +383,7 @@ def _compute_3pt_stats_survey_like(threept_algofunc,
                                    paramset=None, params_sampling=None,
                                    degrees=None, binning=None,
                                    form=None, idx_bin=None, types=None,
+                                   field_cache=None,
                                    save=False, logger=None):
     """Compute three-point statistics from survey-like data and random
     catalogues in the local plane-parallel approximation.
@@ -395,14 +396,18 @@ def _compute_3pt_stats_survey_like(threept_algofunc,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     paramset : :class:`~triumvirate.parameters.ParameterSet`, optional
         Full parameter set.  If `None` (default), `degrees`, `binning`,
         `form` and `params_sampling` should be provided; `idx_bin`
@@ -452,6 +457,14 @@ def _compute_3pt_stats_survey_like(threept_algofunc,
     types : dict, optional
         'catalogue_type' and 'statistic_type' values (default is `None`).
         This should be set by the caller of this function.
+    field_cache : :class:`~triumvirate.fieldmesh.MeshFieldCache`, optional
+        Mesh field cache shared by measurements with different
+        data-source catalogues but the same random-source catalogue
+        (default is `None`).  See
+        :class:`~triumvirate.fieldmesh.MeshFieldCache` for details.
+
+        .. versionadded:: 0.4.0
+
     save : {'.txt', '.npz', False}, optional
         If not `False` (default), save the measurements as a '.txt' file
         or in '.npz' format.  The save path is determined from `paramset`
@@ -511,24 +524,29 @@ def _compute_3pt_stats_survey_like(threept_algofunc,
         logger.info("Binning has been initialised.")
 
     # Set up lines of sight.
-    if los_data is None:
-        los_data = catalogue_data.compute_los()
-    if los_rand is None:
-        los_rand = catalogue_rand.compute_los()
-
-    los_data = np.ascontiguousarray(los_data)
-    los_rand = np.ascontiguousarray(los_rand)
+    if los_data is not None:
+        los_data = np.ascontiguousarray(los_data, dtype=float)
+    if los_rand is not None:
+        los_rand = np.ascontiguousarray(los_rand, dtype=float)
 
     if logger:
         logger.info("Lines of sight have been initialised.")
 
-    # Set up box alignment.
-    if paramset['alignment'] == 'centre':
+    # Set up box alignment.  With a bound mesh field cache, the
+    # random-source catalogue is already aligned and only the
+    # data-source catalogue is offset into its frame.
+    cache_bound = field_cache is not None \
+        and field_cache._bind(catalogue_rand, paramset)
+    if cache_bound:
+        catalogue_data.offset_coords(
+            catalogue_data._observer - catalogue_rand._observer
+        )
+    elif paramset['alignment'] == 'centre':
         catalogue_data.centre(
             [paramset['boxsize'][ax] for ax in ['x', 'y', 'z']],
             catalogue_ref=catalogue_rand
         )
-    if paramset['alignment'] == 'pad':
+    elif paramset['alignment'] == 'pad':
         if paramset['padscale'] == 'box':
             kwargs = {'boxsize_pad': paramset['padfactor']}
         if paramset['padscale'] == 'grid':
@@ -575,9 +593,15 @@ def _compute_3pt_stats_survey_like(threept_algofunc,
     norm_factor_part = _calc_bispec_normalisation_from_particles(
         particles_rand, alpha
     )
-    norm_factor_mesh = _calc_bispec_normalisation_from_mesh(
-        particles_rand, paramset, alpha
-    )
+    if field_cache is not None:
+        norm_factor_mesh = field_cache._get_norm_factor_mesh_unit(
+            '3pt', _calc_bispec_normalisation_from_mesh,
+            particles_rand, paramset
+        ) / alpha**3
+    else:
+        norm_factor_mesh = _calc_bispec_normalisation_from_mesh(
+            particles_rand, paramset, alpha
+        )
     norm_factor_meshes = 0.
 
     if paramset['norm_convention'] == 'none':
@@ -622,7 +646,11 @@ def _compute_3pt_stats_survey_like(threept_algofunc,
 
     results = threept_algofunc(
         particles_data, particles_rand, los_data, los_rand,
-        paramset, binning, norm_factor
+        paramset, binning, norm_factor,
+        field_cache=(
+            field_cache._get_cpp_cache(particles_rand)
+            if field_cache is not None else None
+        )
     )
 
     if logger:
@@ -674,6 +702,7 @@ def compute_bispec(catalogue_data, catalogue_rand,
                    degrees=None, binning=None, form=None, idx_bin=None,
                    sampling_params=None,
                    paramset=None,
+                   field_cache=None,
                    save=False, logger=None):
     """Compute bispectrum from survey-like data and random catalogues
     in the local plane-parallel approximation.
@@ -684,14 +713,18 @@ def compute_bispec(catalogue_data, catalogue_rand,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degrees : tuple of (int, int, int) or str of length 3, optional
         Multipole degrees either as a tuple ('ell1', 'ell2', 'ELL') or
         as a string of length 3.  If not `None` (default), this will
@@ -737,6 +770,14 @@ def compute_bispec(catalogue_data, catalogue_rand,
     paramset : :class:`~triumvirate.parameters.ParameterSet`, optional
         Full parameter set (default is `None`).  This is used in lieu of
         `degrees`, `binning`, `form`, `idx_bin` or `sampling_params`.
+    field_cache : :class:`~triumvirate.fieldmesh.MeshFieldCache`, optional
+        Mesh field cache shared by measurements with different
+        data-source catalogues but the same random-source catalogue
+        (default is `None`).  See
+        :class:`~triumvirate.fieldmesh.MeshFieldCache` for details.
+
+        .. versionadded:: 0.4.0
+
     save : {'.txt', '.npz', False}, optional
         If not `False` (default), save the measurements as a '.txt' file
         or in '.npz' format.  The save path is determined from `paramset`
@@ -758,7 +799,14 @@ def compute_bispec(catalogue_data, catalogue_rand,
           of the first and second wavenumbers;
         - 'bk_raw': bispectrum raw measurements including any
           specified normalisation and shot noise;
-        - 'bk_shot': bispectrum shot noise.
+        - 'bk_shot': bispectrum shot noise;
+        - 'profile': stage profile of the measurement, with each
+          stage ('assignment', 'fft', 'binning', 'shell_fill',
+          'reduction', 'shotnoise' etc.) mapped to its call count
+          ('ncalls'), wall time with and without nested stages in
+          seconds ('time_total', 'time_self'), estimated data touched
+          and peak memory usage in gibibytes ('gbytes', 'gbytes_mem')
+          and thread count ('nthreads').
 
         The effective wavenumber is here defined as the average wavenumber
         in each bin.
@@ -788,6 +836,7 @@ def compute_bispec(catalogue_data, catalogue_rand,
         paramset=paramset, params_sampling=sampling_params,
         degrees=degrees, binning=binning, form=form, idx_bin=idx_bin,
         types={'catalogue_type': 'survey', 'statistic_type': 'bispec'},
+        field_cache=field_cache,
         save=save, logger=logger
     )
 
@@ -799,6 +848,7 @@ def compute_3pcf(catalogue_data, catalogue_rand,
                  degrees=None, binning=None, form=None, idx_bin=None,
                  sampling_params=None,
                  paramset=None,
+                 field_cache=None,
                  save=False, logger=None):
     """Compute three-point correlation function from survey-like
     data and random catalogues in the local plane-parallel approximation.
@@ -809,14 +859,18 @@ def compute_3pcf(catalogue_data, catalogue_rand,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degrees : tuple of (int, int, int) or str of length 3, optional
         Multipole degrees either as a tuple ('ell1', 'ell2', 'ELL') or
         as a string of length 3.  If not `None` (default), this will
@@ -862,6 +916,14 @@ def compute_3pcf(catalogue_data, catalogue_rand,
     paramset : :class:`~triumvirate.parameters.ParameterSet`, optional
         Full parameter set (default is `None`).  This is used in lieu of
         `degrees`, `binning`, `form`, `idx_bin` or `sampling_params`.
+    field_cache : :class:`~triumvirate.fieldmesh.MeshFieldCache`, optional
+        Mesh field cache shared by measurements with different
+        data-source catalogues but the same random-source catalogue
+        (default is `None`).  See
+        :class:`~triumvirate.fieldmesh.MeshFieldCache` for details.
+
+        .. versionadded:: 0.4.0
+
     save : {'.txt', '.npz', False}, optional
         If not `False` (default), save the measurements as a '.txt' file
         or in '.npz' format.  The save path is determined from `paramset`
@@ -883,7 +945,14 @@ def compute_3pcf(catalogue_data, catalogue_rand,
           of the first and second separations;
         - 'zeta_raw': three-point correlation function raw measurements
           including any specified normalisation and shot noise;
-        - 'zeta_shot': three-point correlation function shot noise.
+        - 'zeta_shot': three-point correlation function shot noise;
+        - 'profile': stage profile of the measurement, with each
+          stage ('assignment', 'fft', 'binning', 'shell_fill',
+          'reduction', 'shotnoise' etc.) mapped to its call count
+          ('ncalls'), wall time with and without nested stages in
+          seconds ('time_total', 'time_self'), estimated data touched
+          and peak memory usage in gibibytes ('gbytes', 'gbytes_mem')
+          and thread count ('nthreads').
 
         The effective separation is here defined as the average separation
         in each bin.
@@ -900,6 +969,7 @@ def compute_3pcf(catalogue_data, catalogue_rand,
         paramset=paramset, params_sampling=sampling_params,
         degrees=degrees, binning=binning, form=form, idx_bin=idx_bin,
         types={'catalogue_type': 'survey', 'statistic_type': '3pcf'},
+        field_cache=field_cache,
         save=save, logger=logger
     )
 
@@ -1522,7 +1592,14 @@ def compute_bispec_in_gpp_box(catalogue_data,
           of the first and second wavenumbers;
         - 'bk_raw': bispectrum raw measurements including any
           specified normalisation and shot noise;
-        - 'bk_shot': bispectrum shot noise.
+        - 'bk_shot': bispectrum shot noise;
+        - 'profile': stage profile of the measurement, with each
+          stage ('assignment', 'fft', 'binning', 'shell_fill',
+          'reduction', 'shotnoise' etc.) mapped to its call count
+          ('ncalls'), wall time with and without nested stages in
+          seconds ('time_total', 'time_self'), estimated data touched
+          and peak memory usage in gibibytes ('gbytes', 'gbytes_mem')
+          and thread count ('nthreads').
 
         The effective wavenumber is here defined as the average wavenumber
         in each bin.
@@ -1624,7 +1701,14 @@ def compute_3pcf_in_gpp_box(catalogue_data,
           of the first and second separations;
         - 'zeta_raw': three-point correlation function raw measurements
           including any specified normalisation and shot noise;
-        - 'zeta_shot': three-point correlation function shot noise.
+        - 'zeta_shot': three-point correlation function shot noise;
+        - 'profile': stage profile of the measurement, with each
+          stage ('assignment', 'fft', 'binning', 'shell_fill',
+          'reduction', 'shotnoise' etc.) mapped to its call count
+          ('ncalls'), wall time with and without nested stages in
+          seconds ('time_total', 'time_self'), estimated data touched
+          and peak memory usage in gibibytes ('gbytes', 'gbytes_mem')
+          and thread count ('nthreads').
 
         The effective separation is here defined as the average separation
         in each bin.
@@ -1664,10 +1748,12 @@ def compute_3pcf_window(catalogue_rand, los_rand=None,
     ----------
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degrees : tuple of (int, int, int) or str of length 3, optional
         Multipole degrees either as a tuple ('ell1', 'ell2', 'ELL') or
         as a string of length 3.  If not `None` (default), this will
@@ -1739,7 +1825,14 @@ def compute_3pcf_window(catalogue_rand, los_rand=None,
           of the first and second separations;
         - 'zeta_raw': three-point correlation function raw measurements
           including any specified normalisation and shot noise;
-        - 'zeta_shot': three-point correlation function shot noise.
+        - 'zeta_shot': three-point correlation function shot noise;
+        - 'profile': stage profile of the measurement, with each
+          stage ('assignment', 'fft', 'binning', 'shell_fill',
+          'reduction', 'shotnoise' etc.) mapped to its call count
+          ('ncalls'), wall time with and without nested stages in
+          seconds ('time_total', 'time_self'), estimated data touched
+          and peak memory usage in gibibytes ('gbytes', 'gbytes_mem')
+          and thread count ('nthreads').
 
         The effective separation is here defined as the average separation
         in each bin.
@@ -1783,9 +1876,8 @@ def compute_3pcf_window(catalogue_rand, los_rand=None,
         logger.info("Binning has been initialised.")
 
     # Set up lines of sight.
-    if los_rand is None:
-        los_rand = catalogue_rand.compute_los()
-    los_rand = np.ascontiguousarray(los_rand)
+    if los_rand is not None:
+        los_rand = np.ascontiguousarray(los_rand, dtype=float)
 
     if logger:
         logger.info("Lines of sight have been initialised.")
@@ -19,14 +19,13 @@ import numpy as np
 from scipy.interpolate import InterpolatedUnivariateSpline, RectBivariateSpline
 
 from ._arrayops import (
+    _extrap2d_row_lin,
+    _extrap2d_row_loglin,
     extrap_lin,
     extrap_loglin,
     extrap_pad,
-    extrap2d_lin,
-    extrap2d_loglin,
-    extrap2d_pad,
 )
-from ._fftlog import HankelTransform
+from ._fftlog import HankelTransform, _DoubleSphericalBesselTransform
 
 
 class SphericalBesselTransform:
@@ -194,6 +193,40 @@ class SphericalBesselTransform:
 
         return post_sampts, post_samples
 
+    def transform_batch(self, pre_samples):
+        """Transform a batch of samples at initialised sample points.
+
+        Parameters
+        ----------
+        pre_samples : array_like
+            Pre-transform samples in 2-d, one row per sample array.
+            Assumed to be real if extrapolation is used.
+
+        Returns
+        -------
+        post_sampts : array_like
+            Post-transform sample points.
+        post_samples : array_like
+            Post-transform samples in 2-d, real if `pre_samples` is
+            real.
+
+        """
+        pre_samples = np.asarray(pre_samples)
+
+        if self._extrap_layer == 'outer':
+            pre_samples = self._perform_extrap_rows(pre_samples)
+
+        pre_samples = pre_samples * self._pre_sampts ** (3./2)
+
+        post_sampts, post_samples = self._fbht.transform_batch(pre_samples)
+
+        post_sampts = post_sampts[self._post_slice]
+        post_samples = post_samples[:, self._post_slice]
+
+        post_samples *= (2*np.pi / self._post_sampts) ** (3./2)
+
+        return post_sampts, post_samples
+
     def transform_cosmo_multipoles(self, direction, pre_samples):
         """Transform cosmological multipoles between configuration and
         Fourier spaces.
@@ -253,6 +286,33 @@ class SphericalBesselTransform:
             return extrap_loglin(arr, self._n_ext)
         return arr
 
+    def _perform_extrap_rows(self, arr):
+        """Perform extrapolation along each row according to interal
+        attributes.
+
+        Parameters
+        ----------
+        arr : array_like
+            2-d array to extrapolate.
+
+        Returns
+        -------
+        array_like
+            Extrapolated 2-d array.
+
+        """
+        if self._extrap == 1:
+            return np.c_[
+                np.repeat(arr[:, [0]], self._n_ext, axis=1),
+                arr,
+                np.repeat(arr[:, [-1]], self._n_ext, axis=1),
+            ]
+        if self._extrap == 2:
+            return _extrap2d_row_lin(arr, self._n_ext)
+        if self._extrap == 3:
+            return _extrap2d_row_loglin(arr, self._n_ext)
+        return arr
+
 
 class DoubleSphericalBesselTransform:
     """Double spherical Bessel Transform.
@@ -293,8 +353,8 @@ class DoubleSphericalBesselTransform:
     extrap2d : bool, optional
         If `True` (default is `False`), perform 2-d extrapolation
         pre-transform excluding any pre-factors; otherwise, perform 1-d
-        extrapolation including any pre-factors within the underlying
-        FFTLog algorithm.
+        extrapolation excluding any pre-factors for each row and column
+        in its transform pass.
     threaded : bool, optional
         If `True` (default is `False`), use the multi-threaded FFTLog
         algorithm.
@@ -318,10 +378,6 @@ class DoubleSphericalBesselTransform:
         When the input sample size is not even and extrapolation is used.
 
     """
-    # Representative transform, either vertical (0, across rows)
-    # or horizontal (1, across columns).
-    _rep = 0
-
     def __init__(self, degrees, biases, sample_pts, pivot=1., lowring=True,
                  extrap=0, extrap_exp=2., extrap2d=False, threaded=False):
         if extrap not in {0, 1, 2, 3}:
@@ -336,56 +392,37 @@ class DoubleSphericalBesselTransform:
         self._extrap = extrap
         self._extrap2d = extrap2d
 
-        if self._extrap:
-            if (nsamp := len(sample_pts)) % 2:
-                raise ValueError(
-                    "Input sample size must be even when extrapolation "
-                    f"is used: {len(sample_pts)=}."
-                )
-            if not self._extrap2d:
-                extrap_native = self._extrap
-                self._n_ext = 0
-            else:
-                extrap_native = 0
-                nsamp_trans = int(2 ** np.ceil(np.log2(extrap_exp * nsamp)))
-                self._n_ext = (nsamp_trans - nsamp) // 2
-                sample_pts = extrap_loglin(sample_pts, self._n_ext)
-        else:
-            self._n_ext = 0
-            extrap_native = 0
-
-        self._fbsjt = tuple(
-            SphericalBesselTransform(
-                degree_, bias_, sample_pts,
-                pivot=pivot, lowring=lowring,
-                extrap=extrap_native, extrap_exp=extrap_exp,
-                threaded=threaded
+        if self._extrap and len(sample_pts) % 2:
+            raise ValueError(
+                "Input sample size must be even when extrapolation "
+                f"is used: {len(sample_pts)=}."
             )
-            for (degree_, bias_) in zip(degrees, biases)
-        )
 
-        self._post_slice = slice(self._n_ext, -self._n_ext) if self._n_ext \
-            else slice(None)
+        # Both transform passes are performed in compiled code.
+        self._fbdsjt = _DoubleSphericalBesselTransform(
+            degrees, biases, sample_pts,
+            kr_c=pivot, lowring=lowring,
+            extrap=extrap, extrap_exp=extrap_exp, extrap2d=extrap2d,
+            threaded=threaded
+        )
 
-        self._logres = self._fbsjt[self._rep]._logres
-        self._pre_sampts = np.asarray(self._fbsjt[self._rep]._pre_sampts)
-        self._post_sampts = np.asarray(self._fbsjt[self._rep]._post_sampts)[
-            self._post_slice
-        ]
+        self._logres = self._fbdsjt._logres
+        self._pre_sampts = np.asarray(self._fbdsjt._pre_sampts)
+        self._post_sampts = np.asarray(self._fbdsjt._post_sampts)
 
     @property
     def size(self):
         """Sample size of the transform.
 
         """
-        return self._fbsjt[self._rep].size
+        return self._fbdsjt._nsamp_trans
 
     @property
     def pivot(self):
         """Pivot value.
 
         """
-        return self._fbsjt[self._rep]._pivot
+        return self._fbdsjt._pivot
 
     def transform(self, pre_samples):
         """Transform samples at initialised sample points.
@@ -403,21 +440,7 @@ class DoubleSphericalBesselTransform:
             `post_sampts` in :func:`numpy.meshgrid` 'ij'-indexing format.
 
         """
-        if self._extrap2d:
-            pre_samples = self._perform_extrap(pre_samples)
-
-        inter_samples = []
-        for pre_samples_row in pre_samples:
-            _, inter_samples_row = self._fbsjt[1].transform(pre_samples_row)
-            inter_samples.append(inter_samples_row)
-
-        post_samples_T = []
-        for inter_samples_col in np.asarray(inter_samples).T:
-            _, post_samples_col = self._fbsjt[0].transform(inter_samples_col)
-            post_samples_T.append(post_samples_col)
-
-        post_samples = np.asarray(post_samples_T).T
-        post_samples = post_samples[self._post_slice, self._post_slice]
+        post_samples = self._fbdsjt.transform(pre_samples).astype(complex)
 
         post_sampts = np.meshgrid(
             self._post_sampts, self._post_sampts, indexing='ij'
@@ -463,31 +486,6 @@ class DoubleSphericalBesselTransform:
 
         return post_sampts, post_samples
 
-    def _perform_extrap(self, arr):
-        """Perform extrapolation according to interal attributes.
-
-        Parameters
-        ----------
-        arr : array_like
-            2-d array to extrapolate.
-
-        Returns
-        -------
-        array_like
-            Extrapolated 2-d array.
-
-        """
-        arr = np.asarray(arr)
-        if self._extrap == 1:
-            return extrap2d_pad(
-                arr, self._n_ext, arr[:, 0], arr[:, -1], arr[0, :], arr[-1, :]
-            )
-        if self._extrap == 2:
-            return extrap2d_lin(arr, self._n_ext)
-        if self._extrap == 3:
-            return extrap2d_loglin(arr, self._n_ext)
-        return arr
-
 
 def resample_lglin(sampts, samples, size=None, spline=3):
     """Resample at logarithmically spaced sample points in 1- or 2-d.
@@ -16,6 +16,7 @@ Global plane-parallel estimators
 
 .. autosummary::
     compute_powspec_in_gpp_box
+    compute_powspec_kmu_in_gpp_box
     compute_corrfunc_in_gpp_box
 
 Window function estimator
@@ -39,6 +40,7 @@ from ._twopt import (
     _compute_corrfunc_window,
     _compute_powspec,
     _compute_powspec_in_gpp_box,
+    _compute_powspec_kmu_in_gpp_box,
 )
 from .dataobjs import Binning
 from .parameters import (
@@ -73,7 +75,7 @@ def _amalgamate_parameters(paramset=None, params_sampling=None,
         - 'boxsize': sequence of [float, float, float];
         - 'ngrid': sequence of [int, int, int];
         - 'assignment': {'ngp', 'cic', 'tsc', 'pcs'};
-        - 'interlace': bool;
+        - 'interlace': bool or int;
 
         and exactly one of the following only when 'alignment' is 'pad'---
 
@@ -320,6 +322,7 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
                                    los_data=None, los_rand=None,
                                    paramset=None, params_sampling=None,
                                    degree=None, binning=None, types=None,
+                                   field_cache=None,
                                    save=False, logger=None):
     """Compute two-point statistics from survey-like data and random
     catalogues in the local plane-parallel approximation.
@@ -332,14 +335,18 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     paramset : :class:`~triumvirate.parameters.ParameterSet`, optional
         Full parameter set.  If `None` (default), `degree`, `binning`
         and `params_sampling` must be provided.
@@ -351,7 +358,7 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
         - 'boxsize': sequence of [float, float, float];
         - 'ngrid': sequence of [int, int, int];
         - 'assignment': {'ngp', 'cic', 'tsc', 'pcs'};
-        - 'interlace': bool;
+        - 'interlace': bool or int;
 
         and exactly one of the following only when 'alignment' is 'pad'---
 
@@ -369,6 +376,14 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
     types : dict, optional
         'catalogue_type' and 'statistic_type' values (default is `None`).
         This should be set by the caller of this function.
+    field_cache : :class:`~triumvirate.fieldmesh.MeshFieldCache`, optional
+        Mesh field cache shared by measurements with different
+        data-source catalogues but the same random-source catalogue
+        (default is `None`).  See
+        :class:`~triumvirate.fieldmesh.MeshFieldCache` for details.
+
+        .. versionadded:: 0.4.0
+
     save : {'.txt', '.npz', False}, optional
         If not `False` (default), save the measurements as a '.txt' file
         or in '.npz' format. The save path is determined from `paramset`
@@ -434,24 +449,29 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
         logger.info("Binning has been initialised.")
 
     # Set up lines of sight.
-    if los_data is None:
-        los_data = catalogue_data.compute_los()
-    if los_rand is None:
-        los_rand = catalogue_rand.compute_los()
-
-    los_data = np.ascontiguousarray(los_data)
-    los_rand = np.ascontiguousarray(los_rand)
+    if los_data is not None:
+        los_data = np.ascontiguousarray(los_data, dtype=float)
+    if los_rand is not None:
+        los_rand = np.ascontiguousarray(los_rand, dtype=float)
 
     if logger:
         logger.info("Lines of sight have been initialised.")
 
-    # Set up box alignment.
-    if paramset['alignment'] == 'centre':
+    # Set up box alignment.  With a bound mesh field cache, the
+    # random-source catalogue is already aligned and only the
+    # data-source catalogue is offset into its frame.
+    cache_bound = field_cache is not None \
+        and field_cache._bind(catalogue_rand, paramset)
+    if cache_bound:
+        catalogue_data.offset_coords(
+            catalogue_data._observer - catalogue_rand._observer
+        )
+    elif paramset['alignment'] == 'centre':
         catalogue_data.centre(
             [paramset['boxsize'][ax] for ax in ['x', 'y', 'z']],
             catalogue_ref=catalogue_rand
         )
-    if paramset['alignment'] == 'pad':
+    elif paramset['alignment'] == 'pad':
         if paramset['padscale'] == 'box':
             kwargs = {'boxsize_pad': paramset['padfactor']}
         if paramset['padscale'] == 'grid':
@@ -498,9 +518,15 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
     norm_factor_part = _calc_powspec_normalisation_from_particles(
         particles_rand, alpha
     )
-    norm_factor_mesh = _calc_powspec_normalisation_from_mesh(
-        particles_rand, paramset, alpha
-    )
+    if field_cache is not None:
+        norm_factor_mesh = field_cache._get_norm_factor_mesh_unit(
+            '2pt', _calc_powspec_normalisation_from_mesh,
+            particles_rand, paramset
+        ) / alpha**2
+    else:
+        norm_factor_mesh = _calc_powspec_normalisation_from_mesh(
+            particles_rand, paramset, alpha
+        )
     norm_factor_meshes = _calc_powspec_normalisation_from_meshes(
         particles_data, particles_rand, paramset, alpha,
         padding=PADDING, cellsize=CELLSIZE, assignment=ASSIGNMENT
@@ -548,7 +574,11 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
 
     results = twopt_algofunc(
         particles_data, particles_rand, los_data, los_rand,
-        paramset, binning, norm_factor
+        paramset, binning, norm_factor,
+        field_cache=(
+            field_cache._get_cpp_cache(particles_rand)
+            if field_cache is not None else None
+        )
     )
 
     if logger:
@@ -598,6 +628,7 @@ def compute_powspec(catalogue_data, catalogue_rand,
                     los_data=None, los_rand=None,
                     degree=None, binning=None, sampling_params=None,
                     paramset=None,
+                    field_cache=None,
                     save=False, logger=None):
     """Compute power spectrum from survey-like data and random catalogues
     in the local plane-parallel approximation.
@@ -608,14 +639,18 @@ def compute_powspec(catalogue_data, catalogue_rand,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degree : int, optional
         Multipole degree.  If not `None` (default), this will override
         ``paramset['degrees']['ELL']``.
@@ -630,7 +665,7 @@ def compute_powspec(catalogue_data, catalogue_rand,
         - 'boxsize': sequence of [float, float, float];
         - 'ngrid': sequence of [int, int, int];
         - 'assignment': {'ngp', 'cic', 'tsc', 'pcs'};
-        - 'interlace': bool;
+        - 'interlace': bool or int;
 
         and exactly one of the following only when 'alignment' is 'pad'---
 
@@ -642,6 +677,14 @@ def compute_powspec(catalogue_data, catalogue_rand,
     paramset : :class:`~triumvirate.parameters.ParameterSet`, optional
         Full parameter set (default is `None`).  This is used in lieu of
         `degree`, `binning` or `sampling_params`.
+    field_cache : :class:`~triumvirate.fieldmesh.MeshFieldCache`, optional
+        Mesh field cache shared by measurements with different
+        data-source catalogues but the same random-source catalogue
+        (default is `None`).  See
+        :class:`~triumvirate.fieldmesh.MeshFieldCache` for details.
+
+        .. versionadded:: 0.4.0
+
     save : {'.txt', '.npz', False}, optional
         If not `False` (default), save the measurements as a '.txt' file
         or in '.npz' format. The save path is determined from `paramset`
@@ -660,7 +703,14 @@ def compute_powspec(catalogue_data, catalogue_rand,
         - 'nmodes': number of wavevector modes in each bin;
         - 'pk_raw': power spectrum raw measurements including any
           specified normalisation and shot noise;
-        - 'pk_shot': power spectrum shot noise.
+        - 'pk_shot': power spectrum shot noise;
+        - 'profile': stage profile of the measurement, with each
+          stage ('assignment', 'fft', 'binning', 'shell_fill',
+          'reduction', 'shotnoise' etc.) mapped to its call count
+          ('ncalls'), wall time with and without nested stages in
+          seconds ('time_total', 'time_self'), estimated data touched
+          and peak memory usage in gibibytes ('gbytes', 'gbytes_mem')
+          and thread count ('nthreads').
 
         The effective wavenumber is here defined as the average wavenumber
         in each bin.
@@ -706,6 +756,7 @@ def compute_powspec(catalogue_data, catalogue_rand,
         paramset=paramset, params_sampling=sampling_params,
         degree=degree, binning=binning,
         types={'catalogue_type': 'survey', 'statistic_type': 'powspec'},
+        field_cache=field_cache,
         save=save, logger=logger
     )
 
@@ -716,6 +767,7 @@ def compute_corrfunc(catalogue_data, catalogue_rand,
                      los_data=None, los_rand=None,
                      degree=None, binning=None, sampling_params=None,
                      paramset=None,
+                     field_cache=None,
                      save=False, logger=None):
     """Compute correlation function from survey-like data and random
     catalogues in the local plane-parallel approximation.
@@ -726,14 +778,18 @@ def compute_corrfunc(catalogue_data, catalogue_rand,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degree : int, optional
         Multipole degree.  If not `None` (default), this will override
         ``paramset['degrees']['ELL']``.
@@ -748,7 +804,7 @@ def compute_corrfunc(catalogue_data, catalogue_rand,
         - 'boxsize': sequence of [float, float, float];
         - 'ngrid': sequence of [int, int, int];
         - 'assignment': {'ngp', 'cic', 'tsc', 'pcs'};
-        - 'interlace': bool;
+        - 'interlace': bool or int;
 
         and exactly one of the following only when 'alignment' is 'pad'---
 
@@ -760,6 +816,14 @@ def compute_corrfunc(catalogue_data, catalogue_rand,
     paramset : :class:`~triumvirate.parameters.ParameterSet`, optional
         Full parameter set (default is `None`).  This is used
         in lieu of `degree`, `binning` or `sampling_params`.
+    field_cache : :class:`~triumvirate.fieldmesh.MeshFieldCache`, optional
+        Mesh field cache shared by measurements with different
+        data-source catalogues but the same random-source catalogue
+        (default is `None`).  See
+        :class:`~triumvirate.fieldmesh.MeshFieldCache` for details.
+
+        .. versionadded:: 0.4.0
+
     save : {'.txt', '.npz', False}, optional
         If not `False` (default), save the measurements as a '.txt' file
         or in '.npz' format. The save path is determined from `paramset`
@@ -776,7 +840,14 @@ def compute_corrfunc(catalogue_data, catalogue_rand,
         - 'rbin': central separation for each bin;
         - 'reff': effective separation for each bin;
         - 'npairs': number of separation pairs in each bin;
-        - 'xi': two-point correlation function measurements.
+        - 'xi': two-point correlation function measurements;
+        - 'profile': stage profile of the measurement, with each
+          stage ('assignment', 'fft', 'binning', 'shell_fill',
+          'reduction', 'shotnoise' etc.) mapped to its call count
+          ('ncalls'), wall time with and without nested stages in
+          seconds ('time_total', 'time_self'), estimated data touched
+          and peak memory usage in gibibytes ('gbytes', 'gbytes_mem')
+          and thread count ('nthreads').
 
         The effective separation is here defined as the average separation
         in each bin.
@@ -799,6 +870,7 @@ def compute_corrfunc(catalogue_data, catalogue_rand,
         paramset=paramset, params_sampling=sampling_params,
         degree=degree, binning=binning,
         types={'catalogue_type': 'survey', 'statistic_type': '2pcf'},
+        field_cache=field_cache,
         save=save, logger=logger
     )
 
@@ -833,7 +905,7 @@ def _compute_2pt_stats_sim_like(twopt_algofunc, catalogue_data,
         - 'boxsize': sequence of [float, float, float];
         - 'ngrid': sequence of [int, int, int];
         - 'assignment': {'ngp', 'cic', 'tsc', 'pcs'};
-        - 'interlace': bool;
+        - 'interlace': bool or int;
 
         and exactly one of the following only when 'alignment' is 'pad'---
 
@@ -1066,7 +1138,7 @@ def compute_powspec_in_gpp_box(catalogue_data,
         - 'boxsize': sequence of [float, float, float];
         - 'ngrid': sequence of [int, int, int];
         - 'assignment': {'ngp', 'cic', 'tsc', 'pcs'};
-        - 'interlace': bool;
+        - 'interlace': bool or int;
 
         and exactly one of the following only when 'alignment' is 'pad'---
 
@@ -1096,7 +1168,14 @@ def compute_powspec_in_gpp_box(catalogue_data,
         - 'nmodes': number of wavevector modes in each bin;
         - 'pk_raw': power spectrum raw measurements including any
           specified normalisation and shot noise;
-        - 'pk_shot': power spectrum shot noise.
+        - 'pk_shot': power spectrum shot noise;
+        - 'profile': stage profile of the measurement, with each
+          stage ('assignment', 'fft', 'binning', 'shell_fill',
+          'reduction', 'shotnoise' etc.) mapped to its call count
+          ('ncalls'), wall time with and without nested stages in
+          seconds ('time_total', 'time_self'), estimated data touched
+          and peak memory usage in gibibytes ('gbytes', 'gbytes_mem')
+          and thread count ('nthreads').
 
         The effective wavenumber is here defined as the average wavenumber
         in each bin.
@@ -1124,6 +1203,102 @@ def compute_powspec_in_gpp_box(catalogue_data,
     return results
 
 
+def compute_powspec_kmu_in_gpp_box(catalogue_data,
+                                   degrees=(0, 2, 4), num_wedges=0,
+                                   binning=None, sampling_params=None,
+                                   paramset=None, logger=None):
+    """Compute power spectrum multipoles and wedges from
+    a simulation-box catalogue in the global plane-parallel approximation
+    in a single (k, μ) accumulation.
+
+    .. versionadded:: 0.4.0
+
+    All multipoles and wedges share one mesh assignment, one FFT and one
+    sweep over the mesh grid, and the multipoles are identical to those
+    from :func:`~triumvirate.twopt.compute_powspec_in_gpp_box` for each
+    degree.  The line of sight is along the z-axis.
+
+    Parameters
+    ----------
+    catalogue_data : :class:`~triumvirate.catalogue.ParticleCatalogue`
+        Data-source catalogue.
+    degrees : sequence of int, optional
+        Multipole degrees (default is (0, 2, 4)).
+    num_wedges : int, optional
+        Number of equal-width wedges in absolute μ-values in [0, 1]
+        (default is 0, i.e. no wedges).
+    binning : :class:`~triumvirate.dataobjs.Binning`, optional
+        Binning for the measurements.  If `None` (default), this is
+        constructed from `paramset`.
+    sampling_params : dict, optional
+        Dictionary containing a subset of sampling parameters as in
+        :func:`~triumvirate.twopt.compute_powspec_in_gpp_box`.
+        If not `None` (default), this will override the corresponding
+        entries in `paramset`.
+    paramset : :class:`~triumvirate.parameters.ParameterSet`, optional
+        Full parameter set (default is `None`).  This is used
+        in lieu of `binning` or `sampling_params`.
+    logger : :class:`logging.Logger`, optional
+        Logger (default is `None`).
+
+    Returns
+    -------
+    results : dict of {str: :class:`numpy.ndarray`}
+        Measurement results as a dictionary with the following entries---
+
+        - 'ells': multipole degrees;
+        - 'kbin': central wavenumber for each bin;
+        - 'keff': effective wavenumber for each bin;
+        - 'nmodes': number of wavevector modes in each bin;
+        - 'pk_raw': power spectrum multipole raw measurements including
+          any specified normalisation and shot noise, with shape
+          ``(len(degrees), num_bins)``;
+        - 'pk_shot': power spectrum multipole shot noise, with the same
+          shape as 'pk_raw';
+        - 'mu_edges': wedge edges in absolute μ-values;
+        - 'keff_wedges', 'mueff_wedges': effective wavenumber and
+          absolute μ-value for each wedge bin, with shape
+          ``(num_wedges, num_bins)``;
+        - 'nmodes_wedges': number of wavevector modes in each wedge bin;
+        - 'pk_raw_wedges', 'pk_shot_wedges': power spectrum wedge raw
+          measurements and shot noise;
+        - 'profile': stage profile of the measurement as in
+          :func:`~triumvirate.twopt.compute_powspec_in_gpp_box`.
+
+    Raises
+    ------
+    ValueError
+        When `paramset` is `None` but `binning` or `sampling_params` is
+        also `None`, or when any degree in `degrees` or `num_wedges` is
+        negative.
+
+    """
+    degrees = [int(ell) for ell in degrees]
+    if any(ell < 0 for ell in degrees) or num_wedges < 0:
+        raise ValueError(
+            "Multipole degrees and the number of wedges "
+            "must be non-negative."
+        )
+
+    def _compute_powspec_kmu(particles_data, paramset, binning, norm_factor):
+        return _compute_powspec_kmu_in_gpp_box(
+            particles_data, paramset, binning,
+            degrees, num_wedges, norm_factor
+        )
+
+    # The multipole degree parameter is unused by the (k, μ) accumulation
+    # but is required for a parameter set to be amalgamated.
+    results = _compute_2pt_stats_sim_like(
+        _compute_powspec_kmu, catalogue_data,
+        paramset=paramset, params_sampling=sampling_params,
+        degree=(0 if paramset is None else None), binning=binning,
+        types={'catalogue_type': 'sim', 'statistic_type': 'powspec'},
+        logger=logger
+    )
+
+    return results
+
+
 def compute_corrfunc_in_gpp_box(catalogue_data,
                                 degree=None, binning=None,
                                 sampling_params=None,
@@ -1150,7 +1325,7 @@ def compute_corrfunc_in_gpp_box(catalogue_data,
         - 'boxsize': sequence of [float, float, float];
         - 'ngrid': sequence of [int, int, int];
         - 'assignment': {'ngp', 'cic', 'tsc', 'pcs'};
-        - 'interlace': bool;
+        - 'interlace': bool or int;
 
         and exactly one of the following only when 'alignment' is 'pad'---
 
@@ -1178,7 +1353,14 @@ def compute_corrfunc_in_gpp_box(catalogue_data,
         - 'rbin': central separation for each bin;
         - 'reff': effective separation for each bin;
         - 'npairs': number of separation pairs in each bin;
-        - 'xi': two-point correlation function measurements.
+        - 'xi': two-point correlation function measurements;
+        - 'profile': stage profile of the measurement, with each
+          stage ('assignment', 'fft', 'binning', 'shell_fill',
+          'reduction', 'shotnoise' etc.) mapped to its call count
+          ('ncalls'), wall time with and without nested stages in
+          seconds ('time_total', 'time_self'), estimated data touched
+          and peak memory usage in gibibytes ('gbytes', 'gbytes_mem')
+          and thread count ('nthreads').
 
         The effective separation is here defined as the average separation
         in each bin.
@@ -1220,10 +1402,12 @@ def compute_corrfunc_window(catalogue_rand, los_rand=None,
     ----------
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue,
+        or a global line-of-sight axis for all its particles.
+        If `None` (default), the local line of sight is evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degree : int, optional
         Multipole degree.  If not `None` (default), this will override
         ``paramset['degrees']['ELL']``.
@@ -1238,7 +1422,7 @@ def compute_corrfunc_window(catalogue_rand, los_rand=None,
         - 'boxsize': sequence of [float, float, float];
         - 'ngrid': sequence of [int, int, int];
         - 'assignment': {'ngp', 'cic', 'tsc', 'pcs'};
-        - 'interlace': bool;
+        - 'interlace': bool or int;
 
         and exactly one of the following only when 'alignment' is 'pad'---
 
@@ -1266,7 +1450,14 @@ def compute_corrfunc_window(catalogue_rand, los_rand=None,
         - 'rbin': central separation for each bin;
         - 'reff': effective separation for each bin;
         - 'npairs': number of separation pairs in each bin;
-        - 'xi': two-point correlation function window measurements.
+        - 'xi': two-point correlation function window measurements;
+        - 'profile': stage profile of the measurement, with each
+          stage ('assignment', 'fft', 'binning', 'shell_fill',
+          'reduction', 'shotnoise' etc.) mapped to its call count
+          ('ncalls'), wall time with and without nested stages in
+          seconds ('time_total', 'time_self'), estimated data touched
+          and peak memory usage in gibibytes ('gbytes', 'gbytes_mem')
+          and thread count ('nthreads').
 
         The effective separation is here defined as the average separation
         in each bin.
@@ -1310,9 +1501,8 @@ def compute_corrfunc_window(catalogue_rand, los_rand=None,
         logger.info("Binning has been initialised.")
 
     # Set up lines of sight.
-    if los_rand is None:
-        los_rand = catalogue_rand.compute_los()
-    los_rand = np.ascontiguousarray(los_rand)
+    if los_rand is not None:
+        los_rand = np.ascontiguousarray(los_rand, dtype=float)
 
     if logger:
         logger.info("Lines of sight have been initialised.")
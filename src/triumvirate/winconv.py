@@ -26,11 +26,8 @@ import numpy as np
 from scipy.interpolate import InterpolatedUnivariateSpline, RectBivariateSpline
 
 from triumvirate._arrayops import SpacingError, _check_1d_array
-from triumvirate.transforms import (
-    DoubleSphericalBesselTransform,
-    SphericalBesselTransform,
-    resample_lglin,
-)
+from triumvirate._winconv import _WinConvEngine
+from triumvirate.transforms import resample_lglin
 
 
 NAMED_FORMULAE = {
@@ -161,10 +158,10 @@ class WinConvFormulae:
         Window convolution formulae.
     multipoles : list of str
         Windowed CF multipoles.
-    multipoles_Q : array of str
-        Required window function multipoles.
-    multipoles_Z : array of str
-        Required unwindowed CF multipoles.
+    multipoles_Q : list of str
+        Required window function multipoles (in order of appearance).
+    multipoles_Z : list of str
+        Required unwindowed CF multipoles (in order of appearance).
 
     Examples
     --------
@@ -227,17 +224,17 @@ class WinConvFormulae:
             for multipole, formula in formulae.items()
         }
 
-        self.multipoles = formulae.keys()
-        self.multipoles_Q = np.unique([
+        self.multipoles = list(formulae.keys())
+        self.multipoles_Q = list(dict.fromkeys([
             term.ind_Q
             for formula in self.formulae.values()
             for term in formula
-        ])
-        self.multipoles_Z = np.unique([
+        ]))
+        self.multipoles_Z = list(dict.fromkeys([
             term.ind_Z
             for formula in self.formulae.values()
             for term in formula
-        ])
+        ]))
 
     def __getitem__(self, multipole):
         """Get the formula for a specific windowed CF multipole.
@@ -319,6 +316,121 @@ class WinConvFormulae:
         return ' '.join(terms_str)
 
 
+def _compile_coupling(formulae, window_multipoles):
+    """Compile window convolution formulae into a dense coupling plan.
+
+    Parameters
+    ----------
+    formulae : :class:`~triumvirate.winconv.WinConvFormulae`
+        Window convolution formulae.
+    window_multipoles : dict of {str: array of float}
+        Window function multipole samples (each key is a multipole)
+        at the sample points of the convolution.
+
+    Returns
+    -------
+    coupling : array of float
+        Coupling plan, where ``coupling[a, b]`` is the sum of the window
+        function multipoles (times coefficients) of all terms coupling
+        the `b`-th multipole in :attr:`~.WinConvFormulae.multipoles_Z`
+        to the `a`-th multipole in :attr:`~.WinConvFormulae.multipoles`.
+
+    """
+    index_Z = {
+        multipole_Z: idx
+        for idx, multipole_Z in enumerate(formulae.multipoles_Z)
+    }
+    shape = np.shape(window_multipoles[formulae.multipoles_Q[0]])
+
+    coupling = np.zeros(
+        (len(formulae.multipoles), len(formulae.multipoles_Z), *shape)
+    )
+    for idx, multipole in enumerate(formulae.multipoles):
+        for term in formulae[multipole]:
+            coupling[idx, index_Z[term.ind_Z]] += \
+                float(term.coeff) * np.asarray(window_multipoles[term.ind_Q])
+
+    return coupling
+
+
+def _get_resampling_weights(sampts_from, sampts_to, clip=False):
+    """Get cubic-spline resampling weights between sample points.
+
+    Parameters
+    ----------
+    sampts_from, sampts_to : 1-d array of float
+        Sample points before and after resampling.
+    clip : bool, optional
+        If `True` (default is `False`), sample points after resampling
+        are clipped to the range of those before resampling instead of
+        being extrapolated to.
+
+    Returns
+    -------
+    weights : 2-d array of float or None
+        Resampling weights, such that ``weights @ samples`` interpolates
+        `samples` at `sampts_from` to `sampts_to` as
+        :class:`scipy.interpolate.InterpolatedUnivariateSpline` does
+        (or, with `clip`, as :class:`scipy.interpolate.RectBivariateSpline`
+        does in each dimension).  `None` if the sample points are
+        the same.
+
+    """
+    if np.shape(sampts_from) == np.shape(sampts_to) \
+            and np.allclose(sampts_from, sampts_to):
+        return None
+
+    if clip:
+        sampts_to = np.clip(
+            sampts_to, np.min(sampts_from), np.max(sampts_from)
+        )
+
+    return np.column_stack([
+        InterpolatedUnivariateSpline(sampts_from, unit_samples)(sampts_to)
+        for unit_samples in np.eye(len(sampts_from))
+    ])
+
+
+def _plan_transforms(engine, degrees_Z, degrees, sampts_in, sampts_common,
+                     sampts_out, transform_kwargs, clip=False):
+    """Plan FFTLog transforms and resampling weights of a window
+    convolution engine for Fourier-space statistics.
+
+    Parameters
+    ----------
+    engine : :class:`~triumvirate._winconv._WinConvEngine`
+        Window convolution engine.
+    degrees_Z, degrees : list of int or list of (int, int)
+        Transform degrees of the unwindowed and windowed multipoles.
+    sampts_in, sampts_common, sampts_out : 1-d array of float
+        Input wavenumber, common separation and output wavenumber
+        sample points.
+    transform_kwargs : dict
+        FFTLog transform keyword arguments.
+    clip : bool, optional
+        Whether resampling clips sample points (default is `False`);
+        see :func:`~triumvirate.winconv._get_resampling_weights`.
+
+    """
+    engine.plan_transforms(
+        degrees_Z, degrees, sampts_in, sampts_common,
+        kr_c=transform_kwargs.get('pivot', 1.),
+        lowring=transform_kwargs.get('lowring', True),
+        extrap=transform_kwargs.get('extrap', 0),
+        extrap_exp=transform_kwargs.get('extrap_exp', 2.),
+        extrap2d=transform_kwargs.get('extrap2d', False),
+    )
+
+    for idx_Z, sampts_Z in enumerate(engine.post_sampts_Z):
+        engine.set_input_weights(
+            idx_Z, _get_resampling_weights(sampts_Z, sampts_common, clip=clip)
+        )
+    for idx, sampts in enumerate(engine.post_sampts):
+        engine.set_output_weights(
+            idx, _get_resampling_weights(sampts, sampts_out, clip=clip)
+        )
+
+
 class TwoPointWinConvBase:
     """Generic window convolution of two-point statistics.
 
@@ -403,7 +515,7 @@ class TwoPCFWinConv(TwoPointWinConvBase):
         super().__init__(formulae, window_sampts, window_multipoles)
 
         self.r_in = r_in
-        self.r_out = r_out or r_in
+        self.r_out = r_in if r_out is None else r_out
 
         self._Q_out = {
             _multipole: InterpolatedUnivariateSpline(
@@ -412,39 +524,45 @@ class TwoPCFWinConv(TwoPointWinConvBase):
             for _multipole, _Qpole_in in self._Q_in.items()
         }
 
-    def convolve(self, xi_in):
+        # Compile the coupling plan and interpolation weights
+        # for repeated use.
+        self._engine = _WinConvEngine(
+            1, _compile_coupling(self._formulae, self._Q_out),
+            nsamp_in=len(self.r_in)
+        )
+        weights_in = _get_resampling_weights(self.r_in, self.r_out)
+        for idx_Z in range(len(self._formulae.multipoles_Z)):
+            self._engine.set_input_weights(idx_Z, weights_in)
+
+    def convolve(self, xi_in, on_grid=False):
         """Convolve 2PCF multipoles.
 
         Parameters
         ----------
-        xi_in : dict of {str: 2-d array of float}
-            Input 3PCF multipole samples (each key is a multipole)
+        xi_in : dict of {str: 1-d array of float}
+            Input 2PCF multipole samples (each key is a multipole)
             at sample points :attr:`r_in`.
+        on_grid : bool, optional
+            If `True` (default is `False`), `xi_in` are sampled at
+            :attr:`r_out` instead and no interpolation is performed.
 
         Returns
         -------
-        xi_conv_out : dict of {str: 2-d :class:`numpy.ndarray`}
-            Output windowed 3PCF multipole samples (each key is
+        xi_conv_out : dict of {str: 1-d :class:`numpy.ndarray`}
+            Output windowed 2PCF multipole samples (each key is
             a multipole) at sample points :attr:`r_out`.
 
         """
-        # Interpolate input multipoles at output sample points.
-        xi_out = {
-            multipole: InterpolatedUnivariateSpline(
-                self.r_in, Zpole_in
-            )(self.r_out)
-            for multipole, Zpole_in in xi_in.items()
-        }
-
-        # Perform convolution as multiplication.
-        xi_conv_out = {}
-        for multipole in self._formulae.multipoles:
-            xi_conv_out[multipole] = np.add.reduce([
-                term.coeff * self._Q_out[term.ind_Q] * xi_out[term.ind_Z]
-                for term in self._formulae[multipole]
-            ])
+        # Interpolate and convolve all multipoles in one call.
+        xi_conv_out = self._engine.convolve(
+            [
+                xi_in[multipole_Z]
+                for multipole_Z in self._formulae.multipoles_Z
+            ],
+            on_grid=on_grid
+        )
 
-        return xi_conv_out
+        return dict(zip(self._formulae.multipoles, xi_conv_out))
 
 
 class PowspecWinConv(TwoPointWinConvBase):
@@ -476,9 +594,10 @@ class PowspecWinConv(TwoPointWinConvBase):
         sample points are used (after logarithmic respacing if necessary);
         otherwise, `r_common` must be logarithmically spaced.
     transform_kwargs : dict, optional
-        FFTLog transform keyword arguments to be passed to
+        FFTLog transform keyword arguments as for
         :class:`~triumvirate.transforms.SphericalBesselTransform`
-        (default is `None`).
+        (default is `None`), i.e. 'pivot', 'lowring', 'extrap',
+        'extrap_exp' and 'threaded'.
 
     Attributes
     ----------
@@ -552,7 +671,7 @@ class PowspecWinConv(TwoPointWinConvBase):
             self.r_common = r_common
 
         try:
-            _check_1d_array(k_in, check_log=True)
+            _check_1d_array(k_in, check_loglin=True)
         except SpacingError:
             raise SpacingError(
                 "Input power spectrum wavenumber sample points are not "
@@ -560,11 +679,12 @@ class PowspecWinConv(TwoPointWinConvBase):
             )
 
         self.k_in = k_in
-        self.k_out = k_out or k_in
+        self.k_out = k_in if k_out is None else k_out
 
         super().__init__(formulae, _rQ_in, _Q_in)
 
-        # Instantiate transforms for each multipole for repeated use.
+        # Plan transforms for each multipole, and compile the coupling
+        # plan and interpolation weights for repeated use.
         self._transform_kwargs = transform_kwargs or {}
         # if 'lowring' not in self._transform_kwargs:
         #     self._transform_kwargs['lowring'] = True
@@ -572,29 +692,20 @@ class PowspecWinConv(TwoPointWinConvBase):
             self._transform_kwargs['extrap'] = 3
         # if 'extrap_exp' not in self._transform_kwargs:
         #     self._transform_kwargs['extrap_exp'] = 2.
-        # if 'extrap_layer' not in self._transform_kwargs:
-        #     self._transform_kwargs['extrap_layer'] = 'outer'
-
-        self._bsjt = {
-            multipole_Z: SphericalBesselTransform(
-                degree=int(multipole_Z),
-                bias=0,
-                sample_pts=self.k_in,
-                **self._transform_kwargs
-            )
-            for multipole_Z in self._formulae.multipoles_Z
-        }  # backward sj-transform for unwindowed power spectrum multipoles
-        self._fsjt = {
-            multipole: SphericalBesselTransform(
-                degree=int(multipole),
-                bias=0,
-                sample_pts=self.r_common,
-                **self._transform_kwargs
-            )
-            for multipole in self._formulae.multipoles
-        }  # forward sj-transform for windowed 2PCF multipoles
 
-    def convolve(self, pk_in):
+        self._engine = _WinConvEngine(
+            1, _compile_coupling(self._formulae, self._Q_in),
+            nsamp_in=len(self.k_in), nsamp_out=len(self.k_out),
+            threaded=self._transform_kwargs.get('threaded', False)
+        )
+        _plan_transforms(
+            self._engine,
+            [int(multipole_Z) for multipole_Z in self._formulae.multipoles_Z],
+            [int(multipole) for multipole in self._formulae.multipoles],
+            self.k_in, self.r_common, self.k_out, self._transform_kwargs
+        )
+
+    def convolve(self, pk_in, on_grid=False):
         """Convolve power spectrum multipoles.
 
         Parameters
@@ -602,6 +713,12 @@ class PowspecWinConv(TwoPointWinConvBase):
         pk_in : dict of {str: 1-d array of float}
             Input power spectrum multipole samples (each key is
             a multipole) at sample points :attr:`k_in`.
+        on_grid : bool, optional
+            If `True` (default is `False`), `pk_in` are instead the
+            unwindowed 2PCF multipole samples at sample points
+            :attr:`r_common` (i.e. on the FFTLog grid of the forward
+            transforms), and no backward transform or interpolation
+            is performed.
 
         Returns
         -------
@@ -610,45 +727,16 @@ class PowspecWinConv(TwoPointWinConvBase):
             a multipole) at sample points :attr:`k_out`.
 
         """
-        # Backward transform bispectrum multipoles to 3PCF multipoles.
-        xi_in = {}
-        for multipole_Z, Ppole_in in pk_in.items():
-            r_in, xi_in[multipole_Z] = \
-                self._bsjt[multipole_Z].transform(Ppole_in)
-
-        # Resample at common separation sample points.
-        if not np.allclose(r_in, self.r_common):
-            xi_in = {
-                multipole_Z: InterpolatedUnivariateSpline(
-                    r_in, Zpole_in
-                )(self.r_common)
-                for multipole_Z, Zpole_in in xi_in.items()
-            }
-
-        # Convolve 2PCF multipoles.
-        xi_conv = {}
-        for multipole in self._formulae.multipoles:
-            xi_conv[multipole] = np.add.reduce([
-                term.coeff * self._Q_in[term.ind_Q] * xi_in[term.ind_Z]
-                for term in self._formulae[multipole]
-            ])
-
-        # Forward transform 2PCF multipoles to power spectrum multipoles.
-        pk_conv_out = {}
-        for multipole, Zpole_conv in xi_conv.items():
-            k_conv, pk_conv_out[multipole] = \
-                self._fsjt[multipole].transform(Zpole_conv)
-
-        # Resample at output wavenumber sample points.
-        if not np.allclose(k_conv, self.k_out):
-            pk_conv_out = {
-                multipole: InterpolatedUnivariateSpline(
-                    k_conv, Ppole_conv_out
-                )(self.k_out)
-                for multipole, Ppole_conv_out in pk_conv_out.items()
-            }
-
-        return pk_conv_out
+        # Transform, interpolate and convolve all multipoles in one call.
+        pk_conv_out = self._engine.convolve(
+            [
+                pk_in[multipole_Z]
+                for multipole_Z in self._formulae.multipoles_Z
+            ],
+            on_grid=on_grid
+        )
+
+        return dict(zip(self._formulae.multipoles, pk_conv_out))
 
 
 class ThreePointWinConvBase:
@@ -747,7 +835,7 @@ class ThreePCFWinConv(ThreePointWinConvBase):
         super().__init__(formulae, window_sampts, window_multipoles)
 
         self.r_in = r_in
-        self.r_out = r_out or r_in
+        self.r_out = r_in if r_out is None else r_out
 
         self._Q_out = {
             _multipole: RectBivariateSpline(
@@ -762,7 +850,23 @@ class ThreePCFWinConv(ThreePointWinConvBase):
             for _multipole, _Qpole_in in self._Q_in.items()
         }
 
-    def convolve(self, zeta_in):
+        # Compile the coupling plans and interpolation weights
+        # for repeated use.
+        self._engine = _WinConvEngine(
+            2, _compile_coupling(self._formulae, self._Q_out),
+            nsamp_in=len(self.r_in)
+        )
+        self._engine_diag = _WinConvEngine(
+            1, _compile_coupling(self._formulae, self._Qdiag_out),
+            nsamp_in=len(self.r_in)
+        )
+        weights_in = _get_resampling_weights(self.r_in, self.r_out, clip=True)
+        weights_diag_in = _get_resampling_weights(self.r_in, self.r_out)
+        for idx_Z in range(len(self._formulae.multipoles_Z)):
+            self._engine.set_input_weights(idx_Z, weights_in)
+            self._engine_diag.set_input_weights(idx_Z, weights_diag_in)
+
+    def convolve(self, zeta_in, on_grid=False):
         """Convolve 3PCF multipoles.
 
         Parameters
@@ -770,6 +874,9 @@ class ThreePCFWinConv(ThreePointWinConvBase):
         zeta_in : dict of {str: 2-d array of float}
             Input 3PCF multipole samples (each key is a multipole)
             at sample points :attr:`r_in`.
+        on_grid : bool, optional
+            If `True` (default is `False`), `zeta_in` are sampled at
+            :attr:`r_out` instead and no interpolation is performed.
 
         Returns
         -------
@@ -778,25 +885,18 @@ class ThreePCFWinConv(ThreePointWinConvBase):
             a multipole) at sample points :attr:`r_out`.
 
         """
-        # Interpolate input multipoles at output sample points.
-        zeta_out = {
-            multipole: RectBivariateSpline(
-                self.r_in, self.r_in, Zpole_in
-            )(self.r_out, self.r_out)
-            for multipole, Zpole_in in zeta_in.items()
-        }
-
-        # Perform convolution as multiplication.
-        zeta_conv_out = {}
-        for multipole in self._formulae.multipoles:
-            zeta_conv_out[multipole] = np.add.reduce([
-                term.coeff * self._Q_out[term.ind_Q] * zeta_out[term.ind_Z]
-                for term in self._formulae[multipole]
-            ])
-
-        return zeta_conv_out
-
-    def convolve_diag(self, zeta_diag_in):
+        # Interpolate and convolve all multipoles in one call.
+        zeta_conv_out = self._engine.convolve(
+            [
+                zeta_in[multipole_Z]
+                for multipole_Z in self._formulae.multipoles_Z
+            ],
+            on_grid=on_grid
+        )
+
+        return dict(zip(self._formulae.multipoles, zeta_conv_out))
+
+    def convolve_diag(self, zeta_diag_in, on_grid=False):
         """Convolve diagonal 3PCF multipoles.
 
         Parameters
@@ -804,6 +904,9 @@ class ThreePCFWinConv(ThreePointWinConvBase):
         zeta_diag_in : dict of {str: 1-d array of float}
             Input diagonal 3PCF multipole samples (each key
             is a multipole) at sample points :attr:`r_in`.
+        on_grid : bool, optional
+            If `True` (default is `False`), `zeta_diag_in` are sampled at
+            :attr:`r_out` instead and no interpolation is performed.
 
         Returns
         -------
@@ -812,24 +915,16 @@ class ThreePCFWinConv(ThreePointWinConvBase):
             is a multipole) at sample points :attr:`r_out`.
 
         """
-        # Interpolate input multipoles at output sample points.
-        zeta_diag_out = {
-            multipole: InterpolatedUnivariateSpline(
-                self.r_in, Zpole_diag_in
-            )(self.r_out)
-            for multipole, Zpole_diag_in in zeta_diag_in.items()
-        }
-
-        # Perform convolution as multiplication.
-        zeta_diag_conv_out = {}
-        for multipole in self._formulae.multipoles:
-            zeta_diag_conv_out[multipole] = np.add.reduce([
-                term.coeff
-                * self._Qdiag_out[term.ind_Q] * zeta_diag_out[term.ind_Z]
-                for term in self._formulae[multipole]
-            ])
+        # Interpolate and convolve all multipoles in one call.
+        zeta_diag_conv_out = self._engine_diag.convolve(
+            [
+                zeta_diag_in[multipole_Z]
+                for multipole_Z in self._formulae.multipoles_Z
+            ],
+            on_grid=on_grid
+        )
 
-        return zeta_diag_conv_out
+        return dict(zip(self._formulae.multipoles, zeta_diag_conv_out))
 
 
 class BispecWinConv(ThreePointWinConvBase):
@@ -861,9 +956,10 @@ class BispecWinConv(ThreePointWinConvBase):
         sample points are used (after logarithmic respacing if necessary);
         otherwise, `r_common` must be logarithmically spaced.
     transform_kwargs : dict, optional
-        FFTLog transform keyword arguments to be passed to
+        FFTLog transform keyword arguments as for
         :class:`~triumvirate.transforms.DoubleSphericalBesselTransform`
-        (default is `None`).
+        (default is `None`), i.e. 'pivot', 'lowring', 'extrap',
+        'extrap_exp', 'extrap2d' and 'threaded'.
 
     Attributes
     ----------
@@ -943,7 +1039,7 @@ class BispecWinConv(ThreePointWinConvBase):
             self.r_common = r_common
 
         try:
-            _check_1d_array(k_in, check_log=True)
+            _check_1d_array(k_in, check_loglin=True)
         except SpacingError:
             raise SpacingError(
                 "Input bispectrum wavenumber sample points are not "
@@ -951,11 +1047,12 @@ class BispecWinConv(ThreePointWinConvBase):
             )
 
         self.k_in = k_in
-        self.k_out = k_out or k_in
+        self.k_out = k_in if k_out is None else k_out
 
         super().__init__(formulae, _rQ_in, _Q_in)
 
-        # Instantiate transforms for each multipole for repeated use.
+        # Plan transforms for each multipole, and compile the coupling
+        # plan and interpolation weights for repeated use.
         self._transform_kwargs = transform_kwargs or {}
         # if 'lowring' not in self._transform_kwargs:
         #     self._transform_kwargs['lowring'] = True
@@ -966,26 +1063,26 @@ class BispecWinConv(ThreePointWinConvBase):
         # if 'extrap2d' not in self._transform_kwargs:
         #     self._transform_kwargs['extrap2d'] = False
 
-        self._bdsjt = {
-            multipole_Z: DoubleSphericalBesselTransform(
-                degrees=(int(multipole_Z[0]), int(multipole_Z[1])),
-                biases=(0, 0),
-                sample_pts=self.k_in,
-                **self._transform_kwargs
-            )
-            for multipole_Z in self._formulae.multipoles_Z
-        }  # backward double sj-transform for unwindowed bispectrum multipoles
-        self._fdsjt = {
-            multipole: DoubleSphericalBesselTransform(
-                degrees=(multipole[0], multipole[1]),
-                biases=(0, 0),
-                sample_pts=self.r_common,
-                **self._transform_kwargs
-            )
-            for multipole in self._formulae.multipoles
-        }  # forward double sj-transform for windowed 3PCF multipoles
-
-    def convolve(self, bk_in):
+        self._engine = _WinConvEngine(
+            2, _compile_coupling(self._formulae, self._Q_in),
+            nsamp_in=len(self.k_in), nsamp_out=len(self.k_out),
+            threaded=self._transform_kwargs.get('threaded', False)
+        )
+        _plan_transforms(
+            self._engine,
+            [
+                (int(multipole_Z[0]), int(multipole_Z[1]))
+                for multipole_Z in self._formulae.multipoles_Z
+            ],
+            [
+                (int(multipole[0]), int(multipole[1]))
+                for multipole in self._formulae.multipoles
+            ],
+            self.k_in, self.r_common, self.k_out, self._transform_kwargs,
+            clip=True
+        )
+
+    def convolve(self, bk_in, on_grid=False):
         """Convolve bispectrum multipoles.
 
         Parameters
@@ -993,6 +1090,12 @@ class BispecWinConv(ThreePointWinConvBase):
         bk_in : dict of {str: 2-d array of float}
             Input bispectrum multipole samples (each key is a multipole)
             at sample points :attr:`k_in`.
+        on_grid : bool, optional
+            If `True` (default is `False`), `bk_in` are instead the
+            unwindowed 3PCF multipole samples at sample points
+            :attr:`r_common` (i.e. on the FFTLog grid of the forward
+            transforms), and no backward transform or interpolation
+            is performed.
 
         Returns
         -------
@@ -1001,42 +1104,13 @@ class BispecWinConv(ThreePointWinConvBase):
             a multipole) at sample points :attr:`k_out`.
 
         """
-        # Backward transform bispectrum multipoles to 3PCF multipoles.
-        zeta_in = {}
-        for multipole_Z, Bpole_in in bk_in.items():
-            r_in, zeta_in[multipole_Z] = \
-                self._bdsjt[multipole_Z].transform(Bpole_in)
-
-        # Resample at common separation sample points.
-        if not np.allclose(r_in, self.r_common):
-            zeta_in = {
-                multipole_Z: RectBivariateSpline(
-                    r_in, r_in, Zpole_in
-                )(self.r_common, self.r_common)
-                for multipole_Z, Zpole_in in zeta_in.items()
-            }
-
-        # Convolve 3PCF multipoles.
-        zeta_conv = {}
-        for multipole in self._formulae.multipoles:
-            zeta_conv[multipole] = np.add.reduce([
-                term.coeff * self._Q_in[term.ind_Q] * zeta_in[term.ind_Z]
-                for term in self._formulae[multipole]
-            ])
-
-        # Forward transform 3PCF multipoles to bispectrum multipoles.
-        bk_conv_out = {}
-        for multipole, Zpole_conv in zeta_conv.items():
-            k_conv, bk_conv_out[multipole] = \
-                self._fdsjt[multipole].transform(Zpole_conv)
-
-        # Resample at output wavenumber sample points.
-        if not np.allclose(k_conv, self.k_out):
-            bk_conv_out = {
-                multipole: RectBivariateSpline(
-                    k_conv, k_conv, Bpole_conv_out
-                )(self.k_out, self.k_out)
-                for multipole, Bpole_conv_out in bk_conv_out.items()
-            }
-
-        return bk_conv_out
+        # Transform, interpolate and convolve all multipoles in one call.
+        bk_conv_out = self._engine.convolve(
+            [
+                bk_in[multipole_Z]
+                for multipole_Z in self._formulae.multipoles_Z
+            ],
+            on_grid=on_grid
+        )
+
+        return dict(zip(self._formulae.multipoles, bk_conv_out))
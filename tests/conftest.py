@@ -194,6 +194,19 @@ def test_rand_catalogue(test_ctlg_dir, test_logger, test_catalogue_properties):
     return ParticleCatalogue(x, y, z, nz=nz, logger=test_logger)
 
 
+@pytest.fixture
+def copy_catalogue():
+    # Catalogues are copied (optionally subsampled by `step`) before use
+    # where they would otherwise be offset in place by measurements.
+    def _copy_catalogue(catalogue, step=1):
+        return ParticleCatalogue(
+            *(np.array(catalogue[axis][::step]) for axis in 'xyz'),
+            nz=np.array(catalogue['nz'][::step])
+        )
+
+    return _copy_catalogue
+
+
 @pytest.fixture
 def test_uniform_catalogue(test_ctlg_dir, test_logger,
                            test_catalogue_properties):
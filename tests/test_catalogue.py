@@ -144,6 +144,48 @@ def test_ParticleCatalogue_read_from_file(filename, reader, format,
         "Loaded catalogue particle clustering weight column does not match."
 
 
+@pytest.mark.parametrize(
+    "kind, radius_max",
+    [
+        ('uniform', None),
+        ('poisson', None),
+        ('lognormal', 40.),
+    ]
+)
+def test_ParticleCatalogue_generate_synthetic(kind, radius_max):
+
+    num, boxsize = 20000, 100.
+
+    catalogue = ParticleCatalogue.generate_synthetic(
+        num, boxsize, kind=kind, seed=7, ngrid=16, radius_max=radius_max
+    )
+    catalogue_rep = ParticleCatalogue.generate_synthetic(
+        num, boxsize, kind=kind, seed=7, ngrid=16, radius_max=radius_max
+    )
+
+    if kind == 'uniform':
+        assert len(catalogue) == num, \
+            "Synthetic catalogue length is incorrect."
+    for axis in ['x', 'y', 'z']:
+        assert np.all(
+            (catalogue[axis] >= 0.) & (catalogue[axis] < boxsize)
+        ), "Synthetic catalogue particles are outside the box."
+        assert np.array_equal(catalogue[axis], catalogue_rep[axis]), \
+            "Synthetic catalogue is not reproducible with the same seed."
+    assert np.allclose(catalogue['nz'], num / boxsize**3), \
+        "Synthetic catalogue number density column is incorrect."
+
+    if radius_max is not None:
+        r = np.sqrt(sum(
+            (catalogue[axis] - boxsize/2.)**2 for axis in ['x', 'y', 'z']
+        ))
+        assert np.all(r <= radius_max), \
+            "Synthetic catalogue particles are outside the survey mask."
+
+    with pytest.raises(ValueError):
+        ParticleCatalogue.generate_synthetic(num, boxsize, kind='unknown')
+
+
 def test_ParticleCatalogue___str__(minimal_catalogue):
     assert 'extdata' in str(minimal_catalogue), \
         "Catalogue string representation has incorrect source."
@@ -301,6 +343,13 @@ def test_ParticleCatalogue_offset_coords(origin, extents, minimal_catalogue):
             "Catalogue particle coordinates are not offset correctly."
 
 
+def test_ParticleCatalogue_compute_los_offset(minimal_catalogue):
+    _los = minimal_catalogue.compute_los()
+    minimal_catalogue.offset_coords([1., 2., 3.])
+    assert np.allclose(minimal_catalogue.compute_los(), _los), \
+        "Catalogue lines of sight are not invariant under offset."
+
+
 @pytest.mark.parametrize(
     "ref_catalogue",
     [
@@ -0,0 +1,52 @@
+"""Test :mod:`~triumvirate.dataio`.
+
+"""
+import numpy as np
+import pytest
+
+from triumvirate.dataio import read_binary_measurements
+
+
+def test_read_binary_measurements(test_stats_dir):
+
+    measurements = read_binary_measurements(test_stats_dir/"pk0_lpp.bin")
+    measurements_ext = np.loadtxt(test_stats_dir/"pk0_lpp.txt", unpack=True)
+
+    assert measurements['nmodes'].dtype == np.int64, \
+        "Mode counts are not read as integers."
+    assert measurements['pk_raw'].dtype == np.complex128, \
+        "Raw statistics are not read as complex numbers."
+
+    assert np.allclose(measurements['kbin'], measurements_ext[0]), \
+        "Measurement bins do not match."
+    assert np.allclose(measurements['keff'], measurements_ext[1]), \
+        "Measured coordinates do not match."
+    assert np.allclose(measurements['nmodes'], measurements_ext[2]), \
+        "Measured mode counts do not match."
+    assert np.allclose(
+        measurements['pk_raw'],
+        measurements_ext[3] + 1j * measurements_ext[4]
+    ), "Measured raw statistics do not match."
+    assert np.allclose(
+        measurements['pk_shot'],
+        measurements_ext[5] + 1j * measurements_ext[6],
+        atol=1.e-6
+    ), "Measured shot noise contributions do not match."
+
+    assert "Mesh number: [64, 64, 64]" in measurements['header'], \
+        "Header text is not read."
+    assert measurements['profile']['binning']['ncalls'] == 1, \
+        "Stage profile is not read."
+
+
+def test_read_binary_measurements_invalid(test_stats_dir, tmp_path):
+
+    with pytest.raises(ValueError, match="Not a binary measurement file"):
+        read_binary_measurements(test_stats_dir/"pk0_lpp.txt")
+
+    truncated_file = tmp_path/"pk0_truncated.bin"
+    truncated_file.write_bytes(
+        (test_stats_dir/"pk0_lpp.bin").read_bytes()[:-8]
+    )
+    with pytest.raises(ValueError, match="truncated"):
+        read_binary_measurements(truncated_file)
@@ -4,6 +4,10 @@
 import numpy as np
 import pytest
 
+from triumvirate._field import (
+    _calc_shotnoise_aliasing_interlaced,
+    _execute_pruned_transform
+)
 from triumvirate.fieldmesh import record_binned_vectors
 
 
@@ -73,3 +77,253 @@ def test_record_binned_vectors(case, statistic_type, count, last_entry,
             "The last entry of binned vectors has "
             f"incorrect '{name}' field value."
         )
+
+
+@pytest.mark.parametrize("space", ['fourier', 'config'])
+@pytest.mark.parametrize(
+    "boxsize, ngrid",
+    [
+        (500., 64),
+        ((1000., 800., 600.), (32, 24, 20)),
+    ]
+)
+def test_record_binned_vectors_order(space, boxsize, ngrid,
+                                     test_binning_fourier,
+                                     test_binning_config):
+
+    binning = test_binning_fourier if space == 'fourier' \
+        else test_binning_config
+
+    binned_vectors = record_binned_vectors(
+        binning, boxsize=boxsize, ngrid=ngrid
+    )
+
+    # Reproduce the previous recording, which scanned the bins for the
+    # vector in each mesh grid cell and then sorted the vectors by bin.
+    # A stable sort fixes the order within each bin to the mesh grid
+    # order, which the parallel placement passes preserve regardless of
+    # the thread count.
+    boxsize = np.broadcast_to(boxsize, 3).astype(float)
+    ngrid = np.broadcast_to(ngrid, 3)
+    if space == 'fourier':
+        cellsizes = 2*np.pi / boxsize
+    else:
+        cellsizes = boxsize / ngrid
+
+    idx_grid = np.meshgrid(*map(np.arange, ngrid), indexing='ij')
+    vecs = [
+        np.where(
+            idx_grid[iaxis] < ngrid[iaxis] // 2,
+            idx_grid[iaxis], idx_grid[iaxis] - ngrid[iaxis]
+        ).ravel() * cellsizes[iaxis]
+        for iaxis in range(3)
+    ]
+    scales = np.sqrt(vecs[0] * vecs[0] + vecs[1] * vecs[1] + vecs[2] * vecs[2])
+
+    bin_edges = np.asarray(binning.bin_edges)
+    indices = np.searchsorted(bin_edges, scales, side='right') - 1
+    in_range = (indices >= 0) & (indices < binning.num_bins)
+    sorting = np.argsort(indices[in_range], kind='stable')
+
+    indices_ref = indices[in_range][sorting]
+    vecs_ref = [vec[in_range][sorting] for vec in vecs]
+
+    assert len(binned_vectors) == len(indices_ref), \
+        "Binned vectors have incorrect count."
+    assert np.array_equal(binned_vectors['index'], indices_ref), \
+        "Binned vectors are not in bin order."
+    assert np.array_equal(
+        binned_vectors['lower_edge'], bin_edges[indices_ref]
+    ), "Binned vectors have incorrect lower bin edges."
+    assert np.array_equal(
+        binned_vectors['upper_edge'], bin_edges[indices_ref + 1]
+    ), "Binned vectors have incorrect upper bin edges."
+    for iaxis, axis in enumerate('xyz'):
+        assert np.array_equal(
+            binned_vectors[f'vec{axis}'], vecs_ref[iaxis]
+        ), f"Binned vectors have incorrect '{axis}'-components or order."
+
+
+@pytest.mark.parametrize("assignment", ['ngp', 'cic', 'tsc', 'pcs'])
+@pytest.mark.parametrize("interlace", [False, 2, 3, 4])
+def test_calc_shotnoise_aliasing_interlaced(assignment, interlace,
+                                            test_paramset):
+
+    ngrid = 16
+    test_paramset.update(
+        ngrid={'x': ngrid, 'y': ngrid, 'z': ngrid},
+        assignment=assignment,
+        interlace=interlace
+    )
+
+    assignment_order = ['ngp', 'cic', 'tsc', 'pcs'].index(assignment) + 1
+    interlace_order = interlace or 1
+
+    # Directly sum the squared assignment window over aliased images
+    # `n` (truncated at `nmax` per axis) satisfying the interlacing
+    # condition n_x + n_y + n_z = 0 (mod N), by grouping the images
+    # in each dimension into their residue classes.
+    nmax = 10**6
+    n = np.arange(-nmax, nmax + 1)
+
+    def _sum_by_residue(idx):
+        u = idx / ngrid if idx < ngrid // 2 else idx / ngrid - 1
+        win2 = np.sinc(u + n) ** (2 * assignment_order)
+        return np.array([
+            np.sum(win2[n % interlace_order == r])
+            for r in range(interlace_order)
+        ])
+
+    idx_samples = [0, 1, 3, 5, 8, 11, 15]
+    sums_by_residue = {idx: _sum_by_residue(idx) for idx in idx_samples}
+
+    indices = np.array([
+        (i, j, k)
+        for i in idx_samples for j in idx_samples for k in idx_samples
+    ])
+    aliasing_direct = np.array([
+        sum(
+            sums_by_residue[i][rx] * sums_by_residue[j][ry]
+            * sums_by_residue[k][(- rx - ry) % interlace_order]
+            for rx in range(interlace_order)
+            for ry in range(interlace_order)
+        )
+        for (i, j, k) in indices
+    ])
+
+    aliasing = _calc_shotnoise_aliasing_interlaced(test_paramset, indices)
+
+    assert np.allclose(aliasing, aliasing_direct, rtol=1.e-6, atol=1.e-12), \
+        "Shot-noise aliasing does not match the direct aliasing sum."
+
+
+def _get_pruned_pencils(ngrid, boxsize, k_max):
+    """Mirror the pencil blocks kept by pruned transforms.
+
+    """
+    dk = 2 * np.pi / np.asarray(boxsize)
+
+    # Blocks of adjacent pencils along the z-axis are transformed together.
+    nblock = next(nb for nb in [8, 4, 2, 1] if ngrid[2] % nb == 0)
+
+    kvecs = [
+        np.where(idx < n // 2, idx, idx - n) * dk_
+        for idx, n, dk_ in zip(map(np.arange, ngrid), ngrid, dk)
+    ]
+    k_prune = k_max + np.max(dk)
+    in_cylinder = \
+        kvecs[1][:, None]**2 + kvecs[2][None, :]**2 <= k_prune**2
+
+    active_jk = in_cylinder.reshape(
+        ngrid[1], ngrid[2] // nblock, nblock
+    ).any(axis=-1)
+    active_k = active_jk.any(axis=0)
+
+    # Pruning falls back to the full transform if too few pencils are
+    # skipped.
+    executed = active_jk.mean() + active_k.mean() < 1.5
+
+    return executed, np.repeat(active_jk, nblock, axis=-1), kvecs
+
+
+@pytest.mark.parametrize(
+    "ngrid",
+    [
+        (32, 32, 32),  # cubic
+        (32, 24, 20),  # non-cubic, not divisible by 8
+        (24, 30, 18),  # not divisible by 4
+        (20, 16, 15),  # odd
+    ]
+)
+@pytest.mark.parametrize("k_frac", [0.3, 0.55, 0.8, 1.8])
+def test_execute_pruned_transform(ngrid, k_frac, test_paramset):
+
+    boxsize = (1000., 800., 600.)
+    test_paramset.update(
+        boxsize=dict(zip(['x', 'y', 'z'], boxsize)),
+        ngrid=dict(zip(['x', 'y', 'z'], ngrid))
+    )
+
+    # Set the maximum wavenumber as a fraction of the smallest Nyquist
+    # wavenumber.
+    k_max = k_frac * np.min(np.pi * np.asarray(ngrid) / boxsize)
+    executed_expected, active_x, kvecs = \
+        _get_pruned_pencils(ngrid, boxsize, k_max)
+    kmag = np.sqrt(
+        kvecs[0][:, None, None]**2
+        + kvecs[1][None, :, None]**2
+        + kvecs[2][None, None, :]**2
+    )
+
+    rng = np.random.default_rng(42)
+    field = rng.standard_normal(ngrid) + 1j * rng.standard_normal(ngrid)
+
+    # Forward transform: modes inside the sphere and on kept pencils
+    # match the full transform, and skipped pencils are zero.
+    executed, field_fwd = _execute_pruned_transform(
+        test_paramset, field, k_max
+    )
+    assert executed == executed_expected, \
+        "Pruned forward transform does not fall back as expected."
+
+    if executed:
+        field_fwd_full = np.fft.fftn(field)
+        atol = 1.e-12 * np.max(np.abs(field_fwd_full))
+        assert np.allclose(
+            field_fwd[kmag <= k_max], field_fwd_full[kmag <= k_max],
+            rtol=1.e-12, atol=atol
+        ), "Pruned forward transform does not match inside the sphere."
+        assert np.allclose(
+            field_fwd[:, active_x], field_fwd_full[:, active_x],
+            rtol=1.e-12, atol=atol
+        ), "Pruned forward transform does not match on kept pencils."
+        assert np.all(field_fwd[:, ~active_x] == 0.), \
+            "Pruned forward transform is not zero on skipped pencils."
+    else:
+        assert np.array_equal(field_fwd, field), \
+            "Field is modified when pruning falls back."
+
+    # Inverse transform: a field vanishing outside the sphere is
+    # transformed exactly.
+    field_bl = np.where(kmag <= k_max, field, 0.)
+    executed, field_inv = _execute_pruned_transform(
+        test_paramset, field_bl, k_max, inverse=True
+    )
+    assert executed == executed_expected, \
+        "Pruned inverse transform does not fall back as expected."
+
+    if executed:
+        field_inv_full = np.fft.ifftn(field_bl) * np.prod(ngrid)
+        assert np.allclose(
+            field_inv, field_inv_full,
+            rtol=1.e-12, atol=1.e-12 * np.max(np.abs(field_inv_full))
+        ), "Pruned inverse transform does not match the full transform."
+    else:
+        assert np.array_equal(field_inv, field_bl), \
+            "Field is modified when pruning falls back."
+
+
+@pytest.mark.parametrize("k_max", [0., -0.1, 1.])
+def test_execute_pruned_transform_fallback(k_max, test_paramset):
+
+    ngrid = 32
+    test_paramset.update(
+        boxsize={'x': 1000., 'y': 1000., 'z': 1000.},
+        ngrid={'x': ngrid, 'y': ngrid, 'z': ngrid}
+    )
+
+    # Pruning is off for non-positive maximum wavenumbers and falls
+    # back to the full transform beyond the Nyquist wavenumber.
+    field = np.ones((ngrid,) * 3, dtype=complex)
+    for inverse in [False, True]:
+        executed, field_out = _execute_pruned_transform(
+            test_paramset, field, k_max, inverse=inverse
+        )
+        assert not executed, "Pruned transform does not fall back."
+        assert np.array_equal(field_out, field), \
+            "Field is modified when pruning falls back."
+
+    with pytest.raises(ValueError):
+        _execute_pruned_transform(
+            test_paramset, np.ones((ngrid, ngrid, ngrid // 2)), 0.1
+        )
@@ -7,9 +7,11 @@ from collections.abc import Collection, Sequence
 from copy import deepcopy
 from pprint import pformat
 
+import numpy as np
 import pytest
 import yaml
 
+from triumvirate._field import _ret_grid_index
 from triumvirate.parameters import (
     InvalidParameterError,
     ParameterSet,
@@ -327,6 +329,60 @@ def test_ParameterSet___setitem__(param_name, param_value, valid_paramset):
         "Parameter set value setting failed."
 
 
+def test_ParameterSet_interlace_reset(valid_paramset):
+
+    # Interlacing is disabled for three-point statistics.
+    valid_paramset['statistic_type'] = 'powspec'
+
+    # Resetting the interlacing switch on the same parameter set should
+    # not retain the interlacing order from a previous setting.
+    for interlace, interlace_readback in [
+        (3, 3), (True, True), (4, 4), (False, False),
+        (3, 3), ('on', True), (2, True), (1, False),
+    ]:
+        valid_paramset['interlace'] = interlace
+        assert valid_paramset['interlace'] == interlace_readback, \
+            "Interlacing reset on the same parameter set failed."
+
+
+# Mesh grid numbers whose products exceed 2^31 (e.g. 2048^3 = 2^33 wraps
+# to zero in 32-bit arithmetic); only indices are derived, so no mesh
+# memory is allocated.
+@pytest.mark.parametrize(
+    "ngrid",
+    [
+        {'x': 1291, 'y': 1291, 'z': 1291},
+        {'x': 2048, 'y': 2048, 'z': 2048},
+        {'x': 4096, 'y': 4096, 'z': 256},
+    ]
+)
+def test_ParameterSet_large_nmesh(ngrid, valid_paramset):
+
+    valid_paramset['ngrid'] = ngrid
+
+    assert valid_paramset['ngrid'] == ngrid, \
+        "Parameter set value setting failed for large mesh grid numbers."
+
+    nmesh = np.prod(list(ngrid.values()), dtype=np.int64)
+    assert nmesh > 2**31 and valid_paramset._nmesh == nmesh, \
+        "Mesh grid cell number is not derived in 64-bit integers."
+
+    # The last grid cell index overflows 32-bit integers.
+    for idx_grid, idx_grid_expected in [
+        (_ret_grid_index(valid_paramset, 0, 0, 1), 1),
+        (_ret_grid_index(valid_paramset, 0, 1, 0), ngrid['z']),
+        (_ret_grid_index(valid_paramset, 1, 0, 0), ngrid['y'] * ngrid['z']),
+        (
+            _ret_grid_index(
+                valid_paramset, ngrid['x'] - 1, ngrid['y'] - 1, ngrid['z'] - 1
+            ),
+            nmesh - 1
+        ),
+    ]:
+        assert idx_grid == idx_grid_expected, \
+            "Grid cell index is not derived in 64-bit integers."
+
+
 # Use `default_parameters` fixture to test the valid parameter set.
 def test_ParameterSet__getattr__(valid_paramset, default_parameters):
 
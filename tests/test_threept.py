@@ -1,9 +1,20 @@
 """Test :mod:`~triumvirate.threept`.
 
 """
+import ctypes
+import re
+import threading
+
 import numpy as np
 import pytest
 
+from triumvirate._threept import (
+    _get_tracked_resource_usage,
+    _reset_tracked_resource_usage
+)
+from triumvirate.dataobjs import Binning
+from triumvirate.fieldmesh import MeshFieldCache
+from triumvirate.parameters import ParameterSet
 from triumvirate.threept import (
     compute_3pcf,
     compute_3pcf_in_gpp_box,
@@ -330,3 +341,354 @@ def test_compute_3pcf_window(degrees, form, idx_bin,
         measurements_ext[-2] + 1j * measurements_ext[-1],
         atol=1.e-6
     ), "Measured shot noise contributions do not match."
+
+
+@pytest.mark.slow
+def test_compute_bispec_with_field_cache(test_data_catalogue,
+                                         test_rand_catalogue,
+                                         test_binning_fourier,
+                                         test_param_dir,
+                                         copy_catalogue):
+
+    def _measure(catalogue_data, catalogue_rand, field_cache=None):
+        return compute_bispec(
+            catalogue_data, catalogue_rand,
+            degrees=(2, 0, 2),
+            binning=test_binning_fourier,
+            form='diag',
+            paramset=ParameterSet(
+                param_filepath=test_param_dir/"test_params.yml"
+            ),
+            field_cache=field_cache
+        )
+
+    catalogues_data = [
+        test_data_catalogue, copy_catalogue(test_rand_catalogue, step=7)
+    ]
+
+    field_cache = MeshFieldCache()
+    catalogue_rand = copy_catalogue(test_rand_catalogue)
+    counts_rand_computed = []
+    for catalogue_data in catalogues_data:
+        measurements = _measure(
+            copy_catalogue(catalogue_data), catalogue_rand,
+            field_cache=field_cache
+        )
+        measurements_ref = _measure(
+            copy_catalogue(catalogue_data),
+            copy_catalogue(test_rand_catalogue)
+        )
+
+        assert np.allclose(
+            measurements['bk_raw'], measurements_ref['bk_raw']
+        ), "Measured raw statistics with field cache do not match."
+        assert np.allclose(
+            measurements['bk_shot'], measurements_ref['bk_shot']
+        ), "Measured shot noise contributions with field cache do not match."
+
+        counts_rand_computed.append(field_cache.count_rand_computed)
+
+    assert counts_rand_computed[0] == counts_rand_computed[-1] > 0, \
+        "Random-source fields are not reused."
+
+
+@pytest.mark.slow
+@pytest.mark.parametrize("checkpoint_fields", [False, True])
+def test_compute_bispec_resumed_from_checkpoint(checkpoint_fields,
+                                                test_data_catalogue,
+                                                test_rand_catalogue,
+                                                test_binning_fourier,
+                                                test_param_dir,
+                                                tmp_path,
+                                                capfd,
+                                                copy_catalogue):
+
+    def _measure(checkpoint_dir=None):
+        paramset = ParameterSet(
+            param_filepath=test_param_dir/"test_params.yml"
+        )
+        if checkpoint_dir is not None:
+            paramset['checkpoint_dir'] = str(checkpoint_dir)
+            paramset['checkpoint_fields'] = checkpoint_fields
+
+        measurements = compute_bispec(
+            copy_catalogue(test_data_catalogue),
+            copy_catalogue(test_rand_catalogue),
+            degrees=(2, 0, 2),
+            binning=test_binning_fourier,
+            form='diag',
+            paramset=paramset
+        )
+
+        # Flush C++ logging to the captured output.
+        ctypes.CDLL(None).fflush(None)
+        return measurements, capfd.readouterr().out
+
+    def _snapshot_checkpoint():
+        # Copy the checkpoint files as soon as the first term is
+        # completed, which leaves a partial checkpoint as if the
+        # measurement were interrupted there.
+        while not measured.is_set():
+            if any(checkpoint_dir.glob("trvckpt_*.state")):
+                for filepath in checkpoint_dir.glob("trvckpt_*"):
+                    if filepath.suffix != '.tmp':
+                        snapshot[filepath.name] = filepath.read_bytes()
+                return
+
+    measurements_ref, _ = _measure()
+
+    # The GIL is released during the measurement, so the checkpoint
+    # directory is watched from another Python thread.
+    checkpoint_dir = tmp_path/"checkpoints"
+    snapshot = {}
+    measured = threading.Event()
+    watcher = threading.Thread(target=_snapshot_checkpoint)
+    watcher.start()
+    try:
+        _measure(checkpoint_dir=checkpoint_dir)
+    finally:
+        measured.set()
+        watcher.join()
+
+    assert not any(checkpoint_dir.iterdir()), \
+        "Checkpoint files are not removed after the measurement completes."
+    assert any(filename.endswith('.state') for filename in snapshot), \
+        "No checkpoint state is saved during the measurement."
+    if checkpoint_fields:
+        assert any(filename.endswith('.bin') for filename in snapshot), \
+            "No fields are checkpointed during the measurement."
+
+    # Resume from the partial checkpoint.
+    for filename, content in snapshot.items():
+        (checkpoint_dir/filename).write_bytes(content)
+
+    measurements, log = _measure(checkpoint_dir=checkpoint_dir)
+
+    nterms_completed = int(re.search(
+        r"Resumed from checkpoint with ([0-9]+) completed terms", log
+    ).group(1))
+    nterms_total = nterms_completed + len(re.findall(
+        r"Bispectrum term at orders .* computed", log
+    ))
+    assert 0 < nterms_completed < nterms_total, \
+        "Measurement is not resumed from a partial checkpoint."
+    if checkpoint_fields:
+        assert "Restored checkpointed field" in log, \
+            "Checkpointed fields are not restored."
+
+    assert np.allclose(
+        measurements['nmodes_1'], measurements_ref['nmodes_1']
+    ), "Resumed mode counts do not match the uninterrupted measurement."
+    assert np.allclose(
+        measurements['bk_raw'], measurements_ref['bk_raw'], rtol=1.e-10
+    ), "Resumed raw statistics do not match the uninterrupted measurement."
+    assert np.allclose(
+        measurements['bk_shot'], measurements_ref['bk_shot'], rtol=1.e-10
+    ), "Resumed shot noise contributions do not match " \
+        "the uninterrupted measurement."
+
+    # An invalid checkpoint state is discarded.
+    for filename, content in snapshot.items():
+        if filename.endswith('.state'):
+            (checkpoint_dir/filename).write_bytes(content[:-1])
+
+    measurements, log = _measure(checkpoint_dir=checkpoint_dir)
+
+    assert "Checkpoint state is invalid and discarded" in log, \
+        "Invalid checkpoint state is not discarded."
+    assert np.allclose(
+        measurements['bk_raw'], measurements_ref['bk_raw'], rtol=1.e-10
+    ), "Raw statistics after a discarded checkpoint do not match " \
+        "the uninterrupted measurement."
+
+
+@pytest.mark.slow
+@pytest.mark.parametrize("catalogue_type", ['survey', 'sim'])
+def test_compute_bispec_with_crop_fourier(catalogue_type,
+                                          test_data_catalogue,
+                                          test_rand_catalogue,
+                                          test_param_dir):
+
+    # The bin range is narrowed so that the mesh grid can be cropped.
+    binning = Binning('fourier', 'lin', bin_min=0.005, bin_max=0.05,
+                      num_bins=4)
+
+    def _measure(crop_fourier):
+        paramset = ParameterSet(
+            param_filepath=test_param_dir/"test_params.yml"
+        )
+        paramset['crop_fourier'] = crop_fourier
+        if catalogue_type == 'sim':
+            return compute_bispec_in_gpp_box(
+                test_data_catalogue,
+                degrees=(0, 0, 0),
+                binning=binning,
+                form='diag',
+                paramset=paramset
+            )
+        return compute_bispec(
+            test_data_catalogue, test_rand_catalogue,
+            degrees=(2, 0, 2),
+            binning=binning,
+            form='diag',
+            paramset=paramset
+        )
+
+    measurements = _measure(True)
+    measurements_ref = _measure(False)
+
+    assert np.allclose(
+        measurements['nmodes_1'], measurements_ref['nmodes_1']
+    ), "Measured mode counts with Fourier cropping do not match."
+    assert np.allclose(
+        measurements['bk_raw'], measurements_ref['bk_raw'], rtol=1.e-8
+    ), "Measured raw statistics with Fourier cropping do not match."
+    assert np.allclose(
+        measurements['bk_shot'], measurements_ref['bk_shot']
+    ), "Measured shot noise contributions with Fourier cropping do not match."
+
+
+@pytest.mark.slow
+@pytest.mark.parametrize("schedule", ['task', 'pipeline'])
+@pytest.mark.parametrize("tight_budget", [False, True])
+def test_compute_bispec_bin_pair_schedule(schedule, tight_budget,
+                                          test_data_catalogue,
+                                          test_rand_catalogue,
+                                          test_binning_fourier,
+                                          test_param_dir,
+                                          capfd):
+
+    def _measure(schedule, memory_budget=None):
+        paramset = ParameterSet(
+            param_filepath=test_param_dir/"test_params.yml"
+        )
+        paramset['task_parallel'] = (schedule == 'task')
+        paramset['pipeline'] = (schedule == 'pipeline')
+        if memory_budget is not None:
+            paramset['memory_budget'] = memory_budget
+
+        measurements = compute_bispec(
+            test_data_catalogue, test_rand_catalogue,
+            degrees=(0, 0, 0),
+            binning=test_binning_fourier,
+            form='full',
+            paramset=paramset
+        )
+
+        # Flush C++ logging to the captured output.
+        ctypes.CDLL(None).fflush(None)
+        return measurements, capfd.readouterr().out
+
+    measurements_ref, log_ref = _measure('loop')
+    assert "scheduled with loop-level parallelism" in log_ref, \
+        "Bin pairs are not scheduled with loop-level parallelism."
+
+    # Set the memory budget just above the estimated peak memory usage
+    # (which is logged to three decimal places) so that additional
+    # fields for other threads would exceed it.
+    if tight_budget:
+        memory_budget = float(re.search(
+            r"Estimated peak memory usage for bispectrum measurement: "
+            r"([0-9.]+) gigabytes", log_ref
+        ).group(1)) + 5.e-4
+    else:
+        memory_budget = None
+
+    measurements, log = _measure(schedule, memory_budget=memory_budget)
+    if "unavailable without OpenMP" in log:
+        pytest.skip("Bin-pair scheduling is unavailable without OpenMP.")
+
+    # Task-level scheduling only needs additional fields for threads
+    # other than the calling one, whereas pipelining always needs them.
+    nthreads = measurements['profile']['fft']['nthreads']
+    if tight_budget and (schedule == 'pipeline' or nthreads > 1):
+        assert "would exceed the memory budget" in log, \
+            "Bin-pair scheduling does not fall back within memory budget."
+        assert "scheduled with loop-level parallelism" in log, \
+            "Bin pairs are not scheduled with loop-level parallelism."
+    else:
+        schedule_name = {'task': 'task-level', 'pipeline': 'pipelined'}
+        assert f"scheduled with {schedule_name[schedule]} parallelism" \
+            in log, f"Bin pairs are not scheduled as forced: {schedule}."
+
+    assert np.allclose(
+        measurements['nmodes_1'], measurements_ref['nmodes_1']
+    ), "Measured mode counts do not match the loop schedule."
+    assert np.allclose(
+        measurements['bk_raw'], measurements_ref['bk_raw'], rtol=1.e-10
+    ), "Measured raw statistics do not match the loop schedule."
+    assert np.allclose(
+        measurements['bk_shot'], measurements_ref['bk_shot'], rtol=1.e-10
+    ), "Measured shot noise contributions do not match the loop schedule."
+
+
+@pytest.mark.slow
+@pytest.mark.parametrize("schedule", ['task', 'pipeline'])
+def test_compute_bispec_worker_tracking(schedule,
+                                        test_data_catalogue,
+                                        test_rand_catalogue,
+                                        test_binning_fourier,
+                                        test_param_dir,
+                                        capfd):
+
+    # Use a mesh grid large enough for the fields of worker threads to
+    # dominate the peak memory usage.
+    ngrid = 128
+    gbytes_pair = 2 * ngrid**3 * 16 / 1024**3
+
+    def _measure(schedule):
+        paramset = ParameterSet(
+            param_filepath=test_param_dir/"test_params.yml"
+        )
+        paramset['ngrid'] = {'x': ngrid, 'y': ngrid, 'z': ngrid}
+        paramset['task_parallel'] = (schedule == 'task')
+        paramset['pipeline'] = (schedule == 'pipeline')
+
+        _reset_tracked_resource_usage()
+        measurements = compute_bispec(
+            test_data_catalogue, test_rand_catalogue,
+            degrees=(0, 0, 0),
+            binning=test_binning_fourier,
+            form='full',
+            paramset=paramset
+        )
+        usage = _get_tracked_resource_usage()
+
+        # Flush C++ logging to the captured output.
+        ctypes.CDLL(None).fflush(None)
+        return measurements['profile'], usage, capfd.readouterr().out
+
+    profile_ref, usage_ref, _ = _measure('loop')
+    profile, usage, log = _measure(schedule)
+    if "unavailable without OpenMP" in log:
+        pytest.skip("Bin-pair scheduling is unavailable without OpenMP.")
+
+    nthreads = profile['fft']['nthreads']
+    if nthreads < 2:
+        pytest.skip("Worker threads are unavailable with a single thread.")
+
+    # (I)FFTs of worker threads are counted on the calling thread, and
+    # each bin pair is filled at least as often as in the loop schedule.
+    assert usage['count_fft'] + usage['count_ifft'] \
+        == profile['fft']['ncalls'], \
+        "(I)FFT counts do not match the stage profile."
+    assert usage['count_fft'] == usage_ref['count_fft'], \
+        "FFT counts do not match the loop schedule."
+    assert usage['count_ifft'] >= usage_ref['count_ifft'], \
+        "IFFT counts of worker threads are missing."
+
+    # Each worker thread holds its own pair of fields in task-level
+    # scheduling, and pipelining holds a second pair of fields.
+    if schedule == 'task':
+        gbytes_extra = (nthreads - 1) * gbytes_pair
+    else:
+        gbytes_extra = gbytes_pair
+    gbytes_region = profile_ref['reduction']['gbytes_mem'] + gbytes_extra
+
+    assert usage['gbytes_max'] == pytest.approx(
+        max(usage_ref['gbytes_max'], gbytes_region)
+    ), "Peak memory usage does not include fields of worker threads."
+    if schedule == 'pipeline':
+        assert profile['reduction']['gbytes_mem'] == pytest.approx(
+            gbytes_region
+        ), "Stage peak memory usage does not include the calling thread."
@@ -1,6 +1,8 @@
 """Test :mod:`~triumvirate.transforms`.
 
 """
+from concurrent.futures import ThreadPoolExecutor
+
 import numpy as np
 import pytest
 from scipy.special import gamma
@@ -85,6 +87,79 @@ def test_hankeltransform(order, bias, nsamp, lgrange_samp, extrap,
     ), "Transform not accurate in the expected range."
 
 
+@pytest.mark.parametrize(
+    "order, bias, nsamp, lgrange_samp, extrap, hankel_func_pair",
+    [
+        (2, 0, 2**10, [-5., 5.], 0, 'sym'),
+        (0, 0, 2**11, [-5., 5.], 3, 'asym'),
+    ],
+    indirect=['hankel_func_pair',]
+)
+def test_hankeltransform_batch(order, bias, nsamp, lgrange_samp, extrap,
+                               hankel_func_pair):
+
+    f, _ = hankel_func_pair
+
+    pre_sampts = np.logspace(*lgrange_samp, nsamp, base=10, endpoint=False)
+    transformer = HankelTransform(
+        order, bias, pre_sampts, kr_c=1., lowring=True, extrap=extrap
+    )
+
+    pre_samples = np.outer([1., 2., 3.], f(pre_sampts, mu=order))
+    post_samples = np.asarray([
+        transformer.transform(pre_samples_row)[1]
+        for pre_samples_row in pre_samples
+    ])
+
+    _, post_samples_batch = transformer.transform_batch(pre_samples)
+    assert np.allclose(
+        post_samples_batch, post_samples.real,
+        rtol=1.e-10, atol=1.e-10 * np.abs(post_samples).max()
+    ), "Batched transform does not match single transforms."
+
+    _, post_samples_batch = \
+        transformer.transform_batch(pre_samples * (1. + 2.j))
+    assert np.allclose(
+        post_samples_batch, post_samples.real * (1. + 2.j),
+        rtol=1.e-10, atol=1.e-10 * np.abs(post_samples).max()
+    ), "Batched transform of complex samples is incorrect."
+
+
+def test_hankeltransform_batch_concurrent():
+
+    nsamp = 2**10
+    pre_sampts = np.logspace(-5., 5., nsamp, base=10, endpoint=False)
+    transformer = HankelTransform(
+        0, 0, pre_sampts, kr_c=1., lowring=True, extrap=3
+    )
+
+    # Batches of different sizes make concurrent calls replan the shared
+    # batched transform.
+    rng = np.random.default_rng(42)
+    pre_samples_batches = [
+        rng.uniform(0.5, 2., (nbatch, 1)) / (1. + pre_sampts**2)
+        for nbatch in [1, 2, 3, 5, 8, 13] * 4
+    ]
+    post_samples_batches = [
+        transformer.transform_batch(pre_samples)[1]
+        for pre_samples in pre_samples_batches
+    ]
+
+    with ThreadPoolExecutor(max_workers=8) as executor:
+        post_samples_batches_concurrent = list(executor.map(
+            lambda pre_samples: transformer.transform_batch(pre_samples)[1],
+            pre_samples_batches
+        ))
+
+    for post_samples, post_samples_concurrent in zip(
+        post_samples_batches, post_samples_batches_concurrent
+    ):
+        assert np.allclose(
+            post_samples_concurrent, post_samples,
+            rtol=1.e-12, atol=1.e-12 * np.abs(post_samples).max()
+        ), "Concurrent batched transforms do not match serial ones."
+
+
 @pytest.mark.parametrize(
     "degree, bias, nsamp, lgrange_samp, extrap, sj_func_pair, lgrange_test",
     [
@@ -121,15 +196,18 @@ def test_sphericalbesseltransform(degree, bias, nsamp, lgrange_samp, extrap,
 
 
 @pytest.mark.parametrize(
-    "degrees, biases, nsamp, lgrange_samp, extrap, sj_func_pair, lgrange_test",
+    "degrees, biases, nsamp, lgrange_samp, extrap, extrap2d, sj_func_pair, "
+    "lgrange_test",
     [
-        ((0, 0), (0, 0), 2**10, [-5., 5.], 0, 'sym', [-3., 0.]),
-        ((2, 2), (0, 0), 2**11, [-5., 5.], 3, 'asym', [-.5, 3.]),
+        ((0, 0), (0, 0), 2**10, [-5., 5.], 0, False, 'sym', [-3., 0.]),
+        ((2, 2), (0, 0), 2**11, [-5., 5.], 3, False, 'asym', [-.5, 3.]),
+        ((2, 2), (0, 0), 2**11, [-5., 5.], 3, True, 'asym', [-.5, 3.]),
     ],
     indirect=['sj_func_pair',]
 )
 def test_doublesphericalbesseltransform(degrees, biases, nsamp, lgrange_samp,
-                                        extrap, sj_func_pair, lgrange_test):
+                                        extrap, extrap2d, sj_func_pair,
+                                        lgrange_test):
 
     f, g = sj_func_pair
 
@@ -140,7 +218,8 @@ def test_doublesphericalbesseltransform(degrees, biases, nsamp, lgrange_samp,
     pre_samples = pre_samples_1[:, None] * pre_samples_2[None, :]
 
     transformer = DoubleSphericalBesselTransform(
-        degrees, biases, pre_sampts, lowring=True, extrap=extrap
+        degrees, biases, pre_sampts, lowring=True, extrap=extrap,
+        extrap2d=extrap2d
     )
 
     # Test only
@@ -1,15 +1,20 @@
 """Test :mod:`~triumvirate.twopt`.
 
 """
+from concurrent.futures import ThreadPoolExecutor
+
 import numpy as np
 import pytest
 
+from triumvirate.fieldmesh import MeshFieldCache
+from triumvirate.parameters import ParameterSet
 from triumvirate.twopt import (
     compute_corrfunc,
     compute_corrfunc_in_gpp_box,
     compute_corrfunc_window,
     compute_powspec,
-    compute_powspec_in_gpp_box
+    compute_powspec_in_gpp_box,
+    compute_powspec_kmu_in_gpp_box
 )
 
 
@@ -131,6 +136,56 @@ def test_compute_powspec_in_gpp_box(degree,
     ), "Measured shot noise contributions do not match."
 
 
+@pytest.mark.slow
+def test_compute_powspec_kmu_in_gpp_box(test_data_catalogue,
+                                        test_binning_fourier,
+                                        test_paramset,
+                                        test_logger,
+                                        test_stats_dir):
+
+    measurements = compute_powspec_kmu_in_gpp_box(
+        test_data_catalogue,
+        degrees=[0, 2],
+        num_wedges=4,
+        binning=test_binning_fourier,
+        paramset=test_paramset,
+        logger=test_logger
+    )
+
+    for idx_ell, degree in enumerate([0, 2]):
+        measurements_ext = np.loadtxt(
+            test_stats_dir/f"pk{degree}_gpp.txt", unpack=True
+        )
+
+        assert np.allclose(measurements['keff'], measurements_ext[1]), \
+            "Measured coordinates do not match."
+        assert np.allclose(measurements['nmodes'], measurements_ext[2]), \
+            "Measured mode counts do not match."
+        assert np.allclose(
+            measurements['pk_raw'][idx_ell],
+            measurements_ext[3] + 1j * measurements_ext[4]
+        ), "Measured raw statistics do not match."
+        assert np.allclose(
+            measurements['pk_shot'][idx_ell],
+            measurements_ext[5] + 1j * measurements_ext[6],
+            atol=1.e-6
+        ), "Measured shot noise contributions do not match."
+
+    # The mode-weighted average of the wedges is the monopole.
+    nmodes_wedges = measurements['nmodes_wedges']
+    assert np.array_equal(nmodes_wedges.sum(axis=0), measurements['nmodes']), \
+        "Wedge mode counts do not add up."
+    assert np.allclose(
+        (nmodes_wedges * measurements['pk_raw_wedges']).sum(axis=0)
+        / measurements['nmodes'],
+        measurements['pk_raw'][0]
+    ), "Measured wedges do not average to the monopole."
+    assert np.all(
+        (measurements['mueff_wedges'] >= measurements['mu_edges'][:-1, None])
+        & (measurements['mueff_wedges'] <= measurements['mu_edges'][1:, None])
+    ), "Measured wedge coordinates are out of range."
+
+
 @pytest.mark.slow
 @pytest.mark.parametrize(
     "degree",
@@ -205,3 +260,376 @@ def test_compute_corrfunc_window(degree,
         measurements['xi'],
         measurements_ext[3] + 1j * measurements_ext[4]
     ), "Measured statistics do not match."
+
+
+@pytest.mark.slow
+def test_compute_powspec_in_gpp_box_concurrent(test_data_catalogue,
+                                               test_binning_fourier,
+                                               test_param_dir,
+                                               test_stats_dir,
+                                               copy_catalogue):
+
+    # Each thread measures from its own catalogue and parameter set
+    # as both are modified in place during the measurement.
+    def _measure(_):
+        paramset = ParameterSet(
+            param_filepath=test_param_dir/"test_params.yml"
+        )
+        return compute_powspec_in_gpp_box(
+            copy_catalogue(test_data_catalogue),
+            degree=0,
+            binning=test_binning_fourier,
+            paramset=paramset
+        )
+
+    with ThreadPoolExecutor(max_workers=2) as executor:
+        measurements_list = list(executor.map(_measure, range(2)))
+
+    measurements_ext = np.loadtxt(test_stats_dir/"pk0_gpp.txt", unpack=True)
+
+    for measurements in measurements_list:
+        assert np.allclose(measurements['nmodes'], measurements_ext[2]), \
+            "Measured mode counts do not match."
+        assert np.allclose(
+            measurements['pk_raw'],
+            measurements_ext[3] + 1j * measurements_ext[4]
+        ), "Measured raw statistics do not match."
+
+
+@pytest.mark.slow
+def test_compute_powspec_with_field_cache(test_data_catalogue,
+                                          test_rand_catalogue,
+                                          test_binning_fourier,
+                                          test_param_dir,
+                                          copy_catalogue):
+
+    def _measure(catalogue_data, catalogue_rand, field_cache=None):
+        return compute_powspec(
+            catalogue_data, catalogue_rand,
+            degree=2,
+            binning=test_binning_fourier,
+            paramset=ParameterSet(
+                param_filepath=test_param_dir/"test_params.yml"
+            ),
+            field_cache=field_cache
+        )
+
+    catalogues_data = [
+        test_data_catalogue, copy_catalogue(test_rand_catalogue, step=7)
+    ]
+
+    field_cache = MeshFieldCache()
+    catalogue_rand = copy_catalogue(test_rand_catalogue)
+    counts_rand_computed = []
+    for catalogue_data in catalogues_data:
+        measurements = _measure(
+            copy_catalogue(catalogue_data), catalogue_rand,
+            field_cache=field_cache
+        )
+        measurements_ref = _measure(
+            copy_catalogue(catalogue_data),
+            copy_catalogue(test_rand_catalogue)
+        )
+
+        assert np.allclose(
+            measurements['pk_raw'], measurements_ref['pk_raw']
+        ), "Measured raw statistics with field cache do not match."
+        assert np.allclose(
+            measurements['pk_shot'], measurements_ref['pk_shot']
+        ), "Measured shot noise contributions with field cache do not match."
+
+        counts_rand_computed.append(field_cache.count_rand_computed)
+
+    assert counts_rand_computed[0] == counts_rand_computed[-1] > 0, \
+        "Random-source fields are not reused."
+
+    with pytest.raises(ValueError):
+        _measure(
+            copy_catalogue(test_data_catalogue),
+            copy_catalogue(test_rand_catalogue),
+            field_cache=field_cache
+        )
+
+
+@pytest.mark.slow
+def test_compute_powspec_with_persisted_field_cache(test_data_catalogue,
+                                                    test_rand_catalogue,
+                                                    test_binning_fourier,
+                                                    test_param_dir,
+                                                    tmp_path,
+                                                    copy_catalogue):
+
+    def _measure(field_cache=None, **params):
+        paramset = ParameterSet(
+            param_filepath=test_param_dir/"test_params.yml"
+        )
+        paramset.update(params)
+        return compute_powspec(
+            copy_catalogue(test_data_catalogue),
+            copy_catalogue(test_rand_catalogue),
+            degree=2,
+            binning=test_binning_fourier,
+            paramset=paramset,
+            field_cache=field_cache
+        )
+
+    def _list_files():
+        return sorted(cache_dir.glob("trvmesh_*.bin"))
+
+    measurements_ref = _measure()
+
+    # Each run uses a new cache over the same on-disk cache directory, as
+    # a later session would.  Between runs, the cached files are first
+    # left unchanged and then their headers are corrupted (by changing
+    # the format version), so that they are rejected and overwritten.
+    cache_dir = tmp_path/"mesh_cache"
+    for run in ['miss', 'hit', 'header_mismatch', 'hit_after_rewrite']:
+        if run == 'header_mismatch':
+            for filepath in _list_files():
+                with open(filepath, 'r+b') as cache_file:
+                    cache_file.seek(8)  # after the magic string
+                    cache_file.write(np.int32(-1).tobytes())
+
+        field_cache = MeshFieldCache(cache_dir=cache_dir)
+        measurements = _measure(field_cache)
+
+        assert np.allclose(
+            measurements['pk_raw'], measurements_ref['pk_raw'], rtol=1.e-12
+        ), f"Measured raw statistics do not match ({run})."
+        assert np.allclose(
+            measurements['pk_shot'], measurements_ref['pk_shot'],
+            rtol=1.e-12
+        ), f"Measured shot noise contributions do not match ({run})."
+
+        nfiles = len(_list_files())
+        if run in ['miss', 'header_mismatch']:
+            assert field_cache.count_rand_loaded == 0, \
+                f"Random-source fields are loaded from disk ({run})."
+            assert field_cache.count_rand_computed == nfiles > 0, \
+                f"Random-source fields are not saved to disk ({run})."
+        else:
+            assert field_cache.count_rand_loaded == nfiles > 0, \
+                f"Random-source fields are not loaded from disk ({run})."
+            assert field_cache.count_rand_computed == 0, \
+                f"Random-source fields are recomputed ({run})."
+
+    # Changed sampling parameters miss the cached files.
+    field_cache = MeshFieldCache(cache_dir=cache_dir)
+    _measure(field_cache, assignment='cic')
+
+    assert field_cache.count_rand_loaded == 0, \
+        "Random-source fields with changed sampling are loaded from disk."
+    assert len(_list_files()) == nfiles + field_cache.count_rand_computed, \
+        "Random-source fields with changed sampling are not saved to disk."
+
+
+@pytest.mark.slow
+def test_compute_powspec_with_global_los_axis(test_data_catalogue,
+                                              test_rand_catalogue,
+                                              test_binning_fourier,
+                                              test_param_dir,
+                                              tmp_path,
+                                              copy_catalogue):
+
+    def _measure(los_data, los_rand, field_cache=None):
+        return compute_powspec(
+            copy_catalogue(test_data_catalogue),
+            copy_catalogue(test_rand_catalogue),
+            los_data=los_data, los_rand=los_rand,
+            degree=2,
+            binning=test_binning_fourier,
+            paramset=ParameterSet(
+                param_filepath=test_param_dir/"test_params.yml"
+            ),
+            field_cache=field_cache
+        )
+
+    los_axis = np.array([1., 2., 2.]) / 3.
+
+    measurements_ref = _measure(
+        np.tile(los_axis, (len(test_data_catalogue), 1)),
+        np.tile(los_axis, (len(test_rand_catalogue), 1))
+    )
+
+    # The global axis is also recorded in the keys of persisted
+    # random-source fields, which are loaded back in the second run.
+    cache_dir = tmp_path/"mesh_cache"
+    for run in ['miss', 'hit']:
+        field_cache = MeshFieldCache(cache_dir=cache_dir)
+        measurements = _measure(los_axis, los_axis, field_cache=field_cache)
+
+        assert np.allclose(
+            measurements['pk_raw'], measurements_ref['pk_raw'], rtol=1.e-12
+        ), f"Measured raw statistics do not match ({run})."
+        assert np.allclose(
+            measurements['pk_shot'], measurements_ref['pk_shot'],
+            rtol=1.e-12
+        ), f"Measured shot noise contributions do not match ({run})."
+
+        if run == 'miss':
+            assert field_cache.count_rand_loaded == 0, \
+                "Random-source fields are loaded from disk."
+        else:
+            assert field_cache.count_rand_loaded > 0, \
+                "Random-source fields are not loaded from disk."
+
+    # A different global axis misses the cached files.
+    field_cache = MeshFieldCache(cache_dir=cache_dir)
+    _measure(los_axis[::-1], los_axis[::-1], field_cache=field_cache)
+
+    assert field_cache.count_rand_loaded == 0, \
+        "Random-source fields along a different axis are loaded from disk."
+
+    with pytest.raises(ValueError):
+        _measure(np.zeros(3), None)
+
+
+@pytest.mark.slow
+@pytest.mark.parametrize("interlace", [False, True, 3])
+@pytest.mark.parametrize("degree", [2, 4])
+def test_compute_powspec_cartesian(degree,
+                                   interlace,
+                                   test_data_catalogue,
+                                   test_rand_catalogue,
+                                   test_binning_fourier,
+                                   test_param_dir,
+                                   copy_catalogue):
+
+    measurements_dict = {}
+    for estimator in ['ylm', 'cartesian']:
+        paramset = ParameterSet(
+            param_filepath=test_param_dir/"test_params.yml"
+        )
+        paramset['interlace'] = interlace
+        paramset['powspec_estimator'] = estimator
+
+        measurements_dict[estimator] = compute_powspec(
+            copy_catalogue(test_data_catalogue),
+            copy_catalogue(test_rand_catalogue),
+            degree=degree,
+            binning=test_binning_fourier,
+            paramset=paramset
+        )
+
+    # Shot noise contributions which vanish analytically are compared
+    # on the scale of the raw statistics.
+    measurements = measurements_dict['cartesian']
+    measurements_ylm = measurements_dict['ylm']
+    atol = 1.e-12 * np.max(np.abs(measurements_ylm['pk_raw']))
+
+    assert np.array_equal(
+        measurements['nmodes'], measurements_ylm['nmodes']
+    ), "Measured mode counts do not match."
+    assert np.allclose(
+        measurements['pk_raw'], measurements_ylm['pk_raw'],
+        rtol=1.e-12, atol=atol
+    ), "Measured raw statistics do not match."
+    assert np.allclose(
+        measurements['pk_shot'], measurements_ylm['pk_shot'],
+        rtol=1.e-12, atol=atol
+    ), "Measured shot noise contributions do not match."
+
+    with pytest.raises(ValueError):
+        paramset['powspec_estimator'] = 'cartesian-moments'
+
+
+@pytest.mark.slow
+def test_compute_powspec_profile(test_data_catalogue,
+                                 test_rand_catalogue,
+                                 test_binning_fourier,
+                                 test_param_dir):
+
+    measurements = compute_powspec(
+        test_data_catalogue, test_rand_catalogue,
+        degree=0,
+        binning=test_binning_fourier,
+        paramset=ParameterSet(
+            param_filepath=test_param_dir/"test_params.yml"
+        )
+    )
+
+    for stage in ['assignment', 'fft', 'binning']:
+        assert stage in measurements['profile'], \
+            f"Stage '{stage}' is not profiled."
+        assert measurements['profile'][stage]['ncalls'] > 0, \
+            f"Stage '{stage}' is not timed."
+
+
+@pytest.mark.slow
+def test_compute_powspec_memory_budget(test_data_catalogue,
+                                       test_rand_catalogue,
+                                       test_binning_fourier,
+                                       test_param_dir):
+
+    paramset = ParameterSet(param_filepath=test_param_dir/"test_params.yml")
+    paramset['memory_budget'] = 1.e-3
+
+    with pytest.raises(MemoryError):
+        compute_powspec(
+            test_data_catalogue, test_rand_catalogue,
+            degree=0,
+            binning=test_binning_fourier,
+            paramset=paramset
+        )
+
+
+@pytest.mark.slow
+def test_compute_powspec_in_gpp_box_interlace_order(test_data_catalogue,
+                                                    test_binning_fourier,
+                                                    test_param_dir,
+                                                    copy_catalogue):
+
+    measurements_dict = {}
+    for interlace in [True, 2, 3, 4]:
+        paramset = ParameterSet(
+            param_filepath=test_param_dir/"test_params.yml"
+        )
+        paramset['interlace'] = interlace
+        measurements_dict[interlace] = compute_powspec_in_gpp_box(
+            copy_catalogue(test_data_catalogue),
+            degree=0,
+            binning=test_binning_fourier,
+            paramset=paramset
+        )
+        if interlace in [True, 2]:
+            assert paramset['interlace'] is True, \
+                "Interlacing of order 2 is not read back as a switch."
+        else:
+            assert paramset['interlace'] == interlace, \
+                "Interlacing order is not read back."
+
+    # Multithreaded mesh assignment may reorder floating-point sums.
+    assert np.allclose(
+        measurements_dict[2]['pk_raw'], measurements_dict[True]['pk_raw'],
+        rtol=1.e-12
+    ), "Interlacing of order 2 does not match the interlacing switch."
+
+    # Switching interlacing on for the parameter set last used with
+    # order 4 should reset the order to 2.
+    paramset['interlace'] = True
+    measurements_reset = compute_powspec_in_gpp_box(
+        copy_catalogue(test_data_catalogue),
+        degree=0,
+        binning=test_binning_fourier,
+        paramset=paramset
+    )
+    for name in ['pk_raw', 'pk_shot']:
+        assert np.allclose(
+            measurements_reset[name], measurements_dict[True][name],
+            rtol=1.e-12
+        ), "Interlacing reset on a reused parameter set does not match."
+    for order in [3, 4]:
+        assert np.allclose(
+            measurements_dict[order]['pk_raw'],
+            measurements_dict[2]['pk_raw'],
+            rtol=1.e-3
+        ), f"Measured raw statistics at interlacing order {order} deviate."
+
+    # Residual shot-noise aliasing decreases with the interlacing order.
+    shot_poisson = measurements_dict[4]['pk_shot'].real[0]
+    shot_residuals = [
+        np.abs(measurements_dict[order]['pk_shot'].real[-1] - shot_poisson)
+        for order in [2, 3, 4]
+    ]
+    assert shot_residuals[0] > shot_residuals[1] > shot_residuals[2], \
+        "Residual shot-noise aliasing does not decrease with order."
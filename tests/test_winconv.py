@@ -0,0 +1,174 @@
+"""Test :mod:`~triumvirate.winconv`.
+
+"""
+import numpy as np
+import pytest
+from scipy.interpolate import InterpolatedUnivariateSpline, RectBivariateSpline
+
+from triumvirate.transforms import (
+    DoubleSphericalBesselTransform,
+    SphericalBesselTransform,
+)
+from triumvirate.winconv import (
+    NAMED_FORMULAE,
+    BispecWinConv,
+    PowspecWinConv,
+    ThreePCFWinConv,
+    TwoPCFWinConv,
+    WinConvFormulae,
+)
+
+
+FORMULAE_3PT = {
+    (0, 0): [((0, 0), (0, 0), 1), ((1, 1), (1, 1), 1./3)],
+    (1, 1): [((0, 0), (1, 1), 1), ((1, 1), (0, 0), 1)],
+}
+
+
+@pytest.mark.parametrize(
+    "r_common, on_grid",
+    [
+        (None, False),
+        (np.logspace(-.5, 2.5, 128), False),
+        (np.logspace(-.5, 2.5, 128), True),
+    ]
+)
+def test_PowspecWinConv(r_common, on_grid):
+    r = np.logspace(-1., 3., 128)
+    k = np.logspace(-3., 1., 128)
+    window_multipoles = {
+        ell: np.exp(- r / (500. - 50.*ell)) for ell in range(0, 10, 2)
+    }
+    pk_in = {ell: 1.e4 / (1. + (k/.05)**2) / (1. + ell) for ell in (0, 2, 4)}
+
+    winconv = PowspecWinConv(
+        'wilson+16', r, window_multipoles, k, r_common=r_common
+    )
+    r_common = winconv.r_common
+
+    # Convolve in separate steps for comparison.
+    formulae = WinConvFormulae(NAMED_FORMULAE['wilson+16'])
+    Q_common = {
+        ell: InterpolatedUnivariateSpline(r, Qpole)(r_common)
+        for ell, Qpole in window_multipoles.items()
+    }
+    xi_in = {}
+    for ell, Ppole in pk_in.items():
+        r_in, Zpole = SphericalBesselTransform(ell, 0, k, extrap=3) \
+            .transform(Ppole.copy())
+        xi_in[ell] = InterpolatedUnivariateSpline(r_in, Zpole.real)(r_common)
+
+    pk_conv_out = winconv.convolve(xi_in if on_grid else pk_in, on_grid)
+    for ell in formulae.multipoles:
+        xi_conv = np.add.reduce([
+            float(term.coeff) * Q_common[term.ind_Q] * xi_in[term.ind_Z]
+            for term in formulae[ell]
+        ])
+        k_conv, Ppole_conv = SphericalBesselTransform(
+            ell, 0, r_common, extrap=3
+        ).transform(xi_conv)
+        assert pk_conv_out[ell] == pytest.approx(
+            InterpolatedUnivariateSpline(k_conv, Ppole_conv.real)(k),
+            rel=1.e-9, abs=1.e-9 * np.max(np.abs(Ppole_conv))
+        ), f"Windowed power spectrum multipole {ell} mismatches."
+
+
+def test_TwoPCFWinConv():
+    r = np.logspace(-1., 3., 128)
+    r_out = np.linspace(5., 200., 40)
+    window_multipoles = {
+        ell: np.exp(- r / (500. - 50.*ell)) for ell in range(0, 10, 2)
+    }
+    xi_in = {ell: 1. / (1. + (r/10.)**2) / (1. + ell) for ell in (0, 2, 4)}
+
+    winconv = TwoPCFWinConv('wilson+16', r, window_multipoles, r, r_out)
+    xi_conv_out = winconv.convolve(xi_in)
+    xi_conv_out_ongrid = winconv.convolve(
+        {
+            ell: InterpolatedUnivariateSpline(r, Zpole)(r_out)
+            for ell, Zpole in xi_in.items()
+        },
+        on_grid=True
+    )
+
+    formulae = WinConvFormulae(NAMED_FORMULAE['wilson+16'])
+    for ell in formulae.multipoles:
+        xi_conv = np.add.reduce([
+            float(term.coeff)
+            * InterpolatedUnivariateSpline(r, window_multipoles[term.ind_Q])(
+                r_out
+            )
+            * InterpolatedUnivariateSpline(r, xi_in[term.ind_Z])(r_out)
+            for term in formulae[ell]
+        ])
+        assert xi_conv_out[ell] == pytest.approx(xi_conv, rel=1.e-12), \
+            f"Windowed 2PCF multipole {ell} mismatches."
+        assert xi_conv_out_ongrid[ell] == pytest.approx(
+            xi_conv, rel=1.e-12
+        ), f"Windowed on-grid 2PCF multipole {ell} mismatches."
+
+
+def test_ThreePointWinConv():
+    nsamp = 32
+    r = np.logspace(-1., 3., nsamp)
+    k = np.logspace(-3., 1., nsamp)
+    r_out = np.logspace(0., 2., 20)
+    window_multipoles = {
+        (0, 0): np.exp(- np.add.outer(r, r) / 500.),
+        (1, 1): .1 * np.exp(- np.add.outer(r, r) / 300.),
+    }
+    bk_in = {
+        (0, 0): 1.e8 / np.outer(1. + (k/.05)**2, 1. + (k/.05)**2),
+        (1, 1): 1.e7 / np.outer(1. + (k/.05)**2, 1. + (k/.05)**2),
+    }
+    formulae = WinConvFormulae(FORMULAE_3PT)
+
+    # Configuration-space convolution.
+    winconv = ThreePCFWinConv(FORMULAE_3PT, r, window_multipoles, r, r_out)
+    zeta_conv_out = winconv.convolve(bk_in)
+    for multipole in formulae.multipoles:
+        zeta_conv = np.add.reduce([
+            float(term.coeff)
+            * RectBivariateSpline(r, r, window_multipoles[term.ind_Q])(
+                r_out, r_out
+            )
+            * RectBivariateSpline(r, r, bk_in[term.ind_Z])(r_out, r_out)
+            for term in formulae[multipole]
+        ])
+        assert zeta_conv_out[multipole] == pytest.approx(
+            zeta_conv, rel=1.e-12
+        ), f"Windowed 3PCF multipole {multipole} mismatches."
+
+    # Fourier-space convolution.
+    transform_kwargs = {'extrap': 1}
+    winconv = BispecWinConv(
+        FORMULAE_3PT, r, window_multipoles, k,
+        transform_kwargs=transform_kwargs
+    )
+    bk_conv_out = winconv.convolve(bk_in)
+
+    zeta_in = {}
+    for multipole, Bpole in bk_in.items():
+        dsjt = DoubleSphericalBesselTransform(
+            multipole, (0, 0), k, **transform_kwargs
+        )
+        _, Zpole = dsjt.transform(Bpole)
+        zeta_in[multipole] = RectBivariateSpline(
+            dsjt._post_sampts, dsjt._post_sampts, Zpole.real
+        )(r, r)
+    for multipole in formulae.multipoles:
+        zeta_conv = np.add.reduce([
+            float(term.coeff)
+            * window_multipoles[term.ind_Q] * zeta_in[term.ind_Z]
+            for term in formulae[multipole]
+        ])
+        dsjt = DoubleSphericalBesselTransform(
+            multipole, (0, 0), r, **transform_kwargs
+        )
+        _, Bpole_conv = dsjt.transform(zeta_conv)
+        Bpole_conv = RectBivariateSpline(
+            dsjt._post_sampts, dsjt._post_sampts, Bpole_conv.real
+        )(k, k)
+        assert bk_conv_out[multipole] == pytest.approx(
+            Bpole_conv, rel=1.e-9, abs=1.e-9 * np.max(np.abs(Bpole_conv))
+        ), f"Windowed bispectrum multipole {multipole} mismatches."